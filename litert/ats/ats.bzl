@@ -76,6 +76,7 @@ def litert_define_ats(
         jit_suffix,
         compile_only_suffix,
         compile_aot_and_run_suffix = None,
+        perf_suffix = None,
         dont_register = [],
         do_register = [],
         param_seeds = {},
@@ -89,6 +90,9 @@ def litert_define_ats(
       jit_suffix: Suffix for the Just-In-Time execution target.
       compile_only_suffix: Suffix for the Compile-Only target.
       compile_aot_and_run_suffix: Suffix for the Compile AOT and Run target.
+      perf_suffix: Suffix for the perf target, which microbenchmarks the same models instead of
+          checking numerics. Pass `--perf_baseline` and `--perf_baseline_out` at runtime to compare
+          against and record baselines.
       dont_register: A list of regular expressions for tests that should not be registered.
       do_register: A list of regular expressions for tests that should be registered.
       param_seeds: A dictionary of parameter seeds for the test suite.
@@ -158,6 +162,18 @@ def litert_define_ats(
                 data = data,
             )
 
+        if perf_suffix != None:
+            litert_device_exec(
+                name = name + perf_suffix + version_suffix,
+                target = "//litert/ats:ats",
+                remote_suffix = "_remote",
+                local_suffix = "",
+                exec_args = run_args + ["--perf_mode=true"],
+                backend_id = b,
+                model_providers = model_providers,
+                data = data,
+            )
+
         init_compile_args = ["--compile_mode=true"]
         for m in extra_models_host:
             init_compile_args.append("--extra_models={}".format(m))
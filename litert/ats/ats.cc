@@ -26,6 +26,7 @@
 #include "litert/ats/compile_fixture.h"
 #include "litert/ats/configure.h"
 #include "litert/ats/inference_fixture.h"
+#include "litert/ats/perf_fixture.h"
 #include "litert/ats/register.h"
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_op_code.h"
@@ -105,11 +106,14 @@ int Ats() {
   size_t test_id = 0;
   typename AtsInferenceTest::Capture i_cap;
   typename AtsCompileTest::Capture c_cap;
+  typename AtsPerfTest::Capture p_cap;
 
-  if (!options->CompileMode()) {
-    RegisterAll<AtsInferenceTest>(*options, test_id, i_cap);
-  } else {
+  if (options->CompileMode()) {
     RegisterAll<AtsCompileTest>(*options, test_id, c_cap);
+  } else if (options->PerfMode()) {
+    RegisterAll<AtsPerfTest>(*options, test_id, p_cap);
+  } else {
+    RegisterAll<AtsInferenceTest>(*options, test_id, i_cap);
   }
 
   // Preliminary report.
@@ -125,6 +129,13 @@ int Ats() {
   if (options->CompileMode()) {
     options->Csv(c_cap);
     options->Print(c_cap);
+  } else if (options->PerfMode()) {
+    options->Csv(p_cap);
+    options->Print(p_cap);
+    if (auto saved = options->SavePerfBaseline(p_cap); !saved) {
+      LITERT_LOG(LITERT_ERROR, "%s", saved.Error().Message().c_str());
+      return 1;
+    }
   } else {
     options->Csv(i_cap);
     options->Print(i_cap);
@@ -16,6 +16,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -28,6 +29,8 @@
 #include "litert/ats/configure.h"
 #include "litert/ats/executor.h"
 #include "litert/ats/inference_fixture.h"
+#include "litert/ats/perf.h"
+#include "litert/ats/perf_fixture.h"
 #include "litert/ats/register.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_op_code.h"
@@ -73,6 +76,22 @@ Expected<AtsConf> CompileOptions() {
   return AtsConf::ParseFlagsAndDoSetup();
 }
 
+Expected<AtsConf> PerfOptions(bool npu, const std::string& baseline_out) {
+  absl::FlagSaver saver;
+  if (npu) {
+    absl::SetFlag(&FLAGS_dispatch_dir, GetLiteRtPath("vendors/examples/"));
+    absl::SetFlag(&FLAGS_plugin_dir, GetLiteRtPath("vendors/examples/"));
+    absl::SetFlag(&FLAGS_soc_manufacturer, "ExampleSocManufacturer");
+  }
+  absl::SetFlag(&FLAGS_backend, npu ? "npu" : "cpu");
+  absl::SetFlag(&FLAGS_perf_mode, true);
+  absl::SetFlag(&FLAGS_perf_warmup_runs, 1);
+  absl::SetFlag(&FLAGS_perf_trials, 3);
+  absl::SetFlag(&FLAGS_perf_runs_per_trial, 2);
+  absl::SetFlag(&FLAGS_perf_baseline_out, baseline_out);
+  return AtsConf::ParseFlagsAndDoSetup();
+}
+
 Expected<void> CheckAts() {
   absl::SetFlag(&FLAGS_extra_models, {GetLiteRtPath("test/testdata/")});
 
@@ -83,10 +102,18 @@ Expected<void> CheckAts() {
 
   typename AtsInferenceTest::Capture i_cap;
   typename AtsCompileTest::Capture c_cap;
+  typename AtsPerfTest::Capture p_cap;
 
   LITERT_ASSIGN_OR_RETURN(auto cpu_inference_options, CpuInferenceOptions());
   LITERT_ASSIGN_OR_RETURN(auto compile_options, CompileOptions());
   LITERT_ASSIGN_OR_RETURN(auto npu_inference_options, NpuInferenceOptions());
+  LITERT_ASSIGN_OR_RETURN(auto perf_dir, UniqueTestDirectory::Create());
+  const auto baseline_out =
+      internal::Join({perf_dir.Str(), "perf_baseline.txt"});
+  LITERT_ASSIGN_OR_RETURN(auto cpu_perf_options,
+                          PerfOptions(/*npu=*/false, baseline_out));
+  LITERT_ASSIGN_OR_RETURN(auto npu_perf_options,
+                          PerfOptions(/*npu=*/true, baseline_out));
 
   // CPU
   {
@@ -117,6 +144,17 @@ Expected<void> CheckAts() {
         /*iters=*/1, test_id, compile_options, c_cap);
   }
 
+  // Perf
+
+  {
+    RegisterCombinations<AtsPerfTest, BinaryNoBroadcast, SizeListC<1>,
+                         TypeList<float>, OpCodeListC<kLiteRtOpCodeTflSub>>(
+        /*iters=*/1, test_id, cpu_perf_options, p_cap);
+    RegisterCombinations<AtsPerfTest, BinaryNoBroadcast, SizeListC<1>,
+                         TypeList<float>, OpCodeListC<kLiteRtOpCodeTflSub>>(
+        /*iters=*/1, test_id, npu_perf_options, p_cap);
+  }
+
   const auto* ut = ::testing::UnitTest::GetInstance();
   LITERT_ENSURE((ut->total_test_count() == test_id),
                 Error(kLiteRtStatusErrorRuntimeFailure),
@@ -137,7 +175,7 @@ Expected<void> CheckAts() {
         [](const auto& row) { return row.run.status != RunStatus::kError; });
 
     LITERT_ENSURE(
-        i_cap_ok && i_cap.Rows().size() == test_id - 1 && num_extra_models == 1,
+        i_cap_ok && i_cap.Rows().size() == test_id - 3 && num_extra_models == 1,
         Error(kLiteRtStatusErrorRuntimeFailure),
         "Status capture contains errors.");
   }
@@ -154,10 +192,30 @@ Expected<void> CheckAts() {
                   "Status capture contains errors.");
   }
 
+  // Check perf capture and the saved baseline.
+  {
+    const auto p_cap_ok = std::all_of(
+        p_cap.Rows().begin(), p_cap.Rows().end(), [](const auto& row) {
+          return row.run.status == RunStatus::kOk &&
+                 row.perf.Samples().size() == 3;
+        });
+
+    LITERT_ENSURE(p_cap_ok && p_cap.Rows().size() == 2,
+                  Error(kLiteRtStatusErrorRuntimeFailure),
+                  "Perf capture contains errors.");
+
+    LITERT_RETURN_IF_ERROR(cpu_perf_options.SavePerfBaseline(p_cap));
+    LITERT_ASSIGN_OR_RETURN(auto baseline, PerfBaseline::Load(baseline_out));
+    LITERT_ENSURE(baseline.Size() == 2, Error(kLiteRtStatusErrorRuntimeFailure),
+                  "Unexpected number of perf baseline entries.");
+  }
+
   i_cap.Print(std::cerr);
   i_cap.Csv(std::cerr);
   c_cap.Print(std::cerr);
   c_cap.Csv(std::cerr);
+  p_cap.Print(std::cerr);
+  p_cap.Csv(std::cerr);
 
   // Check post-test saved models.
   {
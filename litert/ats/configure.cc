@@ -30,6 +30,7 @@
 #include "absl/strings/str_split.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/ats/common.h"
+#include "litert/ats/perf.h"
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_common.h"
@@ -114,6 +115,36 @@ ABSL_FLAG(std::string, soc_model, "",
           "The SOC model to target for compilation. Only relevant for "
           "NPU compilation.");
 
+ABSL_FLAG(bool, perf_mode, false,
+          "Enable the perf flow. Uses the same input and generated models, but "
+          "microbenchmarks them on the target backend instead of checking "
+          "their numerics.");
+
+ABSL_FLAG(size_t, perf_warmup_runs, 5,
+          "Untimed runs per test before the perf trials.");
+
+ABSL_FLAG(size_t, perf_trials, 20,
+          "Number of latency samples per test in perf mode.");
+
+ABSL_FLAG(size_t, perf_runs_per_trial, 10,
+          "Number of runs averaged into every perf sample.");
+
+ABSL_FLAG(std::string, perf_baseline, "",
+          "If specified, perf tests whose latency regressed against this "
+          "baseline file will fail.");
+
+ABSL_FLAG(std::string, perf_baseline_out, "",
+          "If specified, the perf samples of this run will be written to this "
+          "path as a new baseline.");
+
+ABSL_FLAG(double, perf_threshold, 0.1,
+          "Relative growth of the median latency over the baseline above "
+          "which a perf test may fail.");
+
+ABSL_FLAG(double, perf_alpha, 0.01,
+          "Significance level of the one-sided Mann-Whitney test that a perf "
+          "test is slower than its baseline.");
+
 namespace litert::testing {
 
 namespace {
@@ -180,6 +211,23 @@ Expected<std::optional<internal::CompilerPlugin>> ParsePlugin(
   return R(std::move(plugin));
 }
 
+Expected<PerfConf> ParsePerf() {
+  PerfConf perf;
+  perf.enabled = absl::GetFlag(FLAGS_perf_mode);
+  perf.warmup_runs = absl::GetFlag(FLAGS_perf_warmup_runs);
+  perf.trials = absl::GetFlag(FLAGS_perf_trials);
+  perf.runs_per_trial =
+      std::max<size_t>(absl::GetFlag(FLAGS_perf_runs_per_trial), 1);
+  perf.threshold = absl::GetFlag(FLAGS_perf_threshold);
+  perf.alpha = absl::GetFlag(FLAGS_perf_alpha);
+  perf.baseline_out = absl::GetFlag(FLAGS_perf_baseline_out);
+  const auto baseline = absl::GetFlag(FLAGS_perf_baseline);
+  if (perf.enabled && !baseline.empty()) {
+    LITERT_ASSIGN_OR_RETURN(perf.baseline, PerfBaseline::Load(baseline));
+  }
+  return perf;
+}
+
 void Setup(const AtsConf& options) {
   if (options.Quiet()) {
     LiteRtSetMinLoggerSeverity(LiteRtGetDefaultLogger(), LITERT_SILENT);
@@ -191,6 +239,7 @@ void Setup(const AtsConf& options) {
 Expected<AtsConf> AtsConf::ParseFlagsAndDoSetup() {
   LITERT_ASSIGN_OR_RETURN(auto seeds, ParseParamSeedMap());
   LITERT_ASSIGN_OR_RETURN(auto backend, ParseBackend());
+  LITERT_ASSIGN_OR_RETURN(auto perf, ParsePerf());
   std::vector<std::regex> neg_re;
   for (const auto& re : absl::GetFlag(FLAGS_dont_register)) {
     neg_re.push_back(std::regex(re, std::regex_constants::ECMAScript));
@@ -230,7 +279,8 @@ Expected<AtsConf> AtsConf::ParseFlagsAndDoSetup() {
               fail_on_timeout, dump_report, std::move(csv), compile_mode,
               std::move(models_out), limit, std::move(plugin),
               std::move(soc_manufacturer), std::move(soc_model),
-              std::move(target_options), std::move(reference_options));
+              std::move(target_options), std::move(reference_options),
+              std::move(perf));
   Setup(res);
   return res;
 }
@@ -26,6 +26,7 @@
 #include "absl/flags/declare.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "litert/ats/common.h"
+#include "litert/ats/perf.h"
 #include "litert/cc/internal/litert_rng.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_options.h"
@@ -97,6 +98,30 @@ ABSL_DECLARE_FLAG(std::string, soc_manufacturer);
 // compilation.
 ABSL_DECLARE_FLAG(std::string, soc_model);
 
+// Microbenchmarks the generated models instead of checking their numerics.
+ABSL_DECLARE_FLAG(bool, perf_mode);
+
+// Untimed runs per test before the perf trials.
+ABSL_DECLARE_FLAG(size_t, perf_warmup_runs);
+
+// Number of latency samples per test in perf mode.
+ABSL_DECLARE_FLAG(size_t, perf_trials);
+
+// Runs averaged into every perf sample.
+ABSL_DECLARE_FLAG(size_t, perf_runs_per_trial);
+
+// Perf baseline to compare against.
+ABSL_DECLARE_FLAG(std::string, perf_baseline);
+
+// Where to save the perf samples of this run as a new baseline.
+ABSL_DECLARE_FLAG(std::string, perf_baseline_out);
+
+// Relative latency growth above which a test may be flagged as a regression.
+ABSL_DECLARE_FLAG(double, perf_threshold);
+
+// Significance level of the perf regression test.
+ABSL_DECLARE_FLAG(double, perf_alpha);
+
 namespace litert::testing {
 
 class AtsConf {
@@ -238,6 +263,22 @@ class AtsConf {
   // Litert options to use for the reference backend.
   const Options& ReferenceOptions() const { return reference_options_; }
 
+  // Whether to run the perf flow instead of checking numerics.
+  bool PerfMode() const { return perf_.enabled; }
+
+  // Settings of the perf flow.
+  const PerfConf& Perf() const { return perf_; }
+
+  // Save the perf samples of the run as a new baseline if the user has
+  // requested.
+  template <typename T>
+  Expected<void> SavePerfBaseline(const T& capture) const {
+    if (perf_.baseline_out.empty() || !perf_.enabled) {
+      return {};
+    }
+    return capture.Baseline().Save(perf_.baseline_out);
+  }
+
   AtsConf(const AtsConf&) = delete;
   AtsConf& operator=(const AtsConf&) = delete;
   AtsConf(AtsConf&&) = default;
@@ -255,7 +296,8 @@ class AtsConf {
                    bool compile_mode, std::string models_out, int32_t limit,
                    std::optional<internal::CompilerPlugin> plugin,
                    std::string soc_manufacturer, std::string soc_model,
-                   Options&& target_options, Options&& reference_options)
+                   Options&& target_options, Options&& reference_options,
+                   PerfConf perf)
       : seeds_for_params_(std::move(seeds_for_params)),
         backend_(backend),
         quiet_(quiet),
@@ -277,7 +319,8 @@ class AtsConf {
         soc_manufacturer_(std::move(soc_manufacturer)),
         soc_model_(std::move(soc_model)),
         target_options_(std::move(target_options)),
-        reference_options_(std::move(reference_options)) {
+        reference_options_(std::move(reference_options)),
+        perf_(std::move(perf)) {
     // For now, we will provide default settings for data generation.
     // More configurability may be introduced later.
     data_builder_.SetSin();
@@ -306,6 +349,7 @@ class AtsConf {
   std::string soc_model_;
   Options target_options_;
   Options reference_options_;
+  PerfConf perf_;
 
   RandomTensorDataBuilder data_builder_;
 };
@@ -28,6 +28,7 @@
 #include <gtest/gtest.h>
 #include "absl/strings/str_format.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/capture_common.h"
 #include "litert/ats/common.h"
 #include "litert/ats/configure.h"
 #include "litert/ats/executor.h"
@@ -49,6 +50,28 @@ namespace litert::testing {
 using ::testing::RegisterTest;
 using ::testing::litert::MeanSquaredErrorLt;
 
+// Creates the executor for the target backend of `conf`, recording the outcome
+// of any compilation in `compilation`.
+inline Expected<CompiledModelExecutor::Ptr> MakeTargetExecutor(
+    const AtsConf& conf, LiteRtModelT& graph, CompilationDetail& compilation) {
+  if (conf.IsNpu()) {
+    auto exec = NpuCompiledModelExecutor::Create(
+        graph, conf.TargetOptions(), conf.DispatchDir(), conf.PluginDir());
+    compilation.SetFields(conf, graph, !exec.HasValue());
+    if (!exec) {
+      return exec.Error();
+    }
+    auto res = std::make_unique<CompiledModelExecutor>(std::move(*exec));
+    return res;
+  } else if (conf.IsCpu()) {
+    LITERT_ASSIGN_OR_RETURN(auto exec, CpuCompiledModelExecutor::Create(
+                                           graph, conf.TargetOptions()));
+    return std::make_unique<CompiledModelExecutor>(std::move(exec));
+  }
+
+  return Error(kLiteRtStatusErrorInvalidArgument, "Unsupported backend");
+}
+
 // Fixture for tests that test execution on a given graph.
 class AtsInferenceTest : public RngTest {
  private:
@@ -115,24 +138,7 @@ class AtsInferenceTest : public RngTest {
   double Tol() const { return graph_->HasReference() ? 1e-4 : 1e2; }
 
   Expected<CompiledModelExecutor::Ptr> MakeExecutor() {
-    CompiledModelExecutor::Ptr exec;
-    if (conf_.IsNpu()) {
-      auto exec = NpuCompiledModelExecutor::Create(
-          Graph(), conf_.TargetOptions(), conf_.DispatchDir(),
-          conf_.PluginDir());
-      cap_.compilation.SetFields(conf_, Graph(), !exec.HasValue());
-      if (!exec) {
-        return exec.Error();
-      }
-      auto res = std::make_unique<CompiledModelExecutor>(std::move(*exec));
-      return res;
-    } else if (conf_.IsCpu()) {
-      LITERT_ASSIGN_OR_RETURN(auto exec, CpuCompiledModelExecutor::Create(
-                                             Graph(), conf_.TargetOptions()));
-      return std::make_unique<CompiledModelExecutor>(std::move(exec));
-    }
-
-    return Error(kLiteRtStatusErrorInvalidArgument, "Unsupported backend");
+    return MakeTargetExecutor(conf_, Graph(), cap_.compilation);
   }
 
   template <typename Rng>
@@ -0,0 +1,244 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_map.h"  // from @com_google_absl
+#include "absl/strings/numbers.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_join.h"  // from @com_google_absl
+#include "absl/strings/str_replace.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/ats/common.h"
+#include "litert/c/litert_common.h"
+#include "litert/cc/litert_expected.h"
+
+namespace litert::testing {
+
+/// STATISTICS /////////////////////////////////////////////////////////////////
+
+// Median of the given samples, 0 if there are none.
+inline double Median(std::vector<double> samples) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const size_t mid = samples.size() / 2;
+  std::nth_element(samples.begin(), samples.begin() + mid, samples.end());
+  const double upper = samples[mid];
+  if (samples.size() % 2 == 1) {
+    return upper;
+  }
+  const double lower =
+      *std::max_element(samples.begin(), samples.begin() + mid);
+  return (lower + upper) / 2.0;
+}
+
+// One-sided Mann-Whitney U test. Returns the p-value of the null hypothesis
+// that samples from `a` are not larger than samples from `b`. Uses the normal
+// approximation with tie and continuity corrections, which is accurate enough
+// for the ~10+ samples per side the perf mode takes.
+inline double MannWhitneyGreaterPValue(absl::Span<const double> a,
+                                       absl::Span<const double> b) {
+  const double n1 = a.size();
+  const double n2 = b.size();
+  if (a.empty() || b.empty()) {
+    return 1.0;
+  }
+
+  // Pool the samples, remembering which side each one came from.
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(a.size() + b.size());
+  for (const auto s : a) {
+    pooled.push_back({s, true});
+  }
+  for (const auto s : b) {
+    pooled.push_back({s, false});
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // Sum of the ranks of `a`, ties get the average of their ranks.
+  double rank_sum_a = 0.0;
+  double tie_term = 0.0;
+  for (size_t i = 0; i < pooled.size();) {
+    size_t j = i;
+    while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+      ++j;
+    }
+    const double rank = (i + 1 + j) / 2.0;
+    const double num_tied = j - i;
+    tie_term += num_tied * num_tied * num_tied - num_tied;
+    for (size_t k = i; k < j; ++k) {
+      if (pooled[k].second) {
+        rank_sum_a += rank;
+      }
+    }
+    i = j;
+  }
+
+  const double n = n1 + n2;
+  const double u = rank_sum_a - n1 * (n1 + 1) / 2.0;
+  const double mean = n1 * n2 / 2.0;
+  const double var = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)));
+  if (var <= 0.0) {
+    // Every sample is the same.
+    return 1.0;
+  }
+  const double z = (u - mean - 0.5) / std::sqrt(var);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Result of comparing the latencies of a test against its baseline.
+struct PerfVerdict {
+  double median = 0.0;
+  double baseline_median = 0.0;
+  // Ratio of the medians, > 1 means slower than the baseline.
+  double ratio = 1.0;
+  double p_value = 1.0;
+  // Slower than the baseline by more than the threshold, and significantly so.
+  bool regressed = false;
+};
+
+// Flags a regression when the median latency grew by more than `threshold`
+// (relative) over the baseline and the samples are significantly larger
+// according to a one-sided Mann-Whitney test at level `alpha`. Requiring both
+// keeps tiny but consistent slowdowns and large but noisy ones from failing.
+inline PerfVerdict ComparePerf(const std::vector<double>& samples,
+                               const std::vector<double>& baseline,
+                               double threshold, double alpha) {
+  PerfVerdict res;
+  res.median = Median(samples);
+  res.baseline_median = Median(baseline);
+  if (res.baseline_median > 0.0) {
+    res.ratio = res.median / res.baseline_median;
+  }
+  res.p_value = MannWhitneyGreaterPValue(samples, baseline);
+  res.regressed = res.ratio > 1.0 + threshold && res.p_value < alpha;
+  return res;
+}
+
+/// BASELINE ///////////////////////////////////////////////////////////////////
+
+// Per-test latency samples, in microseconds per run, from a previous perf
+// run. Serialized as one line per test: the key, a tab and the comma separated
+// samples. Tests are keyed by their gtest name, so baselines are only
+// comparable between runs with the same selection flags and seeds.
+class PerfBaseline {
+ public:
+  using Samples = std::vector<double>;
+
+  // Key of the test with the given names.
+  static std::string Key(const TestNames& names) {
+    return absl::StrReplaceAll(
+        absl::StrFormat("%s.%s", names.suite, names.test),
+        {{"\t", " "}, {"\n", " "}});
+  }
+
+  static Expected<PerfBaseline> Load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+      return Error(kLiteRtStatusErrorFileIO,
+                   absl::StrFormat("Failed to open perf baseline %s", path));
+    }
+    PerfBaseline res;
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::pair<absl::string_view, absl::string_view> entry =
+          absl::StrSplit(line, absl::MaxSplits('\t', 1));
+      Samples samples;
+      for (const auto s : absl::StrSplit(entry.second, ',')) {
+        double sample;
+        if (!absl::SimpleAtod(s, &sample)) {
+          return Error(kLiteRtStatusErrorInvalidArgument,
+                       absl::StrFormat("Malformed perf baseline line: %s",
+                                       line));
+        }
+        samples.push_back(sample);
+      }
+      res.Set(std::string(entry.first), std::move(samples));
+    }
+    return res;
+  }
+
+  Expected<void> Save(const std::string& path) const {
+    std::ofstream out(path);
+    out << "# ATS perf baseline: <test> TAB <latencies (us per run)>\n";
+    for (const auto& [key, samples] : samples_) {
+      out << key << '\t' << absl::StrJoin(samples, ",") << '\n';
+    }
+    out.close();
+    if (!out) {
+      return Error(kLiteRtStatusErrorFileIO,
+                   absl::StrFormat("Failed to write perf baseline %s", path));
+    }
+    return {};
+  }
+
+  // Samples for the given key, nullptr if the baseline doesn't have the test.
+  const Samples* Find(absl::string_view key) const {
+    auto it = samples_.find(key);
+    return it == samples_.end() ? nullptr : &it->second;
+  }
+
+  void Set(std::string key, Samples samples) {
+    samples_[std::move(key)] = std::move(samples);
+  }
+
+  size_t Size() const { return samples_.size(); }
+
+ private:
+  // Ordered so that saved baselines diff cleanly.
+  absl::btree_map<std::string, Samples> samples_;
+};
+
+/// CONFIGURATION //////////////////////////////////////////////////////////////
+
+// Settings of the perf mode, which microbenchmarks the generated models instead
+// of checking their numerics.
+struct PerfConf {
+  // Whether to run the perf mode.
+  bool enabled = false;
+  // Untimed runs before the trials, to warm up caches and lazy allocations.
+  size_t warmup_runs = 5;
+  // Number of latency samples per test.
+  size_t trials = 20;
+  // Runs averaged into every sample, to get above the timer resolution for
+  // small ops.
+  size_t runs_per_trial = 10;
+  // Relative growth of the median latency above which a test may regress.
+  double threshold = 0.1;
+  // Significance level of the regression test.
+  double alpha = 0.01;
+  // Baseline to compare against, empty if none was given.
+  PerfBaseline baseline;
+  // Where to save the samples of this run as a new baseline, if anywhere.
+  std::string baseline_out;
+};
+
+}  // namespace litert::testing
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_H_
@@ -0,0 +1,119 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_CAPTURE_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_CAPTURE_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/capture_common.h"
+#include "litert/ats/common.h"
+#include "litert/ats/inference_capture.h"
+#include "litert/ats/perf.h"
+#include "litert/ats/print.h"
+
+namespace litert::testing {
+
+// Latency samples of a perf test and how they compare to the baseline.
+class PerfDetail
+    : public Printable<double, double, double, double, bool, size_t> {
+ public:
+  // Key of the test in the perf baselines.
+  std::string key = "";  // NOLINT
+
+  // Record the samples of the run, in microseconds per run.
+  void SetSamples(std::vector<double> samples) {
+    samples_ = std::move(samples);
+  }
+  const std::vector<double>& Samples() const { return samples_; }
+
+  // Record the comparison against the baseline.
+  void SetVerdict(const PerfVerdict& verdict) {
+    verdict_ = verdict;
+    has_baseline_ = true;
+  }
+  const PerfVerdict& Verdict() const { return verdict_; }
+  bool HasBaseline() const { return has_baseline_; }
+
+  // Median latency of the samples.
+  double MedianLatency() const { return Median(samples_); }
+
+  PerfDetail()
+      : Printable("Perf", "median_latency(us)", "baseline_median(us)",
+                  "ratio", "p_value", "regressed", "num_trials") {}
+
+ private:
+  Fields GetFields() const override {
+    return Fields{MedianLatency(),    verdict_.baseline_median,
+                  verdict_.ratio,     verdict_.p_value,
+                  verdict_.regressed, samples_.size()};
+  }
+
+  std::vector<double> samples_;
+  PerfVerdict verdict_;
+  bool has_baseline_ = false;
+};
+
+// Type to hold all of the capturable information related to a single perf
+// test case.
+struct PerfCaptureEntry
+    : public PrintableRow<ModelDetail, AcceleratorDetail, PerfDetail, RunDetail,
+                          CompilationDetail> {
+  PerfCaptureEntry() = default;
+
+  ModelDetail model = {};
+  AcceleratorDetail accelerator = {};
+  PerfDetail perf = {};
+  RunDetail run = {};
+  CompilationDetail compilation = {};
+
+ private:
+  Printables GetPrintables() const override {
+    return Printables{std::cref(model), std::cref(accelerator),
+                      std::cref(perf), std::cref(run), std::cref(compilation)};
+  }
+
+  std::string Name() const override { return model.name; }
+};
+
+// Contains a collection of PerfCaptureEntry.
+class PerfCapture : public PrintableCollection<PerfCaptureEntry> {
+ public:
+  using Entry = PerfCaptureEntry;
+
+  // The samples of the tests that ran successfully, as a baseline for future
+  // runs.
+  PerfBaseline Baseline() const {
+    PerfBaseline res;
+    for (const auto& row : Rows()) {
+      if (row.run.status != RunStatus::kOk || row.perf.Samples().empty()) {
+        continue;
+      }
+      res.Set(row.perf.key, row.perf.Samples());
+    }
+    return res;
+  }
+
+ private:
+  absl::string_view Name() const override { return "Ats Perf Results"; }
+};
+
+}  // namespace litert::testing
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_CAPTURE_H_
@@ -0,0 +1,143 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_FIXTURE_H_
+#define THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_FIXTURE_H_
+
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <ratio>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "litert/ats/common.h"
+#include "litert/ats/configure.h"
+#include "litert/ats/executor.h"
+#include "litert/ats/inference_fixture.h"
+#include "litert/ats/perf.h"
+#include "litert/ats/perf_capture.h"
+#include "litert/c/internal/litert_logging.h"  // IWYU pragma: keep
+#include "litert/cc/internal/litert_c_types_printing.h"  // IWYU pragma: keep
+#include "litert/core/model/model.h"
+#include "litert/test/generators/common.h"
+#include "litert/test/matchers.h"
+#include "litert/test/rng_fixture.h"
+
+namespace litert::testing {
+
+// Fixture for tests that microbenchmark execution of a given graph on the
+// target backend and compare the latencies against a baseline. Numerics are
+// not checked, that is the job of the inference tests.
+class AtsPerfTest : public RngTest {
+ public:
+  using Capture = PerfCapture;
+
+  static constexpr absl::string_view Name() { return "perf"; }
+
+  static void Register(TestGraph::Ptr graph, const AtsConf& conf,
+                       const TestNames& names, typename Capture::Entry& cap) {
+    RegisterTest(names.suite.c_str(), names.test.c_str(), nullptr, nullptr,
+                 __FILE__, __LINE__,
+                 [graph = std::move(graph), &conf = std::as_const(conf), &cap,
+                  names]() mutable {
+                   return new AtsPerfTest(std::move(graph), conf, names, cap);
+                 });
+  }
+
+  void SetUp() override {
+    ASSERT_EQ(Graph().NumSubgraphs(), 1);
+    cap_.model.SetFields(names_, Graph());
+    cap_.perf.key = PerfBaseline::Key(names_);
+    cap_.run.num_iterations = Perf().trials * Perf().runs_per_trial;
+  }
+
+  void TestBody() override {
+    auto device = this->TracedDevice(conf_.DataSeed());
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto exec, MakeTargetExecutor(conf_, Graph(), cap_.compilation));
+    // Latency shouldn't depend on the data, so every run uses the same inputs.
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto inputs, graph_->MakeInputs(device, conf_.DataBuilder()));
+
+    for (size_t i = 0; i < Perf().warmup_runs; ++i) {
+      LITERT_ASSERT_OK(exec->Run(inputs));
+    }
+
+    std::vector<double> samples;
+    samples.reserve(Perf().trials);
+    for (auto _ : this->FuzzBlock(Perf().trials, conf_.MaxMsPerTest())) {
+      const auto start = Clock::now();
+      for (size_t i = 0; i < Perf().runs_per_trial; ++i) {
+        LITERT_ASSERT_OK(exec->Run(inputs));
+      }
+      const std::chrono::duration<double, std::micro> elapsed =
+          Clock::now() - start;
+      samples.push_back(elapsed.count() / Perf().runs_per_trial);
+    }
+    cap_.perf.SetSamples(std::move(samples));
+
+    CheckBaseline();
+  }
+
+  void TearDown() override {
+    cap_.accelerator.SetFields(conf_);
+    if (HasFailure()) {
+      cap_.run.status = RunStatus::kError;
+    } else if (TimedOut()) {
+      cap_.run.status = RunStatus::kTimeout;
+    } else {
+      cap_.run.status = RunStatus::kOk;
+    }
+  }
+
+ private:
+  void CheckBaseline() {
+    const auto* baseline = Perf().baseline.Find(cap_.perf.key);
+    if (baseline == nullptr) {
+      if (Perf().baseline.Size() > 0) {
+        LITERT_LOG(LITERT_WARNING, "No perf baseline for %s",
+                   cap_.perf.key.c_str());
+      }
+      return;
+    }
+    const auto verdict = ComparePerf(cap_.perf.Samples(), *baseline,
+                                     Perf().threshold, Perf().alpha);
+    cap_.perf.SetVerdict(verdict);
+    EXPECT_FALSE(verdict.regressed) << absl::StrFormat(
+        "Median latency regressed from %.2fus to %.2fus (x%.2f, p=%.2g)",
+        verdict.baseline_median, verdict.median, verdict.ratio,
+        verdict.p_value);
+  }
+
+  const PerfConf& Perf() const { return conf_.Perf(); }
+
+  LiteRtModelT& Graph() const { return graph_->Graph(); }
+
+  AtsPerfTest(TestGraph::Ptr graph, const AtsConf& conf,
+              const TestNames& names, typename Capture::Entry& cap)
+      : graph_(std::move(graph)), conf_(conf), names_(names), cap_(cap) {}
+
+  TestGraph::Ptr graph_;
+  const AtsConf& conf_;
+  TestNames names_;
+  typename Capture::Entry& cap_;
+};
+
+}  // namespace litert::testing
+
+#endif  // THIRD_PARTY_ODML_LITERT_LITERT_ATS_PERF_FIXTURE_H_
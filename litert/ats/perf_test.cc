@@ -0,0 +1,114 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/ats/perf.h"
+
+#include <fstream>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "litert/ats/common.h"
+#include "litert/core/filesystem.h"
+#include "litert/test/common.h"
+#include "litert/test/matchers.h"
+
+namespace litert::testing {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pointee;
+
+TEST(AtsPerf, Median) {
+  EXPECT_EQ(Median({}), 0.0);
+  EXPECT_EQ(Median({3.0, 1.0, 2.0}), 2.0);
+  EXPECT_EQ(Median({4.0, 1.0, 3.0, 2.0}), 2.5);
+}
+
+TEST(AtsPerf, MannWhitneySeparated) {
+  const std::vector<double> slow = {6, 7, 8, 9, 10};
+  const std::vector<double> fast = {1, 2, 3, 4, 5};
+  // U = 25, z = 12 / sqrt(275 / 12).
+  EXPECT_NEAR(MannWhitneyGreaterPValue(slow, fast), 0.0061, 1e-4);
+  EXPECT_NEAR(MannWhitneyGreaterPValue(fast, slow), 0.9967, 1e-4);
+}
+
+TEST(AtsPerf, MannWhitneyTies) {
+  const std::vector<double> same = {1, 1, 1, 1};
+  EXPECT_EQ(MannWhitneyGreaterPValue(same, same), 1.0);
+  EXPECT_EQ(MannWhitneyGreaterPValue(same, {}), 1.0);
+
+  const std::vector<double> a = {2, 2, 3, 3};
+  const std::vector<double> b = {1, 1, 2, 2};
+  const double p = MannWhitneyGreaterPValue(a, b);
+  EXPECT_GT(p, 0.0);
+  EXPECT_LT(p, 0.05);
+}
+
+TEST(AtsPerf, ComparePerf) {
+  const std::vector<double> baseline = {10, 11, 10, 9, 10, 11, 10, 9, 10, 10};
+  std::vector<double> slower;
+  for (const auto s : baseline) {
+    slower.push_back(s * 1.5);
+  }
+
+  const auto regressed = ComparePerf(slower, baseline, /*threshold=*/0.1,
+                                     /*alpha=*/0.01);
+  EXPECT_DOUBLE_EQ(regressed.ratio, 1.5);
+  EXPECT_TRUE(regressed.regressed);
+
+  // Significant, but under the threshold.
+  const auto under_threshold = ComparePerf(slower, baseline,
+                                           /*threshold=*/0.6, /*alpha=*/0.01);
+  EXPECT_FALSE(under_threshold.regressed);
+
+  // Over the threshold, but not significant.
+  const auto noisy = ComparePerf({30, 9, 12}, {10, 10, 11},
+                                 /*threshold=*/0.1, /*alpha=*/0.01);
+  EXPECT_DOUBLE_EQ(noisy.ratio, 1.2);
+  EXPECT_FALSE(noisy.regressed);
+
+  const auto faster = ComparePerf(baseline, slower, /*threshold=*/0.1,
+                                  /*alpha=*/0.01);
+  EXPECT_FALSE(faster.regressed);
+}
+
+TEST(AtsPerf, BaselineRoundTrip) {
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, UniqueTestDirectory::Create());
+  const auto path = internal::Join({dir.Str(), "baseline.txt"});
+
+  PerfBaseline baseline;
+  baseline.Set(PerfBaseline::Key(TestNames{"suite", "test\tname", "", ""}),
+               {1.5, 2.25});
+  baseline.Set("other", {3.0});
+  LITERT_ASSERT_OK(baseline.Save(path));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto loaded, PerfBaseline::Load(path));
+  EXPECT_EQ(loaded.Size(), 2);
+  EXPECT_THAT(loaded.Find("suite.test name"), Pointee(ElementsAre(1.5, 2.25)));
+  EXPECT_THAT(loaded.Find("other"), Pointee(ElementsAre(3.0)));
+  EXPECT_EQ(loaded.Find("missing"), nullptr);
+}
+
+TEST(AtsPerf, BaselineErrors) {
+  EXPECT_FALSE(PerfBaseline::Load("/does/not/exist"));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto dir, UniqueTestDirectory::Create());
+  const auto path = internal::Join({dir.Str(), "baseline.txt"});
+  std::ofstream(path) << "test\t1.0,abc\n";
+  EXPECT_FALSE(PerfBaseline::Load(path));
+}
+
+}  // namespace
+}  // namespace litert::testing
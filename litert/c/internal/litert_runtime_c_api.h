@@ -295,6 +295,24 @@ typedef struct LiteRtRuntimeCApiStruct {
       size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
       size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
       bool* async);
+  // litert_compiled_model.h: LiteRtRunCompiledModelPipelined
+  LiteRtStatus (*litert_run_compiled_model_pipelined)(
+      LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+      size_t num_inferences, size_t num_input_buffers,
+      LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+      LiteRtTensorBuffer* output_buffers, size_t max_in_flight);
+  // litert_compiled_model.h: LiteRtRunCompiledModelWithDeadline
+  LiteRtStatus (*litert_run_compiled_model_with_deadline)(
+      LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+      size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+      size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+      int64_t deadline_ns);
+  // litert_compiled_model.h: LiteRtEnableCompiledModelCancellation
+  LiteRtStatus (*litert_enable_compiled_model_cancellation)(
+      LiteRtCompiledModel compiled_model);
+  // litert_compiled_model.h: LiteRtCancelCompiledModel
+  LiteRtStatus (*litert_cancel_compiled_model)(
+      LiteRtCompiledModel compiled_model);
   // litert_compiled_model.h: LiteRtSetCompiledModelCancellationFunction
   LiteRtStatus (*litert_set_compiled_model_cancellation_function)(
       LiteRtCompiledModel compiled_model, void* data,
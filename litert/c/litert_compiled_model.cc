@@ -16,7 +16,9 @@
 
 #include <stddef.h>
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdarg>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -177,6 +179,67 @@ LiteRtStatus LiteRtRunCompiledModelAsync(LiteRtCompiledModel compiled_model,
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtRunCompiledModelPipelined(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_inferences, size_t num_input_buffers,
+    LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+    LiteRtTensorBuffer* output_buffers, size_t max_in_flight) {
+  if (!compiled_model ||
+      (num_inferences > 0 && num_input_buffers > 0 && !input_buffers) ||
+      (num_inferences > 0 && num_output_buffers > 0 && !output_buffers)) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  auto res = compiled_model->RunPipelinedCApi(
+      signature_index, num_inferences, num_input_buffers, input_buffers,
+      num_output_buffers, output_buffers, max_in_flight);
+  if (!res) {
+    LITERT_LOG(LITERT_ERROR, "%s", res.Error().Message().c_str());
+    return res.Error().Status();
+  }
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtRunCompiledModelWithDeadline(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+    size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+    int64_t deadline_ns) {
+  if (!compiled_model || (num_input_buffers > 0 && !input_buffers) ||
+      (num_output_buffers > 0 && !output_buffers)) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+
+  const std::chrono::steady_clock::time_point deadline(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::nanoseconds(deadline_ns)));
+  auto res = compiled_model->RunWithDeadlineCApi(
+      signature_index, num_input_buffers, input_buffers, num_output_buffers,
+      output_buffers, deadline);
+  if (!res) {
+    LITERT_LOG(LITERT_ERROR, "%s", res.Error().Message().c_str());
+    return res.Error().Status();
+  }
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtEnableCompiledModelCancellation(
+    LiteRtCompiledModel compiled_model) {
+  if (!compiled_model) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  LITERT_RETURN_IF_ERROR(compiled_model->EnableCancellation());
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtCancelCompiledModel(LiteRtCompiledModel compiled_model) {
+  if (!compiled_model) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  LITERT_RETURN_IF_ERROR(compiled_model->Cancel());
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtSetCompiledModelCancellationFunction(
     LiteRtCompiledModel compiled_model, void* data,
     bool (*check_cancelled_func)(void*)) {
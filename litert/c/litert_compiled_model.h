@@ -16,6 +16,7 @@
 #define ODML_LITERT_LITERT_C_LITERT_COMPILED_MODEL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_layout.h"
@@ -166,6 +167,51 @@ LiteRtStatus LiteRtRunCompiledModelAsync(
     size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
     size_t num_output_buffers, LiteRtTensorBuffer* output_buffers, bool* async);
 
+// Runs `num_inferences` independent inferences of the given signature and
+// returns once all of them have completed. The CPU ops of some inferences run
+// while the NPU executes others, with up to `max_in_flight` inferences in
+// flight at any time. If the NPU can't be dispatched asynchronously, then the
+// inferences run one after the other. Note that:
+//
+// - `input_buffers` holds `num_inferences * num_input_buffers` buffers, the
+//   input buffers of the first inference followed by those of the second
+//   inference, and so on. The same holds for `output_buffers`.
+//
+// - The buffer contents are copied, hence every buffer must be lockable on the
+//   CPU. The signature inputs and outputs must not have been bound to tensor
+//   buffers by a previous LiteRtRunCompiledModel() call.
+//
+// - The model must not have dynamic tensor shapes.
+LiteRtStatus LiteRtRunCompiledModelPipelined(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_inferences, size_t num_input_buffers,
+    LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+    LiteRtTensorBuffer* output_buffers, size_t max_in_flight);
+
+// Runs the model like LiteRtRunCompiledModel(), but the execution stops once
+// `deadline_ns` has passed and then fails with
+// kLiteRtStatusErrorTimeoutExpired. The deadline is absolute, in nanoseconds
+// on the clock of std::chrono::steady_clock (CLOCK_MONOTONIC on Linux and
+// Android). CPU kernels stop between ops, loop iterations or GEMM chunks, a
+// delegated partition isn't interrupted once it started. The compiled model
+// can be run again right away, without re-allocating its tensors.
+LiteRtStatus LiteRtRunCompiledModelWithDeadline(
+    LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+    size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+    size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+    int64_t deadline_ns);
+
+// Enables cancellation of in flight executions with
+// LiteRtCancelCompiledModel().
+LiteRtStatus LiteRtEnableCompiledModelCancellation(
+    LiteRtCompiledModel compiled_model);
+
+// Cancels the in flight execution of the compiled model, if any, which then
+// fails with kLiteRtStatusCancelled. Executions started afterwards are not
+// affected. Non blocking and thread safe. Fails if cancellation wasn't enabled
+// with LiteRtEnableCompiledModelCancellation().
+LiteRtStatus LiteRtCancelCompiledModel(LiteRtCompiledModel compiled_model);
+
 // Sets a callback function that will be called periodically during model
 // execution to check if the execution should be cancelled.
 //
@@ -25,6 +25,7 @@
 struct LiteRtCompilerOptionsT {
   LiteRtCompilerOptionsPartitionStrategy partition_strategy =
       kLiteRtCompilerOptionsPartitionStrategyDefault;
+  int num_compile_threads = 1;
   bool dummy_option = false;
 };
 
@@ -44,6 +45,7 @@ LiteRtStatus LiteRtCreateCompilerOptions(LiteRtOpaqueOptions* options) {
     const LiteRtCompilerOptionsT* options =
         reinterpret_cast<const LiteRtCompilerOptionsT*>(payload);
     uint64_t ans = 0;
+    litert::HashCombine(ans, options->num_compile_threads);
     litert::HashCombine(ans, options->dummy_option);
     return ans;
   };
@@ -88,6 +90,24 @@ LiteRtStatus LiteRtGetCompilerOptionsPartitionStrategy(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtSetCompilerOptionsNumCompileThreads(
+    LiteRtCompilerOptions options, int num_compile_threads) {
+  if (options == nullptr || num_compile_threads < 1) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  options->num_compile_threads = num_compile_threads;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCompilerOptionsNumCompileThreads(
+    LiteRtCompilerOptionsConst options, int* num_compile_threads) {
+  if (options == nullptr || num_compile_threads == nullptr) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  *num_compile_threads = options->num_compile_threads;
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtSetDummyCompilerOptions(LiteRtCompilerOptions options,
                                            bool dummy_option) {
   if (options == nullptr) {
@@ -61,6 +61,18 @@ LiteRtStatus LiteRtGetCompilerOptionsPartitionStrategy(
     LiteRtCompilerOptionsConst options,
     LiteRtCompilerOptionsPartitionStrategy* partition_strategy);
 
+// Sets the number of threads that compile the partitions of a model. With more
+// than one thread, every partition is compiled with a separate invocation of
+// the compiler plugin, each thread using an instance of the plugin of its own.
+// The byte code of the partitions is attached to the model in partition order
+// regardless. Only plugins that implement LiteRtCompilerPluginCompilePartition
+// compile in parallel, others ignore this option. Defaults to 1.
+LiteRtStatus LiteRtSetCompilerOptionsNumCompileThreads(
+    LiteRtCompilerOptions options, int num_compile_threads);
+
+LiteRtStatus LiteRtGetCompilerOptionsNumCompileThreads(
+    LiteRtCompilerOptionsConst options, int* num_compile_threads);
+
 // Dummy options for testing.
 LiteRtStatus LiteRtSetDummyCompilerOptions(LiteRtCompilerOptions options,
                                            bool dummy_option);
@@ -89,6 +89,29 @@ TEST(LiteRtCompilerOptionsTest, SetAndGetWCPartitionStrategy) {
   LiteRtDestroyOpaqueOptions(options);
 }
 
+TEST(LiteRtCompilerOptionsTest, SetAndGetNumCompileThreads) {
+  LiteRtOpaqueOptions options;
+  LITERT_ASSERT_OK(LiteRtCreateCompilerOptions(&options));
+  LiteRtCompilerOptions compiler_options;
+  LITERT_ASSERT_OK(LiteRtFindCompilerOptions(options, &compiler_options));
+
+  int num_compile_threads;
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsNumCompileThreads(
+      compiler_options, &num_compile_threads));
+  EXPECT_EQ(num_compile_threads, 1);
+
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsNumCompileThreads(compiler_options, 4));
+  LITERT_ASSERT_OK(LiteRtGetCompilerOptionsNumCompileThreads(
+      compiler_options, &num_compile_threads));
+  EXPECT_EQ(num_compile_threads, 4);
+
+  EXPECT_NE(LiteRtSetCompilerOptionsNumCompileThreads(compiler_options, 0),
+            kLiteRtStatusOk);
+
+  LiteRtDestroyOpaqueOptions(options);
+}
+
 TEST(LiteRtCompilerOptionsTest, Hash) {
   LiteRtOpaqueOptions options1;
   LITERT_ASSERT_OK(LiteRtCreateCompilerOptions(&options1));
@@ -101,6 +124,15 @@ TEST(LiteRtCompilerOptionsTest, Hash) {
   EXPECT_EQ(hash1, hash2);
 
   LiteRtCompilerOptions compiler_options;
+  LITERT_ASSERT_OK(LiteRtFindCompilerOptions(options2, &compiler_options));
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsNumCompileThreads(compiler_options, 4));
+  LITERT_ASSERT_OK(LiteRtGetOpaqueOptionsHash(options1, &hash1));
+  LITERT_ASSERT_OK(LiteRtGetOpaqueOptionsHash(options2, &hash2));
+  EXPECT_NE(hash1, hash2);
+  LITERT_ASSERT_OK(
+      LiteRtSetCompilerOptionsNumCompileThreads(compiler_options, 1));
+
   LITERT_ASSERT_OK(LiteRtFindCompilerOptions(options1, &compiler_options));
   LITERT_ASSERT_OK(LiteRtSetDummyCompilerOptions(compiler_options, true));
   LITERT_ASSERT_OK(LiteRtSetCompilerOptionsPartitionStrategy(
@@ -128,3 +128,21 @@ LiteRtStatus LiteRtGetCpuOptionsXnnPackWeightCacheFileDescriptor(
   *fd = options->xnn.weight_cache_file_descriptor;
   return kLiteRtStatusOk;
 }
+
+LiteRtStatus LiteRtSetCpuOptionsTuningStoragePath(LiteRtCpuOptions options,
+                                                  const char* path) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  options->tuning_storage_path = path;
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus LiteRtGetCpuOptionsTuningStoragePath(
+    LiteRtCpuOptionsConst options, const char** const path) {
+  LITERT_RETURN_IF_ERROR(options, litert::ErrorStatusBuilder::InvalidArgument())
+      << "options is null.";
+  LITERT_RETURN_IF_ERROR(path, litert::ErrorStatusBuilder::InvalidArgument())
+      << "path is null.";
+  *path = options->tuning_storage_path;
+  return kLiteRtStatusOk;
+}
@@ -74,6 +74,23 @@ LiteRtStatus LiteRtSetCpuOptionsXnnPackWeightCacheFileDescriptor(
 LiteRtStatus LiteRtGetCpuOptionsXnnPackWeightCacheFileDescriptor(
     LiteRtCpuOptionsConst options, int* fd);
 
+// Sets the mini-benchmark storage path of the model, to apply the CPU
+// configuration found for it by the CPU autotuner on this type of host. When
+// tuning results exist, they replace the number of threads and XNNPack flags,
+// enable the weight cache if it helped and none was set, and restrict the
+// XNNPack worker threads to the tuned cores. Neither `options` nor the
+// affinity of the calling thread are changed. Without results, the options
+// are used as they are.
+// The `path` string is owned by the caller and must outlive the `options`
+// object.
+LiteRtStatus LiteRtSetCpuOptionsTuningStoragePath(LiteRtCpuOptions options,
+                                                  const char* path);
+
+// Gets the mini-benchmark storage path of the model set with
+// LiteRtSetCpuOptionsTuningStoragePath(), or null.
+LiteRtStatus LiteRtGetCpuOptionsTuningStoragePath(
+    LiteRtCpuOptionsConst options, const char** path);
+
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -236,4 +236,28 @@ TEST_F(LiteRtCpuOptionsFieldsTest,
       IsError(kLiteRtStatusErrorInvalidArgument));
 }
 
+TEST_F(LiteRtCpuOptionsFieldsTest, SetAndGetTuningStoragePath) {
+  const absl::string_view expected_path = "a/path/to/the/storage.fb";
+  const char* path = "not null";
+
+  LITERT_EXPECT_OK(LiteRtGetCpuOptionsTuningStoragePath(cpu_options_, &path));
+  ASSERT_EQ(path, nullptr);
+
+  LITERT_EXPECT_OK(
+      LiteRtSetCpuOptionsTuningStoragePath(cpu_options_, expected_path.data()));
+  LITERT_EXPECT_OK(LiteRtGetCpuOptionsTuningStoragePath(cpu_options_, &path));
+  ASSERT_EQ(path, expected_path);
+}
+
+TEST_F(LiteRtCpuOptionsFieldsTest, TuningStoragePathFailsWithInvalidArgument) {
+  const char* path = nullptr;
+  EXPECT_THAT(LiteRtSetCpuOptionsTuningStoragePath(/*options=*/nullptr,
+                                                   /*path=*/"a/path"),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(LiteRtGetCpuOptionsTuningStoragePath(/*options=*/nullptr, &path),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+  EXPECT_THAT(LiteRtGetCpuOptionsTuningStoragePath(cpu_options_, nullptr),
+              IsError(kLiteRtStatusErrorInvalidArgument));
+}
+
 }  // namespace
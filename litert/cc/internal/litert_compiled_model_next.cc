@@ -14,10 +14,12 @@
 
 #include "litert/cc/internal/litert_compiled_model_next.h"
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
 #include "absl/cleanup/cleanup.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_metrics.h"
 #include "litert/cc/internal/litert_handle.h"
@@ -27,6 +29,7 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_model.h"
 #include "litert/cc/litert_options.h"
+#include "litert/cc/litert_tensor_buffer.h"
 
 namespace litert {
 
@@ -72,6 +75,45 @@ Expected<CompiledModelNext> CompiledModelNext::Create(
                            OwnHandle::kYes);
 }
 
+Expected<void> CompiledModelNext::RunPipelined(
+    size_t signature_index,
+    absl::Span<const std::vector<TensorBuffer>> input_buffers,
+    absl::Span<const std::vector<TensorBuffer>> output_buffers,
+    size_t max_in_flight) {
+  if (input_buffers.size() != output_buffers.size()) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Number of input and output buffer sets mismatch");
+  }
+  const size_t num_inferences = input_buffers.size();
+  const size_t num_inputs = num_inferences ? input_buffers[0].size() : 0;
+  const size_t num_outputs = num_inferences ? output_buffers[0].size() : 0;
+  std::vector<LiteRtTensorBuffer> litert_input_buffers;
+  std::vector<LiteRtTensorBuffer> litert_output_buffers;
+  litert_input_buffers.reserve(num_inferences * num_inputs);
+  litert_output_buffers.reserve(num_inferences * num_outputs);
+  for (size_t i = 0; i < num_inferences; ++i) {
+    if (input_buffers[i].size() != num_inputs ||
+        output_buffers[i].size() != num_outputs) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Input or output buffer size mismatch");
+    }
+    for (const auto& buffer : input_buffers[i]) {
+      litert_input_buffers.push_back(buffer.Get());
+    }
+    for (const auto& buffer : output_buffers[i]) {
+      litert_output_buffers.push_back(buffer.Get());
+    }
+  }
+  if (auto status = env_.runtime->RunCompiledModelPipelined(
+          Get(), signature_index, num_inferences, num_inputs,
+          litert_input_buffers.data(), num_outputs,
+          litert_output_buffers.data(), max_in_flight);
+      status != kLiteRtStatusOk) {
+    return Unexpected(status, "Failed to invoke the compiled model");
+  }
+  return {};
+}
+
 Expected<void> CompiledModelNext::StartMetricsCollection(int detail_level) {
   if (auto status = env_.runtime->CompiledModelStartMetricsCollection(
           Get(), detail_level);
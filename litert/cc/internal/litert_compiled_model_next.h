@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
 #include "litert/cc/internal/litert_handle.h"
@@ -31,6 +32,7 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/cc/litert_model.h"
 #include "litert/cc/litert_options.h"
+#include "litert/cc/litert_tensor_buffer.h"
 
 /// @file
 /// @brief Defines an advanced `CompiledModel` with new and experimental
@@ -75,6 +77,23 @@ class CompiledModelNext : public CompiledModel {
   /// collected data.
   Expected<Metrics> StopMetricsCollection();
 
+  /// @brief Runs independent inferences of a signature and returns once all
+  /// of them have completed.
+  ///
+  /// The CPU ops of some inferences run while the NPU executes others. The
+  /// buffer contents are copied, and the signature I/O must not have been
+  /// bound to tensor buffers by a previous `Run()`.
+  ///
+  /// @param signature_index The zero-based index of the signature.
+  /// @param input_buffers The input buffers of each inference.
+  /// @param output_buffers The output buffers of each inference.
+  /// @param max_in_flight The maximum number of inferences in flight.
+  Expected<void> RunPipelined(
+      size_t signature_index,
+      absl::Span<const std::vector<TensorBuffer>> input_buffers,
+      absl::Span<const std::vector<TensorBuffer>> output_buffers,
+      size_t max_in_flight = 2);
+
   /// @brief Sets a dispatch annotation on the compiled model.
   ///
   /// These annotations are propagated to dispatch graphs during model
@@ -110,6 +110,12 @@ const LiteRtRuntimeCApiStruct kLiteRtRuntimeBuiltin = {
     .litert_get_compiled_model_environment = LiteRtGetCompiledModelEnvironment,
     .litert_run_compiled_model = LiteRtRunCompiledModel,
     .litert_run_compiled_model_async = LiteRtRunCompiledModelAsync,
+    .litert_run_compiled_model_pipelined = LiteRtRunCompiledModelPipelined,
+    .litert_run_compiled_model_with_deadline =
+        LiteRtRunCompiledModelWithDeadline,
+    .litert_enable_compiled_model_cancellation =
+        LiteRtEnableCompiledModelCancellation,
+    .litert_cancel_compiled_model = LiteRtCancelCompiledModel,
     .litert_set_compiled_model_cancellation_function =
         LiteRtSetCompiledModelCancellationFunction,
     .litert_destroy_compiled_model = LiteRtDestroyCompiledModel,
@@ -480,6 +480,39 @@ class RuntimeProxy {
                                output_buffers, async);
   }
 
+  LiteRtStatus RunCompiledModelPipelined(
+      LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+      size_t num_inferences, size_t num_input_buffers,
+      LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+      LiteRtTensorBuffer* output_buffers, size_t max_in_flight) {
+    LITERT_PROXY_METHOD_STATUS(litert_run_compiled_model_pipelined,
+                               compiled_model, signature_index, num_inferences,
+                               num_input_buffers, input_buffers,
+                               num_output_buffers, output_buffers,
+                               max_in_flight);
+  }
+
+  LiteRtStatus RunCompiledModelWithDeadline(
+      LiteRtCompiledModel compiled_model, LiteRtParamIndex signature_index,
+      size_t num_input_buffers, LiteRtTensorBuffer* input_buffers,
+      size_t num_output_buffers, LiteRtTensorBuffer* output_buffers,
+      int64_t deadline_ns) {
+    LITERT_PROXY_METHOD_STATUS(litert_run_compiled_model_with_deadline,
+                               compiled_model, signature_index,
+                               num_input_buffers, input_buffers,
+                               num_output_buffers, output_buffers, deadline_ns);
+  }
+
+  LiteRtStatus EnableCompiledModelCancellation(
+      LiteRtCompiledModel compiled_model) {
+    LITERT_PROXY_METHOD_STATUS(litert_enable_compiled_model_cancellation,
+                               compiled_model);
+  }
+
+  LiteRtStatus CancelCompiledModel(LiteRtCompiledModel compiled_model) {
+    LITERT_PROXY_METHOD_STATUS(litert_cancel_compiled_model, compiled_model);
+  }
+
   LiteRtStatus SetCompiledModelCancellationFunction(
       LiteRtCompiledModel compiled_model, void* data,
       bool (*check_cancelled_func)(void*)) {
@@ -14,7 +14,9 @@
 
 #include "litert/cc/litert_compiled_model.h"
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <utility>
@@ -159,6 +161,34 @@ Expected<void> CompiledModel::RunCApiHelper(LiteRtParamIndex signature_index,
   return {};
 }
 
+Expected<void> CompiledModel::Run(
+    size_t signature_index, absl::Span<const TensorBuffer> input_buffers,
+    absl::Span<const TensorBuffer> output_buffers,
+    std::chrono::steady_clock::time_point deadline) const {
+  std::vector<LiteRtTensorBuffer> litert_input_buffers;
+  litert_input_buffers.reserve(input_buffers.size());
+  for (const auto& buffer : input_buffers) {
+    litert_input_buffers.push_back(buffer.Get());
+  }
+  std::vector<LiteRtTensorBuffer> litert_output_buffers;
+  litert_output_buffers.reserve(output_buffers.size());
+  for (const auto& buffer : output_buffers) {
+    litert_output_buffers.push_back(buffer.Get());
+  }
+  const int64_t deadline_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          deadline.time_since_epoch())
+          .count();
+  if (auto status = env_.runtime->RunCompiledModelWithDeadline(
+          Get(), signature_index, litert_input_buffers.size(),
+          litert_input_buffers.data(), litert_output_buffers.size(),
+          litert_output_buffers.data(), deadline_ns);
+      status != kLiteRtStatusOk) {
+    return Unexpected(status, "Failed to invoke the compiled model");
+  }
+  return {};
+}
+
 Expected<void> CompiledModel::RunHelper(
     size_t signature_index, absl::Span<const TensorBuffer> input_buffers,
     absl::Span<const TensorBuffer> output_buffers, bool& async) const {
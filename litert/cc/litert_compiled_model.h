@@ -15,6 +15,7 @@
 #ifndef ODML_LITERT_LITERT_CC_LITERT_COMPILED_MODEL_H_
 #define ODML_LITERT_LITERT_CC_LITERT_COMPILED_MODEL_H_
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -425,6 +426,26 @@ class CompiledModel : public internal::BaseHandle<LiteRtCompiledModel> {
                      async);
   }
 
+  /// @brief Runs the model for a given signature index synchronously, and
+  /// stops once `deadline` has passed.
+  ///
+  /// A run that exceeds its deadline fails with
+  /// `kLiteRtStatusErrorTimeoutExpired`. CPU kernels stop between ops, loop
+  /// iterations or GEMM chunks; a delegated partition isn't interrupted once it
+  /// started. The model can be run again right away, without re-allocating.
+  Expected<void> Run(size_t signature_index,
+                     absl::Span<const TensorBuffer> input_buffers,
+                     absl::Span<const TensorBuffer> output_buffers,
+                     std::chrono::steady_clock::time_point deadline) const;
+
+  /// @brief Runs the model for the default signature synchronously, and stops
+  /// once `deadline` has passed.
+  Expected<void> Run(absl::Span<const TensorBuffer> input_buffers,
+                     absl::Span<const TensorBuffer> output_buffers,
+                     std::chrono::steady_clock::time_point deadline) const {
+    return Run(/*signature_index=*/0, input_buffers, output_buffers, deadline);
+  }
+
   /// @brief Runs the model for a given signature index asynchronously, if
   /// possible, with the provided input/output `TensorBuffer`s.
   ///
@@ -553,6 +574,23 @@ class CompiledModel : public internal::BaseHandle<LiteRtCompiledModel> {
   /// C++-friendly version of `SetCancellationFunction`.
   void SetCancellationFunction(absl::AnyInvocable<bool()> check_cancelled_func);
 
+  /// @brief Enables cancellation of in flight runs with `Cancel`.
+  Expected<void> EnableCancellation() {
+    LITERT_RETURN_IF_ERROR(
+        env_.runtime->EnableCompiledModelCancellation(Get()));
+    return {};
+  }
+
+  /// @brief Cancels the in flight run, if any, which then fails with
+  /// `kLiteRtStatusCancelled`.
+  ///
+  /// Runs started afterwards are not affected. Non blocking and thread safe.
+  /// Fails if cancellation wasn't enabled with `EnableCancellation`.
+  Expected<void> Cancel() const {
+    LITERT_RETURN_IF_ERROR(env_.runtime->CancelCompiledModel(Get()));
+    return {};
+  }
+
   /// @brief Resizes the specified input tensor to support dynamic shapes.
   ///
   /// This function mirrors TFLite's `ResizeInputTensorStrict` API and requires
@@ -14,7 +14,15 @@
 
 #include "litert/cc/litert_compiled_model.h"
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <unistd.h>
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,11 +31,14 @@
 #include <gtest/gtest.h>
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "absl/strings/str_format.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/c/options/litert_cpu_options.h"
 #include "litert/cc/litert_common.h"
 #include "litert/cc/litert_element_type.h"
 #include "litert/cc/litert_environment.h"
@@ -41,10 +52,14 @@
 #include "litert/cc/litert_tensor_buffer.h"
 #include "litert/cc/litert_tensor_buffer_requirements.h"
 #include "litert/cc/litert_tensor_buffer_types.h"
+#include "litert/cc/options/litert_cpu_options.h"
 #include "litert/cc/options/litert_runtime_options.h"
 #include "litert/test/common.h"
 #include "litert/test/matchers.h"
 #include "litert/test/testdata/simple_model_test_vectors.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
 
 using ::testing::ElementsAre;
 using ::testing::FloatNear;
@@ -396,6 +411,156 @@ TEST(CompiledModelTest, RunAsyncReturnsFalse) {
     EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
   }
 }
+
+TEST(CompiledModelTest, RunWithDeadline) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> output_buffers,
+                              compiled_model.CreateOutputBuffers());
+  ASSERT_TRUE(input_buffers[0].Write<float>(
+      absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+  ASSERT_TRUE(input_buffers[1].Write<float>(
+      absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+
+  // A deadline that has already passed times out without running.
+  EXPECT_THAT(
+      compiled_model.Run(input_buffers, output_buffers,
+                         std::chrono::steady_clock::now() -
+                             std::chrono::seconds(1)),
+      ::testing::litert::IsError(kLiteRtStatusErrorTimeoutExpired));
+
+  // The model stays usable after a timeout.
+  LITERT_ASSERT_OK(compiled_model.Run(
+      input_buffers, output_buffers,
+      std::chrono::steady_clock::now() + std::chrono::hours(1)));
+  {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto lock_and_addr,
+        litert::TensorBufferScopedLock::Create<const float>(
+            output_buffers[0], TensorBuffer::LockMode::kRead));
+    auto output = absl::MakeSpan(lock_and_addr.second, kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+  }
+}
+
+TEST(CompiledModelTest, CancelRequiresEnableCancellation) {
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            HwAccelerators::kCpu));
+
+  EXPECT_FALSE(compiled_model.Cancel());
+  LITERT_ASSERT_OK(compiled_model.EnableCancellation());
+  LITERT_EXPECT_OK(compiled_model.Cancel());
+
+  // A cancel that arrives between runs doesn't affect the next run.
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> output_buffers,
+                              compiled_model.CreateOutputBuffers());
+  ASSERT_TRUE(input_buffers[0].Write<float>(
+      absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+  ASSERT_TRUE(input_buffers[1].Write<float>(
+      absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  LITERT_EXPECT_OK(compiled_model.Run(input_buffers, output_buffers));
+}
+
+TEST(CompiledModelTest, AppliesCpuTuningResult) {
+  using ::tflite::acceleration::CpuTuningResult;
+  // Store tuning results as the CPU autotuner would.
+  const std::string storage_path =
+      absl::StrCat(::testing::TempDir(), "/applies_cpu_tuning_result.fb");
+  unlink(tflite::acceleration::CpuTuningResultsPath(storage_path).c_str());
+  const std::string weight_cache_path =
+      absl::StrCat(::testing::TempDir(), "/applies_cpu_tuning_result.cache");
+  unlink(weight_cache_path.c_str());
+  CpuTuningResult result;
+  result.config.num_threads = 2;
+  result.config.weight_cache_file_path = weight_cache_path;
+  const uint64_t mask = tflite::acceleration::GetCurrentThreadAffinity();
+  result.config.affinity_mask = mask & -mask;
+  result.inference_time_us = 1000;
+  result.number_of_source_events = 1;
+  tflite::BenchmarkEventT event;
+  event.tflite_settings = std::make_unique<tflite::TFLiteSettingsT>();
+  tflite::acceleration::CpuTuningConfigToSettings(result.config,
+                                                  event.tflite_settings.get());
+  event.event_type = tflite::BenchmarkEventType_END;
+  event.result = std::make_unique<tflite::BenchmarkResultT>();
+  event.result->ok = true;
+  event.result->inference_time_us = {1000};
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(tflite::BenchmarkEvent::Pack(fbb, &event));
+  ASSERT_EQ(tflite::acceleration::StoreCpuTuningResult(
+                storage_path,
+                *flatbuffers::GetRoot<tflite::BenchmarkEvent>(
+                    fbb.GetBufferPointer()),
+                result),
+            tflite::acceleration::kMinibenchmarkSuccess);
+
+#if defined(__linux__)
+  cpu_set_t affinity_before;
+  CPU_ZERO(&affinity_before);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(affinity_before), &affinity_before),
+            0);
+#endif  // __linux__
+
+  LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
+  LITERT_ASSERT_OK_AND_ASSIGN(Options compilation_options, Options::Create());
+  compilation_options.SetHardwareAccelerators(HwAccelerators::kCpu);
+  LITERT_ASSERT_OK_AND_ASSIGN(auto& cpu_options,
+                              compilation_options.GetCpuOptions());
+  LITERT_ASSERT_OK(cpu_options.SetTuningStoragePath(storage_path.c_str()));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      CompiledModel compiled_model,
+      CompiledModel::Create(env, testing::GetTestFilePath(kModelFileName),
+                            compilation_options));
+
+  // The tuned weight cache is used without being written into the options.
+  EXPECT_EQ(access(weight_cache_path.c_str(), F_OK), 0);
+  LITERT_ASSERT_OK_AND_ASSIGN(OpaqueOptions opaque_options,
+                              compilation_options.GetOpaqueOptions());
+  LiteRtCpuOptions applied_cpu_options;
+  LITERT_ASSERT_OK(
+      LiteRtFindCpuOptions(opaque_options.Get(), &applied_cpu_options));
+  const char* applied_weight_cache_path = nullptr;
+  LITERT_ASSERT_OK(LiteRtGetCpuOptionsXnnPackWeightCachePath(
+      applied_cpu_options, &applied_weight_cache_path));
+  EXPECT_EQ(applied_weight_cache_path, nullptr);
+#if defined(__linux__)
+  // Only the delegate's worker threads are restricted to the tuned cores.
+  cpu_set_t affinity_after;
+  CPU_ZERO(&affinity_after);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(affinity_after), &affinity_after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&affinity_before, &affinity_after));
+#endif  // __linux__
+
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(std::vector<TensorBuffer> output_buffers,
+                              compiled_model.CreateOutputBuffers());
+  ASSERT_TRUE(input_buffers[0].Write<float>(
+      absl::MakeConstSpan(kTestInput0Tensor, kTestInput0Size)));
+  ASSERT_TRUE(input_buffers[1].Write<float>(
+      absl::MakeConstSpan(kTestInput1Tensor, kTestInput1Size)));
+  LITERT_ASSERT_OK(compiled_model.Run(input_buffers, output_buffers));
+  {
+    LITERT_ASSERT_OK_AND_ASSIGN(
+        auto lock_and_addr,
+        litert::TensorBufferScopedLock::Create<const float>(
+            output_buffers[0], TensorBuffer::LockMode::kRead));
+    auto output = absl::MakeSpan(lock_and_addr.second, kTestOutputSize);
+    EXPECT_THAT(output, Pointwise(FloatNear(1e-5), kTestOutputTensor));
+  }
+}
+
 TEST(CompiledModelTest, WithProfiler) {
   // Environment setup.
   LITERT_ASSERT_OK_AND_ASSIGN(Environment env, litert::Environment::Create({}));
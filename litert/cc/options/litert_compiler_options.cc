@@ -60,6 +60,23 @@ CompilerOptions::GetPartitionStrategy() const {
   return partition_strategy;
 }
 
+Expected<void> CompilerOptions::SetNumCompileThreads(int num_compile_threads) {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  LITERT_RETURN_IF_ERROR(LiteRtSetCompilerOptionsNumCompileThreads(
+      compiler_options, num_compile_threads));
+  return {};
+}
+
+Expected<int> CompilerOptions::GetNumCompileThreads() const {
+  LiteRtCompilerOptions compiler_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
+  int num_compile_threads;
+  LITERT_RETURN_IF_ERROR(LiteRtGetCompilerOptionsNumCompileThreads(
+      compiler_options, &num_compile_threads));
+  return num_compile_threads;
+}
+
 Expected<void> CompilerOptions::SetDummyOption(bool dummy_option) {
   LiteRtCompilerOptions compiler_options;
   LITERT_RETURN_IF_ERROR(LiteRtFindCompilerOptions(Get(), &compiler_options));
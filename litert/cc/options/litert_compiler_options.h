@@ -38,6 +38,11 @@ class CompilerOptions : public OpaqueOptions {
       LiteRtCompilerOptionsPartitionStrategy partition_strategy);
   Expected<LiteRtCompilerOptionsPartitionStrategy> GetPartitionStrategy() const;
 
+  /// @brief Sets the number of threads that compile the partitions of a
+  /// model. See `LiteRtSetCompilerOptionsNumCompileThreads`.
+  Expected<void> SetNumCompileThreads(int num_compile_threads);
+  Expected<int> GetNumCompileThreads() const;
+
   Expected<void> SetDummyOption(bool dummy_option);
   Expected<bool> GetDummyOption() const;
 };
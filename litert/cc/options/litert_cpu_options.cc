@@ -113,4 +113,21 @@ Expected<int> CpuOptions::GetXNNPackWeightCacheFileDescriptor() const {
   return fd;
 }
 
+Expected<void> CpuOptions::SetTuningStoragePath(const char* path) {
+  LiteRtCpuOptions cpu_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCpuOptions(Get(), &cpu_options));
+  LITERT_RETURN_IF_ERROR(
+      LiteRtSetCpuOptionsTuningStoragePath(cpu_options, path));
+  return {};
+}
+
+Expected<absl::string_view> CpuOptions::GetTuningStoragePath() const {
+  LiteRtCpuOptions cpu_options;
+  LITERT_RETURN_IF_ERROR(LiteRtFindCpuOptions(Get(), &cpu_options));
+  const char* path;
+  LITERT_RETURN_IF_ERROR(
+      LiteRtGetCpuOptionsTuningStoragePath(cpu_options, &path));
+  return absl::NullSafeStringView(path);
+}
+
 }  // namespace litert
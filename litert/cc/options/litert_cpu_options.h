@@ -44,6 +44,10 @@ class CpuOptions : public OpaqueOptions {
 
   Expected<void> SetXNNPackWeightCacheFileDescriptor(int fd);
   Expected<int> GetXNNPackWeightCacheFileDescriptor() const;
+
+  // See LiteRtSetCpuOptionsTuningStoragePath().
+  Expected<void> SetTuningStoragePath(const char* path);
+  Expected<absl::string_view> GetTuningStoragePath() const;
 };
 
 }  // namespace litert
@@ -111,6 +111,16 @@ TEST(CpuOptions, SetAndGetXNNPackWeighCacheFileDescriptorWorks) {
               IsOkAndHolds(1234));
 }
 
+TEST(CpuOptions, SetAndGetTuningStoragePathWorks) {
+  LITERT_ASSERT_OK_AND_ASSIGN(CpuOptions options, CpuOptions::Create());
+  EXPECT_THAT(options.GetTuningStoragePath(),
+              IsOkAndHolds(absl::string_view()));
+
+  LITERT_EXPECT_OK(options.SetTuningStoragePath("a/storage.fb"));
+  EXPECT_THAT(options.GetTuningStoragePath(),
+              IsOkAndHolds(StrEq("a/storage.fb")));
+}
+
 TEST(CpuOptions, CheckXNNPackFlagsDefaultValue) {
   LITERT_ASSERT_OK_AND_ASSIGN(CpuOptions options, CpuOptions::Create());
   // Note: we can't check the default value for this as XNNPack compile options
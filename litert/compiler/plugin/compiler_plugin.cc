@@ -18,16 +18,16 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <optional>
-#include <queue>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
-#include "absl/algorithm/container.h"  // from @com_google_absl
 #include "absl/container/flat_hash_set.h"  // from @com_google_absl
 #include "absl/log/absl_check.h"  // from @com_google_absl
 #include "absl/strings/str_cat.h"  // from @com_google_absl
@@ -153,6 +153,13 @@ LiteRtStatus ResolvePluginApi(SharedLibrary& lib,
                    result.compiler_plugin_partition);
   RESOLVE_API_FUNC(kLiteRtCompilerPluginCompile,
                    result.compiler_plugin_compile);
+  // Optional, plugins without it always compile all partitions at once.
+  if (auto compile_partition =
+          lib.LookupSymbol<decltype(result.compiler_plugin_compile_partition)>(
+              kLiteRtCompilerPluginCompilePartition.data());
+      compile_partition) {
+    result.compiler_plugin_compile_partition = *compile_partition;
+  }
 
   RESOLVE_API_FUNC(kLiteRtDestroyCompiledResult,
                    result.destroy_compiled_result);
@@ -214,6 +221,76 @@ void SortPlugins(std::vector<CompilerPlugin>& compiler_plugins) {
             });
 }
 
+// The ops of a subgraph on which no transformation matches. The other ops form
+// the worklist of the rewrite driver.
+//
+// A pattern is expected to only look at its root op, at the producers of the
+// root op transitively, and at the users of the tensors of these ops. The set
+// is kept closed under the producer relation: an op only enters it once its
+// producers did, and an op that leaves it takes the users of its outputs
+// along, transitively.
+class NoMatchOps {
+ public:
+  bool Contains(LiteRtOp op) const { return ops_.contains(op); }
+
+  // Adds `op` if all of its producers are in the set.
+  void Insert(LiteRtOp op) {
+    for (LiteRtTensor input : op->Inputs()) {
+      LiteRtOp producer = input->DefiningOp();
+      if (producer != nullptr && !ops_.contains(producer)) {
+        return;
+      }
+    }
+    ops_.insert(op);
+  }
+
+  // Puts the ops that a rewrite at `root` recorded in `builder` can affect
+  // back on the worklist: the producers and users of the tensors of the root,
+  // erased and built ops, and the users of their outputs transitively. Must be
+  // called before the changes are applied.
+  void Invalidate(LiteRtOp root, LiteRtBuilderT& builder) {
+    std::vector<LiteRtOp> stack;
+    auto push_neighbors = [&stack](LiteRtOp op) {
+      for (auto* tensors : {&op->Inputs(), &op->Outputs()}) {
+        for (LiteRtTensor tensor : *tensors) {
+          if (tensor->DefiningOp() != nullptr) {
+            stack.push_back(tensor->DefiningOp());
+          }
+          stack.insert(stack.end(), tensor->Users().begin(),
+                       tensor->Users().end());
+        }
+      }
+    };
+    const auto erases = builder.Erases();
+    push_neighbors(root);
+    for (LiteRtOp op : erases) {
+      push_neighbors(op);
+    }
+    for (LiteRtOp op : builder.Subgraph().Ops()) {
+      push_neighbors(op);
+    }
+    // The users of an op outside of the set are outside of it as well.
+    while (!stack.empty()) {
+      LiteRtOp op = stack.back();
+      stack.pop_back();
+      if (ops_.erase(op) == 0) {
+        continue;
+      }
+      for (LiteRtTensor output : op->Outputs()) {
+        stack.insert(stack.end(), output->Users().begin(),
+                     output->Users().end());
+      }
+    }
+    // Erased ops are destroyed by ApplyChanges().
+    for (LiteRtOp op : erases) {
+      ops_.erase(op);
+    }
+  }
+
+ private:
+  absl::flat_hash_set<LiteRtOp> ops_;
+};
+
 }  // namespace
 
 Expected<CompilerPlugin> CompilerPlugin::LoadPlugin(
@@ -300,11 +377,13 @@ CompilerPlugin::CompilerPlugin(CompilerPlugin&& other)
       options_(other.options_),
       env_(std::move(other.env_)),
       plugin_api_(std::move(other.plugin_api_)),
-      plugin_handle_(std::move(other.plugin_handle_)) {
+      plugin_handle_(std::move(other.plugin_handle_)),
+      worker_handles_(std::move(other.worker_handles_)) {
   other.soc_models_ = {};
   other.plugin_api_ = {};
   other.lib_.Close();
   other.plugin_handle_ = nullptr;
+  other.worker_handles_.clear();
   other.options_ = nullptr;
   other.env_ = nullptr;
 }
@@ -316,12 +395,16 @@ CompilerPlugin& CompilerPlugin::operator=(CompilerPlugin&& other) {
     std::swap(env_, other.env_);
     std::swap(plugin_api_, other.plugin_api_);
     std::swap(plugin_handle_, other.plugin_handle_);
+    std::swap(worker_handles_, other.worker_handles_);
     std::swap(options_, other.options_);
   }
   return *this;
 }
 
 CompilerPlugin::~CompilerPlugin() {
+  for (LiteRtCompilerPlugin worker_handle : worker_handles_) {
+    plugin_api_.destroy_compiler_plugin(worker_handle);
+  }
   if (plugin_handle_ != nullptr) {
     plugin_api_.destroy_compiler_plugin(plugin_handle_);
   }
@@ -385,50 +468,47 @@ Expected<void> CompilerPlugin::GreedyPatternMatchAndRewrite(
   LITERT_LOG(LITERT_DEBUG, "GreedyPatternMatchAndRewrite, total patterns: %d",
              transformations_.size());
   for (auto& subgraph : model.Subgraphs()) {
+    // Each iteration rewrites the first op in program order that a
+    // transformation matches, but only runs the patterns on the ops whose
+    // neighborhood changed since they were last tried.
+    NoMatchOps no_match_ops;
+    size_t iterations = 0;
+    size_t num_pattern_calls = 0;
     bool subgraph_modified = true;
-    int iterations = 0;
     while (subgraph_modified) {
       subgraph_modified = false;
-      LITERT_LOG(LITERT_DEBUG, "Iteration %d", iterations);
+      LITERT_LOG(LITERT_DEBUG, "Iteration %zu", iterations);
       if (iterations++ >= max_transformation_iterations_) {
         break;
       }
-      std::queue<LiteRtOp> worklist;
-      for (const auto& op : subgraph->Ops()) {
-        worklist.push(op);
-      }
-      LITERT_LOG(LITERT_DEBUG, "Worklist size: %lu", worklist.size());
-      while (!worklist.empty()) {
-        LiteRtOp op = worklist.front();
-        worklist.pop();
-
-        // Check if the op is still in the subgraph.
-        if (!absl::c_linear_search(subgraph->Ops(), op)) {
+      const auto& ops = subgraph->Ops();
+      for (size_t i = 0; i < ops.size() && !subgraph_modified; ++i) {
+        LiteRtOp op = ops[i];
+        if (no_match_ops.Contains(op)) {
           continue;
         }
         LITERT_LOG(LITERT_DEBUG, "Matching pattern for op: %d", op->OpCode());
         for (const auto& transformation : transformations_) {
           LiteRtBuilderT builder;
-          LITERT_LOG(LITERT_DEBUG, "Matching pattern '%s'",
-                     transformation.name);
+          ++num_pattern_calls;
           // Call the function pointer.
           if (transformation.pattern(&builder, op) == kLiteRtStatusOk) {
             LITERT_LOG(LITERT_DEBUG, "Matched pattern '%s'",
                        transformation.name);
-
+            no_match_ops.Invalidate(op, builder);
             builder.ApplyChanges(subgraph);
             subgraph_modified = true;
             // Break from the inner transformation loop since the graph changed.
             break;
           }
         }
-        if (subgraph_modified) {
-          // Restart the scan for this subgraph as it has been modified.
-          LITERT_LOG(LITERT_DEBUG, "Restarting scan");
-          break;
+        if (!subgraph_modified) {
+          no_match_ops.Insert(op);
         }
       }
     }
+    LITERT_LOG(LITERT_DEBUG, "Rewrote subgraph with %zu pattern calls",
+               num_pattern_calls);
   }
   return {};
 }
@@ -464,6 +544,62 @@ Expected<CompiledResult> CompilerPlugin::Compile(LiteRtModel partitions,
   return result;
 }
 
+Expected<std::vector<CompiledResult>> CompilerPlugin::CompileInParallel(
+    LiteRtModelT& partitions, size_t num_threads,
+    absl::string_view soc_model) {
+  if (!SupportsParallelCompile()) {
+    return Unexpected(kLiteRtStatusErrorUnsupported,
+                      "Plugin can't compile partitions separately");
+  }
+  const size_t num_partitions = partitions.NumSubgraphs();
+  std::vector<LiteRtModelT> models;
+  models.reserve(num_partitions);
+  for (size_t i = 0; i < num_partitions; ++i) {
+    models.push_back(partitions.Yank({0}));
+  }
+  num_threads = std::max<size_t>(1, std::min(num_threads, num_partitions));
+  while (worker_handles_.size() + 1 < num_threads) {
+    LiteRtCompilerPlugin worker_handle;
+    LITERT_RETURN_IF_ERROR(
+        plugin_api_.create_compiler_plugin(&worker_handle, env_, options_));
+    worker_handles_.push_back(worker_handle);
+  }
+
+  const char* soc_model_str = !soc_model.empty() ? soc_model.data() : nullptr;
+  LITERT_PERFETTO_TRACE_EVENT("CompilerPlugin CompileInParallel");
+  std::vector<CompiledResult> results;
+  results.reserve(num_partitions);
+  for (size_t i = 0; i < num_partitions; ++i) {
+    results.push_back(MakeResult());
+  }
+  std::vector<LiteRtStatus> statuses(num_partitions, kLiteRtStatusOk);
+  std::atomic<size_t> next_partition = 0;
+  auto compile = [&](LiteRtCompilerPlugin handle) {
+    for (size_t i = next_partition++; i < num_partitions;
+         i = next_partition++) {
+      statuses[i] = plugin_api_.compiler_plugin_compile_partition(
+          handle, soc_model_str, &models[i], i,
+          &results[i].compiled_result_handle_);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(compile, worker_handles_[i - 1]);
+  }
+  compile(plugin_handle_);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < num_partitions; ++i) {
+    if (statuses[i] != kLiteRtStatusOk) {
+      return Unexpected(statuses[i],
+                        absl::StrFormat("Failed to compile partition %d", i));
+    }
+  }
+  return results;
+}
+
 namespace {
 
 LiteRtStatus PartitionSubgraph(
@@ -719,22 +855,16 @@ Expected<PartitionResult> PartitionModelDirect(
   return PartitionResult{std::move(dispatch_ops), std::move(new_model)};
 }
 
-Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
-                                        LiteRtModelT& model,
-                                        PartitionResult partitions,
-                                        absl::string_view soc_model) {
-  auto& dispatch_ops = partitions.first;
-  auto& sliced_model = partitions.second;
-
-  // Pass sliced subgraphs to plugin for compilation.
-  auto compiled_result = compiler_plugin.Compile(&sliced_model, soc_model);
-  if (!compiled_result) {
-    return compiled_result.Error();
-  }
+namespace {
 
+// Registers the byte code of `compiled_result` in `model` and attaches it to
+// the dispatch ops of the partitions it was compiled from.
+Expected<void> AttachCompiledResult(const CompiledResult& compiled_result,
+                                    absl::Span<const LiteRtOp> dispatch_ops,
+                                    LiteRtModelT& model) {
   // Register byte code buffers as external buffers. Map the byte code indices
   // to the registered buffer ids.
-  auto num_byte_code = compiled_result->NumByteCodeModules();
+  auto num_byte_code = compiled_result.NumByteCodeModules();
   if (!num_byte_code) {
     return num_byte_code.Error();
   }
@@ -742,7 +872,7 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
   std::vector<LiteRtParamIndex> byte_code_idx_to_buf_id(*num_byte_code);
 
   for (auto i = 0; i < *num_byte_code; ++i) {
-    auto byte_code = compiled_result->ByteCode(i);
+    auto byte_code = compiled_result.ByteCode(i);
     if (!byte_code) {
       return byte_code.Error();
     }
@@ -760,7 +890,7 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
   for (auto i = 0; i < dispatch_ops.size(); ++i) {
     auto* dispatch_op = dispatch_ops.at(i);
 
-    auto call_info = compiled_result->CallInfo(i);
+    auto call_info = compiled_result.CallInfo(i);
     if (!call_info) {
       return call_info.Error();
     }
@@ -769,6 +899,60 @@ Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
 
     model.AttachAssetToOp(dispatch_op, buf_id, std::string(name));
   }
+  return {};
+}
+
+// Number of threads to compile partitions with, from the compiler options of
+// the plugin.
+int NumCompileThreads(const CompilerPlugin& compiler_plugin) {
+  auto compiler_options = compiler_plugin.CompilerOptions();
+  int num_threads;
+  if (!compiler_options ||
+      LiteRtGetCompilerOptionsNumCompileThreads(
+          *compiler_options, &num_threads) != kLiteRtStatusOk) {
+    return 1;
+  }
+  return num_threads;
+}
+
+}  // namespace
+
+Expected<void> ApplyPluginWithPartition(CompilerPlugin& compiler_plugin,
+                                        LiteRtModelT& model,
+                                        PartitionResult partitions,
+                                        absl::string_view soc_model) {
+  auto& dispatch_ops = partitions.first;
+  auto& sliced_model = partitions.second;
+
+  // Pass sliced subgraphs to plugin for compilation. With multiple threads,
+  // plugins that can compile partitions separately compile each of them with
+  // its index, and the results are attached in partition order. This gives
+  // the same model as a single compilation.
+  const int num_threads = NumCompileThreads(compiler_plugin);
+  if (num_threads > 1 && !compiler_plugin.SupportsParallelCompile()) {
+    LITERT_LOG(LITERT_WARNING,
+               "Plugin %s can't compile partitions separately, compiling "
+               "them on a single thread.",
+               compiler_plugin.SocManufacturer().data());
+  }
+  if (num_threads > 1 && dispatch_ops.size() > 1 &&
+      compiler_plugin.SupportsParallelCompile()) {
+    LITERT_ASSIGN_OR_RETURN(auto compiled_results,
+                            compiler_plugin.CompileInParallel(
+                                sliced_model, num_threads, soc_model));
+    for (auto i = 0; i < compiled_results.size(); ++i) {
+      LITERT_RETURN_IF_ERROR(AttachCompiledResult(
+          compiled_results[i], absl::MakeConstSpan(&dispatch_ops[i], 1),
+          model));
+    }
+  } else {
+    auto compiled_result = compiler_plugin.Compile(&sliced_model, soc_model);
+    if (!compiled_result) {
+      return compiled_result.Error();
+    }
+    LITERT_RETURN_IF_ERROR(
+        AttachCompiledResult(*compiled_result, dispatch_ops, model));
+  }
 
   // Tag the model with make/model from the plugin.
   auto build_stamp =
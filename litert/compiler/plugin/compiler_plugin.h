@@ -127,6 +127,21 @@ class CompilerPlugin {
   Expected<CompiledResult> Compile(LiteRtModel partitions,
                                    absl::string_view soc_model = "");
 
+  // Whether the plugin implements LiteRtCompilerPluginCompilePartition, which
+  // CompileInParallel() requires.
+  bool SupportsParallelCompile() const {
+    return plugin_api_.compiler_plugin_compile_partition != nullptr;
+  }
+
+  // Compiles every subgraph of `partitions` with a plugin invocation of its
+  // own, passing the subgraph index, on up to `num_threads` threads. Returns
+  // the results in subgraph order. Each thread uses a separate instance of the
+  // plugin. The subgraphs are moved out of `partitions`. Result objects must
+  // be outlived by this CompilerPlugin.
+  Expected<std::vector<CompiledResult>> CompileInParallel(
+      LiteRtModelT& partitions, size_t num_threads,
+      absl::string_view soc_model = "");
+
   // Register all transformations to the builder object owned by this plugin.
   Expected<void> RegisterAllTransformations();
 
@@ -175,6 +190,8 @@ class CompilerPlugin {
   LiteRtEnvironmentOptions env_ = nullptr;
   LiteRtCompilerPluginApi plugin_api_ = {};
   LiteRtCompilerPlugin plugin_handle_ = nullptr;
+  // Additional plugin instances for the threads of CompileInParallel().
+  std::vector<LiteRtCompilerPlugin> worker_handles_;
   std::vector<LiteRtTransformation> transformations_;
   size_t max_transformation_iterations_ = 100;
 
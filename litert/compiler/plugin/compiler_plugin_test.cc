@@ -15,6 +15,7 @@
 #include "litert/compiler/plugin/compiler_plugin.h"
 
 #include <array>
+#include <cstddef>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -430,6 +431,51 @@ TEST(ApplyTest, MultiSubgraph) {
   EXPECT_TRUE(model.FindMetadata(kLiteRtBuildStampKey));
 }
 
+TEST(ApplyTest, ParallelCompileMatchesSerialCompile) {
+  struct Asset {
+    std::string entry_point;
+    size_t buf_id;
+    std::string byte_code;
+    bool operator==(const Asset& other) const {
+      return entry_point == other.entry_point && buf_id == other.buf_id &&
+             byte_code == other.byte_code;
+    }
+  };
+  // Returns the entry point and byte code attached to the dispatch op of every
+  // subgraph.
+  auto compile = [](int num_compile_threads) -> std::vector<Asset> {
+    auto litert_options = Options::Create();
+    auto compiler_options = CompilerOptions::Create();
+    compiler_options->SetNumCompileThreads(num_compile_threads);
+    litert_options->AddOpaqueOptions(std::move(*compiler_options));
+    auto plugins = CompilerPlugin::LoadPlugins(
+        {GetLiteRtPath(kTestPluginSearchPath)}, /*env=*/nullptr,
+        litert_options->Get());
+    auto model_wrap = testing::LoadTestFileModel("multi_subgraph_mul.tflite");
+    auto& model = *model_wrap.Get();
+    EXPECT_TRUE(ApplyPlugin(plugins->front(), model));
+
+    std::vector<Asset> assets;
+    for (auto i = 0; i < model.NumSubgraphs(); ++i) {
+      auto asset = model.FindOpAsset(model.Subgraph(i).Ops().front());
+      EXPECT_TRUE(asset);
+      auto buffer = model.Buffers()->GetBuffer(asset->first);
+      EXPECT_TRUE(buffer);
+      assets.push_back({std::string(asset->second), asset->first,
+                        std::string(buffer->StrView())});
+    }
+    return assets;
+  };
+
+  const auto serial = compile(/*num_compile_threads=*/1);
+  ASSERT_EQ(serial.size(), 2);
+  EXPECT_EQ(serial[0].entry_point, "partition_0");
+  EXPECT_EQ(serial[1].entry_point, "partition_1");
+  EXPECT_NE(serial[0].buf_id, serial[1].buf_id);
+  EXPECT_EQ(compile(/*num_compile_threads=*/2), serial);
+  EXPECT_EQ(compile(/*num_compile_threads=*/8), serial);
+}
+
 TEST(ApplyTest, ApplyPlugins) {
   auto model_wrap = testing::LoadTestFileModel("mul_simple.tflite");
   ASSERT_TRUE(model_wrap);
@@ -753,6 +799,13 @@ LiteRtStatus ReplaceAddWithMul(LiteRtBuilder builder, LiteRtOp op) {
   return kLiteRtStatusOk;
 }
 
+int num_count_calls = 0;
+
+LiteRtStatus CountCalls(LiteRtBuilder builder, LiteRtOp op) {
+  ++num_count_calls;
+  return kLiteRtStatusErrorNotFound;
+}
+
 }  // namespace
 
 class CompilerPluginFriend : public ::testing::Test {
@@ -982,4 +1035,77 @@ TEST_F(CompilerPluginFriend, MultipleIndependentMatches) {
   EXPECT_EQ(subgraph.Ops()[1]->OpCode(), kLiteRtOpCodeTflMul);
 }
 
+TEST_F(CompilerPluginFriend, RewriteOnlyRetriesChangedNeighborhoods) {
+  CompilerPlugin plugin = CreatePlugin();
+  AddTransformation(plugin, {ReplaceAddWithMul, "Add_to_Mul", 0});
+  AddTransformation(plugin, {CountCalls, "CountCalls", 0});
+
+  // A chain of adds, each of which gets rewritten.
+  constexpr int kNumOps = 16;
+  LiteRtModelT model;
+  auto& subgraph = model.EmplaceSubgraph();
+  LiteRtTensorT* input = &subgraph.EmplaceTensor();
+  for (int i = 0; i < kNumOps; ++i) {
+    auto& op = subgraph.EmplaceOp();
+    op.SetOpCode(kLiteRtOpCodeTflAdd);
+    auto& output = subgraph.EmplaceTensor();
+    AttachInput(input, op);
+    AttachOutput(&output, op);
+    input = &output;
+  }
+
+  num_count_calls = 0;
+  LITERT_ASSERT_OK(plugin.GreedyPatternMatchAndRewrite(model));
+
+  ASSERT_EQ(subgraph.Ops().size(), kNumOps);
+  for (const auto* op : subgraph.Ops()) {
+    EXPECT_EQ(op->OpCode(), kLiteRtOpCodeTflMul);
+  }
+  // Restarting a full scan after every rewrite would retry the patterns on
+  // the rewritten ops kNumOps * (kNumOps + 1) / 2 times.
+  EXPECT_LE(num_count_calls, 2 * kNumOps);
+}
+
+TEST_F(CompilerPluginFriend, RewriteRetriesProducersOfRewrittenOps) {
+  CompilerPlugin plugin = CreatePlugin();
+  AddTransformation(plugin, {ReplaceAddWithMul, "Add_to_Mul", 0});
+  // Sub -> Div, only once the single user of the sub is a mul.
+  AddTransformation(
+      plugin,
+      {[](LiteRtBuilder builder, LiteRtOp op) -> LiteRtStatus {
+         if (op->OpCode() != kLiteRtOpCodeTflSub ||
+             op->Output(0).Users().size() != 1 ||
+             op->Output(0).Users().front()->OpCode() != kLiteRtOpCodeTflMul) {
+           return kLiteRtStatusErrorNotFound;
+         }
+         LiteRtBuilderT* b = reinterpret_cast<LiteRtBuilderT*>(builder);
+         b->BuildOp(kLiteRtOpCodeTflDiv, op->Inputs(), op->Outputs());
+         b->EraseOp(op);
+         return kLiteRtStatusOk;
+       },
+       "Sub_to_Div", 0});
+
+  LiteRtModelT model;
+  auto& subgraph = model.EmplaceSubgraph();
+  auto& t0 = subgraph.EmplaceTensor();
+  auto& t1 = subgraph.EmplaceTensor();
+  auto& t2 = subgraph.EmplaceTensor();
+
+  auto& sub = subgraph.EmplaceOp();
+  sub.SetOpCode(kLiteRtOpCodeTflSub);
+  AttachInput(&t0, sub);
+  AttachOutput(&t1, sub);
+
+  auto& add = subgraph.EmplaceOp();
+  add.SetOpCode(kLiteRtOpCodeTflAdd);
+  AttachInput(&t1, add);
+  AttachOutput(&t2, add);
+
+  LITERT_ASSERT_OK(plugin.GreedyPatternMatchAndRewrite(model));
+
+  ASSERT_EQ(subgraph.Ops().size(), 2);
+  EXPECT_EQ(subgraph.Ops()[0]->OpCode(), kLiteRtOpCodeTflDiv);
+  EXPECT_EQ(subgraph.Ops()[1]->OpCode(), kLiteRtOpCodeTflMul);
+}
+
 }  // namespace litert::internal
@@ -14,8 +14,20 @@
 
 #include "litert/core/cache/compilation_cache.h"
 
+#include <fcntl.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // defined(_WIN32)
+
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <functional>
 #include <ios>
@@ -41,6 +53,7 @@
 #include "litert/core/filesystem.h"
 #include "litert/core/model/model.h"
 #include "litert/core/model/model_load.h"
+#include "litert/core/model/model_serialize.h"
 #include "litert/core/options.h"
 #include "litert/core/util/flatbuffer_tools.h"
 
@@ -54,6 +67,29 @@ std::string GetCachedModelFilePath(absl::string_view cache_root_path,
       {cache_root_path, absl::StrCat(model_hash, ".tflite")});
 }
 
+// Creates a new file next to `path` for writing, with a name no other writer
+// uses. Returns the file descriptor and sets `temp_file_path`, or returns -1.
+int CreateTempFile(const std::string& path, std::string* temp_file_path) {
+  std::string name_template = absl::StrCat(path, ".tmp.XXXXXX");
+#if defined(_WIN32)
+  if (_mktemp_s(name_template.data(), name_template.size() + 1) != 0) {
+    return -1;
+  }
+  const int fd = _open(name_template.c_str(),
+                       _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY,
+                       _S_IREAD | _S_IWRITE);
+#else
+  const int fd = mkstemp(name_template.data());
+  if (fd >= 0) {
+    // mkstemp() creates the file readable by the owner only.
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fchmod(fd, 0644);
+  }
+#endif  // defined(_WIN32)
+  *temp_file_path = std::move(name_template);
+  return fd;
+}
+
 Expected<std::vector<litert::internal::CompilationCache::CompilerPluginInfo>>
 GetPluginInfo(
     const std::vector<litert::internal::CompilerPlugin>& compiler_plugins) {
@@ -216,6 +252,41 @@ Expected<void> CompilationCache::SaveModel(
   return Expected<void>();
 }
 
+Expected<void> CompilationCache::SerializeAndSaveModel(LiteRtModelT&& model,
+                                                       uint64_t model_hash) {
+  const std::string cached_model_file_path =
+      GetCachedModelFilePath(cache_root_path_, model_hash);
+  // Concurrent writers of the same model each get their own file, and the
+  // last rename wins.
+  std::string temp_file_path;
+  const int fd = CreateTempFile(cached_model_file_path, &temp_file_path);
+  if (fd < 0) {
+    LITERT_LOG(LITERT_ERROR, "Failed to open cache file for writing: %s",
+               temp_file_path.c_str());
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      "Failed to open cache file for writing");
+  }
+
+  auto written = SerializeModelToFd(std::move(model), fd);
+#if defined(_WIN32)
+  const bool closed = _close(fd) == 0;
+  // Windows doesn't replace existing files on rename.
+  std::remove(cached_model_file_path.c_str());
+#else
+  const bool closed = close(fd) == 0;
+#endif  // defined(_WIN32)
+  if (!written || !closed ||
+      std::rename(temp_file_path.c_str(), cached_model_file_path.c_str()) !=
+          0) {
+    std::remove(temp_file_path.c_str());
+    LITERT_LOG(LITERT_ERROR, "Failed to write all data to cache file: %s",
+               cached_model_file_path.c_str());
+    return Unexpected(kLiteRtStatusErrorFileIO,
+                      "Failed to write all data to cache file");
+  }
+  return {};
+}
+
 Expected<std::optional<LiteRtModelT::Ptr>> CompilationCache::TryLoadModel(
     uint64_t model_hash) {
   std::string expected_model_file_path =
@@ -72,6 +72,12 @@ class CompilationCache {
   Expected<void> SaveModel(const litert::BufferRef<uint8_t>& model_buffer,
                            uint64_t model_hash);
 
+  // Serializes the provided 'model' straight into the cache file associated
+  // with the 'model_hash', without holding the serialized model in memory.
+  // The model is consumed. A partially written model is never left behind.
+  Expected<void> SerializeAndSaveModel(LiteRtModelT&& model,
+                                       uint64_t model_hash);
+
   // Tries to load a model associated with the 'model_hash' from the cache.
   //
   // - Returns an empty optional if no such model can be found, i.e. a cache
@@ -15,17 +15,23 @@
 #include "litert/core/cache/compilation_cache.h"
 
 #include <cstddef>
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 
 #include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/options/litert_google_tensor_options.h"
 #include "litert/cc/litert_macros.h"
 #include "litert/core/model/model.h"
 #include "litert/core/model/model_load.h"
+#include "litert/core/model/model_serialize.h"
 #include "litert/core/options.h"
 #include "litert/test/common.h"
 #include "litert/test/testdata/simple_model_test_vectors.h"
@@ -90,6 +96,105 @@ TEST(CompilationCacheTest, CacheHit) {
   EXPECT_TRUE(cache_hit.has_value());
 }
 
+TEST(CompilationCacheTest, SerializeAndSaveModel_CacheHit) {
+  // GIVEN: an empty compilation cache and a model
+  const auto cache_root_path =
+      std::filesystem::path(::testing::TempDir()) / "serialize_and_save";
+  std::filesystem::remove_all(cache_root_path);
+  std::filesystem::create_directories(cache_root_path);
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path.string()));
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  LITERT_ASSIGN_OR_ABORT(
+      const std::size_t model_hash,
+      CompilationCache::GetModelHash(*model, GetTestOptions(),
+                                     GetTestCompilerPluginInfo()));
+  const auto num_subgraphs = model->NumSubgraphs();
+
+  // WHEN: the model is serialized straight into the cache
+  LITERT_ABORT_IF_ERROR(
+      compilation_cache.SerializeAndSaveModel(std::move(*model), model_hash));
+
+  // THEN: the cache holds the same bytes as an in-memory serialization, and
+  // no temporary file is left behind
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> reference_model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  LITERT_ASSIGN_OR_ABORT(auto serialized,
+                         SerializeModel(std::move(*reference_model)));
+  const auto cached_model_file_path =
+      cache_root_path / absl::StrCat(model_hash, ".tflite");
+  std::ifstream cached_model_file(cached_model_file_path, std::ios::binary);
+  ASSERT_TRUE(cached_model_file.is_open());
+  const std::string cached_model(
+      (std::istreambuf_iterator<char>(cached_model_file)),
+      std::istreambuf_iterator<char>());
+  EXPECT_EQ(cached_model, serialized.StrView());
+  int num_files = 0;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(cache_root_path)) {
+    EXPECT_EQ(entry.path(), cached_model_file_path);
+    ++num_files;
+  }
+  EXPECT_EQ(num_files, 1);
+
+  // THEN: the model can be loaded from the cache
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(model_hash));
+  ASSERT_TRUE(cache_hit.has_value());
+  EXPECT_EQ((*cache_hit)->NumSubgraphs(), num_subgraphs);
+}
+
+TEST(CompilationCacheTest, SerializeAndSaveModel_KeepsOtherWritersFiles) {
+  // GIVEN: an empty compilation cache, a model, and a file at the temporary
+  // path the cache used to write all models of that hash to
+  const auto cache_root_path =
+      std::filesystem::path(::testing::TempDir()) / "serialize_and_save_other";
+  std::filesystem::remove_all(cache_root_path);
+  std::filesystem::create_directories(cache_root_path);
+  LITERT_ASSIGN_OR_ABORT(CompilationCache compilation_cache,
+                         CompilationCache::Create(cache_root_path.string()));
+  LITERT_ASSIGN_OR_ABORT(
+      std::unique_ptr<LiteRtModelT> model,
+      LoadModelFromFile(litert::testing::GetTestFilePath(kModelFileName)));
+  LITERT_ASSIGN_OR_ABORT(
+      const std::size_t model_hash,
+      CompilationCache::GetModelHash(*model, GetTestOptions(),
+                                     GetTestCompilerPluginInfo()));
+  const auto other_file_path =
+      cache_root_path / absl::StrCat(model_hash, ".tflite.tmp");
+  {
+    std::ofstream other_file(other_file_path, std::ios::binary);
+    other_file << "partial";
+  }
+
+  // WHEN: the model is serialized into the cache
+  LITERT_ABORT_IF_ERROR(
+      compilation_cache.SerializeAndSaveModel(std::move(*model), model_hash));
+
+  // THEN: the other file is untouched, and only the cached model was added
+  std::ifstream other_file(other_file_path, std::ios::binary);
+  ASSERT_TRUE(other_file.is_open());
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(other_file),
+                        std::istreambuf_iterator<char>()),
+            "partial");
+  int num_files = 0;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(cache_root_path)) {
+    EXPECT_TRUE(entry.path() == other_file_path ||
+                entry.path() ==
+                    cache_root_path / absl::StrCat(model_hash, ".tflite"))
+        << entry.path();
+    ++num_files;
+  }
+  EXPECT_EQ(num_files, 2);
+  LITERT_ASSIGN_OR_ABORT(std::optional<LiteRtModelT::Ptr> cache_hit,
+                         compilation_cache.TryLoadModel(model_hash));
+  EXPECT_TRUE(cache_hit.has_value());
+}
+
 TEST(CompilationCacheTest, CompilerPluginVersionChange_CacheMiss) {
   // GIVEN: a compilation cache and a model, saved to the cache
   const std::string cache_root_path = ::testing::TempDir();
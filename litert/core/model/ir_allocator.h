@@ -18,9 +18,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <functional>
-#include <iterator>
-#include <list>
 #include <memory>
+#include <new>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -32,12 +31,27 @@ namespace litert::internal {
 // A list of IR objects scoped to the same block (subgraph) that provides
 // pointer stability. Facilitates management of memory and c-like access
 // to elements.
+//
+// Elements are constructed in place in chunks of slots that are never
+// reallocated, and their order is kept in a separate array of pointers.
+// Positional insertion and erasure only shift pointers. Slots of erased
+// elements are reused by later insertions. Transferring elements to another
+// allocator leaves them in place, the receiving allocator shares ownership of
+// the chunks instead.
 template <class Ir>
 class IrAllocator {
  private:
-  using Storage = std::list<Ir>;
+  struct alignas(Ir) Slot {
+    unsigned char bytes[sizeof(Ir)];
+  };
+  using Chunk = std::shared_ptr<Slot[]>;
   using Refs = std::vector<Ir*>;
 
+  // Bounds of the number of slots in chunks allocated on demand. Chunks grow
+  // with the number of elements.
+  static constexpr size_t kMinChunkSlots = 4;
+  static constexpr size_t kMaxChunkSlots = 1024;
+
  public:
   // Emplace a new element onto the list.
   template <class... Args>
@@ -47,17 +61,19 @@ class IrAllocator {
 
   template <class... Args>
   Ir& EmplaceAt(int index, Args&&... args) {
-    auto storage_it = storage_.begin();
-    std::advance(storage_it, index);
-
-    auto emp_iter = storage_.emplace(storage_it, std::forward<Args>(args)...);
-
-    auto refs_it = refs_->begin();
-    std::advance(refs_it, index);
-
-    refs_->insert(refs_it, &(*emp_iter));
+    Ir* ir = new (Allocate()) Ir(std::forward<Args>(args)...);
+    refs_->insert(refs_->begin() + index, ir);
+    return *ir;
+  }
 
-    return *emp_iter;
+  // Makes room for `num_elements` more elements, which are then emplaced
+  // without further allocations.
+  void Reserve(size_t num_elements) {
+    refs_->reserve(refs_->size() + num_elements);
+    const size_t available = free_slots_.size() + (chunk_end_ - next_slot_);
+    if (num_elements > available) {
+      AddChunk(num_elements - available);
+    }
   }
 
   // Get the array of (stable) pointers to underlying elements. Suitable
@@ -73,17 +89,16 @@ class IrAllocator {
   // Returns the number of elements removed.
   size_t RemoveIf(std::function<bool(const Ir& ir)> pred) {
     auto ref_it = refs_->begin();
-    for (auto it = storage_.begin(); it != storage_.end();) {
-      if (!pred(*it)) {
-        *ref_it = &*it;
+    for (Ir* ir : *refs_) {
+      if (!pred(*ir)) {
+        *ref_it = ir;
         ++ref_it;
-        ++it;
         continue;
       }
-      it = storage_.erase(it);
+      Destroy(ir);
     }
     const size_t removed = refs_->end() - ref_it;
-    refs_->resize(refs_->size() - removed);
+    refs_->erase(ref_it, refs_->end());
     return removed;
   }
 
@@ -93,7 +108,9 @@ class IrAllocator {
     if (size >= Size()) {
       return;
     }
-    storage_.resize(size);
+    for (auto it = refs_->begin() + size; it != refs_->end(); ++it) {
+      Destroy(*it);
+    }
     refs_->resize(size);
   }
 
@@ -103,29 +120,30 @@ class IrAllocator {
                     std::optional<std::vector<size_t>> indices = std::nullopt) {
     if (&other == this) return;
     if (!indices) {
-      storage_.splice(storage_.cend(), other.storage_);
-      refs_->insert(refs_->end(), other.refs_->cbegin(), other.refs_->cend());
-      other.ResetRefs();
+      TransferFrom(other, Size());
       return;
     }
 
     auto& inds = *indices;
     std::sort(inds.begin(), inds.end());
     inds.erase(std::unique(inds.begin(), inds.end()), inds.end());
-    std::vector<typename Storage::iterator> its;
-    auto i = 0;
-    auto it = other.storage_.begin();
-    for (auto ind : inds) {
-      std::advance(it, ind - i);
-      i = ind;
-      its.push_back(it);
+    if (inds.empty()) {
+      return;
     }
-    for (auto it : its) {
-      storage_.splice(storage_.cend(), other.storage_, it);
+    ShareChunksOf(other);
+    auto& other_refs = *other.refs_;
+    auto kept = other_refs.begin() + inds.front();
+    auto ind_it = inds.begin();
+    for (size_t i = inds.front(); i < other_refs.size(); ++i) {
+      if (ind_it != inds.end() && *ind_it == i) {
+        refs_->push_back(other_refs[i]);
+        ++ind_it;
+        continue;
+      }
+      *kept = other_refs[i];
+      ++kept;
     }
-
-    ResetRefs();
-    other.ResetRefs();
+    other_refs.erase(kept, other_refs.end());
   }
 
   // Transfers ownership of the given object to this allocator with at specified
@@ -139,29 +157,10 @@ class IrAllocator {
       // Or handle as an error, for now, clamp to the end.
       index = Size();
     }
-
-    auto storage_it = storage_.begin();
-    std::advance(storage_it, index);
-
-    const size_t num_moved = other.storage_.size();
-    storage_.splice(storage_it, other.storage_);
-
-    // The elements from other.storage_ are inserted before storage_it.
-    // The range of new elements is [std::prev(storage_it, num_moved),
-    // storage_it).
-    auto insert_start_it = std::prev(storage_it, num_moved);
-
-    auto refs_it = refs_->begin();
-    std::advance(refs_it, index);
-
-    std::vector<Ir*> new_refs;
-    new_refs.reserve(num_moved);
-    for (auto it = insert_start_it; it != storage_it; ++it) {
-      new_refs.push_back(&*it);
-    }
-    refs_->insert(refs_it, new_refs.begin(), new_refs.end());
-
-    other.ResetRefs();  // other.storage_ is now empty.
+    ShareChunksOf(other);
+    refs_->insert(refs_->begin() + index, other.refs_->cbegin(),
+                  other.refs_->cend());
+    other.refs_->clear();
   }
 
   // Override for rvalues.
@@ -174,29 +173,86 @@ class IrAllocator {
   }
 
   // Number of elements stored by this allocator.
-  size_t Size() const { return storage_.size(); }
+  size_t Size() const { return refs_->size(); }
 
   IrAllocator() { refs_ = std::make_unique<Refs>(); }
 
+  ~IrAllocator() { DestroyAll(); }
+
   // IR is generally semantically movable (without reference invalidation)
-  // but not copyable. IrAllocators reflect that, note moving lists
-  // does not invalidate references.
+  // but not copyable. IrAllocators reflect that, note moving the allocator
+  // does not move the elements.
   IrAllocator(const IrAllocator& other) = delete;
   IrAllocator& operator=(const IrAllocator& other) = delete;
-  IrAllocator(IrAllocator&& other) = default;
-  IrAllocator& operator=(IrAllocator&& other) = default;
+  IrAllocator(IrAllocator&& other) noexcept { *this = std::move(other); }
+  IrAllocator& operator=(IrAllocator&& other) noexcept {
+    if (&other == this) return *this;
+    DestroyAll();
+    refs_ = std::move(other.refs_);
+    chunks_ = std::move(other.chunks_);
+    free_slots_ = std::move(other.free_slots_);
+    next_slot_ = std::exchange(other.next_slot_, nullptr);
+    chunk_end_ = std::exchange(other.chunk_end_, nullptr);
+    return *this;
+  }
 
  private:
-  void ResetRefs() {
-    refs_->resize(storage_.size());
-    auto it = storage_.begin();
-    for (auto i = 0; i < storage_.size(); ++i, ++it) {
-      refs_->at(i) = &*it;
+  void* Allocate() {
+    if (!free_slots_.empty()) {
+      Slot* slot = free_slots_.back();
+      free_slots_.pop_back();
+      return slot;
+    }
+    if (next_slot_ == chunk_end_) {
+      AddChunk(std::clamp(Size(), kMinChunkSlots, kMaxChunkSlots));
     }
+    return next_slot_++;
+  }
+
+  // Starts allocating from a new chunk of `num_slots` slots. The unused slots
+  // of the current chunk are kept for reuse.
+  void AddChunk(size_t num_slots) {
+    for (; next_slot_ != chunk_end_; ++next_slot_) {
+      free_slots_.push_back(next_slot_);
+    }
+    chunks_.push_back(Chunk(new Slot[num_slots]));
+    next_slot_ = chunks_.back().get();
+    chunk_end_ = next_slot_ + num_slots;
+  }
+
+  void Destroy(Ir* ir) {
+    ir->~Ir();
+    free_slots_.push_back(reinterpret_cast<Slot*>(ir));
+  }
+
+  void DestroyAll() {
+    if (refs_ == nullptr) {
+      return;
+    }
+    for (Ir* ir : *refs_) {
+      ir->~Ir();
+    }
+    refs_->clear();
+  }
+
+  // Keeps the chunks of `other` alive for as long as this allocator, so that
+  // elements transferred from `other` may stay where they are.
+  void ShareChunksOf(const IrAllocator& other) {
+    chunks_.insert(chunks_.end(), other.chunks_.cbegin(),
+                   other.chunks_.cend());
+    std::sort(chunks_.begin(), chunks_.end(),
+              [](const Chunk& a, const Chunk& b) { return a.get() < b.get(); });
+    chunks_.erase(std::unique(chunks_.begin(), chunks_.end()), chunks_.end());
   }
 
-  Storage storage_;
   std::unique_ptr<Refs> refs_;
+  std::vector<Chunk> chunks_;
+  // Slots of erased elements, and unused slots of previous chunks, which are
+  // reused before the current chunk.
+  std::vector<Slot*> free_slots_;
+  // Unused part of the chunk allocated last.
+  Slot* next_slot_ = nullptr;
+  Slot* chunk_end_ = nullptr;
 };
 
 }  // namespace litert::internal
@@ -284,5 +284,78 @@ TEST(IrAllocatorTest, TransferFromSelfWithIndices) {
   EXPECT_EQ(ops.Elements().at(2), op3);
 }
 
+TEST(IrAllocatorTest, EmplaceAtKeepsPointersStable) {
+  IrAllocator<LiteRtOpT> ops;
+  std::vector<LiteRtOp> expected;
+  for (int i = 0; i < 100; ++i) {
+    expected.push_back(&ops.EmplaceBack());
+  }
+  for (int i = 0; i < 100; ++i) {
+    const int index = 2 * i + 1;
+    expected.insert(expected.begin() + index, &ops.EmplaceAt(index));
+  }
+  EXPECT_THAT(ops.Elements(), ElementsAreArray(expected));
+}
+
+TEST(IrAllocatorTest, Reserve) {
+  IrAllocator<LiteRtOpT> ops;
+  auto* op1 = &ops.EmplaceBack();
+  ops.Reserve(100);
+  const auto* refs = ops.Elements().data();
+  std::vector<LiteRtOp> expected = {op1};
+  for (int i = 0; i < 100; ++i) {
+    expected.push_back(&ops.EmplaceBack());
+  }
+  EXPECT_EQ(ops.Elements().data(), refs);
+  EXPECT_THAT(ops.Elements(), ElementsAreArray(expected));
+}
+
+TEST(IrAllocatorTest, ReusesRemovedSlots) {
+  IrAllocator<LiteRtOpT> ops;
+  auto& op1 = ops.EmplaceBack();
+  op1.SetOpCode(kCustomOpCode);
+  auto& op2 = ops.EmplaceBack();
+  op2.SetOpCode(kNonCustomOpCode);
+
+  auto pred = [](const auto& op) { return op.OpCode() == kCustomOpCode; };
+  ASSERT_EQ(ops.RemoveIf(pred), 1);
+
+  auto& op3 = ops.EmplaceAt(0);
+  EXPECT_EQ(&op3, &op1);
+  EXPECT_THAT(ops.Elements(), ElementsAreArray({&op3, &op2}));
+}
+
+TEST(IrAllocatorTest, TransferredElementsOutliveSource) {
+  IrAllocator<LiteRtOpT> ops;
+  LiteRtOp other_op1 = nullptr;
+  LiteRtOp other_op2 = nullptr;
+  {
+    IrAllocator<LiteRtOpT> other_ops;
+    other_op1 = &other_ops.EmplaceBack();
+    other_op1->SetOpCode(kCustomOpCode);
+    other_op2 = &other_ops.EmplaceBack();
+    std::vector<size_t> indices = {0};
+    ops.TransferFrom(other_ops, std::move(indices));
+    EXPECT_THAT(other_ops.Elements(), ElementsAreArray({other_op2}));
+  }
+  EXPECT_THAT(ops.Elements(), ElementsAreArray({other_op1}));
+  EXPECT_EQ(ops.Elements().at(0)->OpCode(), kCustomOpCode);
+}
+
+TEST(IrAllocatorTest, Move) {
+  IrAllocator<LiteRtOpT> ops;
+  auto* op1 = &ops.EmplaceBack();
+  const auto* refs = ops.Elements().data();
+
+  IrAllocator<LiteRtOpT> moved_ops(std::move(ops));
+  EXPECT_EQ(moved_ops.Elements().data(), refs);
+  EXPECT_THAT(moved_ops.Elements(), ElementsAreArray({op1}));
+
+  IrAllocator<LiteRtOpT> assigned_ops;
+  assigned_ops.EmplaceBack();
+  assigned_ops = std::move(moved_ops);
+  EXPECT_THAT(assigned_ops.Elements(), ElementsAreArray({op1}));
+}
+
 }  // namespace
 }  // namespace litert::internal
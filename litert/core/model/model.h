@@ -680,6 +680,13 @@ class LiteRtSubgraphT {
     return ops_.EmplaceAt(index, std::forward<Args>(args)...);
   }
 
+  // Makes room for the given numbers of new tensors and ops, e.g. before
+  // unpacking a serialized subgraph.
+  void Reserve(size_t num_tensors, size_t num_ops) {
+    tensors_.Reserve(num_tensors);
+    ops_.Reserve(num_ops);
+  }
+
   // De-allocates ops that pass given predicate. Returns number of ops removed.
   size_t RemoveOpIf(std::function<bool(const LiteRtOpT& op)> pred) {
     return ops_.RemoveIf(pred);
@@ -985,6 +992,11 @@ class LiteRtModelT {
     return subgraphs_.EmplaceBack(Buffers(), std::forward<Args>(args)...);
   }
 
+  // Makes room for `num_subgraphs` new subgraphs.
+  void ReserveSubgraphs(size_t num_subgraphs) {
+    subgraphs_.Reserve(num_subgraphs);
+  }
+
   // Transfers given subgraphs into this model. New subgraphs are appended.
   void TransferSubgraphsFrom(LiteRtSubgraphT::Alloc&& subgraphs) {
     // TODO: Consider merging buffer managers here.
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -20,7 +23,9 @@
 #include <filesystem>  // NOLINT
 #include <fstream>
 #include <functional>
+#include <iterator>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -516,6 +521,51 @@ TEST(ModelSerializeTest, WithMultipleOffsetTensorBuffer) {
   }
 }
 
+// Offset tensor data must be looked up by litert buffer id. Unrelated buffers
+// registered first make those ids differ from the tfl buffer indices.
+TEST(ModelSerializeTest, WithOffsetTensorBufferIdsDifferentFromTflIndices) {
+  static constexpr absl::string_view kUnrelatedData = "UNRELATED_DATA";
+  static constexpr absl::string_view kTensorData = "SOME_TENSOR_DATA";
+  static constexpr absl::string_view kTensorData2 = "SOME_TENSOR_DATA2";
+
+  LiteRtModelT root;
+  for (int i = 0; i < 3; ++i) {
+    root.Buffers()->RegisterOwnedBuffer(
+        OwningBufferRef<uint8_t>(kUnrelatedData));
+  }
+  auto& sg = root.EmplaceSubgraph();
+  sg.EmplaceOp();
+
+  for (const auto data : {kTensorData, kTensorData2}) {
+    auto& tensor = sg.EmplaceTensor();
+    tensor.SetType(MakeRankedTensorType(kLiteRtElementTypeFloat32, {}));
+    auto& weights = tensor.Weights();
+    weights.SetBufferManager(root.Buffers());
+
+    OwningBufferRef<uint8_t> buffer(data);
+    BufferContext context;
+    context.should_append = true;
+    SetWeightsFromOwnedBuffer(weights, std::move(buffer), context);
+  }
+
+  auto serialized = SerializeModel(std::move(root));
+  ASSERT_TRUE(serialized);
+
+  auto fb = FlatbufferWrapper::CreateFromBuffer(*serialized);
+  ASSERT_TRUE(fb);
+  auto tfl = fb->get()->Unpack();
+  ASSERT_EQ(tfl->subgraphs[0]->tensors.size(), 2);
+
+  const absl::string_view expected[] = {kTensorData, kTensorData2};
+  for (int i = 0; i < 2; ++i) {
+    const auto& tfl_tensor = tfl->subgraphs[0]->tensors[i];
+    const auto& tfl_buffer = tfl->buffers[tfl_tensor->buffer];
+    auto data =
+        serialized->StrView().substr(tfl_buffer->offset, tfl_buffer->size);
+    EXPECT_EQ(data, expected[i]);
+  }
+}
+
 TEST(ModelSerializeTest, WithSingleExternalBuffer) {
   static constexpr absl::string_view kByteCode = "SOME_BYTE_CODE";
   static constexpr absl::string_view kName = "foo";
@@ -759,6 +809,59 @@ TEST(ModelSerializeTest, WithOffsetTensorBufferAndOpAssetHasAlignment) {
   }
 }
 
+TEST(ModelSerializeTest, ToFdAndStreamMatchInMemory) {
+  static constexpr absl::string_view kTensorData = "SOME_TENSOR_DATA";
+  static constexpr absl::string_view kByteCode = "SOME_BYTE_CODE";
+  static constexpr size_t kAlignment = 32;
+
+  auto build = [](LiteRtModelT& root) {
+    auto& sg = root.EmplaceSubgraph();
+    auto& op = sg.EmplaceOp();
+    auto& tensor = sg.EmplaceTensor();
+    tensor.SetType(MakeRankedTensorType(kLiteRtElementTypeFloat32, {}));
+    auto& weights = tensor.Weights();
+    weights.SetBufferManager(root.Buffers());
+
+    OwningBufferRef<uint8_t> tensor_buffer(kTensorData);
+    BufferContext context;
+    context.should_append = true;
+    SetWeightsFromOwnedBuffer(weights, std::move(tensor_buffer), context);
+
+    OwningBufferRef<uint8_t> byte_code(kByteCode);
+    const auto buf_id =
+        root.Buffers()->RegisterOwnedBuffer(std::move(byte_code));
+    root.AttachAssetToOp(&op, buf_id, "name");
+  };
+
+  LiteRtModelT in_memory_model;
+  build(in_memory_model);
+  auto serialized = SerializeModel(std::move(in_memory_model), kAlignment);
+  ASSERT_TRUE(serialized);
+
+  const auto path = std::filesystem::path(::testing::TempDir()) / "to_fd.tfl";
+  const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  ASSERT_GE(fd, 0);
+  LiteRtModelT fd_model;
+  build(fd_model);
+  auto fd_size = SerializeModelToFd(std::move(fd_model), fd, kAlignment);
+  close(fd);
+  ASSERT_TRUE(fd_size);
+  EXPECT_EQ(*fd_size, serialized->Size());
+  std::ifstream file(path, std::ios::binary);
+  const std::string file_contents((std::istreambuf_iterator<char>(file)),
+                                  std::istreambuf_iterator<char>());
+  EXPECT_EQ(file_contents, serialized->StrView());
+
+  std::ostringstream stream;
+  LiteRtModelT stream_model;
+  build(stream_model);
+  auto stream_size =
+      SerializeModelToStream(std::move(stream_model), stream, kAlignment);
+  ASSERT_TRUE(stream_size);
+  EXPECT_EQ(*stream_size, serialized->Size());
+  EXPECT_EQ(stream.str(), serialized->StrView());
+}
+
 TEST(ModelSerializeTest, TransferAndSerializeNoConstants) {
   LiteRtModelT root;
   auto& sg = root.EmplaceSubgraph();
@@ -263,8 +263,11 @@ LiteRtStatus UnpackTensor(FlatbufferContext& context,
 LiteRtStatus UnpackSubgraph(FlatbufferContext& context,
                             const TflPackedSubgraph& tfl_subgraph,
                             LiteRtSubgraphT& litert_subgraph) {
-  // Unpack tensors.
   const auto num_tensors = tfl_subgraph.tensors()->size();
+  const auto num_ops = tfl_subgraph.operators()->size();
+  litert_subgraph.Reserve(num_tensors, num_ops);
+
+  // Unpack tensors.
   for (auto i = 0; i < num_tensors; ++i) {
     const auto* tfl_tensor = tfl_subgraph.tensors()->Get(i);
     auto& litert_tensor = litert_subgraph.EmplaceTensor();
@@ -274,7 +277,6 @@ LiteRtStatus UnpackSubgraph(FlatbufferContext& context,
 
   // Unpack ops, pass litert_subgraph so they can look up the new litert
   // tensors.
-  const auto num_ops = tfl_subgraph.operators()->size();
   for (auto i = 0; i < num_ops; ++i) {
     const auto* tfl_op = tfl_subgraph.operators()->Get(i);
     LITERT_RETURN_IF_ERROR(UnpackOp(context, litert_subgraph, *tfl_op,
@@ -382,6 +384,7 @@ Expected<LiteRtModelT::Ptr> UnpackModel(FlatbufferWrapper&& flatbuffer) {
 
   if (packed_model->subgraphs()) {
     const auto num_subgraphs = packed_model->subgraphs()->size();
+    litert_model->ReserveSubgraphs(num_subgraphs);
     for (auto i = 0; i < num_subgraphs; ++i) {
       const auto* tfl_subgraph = packed_model->subgraphs()->Get(i);
       LITERT_RETURN_IF_ERROR(UnpackSubgraph(context, *tfl_subgraph,
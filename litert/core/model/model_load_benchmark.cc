@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures loading and transforming a synthetic graph with a very large number
+// of ops.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"  // from @com_google_absl
+#include "absl/flags/parse.h"  // from @com_google_absl
+#include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/cc/litert_buffer_ref.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/core/model/model.h"
+#include "litert/core/model/model_load.h"
+#include "litert/core/model/model_serialize.h"
+#include "litert/core/util/flatbuffer_tools.h"
+#include "tflite/schema/schema_generated.h"
+
+ABSL_FLAG(int, num_ops, 200000, "Number of ops of the synthetic graph.");
+ABSL_FLAG(int, insert_every, 8,
+          "The transformation inserts an op after every this many ops.");
+
+namespace litert::internal {
+namespace {
+
+// A chain of `num_ops` RELU ops.
+Expected<OwningBufferRef<uint8_t>> SerializeChain(int num_ops) {
+  LiteRtModelT model;
+  auto& subgraph = model.EmplaceSubgraph();
+  subgraph.Reserve(num_ops + 1, num_ops);
+  const int32_t dims[] = {1, 16};
+  auto add_tensor = [&](int index) -> LiteRtTensorT& {
+    auto& tensor = subgraph.EmplaceTensor();
+    tensor.SetType(MakeRankedTensorType(kLiteRtElementTypeFloat32, dims));
+    tensor.SetName(absl::StrCat("t", index));
+    return tensor;
+  };
+
+  LiteRtTensorT* input = &add_tensor(0);
+  subgraph.Inputs().push_back(input);
+  for (int i = 0; i < num_ops; ++i) {
+    auto& op = subgraph.EmplaceOp();
+    op.SetOpCode(kLiteRtOpCodeTflRelu);
+    SetTflOpCodeInd(op, 0);
+    auto& output = add_tensor(i + 1);
+    AttachInput(input, op);
+    AttachOutput(&output, op);
+    input = &output;
+  }
+  subgraph.Outputs().push_back(input);
+  model.EmplaceSignature(MakeDefaultSignature(&subgraph));
+
+  std::vector<TflOpCodePtr> tfl_codes;
+  tfl_codes.push_back(std::make_unique<TflOpCode>());
+  tfl_codes.back()->builtin_code = ::tflite::BuiltinOperator_RELU;
+  tfl_codes.back()->version = 1;
+  SetTflOpCodes(model, std::move(tfl_codes));
+  return SerializeModel(std::move(model));
+}
+
+// Inserts an op after every `insert_every` ops, the way partitioning inserts
+// dispatch ops, then removes them again.
+Expected<void> Transform(LiteRtSubgraphT& subgraph, int insert_every) {
+  const size_t num_ops = subgraph.Ops().size();
+  for (size_t i = insert_every; i < subgraph.Ops().size();
+       i += insert_every + 1) {
+    subgraph.EmplaceOpAt(i);
+  }
+  DCE(subgraph);
+  if (subgraph.Ops().size() != num_ops) {
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                      "Unexpected number of ops after the transformation");
+  }
+  return {};
+}
+
+Expected<void> Run() {
+  const int num_ops = absl::GetFlag(FLAGS_num_ops);
+  LITERT_ASSIGN_OR_RETURN(auto serialized, SerializeChain(num_ops));
+  ABSL_LOG(INFO) << "model: " << num_ops << " ops, " << serialized.Size()
+                 << " bytes";
+
+  absl::Time start = absl::Now();
+  LITERT_ASSIGN_OR_RETURN(auto model, LoadModelFromBuffer(serialized));
+  ABSL_LOG(INFO) << "load: " << absl::Now() - start;
+
+  start = absl::Now();
+  LITERT_RETURN_IF_ERROR(
+      Transform(*model->MainSubgraph(), absl::GetFlag(FLAGS_insert_every)));
+  ABSL_LOG(INFO) << "transform: " << absl::Now() - start;
+
+  start = absl::Now();
+  model.reset();
+  ABSL_LOG(INFO) << "destroy: " << absl::Now() - start;
+  return {};
+}
+
+}  // namespace
+}  // namespace litert::internal
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  if (auto result = litert::internal::Run(); !result) {
+    ABSL_LOG(ERROR) << result.Error().Message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
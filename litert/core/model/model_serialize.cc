@@ -16,11 +16,20 @@
 
 #include <sys/types.h>
 
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <sys/uio.h>
+#endif  // defined(_WIN32)
+
 #include <algorithm>
+#include <cerrno>
+#include <climits>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <ostream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -34,6 +43,7 @@
 #endif
 
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_op_code.h"
@@ -351,13 +361,24 @@ Expected<TflModelPtr> PackAsTflite(SerializationContext& builder) {
   return std::move(builder).Release();
 }
 
-// Appends external buffers to the back of the serialized tflite model. Updates
-// the ops that references them with the correct offset and size in-place.
-Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
+// A serialized model: the tflite flatbuffer, followed by the external buffers
+// at the given offsets. The external buffers are owned by the litert model.
+struct SerializedModel {
+  OwningBufferRef<uint8_t> flatbuffer;
+  std::vector<std::pair<size_t, BufferRef<uint8_t>>> appended_buffers;
+  size_t size = 0;
+};
+
+// Lays out external buffers after the serialized tflite model. Updates the ops
+// that references them with the correct offset and size in-place.
+Expected<SerializedModel> LayOutAppendedBuffers(
     SerializationContext& builder, OwningBufferRef<uint8_t> serialized_tfl,
     LiteRtModelT& litert_model) {
+  SerializedModel serialized;
+  serialized.size = serialized_tfl.Size();
   if (builder.OpAssetMap().empty() && builder.OffsetTensorMap().empty()) {
-    return serialized_tfl;
+    serialized.flatbuffer = std::move(serialized_tfl);
+    return serialized;
   }
 
   const auto align = builder.BytecodeAlignment();
@@ -473,49 +494,35 @@ Expected<OwningBufferRef<uint8_t>> SerializeWithAppendedBuffers(
       return Error(kLiteRtStatusErrorInvalidFlatbuffer);
     }
   }
-  // Allocate buffer enough for original model and appended buffers and copy.
-  OwningBufferRef<uint8_t> final_model(cur_offset);
-
-  // Copy serialized tflite model.
-  uint8_t* const start = final_model.Data();
-  std::memcpy(start, serialized_tfl.Data(), serialized_tfl.Size());
-
-  // Copy asset buffers (aligned).
+  // Collect the asset buffers (aligned), followed by the offset tensor
+  // buffers.
   for (auto it = asset_buffer_offsets.Begin(); it != asset_buffer_offsets.End();
        ++it) {
-    const auto buf_id = it->first;
-
-    auto asset_buf = litert_model.Buffers()->GetBuffer(buf_id);
+    auto asset_buf = litert_model.Buffers()->GetBuffer(it->first);
     if (!asset_buf) {
       LITERT_LOG(LITERT_ERROR, "Failed to find asset buffer");
       return asset_buf.Error();
     }
-    uint8_t* const offset = start + it->second.first;
-    std::memcpy(offset, asset_buf->Data(), asset_buf->Size());
+    serialized.appended_buffers.emplace_back(it->second.first, *asset_buf);
   }
-
-  // Copy offset tensor buffers.
   for (auto it = offset_tensor_offsets.Begin();
        it != offset_tensor_offsets.End(); ++it) {
-    const auto buf_id = it->first;
-
-    auto offset_buf = litert_model.Buffers()->GetBuffer(buf_id);
+    const auto litert_buf_id = builder.OffsetTensorMap().at(it->first);
+    auto offset_buf = litert_model.Buffers()->GetBuffer(litert_buf_id);
     if (!offset_buf) {
       LITERT_LOG(LITERT_ERROR, "Failed to find offset tensor buffer");
       return offset_buf.Error();
     }
-
-    uint8_t* const offset = start + it->second.first;
-    std::memcpy(offset, offset_buf->Data(), offset_buf->Size());
+    serialized.appended_buffers.emplace_back(it->second.first, *offset_buf);
   }
 
-  return final_model;
+  serialized.flatbuffer = std::move(serialized_tfl);
+  serialized.size = cur_offset;
+  return serialized;
 }
 
-}  // namespace
-
-Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
-                                                  size_t bytecode_alignment) {
+Expected<SerializedModel> Serialize(LiteRtModelT& model,
+                                    size_t bytecode_alignment) {
   // Pass the op code list through that was saved during loading. Add one more
   // op code for the dispatch ops
   auto tfl_op_codes = litert::internal::TakeTflOpCodes(model);
@@ -543,19 +550,145 @@ Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
   }
 
   auto serialized_tfl = SerializeFlatbuffer(**tfl_model);
-  auto serialized_with_buffers =
-      SerializeWithAppendedBuffers(builder, std::move(serialized_tfl), model);
-  if (!serialized_with_buffers) {
+  // The unpacked model holds copies of all non-appended buffers.
+  tfl_model->reset();
+  auto serialized =
+      LayOutAppendedBuffers(builder, std::move(serialized_tfl), model);
+  if (!serialized) {
     LITERT_LOG(LITERT_ERROR, "Failed to serialize with appended buffers");
-    return serialized_with_buffers.Error();
+    return serialized.Error();
   }
 
-  if (!VerifyFlatbuffer(serialized_with_buffers->Span())) {
+  // Appended buffers are only referenced by offset, verifying the flatbuffer
+  // alone is enough.
+  if (!VerifyFlatbuffer(serialized->flatbuffer.Span())) {
     LITERT_LOG(LITERT_ERROR, "Failed to verify flatbuffer");
     return Error(kLiteRtStatusErrorInvalidFlatbuffer);
   }
 
-  return serialized_with_buffers;
+  return serialized;
+}
+
+// Returns the consecutive pieces of `serialized`, the gaps between buffers are
+// filled from `zeros`.
+std::vector<BufferRef<uint8_t>> GetPieces(const SerializedModel& serialized,
+                                          std::vector<uint8_t>& zeros) {
+  size_t end = serialized.flatbuffer.Size();
+  for (const auto& [offset, buffer] : serialized.appended_buffers) {
+    zeros.resize(std::max(zeros.size(), offset - end));
+    end = offset + buffer.Size();
+  }
+
+  std::vector<BufferRef<uint8_t>> pieces;
+  pieces.reserve(2 * serialized.appended_buffers.size() + 1);
+  pieces.push_back(serialized.flatbuffer);
+  end = serialized.flatbuffer.Size();
+  for (const auto& [offset, buffer] : serialized.appended_buffers) {
+    if (offset > end) {
+      pieces.emplace_back(zeros.data(), offset - end);
+    }
+    pieces.push_back(buffer);
+    end = offset + buffer.Size();
+  }
+  return pieces;
+}
+
+// Writes `pieces` to `fd` one after the other.
+Expected<void> WritePieces(int fd,
+                           absl::Span<const BufferRef<uint8_t>> pieces) {
+#if defined(_WIN32)
+  for (const auto& piece : pieces) {
+    const uint8_t* data = piece.Data();
+    size_t size = piece.Size();
+    while (size > 0) {
+      const int written = _write(
+          fd, data, static_cast<unsigned int>(std::min<size_t>(size, INT_MAX)));
+      if (written < 0) {
+        LITERT_LOG(LITERT_ERROR, "Failed to write model: %s", strerror(errno));
+        return Error(kLiteRtStatusErrorFileIO);
+      }
+      data += written;
+      size -= written;
+    }
+  }
+#else
+  std::vector<iovec> iovs;
+  iovs.reserve(pieces.size());
+  for (const auto& piece : pieces) {
+    iovs.push_back({const_cast<uint8_t*>(piece.Data()), piece.Size()});
+  }
+  size_t next = 0;
+  while (next < iovs.size()) {
+    const int count = std::min<size_t>(iovs.size() - next, IOV_MAX);
+    const ssize_t written = writev(fd, &iovs[next], count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LITERT_LOG(LITERT_ERROR, "Failed to write model: %s", strerror(errno));
+      return Error(kLiteRtStatusErrorFileIO);
+    }
+    // Skip the fully written pieces and the written part of the next one.
+    size_t remaining = written;
+    while (next < iovs.size() && remaining >= iovs[next].iov_len) {
+      remaining -= iovs[next].iov_len;
+      ++next;
+    }
+    if (remaining > 0) {
+      iovs[next].iov_base = static_cast<uint8_t*>(iovs[next].iov_base) +
+                            remaining;
+      iovs[next].iov_len -= remaining;
+    }
+  }
+#endif  // defined(_WIN32)
+  return {};
+}
+
+}  // namespace
+
+Expected<OwningBufferRef<uint8_t>> SerializeModel(LiteRtModelT&& model,
+                                                  size_t bytecode_alignment) {
+  LITERT_ASSIGN_OR_RETURN(auto serialized,
+                          Serialize(model, bytecode_alignment));
+  if (serialized.appended_buffers.empty()) {
+    return std::move(serialized.flatbuffer);
+  }
+
+  // Allocate buffer enough for original model and appended buffers and copy.
+  OwningBufferRef<uint8_t> final_model(serialized.size);
+  uint8_t* const start = final_model.Data();
+  std::memcpy(start, serialized.flatbuffer.Data(),
+              serialized.flatbuffer.Size());
+  for (const auto& [offset, buffer] : serialized.appended_buffers) {
+    std::memcpy(start + offset, buffer.Data(), buffer.Size());
+  }
+  return final_model;
+}
+
+Expected<size_t> SerializeModelToFd(LiteRtModelT&& model, int fd,
+                                    size_t bytecode_alignment) {
+  LITERT_ASSIGN_OR_RETURN(auto serialized,
+                          Serialize(model, bytecode_alignment));
+  std::vector<uint8_t> zeros;
+  const auto pieces = GetPieces(serialized, zeros);
+  LITERT_RETURN_IF_ERROR(WritePieces(fd, pieces));
+  return serialized.size;
+}
+
+Expected<size_t> SerializeModelToStream(LiteRtModelT&& model,
+                                        std::ostream& out,
+                                        size_t bytecode_alignment) {
+  LITERT_ASSIGN_OR_RETURN(auto serialized,
+                          Serialize(model, bytecode_alignment));
+  std::vector<uint8_t> zeros;
+  for (const auto& piece : GetPieces(serialized, zeros)) {
+    out.write(piece.StrData(), piece.Size());
+  }
+  if (!out.good()) {
+    LITERT_LOG(LITERT_ERROR, "Failed to write model to stream");
+    return Error(kLiteRtStatusErrorFileIO);
+  }
+  return serialized.size;
 }
 
 }  // namespace litert::internal
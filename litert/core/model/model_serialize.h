@@ -15,6 +15,10 @@
 #ifndef ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
 #define ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
 #include "litert/c/litert_model.h"
 #include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_expected.h"
@@ -24,6 +28,19 @@ namespace litert::internal {
 Expected<OwningBufferRef<uint8_t>> SerializeModel(
     LiteRtModelT&& model, size_t bytecode_alignment = 1);
 
+// Serializes `model` into the file descriptor `fd`. The flatbuffer and each
+// of the buffers appended to it are written straight from where they are with
+// scatter-gather I/O, without assembling the serialized model in memory.
+// Returns the number of bytes written.
+Expected<size_t> SerializeModelToFd(LiteRtModelT&& model, int fd,
+                                    size_t bytecode_alignment = 1);
+
+// Same as SerializeModelToFd() for streams, each piece of the serialized model
+// is written with a separate call.
+Expected<size_t> SerializeModelToStream(LiteRtModelT&& model,
+                                        std::ostream& out,
+                                        size_t bytecode_alignment = 1);
+
 }  // namespace litert::internal
 
 #endif  // ODML_LITERT_LITERT_CORE_MODEL_MODEL_SERIALIZE_H_
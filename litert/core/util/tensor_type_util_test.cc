@@ -52,6 +52,18 @@ TEST(TensorTypeUtil, GetNumPackedBytes) {
   EXPECT_EQ(*num_bytes, sizeof(int32_t) * 6);
 }
 
+TEST(TensorTypeUtil, GetNumPackedBytesSubByte) {
+  constexpr std::array<int, 2> dimensions = {3, 3};
+  auto int4_bytes =
+      GetNumPackedBytes(kLiteRtElementTypeInt4, absl::MakeSpan(dimensions));
+  ASSERT_TRUE(int4_bytes);
+  EXPECT_EQ(*int4_bytes, 5);
+  auto int2_bytes =
+      GetNumPackedBytes(kLiteRtElementTypeInt2, absl::MakeSpan(dimensions));
+  ASSERT_TRUE(int2_bytes);
+  EXPECT_EQ(*int2_bytes, 3);
+}
+
 TEST(TensorTypeUtil, GetNumBytes) {
   LiteRtElementType element_type = kLiteRtElementTypeInt32;
   constexpr std::array<int, 3> dimensions = {3, 2, 1};
@@ -15,9 +15,11 @@
 #include "litert/runtime/accelerators/xnnpack/xnnpack_accelerator.h"
 
 #include <memory>
+#include <string>
 
 #include "litert/c/internal/litert_accelerator_registration.h"
 #include "litert/c/internal/litert_delegate_wrapper.h"
+#include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_opaque_options.h"
 #include "litert/c/litert_options.h"
@@ -26,14 +28,55 @@
 #include "litert/cc/litert_macros.h"
 #include "litert/runtime/accelerator.h"
 #include "litert/runtime/accelerators/accelerator_implementation_helper.h"
+#include "litert/runtime/litert_cpu_options.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
 
 namespace litert {
 namespace {
 
 constexpr const char kCpuAcceleratorName[] = "CpuAccelerator";
 
+// Overrides `xnn_options` with the configuration the CPU autotuner found for
+// the model on this type of host, if it has been tuned. The tuned weight cache
+// path is kept in `weight_cache_file_path`, which must outlive the creation of
+// the delegate. The tuned cores are applied to the calling thread through
+// `affinity`, which must be restored once the delegate has created its worker
+// threads.
+void ApplyCpuTuningResult(
+    const LiteRtCpuOptionsT& cpu_options,
+    TfLiteXNNPackDelegateOptions& xnn_options,
+    std::string& weight_cache_file_path,
+    tflite::acceleration::ScopedThreadAffinity& affinity) {
+  tflite::acceleration::CpuTuningResult result;
+  if (!tflite::acceleration::LoadCpuTuningResult(
+          cpu_options.tuning_storage_path, &result)) {
+    LITERT_LOG(LITERT_INFO, "No CPU tuning results for %s on this host.",
+               cpu_options.tuning_storage_path);
+    return;
+  }
+  const tflite::acceleration::CpuTuningConfig& config = result.config;
+  xnn_options.num_threads = config.num_threads;
+  xnn_options.flags = config.xnnpack_flags;
+  if (!config.weight_cache_file_path.empty() &&
+      xnn_options.weight_cache_file_path == nullptr &&
+      xnn_options.weight_cache_file_descriptor <= 0) {
+    weight_cache_file_path = config.weight_cache_file_path;
+    xnn_options.weight_cache_file_path = weight_cache_file_path.c_str();
+  }
+  // XNNPack's worker threads are created with the delegate and inherit the
+  // affinity of this thread. Without workers there is nothing to restrict.
+  if (config.num_threads > 1) {
+    affinity.Set(config.affinity_mask);
+  }
+  LITERT_LOG(LITERT_INFO,
+             "Applied CPU tuning results: %d threads, XNNPack flags 0x%x, "
+             "affinity 0x%llx.",
+             config.num_threads, config.xnnpack_flags,
+             static_cast<unsigned long long>(config.affinity_mask));
+}
+
 struct CpuAcceleratorVersion {
   static constexpr int kMajor = 1;
   static constexpr int kMinor = 0;
@@ -86,6 +129,10 @@ class CpuAccelerator final
     // TODO: b/403547017 - Make the CPU accelerator configurable using the
     // compilation options.
     auto xnn_options = TfLiteXNNPackDelegateOptionsDefault();
+    // Tuning state only needed while the delegate is created. The user's
+    // options and thread are left as they were.
+    std::string tuned_weight_cache_file_path;
+    tflite::acceleration::ScopedThreadAffinity affinity;
     if (cpu_options != nullptr) {
       LiteRtGetCpuOptionsNumThread(cpu_options, &xnn_options.num_threads);
       LiteRtGetCpuOptionsXNNPackFlags(cpu_options, &xnn_options.flags);
@@ -94,9 +141,14 @@ class CpuAccelerator final
       LITERT_RETURN_IF_ERROR(
           LiteRtGetCpuOptionsXnnPackWeightCacheFileDescriptor(
               cpu_options, &xnn_options.weight_cache_file_descriptor));
+      if (cpu_options->tuning_storage_path != nullptr) {
+        ApplyCpuTuningResult(*cpu_options, xnn_options,
+                             tuned_weight_cache_file_path, affinity);
+      }
     }
     TfLiteOpaqueDelegate* xnnpack_delegate =
         TfLiteXNNPackDelegateCreate(&xnn_options);
+    affinity.Restore();
     LITERT_RETURN_IF_ERROR(xnnpack_delegate != nullptr,
                            ErrorStatusBuilder(kLiteRtStatusErrorRuntimeFailure))
         << "XNNPack delegate failed to be created.";
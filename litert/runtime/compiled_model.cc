@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdarg>
 #include <functional>
 #include <iterator>
@@ -78,6 +79,7 @@
 #include "litert/runtime/litert_runtime_options.h"
 #include "litert/runtime/magic_number_utils.h"
 #include "litert/runtime/metrics.h"
+#include "litert/runtime/pipelined_execution.h"
 #include "litert/runtime/tensor_buffer.h"
 #include "litert/runtime/tensor_buffer_requirements.h"
 #include "litert/runtime/tensor_identifier.h"
@@ -319,6 +321,9 @@ Expected<void> LiteRtCompiledModelT::InitializeRuntime(
     // TODO(b/456318365): Handle weight access request to support multiple
     // backends.
     request.opencl = false;
+    // Lets the kernel read the weights ahead of the first inference, in the
+    // order the ops use them.
+    request.prefetch = weight_loader::WeightPrefetch::kWillNeed;
     absl::Status prepare_status = weight_loader_->PrepareAccess(request, env);
     if (!prepare_status.ok()) {
       return litert::Unexpected(kLiteRtStatusErrorRuntimeFailure,
@@ -811,13 +816,23 @@ litert::Expected<bool> LiteRtCompiledModelT::ApplyPluginsWithCaching(
   }
   LITERT_LOG(LITERT_INFO, "JIT compilation changed model, reserializing...");
 
-  LITERT_ASSIGN_OR_RETURN(auto serialized, SerializeModel(std::move(model)));
   if (model_hash.has_value()) {
+    // Stream the compiled model into the cache and map it from there, rather
+    // than holding the serialized model in memory.
     LITERT_LOG(LITERT_DEBUG, "Saving JIT compiled model to cache.");
-    LITERT_RETURN_IF_ERROR(
-        compilation_cache_.value().SaveModel(serialized, model_hash.value()));
+    LITERT_RETURN_IF_ERROR(compilation_cache_.value().SerializeAndSaveModel(
+        std::move(model), model_hash.value()));
+    if (!TryLoadingFromCache(model_hash.value())) {
+      return Unexpected(kLiteRtStatusErrorFileIO,
+                        "Failed to load JIT compiled model from cache");
+    }
+    LITERT_LOG(LITERT_DEBUG,
+               "Plugins applied, flatbuffer model initialized from cached JIT "
+               "compiled model.");
+    return true;
   }
 
+  LITERT_ASSIGN_OR_RETURN(auto serialized, SerializeModel(std::move(model)));
   model_buf_ = std::move(serialized);
   fb_model_ = tflite::FlatBufferModel::BuildFromBuffer(
       reinterpret_cast<const char*>(model_buf_.Data()), model_buf_.Size(),
@@ -1432,6 +1447,78 @@ Expected<void> LiteRtCompiledModelT::RunCApi(
   return result;
 }
 
+Expected<void> LiteRtCompiledModelT::RunWithDeadlineCApi(
+    size_t signature_index, size_t num_input_buffers,
+    const LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+    const LiteRtTensorBuffer* output_buffers,
+    std::chrono::steady_clock::time_point deadline) {
+  if (std::chrono::steady_clock::now() >= deadline) {
+    return Unexpected(kLiteRtStatusErrorTimeoutExpired,
+                      "Deadline expired before the execution started");
+  }
+  interp_->SetInvocationDeadline(deadline);
+  auto result = RunCApi(signature_index, num_input_buffers, input_buffers,
+                        num_output_buffers, output_buffers, /*async=*/nullptr);
+  interp_->ClearInvocationDeadline();
+  // The interpreter reports both as cancelled, tell them apart here.
+  if (!result && result.Error().Status() == kLiteRtStatusCancelled &&
+      std::chrono::steady_clock::now() >= deadline) {
+    return Unexpected(kLiteRtStatusErrorTimeoutExpired,
+                      "Execution exceeded its deadline");
+  }
+  return result;
+}
+
+Expected<void> LiteRtCompiledModelT::RunPipelined(
+    absl::string_view signature_key,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+    size_t max_in_flight) {
+  auto runner = GetSignatureRunner(signature_key);
+  if (runner == nullptr) {
+    return Unexpected(kLiteRtStatusErrorNotFound,
+                      "Failed to get signature runner");
+  }
+  if (auto res = runner->AllocateTensors(); res != kTfLiteOk) {
+    if (error_reporter_) {
+      error_reporter_->Report("Failed to allocate tensors for execution");
+    }
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                      "Failed to allocate tensors");
+  }
+  LITERT_RETURN_IF_ERROR(MarkSignatureAllocationUpToDate(runner));
+
+  const int subgraph_index = interp_->GetSubgraphIndexFromSignature(
+      std::string(signature_key).c_str());
+  return litert::internal::RunPipelined(*interp_->subgraph(subgraph_index),
+                                        *buffer_context_, input_buffers,
+                                        output_buffers, max_in_flight);
+}
+
+Expected<void> LiteRtCompiledModelT::RunPipelinedCApi(
+    size_t signature_index, size_t num_inferences, size_t num_input_buffers,
+    const LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+    const LiteRtTensorBuffer* output_buffers, size_t max_in_flight) {
+  if (signature_index >= signature_keys_.size()) {
+    return Unexpected(kLiteRtStatusErrorIndexOOB,
+                      "Signature index is out of range of signature keys");
+  }
+  std::vector<std::vector<LiteRtTensorBuffer>> input_buffers_vec;
+  std::vector<std::vector<LiteRtTensorBuffer>> output_buffers_vec;
+  input_buffers_vec.reserve(num_inferences);
+  output_buffers_vec.reserve(num_inferences);
+  for (size_t i = 0; i < num_inferences; ++i) {
+    input_buffers_vec.emplace_back(
+        input_buffers + i * num_input_buffers,
+        input_buffers + (i + 1) * num_input_buffers);
+    output_buffers_vec.emplace_back(
+        output_buffers + i * num_output_buffers,
+        output_buffers + (i + 1) * num_output_buffers);
+  }
+  return RunPipelined(*signature_keys_[signature_index], input_buffers_vec,
+                      output_buffers_vec, max_in_flight);
+}
+
 Expected<void> LiteRtCompiledModelT::StartMetricsCollection(int detail_level) {
   if (detail_level < 0) {
     return Unexpected(kLiteRtStatusErrorInvalidArgument,
@@ -1729,6 +1816,22 @@ Expected<std::string> LiteRtCompiledModelT::GetErrorMessages() {
   return buffer_reporter->message();
 }
 
+Expected<void> LiteRtCompiledModelT::EnableCancellation() {
+  if (interp_->EnableCancellation() != kTfLiteOk) {
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                      "Failed to enable cancellation");
+  }
+  return {};
+}
+
+Expected<void> LiteRtCompiledModelT::Cancel() {
+  if (interp_->Cancel() != kTfLiteOk) {
+    return Unexpected(kLiteRtStatusErrorUnsupported,
+                      "Cancellation is not enabled");
+  }
+  return {};
+}
+
 bool LiteRtCompiledModelT::CheckCancelledWrapper(void* data) {
   auto* model = static_cast<LiteRtCompiledModelT*>(data);
   if (model && model->check_cancelled_func_cpp_) {
@@ -16,6 +16,7 @@
 #define ODML_LITERT_LITERT_RUNTIME_COMPILED_MODEL_H_
 
 #include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -164,6 +165,37 @@ class LiteRtCompiledModelT {
                                  const LiteRtTensorBuffer* output_buffers,
                                  bool* async);
 
+  // The same as RunCApi() without asynchronous execution, but the execution
+  // stops once `deadline` has passed and then fails with
+  // kLiteRtStatusErrorTimeoutExpired. CPU kernels stop between nodes, loop
+  // iterations or GEMM chunks, a delegated partition isn't interrupted once it
+  // started. The tensors stay allocated, so the model can be run again right
+  // away.
+  litert::Expected<void> RunWithDeadlineCApi(
+      size_t signature_index, size_t num_input_buffers,
+      const LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+      const LiteRtTensorBuffer* output_buffers,
+      std::chrono::steady_clock::time_point deadline);
+
+  // Runs independent inferences of the given signature, where
+  // `input_buffers[i]` and `output_buffers[i]` hold the buffers of the i-th
+  // inference. The CPU ops of some inferences run while the NPU executes
+  // others, with up to `max_in_flight` inferences in flight. The buffer
+  // contents are copied, and the signature I/O must not have been bound to
+  // tensor buffers by Run(). See litert::internal::RunPipelined().
+  litert::Expected<void> RunPipelined(
+      absl::string_view signature_key,
+      absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+      absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+      size_t max_in_flight);
+
+  // The same as RunPipelined() for C API. The buffers are laid out inference
+  // by inference.
+  litert::Expected<void> RunPipelinedCApi(
+      size_t signature_index, size_t num_inferences, size_t num_input_buffers,
+      const LiteRtTensorBuffer* input_buffers, size_t num_output_buffers,
+      const LiteRtTensorBuffer* output_buffers, size_t max_in_flight);
+
   litert::Expected<void> StartMetricsCollection(int detail_level);
 
   litert::Expected<LiteRtMetricsT> StopMetricsCollection();
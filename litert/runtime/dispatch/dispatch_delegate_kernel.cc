@@ -30,6 +30,7 @@
 #include "absl/container/node_hash_set.h"  // from @com_google_absl
 #include "absl/strings/str_format.h"  // from @com_google_absl
 #include "litert/c/internal/litert_logging.h"
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_metrics.h"
 #include "litert/c/litert_model_types.h"
@@ -170,6 +171,8 @@ TfLiteStatus DispatchDelegateKernel::Eval(TfLiteOpaqueContext* context,
 
 litert::Expected<void> DispatchDelegateKernel::StartMetricsCollection(
     int detail_level) {
+  cpu_sync_bytes_ = 0;
+  num_invocations_ = 0;
   for (auto invocation_context : node_invocation_contexts_) {
     LITERT_RETURN_IF_ERROR(
         LiteRtDispatchStartMetricsCollection(invocation_context, detail_level));
@@ -204,6 +207,15 @@ Expected<LiteRtMetricsT> DispatchDelegateKernel::StopMetricsCollection() {
     }
   }
 
+  LiteRtAny cpu_sync_bytes = {/*.type=*/kLiteRtAnyTypeInt};
+  cpu_sync_bytes.int_value = static_cast<int64_t>(cpu_sync_bytes_);
+  metrics.push_back(
+      {/*.name=*/"dispatch_cpu_sync_bytes", /*.value=*/cpu_sync_bytes});
+  LiteRtAny num_invocations = {/*.type=*/kLiteRtAnyTypeInt};
+  num_invocations.int_value = static_cast<int64_t>(num_invocations_);
+  metrics.push_back(
+      {/*.name=*/"dispatch_num_invocations", /*.value=*/num_invocations});
+
   return LiteRtMetricsT{/*.metrics=*/std::move(metrics)};
 }
 
@@ -295,6 +307,10 @@ Expected<void> DispatchDelegateKernel::InitHelper(
 
 Expected<void> DispatchDelegateKernel::PrepareHelper(
     TfLiteOpaqueContext* context, TfLiteOpaqueNode* node) {
+  // Tensor allocation types are final at this point, but the arena has not
+  // been allocated yet. Shared tensors are bound to their data on the first
+  // Eval() and whenever the data moves.
+  LITERT_RETURN_IF_ERROR(PlanCpuSharedTensors(context));
   return {};
 }
 
@@ -323,6 +339,7 @@ Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
                                 tensor_buffer_info.tensor_buffer->Lock(
                                     kLiteRtTensorBufferLockModeRead));
         std::memcpy(host_buffer, tensor_data, buffer_size);
+        cpu_sync_bytes_ += buffer_size;
         LITERT_RETURN_IF_ERROR(tensor_buffer_info.tensor_buffer->Unlock());
       }
     }
@@ -330,10 +347,47 @@ Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
 
   if (async_dispatch_ && buffer_context_->IsAsyncExecutionMode()) {
     LITERT_RETURN_IF_ERROR(ScheduleAsyncExecution(context));
+    // Shared tensors are accessed by CPU ops, which don't wait on events, and
+    // their memory may be reused by the TFL arena once this kernel returns.
+    // Hence the execution must be complete before returning.
+    if (HasCpuSharedTensors()) {
+      LITERT_RETURN_IF_ERROR(WaitForOutputEvents(context));
+    } else if (buffer_context_->IsPipelinedExecutionMode()) {
+      // The pipelined executor runs other work while the NPU is busy, and
+      // completes this invocation before anything consumes its outputs.
+      buffer_context_->SetPendingCompletion(
+          [this, context]() -> Expected<void> {
+            LITERT_RETURN_IF_ERROR(WaitForOutputEvents(context));
+            return SyncOutputsToCpu(context);
+          });
+      return {};
+    }
   } else {
     LITERT_RETURN_IF_ERROR(ScheduleSyncExecution(context));
   }
 
+  return SyncOutputsToCpu(context);
+}
+
+Expected<void> DispatchDelegateKernel::WaitForOutputEvents(
+    TfLiteOpaqueContext* context) {
+  for (int tensor_id : output_tensor_ids_) {
+    auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
+    if (!tfl_tensor) {
+      continue;
+    }
+    auto& tensor_buffer =
+        tensor_buffer_infos_.find(tfl_tensor)->second.tensor_buffer;
+    if (tensor_buffer->HasEvent()) {
+      LITERT_ASSIGN_OR_RETURN(LiteRtEventT * event, tensor_buffer->GetEvent());
+      LITERT_RETURN_IF_ERROR(event->Wait(/*timeout_in_ms=*/-1));
+    }
+  }
+  return {};
+}
+
+Expected<void> DispatchDelegateKernel::SyncOutputsToCpu(
+    TfLiteOpaqueContext* context) {
   for (int tensor_id : output_tensor_ids_) {
     auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
     if (!tfl_tensor) {
@@ -353,14 +407,25 @@ Expected<void> DispatchDelegateKernel::EvalHelper(TfLiteOpaqueContext* context,
                                 tensor_buffer_info.tensor_buffer->Lock(
                                     kLiteRtTensorBufferLockModeWrite));
         std::memcpy(tensor_data, host_buffer, buffer_size);
+        cpu_sync_bytes_ += buffer_size;
         LITERT_RETURN_IF_ERROR(tensor_buffer_info.tensor_buffer->Unlock());
       }
     }
   }
 
+  ++num_invocations_;
   return {};
 }
 
+bool DispatchDelegateKernel::HasCpuSharedTensors() const {
+  for (const auto& [tfl_tensor, tensor_buffer_info] : tensor_buffer_infos_) {
+    if (tensor_buffer_info.shared_with_cpu) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // /////////////////////////////////////////////////////////////////////////////
 
 Expected<std::vector<TfLiteOpaqueNode*>> DispatchDelegateKernel::GetNodes(
@@ -674,8 +739,12 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
   std::set<LiteRtTensorBufferHandle> unused_buffer_handles;
 
   auto allocate_and_register =
-      [this, context, &unused_buffer_handles,
-       &io_tensors](auto* tfl_tensor) -> Expected<void> {
+      [this, context, &unused_buffer_handles, &io_tensors](
+          int tensor_id, auto* tfl_tensor) -> Expected<void> {
+    // Pipelined executions keep several requests in flight, whose boundary
+    // tensors take turns in the TFL arena, so nothing is shared with it.
+    const bool share_with_cpu = cpu_shared_tensor_ids_.contains(tensor_id) &&
+                                !buffer_context_->IsPipelinedExecutionMode();
     auto iter = tensor_buffer_infos_.find(tfl_tensor);
     if (iter != tensor_buffer_infos_.end()) {
       auto& tensor_buffer_info = iter->second;
@@ -687,10 +756,37 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
         return {};
       }
 
-      LITERT_ASSIGN_OR_RETURN(LiteRtTensorBufferPtr tensor_buffer,
-                              buffer_context_->GetTensorBuffer(tfl_tensor));
-      if (tensor_buffer == tensor_buffer_info.tensor_buffer) {
-        return {};
+      // A tensor buffer wrapping the TFL tensor data must follow the data
+      // when TFL moves it, e.g. when the arena grows, and is replaced with a
+      // regular one if the tensor can no longer be shared.
+      bool rebind = false;
+      if (tensor_buffer_info.shared_with_cpu) {
+        auto host_buffer = tensor_buffer_info.tensor_buffer->GetHostBuffer();
+        rebind = !share_with_cpu || !host_buffer ||
+                 *host_buffer != TfLiteOpaqueTensorData(tfl_tensor) ||
+                 tensor_buffer_info.tensor_buffer_used_size !=
+                     TfLiteOpaqueTensorByteSize(tfl_tensor);
+      } else if (share_with_cpu && tensor_buffer_info.maybe_sync_with_cpu) {
+        // The tensor stopped being shared for a pipelined execution, share it
+        // again unless someone else provided a tensor buffer meanwhile.
+        auto tensor_buffer = buffer_context_->GetTensorBuffer(tfl_tensor);
+        rebind = tensor_buffer &&
+                 *tensor_buffer == tensor_buffer_info.tensor_buffer;
+      }
+
+      LiteRtTensorBufferPtr tensor_buffer;
+      if (rebind) {
+        LITERT_ASSIGN_OR_RETURN(
+            tensor_buffer,
+            CreateCpuBoundaryTensorBuffer(tfl_tensor, share_with_cpu));
+      } else {
+        LITERT_ASSIGN_OR_RETURN(tensor_buffer,
+                                buffer_context_->GetTensorBuffer(tfl_tensor));
+        if (tensor_buffer == tensor_buffer_info.tensor_buffer) {
+          return {};
+        }
+        // The tensor buffer is owned by someone else now.
+        tensor_buffer_info.shared_with_cpu = false;
       }
 
       // The tensor buffer associated with tfl_tensor has changed. Consequently,
@@ -730,29 +826,16 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
     // Allocate a tensor_buffer_info record for tfl_tensor. It will be used by
     // the calls below.
     auto& tensor_buffer_info = tensor_buffer_infos_[tfl_tensor];
+    (void)tensor_buffer_info;
 
     LiteRtTensorBufferPtr buffer_to_register;
     if (auto tensor_buffer = buffer_context_->GetTensorBuffer(tfl_tensor);
         tensor_buffer) {
       buffer_to_register = std::move(*tensor_buffer);
     } else {
-      LITERT_ASSIGN_OR_RETURN(auto new_tensor_buffer,
-                              AllocateTensorBuffer(tfl_tensor));
-      // The LiteRtTensorBuffer is shared between the buffer_context_ and the
-      // Dispatch API. To manage its lifetime correctly, we use manual reference
-      // counting. A new buffer is created with a ref count of 1. We then call
-      // Duplicate() to increment the ref count to 2. One reference is owned by
-      // the buffer_context_ (via context_buffer) and the other is passed to the
-      // Dispatch API (via buffer_to_register). The buffer will be deallocated
-      // only when both owners have released their references.
-      new_tensor_buffer->Duplicate();
-      LiteRtTensorBufferPtr context_buffer(new_tensor_buffer.get());
-      LITERT_RETURN_IF_ERROR(buffer_context_->RegisterTensorBuffer(
-          tfl_tensor, std::move(context_buffer)));
-      size_t tfl_tensor_size = TfLiteOpaqueTensorByteSize(tfl_tensor);
-      tensor_buffer_info.MarkAsMaybeSyncWithCpu(tfl_tensor_size);
-
-      buffer_to_register = std::move(new_tensor_buffer);
+      LITERT_ASSIGN_OR_RETURN(
+          buffer_to_register,
+          CreateCpuBoundaryTensorBuffer(tfl_tensor, share_with_cpu));
     }
 
     // Register the tensor buffer with the dispatch API.
@@ -767,7 +850,7 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
     if (!tfl_tensor) {
       continue;
     }
-    LITERT_RETURN_IF_ERROR(allocate_and_register(tfl_tensor));
+    LITERT_RETURN_IF_ERROR(allocate_and_register(tensor_id, tfl_tensor));
   }
 
   // Allocate buffers for output tensors
@@ -776,7 +859,7 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
     if (!tfl_tensor) {
       continue;
     }
-    LITERT_RETURN_IF_ERROR(allocate_and_register(tfl_tensor));
+    LITERT_RETURN_IF_ERROR(allocate_and_register(tensor_id, tfl_tensor));
   }
 
   // Then allocate intermediate tensor buffers. They are always allocated,
@@ -824,6 +907,102 @@ Expected<void> DispatchDelegateKernel::AllocateTensorBuffersIfNeeded(
   return {};
 }
 
+Expected<void> DispatchDelegateKernel::PlanCpuSharedTensors(
+    TfLiteOpaqueContext* context) {
+  // Tensors of the TFL subgraph interface are bound to tensor buffers by the
+  // upper-level runtime and are therefore not considered here.
+  absl::flat_hash_set<int> interface_tensor_ids;
+  for (auto get_tensor_ids :
+       {TfLiteOpaqueContextGetInputs, TfLiteOpaqueContextGetOutputs,
+        TfLiteOpaqueContextGetVariables}) {
+    const int* tensor_ids = nullptr;
+    int num_tensor_ids = 0;
+    if (get_tensor_ids(context, &tensor_ids, &num_tensor_ids) != kTfLiteOk) {
+      return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                        "Failed to get subgraph interface tensors");
+    }
+    interface_tensor_ids.insert(tensor_ids, tensor_ids + num_tensor_ids);
+  }
+
+  cpu_shared_tensor_ids_.clear();
+  for (const auto* tensor_ids : {&input_tensor_ids_, &output_tensor_ids_}) {
+    for (int tensor_id : *tensor_ids) {
+      if (interface_tensor_ids.contains(tensor_id)) {
+        continue;
+      }
+      auto* tfl_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, tensor_id);
+      if (tfl_tensor && CanShareMemoryWithCpu(tfl_tensor)) {
+        cpu_shared_tensor_ids_.insert(tensor_id);
+      }
+    }
+  }
+
+  return {};
+}
+
+bool DispatchDelegateKernel::CanShareMemoryWithCpu(
+    TfLiteOpaqueTensor* tfl_tensor) const {
+  // Arena tensors are aligned and keep their data for as long as any node
+  // that uses them runs. Other allocation types give no such guarantees.
+  if (TfLiteOpaqueTensorGetAllocationType(tfl_tensor) != kTfLiteArenaRw) {
+    return false;
+  }
+  auto requirements = buffer_context_->GetBufferRequirements(tfl_tensor);
+  if (!requirements) {
+    return false;
+  }
+  const auto& supported_types = (*requirements)->SupportedBufferTypes();
+  return std::find(supported_types.begin(), supported_types.end(),
+                   kLiteRtTensorBufferTypeHostMemory) !=
+             supported_types.end() &&
+         (*requirements)->Strides().empty() &&
+         (*requirements)->Alignment() <= LITERT_HOST_MEMORY_BUFFER_ALIGNMENT &&
+         (*requirements)->BufferSize() ==
+             TfLiteOpaqueTensorByteSize(tfl_tensor);
+}
+
+Expected<LiteRtTensorBufferPtr>
+DispatchDelegateKernel::CreateCpuBoundaryTensorBuffer(
+    TfLiteOpaqueTensor* tfl_tensor, bool share_with_cpu) {
+  auto& tensor_buffer_info = tensor_buffer_infos_[tfl_tensor];
+  size_t tfl_tensor_size = TfLiteOpaqueTensorByteSize(tfl_tensor);
+  void* tensor_data = TfLiteOpaqueTensorData(tfl_tensor);
+  if (reinterpret_cast<uintptr_t>(tensor_data) %
+          LITERT_HOST_MEMORY_BUFFER_ALIGNMENT !=
+      0) {
+    share_with_cpu = false;
+  }
+
+  LiteRtTensorBufferPtr new_tensor_buffer;
+  if (share_with_cpu && tensor_data) {
+    LITERT_ASSIGN_OR_RETURN(LiteRtRankedTensorType litert_tensor_type,
+                            ConvertTensorType(tfl_tensor));
+    LiteRtTensorBufferT* tensor_buffer;
+    LITERT_RETURN_IF_ERROR(LiteRtCreateTensorBufferFromHostMemory(
+        &litert_tensor_type, tensor_data, tfl_tensor_size,
+        /*deallocator=*/nullptr, &tensor_buffer));
+    new_tensor_buffer.reset(tensor_buffer);
+    tensor_buffer_info.MarkAsSharedWithCpu(tfl_tensor_size);
+  } else {
+    LITERT_ASSIGN_OR_RETURN(new_tensor_buffer,
+                            AllocateTensorBuffer(tfl_tensor));
+    tensor_buffer_info.MarkAsMaybeSyncWithCpu(tfl_tensor_size);
+  }
+
+  // The LiteRtTensorBuffer is shared between the buffer_context_ and the
+  // Dispatch API. To manage its lifetime correctly, we use manual reference
+  // counting. A new buffer is created with a ref count of 1. We then call
+  // Duplicate() to increment the ref count to 2. One reference is owned by
+  // the buffer_context_ (via context_buffer) and the other is passed to the
+  // Dispatch API (via the returned pointer). The buffer will be deallocated
+  // only when both owners have released their references.
+  new_tensor_buffer->Duplicate();
+  LiteRtTensorBufferPtr context_buffer(new_tensor_buffer.get());
+  LITERT_RETURN_IF_ERROR(buffer_context_->RegisterTensorBuffer(
+      tfl_tensor, std::move(context_buffer)));
+  return new_tensor_buffer;
+}
+
 Expected<LiteRtTensorBufferPtr> DispatchDelegateKernel::AllocateTensorBuffer(
     TfLiteOpaqueTensor* tfl_tensor) {
   LITERT_ASSIGN_OR_RETURN(auto requirements_ptr,
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
+#include "absl/container/flat_hash_set.h"  // from @com_google_absl
 #include "absl/container/node_hash_map.h"  // from @com_google_absl
 #include "litert/c/litert_common.h"
 #include "litert/cc/litert_expected.h"
@@ -101,9 +102,20 @@ class DispatchDelegateKernel
   Expected<void> ComputeRequirements(TfLiteOpaqueContext* context);
   Expected<void> ComputeTensorPortConnections(TfLiteOpaqueContext* context);
 
+  // Selects the I/O tensors whose TFL memory can be handed to the Dispatch API
+  // as is, so that no copy is needed when CPU ops produce or consume them.
+  Expected<void> PlanCpuSharedTensors(TfLiteOpaqueContext* context);
+  bool CanShareMemoryWithCpu(TfLiteOpaqueTensor* tfl_tensor) const;
+
   Expected<void> AllocateTensorBuffersIfNeeded(TfLiteOpaqueContext* context);
   Expected<LiteRtTensorBufferPtr> AllocateTensorBuffer(
       TfLiteOpaqueTensor* tfl_tensor);
+  // Creates a tensor buffer for an I/O tensor that nobody else provided a
+  // tensor buffer for, and registers it with buffer_context_. The tensor buffer
+  // either wraps the TFL tensor data, if `share_with_cpu`, or is a new
+  // allocation that is synced with the TFL tensor on every invocation.
+  Expected<LiteRtTensorBufferPtr> CreateCpuBoundaryTensorBuffer(
+      TfLiteOpaqueTensor* tfl_tensor, bool share_with_cpu);
   Expected<void> RegisterBufferWithDispatchApi(
       TfLiteOpaqueContext* context, TfLiteOpaqueTensor* tfl_tensor,
       LiteRtTensorBufferPtr&& tensor_buffer);
@@ -113,6 +125,11 @@ class DispatchDelegateKernel
 
   Expected<void> ScheduleAsyncExecution(TfLiteOpaqueContext* context);
   Expected<void> ScheduleSyncExecution(TfLiteOpaqueContext* context);
+  Expected<void> WaitForOutputEvents(TfLiteOpaqueContext* context);
+  // Copies outputs that are not shared with the TFL tensors back to them, and
+  // accounts for a completed invocation.
+  Expected<void> SyncOutputsToCpu(TfLiteOpaqueContext* context);
+  bool HasCpuSharedTensors() const;
 
   Expected<const void*> FindAllocBase() const;
   Expected<int> FindAllocBaseFd() const;
@@ -133,12 +150,22 @@ class DispatchDelegateKernel
   std::vector<int> output_tensor_ids_;
   std::vector<int> internal_tensor_ids_;
 
+  // I/O tensors selected by PlanCpuSharedTensors().
+  absl::flat_hash_set<int> cpu_shared_tensor_ids_;
+
+  // Bytes copied between TFL tensors and tensor buffers, and number of
+  // invocations, since metrics collection started.
+  size_t cpu_sync_bytes_ = 0;
+  size_t num_invocations_ = 0;
+
   std::unordered_map<int, LiteRtTensorBufferHandle> tensor_idx_to_handle_;  // NOLINT
 
   struct TensorInfo {
     LiteRtTensorBufferPtr tensor_buffer;
     LiteRtTensorBufferHandle buffer_handle;
     bool maybe_sync_with_cpu = false;
+    // The tensor buffer wraps the TFL tensor data.
+    bool shared_with_cpu = false;
     size_t tensor_buffer_used_size = 0;
     bool attached = false;
 
@@ -146,6 +173,13 @@ class DispatchDelegateKernel
 
     void MarkAsMaybeSyncWithCpu(size_t used_size) {
       maybe_sync_with_cpu = true;
+      shared_with_cpu = false;
+      tensor_buffer_used_size = used_size;
+    }
+
+    void MarkAsSharedWithCpu(size_t used_size) {
+      maybe_sync_with_cpu = false;
+      shared_with_cpu = true;
       tensor_buffer_used_size = used_size;
     }
   };
@@ -11,6 +11,7 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -20,9 +21,11 @@
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/internal/litert_compiled_model_next.h"
 #include "litert/cc/litert_common.h"
 #include "litert/cc/litert_compiled_model.h"
 #include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_model.h"
 #include "litert/cc/litert_options.h"
 #include "litert/cc/litert_tensor_buffer.h"
 #include "litert/test/common.h"
@@ -102,5 +105,127 @@ TEST(DispatchDelegateTest, SwapInputTensorBufferBetweenInvocations) {
   LITERT_ASSERT_OK(compiled_model.Run(input_map, output_map));
 }
 
+// Tensors passed between CPU ops and the Dispatch API share their memory, so
+// inferences don't copy any data in the steady state.
+TEST(DispatchDelegateTest, CpuBoundaryTensorsAreNotCopied) {
+  const auto litert_libs_path =
+      litert::testing::GetLiteRtPath("vendors/examples");
+  const std::vector<litert::Environment::Option> environment_options = {
+      litert::Environment::Option{
+          litert::Environment::OptionTag::DispatchLibraryDir,
+          litert_libs_path,
+      },
+      litert::Environment::Option{
+          litert::Environment::OptionTag::CompilerPluginLibraryDir,
+          litert_libs_path,
+      },
+  };
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto env,
+      litert::Environment::Create(absl::MakeConstSpan(environment_options)));
+
+  // ADD -> MUL -> MUL -> ADD, where the MULs are offloaded to the NPU.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model, Model::CreateFromFile(litert::testing::GetTestFilePath(
+                      "simple_multi_op.tflite")));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto compiled_model,
+      CompiledModelNext::Create(env, model, litert::HwAccelerators::kNpu));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_buffers,
+                              compiled_model.CreateInputBuffers());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto output_buffers,
+                              compiled_model.CreateOutputBuffers());
+
+  LITERT_ASSERT_OK(compiled_model.StartMetricsCollection(/*detail_level=*/0));
+  constexpr int kNumRuns = 3;
+  for (int i = 1; i <= kNumRuns; ++i) {
+    const float x = i;
+    LITERT_ASSERT_OK(input_buffers[0].Write<float>({x, x, x, x}));
+    LITERT_ASSERT_OK(compiled_model.Run(input_buffers, output_buffers));
+    std::vector<float> output(4);
+    LITERT_ASSERT_OK(output_buffers[0].Read(absl::MakeSpan(output)));
+    const float expected = 2 * (2 * x) * (2 * x) * (2 * x) * (2 * x);
+    EXPECT_THAT(output, ::testing::Each(::testing::FloatEq(expected)));
+  }
+  LITERT_ASSERT_OK_AND_ASSIGN(auto metrics,
+                              compiled_model.StopMetricsCollection());
+
+  int64_t cpu_sync_bytes = -1;
+  int64_t num_invocations = -1;
+  for (const auto& metric : metrics.metrics) {
+    if (metric.name == "dispatch_cpu_sync_bytes") {
+      cpu_sync_bytes = metric.value.int_value;
+    } else if (metric.name == "dispatch_num_invocations") {
+      num_invocations = metric.value.int_value;
+    }
+  }
+  EXPECT_EQ(num_invocations, kNumRuns);
+  EXPECT_EQ(cpu_sync_bytes, 0);
+}
+
+// Inferences run as a pipeline still compute the same results as sequential
+// ones.
+TEST(DispatchDelegateTest, RunPipelined) {
+  const auto litert_libs_path =
+      litert::testing::GetLiteRtPath("vendors/examples");
+  const std::vector<litert::Environment::Option> environment_options = {
+      litert::Environment::Option{
+          litert::Environment::OptionTag::DispatchLibraryDir,
+          litert_libs_path,
+      },
+      litert::Environment::Option{
+          litert::Environment::OptionTag::CompilerPluginLibraryDir,
+          litert_libs_path,
+      },
+  };
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto env,
+      litert::Environment::Create(absl::MakeConstSpan(environment_options)));
+
+  // ADD -> MUL -> MUL -> ADD, where the MULs are offloaded to the NPU.
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto model, Model::CreateFromFile(litert::testing::GetTestFilePath(
+                      "simple_multi_op.tflite")));
+  LITERT_ASSERT_OK_AND_ASSIGN(
+      auto compiled_model,
+      CompiledModelNext::Create(env, model, litert::HwAccelerators::kNpu));
+
+  constexpr int kNumInferences = 5;
+  std::vector<std::vector<TensorBuffer>> input_buffers;
+  std::vector<std::vector<TensorBuffer>> output_buffers;
+  for (int i = 1; i <= kNumInferences; ++i) {
+    LITERT_ASSERT_OK_AND_ASSIGN(auto inputs,
+                                compiled_model.CreateInputBuffers());
+    LITERT_ASSERT_OK_AND_ASSIGN(auto outputs,
+                                compiled_model.CreateOutputBuffers());
+    const float x = i;
+    LITERT_ASSERT_OK(inputs[0].Write<float>({x, x, x, x}));
+    input_buffers.push_back(std::move(inputs));
+    output_buffers.push_back(std::move(outputs));
+  }
+
+  LITERT_ASSERT_OK(compiled_model.StartMetricsCollection(/*detail_level=*/0));
+  LITERT_ASSERT_OK(compiled_model.RunPipelined(
+      /*signature_index=*/0, input_buffers, output_buffers,
+      /*max_in_flight=*/2));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto metrics,
+                              compiled_model.StopMetricsCollection());
+
+  for (int i = 1; i <= kNumInferences; ++i) {
+    std::vector<float> output(4);
+    LITERT_ASSERT_OK(output_buffers[i - 1][0].Read(absl::MakeSpan(output)));
+    const float x = i;
+    const float expected = 2 * (2 * x) * (2 * x) * (2 * x) * (2 * x);
+    EXPECT_THAT(output, ::testing::Each(::testing::FloatEq(expected)));
+  }
+  int64_t num_invocations = -1;
+  for (const auto& metric : metrics.metrics) {
+    if (metric.name == "dispatch_num_invocations") {
+      num_invocations = metric.value.int_value;
+    }
+  }
+  EXPECT_EQ(num_invocations, kNumInferences);
+}
+
 }  // namespace
 }  // namespace litert
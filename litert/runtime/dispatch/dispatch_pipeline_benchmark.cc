@@ -0,0 +1,155 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the throughput of sequential and pipelined inferences of a model
+// whose NPU partitions run on the example dispatch library, with an artificial
+// NPU latency.
+
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"  // from @com_google_absl
+#include "absl/flags/parse.h"  // from @com_google_absl
+#include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/strings/numbers.h"  // from @com_google_absl
+#include "absl/strings/str_split.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/cc/internal/litert_compiled_model_next.h"
+#include "litert/cc/litert_common.h"
+#include "litert/cc/litert_environment.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/cc/litert_model.h"
+#include "litert/cc/litert_tensor_buffer.h"
+#include "litert/test/common.h"
+
+ABSL_FLAG(std::string, graph, "simple_multi_op.tflite",
+          "Test model to run, with NPU partitions between CPU ops.");
+ABSL_FLAG(int, latency_us, 2000, "Artificial latency of every NPU execution.");
+ABSL_FLAG(int, num_inferences, 64, "Number of inferences per measurement.");
+ABSL_FLAG(std::string, max_in_flight, "1,2,4",
+          "Comma separated in-flight depths of the pipelined measurements.");
+
+namespace litert {
+namespace {
+
+using Buffers = std::vector<std::vector<TensorBuffer>>;
+
+Expected<Environment> CreateEnvironment() {
+  const auto litert_libs_path = testing::GetLiteRtPath("vendors/examples");
+  const std::vector<Environment::Option> environment_options = {
+      Environment::Option{
+          Environment::OptionTag::DispatchLibraryDir,
+          litert_libs_path,
+      },
+      Environment::Option{
+          Environment::OptionTag::CompilerPluginLibraryDir,
+          litert_libs_path,
+      },
+  };
+  return Environment::Create(absl::MakeConstSpan(environment_options));
+}
+
+Expected<void> CreateBuffers(const CompiledModelNext& compiled_model,
+                             int num_inferences, Buffers& input_buffers,
+                             Buffers& output_buffers) {
+  for (int i = 0; i < num_inferences; ++i) {
+    LITERT_ASSIGN_OR_RETURN(auto inputs, compiled_model.CreateInputBuffers());
+    LITERT_ASSIGN_OR_RETURN(auto outputs,
+                            compiled_model.CreateOutputBuffers());
+    input_buffers.push_back(std::move(inputs));
+    output_buffers.push_back(std::move(outputs));
+  }
+  return {};
+}
+
+// Returns the throughput of `max_in_flight` pipelined inferences, or of
+// sequential inferences if `max_in_flight` is 0.
+Expected<double> MeasureInferencesPerSecond(Environment& env,
+                                            const Model& model,
+                                            int max_in_flight) {
+  LITERT_ASSIGN_OR_RETURN(
+      auto compiled_model,
+      CompiledModelNext::Create(env, model, HwAccelerators::kNpu));
+  const int num_inferences = absl::GetFlag(FLAGS_num_inferences);
+  Buffers input_buffers;
+  Buffers output_buffers;
+  LITERT_RETURN_IF_ERROR(CreateBuffers(
+      compiled_model, max_in_flight > 0 ? num_inferences : 1, input_buffers,
+      output_buffers));
+
+  auto run = [&]() -> Expected<void> {
+    if (max_in_flight > 0) {
+      return compiled_model.RunPipelined(/*signature_index=*/0, input_buffers,
+                                         output_buffers, max_in_flight);
+    }
+    for (int i = 0; i < num_inferences; ++i) {
+      LITERT_RETURN_IF_ERROR(
+          compiled_model.Run(input_buffers[0], output_buffers[0]));
+    }
+    return {};
+  };
+  // Warm up.
+  LITERT_RETURN_IF_ERROR(run());
+  const absl::Time start = absl::Now();
+  LITERT_RETURN_IF_ERROR(run());
+  return num_inferences / absl::ToDoubleSeconds(absl::Now() - start);
+}
+
+Expected<void> Run() {
+  // Read by the example dispatch library when it's loaded.
+  const std::string latency_us =
+      std::to_string(absl::GetFlag(FLAGS_latency_us));
+  setenv("LITERT_EXAMPLE_DISPATCH_LATENCY_US", latency_us.c_str(),
+         /*overwrite=*/1);
+
+  LITERT_ASSIGN_OR_RETURN(auto env, CreateEnvironment());
+  LITERT_ASSIGN_OR_RETURN(auto model,
+                          Model::CreateFromFile(testing::GetTestFilePath(
+                              absl::GetFlag(FLAGS_graph))));
+
+  LITERT_ASSIGN_OR_RETURN(double sequential,
+                          MeasureInferencesPerSecond(env, model, 0));
+  ABSL_LOG(INFO) << "sequential: " << sequential << " inferences/s";
+  for (absl::string_view depth_str :
+       absl::StrSplit(absl::GetFlag(FLAGS_max_in_flight), ',')) {
+    int depth;
+    if (!absl::SimpleAtoi(depth_str, &depth) || depth <= 0) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Invalid --max_in_flight");
+    }
+    LITERT_ASSIGN_OR_RETURN(double pipelined,
+                            MeasureInferencesPerSecond(env, model, depth));
+    ABSL_LOG(INFO) << "pipelined, max_in_flight=" << depth << ": " << pipelined
+                   << " inferences/s (x" << pipelined / sequential << ")";
+  }
+  return {};
+}
+
+}  // namespace
+}  // namespace litert
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  if (auto result = litert::Run(); !result) {
+    ABSL_LOG(ERROR) << result.Error().Message();
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -156,6 +156,35 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
   // Returns true if the async execution mode is set.
   inline bool IsAsyncExecutionMode() const { return async_execution_mode_; }
 
+  // Sets the pipelined execution mode. It's set by CompiledModel while it
+  // interleaves the execution of consecutive inferences. In this mode, a
+  // DelegateKernel running in async execution mode may return before its
+  // outputs are available on the CPU, after handing over the remaining work to
+  // SetPendingCompletion(). DelegateKernels must not alias CPU tensor memory in
+  // this mode, because the CompiledModel moves tensor data around between
+  // partial invocations.
+  inline void SetPipelinedExecutionMode(bool pipelined_execution_mode) {
+    pipelined_execution_mode_ = pipelined_execution_mode;
+  }
+
+  // Returns true if the pipelined execution mode is set.
+  inline bool IsPipelinedExecutionMode() const {
+    return pipelined_execution_mode_;
+  }
+
+  // Hands over the work that completes the invocation of a DelegateKernel,
+  // i.e. waiting for the accelerator and making the outputs available on the
+  // CPU. Only used in pipelined execution mode.
+  inline void SetPendingCompletion(
+      std::function<litert::Expected<void>()> completion) {
+    pending_completion_ = std::move(completion);
+  }
+
+  // Returns and clears the pending completion, if any.
+  inline std::function<litert::Expected<void>()> TakePendingCompletion() {
+    return std::exchange(pending_completion_, nullptr);
+  }
+
   // Returns the LiteRtEnvironment used to create CompiledModel.
   inline LiteRtEnvironment GetEnvironment() const { return env_; }
 
@@ -234,6 +263,8 @@ class LiteRtExternalLiteRtBufferContextT : public TfLiteExternalContext {
       const LiteRtExternalLiteRtBufferContextT&) = delete;
 
   bool async_execution_mode_ = false;
+  bool pipelined_execution_mode_ = false;
+  std::function<litert::Expected<void>()> pending_completion_;
 
   // Dispatch annotations from the compiled model to be propagated to dispatch
   // graphs.
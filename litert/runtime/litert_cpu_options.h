@@ -22,6 +22,9 @@
 // code.
 struct LiteRtCpuOptionsT {
   TfLiteXNNPackDelegateOptions xnn = TfLiteXNNPackDelegateOptionsDefault();
+  // Mini-benchmark storage path whose CPU tuning results should be applied.
+  // Not owned.
+  const char* tuning_storage_path = nullptr;
 
   static const char* Identifier() { return "xnnpack"; }
 };
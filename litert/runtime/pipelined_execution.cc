@@ -0,0 +1,482 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/runtime/pipelined_execution.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "absl/cleanup/cleanup.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_common.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/cc/litert_macros.h"
+#include "litert/runtime/external_litert_buffer_context.h"
+#include "litert/runtime/tensor_buffer.h"
+#include "tflite/builtin_ops.h"
+#include "tflite/c/common.h"
+#include "tflite/core/subgraph.h"
+
+namespace litert::internal {
+namespace {
+
+constexpr size_t kStorageAlignment = 64;
+
+// Delegate kernels other than XNNPack run on an accelerator, see also
+// LiteRtCompiledModelT::CheckCpuTensors().
+bool RunsOnAccelerator(const TfLiteRegistration& registration) {
+  return registration.builtin_code == kTfLiteBuiltinDelegate &&
+         !(registration.custom_name &&
+           registration.custom_name ==
+               absl::string_view("TfLiteXNNPackDelegate"));
+}
+
+// A range [begin, end) of the execution plan that is run in one go.
+struct Stage {
+  int begin;
+  int end;
+  bool on_accelerator;
+  // For accelerator stages, the last accelerator stage that accesses the
+  // device buffers of this stage's I/O tensors. Another inference can start
+  // this stage once the inference that ran it has completed that stage.
+  int release_after;
+};
+
+// A tensor whose value is needed by a later stage than the one producing it.
+struct BoundaryTensor {
+  int tensor_index;
+  size_t bytes;
+  // Offset within the per-inference storage.
+  size_t offset;
+  // The producing stage, -1 for subgraph inputs.
+  int producer;
+  // The last consuming stage, the number of stages for subgraph outputs.
+  int last_consumer;
+};
+
+class Pipeline {
+ public:
+  Pipeline(tflite::Subgraph& subgraph,
+           LiteRtExternalLiteRtBufferContextT& buffer_context)
+      : subgraph_(subgraph), buffer_context_(buffer_context) {}
+
+  ~Pipeline() {
+    // Don't leave the accelerator writing to buffers after an error.
+    if (completion_) {
+      (void)completion_();
+    }
+  }
+
+  Expected<void> Plan();
+
+  Expected<void> Run(
+      absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+      absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+      size_t max_in_flight);
+
+ private:
+  struct Inference {
+    // The next stage to run, or to complete if `launched`.
+    int next_stage = 0;
+    // Whether the accelerator stage `next_stage` has been started.
+    bool launched = false;
+  };
+
+  int num_stages() const { return stages_.size(); }
+
+  // Whether inference `index` may start `stage`: stages run in the order of
+  // the inferences.
+  bool InOrder(int index, int stage) const {
+    return index == retired_ || inferences_[index - 1].next_stage > stage;
+  }
+
+  uint8_t* Storage(int index) {
+    return storage_.data() + (index % max_in_flight_) * storage_size_;
+  }
+
+  // Makes the arena hold the tensors of inference `index`.
+  void SwitchTo(int index);
+  void CopyLiveTensors(int index, bool to_arena);
+
+  Expected<void> Admit(
+      absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers);
+  Expected<void> Retire(
+      absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers);
+  Expected<void> RunCpuStage(int index);
+  Expected<void> Launch(int index);
+  Expected<void> Complete();
+  void FinishAcceleratorStage(int index);
+  Expected<void> Invoke(const Stage& stage);
+
+  tflite::Subgraph& subgraph_;
+  LiteRtExternalLiteRtBufferContextT& buffer_context_;
+
+  std::vector<Stage> stages_;
+  std::vector<BoundaryTensor> boundary_tensors_;
+  size_t storage_size_ = 0;
+
+  size_t max_in_flight_ = 1;
+  std::vector<uint8_t> storage_;
+  std::vector<Inference> inferences_;
+  // Inferences [retired_, admitted_) are in flight.
+  int retired_ = 0;
+  int admitted_ = 0;
+  // The inference whose tensors are in the arena, or -1.
+  int resident_ = -1;
+  // The inference that owns the accelerator, or -1, and the pending
+  // completion of its current stage.
+  int accelerator_owner_ = -1;
+  std::function<Expected<void>()> completion_;
+  // For each stage, the inference whose device buffers are in use, or -1.
+  std::vector<int> holders_;
+};
+
+Expected<void> Pipeline::Plan() {
+  const std::vector<int>& execution_plan = subgraph_.execution_plan();
+  const auto& nodes_and_registration = subgraph_.nodes_and_registration();
+
+  for (int i = 0; i < execution_plan.size(); ++i) {
+    const bool on_accelerator =
+        RunsOnAccelerator(nodes_and_registration[execution_plan[i]].second);
+    if (on_accelerator || stages_.empty() || stages_.back().on_accelerator) {
+      stages_.push_back({i, i + 1, on_accelerator, num_stages()});
+    } else {
+      stages_.back().end = i + 1;
+    }
+  }
+
+  constexpr int kNone = -2;
+  const size_t num_tensors = subgraph_.tensors_size();
+  std::vector<int> producer(num_tensors, kNone);
+  std::vector<int> last_consumer(num_tensors, kNone);
+  // Accelerator stages accessing each tensor, in increasing order.
+  std::vector<std::vector<int>> accelerator_stages(num_tensors);
+
+  for (int tensor_index : subgraph_.inputs()) {
+    producer[tensor_index] = -1;
+  }
+  for (int s = 0; s < num_stages(); ++s) {
+    for (int i = stages_[s].begin; i < stages_[s].end; ++i) {
+      const TfLiteNode& node = nodes_and_registration[execution_plan[i]].first;
+      for (int tensor_index : absl::MakeConstSpan(node.inputs->data,
+                                                  node.inputs->size)) {
+        if (tensor_index == kTfLiteOptionalTensor) continue;
+        last_consumer[tensor_index] = s;
+        if (stages_[s].on_accelerator) {
+          accelerator_stages[tensor_index].push_back(s);
+        }
+      }
+      for (int tensor_index : absl::MakeConstSpan(node.outputs->data,
+                                                  node.outputs->size)) {
+        if (producer[tensor_index] == kNone) producer[tensor_index] = s;
+        if (stages_[s].on_accelerator) {
+          accelerator_stages[tensor_index].push_back(s);
+        }
+      }
+    }
+  }
+  for (int tensor_index : subgraph_.outputs()) {
+    last_consumer[tensor_index] = num_stages();
+  }
+
+  for (int s = 0; s < num_stages(); ++s) {
+    if (!stages_[s].on_accelerator) continue;
+    const TfLiteNode& node =
+        nodes_and_registration[execution_plan[stages_[s].begin]].first;
+    for (const TfLiteIntArray* tensors : {node.inputs, node.outputs}) {
+      for (int tensor_index :
+           absl::MakeConstSpan(tensors->data, tensors->size)) {
+        if (tensor_index == kTfLiteOptionalTensor) continue;
+        stages_[s].release_after = std::max(
+            stages_[s].release_after, accelerator_stages[tensor_index].back());
+      }
+    }
+  }
+
+  for (const std::vector<int>* io :
+       {&subgraph_.inputs(), &subgraph_.outputs()}) {
+    for (int tensor_index : *io) {
+      if (subgraph_.tensor(tensor_index)->allocation_type != kTfLiteArenaRw) {
+        return Unexpected(
+            kLiteRtStatusErrorUnsupported,
+            absl::StrCat("Pipelined execution requires the I/O tensors to be "
+                         "allocated by the runtime, tensor ",
+                         tensor_index, " is not"));
+      }
+    }
+  }
+
+  for (int tensor_index = 0; tensor_index < num_tensors; ++tensor_index) {
+    const TfLiteTensor* tensor = subgraph_.tensor(tensor_index);
+    if (tensor->allocation_type != kTfLiteArenaRw ||
+        producer[tensor_index] == kNone ||
+        last_consumer[tensor_index] <= producer[tensor_index]) {
+      continue;
+    }
+    boundary_tensors_.push_back({tensor_index, tensor->bytes, storage_size_,
+                                 producer[tensor_index],
+                                 last_consumer[tensor_index]});
+    storage_size_ += (tensor->bytes + kStorageAlignment - 1) /
+                     kStorageAlignment * kStorageAlignment;
+  }
+  return {};
+}
+
+void Pipeline::CopyLiveTensors(int index, bool to_arena) {
+  const int stage = inferences_[index].next_stage;
+  uint8_t* storage = Storage(index);
+  for (const BoundaryTensor& boundary : boundary_tensors_) {
+    if (boundary.producer >= stage || boundary.last_consumer < stage) {
+      continue;
+    }
+    char* data = subgraph_.tensor(boundary.tensor_index)->data.raw;
+    if (to_arena) {
+      std::memcpy(data, storage + boundary.offset, boundary.bytes);
+    } else {
+      std::memcpy(storage + boundary.offset, data, boundary.bytes);
+    }
+  }
+}
+
+void Pipeline::SwitchTo(int index) {
+  if (resident_ == index) {
+    return;
+  }
+  if (resident_ >= 0) {
+    CopyLiveTensors(resident_, /*to_arena=*/false);
+  }
+  CopyLiveTensors(index, /*to_arena=*/true);
+  resident_ = index;
+}
+
+Expected<void> Pipeline::Admit(
+    absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers) {
+  const int index = admitted_;
+  const std::vector<LiteRtTensorBuffer>& buffers = input_buffers[index];
+  uint8_t* storage = Storage(index);
+  for (const BoundaryTensor& boundary : boundary_tensors_) {
+    if (boundary.producer != -1) continue;
+    const auto& inputs = subgraph_.inputs();
+    const size_t i = std::find(inputs.begin(), inputs.end(),
+                               boundary.tensor_index) -
+                     inputs.begin();
+    LiteRtTensorBufferT* buffer = buffers[i];
+    if (buffer->packed_buffer_size() < boundary.bytes) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Input buffer is too small");
+    }
+    LITERT_ASSIGN_OR_RETURN(void* host_memory,
+                            buffer->Lock(kLiteRtTensorBufferLockModeRead));
+    std::memcpy(storage + boundary.offset, host_memory, boundary.bytes);
+    LITERT_RETURN_IF_ERROR(buffer->Unlock());
+  }
+  inferences_[index] = Inference();
+  ++admitted_;
+  return {};
+}
+
+Expected<void> Pipeline::Retire(
+    absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers) {
+  const int index = retired_;
+  SwitchTo(index);
+  const std::vector<LiteRtTensorBuffer>& buffers = output_buffers[index];
+  for (int i = 0; i < subgraph_.outputs().size(); ++i) {
+    const TfLiteTensor* tensor = subgraph_.tensor(subgraph_.outputs()[i]);
+    LiteRtTensorBufferT* buffer = buffers[i];
+    if (buffer->packed_buffer_size() < tensor->bytes) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Output buffer is too small");
+    }
+    LITERT_ASSIGN_OR_RETURN(void* host_memory,
+                            buffer->Lock(kLiteRtTensorBufferLockModeWrite));
+    std::memcpy(host_memory, tensor->data.raw, tensor->bytes);
+    LITERT_RETURN_IF_ERROR(buffer->Unlock());
+  }
+  resident_ = -1;
+  ++retired_;
+  return {};
+}
+
+Expected<void> Pipeline::Invoke(const Stage& stage) {
+  if (auto status = subgraph_.InvokeExecutionPlanRange(stage.begin, stage.end);
+      status != kTfLiteOk) {
+    if (status == kTfLiteCancelled) {
+      return Unexpected(kLiteRtStatusCancelled, "Execution was cancelled");
+    }
+    return Unexpected(kLiteRtStatusErrorRuntimeFailure, "Failed to invoke");
+  }
+  return {};
+}
+
+Expected<void> Pipeline::RunCpuStage(int index) {
+  SwitchTo(index);
+  LITERT_RETURN_IF_ERROR(Invoke(stages_[inferences_[index].next_stage]));
+  ++inferences_[index].next_stage;
+  return {};
+}
+
+Expected<void> Pipeline::Launch(int index) {
+  SwitchTo(index);
+  Inference& inference = inferences_[index];
+  LITERT_RETURN_IF_ERROR(Invoke(stages_[inference.next_stage]));
+  holders_[inference.next_stage] = index;
+  completion_ = buffer_context_.TakePendingCompletion();
+  if (!completion_) {
+    // The delegate kernel ran synchronously.
+    FinishAcceleratorStage(index);
+    return {};
+  }
+  inference.launched = true;
+  accelerator_owner_ = index;
+  return {};
+}
+
+Expected<void> Pipeline::Complete() {
+  const int index = accelerator_owner_;
+  SwitchTo(index);
+  auto completion = std::exchange(completion_, nullptr);
+  accelerator_owner_ = -1;
+  LITERT_RETURN_IF_ERROR(completion());
+  FinishAcceleratorStage(index);
+  return {};
+}
+
+void Pipeline::FinishAcceleratorStage(int index) {
+  Inference& inference = inferences_[index];
+  const int stage = inference.next_stage;
+  for (int s = 0; s <= stage; ++s) {
+    if (holders_[s] == index && stages_[s].release_after <= stage) {
+      holders_[s] = -1;
+    }
+  }
+  inference.launched = false;
+  ++inference.next_stage;
+}
+
+Expected<void> Pipeline::Run(
+    absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+    size_t max_in_flight) {
+  const int num_inferences = input_buffers.size();
+  max_in_flight_ = std::max<size_t>(max_in_flight, 1);
+  storage_.resize(std::min<size_t>(max_in_flight_, num_inferences) *
+                  storage_size_);
+  inferences_.resize(num_inferences);
+  holders_.assign(num_stages(), -1);
+
+  while (retired_ < num_inferences) {
+    while (admitted_ < num_inferences &&
+           admitted_ - retired_ < max_in_flight_) {
+      LITERT_RETURN_IF_ERROR(Admit(input_buffers));
+    }
+
+    // Keep the accelerator busy: start the oldest accelerator stage that is
+    // ready.
+    if (accelerator_owner_ < 0) {
+      int ready = -1;
+      for (int i = retired_; i < admitted_ && ready < 0; ++i) {
+        const int stage = inferences_[i].next_stage;
+        if (stage < num_stages() && stages_[stage].on_accelerator &&
+            holders_[stage] < 0 && InOrder(i, stage)) {
+          ready = i;
+        }
+      }
+      if (ready >= 0) {
+        LITERT_RETURN_IF_ERROR(Launch(ready));
+        continue;
+      }
+    }
+
+    // Then run CPU work of the oldest inference that has some.
+    bool ran = false;
+    for (int i = retired_; i < admitted_ && !ran; ++i) {
+      const int stage = inferences_[i].next_stage;
+      if (stage == num_stages()) {
+        if (i == retired_) {
+          LITERT_RETURN_IF_ERROR(Retire(output_buffers));
+          ran = true;
+        }
+      } else if (!stages_[stage].on_accelerator && InOrder(i, stage)) {
+        LITERT_RETURN_IF_ERROR(RunCpuStage(i));
+        ran = true;
+      }
+    }
+    if (ran) {
+      continue;
+    }
+
+    // Nothing else to do but waiting for the accelerator.
+    if (accelerator_owner_ < 0) {
+      return Unexpected(kLiteRtStatusErrorRuntimeFailure,
+                        "Pipelined execution stalled");
+    }
+    LITERT_RETURN_IF_ERROR(Complete());
+  }
+  return {};
+}
+
+}  // namespace
+
+Expected<void> RunPipelined(
+    tflite::Subgraph& subgraph,
+    LiteRtExternalLiteRtBufferContextT& buffer_context,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+    size_t max_in_flight) {
+  if (input_buffers.size() != output_buffers.size()) {
+    return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                      "Number of input and output buffer sets mismatch");
+  }
+  for (int i = 0; i < input_buffers.size(); ++i) {
+    if (input_buffers[i].size() != subgraph.inputs().size() ||
+        output_buffers[i].size() != subgraph.outputs().size()) {
+      return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                        "Input or output buffer size mismatch");
+    }
+    for (const auto* buffers : {&input_buffers[i], &output_buffers[i]}) {
+      for (LiteRtTensorBuffer buffer : *buffers) {
+        if (buffer == nullptr) {
+          return Unexpected(kLiteRtStatusErrorInvalidArgument,
+                            "Missing tensor buffer");
+        }
+      }
+    }
+  }
+  if (subgraph.HasDynamicTensors()) {
+    return Unexpected(kLiteRtStatusErrorUnsupported,
+                      "Pipelined execution requires static tensor shapes");
+  }
+
+  Pipeline pipeline(subgraph, buffer_context);
+  LITERT_RETURN_IF_ERROR(pipeline.Plan());
+
+  const bool async_execution_mode = buffer_context.IsAsyncExecutionMode();
+  buffer_context.SetAsyncExecutionMode(true);
+  buffer_context.SetPipelinedExecutionMode(true);
+  absl::Cleanup restore_modes = [&buffer_context, async_execution_mode] {
+    buffer_context.SetPipelinedExecutionMode(false);
+    buffer_context.SetAsyncExecutionMode(async_execution_mode);
+  };
+  return pipeline.Run(input_buffers, output_buffers, max_in_flight);
+}
+
+}  // namespace litert::internal
@@ -0,0 +1,60 @@
+// Copyright 2025 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_RUNTIME_PIPELINED_EXECUTION_H_
+#define ODML_LITERT_LITERT_RUNTIME_PIPELINED_EXECUTION_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "litert/cc/litert_expected.h"
+#include "litert/runtime/external_litert_buffer_context.h"
+#include "tflite/core/subgraph.h"
+
+namespace litert::internal {
+
+// Runs independent inferences of `subgraph` as a software pipeline, so that
+// the CPU ops of some inferences run while an accelerator executes a delegate
+// kernel of another inference. The execution plan is split into stages: every
+// accelerator delegate kernel is a stage of its own, and every run of
+// consecutive CPU ops is a stage. Each stage is run for the inferences in
+// order, and at most one accelerator stage is in flight at any time.
+//
+// Delegate kernels that support it return from Eval() once the accelerator
+// execution has been scheduled and leave a pending completion in
+// `buffer_context` (see LiteRtExternalLiteRtBufferContextT::
+// SetPendingCompletion()). The others complete synchronously, which gives a
+// sequential execution.
+//
+// The inferences share the TFL arena. Tensors that live across stages are
+// saved to per-inference storage when another inference takes over the arena,
+// and restored when it comes back. Up to `max_in_flight` inferences are in
+// flight, i.e. have been started but not finished.
+//
+// `input_buffers[i]` and `output_buffers[i]` hold the tensor buffers of the
+// i-th inference, in subgraph input and output order. Their contents are
+// copied from and to the arena. All ops must have been prepared and the
+// subgraph I/O tensors must be allocated in the arena.
+Expected<void> RunPipelined(
+    tflite::Subgraph& subgraph,
+    LiteRtExternalLiteRtBufferContextT& buffer_context,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> input_buffers,
+    absl::Span<const std::vector<LiteRtTensorBuffer>> output_buffers,
+    size_t max_in_flight);
+
+}  // namespace litert::internal
+
+#endif  // ODML_LITERT_LITERT_RUNTIME_PIPELINED_EXECUTION_H_
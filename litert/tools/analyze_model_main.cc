@@ -14,11 +14,15 @@
 
 // Simple tool to print info about a model's structure and ops.
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"  // from @com_google_absl
 #include "absl/flags/parse.h"  // from @com_google_absl
@@ -29,6 +33,7 @@
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_model.h"
 #include "litert/core/model/model.h"
+#include "litert/tools/cost_model.h"
 #include "litert/tools/dump.h"
 #include "litert/tools/tool_display.h"
 
@@ -38,6 +43,19 @@ ABSL_FLAG(bool, no_ops, false,
           "number of ops).");
 ABSL_FLAG(bool, only_summarize, false,
           "Only include the summary in the output.");
+ABSL_FLAG(bool, cost, false,
+          "Estimate the FLOPs and bytes moved by every op, subgraph and "
+          "partition, and compare them against the machine roofline.");
+ABSL_FLAG(double, peak_gflops, 0,
+          "Peak compute throughput of the roofline in GFLOP/s. Estimated "
+          "with a portable multithreaded GEMM if 0, which underestimates the "
+          "tuned CPU kernels.");
+ABSL_FLAG(double, bandwidth_gbps, 0,
+          "Memory bandwidth of the roofline in GB/s. Measured with a "
+          "microbenchmark if 0.");
+ABSL_FLAG(int, num_hot_spots, 10,
+          "Number of ops with the longest roofline time to list per "
+          "subgraph.");
 
 namespace litert::tools {
 namespace {
@@ -115,15 +133,124 @@ void FormatSummary(std::ostream& out, const ModelAnalyzer::Summary& summary) {
       HumanReadableSize(summary.weights_size), summary.fully_compiled);
 }
 
+// Formats a count with an SI suffix, e.g. 1.5G.
+std::string HumanReadableCount(double count) {
+  static constexpr const char* kSuffixes[] = {"", "k", "M", "G", "T", "P"};
+  size_t i = 0;
+  while (count >= 1000 && i + 1 < std::size(kSuffixes)) {
+    count /= 1000;
+    ++i;
+  }
+  return absl::StrFormat("%.3g%s", count, kSuffixes[i]);
+}
+
+std::string HumanReadableSeconds(double seconds) {
+  if (seconds < 1e-3) {
+    return absl::StrFormat("%.3gus", seconds * 1e6);
+  }
+  if (seconds < 1) {
+    return absl::StrFormat("%.3gms", seconds * 1e3);
+  }
+  return absl::StrFormat("%.3gs", seconds);
+}
+
+std::string FormatCost(const OpCost& cost, const Roofline& roofline) {
+  std::string result = absl::StrFormat(
+      "%sFLOP, %s read, %s written, %.2f FLOP/B, %s-bound, >= %s",
+      HumanReadableCount(cost.flops), HumanReadableSize(cost.bytes_read),
+      HumanReadableSize(cost.bytes_written), cost.ArithmeticIntensity(),
+      roofline.IsMemoryBound(cost) ? "memory" : "compute",
+      HumanReadableSeconds(roofline.Seconds(cost)));
+  if (cost.num_unknown > 0) {
+    absl::StrAppendFormat(&result, " (%lu ops not estimated)",
+                          cost.num_unknown);
+  }
+  return result;
+}
+
+Roofline GetRoofline(ToolDisplay& display) {
+  Roofline roofline;
+  roofline.peak_flops = absl::GetFlag(FLAGS_peak_gflops) * 1e9;
+  roofline.bandwidth = absl::GetFlag(FLAGS_bandwidth_gbps) * 1e9;
+  if (roofline.peak_flops <= 0 || roofline.bandwidth <= 0) {
+    display.Start("Measuring roofline");
+    const Roofline measured = MeasureRoofline();
+    if (roofline.peak_flops <= 0) {
+      roofline.peak_flops = measured.peak_flops;
+      roofline.gemm_threads = measured.gemm_threads;
+    }
+    if (roofline.bandwidth <= 0) {
+      roofline.bandwidth = measured.bandwidth;
+    }
+    display.Done("Measuring roofline");
+  }
+  display.Display() << absl::StreamFormat(
+      "\n    Roofline: %.1f GFLOP/s, %.1f GB/s, ridge point %.2f FLOP/B\n",
+      roofline.peak_flops / 1e9, roofline.bandwidth / 1e9,
+      roofline.RidgePoint());
+  if (roofline.gemm_threads > 0) {
+    display.Display() << absl::StreamFormat(
+        "    Peak measured with a portable GEMM on %d threads, a lower bound "
+        "of the
+    tuned CPU kernels. Pass --peak_gflops to override it.
+",
+        roofline.gemm_threads);
+  }
+  return roofline;
+}
+
+// Prints the cost of every subgraph and of its partitions, and its ops with the
+// longest roofline time.
+void AnalyzeCost(std::ostream& out, const LiteRtModelT& model,
+                 const Roofline& roofline, size_t num_hot_spots) {
+  for (size_t i = 0; i < model.NumSubgraphs(); ++i) {
+    const auto& subgraph = model.Subgraph(i);
+    out << absl::StreamFormat(
+        "\n    Subgraph %lu: %s\n", i,
+        FormatCost(EstimateSubgraphCost(subgraph), roofline));
+
+    const auto partitions = EstimatePartitionCosts(subgraph);
+    if (partitions.size() > 1) {
+      for (const auto& partition : partitions) {
+        out << absl::StreamFormat(
+            "      %s ops [%lu, %lu): %s, %s transferred in\n",
+            partition.is_custom ? "Custom" : "CPU", partition.first_op,
+            partition.first_op + partition.num_ops,
+            FormatCost(partition.cost, roofline),
+            HumanReadableSize(partition.transfer_bytes));
+      }
+    }
+
+    std::vector<std::pair<double, size_t>> op_times;
+    for (size_t j = 0; j < subgraph.Ops().size(); ++j) {
+      const OpCost cost = EstimateOpCost(subgraph.Op(j));
+      if (cost.num_unknown == 0 && cost.Bytes() > 0) {
+        op_times.emplace_back(roofline.Seconds(cost), j);
+      }
+    }
+    const size_t num_listed = std::min(num_hot_spots, op_times.size());
+    std::partial_sort(op_times.begin(), op_times.begin() + num_listed,
+                      op_times.end(), std::greater<>());
+    for (size_t k = 0; k < num_listed; ++k) {
+      const auto& op = subgraph.Op(op_times[k].second);
+      out << absl::StreamFormat("      Op %lu (", op_times[k].second);
+      Dump(op.OpCode(), out);
+      out << absl::StreamFormat("): %s\n",
+                                FormatCost(EstimateOpCost(op), roofline));
+    }
+  }
+  out << "\n";
+}
+
 Expected<void> AnalyzeModel(const std::string& model_path, bool no_ops,
-                            bool only_summarize) {
+                            bool only_summarize, bool cost) {
   ToolDisplay display(std::cerr, "LITERT_MODEL_ANALYZE");
   DumpPreamble(display);
   auto scope = display.StartS("Model analysis");
 
   display.Labeled() << absl::StreamFormat(
-      "no_ops=%d, only_summarize=%d, model_path=\"%s\"\n", no_ops,
-      only_summarize, model_path);
+      "no_ops=%d, only_summarize=%d, cost=%d, model_path=\"%s\"\n", no_ops,
+      only_summarize, cost, model_path);
 
   display.Start("Loading model");
   auto model_obj = Model::CreateFromFile(model_path);
@@ -141,6 +268,15 @@ Expected<void> AnalyzeModel(const std::string& model_path, bool no_ops,
   FormatSummary(display.Display(), summary);
   display.Done("Summarizing model");
 
+  Roofline roofline;
+  if (cost) {
+    display.Start("Estimating cost");
+    roofline = GetRoofline(display);
+    AnalyzeCost(display.Display(), analyzer.Model(), roofline,
+                absl::GetFlag(FLAGS_num_hot_spots));
+    display.Done("Estimating cost");
+  }
+
   if (only_summarize) {
     return {};
   }
@@ -156,6 +292,12 @@ Expected<void> AnalyzeModel(const std::string& model_path, bool no_ops,
     for (auto j = 0; j < analyzer.Model().Subgraph(i).Ops().size(); ++j) {
       display.Display() << "    ";
       analyzer.AnalyzeOp(display.Display(), i, j);
+      if (cost) {
+        display.Display() << absl::StreamFormat(
+            "      cost: %s\n",
+            FormatCost(EstimateOpCost(analyzer.Model().Subgraph(i).Op(j)),
+                       roofline));
+      }
     }
   }
   display.Display() << "\n";
@@ -173,7 +315,8 @@ int main(int argc, char* argv[]) {
   const auto model_path = absl::GetFlag(FLAGS_model_path);
   const auto no_ops = absl::GetFlag(FLAGS_no_ops);
   const auto only_summarize = absl::GetFlag(FLAGS_only_summarize);
+  const auto cost = absl::GetFlag(FLAGS_cost);
 
-  return !litert::tools::AnalyzeModel(model_path, no_ops, only_summarize)
+  return !litert::tools::AnalyzeModel(model_path, no_ops, only_summarize, cost)
               .HasValue();
 }
@@ -30,7 +30,6 @@
 #include "litert/c/internal/litert_logging.h"
 #include "litert/c/litert_common.h"
 #include "litert/c/litert_model.h"
-#include "litert/cc/litert_buffer_ref.h"
 #include "litert/cc/litert_environment.h"
 #include "litert/cc/litert_expected.h"
 #include "litert/cc/litert_macros.h"
@@ -38,18 +37,15 @@
 #include "litert/cc/litert_options.h"
 #include "litert/compiler/plugin/compiler_plugin.h"
 #include "litert/core/model/model_serialize.h"
-#include "litert/core/util/flatbuffer_tools.h"
 #include "litert/tools/dump.h"
 #include "litert/tools/tool_display.h"
 
 namespace litert::tools {
 
-using ::litert::BufferRef;
 using ::litert::internal::CompilerPlugin;
 using ::litert::internal::Dump;
 using ::litert::internal::PartitionResult;
-using ::litert::internal::SerializeModel;
-using ::litert::internal::VerifyFlatbuffer;
+using ::litert::internal::SerializeModelToStream;
 using ::litert::tools::ApplyPluginRun;
 
 #define LITERT_ENSURE_CONFIG(expr)              \
@@ -137,9 +133,9 @@ void DumpCompilationResult(ToolDisplay& display, size_t byte_code_size,
       byte_code_size);
 }
 
-void DumpModelStats(ToolDisplay& display, BufferRef<uint8_t> buf) {
+void DumpModelStats(ToolDisplay& display, size_t size) {
   display.Labeled() << absl::StreamFormat(
-      "Serialized a model of size %lu bytes\n", buf.Size());
+      "Serialized a model of size %lu bytes\n", size);
 }
 
 void DumpPartitionResult(ToolDisplay& display, const PartitionResult& result) {
@@ -282,15 +278,11 @@ LiteRtStatus Noop(Context& ctx) {
     return model.Error().Status();
   }
 
-  auto serialized = SerializeModel(std::move(*model->Get()));
-  if (!serialized) {
-    return serialized.Error().Status();
+  auto serialized_size =
+      SerializeModelToStream(std::move(*model->Get()), ctx.Out());
+  if (!serialized_size) {
+    return serialized_size.Error().Status();
   }
-  LITERT_RETURN_IF_ERROR(
-      VerifyFlatbuffer(serialized->Span()),
-      ErrorStatusBuilder(kLiteRtStatusErrorInvalidFlatbuffer))
-      << "Failed to invalidate flatbuffer";
-  serialized->WriteStr(ctx.Out());
   return kLiteRtStatusOk;
 }
 
@@ -335,20 +327,13 @@ LiteRtStatus Partition(Context& ctx) {
   }
   model.TransferSubgraphsFrom(std::move(alloc));
 
-  ctx.Dump().Start("Serializing model");
-  auto serialized = SerializeModel(std::move(model));
-  DumpModelStats(ctx.Dump(), *serialized);
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Verifying flatbuffer");
-  LITERT_RETURN_IF_ERROR(
-      VerifyFlatbuffer(serialized->Span()),
-      ErrorStatusBuilder(kLiteRtStatusErrorInvalidFlatbuffer))
-      << "Failed to invalidate flatbuffer";
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Writing to out");
-  serialized->WriteStr(ctx.Out());
+  // The serialized model is verified and streamed to out piece by piece.
+  ctx.Dump().Start("Serializing model to out");
+  auto serialized_size = SerializeModelToStream(std::move(model), ctx.Out());
+  if (!serialized_size) {
+    return serialized_size.Error().Status();
+  }
+  DumpModelStats(ctx.Dump(), *serialized_size);
   ctx.Dump().Done();
 
   return kLiteRtStatusOk;
@@ -454,20 +439,13 @@ LiteRtStatus Apply(Context& ctx) {
   }
   ctx.Dump().Done();
 
-  ctx.Dump().Start("Serializing model");
-  auto serialized = SerializeModel(std::move(model));
-  DumpModelStats(ctx.Dump(), *serialized);
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Verifying flatbuffer");
-  LITERT_RETURN_IF_ERROR(
-      VerifyFlatbuffer(serialized->Span()),
-      ErrorStatusBuilder(kLiteRtStatusErrorInvalidFlatbuffer))
-      << "Failed to invalidate flatbuffer";
-  ctx.Dump().Done();
-
-  ctx.Dump().Start("Writing to out");
-  serialized->WriteStr(ctx.Out());
+  // The serialized model is verified and streamed to out piece by piece.
+  ctx.Dump().Start("Serializing model to out");
+  auto serialized_size = SerializeModelToStream(std::move(model), ctx.Out());
+  if (!serialized_size) {
+    return serialized_size.Error().Status();
+  }
+  DumpModelStats(ctx.Dump(), *serialized_size);
   ctx.Dump().Done();
 
   return kLiteRtStatusOk;
@@ -147,7 +147,10 @@ Options CreateCompiledModelOptions(const BenchmarkParams& params) {
 
   compilation_options.SetHardwareAccelerators(hardware_accelerators);
 
-  if (use_profiler) {
+  // Delegates only report their ops, which the partition report needs to
+  // measure the hand-off overhead, if profiling is enabled when they are
+  // applied.
+  if (use_profiler || params.Get<bool>("report_delegate_partitions")) {
     LITERT_ASSIGN_OR_ABORT(auto& runtime_options,
                            compilation_options.GetRuntimeOptions());
     runtime_options.SetEnableProfiling(/*enabled=*/true);
@@ -236,6 +239,12 @@ TfLiteStatus BenchmarkLiteRtModel::Init() {
     AddListener(model_runtime_info_listener_.get());
   }
 
+  if (params_.Get<bool>("report_delegate_partitions")) {
+    delegate_partition_report_listener_ =
+        std::make_unique<DelegatePartitionReportListener>(interpreter_);
+    AddListener(delegate_partition_report_listener_.get());
+  }
+
   auto use_profiler = params_.Get<bool>("use_profiler");
   if (use_profiler) {
     LITERT_ASSIGN_OR_ABORT(profiler_, compiled_model_->GetProfiler());
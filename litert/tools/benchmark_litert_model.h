@@ -41,8 +41,10 @@ limitations under the License.
 #include "tflite/c/c_api_types.h"
 #include "tflite/c/common.h"
 #include "tflite/interpreter.h"
+#include "tflite/profiling/delegate_partition_profiler.h"
 #include "tflite/profiling/model_runtime_info.h"
 #include "tflite/profiling/profile_buffer.h"
+#include "tflite/profiling/proto/model_runtime_info.pb.h"
 #include "tflite/tools/benchmark/benchmark_model.h"
 #include "tflite/tools/benchmark/benchmark_params.h"
 #include "tflite/tools/benchmark/proto/benchmark_result.pb.h"
@@ -209,6 +211,59 @@ class ModelRuntimeInfoListener : public ::tflite::benchmark::BenchmarkListener {
  private:
   ::tflite::Interpreter* interpreter_ = nullptr;
 };
+
+// Logs the delegate partitions of the graph, the tensors crossing their
+// boundaries and the time spent handing them over, when
+// report_delegate_partitions is set to true.
+class DelegatePartitionReportListener
+    : public ::tflite::benchmark::BenchmarkListener {
+ public:
+  // The interpreter is only available once the model is compiled, so the
+  // delegates only report their ops to the profiler if profiling was enabled
+  // in the compilation options.
+  explicit DelegatePartitionReportListener(
+      ::tflite::Interpreter* interpreter_ptr)
+      : interpreter_(interpreter_ptr) {
+    auto profiler =
+        std::make_unique<tflite::profiling::DelegatePartitionProfiler>(
+            *interpreter_);
+    profiler_ = profiler.get();
+    interpreter_->AddProfiler(std::move(profiler));
+  }
+
+  void OnSingleRunStart(::tflite::benchmark::RunType run_type) override {
+    if (run_type == ::tflite::benchmark::REGULAR) {
+      profiler_->StartProfiling();
+    }
+  }
+
+  void OnSingleRunEnd() override { profiler_->StopProfiling(); }
+
+  void OnBenchmarkEnd(
+      const ::tflite::benchmark::BenchmarkResults& results) override {
+    tflite::profiling::ModelRuntimeDetails model_runtime_details;
+    if (tflite::profiling::GenerateModelRuntimeInfo(
+            *interpreter_, model_runtime_details) != kTfLiteOk) {
+      LITERT_LOG(LITERT_ERROR,
+                 "Failed to generate the delegate partition report.");
+      return;
+    }
+    profiler_->AddTimings(model_runtime_details);
+    const std::string report =
+        tflite::profiling::DelegatePartitionReport(model_runtime_details);
+    if (report.empty()) {
+      LITERT_LOG(LITERT_INFO, "No delegate partitions.");
+    } else {
+      LITERT_LOG(LITERT_INFO, "Delegate partitions:\n%s", report.c_str());
+    }
+  }
+
+ private:
+  ::tflite::Interpreter* interpreter_ = nullptr;
+  // Owned by the interpreter.
+  tflite::profiling::DelegatePartitionProfiler* profiler_ = nullptr;
+};
+
 using ::litert::CompiledModel;
 using ::litert::Environment;
 using ::litert::Model;
@@ -256,6 +311,8 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
                             BenchmarkParam::Create<std::string>(""));
     default_params.AddParam("model_runtime_info_output_file",
                             BenchmarkParam::Create<std::string>(""));
+    default_params.AddParam("report_delegate_partitions",
+                            BenchmarkParam::Create<bool>(false));
     default_params.AddParam("mediatek_nerun_pilot_version",
                             BenchmarkParam::Create<std::string>("version8"));
     return default_params;
@@ -401,6 +458,10 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
     flags.push_back(tflite::benchmark::CreateFlag<std::string>(
         "model_runtime_info_output_file", &params_,
         "Path to save the model runtime info in binary proto format."));
+    flags.push_back(tflite::benchmark::CreateFlag<bool>(
+        "report_delegate_partitions", &params_,
+        "Whether to report the delegate partitions, the tensors crossing "
+        "their boundaries and the measured hand-off overhead."));
     flags.push_back(tflite::benchmark::CreateFlag<std::string>(
         "mediatek_nerun_pilot_version", &params_,
         "Which version of the MediaTek NPU SDK to use."));
@@ -419,6 +480,8 @@ class BenchmarkLiteRtModel : public BenchmarkModel {
   litert::Profiler profiler_;
   std::unique_ptr<BenchmarkLoggingListener> log_output_;
   std::unique_ptr<ModelRuntimeInfoListener> model_runtime_info_listener_;
+  std::unique_ptr<DelegatePartitionReportListener>
+      delegate_partition_report_listener_;
 
   // TFLite Interpreter is needed for run_summarizer_
   ::tflite::Interpreter* interpreter_ = nullptr;
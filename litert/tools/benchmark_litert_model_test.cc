@@ -168,6 +168,19 @@ TEST(BenchmarkLiteRtModelTest, BenchmarkWithModelRuntimeInfoFilePath) {
   EXPECT_GT(model_runtime_details.subgraphs(0).edges_size(), 0);
 }
 
+TEST(BenchmarkLiteRtModelTest, BenchmarkWithDelegatePartitionReport) {
+  BenchmarkParams params = BenchmarkLiteRtModel::DefaultParams();
+  params.Set<std::string>("graph", kModelPath);
+  params.Set<std::string>("signature_to_run_for", kSignatureToRunFor);
+  params.Set<bool>("use_cpu", true);
+  params.Set<bool>("use_gpu", false);
+  params.Set<bool>("require_full_delegation", false);
+  params.Set<bool>("report_delegate_partitions", true);
+
+  BenchmarkLiteRtModel benchmark = BenchmarkLiteRtModel(std::move(params));
+  EXPECT_EQ(benchmark.Run(), kTfLiteOk);
+}
+
 }  // namespace
 }  // namespace benchmark
 }  // namespace litert
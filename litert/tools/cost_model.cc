@@ -0,0 +1,474 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/cost_model.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"  // from @com_google_absl
+#include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/core/model/model.h"
+#include "litert/core/util/flatbuffer_tools.h"
+#include "litert/core/util/tensor_type_util.h"
+
+namespace litert::tools {
+namespace {
+
+using Dims = absl::Span<const int32_t>;
+
+// Returns the dimensions of `tensor`, or nullopt if they aren't static.
+std::optional<Dims> StaticDims(const LiteRtTensorT* tensor) {
+  if (tensor == nullptr ||
+      tensor->Type().first != kLiteRtRankedTensorType) {
+    return std::nullopt;
+  }
+  const auto& layout = tensor->Type().second.ranked_tensor_type.layout;
+  Dims dims = absl::MakeConstSpan(layout.dimensions, layout.rank);
+  if (std::any_of(dims.begin(), dims.end(), [](int32_t d) { return d < 0; })) {
+    return std::nullopt;
+  }
+  return dims;
+}
+
+double NumElements(Dims dims) {
+  double num_elements = 1;
+  for (int32_t dim : dims) {
+    num_elements *= dim;
+  }
+  return num_elements;
+}
+
+// Returns the bytes of `tensor`, including its per-channel scales, or nullopt
+// if its shape isn't static.
+std::optional<uint64_t> TensorBytes(const LiteRtTensorT* tensor) {
+  auto dims = StaticDims(tensor);
+  if (!dims) {
+    return std::nullopt;
+  }
+  auto element_size = internal::GetElementSize(
+      tensor->Type().second.ranked_tensor_type.element_type);
+  if (!element_size) {
+    return std::nullopt;
+  }
+  const uint64_t num_elements = static_cast<uint64_t>(NumElements(*dims));
+  uint64_t bytes =
+      (num_elements * element_size->num + element_size->denom - 1) /
+      element_size->denom;
+  if (tensor->Qparams().first == kLiteRtQuantizationPerChannel) {
+    bytes += tensor->Qparams().second.per_channel.num_channels * sizeof(float);
+  }
+  return bytes;
+}
+
+// Returns dimension `i` of `dims`, counting from the end if negative, or 0 if
+// out of range.
+int32_t Dim(Dims dims, int i) {
+  if (i < 0) {
+    i += dims.size();
+  }
+  return i >= 0 && static_cast<size_t>(i) < dims.size() ? dims[i] : 0;
+}
+
+// Ops that only change the metadata of their input.
+bool IsFree(LiteRtOpCode code) {
+  switch (code) {
+    case kLiteRtOpCodeTflReshape:
+    case kLiteRtOpCodeTflSqueeze:
+    case kLiteRtOpCodeTflExpandDims:
+    case kLiteRtOpCodeTflBitcast:
+    case kLiteRtOpCodeTflShape:
+    case kLiteRtOpCodeTflRank:
+    case kLiteRtOpCodeShloReshape:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Ops that move or select data without arithmetic.
+bool IsDataMovement(LiteRtOpCode code) {
+  switch (code) {
+    case kLiteRtOpCodeTflConcatenation:
+    case kLiteRtOpCodeTflDepthToSpace:
+    case kLiteRtOpCodeTflSpaceToDepth:
+    case kLiteRtOpCodeTflEmbeddingLookup:
+    case kLiteRtOpCodeTflPad:
+    case kLiteRtOpCodeTflPadv2:
+    case kLiteRtOpCodeTflMirrorPad:
+    case kLiteRtOpCodeTflGather:
+    case kLiteRtOpCodeTflGatherNd:
+    case kLiteRtOpCodeTflBatchToSpaceNd:
+    case kLiteRtOpCodeTflSpaceToBatchNd:
+    case kLiteRtOpCodeTflTranspose:
+    case kLiteRtOpCodeTflStridedSlice:
+    case kLiteRtOpCodeTflSlice:
+    case kLiteRtOpCodeTflSplit:
+    case kLiteRtOpCodeTflSplitV:
+    case kLiteRtOpCodeTflTile:
+    case kLiteRtOpCodeTflPack:
+    case kLiteRtOpCodeTflUnpack:
+    case kLiteRtOpCodeTflReverseV2:
+    case kLiteRtOpCodeTflBroadcastTo:
+    case kLiteRtOpCodeTflDynamicUpdateSlice:
+    case kLiteRtOpCodeTflScatterNd:
+    case kLiteRtOpCodeTflFill:
+    case kLiteRtOpCodeTflZerosLike:
+    case kLiteRtOpCodeShloConcatenate:
+    case kLiteRtOpCodeShloBroadcastInDim:
+    case kLiteRtOpCodeShloSlice:
+    case kLiteRtOpCodeShloDynamicSlice:
+    case kLiteRtOpCodeShloDynamicUpdateSlice:
+    case kLiteRtOpCodeShloPad:
+    case kLiteRtOpCodeShloGather:
+    case kLiteRtOpCodeShloScatter:
+    case kLiteRtOpCodeShloTranspose:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// FLOPs per output element of elementwise ops whose kernels evaluate a
+// transcendental function, which costs several arithmetic operations.
+constexpr double kTranscendentalFlops = 8;
+
+// Ops that evaluate a transcendental function for every element.
+bool IsTranscendental(LiteRtOpCode code) {
+  switch (code) {
+    case kLiteRtOpCodeTflLogistic:
+    case kLiteRtOpCodeTflTanh:
+    case kLiteRtOpCodeTflExp:
+    case kLiteRtOpCodeTflLog:
+    case kLiteRtOpCodeTflSin:
+    case kLiteRtOpCodeTflCos:
+    case kLiteRtOpCodeTflSqrt:
+    case kLiteRtOpCodeTflRsqrt:
+    case kLiteRtOpCodeTflPow:
+    case kLiteRtOpCodeTflElu:
+    case kLiteRtOpCodeTflGelu:
+    case kLiteRtOpCodeTflAtan2:
+    case kLiteRtOpCodeShloLogistic:
+    case kLiteRtOpCodeShloTanh:
+    case kLiteRtOpCodeShloExponential:
+    case kLiteRtOpCodeShloLog:
+    case kLiteRtOpCodeShloCosine:
+    case kLiteRtOpCodeShloRsqrt:
+    case kLiteRtOpCodeShloPower:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Ops whose FLOPs are proportional to the size of their first input rather
+// than of their output.
+bool IsReduction(LiteRtOpCode code) {
+  switch (code) {
+    case kLiteRtOpCodeTflMean:
+    case kLiteRtOpCodeTflSum:
+    case kLiteRtOpCodeTflReduceProd:
+    case kLiteRtOpCodeTflReduceMax:
+    case kLiteRtOpCodeTflReduceMin:
+    case kLiteRtOpCodeTflReduceAny:
+    case kLiteRtOpCodeTflReduceAll:
+    case kLiteRtOpCodeTflArgMax:
+    case kLiteRtOpCodeTflArgMin:
+    case kLiteRtOpCodeTflCumsum:
+    case kLiteRtOpCodeTflL2Normalization:
+    case kLiteRtOpCodeTflTopkV2:
+    case kLiteRtOpCodeShloReduce:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Ops whose cost depends on more than their shapes.
+bool IsOpaque(LiteRtOpCode code) {
+  switch (code) {
+    case kLiteRtOpCodeTflCustom:
+    case kLiteRtOpCodeTflDelegate:
+    case kLiteRtOpCodeTflCall:
+    case kLiteRtOpCodeTflIf:
+    case kLiteRtOpCodeTflWhile:
+    case kLiteRtOpCodeTflCallOnce:
+    case kLiteRtOpCodeShloCustomCall:
+    case kLiteRtOpCodeShloWhile:
+    case kLiteRtOpCodeShloComposite:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the FLOPs of `op`, or nullopt if they can't be estimated.
+std::optional<double> EstimateFlops(const LiteRtOpT& op) {
+  const LiteRtOpCode code = op.OpCode();
+  if (IsFree(code) || IsDataMovement(code)) {
+    return 0;
+  }
+  if (IsOpaque(code) || op.NumOutputs() == 0) {
+    return std::nullopt;
+  }
+  auto input = [&](size_t i) {
+    return i < op.NumInputs() ? StaticDims(op.Inputs()[i]) : std::nullopt;
+  };
+  auto output = StaticDims(op.Outputs()[0]);
+  if (!output) {
+    return std::nullopt;
+  }
+  const double output_elements = NumElements(*output);
+
+  switch (code) {
+    case kLiteRtOpCodeTflFullyConnected: {
+      // Weights are [units, depth].
+      auto weights = input(1);
+      if (!weights) return std::nullopt;
+      return 2 * output_elements * Dim(*weights, -1);
+    }
+    case kLiteRtOpCodeTflConv2d: {
+      // Filter is [out_channels, height, width, in_channels].
+      auto filter = input(1);
+      if (!filter || filter->size() != 4) return std::nullopt;
+      return 2 * output_elements * NumElements(filter->subspan(1));
+    }
+    case kLiteRtOpCodeTflDepthwiseConv2d: {
+      // Filter is [1, height, width, out_channels].
+      auto filter = input(1);
+      if (!filter || filter->size() != 4) return std::nullopt;
+      return 2 * output_elements * Dim(*filter, 1) * Dim(*filter, 2);
+    }
+    case kLiteRtOpCodeTflConv3d: {
+      // Filter is [depth, height, width, in_channels, out_channels].
+      auto filter = input(1);
+      if (!filter || filter->size() != 5) return std::nullopt;
+      return 2 * output_elements * NumElements(filter->subspan(0, 4));
+    }
+    case kLiteRtOpCodeTflTransposeConv: {
+      // Inputs are the output shape, the [out_channels, height, width,
+      // in_channels] filter and the input. Every input element is scattered
+      // over a filter window of every output channel.
+      auto filter = input(1);
+      auto data = input(2);
+      if (!filter || !data || filter->size() != 4) return std::nullopt;
+      return 2 * NumElements(*data) * NumElements(filter->subspan(0, 3));
+    }
+    case kLiteRtOpCodeTflConv3dTranspose: {
+      // Inputs are the output shape, the [depth, height, width, out_channels,
+      // in_channels] filter and the input.
+      auto filter = input(1);
+      auto data = input(2);
+      if (!filter || !data || filter->size() != 5) return std::nullopt;
+      return 2 * NumElements(*data) * NumElements(filter->subspan(0, 4));
+    }
+    case kLiteRtOpCodeTflBatchMatmul: {
+      // The reduced dimension is whichever of the last two dimensions of the
+      // LHS isn't a dimension of the output.
+      auto lhs = input(0);
+      const int32_t rows = Dim(*output, -2);
+      if (!lhs || rows == 0) return std::nullopt;
+      return 2 * output_elements *
+             (static_cast<double>(Dim(*lhs, -1)) * Dim(*lhs, -2) / rows);
+    }
+    case kLiteRtOpCodeTflAveragePool2d:
+    case kLiteRtOpCodeTflMaxPool2d:
+    case kLiteRtOpCodeTflL2Pool2d: {
+      const auto* options = internal::GetTflOptions(op).AsPool2DOptions();
+      if (options == nullptr) return std::nullopt;
+      return output_elements * options->filter_width * options->filter_height;
+    }
+    case kLiteRtOpCodeTflSoftmax:
+    case kLiteRtOpCodeTflLogSoftmax:
+      // Max, subtraction, exponential, sum and division of every element.
+      return output_elements * (kTranscendentalFlops + 4);
+    default:
+      break;
+  }
+
+  if (IsReduction(code)) {
+    auto data = input(0);
+    if (!data) return std::nullopt;
+    return NumElements(*data);
+  }
+  if (IsTranscendental(code)) {
+    return output_elements * kTranscendentalFlops;
+  }
+  // Everything else is modeled as one operation per output element.
+  return output_elements;
+}
+
+}  // namespace
+
+double OpCost::ArithmeticIntensity() const {
+  return Bytes() == 0 ? 0 : flops / Bytes();
+}
+
+OpCost& OpCost::operator+=(const OpCost& other) {
+  flops += other.flops;
+  bytes_read += other.bytes_read;
+  bytes_written += other.bytes_written;
+  num_unknown += other.num_unknown;
+  return *this;
+}
+
+OpCost EstimateOpCost(const LiteRtOpT& op) {
+  OpCost cost;
+  if (IsFree(op.OpCode())) {
+    return cost;
+  }
+  bool known = true;
+  for (const auto* tensor : op.Inputs()) {
+    if (tensor == nullptr) {
+      // Omitted optional input.
+      continue;
+    }
+    auto bytes = TensorBytes(tensor);
+    known &= bytes.has_value();
+    cost.bytes_read += bytes.value_or(0);
+  }
+  for (const auto* tensor : op.Outputs()) {
+    auto bytes = TensorBytes(tensor);
+    known &= bytes.has_value();
+    cost.bytes_written += bytes.value_or(0);
+  }
+  auto flops = EstimateFlops(op);
+  cost.flops = flops.value_or(0);
+  if (!known || !flops) {
+    cost.num_unknown = 1;
+  }
+  return cost;
+}
+
+OpCost EstimateSubgraphCost(const LiteRtSubgraphT& subgraph) {
+  OpCost cost;
+  for (const auto* op : subgraph.Ops()) {
+    cost += EstimateOpCost(*op);
+  }
+  return cost;
+}
+
+std::vector<PartitionCost> EstimatePartitionCosts(
+    const LiteRtSubgraphT& subgraph) {
+  std::vector<PartitionCost> partitions;
+  // The ops of the current partition.
+  absl::flat_hash_set<const LiteRtOpT*> members;
+  const auto ops = subgraph.Ops();
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const bool is_custom = ops[i]->OpCode() == kLiteRtOpCodeTflCustom;
+    if (partitions.empty() || is_custom || partitions.back().is_custom) {
+      partitions.push_back({i, 0, is_custom});
+      members.clear();
+    }
+    PartitionCost& partition = partitions.back();
+    ++partition.num_ops;
+    partition.cost += EstimateOpCost(*ops[i]);
+    for (const auto* tensor : ops[i]->Inputs()) {
+      if (tensor == nullptr || tensor->DefiningOp() == nullptr ||
+          members.contains(tensor->DefiningOp())) {
+        continue;
+      }
+      partition.transfer_bytes += TensorBytes(tensor).value_or(0);
+    }
+    members.insert(ops[i]);
+  }
+  return partitions;
+}
+
+double Roofline::Seconds(const OpCost& cost) const {
+  return std::max(cost.flops / peak_flops, cost.Bytes() / bandwidth);
+}
+
+namespace {
+
+// Returns the best time of `num_runs` runs of `f`, in seconds.
+template <class F>
+double BestSeconds(int num_runs, F&& f) {
+  double best = 0;
+  for (int i = 0; i < num_runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best) {
+      best = elapsed.count();
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+Roofline MeasureRoofline(const RooflineBenchmarkOptions& options) {
+  Roofline roofline;
+
+  // C += A * B, with an inner loop over contiguous rows of B and C that the
+  // compiler vectorizes. Every thread computes a block of rows of C.
+  const size_t n = options.gemm_size;
+  std::vector<float> a(n * n, 1.0f);
+  std::vector<float> b(n * n, 0.5f);
+  std::vector<float> c(n * n, 0.0f);
+  const size_t num_threads = std::clamp<size_t>(
+      options.num_threads > 0 ? options.num_threads
+                              : std::thread::hardware_concurrency(),
+      1, n);
+  auto gemm_rows = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      float* c_row = &c[i * n];
+      for (size_t k = 0; k < n; ++k) {
+        const float a_ik = a[i * n + k];
+        const float* b_row = &b[k * n];
+        for (size_t j = 0; j < n; ++j) {
+          c_row[j] += a_ik * b_row[j];
+        }
+      }
+    }
+  };
+  const double gemm_seconds = BestSeconds(options.num_runs, [&] {
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < num_threads; ++t) {
+      threads.emplace_back(gemm_rows, n * t / num_threads,
+                           n * (t + 1) / num_threads);
+    }
+    gemm_rows(0, n / num_threads);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  });
+  // Keeps the result observable.
+  volatile float sink = c[n * n / 2];
+  (void)sink;
+  roofline.peak_flops = 2.0 * n * n * n / gemm_seconds;
+  roofline.gemm_threads = num_threads;
+
+  std::vector<uint8_t> src(options.copy_bytes, 1);
+  std::vector<uint8_t> dst(options.copy_bytes, 0);
+  const double copy_seconds = BestSeconds(options.num_runs, [&] {
+    std::memcpy(dst.data(), src.data(), src.size());
+  });
+  sink = dst[dst.size() / 2];
+  // A copy reads and writes every byte.
+  roofline.bandwidth = 2.0 * options.copy_bytes / copy_seconds;
+  return roofline;
+}
+
+}  // namespace litert::tools
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ODML_LITERT_LITERT_TOOLS_COST_MODEL_H_
+#define ODML_LITERT_LITERT_TOOLS_COST_MODEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "litert/core/model/model.h"
+
+namespace litert::tools {
+
+// Static estimate of the work of an op, or of a group of ops, from the shapes
+// and types of the tensors.
+struct OpCost {
+  // Arithmetic operations, counting a multiply-accumulate as two.
+  double flops = 0;
+  // Bytes of the inputs, including the weights and their quantization
+  // parameters.
+  uint64_t bytes_read = 0;
+  // Bytes of the outputs.
+  uint64_t bytes_written = 0;
+  // Number of ops whose cost couldn't be estimated, because of dynamic shapes
+  // or opaque ops such as custom ops.
+  size_t num_unknown = 0;
+
+  uint64_t Bytes() const { return bytes_read + bytes_written; }
+
+  // FLOPs per byte moved, 0 if no byte is moved.
+  double ArithmeticIntensity() const;
+
+  OpCost& operator+=(const OpCost& other);
+};
+
+// Estimates the cost of `op`. Data movement ops, like transposes, only move
+// bytes; ops that only change the tensor metadata, like reshapes, are free.
+OpCost EstimateOpCost(const LiteRtOpT& op);
+
+// Sum of the costs of the ops of `subgraph`.
+OpCost EstimateSubgraphCost(const LiteRtSubgraphT& subgraph);
+
+// A run of consecutive ops of a subgraph that executes on the same side: either
+// a custom op, which is how compiled partitions are dispatched to accelerators,
+// or the CPU ops between custom ops.
+struct PartitionCost {
+  // Range of the ops of the partition in the subgraph.
+  size_t first_op = 0;
+  size_t num_ops = 0;
+  bool is_custom = false;
+  OpCost cost;
+  // Bytes of the activations that enter the partition from another partition
+  // and so have to cross between the CPU and an accelerator.
+  uint64_t transfer_bytes = 0;
+};
+
+// Splits `subgraph` into partitions, in execution order.
+std::vector<PartitionCost> EstimatePartitionCosts(
+    const LiteRtSubgraphT& subgraph);
+
+// Peak compute throughput and memory bandwidth of a machine.
+struct Roofline {
+  // FLOP/s.
+  double peak_flops = 0;
+  // Bytes/s.
+  double bandwidth = 0;
+  // Threads that ran the GEMM of MeasureRoofline(), 0 if the peak wasn't
+  // measured.
+  int gemm_threads = 0;
+
+  // Arithmetic intensity above which work is compute-bound.
+  double RidgePoint() const { return peak_flops / bandwidth; }
+
+  // Whether the time of `cost` is bounded by the memory bandwidth.
+  bool IsMemoryBound(const OpCost& cost) const {
+    return cost.ArithmeticIntensity() < RidgePoint();
+  }
+
+  // Lower bound of the time of `cost` on the machine, in seconds.
+  double Seconds(const OpCost& cost) const;
+};
+
+// Sizes of the microbenchmarks of MeasureRoofline().
+struct RooflineBenchmarkOptions {
+  // The GEMM is of square matrices of this size.
+  size_t gemm_size = 512;
+  // Threads that split the rows of the GEMM, 0 for every hardware thread.
+  int num_threads = 0;
+  // Bytes of the buffer copied for the bandwidth.
+  size_t copy_bytes = 64 << 20;
+  // Every benchmark keeps the best of this many runs.
+  int num_runs = 5;
+};
+
+// Measures the roofline of the CPU with a float GEMM on `num_threads` threads
+// and a large copy. The GEMM is portable C++ rather than the tuned ruy or
+// XNNPACK kernels, so the peak is a lower bound of what the CPU kernels
+// achieve, often by several times.
+Roofline MeasureRoofline(const RooflineBenchmarkOptions& options = {});
+
+}  // namespace litert::tools
+
+#endif  // ODML_LITERT_LITERT_TOOLS_COST_MODEL_H_
@@ -0,0 +1,185 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "litert/tools/cost_model.h"
+
+#include <cstdint>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+#include "litert/c/litert_model_types.h"
+#include "litert/c/litert_op_code.h"
+#include "litert/core/model/model.h"
+
+namespace litert::tools {
+namespace {
+
+using ::litert::internal::AttachInput;
+using ::litert::internal::AttachOutput;
+
+LiteRtTensorT& AddTensor(LiteRtSubgraphT& subgraph,
+                         LiteRtElementType element_type,
+                         std::initializer_list<int32_t> dims) {
+  auto& tensor = subgraph.EmplaceTensor();
+  tensor.SetType(MakeRankedTensorType(element_type, dims));
+  return tensor;
+}
+
+LiteRtOpT& AddOp(LiteRtSubgraphT& subgraph, LiteRtOpCode code,
+                 std::initializer_list<LiteRtTensorT*> inputs,
+                 LiteRtTensorT& output) {
+  auto& op = subgraph.EmplaceOp();
+  op.SetOpCode(code);
+  for (auto* input : inputs) {
+    AttachInput(input, op);
+  }
+  AttachOutput(&output, op);
+  return op;
+}
+
+TEST(CostModelTest, FullyConnected) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {2, 64});
+  auto& weights = AddTensor(subgraph, kLiteRtElementTypeInt8, {16, 64});
+  weights.Qparams().first = kLiteRtQuantizationPerChannel;
+  weights.Qparams().second.per_channel.num_channels = 16;
+  auto& output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {2, 16});
+  auto& op = AddOp(subgraph, kLiteRtOpCodeTflFullyConnected,
+                   {&input, &weights}, output);
+
+  const OpCost cost = EstimateOpCost(op);
+  EXPECT_EQ(cost.flops, 2 * 2 * 16 * 64);
+  EXPECT_EQ(cost.bytes_read, 2 * 64 * 4 + 16 * 64 + 16 * 4);
+  EXPECT_EQ(cost.bytes_written, 2 * 16 * 4);
+  EXPECT_EQ(cost.num_unknown, 0);
+  EXPECT_DOUBLE_EQ(cost.ArithmeticIntensity(),
+                   cost.flops / (cost.bytes_read + cost.bytes_written));
+}
+
+TEST(CostModelTest, SubByteWeights) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {1, 64});
+  auto& weights = AddTensor(subgraph, kLiteRtElementTypeInt4, {16, 64});
+  auto& output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {1, 16});
+  auto& op = AddOp(subgraph, kLiteRtOpCodeTflFullyConnected,
+                   {&input, &weights}, output);
+
+  EXPECT_EQ(EstimateOpCost(op).bytes_read, 64 * 4 + 16 * 64 / 2);
+}
+
+TEST(CostModelTest, Conv2d) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {1, 8, 8, 3});
+  auto& filter = AddTensor(subgraph, kLiteRtElementTypeFloat32, {4, 3, 3, 3});
+  auto& output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {1, 8, 8, 4});
+  auto& op =
+      AddOp(subgraph, kLiteRtOpCodeTflConv2d, {&input, &filter}, output);
+
+  EXPECT_EQ(EstimateOpCost(op).flops, 2.0 * (8 * 8 * 4) * (3 * 3 * 3));
+}
+
+TEST(CostModelTest, BatchMatmulWithAdjointLhs) {
+  LiteRtSubgraphT subgraph;
+  // [K, M] x [K, N] with adj_x.
+  auto& lhs = AddTensor(subgraph, kLiteRtElementTypeFloat32, {3, 32, 8});
+  auto& rhs = AddTensor(subgraph, kLiteRtElementTypeFloat32, {3, 32, 4});
+  auto& output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {3, 8, 4});
+  auto& op =
+      AddOp(subgraph, kLiteRtOpCodeTflBatchMatmul, {&lhs, &rhs}, output);
+
+  EXPECT_EQ(EstimateOpCost(op).flops, 2.0 * 3 * 8 * 4 * 32);
+}
+
+TEST(CostModelTest, ReshapeIsFree) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {4, 4});
+  auto& output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {16});
+  auto& op = AddOp(subgraph, kLiteRtOpCodeTflReshape, {&input}, output);
+
+  const OpCost cost = EstimateOpCost(op);
+  EXPECT_EQ(cost.flops, 0);
+  EXPECT_EQ(cost.Bytes(), 0);
+  EXPECT_EQ(cost.num_unknown, 0);
+}
+
+TEST(CostModelTest, DynamicShapesAndCustomOpsAreUnknown) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {-1, 4});
+  auto& relu_output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {-1, 4});
+  auto& custom_output = AddTensor(subgraph, kLiteRtElementTypeFloat32, {4});
+  AddOp(subgraph, kLiteRtOpCodeTflRelu, {&input}, relu_output);
+  AddOp(subgraph, kLiteRtOpCodeTflCustom, {&relu_output}, custom_output);
+
+  const OpCost cost = EstimateSubgraphCost(subgraph);
+  EXPECT_EQ(cost.num_unknown, 2);
+  EXPECT_EQ(cost.bytes_written, 4 * 4);
+}
+
+TEST(CostModelTest, PartitionsSplitAtCustomOps) {
+  LiteRtSubgraphT subgraph;
+  auto& input = AddTensor(subgraph, kLiteRtElementTypeFloat32, {64});
+  auto& t0 = AddTensor(subgraph, kLiteRtElementTypeFloat32, {64});
+  auto& t1 = AddTensor(subgraph, kLiteRtElementTypeFloat32, {64});
+  auto& t2 = AddTensor(subgraph, kLiteRtElementTypeFloat32, {32});
+  auto& t3 = AddTensor(subgraph, kLiteRtElementTypeFloat32, {32});
+  AddOp(subgraph, kLiteRtOpCodeTflRelu, {&input}, t0);
+  AddOp(subgraph, kLiteRtOpCodeTflTanh, {&t0}, t1);
+  AddOp(subgraph, kLiteRtOpCodeTflCustom, {&t1}, t2);
+  AddOp(subgraph, kLiteRtOpCodeTflRelu, {&t2}, t3);
+
+  const auto partitions = EstimatePartitionCosts(subgraph);
+  ASSERT_EQ(partitions.size(), 3);
+  EXPECT_EQ(partitions[0].first_op, 0);
+  EXPECT_EQ(partitions[0].num_ops, 2);
+  EXPECT_FALSE(partitions[0].is_custom);
+  EXPECT_EQ(partitions[0].transfer_bytes, 0);
+  EXPECT_EQ(partitions[0].cost.flops, 64 + 64 * 8);
+  EXPECT_TRUE(partitions[1].is_custom);
+  EXPECT_EQ(partitions[1].transfer_bytes, 64 * 4);
+  EXPECT_EQ(partitions[1].cost.num_unknown, 1);
+  EXPECT_EQ(partitions[2].first_op, 3);
+  EXPECT_EQ(partitions[2].transfer_bytes, 32 * 4);
+}
+
+TEST(CostModelTest, Roofline) {
+  const Roofline roofline{/*peak_flops=*/100e9, /*bandwidth=*/10e9};
+  EXPECT_DOUBLE_EQ(roofline.RidgePoint(), 10);
+
+  OpCost memory_bound;
+  memory_bound.flops = 1e6;
+  memory_bound.bytes_read = 1e6;
+  EXPECT_TRUE(roofline.IsMemoryBound(memory_bound));
+  EXPECT_DOUBLE_EQ(roofline.Seconds(memory_bound), 1e-4);
+
+  OpCost compute_bound;
+  compute_bound.flops = 1e9;
+  compute_bound.bytes_read = 1e6;
+  EXPECT_FALSE(roofline.IsMemoryBound(compute_bound));
+  EXPECT_DOUBLE_EQ(roofline.Seconds(compute_bound), 1e-2);
+}
+
+TEST(CostModelTest, MeasureRoofline) {
+  RooflineBenchmarkOptions options;
+  options.gemm_size = 32;
+  options.copy_bytes = 1 << 16;
+  options.num_runs = 2;
+  options.num_threads = 2;
+  const Roofline roofline = MeasureRoofline(options);
+  EXPECT_GT(roofline.peak_flops, 0);
+  EXPECT_GT(roofline.bandwidth, 0);
+  EXPECT_EQ(roofline.gemm_threads, 2);
+}
+
+}  // namespace
+}  // namespace litert::tools
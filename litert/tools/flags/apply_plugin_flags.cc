@@ -35,6 +35,11 @@ ABSL_FLAG(LiteRtCompilerOptionsPartitionStrategy, partition_strategy,
           kLiteRtCompilerOptionsPartitionStrategyDefault,
           "Partition strategy for the compiler.");
 
+ABSL_FLAG(int, num_compile_threads, 1,
+          "Number of threads that compile the partitions, each with an "
+          "instance of the plugin of its own. Ignored by plugins that can't "
+          "compile partitions separately.");
+
 // NOLINTBEGIN(*alien-types*)
 // TODO: Move absl parse/unparse function to same file as enum types if
 // it becomes an issue.
@@ -71,6 +76,8 @@ namespace litert {
 Expected<void> UpdateCompilerOptionsFromFlags(CompilerOptions& options) {
   LITERT_RETURN_IF_ERROR(
       options.SetPartitionStrategy(absl::GetFlag(FLAGS_partition_strategy)));
+  LITERT_RETURN_IF_ERROR(
+      options.SetNumCompileThreads(absl::GetFlag(FLAGS_num_compile_threads)));
 
   return {};
 }
@@ -36,6 +36,9 @@ bool AbslParseFlag(absl::string_view text,
 std::string AbslUnparseFlag(
     LiteRtCompilerOptionsPartitionStrategy partition_strategy);
 
+// Number of threads compiling the partitions.
+ABSL_DECLARE_FLAG(int, num_compile_threads);
+
 namespace litert {
 
 Expected<void> UpdateCompilerOptionsFromFlags(CompilerOptions& options);
@@ -30,6 +30,15 @@ LITERT_DEFINE_HANDLE(LiteRtCompilerPlugin);
 LITERT_DEFINE_HANDLE(LiteRtCompiledResult);
 
 // Struct to hold information about a transformation. Append only.
+//
+// `pattern` is called with a root op and returns kLiteRtStatusOk after
+// recording a rewrite in the builder. To decide whether it matches, it may
+// only look at the root op, at the ops producing its inputs (transitively),
+// and at the users of the tensors of these ops. The driver relies on this:
+// once no pattern matched an op, the op is only tried again after a rewrite
+// touched one of the ops in that neighborhood. A pattern reading anything
+// else, e.g. an unrelated op of the subgraph or state kept between calls,
+// can miss matches that a full rescan of the subgraph would have found.
 typedef struct {
   LiteRtPatternFn pattern;  // The function pointer of the pattern.
   const char* name;         // The name of the transformation.
@@ -88,6 +97,17 @@ LITERT_CAPI_EXPORT LiteRtStatus LiteRtCompilerPluginPartition(
 LITERT_CAPI_EXPORT LiteRtStatus LiteRtCompilerPluginCompile(
     LiteRtCompilerPlugin compiler_plugin, const char* soc_model,
     LiteRtModel partitions, LiteRtCompiledResult* compiled_result);
+
+// Optional. Compiles the single subgraph of `partition`, which is the partition
+// at `partition_index` of the model, into a result with one byte code module
+// and one call. The call must be named as LiteRtCompilerPluginCompile names the
+// partition at that index. Only plugins that compile every partition
+// independently of the others may implement this, as it allows the partitions
+// of a model to be compiled in parallel.
+LITERT_CAPI_EXPORT LiteRtStatus LiteRtCompilerPluginCompilePartition(
+    LiteRtCompilerPlugin compiler_plugin, const char* soc_model,
+    LiteRtModel partition, LiteRtParamIndex partition_index,
+    LiteRtCompiledResult* compiled_result);
 //
 // Compiled Partition
 //
@@ -122,6 +142,12 @@ LITERT_CAPI_EXPORT LiteRtStatus LiteRtGetNumCompiledResultCalls(
 // and their corresponding names. Registered patterns will be applied to the
 // graph before partition and compilation.
 //
+// Each pass rewrites the first op in program order that a transformation
+// matches, trying the transformations by decreasing benefit, until no
+// transformation matches anymore. Ops are only retried after a rewrite in
+// their neighborhood, so the patterns must respect the locality contract
+// described at LiteRtTransformation.
+//
 // Experimental: Unstable ABI, function signature is subject to change.
 LITERT_CAPI_EXPORT LiteRtStatus LiteRtCompilerPluginRegisterAllTransformations(
     LiteRtCompilerPlugin compiler_plugin,
@@ -59,6 +59,10 @@ typedef LiteRtStatus (*LiteRtCompilerPluginCompileT)(
     LiteRtCompilerPlugin, const char* soc_model, LiteRtModel partitions,
     LiteRtCompiledResult* compiled_result);
 
+typedef LiteRtStatus (*LiteRtCompilerPluginCompilePartitionT)(
+    LiteRtCompilerPlugin, const char* soc_model, LiteRtModel partition,
+    LiteRtParamIndex partition_index, LiteRtCompiledResult* compiled_result);
+
 typedef void (*LiteRtDestroyCompiledResultT)(LiteRtCompiledResult);
 
 typedef LiteRtStatus (*LiteRtGetCompiledResultByteCodeT)(
@@ -104,6 +108,8 @@ struct LiteRtCompilerPluginApi {
 
   LiteRtCompilerPluginPartitionT compiler_plugin_partition;
   LiteRtCompilerPluginCompileT compiler_plugin_compile;
+  // Optional, null if the plugin doesn't implement it.
+  LiteRtCompilerPluginCompilePartitionT compiler_plugin_compile_partition;
 
   LiteRtDestroyCompiledResultT destroy_compiled_result;
   LiteRtGetCompiledResultByteCodeT get_compiled_result_byte_code;
@@ -142,6 +148,8 @@ static constexpr absl::string_view kLiteRtCompilerPluginPartition =
     "LiteRtCompilerPluginPartition";
 static constexpr absl::string_view kLiteRtCompilerPluginCompile =
     "LiteRtCompilerPluginCompile";
+static constexpr absl::string_view kLiteRtCompilerPluginCompilePartition =
+    "LiteRtCompilerPluginCompilePartition";
 
 static constexpr absl::string_view kLiteRtDestroyCompiledResult =
     "LiteRtDestroyCompiledResult";
@@ -12,17 +12,27 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <list>
 #include <memory>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"  // from @com_google_absl
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_event.h"
+#include "litert/c/litert_metrics.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/internal/litert_handle.h"
@@ -36,6 +46,11 @@
 #include "litert/vendors/c/litert_dispatch_api.h"
 #include "litert/vendors/examples/example_common.h"
 
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
+
 namespace {
 using Buffer = ::litert::example::Data;
 using BufferHandle = Buffer*;
@@ -75,6 +90,41 @@ class LiteRtDispatchDeviceContextT {
   RegistredBuffers registered_buffers_;
 };
 
+// Detail level 0 only counts invocations, level 1 also reports the total time
+// spent executing the graph. Higher levels aren't supported.
+constexpr int kMaxMetricsDetailLevel = 1;
+
+class LiteRtDispatchMetricsT {
+ public:
+  LiteRtDispatchMetricsT(int detail_level, int64_t num_invocations,
+                         int64_t execution_time_us)
+      : detail_level_(detail_level),
+        num_invocations_(num_invocations),
+        execution_time_us_(execution_time_us) {}
+
+  int GetNumMetrics() const { return detail_level_ + 1; }
+
+  LiteRtStatus GetMetric(int metric_index, LiteRtMetric& metric) const {
+    if (metric_index < 0 || metric_index >= GetNumMetrics()) {
+      return kLiteRtStatusErrorInvalidArgument;
+    }
+    metric.value.type = kLiteRtAnyTypeInt;
+    if (metric_index == 0) {
+      metric.name = "example_num_invocations";
+      metric.value.int_value = num_invocations_;
+    } else {
+      metric.name = "example_execution_time_us";
+      metric.value.int_value = execution_time_us_;
+    }
+    return kLiteRtStatusOk;
+  }
+
+ private:
+  const int detail_level_;
+  const int64_t num_invocations_;
+  const int64_t execution_time_us_;
+};
+
 class LiteRtDispatchInvocationContextT {
  public:
   using Ptr = std::unique_ptr<LiteRtDispatchInvocationContextT>;
@@ -151,7 +201,54 @@ class LiteRtDispatchInvocationContextT {
     return example_graph_;
   }
 
-  ~LiteRtDispatchInvocationContextT() = default;
+  void StartMetricsCollection(int detail_level) {
+    WaitForBackgroundExecution();
+    collect_metrics_ = true;
+    metrics_detail_level_ = detail_level;
+    num_invocations_ = 0;
+    execution_time_us_ = 0;
+  }
+
+  LiteRtDispatchMetrics StopMetricsCollection() {
+    // Account for an asynchronous execution that is still in flight.
+    WaitForBackgroundExecution();
+    collect_metrics_ = false;
+    return new LiteRtDispatchMetricsT(metrics_detail_level_, num_invocations_,
+                                      execution_time_us_);
+  }
+
+  void CountInvocation() {
+    if (collect_metrics_) {
+      ++num_invocations_;
+    }
+  }
+
+  bool CollectsExecutionTime() const {
+    return collect_metrics_ && metrics_detail_level_ >= 1;
+  }
+
+  // May be called from the worker thread of an asynchronous invocation.
+  void AddExecutionTime(std::chrono::steady_clock::duration duration) {
+    execution_time_us_ +=
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count();
+  }
+
+  // Runs `execute` on a worker thread. Graph buffers are reused across
+  // invocations, so the previous execution must have finished before the
+  // next one is set up.
+  void ExecuteInBackground(std::function<void()> execute) {
+    WaitForBackgroundExecution();
+    worker_ = std::thread(std::move(execute));
+  }
+
+  void WaitForBackgroundExecution() {
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  ~LiteRtDispatchInvocationContextT() { WaitForBackgroundExecution(); }
 
  private:
   LiteRtDispatchInvocationContextT(
@@ -170,6 +267,11 @@ class LiteRtDispatchInvocationContextT {
   std::vector<BufferHandle> inputs_;
   std::vector<BufferHandle> outputs_;
   ::litert::example::ExampleGraph example_graph_;
+  bool collect_metrics_ = false;
+  int metrics_detail_level_ = 0;
+  int64_t num_invocations_ = 0;
+  std::atomic<int64_t> execution_time_us_ = 0;
+  std::thread worker_;
 };
 
 namespace litert::example {
@@ -177,6 +279,9 @@ namespace {
 
 LiteRtEnvironment the_environment = nullptr;
 LiteRtOptions the_options = nullptr;
+// Latency added to every execution, to emulate a real accelerator in
+// benchmarks. Set with environment variable LITERT_EXAMPLE_DISPATCH_LATENCY_US.
+std::chrono::microseconds the_latency{0};
 
 LiteRtStatus GetVendorId(const char** vendor_id) {
   *vendor_id = "Example";
@@ -190,12 +295,18 @@ LiteRtStatus GetBuildId(const char** build_id) {
 
 LiteRtStatus GetCapabilities(int* capabilities) {
   *capabilities = kLiteRtDispatchCapabilitiesBasic;
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+  *capabilities |= kLiteRtDispatchCapabilitiesAsync;
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
   return kLiteRtStatusOk;
 }
 
 LiteRtStatus Initialize(LiteRtEnvironment env, LiteRtOptions options) {
   the_environment = env;
   the_options = options;
+  const char* latency_us = std::getenv("LITERT_EXAMPLE_DISPATCH_LATENCY_US");
+  the_latency = std::chrono::microseconds(latency_us ? std::atoi(latency_us)
+                                                     : 0);
   return kLiteRtStatusOk;
 }
 
@@ -309,21 +420,135 @@ LiteRtStatus DetachOutput(LiteRtDispatchInvocationContext invocation_context,
   return kLiteRtStatusOk;
 }
 
-LiteRtStatus Invoke(LiteRtDispatchInvocationContext invocation_context) {
-  invocation_context->Setup();
-  const auto num_inputs = invocation_context->ExampleGraph().Inputs().size();
+// Executes the graph on the inputs of the last Setup().
+Expected<std::vector<Buffer>> ExecuteGraph(
+    LiteRtDispatchInvocationContextT& invocation_context) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto num_inputs = invocation_context.ExampleGraph().Inputs().size();
   std::vector<Buffer> inputs(num_inputs);
   for (int i = 0; i < num_inputs; ++i) {
-    inputs[i] = invocation_context->GetInput(i);
+    inputs[i] = invocation_context.GetInput(i);
   }
-  LITERT_ASSIGN_OR_RETURN(
-      auto results,
-      ::litert::example::Execute(invocation_context->ExampleGraph(), inputs));
+  std::this_thread::sleep_for(the_latency);
+  auto results =
+      ::litert::example::Execute(invocation_context.ExampleGraph(), inputs);
+  if (invocation_context.CollectsExecutionTime()) {
+    invocation_context.AddExecutionTime(std::chrono::steady_clock::now() -
+                                        start);
+  }
+  return results;
+}
+
+LiteRtStatus Invoke(LiteRtDispatchInvocationContext invocation_context) {
+  invocation_context->WaitForBackgroundExecution();
+  invocation_context->Setup();
+  LITERT_ASSIGN_OR_RETURN(auto results, ExecuteGraph(*invocation_context));
   for (int i = 0; i < results.size(); ++i) {
     invocation_context->GetOutput(i) = std::move(results[i]);
   }
 
   invocation_context->Finish();
+  invocation_context->CountInvocation();
+  return kLiteRtStatusOk;
+}
+
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+LiteRtStatus AttachInputEvent(
+    LiteRtDispatchInvocationContext invocation_context, int graph_input_index,
+    LiteRtEvent input_event) {
+  // Inputs are read on the CPU by Setup(), which waits for their events.
+  return kLiteRtStatusOk;
+}
+
+// Executes the graph on a worker thread, and signals the output events, which
+// are backed by eventfds, once the outputs have been written.
+LiteRtStatus InvokeAsync(LiteRtDispatchInvocationContext invocation_context,
+                         int num_output_events, LiteRtEvent* output_events) {
+  const auto num_outputs = invocation_context->ExampleGraph().Outputs().size();
+  if (num_output_events != num_outputs) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  invocation_context->WaitForBackgroundExecution();
+  invocation_context->Setup();
+
+  // Output buffers can't be locked from the worker thread: locking waits for
+  // the events that the worker signals.
+  std::vector<absl::Span<uint8_t>> output_memory(num_outputs);
+  for (int i = 0; i < num_outputs; ++i) {
+    auto buffer = invocation_context->DeviceContext().Lookup(
+        &invocation_context->GetOutput(i));
+    LITERT_ASSIGN_OR_RETURN(auto packed_size, buffer.PackedSize());
+    LITERT_ASSIGN_OR_RETURN(void* host_memory,
+                            buffer.Lock(TensorBuffer::LockMode::kWrite));
+    LITERT_RETURN_IF_ERROR(buffer.Unlock());
+    output_memory[i] =
+        absl::MakeSpan(static_cast<uint8_t*>(host_memory), packed_size);
+  }
+
+  std::vector<int> event_fds(num_outputs);
+  for (int i = 0; i < num_outputs; ++i) {
+    event_fds[i] = eventfd(/*initval=*/0, EFD_CLOEXEC);
+    if (event_fds[i] < 0) {
+      return kLiteRtStatusErrorRuntimeFailure;
+    }
+    LITERT_RETURN_IF_ERROR(LiteRtCreateEventFromSyncFenceFd(
+        the_environment, event_fds[i], /*owns_fd=*/true, &output_events[i]));
+  }
+
+  invocation_context->CountInvocation();
+  invocation_context->ExecuteInBackground(
+      [invocation_context, output_memory = std::move(output_memory),
+       event_fds = std::move(event_fds)]() {
+        if (auto results = ExecuteGraph(*invocation_context); results) {
+          for (int i = 0; i < results->size(); ++i) {
+            const Buffer& result = (*results)[i];
+            std::memcpy(output_memory[i].data(), result.data(),
+                        std::min(output_memory[i].size(),
+                                 result.size() * sizeof(result[0])));
+            invocation_context->GetOutput(i) = std::move((*results)[i]);
+          }
+        }
+        // Signal the events even on failure, so that nobody waits forever.
+        for (int event_fd : event_fds) {
+          const uint64_t one = 1;
+          (void)write(event_fd, &one, sizeof(one));
+        }
+      });
+  return kLiteRtStatusOk;
+}
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
+
+LiteRtStatus StartMetricsCollection(
+    LiteRtDispatchInvocationContext invocation_context, int detail_level) {
+  if (detail_level < 0) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  if (detail_level > kMaxMetricsDetailLevel) {
+    return kLiteRtStatusErrorUnsupported;
+  }
+  invocation_context->StartMetricsCollection(detail_level);
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus StopMetricsCollection(
+    LiteRtDispatchInvocationContext invocation_context,
+    LiteRtDispatchMetrics* metrics) {
+  *metrics = invocation_context->StopMetricsCollection();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus GetNumMetrics(LiteRtDispatchMetrics metrics, int* num_metrics) {
+  *num_metrics = metrics->GetNumMetrics();
+  return kLiteRtStatusOk;
+}
+
+LiteRtStatus GetMetric(LiteRtDispatchMetrics metrics, int metric_index,
+                       LiteRtMetric* metric) {
+  return metrics->GetMetric(metric_index, *metric);
+}
+
+LiteRtStatus DestroyMetrics(LiteRtDispatchMetrics metrics) {
+  delete metrics;
   return kLiteRtStatusOk;
 }
 
@@ -354,20 +579,31 @@ LiteRtDispatchInterface ExampleInterface = {
     /*.detach_input=*/DetachInput,
     /*.detach_output=*/DetachOutput,
     /*.invoke=*/Invoke,
-    /*.start_metrics_collection=*/nullptr,
-    /*.stop_metrics_collection=*/nullptr,
-    /*.get_num_metrics=*/nullptr,
-    /*.get_metric=*/nullptr,
-    /*.destroy_metrics=*/nullptr,
+    /*.start_metrics_collection=*/StartMetricsCollection,
+    /*.stop_metrics_collection=*/StopMetricsCollection,
+    /*.get_num_metrics=*/GetNumMetrics,
+    /*.get_metric=*/GetMetric,
+    /*.destroy_metrics=*/DestroyMetrics,
     /*.check_runtime_compatibility=*/CheckRuntimeCompatibility,
 };
 
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+LiteRtDispatchAsyncInterface ExampleAsyncInterface = {
+    /*.attach_input_event=*/AttachInputEvent,
+    /*.invoke_async=*/InvokeAsync,
+};
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
+
 LiteRtDispatchApi ExampleApi = {
     /*.version=*/{/*.major=*/LITERT_API_VERSION_MAJOR,
                   /*.minor=*/LITERT_API_VERSION_MINOR,
                   /*.patch=*/LITERT_API_VERSION_PATCH},
     /*.interface=*/&ExampleInterface,
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+    /*.async_interface=*/&ExampleAsyncInterface,
+#else
     /*.async_interface=*/nullptr,
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
     /*.graph_interface=*/nullptr,
 };
 
@@ -19,7 +19,9 @@
 #include <gtest/gtest.h>
 #include "absl/strings/string_view.h"  // from @com_google_absl
 #include "absl/types/span.h"  // from @com_google_absl
+#include "litert/c/litert_any.h"
 #include "litert/c/litert_common.h"
+#include "litert/c/litert_metrics.h"
 #include "litert/c/litert_model_types.h"
 #include "litert/c/litert_tensor_buffer_types.h"
 #include "litert/cc/internal/litert_handle.h"
@@ -115,7 +117,12 @@ TEST_F(ExampleDispatchTest, GetBuildId) {
 TEST_F(ExampleDispatchTest, GetCapabilities) {
   int capabilities;
   LITERT_ASSERT_OK(Api().get_capabilities(&capabilities));
+#if LITERT_HAS_SYNC_FENCE_SUPPORT
+  EXPECT_EQ(capabilities, kLiteRtDispatchCapabilitiesBasic |
+                              kLiteRtDispatchCapabilitiesAsync);
+#else
   EXPECT_EQ(capabilities, kLiteRtDispatchCapabilitiesBasic);
+#endif  // LITERT_HAS_SYNC_FENCE_SUPPORT
 }
 
 TEST_F(ExampleDispatchTest, DeviceContextCreate) {
@@ -188,6 +195,96 @@ ops:mul(0,1)(2))";
   EXPECT_THAT(out, ElementsAre(1.0f, 4.0f, 9.0f, 16.0f));
 }
 
+TEST_F(ExampleDispatchTest, MetricsDetailLevel) {
+  // clang-format off
+  static constexpr absl::string_view kSchema = R"(version:1
+inputs:0,1
+outputs:2
+tensors:[2],[2],[2]
+ops:mul(0,1)(2))";
+  // clang-format on
+  static constexpr absl::string_view kFunctionName = "partition_0";
+
+  LiteRtMemBuffer exec_bytecode_buffer;
+  exec_bytecode_buffer.base_addr = kSchema.data();
+  exec_bytecode_buffer.size = kSchema.size();
+  exec_bytecode_buffer.fd = -1;
+  exec_bytecode_buffer.offset = 0;
+
+  LiteRtDispatchDeviceContext device_context;
+  LITERT_ASSERT_OK(Api().device_context_create(&device_context));
+  auto device_context_ptr = CreateDevicePtr(Api(), device_context);
+
+  LiteRtDispatchInvocationContext invocation_context;
+  LITERT_ASSERT_OK(Api().invocation_context_create(
+      device_context, kLiteRtDispatchExecutableTypeMlModel,
+      &exec_bytecode_buffer, kFunctionName.data(), /*num_inputs=*/2,
+      /*num_outputs=*/1, &invocation_context));
+  auto invocation_context_ptr =
+      CreateInvocationContextPtr(Api(), invocation_context);
+
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input1,
+                              SimpleBuffer::Create<float>({2}, {1.0f, 2.0f}));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_tb1, input1.SpawnTensorBuffer());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input2,
+                              SimpleBuffer::Create<float>({2}, {3.0f, 4.0f}));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto input_tb2, input2.SpawnTensorBuffer());
+  LITERT_ASSERT_OK_AND_ASSIGN(auto output, SimpleBuffer::Create<float>({2}));
+  LITERT_ASSERT_OK_AND_ASSIGN(auto output_tb, output.SpawnTensorBuffer());
+  LiteRtTensorBufferHandle handle1;
+  LITERT_ASSERT_OK(
+      Api().register_tensor_buffer(device_context, input_tb1.Get(), &handle1));
+  LiteRtTensorBufferHandle handle2;
+  LITERT_ASSERT_OK(
+      Api().register_tensor_buffer(device_context, input_tb2.Get(), &handle2));
+  LiteRtTensorBufferHandle handle3;
+  LITERT_ASSERT_OK(
+      Api().register_tensor_buffer(device_context, output_tb.Get(), &handle3));
+  LITERT_ASSERT_OK(Api().attach_input(invocation_context, 0, handle1));
+  LITERT_ASSERT_OK(Api().attach_input(invocation_context, 1, handle2));
+  LITERT_ASSERT_OK(Api().attach_output(invocation_context, 0, handle3));
+
+  EXPECT_EQ(Api().start_metrics_collection(invocation_context, -1),
+            kLiteRtStatusErrorInvalidArgument);
+  EXPECT_EQ(Api().start_metrics_collection(invocation_context, 2),
+            kLiteRtStatusErrorUnsupported);
+
+  // Level 0 only counts invocations.
+  LITERT_ASSERT_OK(Api().start_metrics_collection(invocation_context, 0));
+  LITERT_ASSERT_OK(Api().invoke(invocation_context));
+  LiteRtDispatchMetrics metrics;
+  LITERT_ASSERT_OK(Api().stop_metrics_collection(invocation_context, &metrics));
+  int num_metrics;
+  LITERT_ASSERT_OK(Api().get_num_metrics(metrics, &num_metrics));
+  EXPECT_EQ(num_metrics, 1);
+  LiteRtMetric metric;
+  LITERT_ASSERT_OK(Api().get_metric(metrics, 0, &metric));
+  EXPECT_EQ(absl::string_view(metric.name), "example_num_invocations");
+  EXPECT_EQ(metric.value.int_value, 1);
+  EXPECT_EQ(Api().get_metric(metrics, 1, &metric),
+            kLiteRtStatusErrorInvalidArgument);
+  LITERT_ASSERT_OK(Api().destroy_metrics(metrics));
+
+  // Level 1 also reports the execution time.
+  LITERT_ASSERT_OK(Api().start_metrics_collection(invocation_context, 1));
+  LITERT_ASSERT_OK(Api().invoke(invocation_context));
+  LITERT_ASSERT_OK(Api().invoke(invocation_context));
+  LITERT_ASSERT_OK(Api().stop_metrics_collection(invocation_context, &metrics));
+  LITERT_ASSERT_OK(Api().get_num_metrics(metrics, &num_metrics));
+  EXPECT_EQ(num_metrics, 2);
+  LITERT_ASSERT_OK(Api().get_metric(metrics, 0, &metric));
+  EXPECT_EQ(metric.value.int_value, 2);
+  LITERT_ASSERT_OK(Api().get_metric(metrics, 1, &metric));
+  EXPECT_EQ(absl::string_view(metric.name), "example_execution_time_us");
+  EXPECT_EQ(metric.value.type, kLiteRtAnyTypeInt);
+  EXPECT_GE(metric.value.int_value, 0);
+  LITERT_ASSERT_OK(Api().destroy_metrics(metrics));
+
+  std::vector<float> out(2);
+  LITERT_ASSERT_OK(output_tb.Read(absl::MakeSpan(out)));
+  EXPECT_THAT(out, ElementsAre(3.0f, 8.0f));
+}
+
 TEST_F(ExampleDispatchTest, TensorBufferRequirementsInputs) {
   const auto t = MakeRankedTensorType<float>({2, 2});
   LiteRtTensorBufferRequirements requirements = nullptr;
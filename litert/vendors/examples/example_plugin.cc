@@ -134,7 +134,8 @@ LiteRtStatus LiteRtGetCompiledResultCallInfo(
   }
   *call_info = compiled_result->per_op_data.at(call_idx).data();
   *call_info_size = compiled_result->per_op_data.at(call_idx).size();
-  *byte_code_idx = 0;
+  // Every partition is compiled to a byte code module of its own.
+  *byte_code_idx = call_idx;
   return kLiteRtStatusOk;
 }
 
@@ -220,10 +221,12 @@ Expected<OpCode> ConvertOpCode(LiteRtOpCode code) {
   }
 }
 
+// Compiles the partition at `partition_index` of the model into the byte code
+// module and call at `result_idx` of `result`.
 LiteRtStatus CompileSinglePartition(LiteRtParamIndex partition_index,
                                     LiteRtSubgraph subgraph,
                                     LiteRtCompiledResultT& result,
-                                    int byte_code_idx) {
+                                    int result_idx) {
   const litert::Subgraph sg(subgraph);
   ExampleGraph example_graph;
   std::unordered_map<LiteRtTensor, int> tensor_map;  // NOLINT
@@ -274,8 +277,8 @@ LiteRtStatus CompileSinglePartition(LiteRtParamIndex partition_index,
   example_graph.SetVersion(kExamplePluginVersion);
 
   LITERT_ASSIGN_OR_RETURN(auto serialized, example_graph.Serialize());
-  result.byte_code[byte_code_idx] = std::string(serialized.StrView());
-  result.per_op_data[partition_index] =
+  result.byte_code[result_idx] = std::string(serialized.StrView());
+  result.per_op_data[result_idx] =
       absl::StrFormat("partition_%d", partition_index);
 
   return kLiteRtStatusOk;
@@ -303,6 +306,26 @@ LiteRtStatus LiteRtCompilerPluginCompile(
   return kLiteRtStatusOk;
 }
 
+LiteRtStatus LiteRtCompilerPluginCompilePartition(
+    LiteRtCompilerPlugin compiler_plugin, const char* soc_model,
+    LiteRtModel partition, LiteRtParamIndex partition_index,
+    LiteRtCompiledResult* compiled_result) {
+  auto model = litert::ExtendedModel::CreateFromNonOwnedHandle(partition);
+  if (model.NumSubgraphs() != 1) {
+    return kLiteRtStatusErrorInvalidArgument;
+  }
+  auto result = std::make_unique<LiteRtCompiledResultT>();
+  result->byte_code.resize(1);
+  result->per_op_data.resize(1);
+  LITERT_ASSIGN_OR_RETURN(litert::Subgraph subgraph, model.Subgraph(0));
+  LITERT_RETURN_IF_ERROR(::litert::example::CompileSinglePartition(
+      partition_index, subgraph.Get(), *result, /*result_idx=*/0));
+
+  *compiled_result = result.release();
+
+  return kLiteRtStatusOk;
+}
+
 LiteRtStatus LiteRtCompilerPluginRegisterAllTransformations(
     LiteRtCompilerPlugin compiler_plugin,
     LiteRtTransformation** transformations, LiteRtParamIndex* num_patterns) {
@@ -97,6 +97,36 @@ TEST(TestCallDummyPlugin, CompileMulSubgraph) {
   LiteRtDestroyCompiledResult(compiled);
 }
 
+TEST(TestCallDummyPlugin, CompileMulPartitionWithIndex) {
+  auto plugin = CreatePlugin();
+  auto model = testing::LoadTestFileModel("mul_simple.tflite");
+
+  LiteRtCompiledResult compiled;
+  LITERT_ASSERT_OK(LiteRtCompilerPluginCompilePartition(
+      plugin.get(), /*soc_model=*/nullptr, model.Get(), /*partition_index=*/3,
+      &compiled));
+
+  LiteRtParamIndex num_byte_code;
+  LITERT_ASSERT_OK(
+      LiteRtCompiledResultNumByteCodeModules(compiled, &num_byte_code));
+  EXPECT_EQ(num_byte_code, 1);
+  LiteRtParamIndex num_calls;
+  LITERT_ASSERT_OK(LiteRtGetNumCompiledResultCalls(compiled, &num_calls));
+  EXPECT_EQ(num_calls, 1);
+
+  LiteRtParamIndex byte_code_idx;
+  const void* op_data;
+  size_t op_data_size;
+  LITERT_ASSERT_OK(LiteRtGetCompiledResultCallInfo(
+      compiled, /*call_idx=*/0, &op_data, &op_data_size, &byte_code_idx));
+  absl::string_view op_data_string(reinterpret_cast<const char*>(op_data),
+                                   op_data_size);
+  EXPECT_EQ(op_data_string, "partition_3");
+  EXPECT_EQ(byte_code_idx, 0);
+
+  LiteRtDestroyCompiledResult(compiled);
+}
+
 TEST(TestCallDummyPlugin, RegisterAllTransformations) {
   auto plugin = CreatePlugin();
   LiteRtTransformation* transformations;
@@ -67,6 +67,7 @@ TfLiteStatus ArenaPlanner::ResetAllocations() {
   TF_LITE_ENSURE_STATUS(persistent_arena_.ClearPlan());
   allocs_.clear();
   allocs_.resize(graph_info_->num_tensors());
+  imported_allocs_.clear();
   // NOMUTANTS -- Setting last_active_node_ to kLastActiveNodeUndefined causes
   // all allocs to be cleared. if this is not set, the slow path is taken
   // (Purge) which inspects each alloc. Both paths give the exact same result.
@@ -428,6 +429,67 @@ void ArenaPlanner::GetAllocInfo(size_t* arena_size,
   *arena_persist_size = persistent_arena_.GetBufferSize();
 }
 
+TfLiteStatus ArenaPlanner::ExportPlan(MemoryPlanSnapshot* snapshot) const {
+  snapshot->allocations.clear();
+  const TfLiteTensor* tensors = graph_info_->tensors();
+  for (int i = 0; i < static_cast<int>(allocs_.size()); ++i) {
+    const ArenaAllocWithUsageInterval& alloc = allocs_[i];
+    // Tensors sharing another tensor's buffer are never allocated, they are
+    // recomputed by PlanAllocations().
+    if (alloc.tensor != i || alloc.size == 0) continue;
+    const TfLiteAllocationType type = tensors[i].allocation_type;
+    if (type != kTfLiteArenaRw && type != kTfLiteArenaRwPersistent) continue;
+    snapshot->allocations.push_back(
+        {i, type == kTfLiteArenaRwPersistent, alloc.offset, alloc.size,
+         alloc.first_node, alloc.last_node});
+  }
+  return kTfLiteOk;
+}
+
+void ArenaPlanner::SetPlacement(const MemoryPlacement& placement) {
+  arena_.SetPlacement(placement);
+  persistent_arena_.SetPlacement(placement);
+}
+
+TfLiteStatus ArenaPlanner::ImportPlan(const MemoryPlanSnapshot& snapshot) {
+  const int num_tensors = static_cast<int>(graph_info_->num_tensors());
+  imported_allocs_.assign(num_tensors, PlannedAllocation{-1});
+  for (const PlannedAllocation& alloc : snapshot.allocations) {
+    if (alloc.tensor < 0 || alloc.tensor >= num_tensors ||
+        alloc.offset % tensor_alignment_ != 0) {
+      imported_allocs_.clear();
+      TF_LITE_KERNEL_LOG(context_, "Imported memory plan doesn't match graph.");
+      return kTfLiteError;
+    }
+    imported_allocs_[alloc.tensor] = alloc;
+  }
+  return kTfLiteOk;
+}
+
+bool ArenaPlanner::AllocateFromImportedPlan(SimpleMemoryArena& arena,
+                                            bool persistent,
+                                            int32_t tensor_index,
+                                            size_t size) {
+  // Zero-sized tensors are not part of exported plans.
+  if (imported_allocs_.empty() || size == 0) return false;
+  const int32_t last_node = persistent ? std::numeric_limits<int32_t>::max()
+                                       : dealloc_node_[tensor_index];
+  const PlannedAllocation& imported = imported_allocs_[tensor_index];
+  if (imported.tensor != tensor_index || imported.persistent != persistent ||
+      imported.size != size ||
+      imported.first_node != alloc_node_[tensor_index] ||
+      imported.last_node != last_node ||
+      arena.AllocateAt(context_, tensor_alignment_, imported.offset, size,
+                       tensor_index, imported.first_node, last_node,
+                       &allocs_[tensor_index]) != kTfLiteOk) {
+    // The remaining placements may overlap with tensors placed from here on,
+    // don't use any of them.
+    imported_allocs_.clear();
+    return false;
+  }
+  return true;
+}
+
 TfLiteStatus ArenaPlanner::Commit(bool* reallocated) {
   bool arena_reallocated, persistent_arena_reallocated;
   TF_LITE_ENSURE_STATUS(arena_.Commit(&arena_reallocated));
@@ -540,7 +602,9 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
         continue;
       }
     }
-    if (tensor.allocation_type == kTfLiteArenaRw) {
+    if (tensor.allocation_type == kTfLiteArenaRw &&
+        !AllocateFromImportedPlan(arena_, /*persistent=*/false, tensor_index,
+                                  tensor.bytes)) {
       TF_LITE_ENSURE_STATUS(
           arena_.Allocate(context_, tensor_alignment_, tensor.bytes,
                           tensor_index, alloc_node_[tensor_index],
@@ -550,7 +614,9 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     // Only allocate ArenaRwPersistent tensors which own their buffer.
     if (tensor.allocation_type == kTfLiteArenaRwPersistent &&
         allocs_[tensor_index].size == 0) {
-      if (allocs_[tensor_index].size < tensor.bytes) {
+      if (allocs_[tensor_index].size < tensor.bytes &&
+          !AllocateFromImportedPlan(persistent_arena_, /*persistent=*/true,
+                                    tensor_index, tensor.bytes)) {
         TF_LITE_ENSURE_STATUS(persistent_arena_.Allocate(
             context_, tensor_alignment_, tensor.bytes, tensor_index,
             /*first_node=*/alloc_node_[tensor_index],
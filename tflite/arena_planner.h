@@ -24,6 +24,7 @@ limitations under the License.
 
 #include "tflite/core/c/common.h"
 #include "tflite/graph_info.h"
+#include "tflite/memory_placement.h"
 #include "tflite/memory_planner.h"
 #include "tflite/simple_memory_arena.h"
 #include "tflite/util.h"
@@ -68,10 +69,16 @@ class ArenaPlanner : public MemoryPlanner {
   void DumpDebugInfo(const std::vector<int>& execution_plan) const override;
   void GetAllocInfo(size_t* arena_size,
                     size_t* arena_persist_size) const override;
+  TfLiteStatus ExportPlan(MemoryPlanSnapshot* snapshot) const override;
+  TfLiteStatus ImportPlan(const MemoryPlanSnapshot& snapshot) override;
 
   // Returns the base arena location for a given allocation type.
   std::intptr_t BasePointer(TfLiteAllocationType type);
 
+  // Places both arenas according to `placement` from their next reallocation
+  // on.
+  void SetPlacement(const MemoryPlacement& placement);
+
  private:
   // Check whether the input tensor's memory may be shared the output tensor.
   // tensor_changed: true if the output tensor modifies the tensor data. For
@@ -120,6 +127,12 @@ class ArenaPlanner : public MemoryPlanner {
   // Return the index of the tensor owing `tensor_index's` buffer.
   int FindSharedTensor(int tensor_index);
 
+  // Places `tensor_index` in `arena` at the offset recorded in the imported
+  // plan. Returns false, and drops the imported plan, if there is no matching
+  // placement for the tensor.
+  bool AllocateFromImportedPlan(SimpleMemoryArena& arena, bool persistent,
+                                int32_t tensor_index, size_t size);
+
   TfLiteContext* context_;
   std::unique_ptr<GraphInfo> graph_info_;
 
@@ -166,6 +179,10 @@ class ArenaPlanner : public MemoryPlanner {
 
   // Store number of references to each tensor.
   std::vector<int> refcounts_;
+
+  // Placements imported with ImportPlan(), indexed by tensor. Empty when no
+  // plan was imported or it stopped matching the graph.
+  std::vector<PlannedAllocation> imported_allocs_;
 };
 
 }  // namespace tflite
@@ -370,6 +370,42 @@ TEST_F(ArenaPlannerTest, AllocsCorrectlyReset) {
   EXPECT_EQ(GetOffset(1), 4);
 }
 
+TEST_F(ArenaPlannerTest, ImportedPlanIsReused) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},     // First op
+                      {{2, 0}, {4, 5}, {}},  // Second op
+                      {{4, 5}, {3}, {}}      // Third op
+                  },
+                  {3});
+  SetGraph(&graph);
+  Execute(0, graph.nodes().size() - 1);
+  MemoryPlanSnapshot snapshot;
+  ASSERT_EQ(planner_->ExportPlan(&snapshot), kTfLiteOk);
+  EXPECT_EQ(snapshot.allocations.size(), 6);
+
+  // Moving every tensor keeps the plan valid, and shows that the offsets are
+  // not recomputed.
+  for (PlannedAllocation& alloc : snapshot.allocations) alloc.offset += 64;
+  SetGraph(&graph);
+  ASSERT_EQ(planner_->ImportPlan(snapshot), kTfLiteOk);
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_EQ(GetOffset(5), 12 + 64);
+  EXPECT_EQ(GetOffset(4), GetOffsetAfter(5));
+  EXPECT_EQ(GetOffset(3), GetOffsetAfter(4));
+  EXPECT_EQ(GetOffset(2), GetOffsetAfter(4));
+  EXPECT_EQ(GetOffset(1), 4 + 64);
+
+  // A tensor whose size changed invalidates the rest of the plan.
+  snapshot.allocations[0].size += 4;
+  SetGraph(&graph);
+  ASSERT_EQ(planner_->ImportPlan(snapshot), kTfLiteOk);
+  Execute(0, graph.nodes().size() - 1);
+  EXPECT_EQ(GetOffset(5), 12);
+  EXPECT_EQ(GetOffset(1), 4);
+}
+
 TEST_F(ArenaPlannerTest, SimpleGraphInputsPreserved) {
   TestGraph graph({0, 1},
                   {
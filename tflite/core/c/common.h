@@ -82,7 +82,8 @@ typedef enum TfLiteExternalContextType {
   kTfLiteCpuBackendContext = 3,  /// include cpu_backend_context.h to use.
   kTfLiteLiteRtBufferContext =
       4,  /// include external_litert_buffer_context.h to use.
-  kTfLiteMaxExternalContexts = 5
+  kTfLiteInterruptContext = 5,  /// include invocation_interrupt.h to use.
+  kTfLiteMaxExternalContexts = 6
 } TfLiteExternalContextType;
 
 // Forward declare so dependent structs and methods can reference these types
@@ -19,6 +19,7 @@ limitations under the License.
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <functional>
 #include <map>
 #include <memory>
@@ -37,6 +38,7 @@ limitations under the License.
 #include "tflite/external_cpu_backend_context.h"
 #include "tflite/internal/signature_def.h"
 #include "tflite/interpreter_options.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/logger.h"
 #include "tflite/minimal_logging.h"
 #include "tflite/profiling/root_profiler.h"
@@ -126,6 +128,7 @@ Interpreter::Interpreter(ErrorReporter* error_reporter)
       std::make_unique<ExternalCpuBackendContext>();
   external_contexts_[kTfLiteCpuBackendContext] =
       own_external_cpu_backend_context_.get();
+  external_contexts_[kTfLiteInterruptContext] = &invocation_interrupt_;
 }
 
 Interpreter::~Interpreter() {
@@ -158,6 +161,12 @@ void Interpreter::SetExternalContext(TfLiteExternalContextType type,
         "owned one.");
     return;
   }
+  if (type == kTfLiteInterruptContext) {
+    error_reporter_->Report(
+        "WARNING: The interrupt context is owned by the interpreter and can't "
+        "be replaced.");
+    return;
+  }
 
   // We have an internally owned external context of kTfLiteCpuBackendContext.
   // If it's overwritten here, we will release the resource of the internally
@@ -236,7 +245,7 @@ TfLiteStatus Interpreter::Invoke() {
 
   // "Resets" cancellation flag so cancellation that happens before this invoke
   // will not take effect.
-  if (cancellation_enabled_) (void)continue_invocation_.test_and_set();
+  if (cancellation_enabled_) invocation_interrupt_.ResetCancellation();
 
   // Denormal floating point numbers could cause significant slowdown on
   // platforms like x86, therefore, we suppress denormals here to prevent this
@@ -501,19 +510,35 @@ TfLiteStatus Interpreter::ApplyOptionsImpl(InterpreterOptions* options) {
   for (auto& subgraph : subgraphs_) {
     subgraph->SetOptions(options_.get());
   }
+  // A context set with `SetExternalContext` is left to its owner.
+  if (own_external_cpu_backend_context_ && options_->GetPinWorkerThreads()) {
+    own_external_cpu_backend_context_->set_worker_numa_node(
+        options_->GetMemoryPlacement().numa_node);
+  }
   return kTfLiteOk;
 }
 
 TfLiteStatus Interpreter::EnableCancellation() {
   cancellation_enabled_ = true;
+  invocation_interrupt_.EnableCancellation();
   for (auto& subgraph : subgraphs_) {
-    TF_LITE_ENSURE_STATUS(subgraph->EnableCancellation(&continue_invocation_));
+    TF_LITE_ENSURE_STATUS(
+        subgraph->EnableCancellation(&invocation_interrupt_));
   }
   return kTfLiteOk;
 }
 
 TfLiteStatus Interpreter::Cancel() { return primary_subgraph().Cancel(); }
 
+void Interpreter::SetInvocationDeadline(
+    std::chrono::steady_clock::time_point deadline) {
+  invocation_interrupt_.SetDeadline(deadline);
+}
+
+void Interpreter::ClearInvocationDeadline() {
+  invocation_interrupt_.ClearDeadline();
+}
+
 void Interpreter::AddProfiler(std::unique_ptr<Profiler> profiler) {
   if (profiler == nullptr) return;
   if (root_profiler_ == nullptr) {
@@ -28,7 +28,7 @@ limitations under the License.
 #include <stddef.h>
 #include <stdint.h>
 
-#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <complex>
 #include <cstdio>
 #include <cstdlib>
@@ -54,6 +54,7 @@ limitations under the License.
 #include "tflite/external_cpu_backend_context.h"
 #include "tflite/internal/signature_def.h"
 #include "tflite/interpreter_options.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/portable_type_to_tflitetype.h"
 #include "tflite/profiling/root_profiler.h"
 #include "tflite/profiling/telemetry/c/telemetry_setting_internal.h"
@@ -647,6 +648,19 @@ class Interpreter {
   /// kTfLiteOk.
   TfLiteStatus Cancel();
 
+  /// \warning This is an experimental API and subject to change. \n
+  /// \brief Sets an absolute deadline for subsequent invocations. An
+  /// invocation still running once the deadline has passed stops at the next
+  /// node boundary, or sooner in kernels that check between iterations, and
+  /// returns `kTfLiteCancelled`. The tensors stay allocated, so the interpreter
+  /// can be invoked again right away. Unlike `Cancel`, this doesn't require
+  /// `EnableCancellation`. Thread safe.
+  void SetInvocationDeadline(std::chrono::steady_clock::time_point deadline);
+
+  /// \warning This is an experimental API and subject to change. \n
+  /// \brief Removes the deadline set with `SetInvocationDeadline`.
+  void ClearInvocationDeadline();
+
   /// \brief Allow a delegate to look at the graph and modify the graph to
   /// handle parts of the graph themselves. After this is called, the graph may
   /// contain new nodes that replace 1 more nodes.
@@ -1109,13 +1123,11 @@ class Interpreter {
   // checks when dereferencing by subgraph and operator index) will take place.
   ModelControlDependencies model_control_dependencies_;
 
-  // Flag indicating whether to continue or cancel in flight invocation.
-  // If false, the in flight invocation will be cancelled.
-  // Will be set true when application starts a new invocation.
-  // The flag is shared across all subgraphs in the interpreter.
-  // When the application calls `Cancel`, the flag will be set to false.
-  // It "resets" to true at the beginning of each `Invoke`.
-  std::atomic_flag continue_invocation_ = ATOMIC_FLAG_INIT;
+  // Cancellation flag and deadline of in flight invocations, registered as the
+  // kTfLiteInterruptContext external context so that it is shared across all
+  // subgraphs and visible to kernels. When the application calls `Cancel`, the
+  // flag is raised. It is reset at the beginning of each `Invoke`.
+  InvocationInterrupt invocation_interrupt_;
   bool cancellation_enabled_ = false;
 };
 
@@ -125,8 +125,8 @@ TfLiteStatus SignatureRunner::ResizeInputTensorStrict(
 TfLiteStatus SignatureRunner::Invoke() {
   // "Resets" cancellation flag so cancellation happens before this invoke will
   // not take effect.
-  if (subgraph_->continue_invocation_)
-    (void)subgraph_->continue_invocation_->test_and_set();
+  if (subgraph_->cancellation_interrupt_)
+    subgraph_->cancellation_interrupt_->ResetCancellation();
 
   TF_LITE_ENSURE_STATUS(subgraph_->Invoke());
 
@@ -16,13 +16,14 @@ limitations under the License.
 #include "tflite/core/subgraph.h"
 
 #include <algorithm>
-#include <atomic>
+#include <cmath>
 #include <cstdarg>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -46,10 +47,12 @@ limitations under the License.
 #include "tflite/experimental/resource/initialization_status.h"
 #include "tflite/experimental/resource/resource_base.h"
 #include "tflite/graph_info.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/logger.h"
 #include "tflite/memory_planner.h"
 #include "tflite/minimal_logging.h"
 #include "tflite/profiling/telemetry/telemetry.h"
+#include "tflite/profiling/time.h"
 #include "tflite/schema/schema_generated.h"
 #include "tflite/util.h"
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
@@ -500,6 +503,25 @@ const char* GetDelegateKernalName(const TfLiteRegistration& registration) {
   return "unknown";
 }
 
+// Reports why an invocation stopped early and returns the status to fail it
+// with. The legacy cancellation function keeps failing with kTfLiteError.
+TfLiteStatus ReportInterrupt(TfLiteContext* context,
+                             InvocationInterrupt::Reason reason) {
+  switch (reason) {
+    case InvocationInterrupt::Reason::kDeadlineExceeded:
+      TF_LITE_KERNEL_LOG(context, "Deadline exceeded during Invoke()");
+      return kTfLiteCancelled;
+    case InvocationInterrupt::Reason::kCancellationFunction:
+      TF_LITE_KERNEL_LOG(context, "Client requested cancel during Invoke()");
+      return kTfLiteError;
+    case InvocationInterrupt::Reason::kNone:
+    case InvocationInterrupt::Reason::kCancelled:
+      break;
+  }
+  TF_LITE_KERNEL_LOG(context, "Client requested cancel during Invoke()");
+  return kTfLiteCancelled;
+}
+
 }  // namespace
 
 TfLiteStatus Subgraph::PartitionGraph(const TfLiteIntArray* nodes_to_replace,
@@ -864,6 +886,11 @@ void Subgraph::SetCancellationFunction(void* data,
                                        bool (*check_cancelled_func)(void*)) {
   cancellation_data_ = data;
   check_cancelled_func_ = check_cancelled_func;
+  // Invocations poll the function through the shared interrupt, so that
+  // nothing extra is checked between nodes while none is set.
+  if (InvocationInterrupt* interrupt = InvocationInterrupt::Get(&context_)) {
+    interrupt->SetCancellationFunction(data, check_cancelled_func);
+  }
 }
 
 TfLiteStatus Subgraph::EnsureTensorDataIsReadable(int tensor_index) {
@@ -880,17 +907,16 @@ TfLiteStatus Subgraph::EnsureTensorDataIsReadable(int tensor_index) {
   return status;
 }
 
-TfLiteStatus Subgraph::EnableCancellation(std::atomic_flag* flag) {
-  continue_invocation_ = flag;
+TfLiteStatus Subgraph::EnableCancellation(InvocationInterrupt* interrupt) {
+  cancellation_interrupt_ = interrupt;
   return kTfLiteOk;
 }
 
 TfLiteStatus Subgraph::Cancel() {
-  if (continue_invocation_) {
-    // Sets cancellation flag to false so cancellation check between nodes will
-    // cancel the invocation.
-
-    continue_invocation_->clear();
+  if (cancellation_interrupt_) {
+    // Raises the cancellation flag so the checks between nodes, and within
+    // long running kernels, will cancel the invocation.
+    cancellation_interrupt_->Cancel();
     return kTfLiteOk;
   }
   // Cancellation is not enabled in the interpreter.
@@ -1019,12 +1045,17 @@ TfLiteStatus Subgraph::AllocateTensors(InliningStrategy auto_inline) {
             context(), custom_allocations_, idx));
       }
     }
+    // The inputs may hold data once the tensors are allocated, the reduced
+    // precision storage check runs on them.
+    if (ActivationStorageCheckPending()) return CheckActivationStorage();
     return kTfLiteOk;
   }
 
   // Profile "AllocateTensors" only when memory planning is needed.
   TFLITE_SCOPED_TAGGED_DEFAULT_PROFILE(profiler_.get(), "AllocateTensors");
 
+  TF_LITE_ENSURE_STATUS(ApplyActivationStorage());
+
   next_execution_plan_index_to_prepare_ = 0;
   next_execution_plan_index_to_plan_allocation_ = 0;
   next_original_execution_plan_index_to_prepare_ = 0;
@@ -1593,13 +1624,26 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
 #ifdef TFLITE_USE_SIMPLE_MEMORY_PLANNER
     memory_planner_.reset(new SimplePlanner(&context_, CreateGraphInfo()));
 #else
-    memory_planner_ = std::make_unique<ArenaPlanner>(
+    auto arena_planner = std::make_unique<ArenaPlanner>(
         &context_, CreateGraphInfo(), ShouldPreserveAllTensors(),
         kDefaultTensorAlignment, subgraph_index_);
+    if (options_) {
+      arena_planner->SetPlacement(options_->GetMemoryPlacement());
+    }
+    memory_planner_ = std::move(arena_planner);
 #endif
     memory_planner_->PlanAllocations();
   }
 
+  // Reuse a previously exported memory plan, if any, when planning from the
+  // first node. ImportPlan() only fails for snapshots of a different graph,
+  // in which case allocations are computed as usual.
+  if (has_reusable_memory_plan_ &&
+      next_execution_plan_index_to_plan_allocation_ == 0 &&
+      reusable_memory_plan_execution_plan_ == execution_plan_) {
+    memory_planner_->ImportPlan(reusable_memory_plan_);
+  }
+
   // Execute arena allocations.
   TF_LITE_ENSURE_STATUS(memory_planner_->ExecuteAllocations(
       next_execution_plan_index_to_plan_allocation_,
@@ -1636,6 +1680,301 @@ TfLiteStatus Subgraph::PrepareOpsAndTensors() {
   return kTfLiteOk;
 }
 
+namespace {
+
+// How a kernel deals with float32 activations stored in reduced precision.
+enum class ReducedPrecisionSupport {
+  // Only reads and writes float32.
+  kNone,
+  // Converts each float input and output from and to its storage type.
+  kConverting,
+  // Requires all its float inputs and outputs to have the same storage type.
+  kSameType,
+};
+
+ReducedPrecisionSupport GetReducedPrecisionSupport(
+    const TfLiteRegistration& registration) {
+  // Only the builtin kernels are known to handle reduced precision storage.
+  if (registration.registration_external != nullptr) {
+    return ReducedPrecisionSupport::kNone;
+  }
+  switch (registration.builtin_code) {
+    case kTfLiteBuiltinAdd:
+    case kTfLiteBuiltinMul:
+    case kTfLiteBuiltinSub:
+      return ReducedPrecisionSupport::kConverting;
+    case kTfLiteBuiltinConcatenation:
+    case kTfLiteBuiltinExpandDims:
+    case kTfLiteBuiltinLogistic:
+    case kTfLiteBuiltinReshape:
+    case kTfLiteBuiltinSqueeze:
+    case kTfLiteBuiltinTanh:
+    case kTfLiteBuiltinTranspose:
+      return ReducedPrecisionSupport::kSameType;
+    default:
+      return ReducedPrecisionSupport::kNone;
+  }
+}
+
+TfLiteStatus SetStorageType(TfLiteContext* context, TfLiteTensor* tensor,
+                            TfLiteType type) {
+  tensor->type = type;
+  if (tensor->dims == nullptr) return kTfLiteOk;
+  return tflite::BytesRequired(type, tensor->dims->data, tensor->dims->size,
+                               &tensor->bytes, context);
+}
+
+// Returns the largest difference between `reference` and the data of
+// `tensor`, relative to the largest magnitude in `reference`. Both hold
+// float32 values.
+double MaxRelativeError(const std::vector<char>& reference,
+                        const TfLiteTensor& tensor) {
+  constexpr double kInfinity = std::numeric_limits<double>::infinity();
+  if (reference.size() != tensor.bytes) return kInfinity;
+  const float* expected = reinterpret_cast<const float*>(reference.data());
+  const float* actual = reinterpret_cast<const float*>(tensor.data.raw);
+  double max_magnitude = 0.0;
+  double max_difference = 0.0;
+  for (size_t i = 0; i < tensor.bytes / sizeof(float); ++i) {
+    if (std::isnan(expected[i]) != std::isnan(actual[i])) return kInfinity;
+    if (std::isnan(expected[i]) || expected[i] == actual[i]) continue;
+    const double difference =
+        std::fabs(static_cast<double>(actual[i]) - expected[i]);
+    if (!std::isfinite(difference)) return kInfinity;
+    max_magnitude =
+        std::max(max_magnitude, std::fabs(static_cast<double>(expected[i])));
+    max_difference = std::max(max_difference, difference);
+  }
+  if (max_difference == 0.0) return 0.0;
+  return max_magnitude > 0.0 ? max_difference / max_magnitude : kInfinity;
+}
+
+}  // namespace
+
+TfLiteType Subgraph::ActivationStorageType() const {
+  if (options_ == nullptr || ShouldPreserveAllTensors()) {
+    return kTfLiteFloat32;
+  }
+  // With a tolerance, reduced precision storage waits for the check to accept
+  // it.
+  if (options_->GetActivationStorageTolerance() > 0 &&
+      !activation_storage_report_.accepted &&
+      !activation_storage_check_running_) {
+    return kTfLiteFloat32;
+  }
+  return options_->GetActivationStorageType();
+}
+
+bool Subgraph::ActivationStorageCheckPending() const {
+  return options_ != nullptr &&
+         options_->GetActivationStorageTolerance() > 0 &&
+         options_->GetActivationStorageType() != kTfLiteFloat32 &&
+         !activation_storage_report_.checked && !ShouldPreserveAllTensors();
+}
+
+std::vector<int> Subgraph::FindReducedPrecisionCandidates() const {
+  const int num_tensors = tensors_.size();
+  // Tensors read or written by a kernel without reduced precision support.
+  std::vector<bool> excluded(num_tensors, false);
+  std::vector<int> num_producers(num_tensors, 0);
+  // Tensors tied to each other by kSameType nodes form a group, which can
+  // only be stored in reduced precision as a whole.
+  std::vector<int> group(num_tensors);
+  std::iota(group.begin(), group.end(), 0);
+  auto find_group = [&group](int t) {
+    while (group[t] != t) {
+      group[t] = group[group[t]];
+      t = group[t];
+    }
+    return t;
+  };
+
+  for (const std::vector<int>* indices : {&inputs_, &outputs_, &variables_}) {
+    for (int t : *indices) {
+      if (t != kTfLiteOptionalTensor) excluded[t] = true;
+    }
+  }
+  for (const auto& idx_and_alloc : custom_allocations_) {
+    excluded[idx_and_alloc.first] = true;
+  }
+
+  for (int node_index : execution_plan_) {
+    const TfLiteNode& node = nodes_and_registration_[node_index].first;
+    const ReducedPrecisionSupport support =
+        GetReducedPrecisionSupport(nodes_and_registration_[node_index].second);
+    int first_float = kTfLiteOptionalTensor;
+    auto visit = [&](int t) {
+      if (t == kTfLiteOptionalTensor) return;
+      if (support == ReducedPrecisionSupport::kNone) {
+        excluded[t] = true;
+      } else if (support == ReducedPrecisionSupport::kSameType &&
+                 tensors_[t].type == kTfLiteFloat32) {
+        if (first_float == kTfLiteOptionalTensor) {
+          first_float = t;
+        } else {
+          group[find_group(t)] = find_group(first_float);
+        }
+      }
+    };
+    for (int t : TfLiteIntArrayView(node.inputs)) visit(t);
+    for (int t : TfLiteIntArrayView(node.outputs)) {
+      visit(t);
+      if (t != kTfLiteOptionalTensor) ++num_producers[t];
+    }
+    for (const TfLiteIntArray* indices :
+         {node.intermediates, node.temporaries}) {
+      if (indices == nullptr) continue;
+      for (int t : TfLiteIntArrayView(indices)) {
+        if (t != kTfLiteOptionalTensor) excluded[t] = true;
+      }
+    }
+  }
+
+  auto is_candidate = [&](int t) {
+    const TfLiteTensor& tensor = tensors_[t];
+    return !excluded[t] && num_producers[t] == 1 &&
+           tensor.type == kTfLiteFloat32 &&
+           tensor.allocation_type == kTfLiteArenaRw &&
+           tensor.buffer_handle == kTfLiteNullBufferHandle;
+  };
+  std::vector<bool> group_eligible(num_tensors, true);
+  for (int t = 0; t < num_tensors; ++t) {
+    if (tensors_[t].type == kTfLiteFloat32 && !is_candidate(t)) {
+      group_eligible[find_group(t)] = false;
+    }
+  }
+  std::vector<int> candidates;
+  for (int t = 0; t < num_tensors; ++t) {
+    if (is_candidate(t) && group_eligible[find_group(t)]) {
+      candidates.push_back(t);
+    }
+  }
+  return candidates;
+}
+
+TfLiteStatus Subgraph::RestoreDeclaredActivationStorage() {
+  for (int t : reduced_precision_tensors_) {
+    TF_LITE_ENSURE_STATUS(SetStorageType(&context_, tensor(t), kTfLiteFloat32));
+  }
+  reduced_precision_tensors_.clear();
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::ApplyActivationStorage() {
+  const TfLiteType storage_type = ActivationStorageType();
+  if (storage_type == kTfLiteFloat32 && reduced_precision_tensors_.empty()) {
+    return kTfLiteOk;
+  }
+  const std::vector<int> previous_tensors = reduced_precision_tensors_;
+  const TfLiteType previous_type = previous_tensors.empty()
+                                       ? kTfLiteFloat32
+                                       : tensor(previous_tensors[0])->type;
+  TF_LITE_ENSURE_STATUS(RestoreDeclaredActivationStorage());
+  if (storage_type != kTfLiteFloat32) {
+    reduced_precision_tensors_ = FindReducedPrecisionCandidates();
+    for (int t : reduced_precision_tensors_) {
+      TF_LITE_ENSURE_STATUS(SetStorageType(&context_, tensor(t), storage_type));
+    }
+  }
+  if (reduced_precision_tensors_ == previous_tensors &&
+      (previous_tensors.empty() || previous_type == storage_type)) {
+    return kTfLiteOk;
+  }
+  // The planner decides which tensors share memory from their sizes.
+  if (memory_planner_) {
+    TF_LITE_ENSURE_STATUS(memory_planner_->PlanAllocations());
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::CheckActivationStorage() {
+  ActivationStorageReport& report = activation_storage_report_;
+  // The nested allocations below must not run the check again.
+  report.checked = true;
+  if (FindReducedPrecisionCandidates().empty()) return kTfLiteOk;
+
+  auto copy_data = [this](const std::vector<int>& indices) {
+    std::vector<std::vector<char>> copies(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (indices[i] == kTfLiteOptionalTensor) continue;
+      const TfLiteTensor* t = tensor(indices[i]);
+      if (t->data.raw != nullptr) {
+        copies[i].assign(t->data.raw, t->data.raw + t->bytes);
+      }
+    }
+    return copies;
+  };
+  auto restore_data = [this](const std::vector<int>& indices,
+                              const std::vector<std::vector<char>>& copies) {
+    for (size_t i = 0; i < indices.size(); ++i) {
+      if (copies[i].empty()) continue;
+      TfLiteTensor* t = tensor(indices[i]);
+      TF_LITE_ENSURE(&context_, t->bytes == copies[i].size());
+      std::memcpy(t->data.raw, copies[i].data(), t->bytes);
+    }
+    return kTfLiteOk;
+  };
+  auto timed_invoke = [this](int64_t* elapsed_us) {
+    const uint64_t start_us = profiling::time::NowMicros();
+    TF_LITE_ENSURE_STATUS(InvokeImpl(0, execution_plan_.size()));
+    *elapsed_us = profiling::time::NowMicros() - start_us;
+    return kTfLiteOk;
+  };
+
+  // Re-allocating moves the inputs and resets the variables, so their data is
+  // kept aside and restored before the second run and at the end.
+  const auto inputs = copy_data(inputs_);
+  const auto variables = copy_data(variables_);
+  SubgraphAllocInfo alloc_info;
+
+  GetMemoryAllocInfo(&alloc_info);
+  report.declared_arena_bytes = alloc_info.arena_size;
+  TF_LITE_ENSURE_STATUS(timed_invoke(&report.declared_invoke_us));
+  const auto declared_outputs = copy_data(outputs_);
+
+  activation_storage_check_running_ = true;
+  state_ = kStateUninvokable;
+  const TfLiteStatus status = AllocateTensors();
+  activation_storage_check_running_ = false;
+  TF_LITE_ENSURE_STATUS(status);
+  report.num_reduced_tensors =
+      static_cast<int>(reduced_precision_tensors_.size());
+  TF_LITE_ENSURE_STATUS(restore_data(inputs_, inputs));
+  TF_LITE_ENSURE_STATUS(restore_data(variables_, variables));
+  GetMemoryAllocInfo(&alloc_info);
+  report.reduced_arena_bytes = alloc_info.arena_size;
+  TF_LITE_ENSURE_STATUS(timed_invoke(&report.reduced_invoke_us));
+
+  report.max_relative_error = 0.0;
+  for (size_t i = 0; i < outputs_.size(); ++i) {
+    if (outputs_[i] == kTfLiteOptionalTensor) continue;
+    const TfLiteTensor& output = *tensor(outputs_[i]);
+    if (output.type != kTfLiteFloat32 || output.data.raw == nullptr) continue;
+    report.max_relative_error =
+        std::max(report.max_relative_error,
+                 MaxRelativeError(declared_outputs[i], output));
+  }
+  report.accepted = report.max_relative_error <=
+                    options_->GetActivationStorageTolerance();
+  TFLITE_LOG_PROD(
+      tflite::TFLITE_LOG_INFO,
+      "%s %s activation storage in subgraph %d: %d tensors, max relative "
+      "error %g, arena %zu -> %zu bytes, invoke %lld -> %lld us.",
+      report.accepted ? "Keeping" : "Rejecting",
+      TfLiteTypeGetName(options_->GetActivationStorageType()),
+      subgraph_index_, report.num_reduced_tensors, report.max_relative_error,
+      report.declared_arena_bytes, report.reduced_arena_bytes,
+      static_cast<long long>(report.declared_invoke_us),  // NOLINT
+      static_cast<long long>(report.reduced_invoke_us));  // NOLINT
+
+  if (!report.accepted) {
+    state_ = kStateUninvokable;
+    TF_LITE_ENSURE_STATUS(AllocateTensors());
+  }
+  TF_LITE_ENSURE_STATUS(restore_data(inputs_, inputs));
+  return restore_data(variables_, variables);
+}
+
 TfLiteStatus Subgraph::RemoveUnusedInputs() {
   std::vector<int> input_tensors_count = GetInputTensorsCount();
   // Mark unused inputs as kTfLiteOptionalTensor.
@@ -1650,11 +1989,30 @@ TfLiteStatus Subgraph::RemoveUnusedInputs() {
 }
 
 TfLiteStatus Subgraph::Invoke() {
-  auto status = InvokeImpl();
+  auto status = InvokeImpl(0, execution_plan_.size());
   telemetry::TelemetryReportEvent(&context_, "Invoke", status);
   return status;
 }
-TfLiteStatus Subgraph::InvokeImpl() {
+
+TfLiteStatus Subgraph::InvokeExecutionPlanRange(int begin, int end) {
+  if (begin < 0 || begin > end || end > execution_plan_.size()) {
+    ReportError("Invalid execution plan range [%d, %d).", begin, end);
+    return kTfLiteError;
+  }
+  // Preparing ops or resizing tensors midway would change the memory plan
+  // underneath the ranges that have already run.
+  if (state_ == kStateUninvokable ||
+      next_execution_plan_index_to_prepare_ < execution_plan_.size() ||
+      HasDynamicTensors()) {
+    ReportError(
+        "Partial invocations require all ops to be prepared and static "
+        "tensor shapes.");
+    return kTfLiteError;
+  }
+  return InvokeImpl(begin, end);
+}
+
+TfLiteStatus Subgraph::InvokeImpl(int begin, int end) {
   if (!consistent_) {
     ReportError("Invoke called on model that is not consistent.");
     return kTfLiteError;
@@ -1674,12 +2032,17 @@ TfLiteStatus Subgraph::InvokeImpl() {
       tflite::OnTfLiteSubgraphInvoke(name_.c_str(), subgraph_index_);
 #endif  // TF_LITE_TENSORFLOW_PROFILER
 
+  // Looked up once, so the per node check is a single relaxed load while the
+  // invocation can't be stopped.
+  InvocationInterrupt* interrupt = InvocationInterrupt::Get(&context_);
+  if (interrupt) interrupt->ResetIncomplete();
+
   // Invocations are always done in node order.
   // Note that calling Invoke repeatedly will cause the original memory plan to
   // be reused, unless either ResizeInputTensor() or AllocateTensors() has been
   // called.
-  for (int execution_plan_index = 0;
-       execution_plan_index < execution_plan_.size(); execution_plan_index++) {
+  for (int execution_plan_index = begin; execution_plan_index < end;
+       execution_plan_index++) {
     if (execution_plan_index == next_execution_plan_index_to_prepare_) {
       TF_LITE_ENSURE_STATUS(PrepareOpsAndTensors());
       TF_LITE_ENSURE(&context_, next_execution_plan_index_to_prepare_ >=
@@ -1744,21 +2107,26 @@ TfLiteStatus Subgraph::InvokeImpl() {
     // before executing the node.
     MayAllocateOpOutput(&node);
 
-    if (check_cancelled_func_ != nullptr &&
-        check_cancelled_func_(cancellation_data_)) {
+    // Stopping between nodes leaves every allocation in place, so the
+    // subgraph can be invoked again without re-allocating.
+    if (interrupt) {
+      if (const InvocationInterrupt::Reason reason = interrupt->StopReason();
+          reason != InvocationInterrupt::Reason::kNone) {
+        return ReportInterrupt(&context_, reason);
+      }
+    } else if (IsCancelled()) {
       ReportError("Client requested cancel during Invoke()");
       return kTfLiteError;
     }
 
-    if (continue_invocation_ && !continue_invocation_->test_and_set()) {
-      // `Cancel` is called and cancellation flag is flipped.
-      ReportError("Client requested cancel during Invoke()");
-      return kTfLiteCancelled;
-    }
-
     EnsureTensorsVectorCapacity();
     tensor_resized_since_op_invoke_ = false;
     if (auto s = OpInvoke(registration, &node); s != kTfLiteOk) {
+      // Kernels that stop part way through (e.g. WHILE) fail the invocation
+      // the same way as stopping between nodes does.
+      if (s == kTfLiteCancelled && interrupt) {
+        return ReportInterrupt(&context_, interrupt->StopReason());
+      }
       auto err = ReportOpError(&context_, node, registration, node_index,
                                "failed to invoke");
       return s == kTfLiteCancelled ? s : err;
@@ -1793,6 +2161,12 @@ TfLiteStatus Subgraph::InvokeImpl() {
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   tflite::OnTfLiteSubgraphInvokeEnd(trace_subgraph);
 #endif  // TF_LITE_TENSORFLOW_PROFILER
+  // Kernels that check the interrupt part way through may have left their
+  // outputs incomplete without failing, e.g. a GEMM split into chunks. A stop
+  // requested after the last node ran to completion isn't reported.
+  if (interrupt && interrupt->Incomplete()) {
+    return ReportInterrupt(&context_, interrupt->StopReason());
+  }
   return status;
 }
 
@@ -2467,6 +2841,20 @@ TfLiteStatus Subgraph::EnsureMemoryAllocations() {
   return kTfLiteOk;
 }
 
+TfLiteStatus Subgraph::ExportMemoryPlan(MemoryPlanSnapshot* snapshot) const {
+  if (memory_planner_ == nullptr || state_ == kStateUninvokable) {
+    return kTfLiteError;
+  }
+  return memory_planner_->ExportPlan(snapshot);
+}
+
+void Subgraph::SetMemoryPlanToReuse(std::vector<int> execution_plan,
+                                    MemoryPlanSnapshot snapshot) {
+  has_reusable_memory_plan_ = true;
+  reusable_memory_plan_execution_plan_ = std::move(execution_plan);
+  reusable_memory_plan_ = std::move(snapshot);
+}
+
 TfLiteStatus Subgraph::ModifyGraphWithDelegate(TfLiteDelegate* delegate) {
   auto status = ModifyGraphWithDelegateImpl(delegate);
   telemetry::TelemetryReportEvent(&context_, "ModifyGraphWithDelegate", status);
@@ -2501,6 +2889,17 @@ TfLiteStatus Subgraph::ModifyGraphWithDelegateImpl(TfLiteDelegate* delegate) {
   // Restore delegation state if applicable.
   TF_LITE_ENSURE_STATUS(RedoAllDelegates());
 
+  // Delegates are shown the declared tensor types. Reduced precision storage
+  // is derived again for the nodes left to the CPU kernels when tensors are
+  // allocated next.
+  if (!reduced_precision_tensors_.empty()) {
+    TF_LITE_ENSURE_STATUS(RestoreDeclaredActivationStorage());
+    if (memory_planner_) {
+      TF_LITE_ENSURE_STATUS(memory_planner_->PlanAllocations());
+    }
+    state_ = kStateUninvokable;
+  }
+
   int64_t delegate_flags = TfLiteDelegateGetFlagsInternal(delegate);
   const bool delegate_supports_dynamic_shapes =
       delegate_flags & kTfLiteDelegateFlagsAllowDynamicTensors;
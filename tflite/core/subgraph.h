@@ -18,7 +18,6 @@ limitations under the License.
 #include <stdarg.h>
 #include <stddef.h>
 
-#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -41,6 +40,7 @@ limitations under the License.
 #include "tflite/experimental/resource/resource_base.h"
 #include "tflite/graph_info.h"
 #include "tflite/interpreter_options.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/memory_planner.h"
 #include "tflite/util.h"
 
@@ -341,6 +341,15 @@ class Subgraph {
   // Returns status of success or failure.
   TfLiteStatus Invoke();
 
+  // WARNING: Experimental interface, subject to change.
+  // Invokes only the nodes at execution plan indices [begin, end). This lets a
+  // runtime interleave the partial invocations of consecutive inferences, e.g.
+  // to run the CPU ops of one inference while a delegate kernel of another
+  // inference waits for its accelerator. All ops must have been prepared by
+  // AllocateTensors() and the subgraph must not have dynamic tensors. The
+  // caller is responsible for the data dependencies between the ranges.
+  TfLiteStatus InvokeExecutionPlanRange(int begin, int end);
+
   // Entry point for C node plugin API to report an error.
   void ReportError(const char* format, ...);
 
@@ -475,6 +484,53 @@ class Subgraph {
   // Returns memory allocation status.
   void GetMemoryAllocInfo(SubgraphAllocInfo* alloc_info) const;
 
+  // WARNING: This is an experimental API and subject to change.
+  // Exports the arena placements computed by the last AllocateTensors() call.
+  // Returns kTfLiteError if tensors were not allocated yet, or the memory
+  // planner doesn't support snapshots.
+  TfLiteStatus ExportMemoryPlan(MemoryPlanSnapshot* snapshot) const;
+
+  // WARNING: This is an experimental API and subject to change.
+  // Makes subsequent AllocateTensors() calls reuse the arena placements of
+  // `snapshot` instead of computing them, as long as the execution plan is
+  // `execution_plan` and tensor sizes match the ones the snapshot was taken
+  // with. Tensors that don't match are planned as usual.
+  void SetMemoryPlanToReuse(std::vector<int> execution_plan,
+                            MemoryPlanSnapshot snapshot);
+
+  // WARNING: This is an experimental API and subject to change.
+  // Outcome of the check of reduced precision activation storage, see
+  // InterpreterOptions::SetActivationStorageTolerance().
+  struct ActivationStorageReport {
+    // True once the check has run.
+    bool checked = false;
+    // True if reduced precision storage was kept.
+    bool accepted = false;
+    // Number of activations stored in reduced precision during the check.
+    int num_reduced_tensors = 0;
+    // Largest difference between the float outputs of the two runs, relative
+    // to the largest magnitude of the respective float32 output.
+    double max_relative_error = 0.0;
+    // Arena sizes and Invoke() latencies with declared and reduced precision
+    // storage.
+    size_t declared_arena_bytes = 0;
+    size_t reduced_arena_bytes = 0;
+    int64_t declared_invoke_us = 0;
+    int64_t reduced_invoke_us = 0;
+  };
+
+  // WARNING: This is an experimental API and subject to change.
+  const ActivationStorageReport& activation_storage_report() const {
+    return activation_storage_report_;
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // Returns the indices of the float32 tensors currently stored in
+  // InterpreterOptions::GetActivationStorageType().
+  const std::vector<int>& reduced_precision_tensors() const {
+    return reduced_precision_tensors_;
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // Set the given `InterpreterOptions` object.
   void SetOptions(InterpreterOptions* options) {
@@ -502,6 +558,18 @@ class Subgraph {
     return (options_ && options_->GetEnsureDynamicTensorsAreReleased());
   }
 
+  // WARNING: This is an experimental API and subject to change.
+  // True if control flow ops should keep the memory of the subgraphs they
+  // invoke allocated between invocations.
+  bool ShouldKeepControlFlowSubgraphsResident() const {
+    return (options_ && options_->GetKeepControlFlowSubgraphsResident());
+  }
+
+  // WARNING: This is an experimental API and subject to change.
+  // True if memory has been planned and allocated, i.e. the subgraph can be
+  // invoked without calling AllocateTensors() first.
+  bool IsInvokable() const { return state_ != kStateUninvokable; }
+
   /// WARNING: This is an experimental API and subject to change.
   /// Use dynamic tensor allocation and deallocation method for large tensors
   /// instead of static memory planner. Dynamic tensors are allocated just
@@ -781,9 +849,35 @@ class Subgraph {
                                              const int* output_indices,
                                              int num_outputs);
 
-  // Invoke the subgraph (run the whole graph in dependency order).
+  // Invoke the nodes at execution plan indices [begin, end) in order.
   // Does not report invoke status through profiler.
-  TfLiteStatus InvokeImpl();
+  TfLiteStatus InvokeImpl(int begin, int end);
+
+  // Returns the type eligible float32 activations are currently stored in.
+  TfLiteType ActivationStorageType() const;
+
+  // Returns the float32 activations that are only read and written by kernels
+  // able to store them in reduced precision.
+  std::vector<int> FindReducedPrecisionCandidates() const;
+
+  // Changes the type of the activations stored in reduced precision according
+  // to ActivationStorageType(), and re-plans the arena if that changed
+  // tensor sizes. Called before preparing the nodes.
+  TfLiteStatus ApplyActivationStorage();
+
+  // Stores all activations in their declared type again.
+  TfLiteStatus RestoreDeclaredActivationStorage();
+
+  // Returns true if the reduced precision storage check is enabled and hasn't
+  // run yet.
+  bool ActivationStorageCheckPending() const;
+
+  // Runs the whole execution plan on the current inputs with declared and
+  // reduced precision storage, and keeps the latter only if the outputs are
+  // close enough. Leaves the tensors allocated for the chosen storage, with
+  // the data of the inputs and variables restored. Fills in
+  // activation_storage_report_.
+  TfLiteStatus CheckActivationStorage();
 
   // Allow a delegate to look at the graph and modify the graph to handle
   // parts of the graph themselves. After this is called, the graph may
@@ -965,8 +1059,9 @@ class Subgraph {
 
   // Enables cancellation of in flight invocation with `Cancel` call.
   // Should only be called by the interpreter when building the subgraph.
-  // `flag` should be nullptr otherwise cancellation is disabled.
-  TfLiteStatus EnableCancellation(std::atomic_flag* flag);
+  // `interrupt` should be the interpreter's kTfLiteInterruptContext, or
+  // nullptr to disable cancellation.
+  TfLiteStatus EnableCancellation(InvocationInterrupt* interrupt);
 
   // Attempts to cancel in flight invocation if any.
   // This will not affect `Invoke`s that happen after the cancellation.
@@ -1151,9 +1246,23 @@ class Subgraph {
 
   std::unique_ptr<MemoryPlanner> memory_planner_;
 
+  // Memory plan set with SetMemoryPlanToReuse() and the execution plan it
+  // was computed for.
+  bool has_reusable_memory_plan_ = false;
+  std::vector<int> reusable_memory_plan_execution_plan_;
+  MemoryPlanSnapshot reusable_memory_plan_;
+
   // Maps tensor index to custom allocation for all applicable tensors.
   std::map<int, TfLiteCustomAllocation> custom_allocations_;
 
+  // Float32 activations currently stored in ActivationStorageType().
+  std::vector<int> reduced_precision_tensors_;
+
+  // True while the check allocates the tensors for reduced precision storage.
+  bool activation_storage_check_running_ = false;
+
+  ActivationStorageReport activation_storage_report_;
+
   // Tracking bit for whether a tensor was resized in the course of an op
   // invocation. This is a useful hint to ensure that dynamic tensor outputs
   // trigger downstream reallocation after op invocation.
@@ -1182,15 +1291,17 @@ class Subgraph {
 
   // Reference to cancellation function that can cancel a request in the middle
   // of a call to Invoke(). When this function returns True, a kTfLiteError is
-  // thrown by Invoke().
+  // thrown by Invoke(). It is polled through the interpreter's interrupt when
+  // there is one.
   bool (*check_cancelled_func_)(void*) = nullptr;
 
-  // Pointer to the cancellation flag owned by the interpreter.
-  // If null, it means cancellation is not enabled.
-  // If not null, in flight invocation will be cancelled if the flag is false.
-  // The flag will be reset to true in the beginning of every `Invoke` call
-  // so cancellation hapens before will not cancel subsequent invocations.
-  std::atomic_flag* continue_invocation_ = nullptr;
+  // Pointer to the interrupt owned by the interpreter, which `Cancel` raises.
+  // If null, it means cancellation is not enabled. The interrupt is reset in
+  // the beginning of every `Invoke` call so cancellation that happens before
+  // will not cancel subsequent invocations. In flight invocations check the
+  // kTfLiteInterruptContext external context instead, which is the same object
+  // and is also consulted for deadlines when cancellation is not enabled.
+  InvocationInterrupt* cancellation_interrupt_ = nullptr;
 
   // Reference to data used by the cancellation function in
   // `check_cancelled_func_`.
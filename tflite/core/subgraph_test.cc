@@ -124,6 +124,34 @@ TEST(MarkSubgraphAsDelegationSkippable, MarkSubgraphAsDelegationSkippable) {
   ASSERT_TRUE(subgraphs[1]->IsDelegationSkippable());
 }
 
+TEST(InvokeExecutionPlanRange, InvokesOnlyTheGivenNodes) {
+  Interpreter interpreter;
+  auto& subgraph = interpreter.primary_subgraph();
+  subgraph.AddTensors(3);
+  subgraph.SetInputs({0});
+  subgraph.SetOutputs({2});
+  for (int i = 0; i < 3; ++i) {
+    subgraph.SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {1}, {});
+  }
+  TfLiteRegistration* neg_op = tflite::ops::builtin::Register_NEG();
+  subgraph.AddNodeWithParameters({0}, {1}, {}, nullptr, 0, nullptr, neg_op);
+  subgraph.AddNodeWithParameters({1}, {2}, {}, nullptr, 0, nullptr, neg_op);
+
+  // Ops must be prepared first.
+  EXPECT_EQ(subgraph.InvokeExecutionPlanRange(0, 1), kTfLiteError);
+  ASSERT_EQ(subgraph.AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(subgraph.InvokeExecutionPlanRange(1, 0), kTfLiteError);
+  EXPECT_EQ(subgraph.InvokeExecutionPlanRange(0, 3), kTfLiteError);
+
+  subgraph.tensor(0)->data.f[0] = 3.0f;
+  subgraph.tensor(2)->data.f[0] = 0.0f;
+  ASSERT_EQ(subgraph.InvokeExecutionPlanRange(0, 1), kTfLiteOk);
+  EXPECT_EQ(subgraph.tensor(1)->data.f[0], -3.0f);
+  EXPECT_EQ(subgraph.tensor(2)->data.f[0], 0.0f);
+  ASSERT_EQ(subgraph.InvokeExecutionPlanRange(1, 2), kTfLiteOk);
+  EXPECT_EQ(subgraph.tensor(2)->data.f[0], 3.0f);
+}
+
 // Helper to get the minimal buffer size to allocate for a buffer of given
 // shape.
 size_t BytesFor(const TfLiteType type, const int* const data,
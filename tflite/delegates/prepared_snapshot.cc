@@ -0,0 +1,252 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/prepared_snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/delegates/serialization.h"
+#include "tflite/memory_planner.h"
+#include "tflite/minimal_logging.h"
+#include <farmhash.h>
+
+namespace tflite {
+namespace delegates {
+namespace {
+
+// "TFPS" in little endian.
+constexpr uint32_t kSnapshotMagic = 0x53504654;
+// Bump whenever the layout below changes.
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr char kSnapshotKeyPrefix[] = "prepared_snapshot";
+
+// Snapshots are only ever read back on the device that wrote them, so values
+// are stored in native byte order.
+class Writer {
+ public:
+  template <typename T>
+  void Write(T value) {
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void WriteVector(const std::vector<int>& values) {
+    Write<uint32_t>(values.size());
+    for (int value : values) Write<int32_t>(value);
+  }
+
+  std::string Finish() {
+    const uint64_t checksum = ::util::Fingerprint64(data_.data(), data_.size());
+    Write(checksum);
+    return std::move(data_);
+  }
+
+ private:
+  std::string data_;
+};
+
+class Reader {
+ public:
+  Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool Read(T* value) {
+    if (size_ - pos_ < sizeof(T)) return false;
+    std::memcpy(value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool ReadVector(std::vector<int>* values) {
+    uint32_t size;
+    if (!Read(&size) || size > (size_ - pos_) / sizeof(int32_t)) return false;
+    values->resize(size);
+    for (int& value : *values) {
+      int32_t v;
+      Read(&v);
+      value = v;
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+};
+
+bool ReadAllocation(Reader* reader, PlannedAllocation* alloc) {
+  uint8_t persistent;
+  uint64_t offset, size;
+  if (!reader->Read(&alloc->tensor) || !reader->Read(&persistent) ||
+      !reader->Read(&offset) || !reader->Read(&size) ||
+      !reader->Read(&alloc->first_node) || !reader->Read(&alloc->last_node)) {
+    return false;
+  }
+  alloc->persistent = persistent != 0;
+  alloc->offset = offset;
+  alloc->size = size;
+  return true;
+}
+
+}  // namespace
+
+TfLiteStatus CapturePreparedSnapshot(const Interpreter& interpreter,
+                                     PreparedModelSnapshot* snapshot) {
+  if (snapshot == nullptr) return kTfLiteError;
+  std::vector<PreparedSubgraphSnapshot> subgraphs(interpreter.subgraphs_size());
+  for (int i = 0; i < subgraphs.size(); ++i) {
+    const Subgraph& subgraph = *interpreter.subgraph(i);
+    // Subgraphs of control flow ops are only allocated when first invoked,
+    // leave their plans empty so that they are planned as usual.
+    if (subgraph.ExportMemoryPlan(&subgraphs[i].memory_plan) != kTfLiteOk) {
+      continue;
+    }
+    subgraphs[i].num_tensors = subgraph.tensors_size();
+    subgraphs[i].execution_plan = subgraph.execution_plan();
+  }
+  snapshot->subgraphs = std::move(subgraphs);
+  return kTfLiteOk;
+}
+
+TfLiteStatus ApplyPreparedSnapshot(const PreparedModelSnapshot& snapshot,
+                                   Interpreter* interpreter) {
+  if (interpreter == nullptr) return kTfLiteError;
+  if (snapshot.subgraphs.size() != interpreter->subgraphs_size()) {
+    TFLITE_LOG(TFLITE_LOG_WARNING,
+               "Prepared snapshot has %d subgraphs, the model has %d.",
+               static_cast<int>(snapshot.subgraphs.size()),
+               static_cast<int>(interpreter->subgraphs_size()));
+    return kTfLiteError;
+  }
+  for (int i = 0; i < snapshot.subgraphs.size(); ++i) {
+    const PreparedSubgraphSnapshot& prepared = snapshot.subgraphs[i];
+    // Tensors may only be added, e.g. by delegates, during preparation.
+    if (prepared.num_tensors < interpreter->subgraph(i)->tensors_size()) {
+      return kTfLiteError;
+    }
+  }
+  for (int i = 0; i < snapshot.subgraphs.size(); ++i) {
+    const PreparedSubgraphSnapshot& prepared = snapshot.subgraphs[i];
+    if (prepared.memory_plan.allocations.empty()) continue;
+    interpreter->subgraph(i)->SetMemoryPlanToReuse(prepared.execution_plan,
+                                                   prepared.memory_plan);
+  }
+  return kTfLiteOk;
+}
+
+std::string SerializePreparedSnapshot(const PreparedModelSnapshot& snapshot) {
+  Writer writer;
+  writer.Write(kSnapshotMagic);
+  writer.Write(kSnapshotVersion);
+  writer.Write<uint32_t>(snapshot.subgraphs.size());
+  for (const PreparedSubgraphSnapshot& subgraph : snapshot.subgraphs) {
+    writer.Write<int32_t>(subgraph.num_tensors);
+    writer.WriteVector(subgraph.execution_plan);
+    const auto& allocations = subgraph.memory_plan.allocations;
+    writer.Write<uint32_t>(allocations.size());
+    for (const PlannedAllocation& alloc : allocations) {
+      writer.Write<int32_t>(alloc.tensor);
+      writer.Write<uint8_t>(alloc.persistent);
+      writer.Write<uint64_t>(alloc.offset);
+      writer.Write<uint64_t>(alloc.size);
+      writer.Write<int32_t>(alloc.first_node);
+      writer.Write<int32_t>(alloc.last_node);
+    }
+  }
+  return writer.Finish();
+}
+
+TfLiteStatus DeserializePreparedSnapshot(const std::string& data,
+                                         PreparedModelSnapshot* snapshot) {
+  if (snapshot == nullptr) return kTfLiteError;
+  if (data.size() < sizeof(uint64_t)) return kTfLiteDelegateDataReadError;
+  const size_t payload_size = data.size() - sizeof(uint64_t);
+  uint64_t checksum;
+  std::memcpy(&checksum, data.data() + payload_size, sizeof(checksum));
+  if (checksum != ::util::Fingerprint64(data.data(), payload_size)) {
+    TFLITE_LOG(TFLITE_LOG_WARNING, "Prepared snapshot checksum mismatch.");
+    return kTfLiteDelegateDataReadError;
+  }
+
+  Reader reader(data.data(), payload_size);
+  uint32_t magic, version, num_subgraphs;
+  if (!reader.Read(&magic) || magic != kSnapshotMagic ||
+      !reader.Read(&version) || version != kSnapshotVersion ||
+      !reader.Read(&num_subgraphs)) {
+    return kTfLiteDelegateDataReadError;
+  }
+  // Each subgraph takes at least 12 bytes, don't trust the count blindly.
+  if (num_subgraphs > payload_size / 12) return kTfLiteDelegateDataReadError;
+  std::vector<PreparedSubgraphSnapshot> subgraphs(num_subgraphs);
+  for (PreparedSubgraphSnapshot& subgraph : subgraphs) {
+    uint32_t num_allocations;
+    if (!reader.Read(&subgraph.num_tensors) ||
+        !reader.ReadVector(&subgraph.execution_plan) ||
+        !reader.Read(&num_allocations) ||
+        num_allocations > payload_size / sizeof(PlannedAllocation)) {
+      return kTfLiteDelegateDataReadError;
+    }
+    subgraph.memory_plan.allocations.resize(num_allocations);
+    for (PlannedAllocation& alloc : subgraph.memory_plan.allocations) {
+      if (!ReadAllocation(&reader, &alloc)) {
+        return kTfLiteDelegateDataReadError;
+      }
+    }
+  }
+  if (!reader.AtEnd()) return kTfLiteDelegateDataReadError;
+  snapshot->subgraphs = std::move(subgraphs);
+  return kTfLiteOk;
+}
+
+TfLiteStatus SavePreparedSnapshot(Serialization* serialization,
+                                  const std::string& options_key,
+                                  Interpreter* interpreter) {
+  if (serialization == nullptr || interpreter == nullptr) return kTfLiteError;
+  PreparedModelSnapshot snapshot;
+  TF_LITE_ENSURE_STATUS(CapturePreparedSnapshot(*interpreter, &snapshot));
+  const std::string data = SerializePreparedSnapshot(snapshot);
+  // The entry must not depend on the context: tensor sizes differ before and
+  // after AllocateTensors().
+  auto entry = serialization->GetEntryForDelegate(
+      kSnapshotKeyPrefix + options_key, /*context=*/nullptr);
+  return entry.SetData(interpreter->primary_subgraph().context(), data.data(),
+                       data.size());
+}
+
+TfLiteStatus LoadPreparedSnapshot(Serialization* serialization,
+                                  const std::string& options_key,
+                                  Interpreter* interpreter) {
+  if (serialization == nullptr || interpreter == nullptr) return kTfLiteError;
+  auto entry = serialization->GetEntryForDelegate(
+      kSnapshotKeyPrefix + options_key, /*context=*/nullptr);
+  std::string data;
+  TF_LITE_ENSURE_STATUS(
+      entry.GetData(interpreter->primary_subgraph().context(), &data));
+  PreparedModelSnapshot snapshot;
+  TF_LITE_ENSURE_STATUS(DeserializePreparedSnapshot(data, &snapshot));
+  return ApplyPreparedSnapshot(snapshot, interpreter);
+}
+
+}  // namespace delegates
+}  // namespace tflite
@@ -0,0 +1,113 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_DELEGATES_PREPARED_SNAPSHOT_H_
+#define TENSORFLOW_LITE_DELEGATES_PREPARED_SNAPSHOT_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/delegates/serialization.h"
+#include "tflite/memory_planner.h"
+
+// A prepared model snapshot records the state that AllocateTensors() computes
+// for an interpreter and that only depends on the model and the interpreter
+// configuration: the resolved execution plan of every subgraph, including the
+// delegate partition boundaries, and the arena placement of every tensor.
+//
+// Applying a snapshot to a freshly built interpreter for the same model and
+// configuration lets AllocateTensors() reuse the recorded arena offsets
+// instead of searching for them, which dominates allocation time for graphs
+// with many tensors. Every recorded placement is validated against the sizes
+// and lifetimes computed by the ops' Prepare, so a stale snapshot only costs
+// the time saved: mismatching subgraphs are planned as usual.
+//
+// Snapshots are stored with the Serialization cache directory mechanism used
+// by delegates. Delegates that want to skip their own partitioning work on a
+// warm start can use SaveDelegatedNodes/GetDelegatedNodes with the same
+// Serialization instance.
+//
+// Example code:
+//
+// SerializationParams params;
+// params.model_token = model_token;  // e.g. StrFingerprint() of the model.
+// params.cache_dir = cache_dir;
+// Serialization serialization(params);
+//
+// std::unique_ptr<Interpreter> interpreter = ...;
+// // Key for everything that influences the plan besides the model, e.g. the
+// // number of threads and the applied delegates.
+// const std::string options_key = ...;
+// const bool warm = LoadPreparedSnapshot(&serialization, options_key,
+//                                        interpreter.get()) == kTfLiteOk;
+// interpreter->AllocateTensors();
+// if (!warm) {
+//   SavePreparedSnapshot(&serialization, options_key, interpreter.get());
+// }
+//
+// WARNING: Experimental interface, subject to change.
+namespace tflite {
+namespace delegates {
+
+struct PreparedSubgraphSnapshot {
+  // Number of tensors in the subgraph after AllocateTensors().
+  int32_t num_tensors = 0;
+  // The execution plan, with delegated partitions replaced by their delegate
+  // kernel nodes.
+  std::vector<int> execution_plan;
+  MemoryPlanSnapshot memory_plan;
+};
+
+struct PreparedModelSnapshot {
+  std::vector<PreparedSubgraphSnapshot> subgraphs;
+};
+
+// Records the prepared state of `interpreter`. AllocateTensors() must have
+// been called successfully.
+TfLiteStatus CapturePreparedSnapshot(const Interpreter& interpreter,
+                                     PreparedModelSnapshot* snapshot);
+
+// Makes subsequent AllocateTensors() calls on `interpreter` reuse the state
+// recorded in `snapshot`. Must be called before the first AllocateTensors().
+// Returns kTfLiteError if the snapshot obviously belongs to another model, in
+// which case `interpreter` is left untouched.
+TfLiteStatus ApplyPreparedSnapshot(const PreparedModelSnapshot& snapshot,
+                                   Interpreter* interpreter);
+
+// Converts a snapshot to and from a versioned, checksummed byte string.
+std::string SerializePreparedSnapshot(const PreparedModelSnapshot& snapshot);
+// Returns kTfLiteDelegateDataReadError if `data` is truncated, corrupted or
+// was written by an incompatible version.
+TfLiteStatus DeserializePreparedSnapshot(const std::string& data,
+                                         PreparedModelSnapshot* snapshot);
+
+// Captures the prepared state of `interpreter` and stores it in the cache
+// entry for `options_key`.
+TfLiteStatus SavePreparedSnapshot(Serialization* serialization,
+                                  const std::string& options_key,
+                                  Interpreter* interpreter);
+
+// Loads the snapshot stored for `options_key` and applies it to
+// `interpreter`. Returns kTfLiteDelegateDataNotFound on a cache miss.
+TfLiteStatus LoadPreparedSnapshot(Serialization* serialization,
+                                  const std::string& options_key,
+                                  Interpreter* interpreter);
+
+}  // namespace delegates
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_DELEGATES_PREPARED_SNAPSHOT_H_
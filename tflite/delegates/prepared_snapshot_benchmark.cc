@@ -0,0 +1,87 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Measures AllocateTensors() of a freshly built interpreter with and without
+// a prepared snapshot.
+
+#include <cstdlib>
+#include <memory>
+
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/delegates/prepared_snapshot.h"
+#include "tflite/kernels/builtin_op_kernels.h"
+
+namespace tflite {
+namespace delegates {
+namespace {
+
+// A graph of `num_ops` ADD ops where op i consumes the outputs of ops i - 1
+// and i / 2, so that tensors have many different lifetimes.
+std::unique_ptr<Interpreter> BuildGraph(int num_ops) {
+  auto interpreter = std::make_unique<Interpreter>();
+  interpreter->AddTensors(num_ops + 1);
+  interpreter->SetInputs({0});
+  interpreter->SetOutputs({num_ops});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i <= num_ops; ++i) {
+    interpreter->SetTensorParametersReadWrite(i, kTfLiteFloat32, "",
+                                              {1 + i % 7, 64}, quant);
+  }
+  for (int i = 0; i < num_ops; ++i) {
+    auto* params =
+        reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+    params->activation = kTfLiteActNone;
+    params->pot_scale_int16 = false;
+    interpreter->AddNodeWithParameters({i, i / 2}, {i + 1}, nullptr, 0,
+                                       params, ops::builtin::Register_ADD());
+  }
+  return interpreter;
+}
+
+void BM_AllocateTensors(benchmark::State& state) {
+  const int num_ops = state.range(0);
+  const bool use_snapshot = state.range(1);
+  PreparedModelSnapshot snapshot;
+  {
+    auto interpreter = BuildGraph(num_ops);
+    interpreter->AllocateTensors();
+    CapturePreparedSnapshot(*interpreter, &snapshot);
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto interpreter = BuildGraph(num_ops);
+    if (use_snapshot) ApplyPreparedSnapshot(snapshot, interpreter.get());
+    state.ResumeTiming();
+    if (interpreter->AllocateTensors() != kTfLiteOk) {
+      state.SkipWithError("AllocateTensors failed");
+      break;
+    }
+    state.PauseTiming();
+    interpreter.reset();
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK(BM_AllocateTensors)
+    ->ArgNames({"ops", "snapshot"})
+    ->ArgsProduct({{64, 512, 4096}, {0, 1}});
+
+}  // namespace
+}  // namespace delegates
+}  // namespace tflite
+
+BENCHMARK_MAIN();
@@ -0,0 +1,204 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/delegates/prepared_snapshot.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/builtin_ops.h"
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/delegates/serialization.h"
+#include "tflite/kernels/builtin_op_kernels.h"
+#include "tflite/memory_planner.h"
+
+namespace tflite {
+namespace delegates {
+namespace {
+
+// Builds a chain of `num_adds` ADD ops, each doubling its input.
+std::unique_ptr<Interpreter> BuildAddChain(int num_adds, int size = 7) {
+  auto interpreter = std::make_unique<Interpreter>();
+  interpreter->AddTensors(num_adds + 1);
+  interpreter->SetInputs({0});
+  interpreter->SetOutputs({num_adds});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i <= num_adds; ++i) {
+    interpreter->SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {size},
+                                              quant);
+  }
+  for (int i = 0; i < num_adds; ++i) {
+    auto* params =
+        reinterpret_cast<TfLiteAddParams*>(malloc(sizeof(TfLiteAddParams)));
+    params->activation = kTfLiteActNone;
+    params->pot_scale_int16 = false;
+    interpreter->AddNodeWithParameters({i, i}, {i + 1}, nullptr, 0, params,
+                                       ops::builtin::Register_ADD());
+  }
+  return interpreter;
+}
+
+MemoryPlanSnapshot ExportPlan(const Interpreter& interpreter) {
+  MemoryPlanSnapshot plan;
+  EXPECT_EQ(interpreter.primary_subgraph().ExportMemoryPlan(&plan), kTfLiteOk);
+  return plan;
+}
+
+std::vector<size_t> Offsets(const MemoryPlanSnapshot& plan) {
+  std::vector<size_t> offsets;
+  for (const PlannedAllocation& alloc : plan.allocations) {
+    offsets.push_back(alloc.offset);
+  }
+  return offsets;
+}
+
+TEST(PreparedSnapshotTest, SerializationRoundTrip) {
+  auto interpreter = BuildAddChain(/*num_adds=*/8, /*size=*/1);
+  ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*interpreter, &snapshot), kTfLiteOk);
+  ASSERT_EQ(snapshot.subgraphs.size(), 1);
+  EXPECT_FALSE(snapshot.subgraphs[0].memory_plan.allocations.empty());
+
+  PreparedModelSnapshot restored;
+  ASSERT_EQ(DeserializePreparedSnapshot(SerializePreparedSnapshot(snapshot),
+                                        &restored),
+            kTfLiteOk);
+  ASSERT_EQ(restored.subgraphs.size(), 1);
+  EXPECT_EQ(restored.subgraphs[0].num_tensors,
+            snapshot.subgraphs[0].num_tensors);
+  EXPECT_EQ(restored.subgraphs[0].execution_plan,
+            snapshot.subgraphs[0].execution_plan);
+  EXPECT_EQ(Offsets(restored.subgraphs[0].memory_plan),
+            Offsets(snapshot.subgraphs[0].memory_plan));
+}
+
+TEST(PreparedSnapshotTest, CorruptedDataIsRejected) {
+  auto interpreter = BuildAddChain(/*num_adds=*/4, /*size=*/1);
+  ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*interpreter, &snapshot), kTfLiteOk);
+  const std::string data = SerializePreparedSnapshot(snapshot);
+
+  PreparedModelSnapshot restored;
+  std::string corrupted = data;
+  corrupted[corrupted.size() / 2] ^= 0x1;
+  EXPECT_EQ(DeserializePreparedSnapshot(corrupted, &restored),
+            kTfLiteDelegateDataReadError);
+  EXPECT_EQ(DeserializePreparedSnapshot(data.substr(0, data.size() - 1),
+                                        &restored),
+            kTfLiteDelegateDataReadError);
+  EXPECT_EQ(DeserializePreparedSnapshot("", &restored),
+            kTfLiteDelegateDataReadError);
+  EXPECT_TRUE(restored.subgraphs.empty());
+}
+
+TEST(PreparedSnapshotTest, AppliedSnapshotReproducesPlan) {
+  auto cold = BuildAddChain(/*num_adds=*/16, /*size=*/1);
+  ASSERT_EQ(cold->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*cold, &snapshot), kTfLiteOk);
+
+  auto warm = BuildAddChain(/*num_adds=*/16, /*size=*/1);
+  ASSERT_EQ(ApplyPreparedSnapshot(snapshot, warm.get()), kTfLiteOk);
+  ASSERT_EQ(warm->AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(Offsets(ExportPlan(*warm)),
+            Offsets(snapshot.subgraphs[0].memory_plan));
+  Subgraph::SubgraphAllocInfo cold_info, warm_info;
+  cold->primary_subgraph().GetMemoryAllocInfo(&cold_info);
+  warm->primary_subgraph().GetMemoryAllocInfo(&warm_info);
+  EXPECT_EQ(warm_info.arena_size, cold_info.arena_size);
+
+  warm->typed_input_tensor<float>(0)[0] = 1.0f;
+  ASSERT_EQ(warm->Invoke(), kTfLiteOk);
+  // Every op doubles its input.
+  EXPECT_EQ(warm->typed_output_tensor<float>(0)[0], 65536.0f);
+}
+
+TEST(PreparedSnapshotTest, PlacementsAreTakenFromSnapshot) {
+  auto cold = BuildAddChain(/*num_adds=*/4, /*size=*/1);
+  ASSERT_EQ(cold->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*cold, &snapshot), kTfLiteOk);
+
+  // Shifting every placement keeps the plan valid, and shows that offsets
+  // were not recomputed.
+  auto& allocations = snapshot.subgraphs[0].memory_plan.allocations;
+  for (PlannedAllocation& alloc : allocations) alloc.offset += 1024;
+  auto warm = BuildAddChain(/*num_adds=*/4, /*size=*/1);
+  ASSERT_EQ(ApplyPreparedSnapshot(snapshot, warm.get()), kTfLiteOk);
+  ASSERT_EQ(warm->AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(Offsets(ExportPlan(*warm)),
+            Offsets(snapshot.subgraphs[0].memory_plan));
+}
+
+TEST(PreparedSnapshotTest, MismatchingSnapshotFallsBackToPlanning) {
+  auto cold = BuildAddChain(/*num_adds=*/8, /*size=*/1);
+  ASSERT_EQ(cold->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*cold, &snapshot), kTfLiteOk);
+
+  // Same topology, but the input tensor has a different size.
+  auto reference = BuildAddChain(/*num_adds=*/8, /*size=*/1000);
+  ASSERT_EQ(reference->AllocateTensors(), kTfLiteOk);
+  auto warm = BuildAddChain(/*num_adds=*/8, /*size=*/1000);
+  ASSERT_EQ(ApplyPreparedSnapshot(snapshot, warm.get()), kTfLiteOk);
+  ASSERT_EQ(warm->AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(Offsets(ExportPlan(*warm)), Offsets(ExportPlan(*reference)));
+}
+
+TEST(PreparedSnapshotTest, SnapshotOfOtherModelIsRejected) {
+  auto interpreter = BuildAddChain(/*num_adds=*/4);
+  ASSERT_EQ(interpreter->AllocateTensors(), kTfLiteOk);
+  PreparedModelSnapshot snapshot;
+  ASSERT_EQ(CapturePreparedSnapshot(*interpreter, &snapshot), kTfLiteOk);
+
+  auto larger = BuildAddChain(/*num_adds=*/8);
+  EXPECT_EQ(ApplyPreparedSnapshot(snapshot, larger.get()), kTfLiteError);
+  snapshot.subgraphs.emplace_back();
+  EXPECT_EQ(ApplyPreparedSnapshot(snapshot, larger.get()), kTfLiteError);
+  ASSERT_EQ(larger->AllocateTensors(), kTfLiteOk);
+}
+
+TEST(PreparedSnapshotTest, SaveAndLoadWithSerialization) {
+  SerializationParams params;
+  params.model_token = "prepared_snapshot_test_model";
+  const std::string cache_dir = ::testing::TempDir();
+  params.cache_dir = cache_dir.c_str();
+  Serialization serialization(params);
+
+  auto cold = BuildAddChain(/*num_adds=*/8, /*size=*/1);
+  EXPECT_EQ(LoadPreparedSnapshot(&serialization, "missing", cold.get()),
+            kTfLiteDelegateDataNotFound);
+  ASSERT_EQ(cold->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(SavePreparedSnapshot(&serialization, "threads=1", cold.get()),
+            kTfLiteOk);
+
+  auto warm = BuildAddChain(/*num_adds=*/8, /*size=*/1);
+  ASSERT_EQ(LoadPreparedSnapshot(&serialization, "threads=1", warm.get()),
+            kTfLiteOk);
+  ASSERT_EQ(warm->AllocateTensors(), kTfLiteOk);
+  EXPECT_EQ(Offsets(ExportPlan(*warm)), Offsets(ExportPlan(*cold)));
+}
+
+}  // namespace
+}  // namespace delegates
+}  // namespace tflite
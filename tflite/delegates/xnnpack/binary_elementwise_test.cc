@@ -202,6 +202,19 @@ INSTANTIATE_TEST_SUITE_P(
              std::get<1>(info.param).ToString(std::get<2>(info.param));
     });
 
+// POW is only defined for a subset of the inputs used by the other tests
+// (e.g. sparse weights have zeros), so it is only tested for broadcasting.
+INSTANTIATE_TEST_SUITE_P(
+    PowBroadcastTest, ShapeTest,
+    testing::Combine(testing::Values(BuiltinOperator_POW),
+                     testing::ValuesIn(all_shape_params),
+                     testing::ValuesIn(all_static_params)),
+    [](const testing::TestParamInfo<ShapeTest::ParamType>& info) {
+      return EnumNameBuiltinOperator(std::get<0>(info.param)) +
+             std::string("_") +
+             std::get<1>(info.param).ToString(std::get<2>(info.param));
+    });
+
 class BinaryTest : public testing::TestWithParam<BuiltinOperator> {};
 
 TEST_P(BinaryTest, FP16Weights) {
@@ -96,6 +96,10 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
       input1_distribution = std::uniform_real_distribution<float>(-5.0f, 5.0f);
       input2_distribution = std::uniform_real_distribution<float>(-5.0f, 5.0f);
       break;
+    case BuiltinOperator_POW:
+      input1_distribution = std::uniform_real_distribution<float>(0.5f, 2.0f);
+      input2_distribution = std::uniform_real_distribution<float>(-2.0f, 2.0f);
+      break;
     default:
       break;
   }
@@ -171,10 +175,16 @@ void BinaryElementwiseTester::Test(tflite::BuiltinOperator binary_op,
   float* xnnpack_output_data =
       delegate_interpreter->typed_output_tensor<float>(0);
 
+  // POW is computed less exactly than the other operators, so it gets a few
+  // more ulps.
+  const float relative_tolerance =
+      binary_op == BuiltinOperator_POW ? 8.0f : 2.0f;
   for (size_t i = 0; i < ComputeSize(OutputShape()); i++) {
     ASSERT_NEAR(default_output_data[i], xnnpack_output_data[i],
                 std::numeric_limits<float>::epsilon() *
-                    std::max(std::abs(default_output_data[i]) * 2.0f, 1.0f));
+                    std::max(std::abs(default_output_data[i]) *
+                                 relative_tolerance,
+                             1.0f));
   }
 }
 
@@ -193,6 +203,10 @@ std::vector<char> BinaryElementwiseTester::CreateTfLiteModel(
       input1_distribution = std::uniform_real_distribution<float>(-5.0f, 5.0f);
       input2_distribution = std::uniform_real_distribution<float>(-5.0f, 5.0f);
       break;
+    case BuiltinOperator_POW:
+      input1_distribution = std::uniform_real_distribution<float>(0.5f, 2.0f);
+      input2_distribution = std::uniform_real_distribution<float>(-2.0f, 2.0f);
+      break;
     default:
       break;
   }
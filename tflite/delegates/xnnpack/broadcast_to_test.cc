@@ -0,0 +1,101 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/delegates/xnnpack/broadcast_to_tester.h"
+#include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace tflite {
+namespace xnnpack {
+
+TEST(BroadcastTo, SameRank) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int i = 0; i < 3; i++) {
+    const std::vector<int32_t> output_shape(
+        {shape_rng(), shape_rng(), shape_rng()});
+    std::vector<int32_t> input_shape(output_shape);
+    input_shape[i] = 1;
+
+    // clang-format off
+    BroadcastToTester()
+        .InputShape(input_shape)
+        .OutputShape(output_shape)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(BroadcastTo, HigherRank) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  const std::vector<int32_t> output_shape(
+      {shape_rng(), shape_rng(), shape_rng(), shape_rng()});
+  for (int num_dims = 1; num_dims < 4; num_dims++) {
+    const std::vector<int32_t> input_shape(output_shape.end() - num_dims,
+                                           output_shape.end());
+
+    // clang-format off
+    BroadcastToTester()
+        .InputShape(input_shape)
+        .OutputShape(output_shape)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(BroadcastTo, UnitDimensions) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  const std::vector<int32_t> output_shape(
+      {shape_rng(), shape_rng(), shape_rng(), shape_rng()});
+
+  // clang-format off
+  BroadcastToTester()
+      .InputShape({1, output_shape[2], 1})
+      .OutputShape(output_shape)
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+}  // namespace xnnpack
+}  // namespace tflite
@@ -0,0 +1,189 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/delegates/xnnpack/cast_tester.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "fp16.h"  // from @FP16
+#include "flatbuffers/flatbuffers.h"  // from @flatbuffers
+#include "tflite/converter/schema/schema_conversion_utils.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/model.h"
+#include "tflite/interpreter.h"
+#include "tflite/schema/schema_generated.h"
+#include "tflite/version.h"
+
+namespace tflite {
+namespace xnnpack {
+
+void CastTester::Test(TfLiteDelegate* delegate) const {
+  ASSERT_TRUE(InputType() == TensorType_FLOAT32 ||
+              InputType() == TensorType_FLOAT16);
+  ASSERT_TRUE(OutputType() == TensorType_FLOAT32 ||
+              OutputType() == TensorType_FLOAT16);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  std::uniform_real_distribution<float> input_distribution(-25.0f, 25.0f);
+  auto input_rng = std::bind(input_distribution, std::ref(rng));
+
+  std::vector<char> buffer = CreateTfLiteModel();
+  const Model* model = GetModel(buffer.data());
+
+  std::unique_ptr<Interpreter> delegate_interpreter;
+  ASSERT_EQ(
+      InterpreterBuilder(
+          model,
+          ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates())(
+          &delegate_interpreter),
+      kTfLiteOk);
+  std::unique_ptr<Interpreter> default_interpreter;
+  ASSERT_EQ(
+      InterpreterBuilder(
+          model,
+          ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates())(
+          &default_interpreter),
+      kTfLiteOk);
+
+  ASSERT_TRUE(delegate_interpreter);
+  ASSERT_TRUE(default_interpreter);
+
+  ASSERT_EQ(delegate_interpreter->inputs().size(), 1);
+  ASSERT_EQ(default_interpreter->inputs().size(), 1);
+
+  ASSERT_EQ(delegate_interpreter->outputs().size(), 1);
+  ASSERT_EQ(default_interpreter->outputs().size(), 1);
+
+  ASSERT_EQ(delegate_interpreter->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(default_interpreter->AllocateTensors(), kTfLiteOk);
+
+  ASSERT_EQ(delegate_interpreter->ModifyGraphWithDelegate(delegate), kTfLiteOk);
+  // The CAST node is the only one, and must have been delegated.
+  ASSERT_EQ(delegate_interpreter->execution_plan().size(), 1);
+  const int node_index = delegate_interpreter->execution_plan()[0];
+  ASSERT_NE(
+      delegate_interpreter->node_and_registration(node_index)->first.delegate,
+      nullptr);
+
+  if (InputType() == TensorType_FLOAT16) {
+    uint16_t* default_input_data = reinterpret_cast<uint16_t*>(
+        default_interpreter->input_tensor(0)->data.raw);
+    std::generate_n(default_input_data, Size(),
+                    std::bind(fp16_ieee_from_fp32_value, input_rng));
+    uint16_t* delegate_input_data = reinterpret_cast<uint16_t*>(
+        delegate_interpreter->input_tensor(0)->data.raw);
+    std::copy_n(default_input_data, Size(), delegate_input_data);
+  } else {
+    float* default_input_data =
+        default_interpreter->typed_input_tensor<float>(0);
+    std::generate_n(default_input_data, Size(), std::ref(input_rng));
+    float* delegate_input_data =
+        delegate_interpreter->typed_input_tensor<float>(0);
+    std::copy_n(default_input_data, Size(), delegate_input_data);
+  }
+
+  ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
+  ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+
+  // Both sides round to the nearest value, so the outputs are bit-exact.
+  if (OutputType() == TensorType_FLOAT16) {
+    const uint16_t* default_output_data = reinterpret_cast<const uint16_t*>(
+        default_interpreter->output_tensor(0)->data.raw);
+    const uint16_t* delegate_output_data = reinterpret_cast<const uint16_t*>(
+        delegate_interpreter->output_tensor(0)->data.raw);
+    for (int32_t i = 0; i < Size(); i++) {
+      ASSERT_EQ(default_output_data[i], delegate_output_data[i])
+          << "at index " << i << " / " << Size();
+    }
+  } else {
+    const float* default_output_data =
+        default_interpreter->typed_output_tensor<float>(0);
+    const float* delegate_output_data =
+        delegate_interpreter->typed_output_tensor<float>(0);
+    for (int32_t i = 0; i < Size(); i++) {
+      ASSERT_EQ(default_output_data[i], delegate_output_data[i])
+          << "at index " << i << " / " << Size();
+    }
+  }
+}
+
+std::vector<char> CastTester::CreateTfLiteModel() const {
+  flatbuffers::FlatBufferBuilder builder;
+  flatbuffers::Offset<OperatorCode> operator_code =
+      CreateOperatorCode(builder, BuiltinOperator_CAST);
+
+  const std::array<flatbuffers::Offset<Buffer>, 1> buffers{{
+      CreateBuffer(builder, builder.CreateVector({})),
+  }};
+
+  const std::array<flatbuffers::Offset<Tensor>, 2> tensors{{
+      CreateTensor(
+          builder,
+          builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
+          InputType()),
+      CreateTensor(
+          builder,
+          builder.CreateVector<int32_t>(Shape().data(), Shape().size()),
+          OutputType()),
+  }};
+
+  const std::array<int32_t, 1> op_inputs{{0}};
+  const std::array<int32_t, 1> op_outputs{{1}};
+  flatbuffers::Offset<Operator> op = CreateOperator(
+      builder, /*opcode_index=*/0,
+      builder.CreateVector<int32_t>(op_inputs.data(), op_inputs.size()),
+      builder.CreateVector<int32_t>(op_outputs.data(), op_outputs.size()));
+
+  const std::array<int32_t, 1> subgraph_inputs{{0}};
+  const std::array<int32_t, 1> subgraph_outputs{{1}};
+  flatbuffers::Offset<SubGraph> subgraph = CreateSubGraph(
+      builder, builder.CreateVector(tensors.data(), tensors.size()),
+      builder.CreateVector<int32_t>(subgraph_inputs.data(),
+                                    subgraph_inputs.size()),
+      builder.CreateVector<int32_t>(subgraph_outputs.data(),
+                                    subgraph_outputs.size()),
+      builder.CreateVector(&op, 1));
+
+  flatbuffers::Offset<flatbuffers::String> description =
+      builder.CreateString("Cast operator model");
+
+  flatbuffers::Offset<Model> model_buffer = CreateModel(
+      builder, TFLITE_SCHEMA_VERSION, builder.CreateVector(&operator_code, 1),
+      builder.CreateVector(&subgraph, 1), description,
+      builder.CreateVector(buffers.data(), buffers.size()));
+
+  builder.Finish(model_buffer);
+
+  return std::vector<char>(builder.GetBufferPointer(),
+                           builder.GetBufferPointer() + builder.GetSize());
+}
+
+int32_t CastTester::ComputeSize(const std::vector<int32_t>& shape) {
+  return std::accumulate(shape.cbegin(), shape.cend(), 1,
+                         std::multiplies<int32_t>());
+}
+
+}  // namespace xnnpack
+}  // namespace tflite
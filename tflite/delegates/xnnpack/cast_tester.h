@@ -0,0 +1,79 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_DELEGATES_XNNPACK_CAST_TESTER_H_
+#define TENSORFLOW_LITE_DELEGATES_XNNPACK_CAST_TESTER_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace xnnpack {
+
+class CastTester {
+ public:
+  CastTester() = default;
+  CastTester(const CastTester&) = delete;
+  CastTester& operator=(const CastTester&) = delete;
+
+  inline CastTester& Shape(std::initializer_list<int32_t> shape) {
+    for (auto it = shape.begin(); it != shape.end(); ++it) {
+      EXPECT_GT(*it, 0);
+    }
+    shape_ = std::vector<int32_t>(shape.begin(), shape.end());
+    size_ = CastTester::ComputeSize(shape_);
+    return *this;
+  }
+
+  inline const std::vector<int32_t>& Shape() const { return shape_; }
+
+  inline int32_t Size() const { return size_; }
+
+  inline CastTester& InputType(TensorType input_type) {
+    input_type_ = input_type;
+    return *this;
+  }
+
+  inline TensorType InputType() const { return input_type_; }
+
+  inline CastTester& OutputType(TensorType output_type) {
+    output_type_ = output_type;
+    return *this;
+  }
+
+  inline TensorType OutputType() const { return output_type_; }
+
+  void Test(TfLiteDelegate* delegate) const;
+
+ private:
+  std::vector<char> CreateTfLiteModel() const;
+
+  static int32_t ComputeSize(const std::vector<int32_t>& shape);
+
+  std::vector<int32_t> shape_;
+  int32_t size_ = 1;
+  TensorType input_type_ = TensorType_FLOAT32;
+  TensorType output_type_ = TensorType_FLOAT16;
+};
+
+}  // namespace xnnpack
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_DELEGATES_XNNPACK_CAST_TESTER_H_
@@ -0,0 +1,135 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/delegates/xnnpack/pack_tester.h"
+#include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace tflite {
+namespace xnnpack {
+
+TEST(Pack, 1D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int axis = -2; axis <= 1; axis++) {
+    // clang-format off
+    PackTester()
+        .InputShape({shape_rng()})
+        .NumInputs(shape_rng())
+        .Axis(axis)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(Pack, 2D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int axis = -3; axis <= 2; axis++) {
+    // clang-format off
+    PackTester()
+        .InputShape({shape_rng(), shape_rng()})
+        .NumInputs(shape_rng())
+        .Axis(axis)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(Pack, 3D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int axis = -4; axis <= 3; axis++) {
+    // clang-format off
+    PackTester()
+        .InputShape({shape_rng(), shape_rng(), shape_rng()})
+        .NumInputs(shape_rng())
+        .Axis(axis)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(Pack, 4D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int axis = -5; axis <= 4; axis++) {
+    // clang-format off
+    PackTester()
+        .InputShape({shape_rng(), shape_rng(), shape_rng(), shape_rng()})
+        .NumInputs(shape_rng())
+        .Axis(axis)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+TEST(Pack, SingleInput) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int axis = -3; axis <= 2; axis++) {
+    // clang-format off
+    PackTester()
+        .InputShape({shape_rng(), shape_rng()})
+        .NumInputs(1)
+        .Axis(axis)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+}  // namespace xnnpack
+}  // namespace tflite
@@ -0,0 +1,166 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/delegates/xnnpack/pack_tester.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "flatbuffers/flatbuffers.h"  // from @flatbuffers
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/model.h"
+#include "tflite/interpreter.h"
+#include "tflite/schema/schema_conversion_utils.h"
+#include "tflite/schema/schema_generated.h"
+#include "tflite/version.h"
+
+namespace tflite {
+namespace xnnpack {
+
+std::vector<int32_t> PackTester::OutputShape() const {
+  std::vector<int32_t> output_shape = InputShape();
+  const int32_t axis =
+      Axis() < 0 ? Axis() + static_cast<int32_t>(InputShape().size()) + 1
+                 : Axis();
+  EXPECT_LE(0, axis);
+  EXPECT_LE(axis, static_cast<int32_t>(InputShape().size()));
+  output_shape.insert(output_shape.begin() + axis, NumInputs());
+  return output_shape;
+}
+
+void PackTester::Test(TfLiteDelegate* delegate) const {
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  std::uniform_real_distribution<float> input_distribution(-25.0f, 25.0f);
+  auto input_rng = std::bind(input_distribution, std::ref(rng));
+
+  std::vector<char> buffer = CreateTfLiteModel();
+  const Model* model = GetModel(buffer.data());
+
+  std::unique_ptr<Interpreter> delegate_interpreter;
+  ASSERT_EQ(
+      InterpreterBuilder(
+          model,
+          ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates())(
+          &delegate_interpreter),
+      kTfLiteOk);
+  std::unique_ptr<Interpreter> default_interpreter;
+  ASSERT_EQ(
+      InterpreterBuilder(
+          model,
+          ::tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates())(
+          &default_interpreter),
+      kTfLiteOk);
+
+  ASSERT_TRUE(delegate_interpreter);
+  ASSERT_TRUE(default_interpreter);
+  ASSERT_EQ(delegate_interpreter->inputs().size(), NumInputs());
+  ASSERT_EQ(default_interpreter->inputs().size(), NumInputs());
+  ASSERT_EQ(delegate_interpreter->outputs().size(), 1);
+  ASSERT_EQ(default_interpreter->outputs().size(), 1);
+
+  ASSERT_EQ(delegate_interpreter->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(default_interpreter->AllocateTensors(), kTfLiteOk);
+
+  ASSERT_EQ(delegate_interpreter->ModifyGraphWithDelegate(delegate), kTfLiteOk);
+
+  for (int i = 0; i < NumInputs(); i++) {
+    float* default_input_data =
+        default_interpreter->typed_input_tensor<float>(i);
+    std::generate_n(default_input_data, ComputeSize(InputShape()),
+                    std::ref(input_rng));
+
+    float* delegate_input_data =
+        delegate_interpreter->typed_input_tensor<float>(i);
+    std::copy_n(default_input_data, ComputeSize(InputShape()),
+                delegate_input_data);
+  }
+
+  ASSERT_EQ(default_interpreter->Invoke(), kTfLiteOk);
+  ASSERT_EQ(delegate_interpreter->Invoke(), kTfLiteOk);
+
+  const float* default_output_data =
+      default_interpreter->typed_output_tensor<float>(0);
+  const float* delegate_output_data =
+      delegate_interpreter->typed_output_tensor<float>(0);
+
+  for (size_t i = 0; i < ComputeSize(OutputShape()); i++) {
+    ASSERT_EQ(default_output_data[i], delegate_output_data[i]);
+  }
+}
+
+std::vector<char> PackTester::CreateTfLiteModel() const {
+  flatbuffers::FlatBufferBuilder builder;
+  flatbuffers::Offset<OperatorCode> operator_code =
+      CreateOperatorCode(builder, BuiltinOperator_PACK, 0);
+
+  std::vector<flatbuffers::Offset<Buffer>> buffers{
+      {CreateBuffer(builder, builder.CreateVector({}))}};
+
+  const std::vector<int32_t> output_shape = OutputShape();
+  std::vector<flatbuffers::Offset<Tensor>> tensors;
+  for (int i = 0; i < NumInputs(); i++) {
+    tensors.push_back(
+        CreateTensor(builder,
+                     builder.CreateVector<int32_t>(InputShape().data(),
+                                                   InputShape().size()),
+                     TensorType_FLOAT32, /*buffer=*/0));
+  }
+  tensors.push_back(CreateTensor(
+      builder,
+      builder.CreateVector<int32_t>(output_shape.data(), output_shape.size()),
+      TensorType_FLOAT32, /*buffer=*/0));
+
+  std::vector<int32_t> op_inputs(NumInputs());
+  std::iota(op_inputs.begin(), op_inputs.end(), 0);
+  const std::vector<int32_t> op_outputs{NumInputs()};
+  const flatbuffers::Offset<Operator> op = CreateOperator(
+      builder, /*opcode_index=*/0,
+      builder.CreateVector<int32_t>(op_inputs.data(), op_inputs.size()),
+      builder.CreateVector<int32_t>(op_outputs.data(), op_outputs.size()),
+      tflite::BuiltinOptions_PackOptions,
+      CreatePackOptions(builder, NumInputs(), Axis()).Union());
+
+  flatbuffers::Offset<SubGraph> subgraph = CreateSubGraph(
+      builder, builder.CreateVector(tensors.data(), tensors.size()),
+      builder.CreateVector<int32_t>(op_inputs.data(), op_inputs.size()),
+      builder.CreateVector<int32_t>(op_outputs.data(), op_outputs.size()),
+      builder.CreateVector(&op, 1));
+
+  const flatbuffers::Offset<Model> model_buffer = CreateModel(
+      builder, TFLITE_SCHEMA_VERSION, builder.CreateVector(&operator_code, 1),
+      builder.CreateVector(&subgraph, 1), builder.CreateString("Pack model"),
+      builder.CreateVector(buffers.data(), buffers.size()));
+
+  builder.Finish(model_buffer);
+
+  return std::vector<char>(builder.GetBufferPointer(),
+                           builder.GetBufferPointer() + builder.GetSize());
+}
+
+int32_t PackTester::ComputeSize(const std::vector<int32_t>& shape) {
+  return std::accumulate(shape.cbegin(), shape.cend(), 1,
+                         std::multiplies<int32_t>());
+}
+
+}  // namespace xnnpack
+}  // namespace tflite
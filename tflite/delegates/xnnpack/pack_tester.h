@@ -0,0 +1,77 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_DELEGATES_XNNPACK_PACK_TESTER_H_
+#define TENSORFLOW_LITE_DELEGATES_XNNPACK_PACK_TESTER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace xnnpack {
+
+class PackTester {
+ public:
+  PackTester() = default;
+  PackTester(const PackTester&) = delete;
+  PackTester& operator=(const PackTester&) = delete;
+
+  inline PackTester& InputShape(const std::vector<int32_t>& shape) {
+    for (auto it = shape.begin(); it != shape.end(); ++it) {
+      EXPECT_GT(*it, 0);
+    }
+    input_shape_ = std::vector<int32_t>(shape.begin(), shape.end());
+    return *this;
+  }
+
+  inline const std::vector<int32_t>& InputShape() const { return input_shape_; }
+
+  inline PackTester& NumInputs(int num_inputs) {
+    EXPECT_GT(num_inputs, 0);
+    num_inputs_ = num_inputs;
+    return *this;
+  }
+
+  inline int NumInputs() const { return num_inputs_; }
+
+  inline PackTester& Axis(int32_t axis) {
+    axis_ = axis;
+    return *this;
+  }
+
+  inline int32_t Axis() const { return axis_; }
+
+  std::vector<int32_t> OutputShape() const;
+
+  void Test(TfLiteDelegate* delegate) const;
+
+ private:
+  std::vector<char> CreateTfLiteModel() const;
+
+  static int32_t ComputeSize(const std::vector<int32_t>& shape);
+
+  std::vector<int32_t> input_shape_;
+  int num_inputs_ = 2;
+  int32_t axis_ = 0;
+};
+
+}  // namespace xnnpack
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_DELEGATES_XNNPACK_PACK_TESTER_H_
@@ -0,0 +1,143 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/delegates/xnnpack/tile_tester.h"
+#include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace tflite {
+namespace xnnpack {
+
+TEST(Tile, NoTiling) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  // clang-format off
+  TileTester()
+      .InputShape({shape_rng(), shape_rng(), shape_rng()})
+      .Multiples({1, 1, 1})
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+TEST(Tile, 1D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  // clang-format off
+  TileTester()
+      .InputShape({shape_rng()})
+      .Multiples({shape_rng()})
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+TEST(Tile, 2D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  // clang-format off
+  TileTester()
+      .InputShape({shape_rng(), shape_rng()})
+      .Multiples({shape_rng(), shape_rng()})
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+TEST(Tile, 3D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  // clang-format off
+  TileTester()
+      .InputShape({shape_rng(), shape_rng(), shape_rng()})
+      .Multiples({shape_rng(), shape_rng(), shape_rng()})
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+TEST(Tile, 4D) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  // clang-format off
+  TileTester()
+      .InputShape({shape_rng(), shape_rng(), shape_rng(), shape_rng()})
+      .Multiples({shape_rng(), shape_rng(), shape_rng(), shape_rng()})
+      .Test(xnnpack_delegate.get());
+  // clang-format on
+}
+
+TEST(Tile, SingleDimension) {
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate(TfLiteXNNPackDelegateCreate(nullptr),
+                       TfLiteXNNPackDelegateDelete);
+
+  std::random_device random_device;
+  auto rng = std::mt19937(random_device());
+  auto shape_rng =
+      std::bind(std::uniform_int_distribution<int32_t>(2, 5), std::ref(rng));
+
+  for (int i = 0; i < 3; i++) {
+    std::vector<int32_t> multiples({1, 1, 1});
+    multiples[i] = shape_rng();
+
+    // clang-format off
+    TileTester()
+        .InputShape({shape_rng(), shape_rng(), shape_rng()})
+        .Multiples(multiples)
+        .Test(xnnpack_delegate.get());
+    // clang-format on
+  }
+}
+
+}  // namespace xnnpack
+}  // namespace tflite
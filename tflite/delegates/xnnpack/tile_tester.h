@@ -0,0 +1,71 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_DELEGATES_XNNPACK_TILE_TESTER_H_
+#define TENSORFLOW_LITE_DELEGATES_XNNPACK_TILE_TESTER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace xnnpack {
+
+class TileTester {
+ public:
+  TileTester() = default;
+  TileTester(const TileTester&) = delete;
+  TileTester& operator=(const TileTester&) = delete;
+
+  inline TileTester& InputShape(const std::vector<int32_t>& shape) {
+    for (auto it = shape.begin(); it != shape.end(); ++it) {
+      EXPECT_GT(*it, 0);
+    }
+    input_shape_ = std::vector<int32_t>(shape.begin(), shape.end());
+    return *this;
+  }
+
+  inline const std::vector<int32_t>& InputShape() const { return input_shape_; }
+
+  inline TileTester& Multiples(const std::vector<int32_t>& multiples) {
+    for (auto it = multiples.begin(); it != multiples.end(); ++it) {
+      EXPECT_GT(*it, 0);
+    }
+    multiples_ = std::vector<int32_t>(multiples.begin(), multiples.end());
+    return *this;
+  }
+
+  inline const std::vector<int32_t>& Multiples() const { return multiples_; }
+
+  std::vector<int32_t> OutputShape() const;
+
+  void Test(TfLiteDelegate* delegate) const;
+
+ private:
+  std::vector<char> CreateTfLiteModel() const;
+
+  static int32_t ComputeSize(const std::vector<int32_t>& shape);
+
+  std::vector<int32_t> input_shape_;
+  std::vector<int32_t> multiples_;
+};
+
+}  // namespace xnnpack
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_DELEGATES_XNNPACK_TILE_TESTER_H_
@@ -151,7 +151,7 @@ BuiltinOperator all_unary_ops[] = {
     BuiltinOperator_ROUND,      BuiltinOperator_RSQRT,
     BuiltinOperator_SIN,        BuiltinOperator_SQRT,
     BuiltinOperator_SQUARE,     BuiltinOperator_TANH,
-    BuiltinOperator_LOGISTIC,
+    BuiltinOperator_LOGISTIC,   BuiltinOperator_LOG,
 };
 
 INSTANTIATE_TEST_SUITE_P(
@@ -50,6 +50,7 @@ void UnaryElementwiseTester::Test(tflite::BuiltinOperator unary_op,
     case BuiltinOperator_SQRT:
       input_distribution = std::uniform_real_distribution<float>(0.0f, 10.0f);
       break;
+    case BuiltinOperator_LOG:
     case BuiltinOperator_RSQRT:
       input_distribution = std::uniform_real_distribution<float>(
           std::numeric_limits<float>::epsilon(), 10.0f);
@@ -316,7 +316,9 @@ MMapWeightCacheProvider::MMapWeightCacheProvider(
       XNN_MOVE_CONSTRUCT_MEMBER(file_descriptor_),
       XNN_MOVE_CONSTRUCT_MEMBER(builder_),
       XNN_MOVE_CONSTRUCT_MEMBER(building_run_),
-      XNN_MOVE_CONSTRUCT_MEMBER(offset_to_addr_) {
+      XNN_MOVE_CONSTRUCT_MEMBER(offset_to_addr_),
+      XNN_MOVE_CONSTRUCT_MEMBER(memory_placement_),
+      XNN_MOVE_CONSTRUCT_MEMBER(placed_cache_) {
   // The contexts need to keep pointing to their owning object.
   cache_provider_.context = this;
   other.cache_provider_.context = &other;
@@ -340,6 +342,8 @@ MMapWeightCacheProvider& MMapWeightCacheProvider::operator=(
   XNN_MOVE_MEMBER(builder_);
   XNN_MOVE_MEMBER(building_run_);
   XNN_MOVE_MEMBER(offset_to_addr_);
+  XNN_MOVE_MEMBER(memory_placement_);
+  XNN_MOVE_MEMBER(placed_cache_);
 #undef XNN_MOVE_MEMBER
   return *this;
 }
@@ -462,6 +466,25 @@ bool MMapWeightCacheProvider::Load() {
 
   XNNPACK_RETURN_CHECK(CheckFingerprints(buffer_list));
 
+  // The file mapping is kept for later build steps, which read the header
+  // from it.
+  uint8_t* cache_data = mmap_handle.data();
+  placed_cache_.reset();
+  if (memory_placement_.Applies(mmap_handle.size())) {
+    placed_cache_ = tflite::PlacedBuffer::CopyOf(
+        mmap_handle.data(), mmap_handle.size(), memory_placement_);
+    if (placed_cache_) {
+      // Packed weights are never written once they are in the cache.
+      cache_data =
+          reinterpret_cast<uint8_t*>(const_cast<char*>(placed_cache_->data()));
+    } else {
+      TFLITE_LOG(tflite::TFLITE_LOG_WARNING,
+                 "XNNPack weight cache: could not place '%s', reading it "
+                 "from the file mapping.",
+                 file_path_.c_str());
+    }
+  }
+
   mmap_buffer_base_offset_ = buffer_list->base_offset();
   if (const auto buffers = buffer_list->buffers(); buffers) {
     for (auto* buffer : *buffers) {
@@ -473,7 +496,7 @@ bool MMapWeightCacheProvider::Load() {
           BufferLocation{/*offset=*/buffer->offset(), /*size=*/buffer->size()});
       offset_to_addr_.insert(
           {buffer->offset(),
-           mmap_handle.data() + mmap_buffer_base_offset_ + buffer->offset()});
+           cache_data + mmap_buffer_base_offset_ + buffer->offset()});
     }
   }
 
@@ -639,6 +662,7 @@ void MMapWeightCacheProvider::Release() {
   cache_key_to_offset_.clear();
   mmap_handles_.clear();
   mmap_buffer_base_offset_ = 0;
+  placed_cache_.reset();
   builder_ = WeightCacheBuilder();
 }
 
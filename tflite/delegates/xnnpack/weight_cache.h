@@ -29,6 +29,7 @@ limitations under the License.
 #include "tflite/delegates/xnnpack/file_util.h"
 #include "tflite/delegates/xnnpack/mmap_handle.h"
 #include "tflite/delegates/xnnpack/weight_cache_schema_generated.h"
+#include "tflite/memory_placement.h"
 
 // WARNING: the interface in this file is still under experimentation and WILL
 // CHANGE. Do not rely on it.
@@ -247,6 +248,16 @@ class MMapWeightCacheProvider {
 
   const std::string& GetFilePath() const { return file_path_; }
 
+  // Makes the next `Load` copy the cache into memory placed according to
+  // `placement`, e.g. backed by huge pages on a given NUMA node, instead of
+  // reading the packed weights from the file mapping. Giving the providers of
+  // the interpreters running on each NUMA node their own placement replicates
+  // the weights per node. Caches smaller than `placement.min_bytes` and
+  // segments appended by later build steps stay in the file mapping.
+  void SetMemoryPlacement(const tflite::MemoryPlacement& placement) {
+    memory_placement_ = placement;
+  }
+
   // Tries to load the given file. If the file doesn't exist starts building the
   // cache for it.
   //
@@ -417,6 +428,13 @@ class MMapWeightCacheProvider {
   // Stores the loaded buffer addresses corresponding to the given offset in the
   // cache file.
   std::map<size_t, void*> offset_to_addr_;
+
+  // Where loaded caches are copied to, see `SetMemoryPlacement`.
+  tflite::MemoryPlacement memory_placement_;
+
+  // Copy of the cache file the loaded buffer addresses point into, if it was
+  // placed.
+  std::unique_ptr<tflite::PlacedBuffer> placed_cache_;
 };
 
 }  // namespace xnnpack
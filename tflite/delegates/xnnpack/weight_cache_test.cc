@@ -44,6 +44,7 @@ limitations under the License.
 #include "tflite/delegates/xnnpack/weight_cache_schema_generated.h"
 #include "tflite/delegates/xnnpack/weight_cache_test_helpers.h"
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tflite/memory_placement.h"
 
 namespace tflite::xnnpack {
 
@@ -732,6 +733,31 @@ TEST_P(LoadMMapWeightCacheProviderTest, LookUpSucceeds) {
               ElementsAreArray(reference_2.buffer));
 }
 
+TEST_P(LoadMMapWeightCacheProviderTest, PlacedLoadCopiesTheCache) {
+  if (use_in_memory_cache) {
+    GTEST_SKIP() << "In-memory caches can't be loaded by another provider.";
+  }
+  tflite::MemoryPlacement placement;
+  placement.huge_pages = tflite::HugePageMode::kTransparent;
+  placement.min_bytes = 0;
+  MMapWeightCacheProvider placed_provider;
+  placed_provider.SetMemoryPlacement(placement);
+  placed_provider.MapTensorIdentifiers(ctx.tensors.data(), ctx.tensors.size(),
+                                       ctx.tensor_buffer_identifiers);
+  ASSERT_TRUE(placed_provider.Load(tmp_file.GetCPath()));
+
+  const xnn_weights_cache_look_up_key look_up_key = LookUpKey1();
+  const uint64_t offset = placed_provider.LookUp(&look_up_key);
+  const auto& reference = ctx.packed_buffers.find(pack_id_1)->second;
+  ASSERT_EQ(offset, reference.offset);
+
+  const void* const addr = placed_provider.OffsetToAddr(offset);
+  ASSERT_NE(addr, nullptr);
+  EXPECT_NE(addr, cache_provider.OffsetToAddr(offset));
+  EXPECT_THAT(LightSpan<const uint8_t>(addr, reference.buffer.size()),
+              ElementsAreArray(reference.buffer));
+}
+
 struct MMapWeightCacheProviderTest : testing::TestWithParam<TestVariant> {
   void SetUp() override {
     if (use_in_memory_cache &&
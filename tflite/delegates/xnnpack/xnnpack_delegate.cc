@@ -60,6 +60,7 @@ limitations under the License.
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/kernels/padding.h"
 #include "tflite/logger.h"
+#include "tflite/memory_placement.h"
 #include "tflite/minimal_logging.h"
 #include "tflite/schema/schema_generated.h"
 #include "tflite/tools/optimize/reduced_precision_support.h"
@@ -642,6 +643,12 @@ class Delegate {
                 options_.weight_cache_provider),
             kNotOwned);
       }
+      if (options_.weight_cache_memory_placement &&
+          !weight_cache_provider_->IsActive()) {
+        weight_cache_provider_->SetMemoryPlacement(
+            *static_cast<const tflite::MemoryPlacement*>(
+                options_.weight_cache_memory_placement));
+      }
       // Try to setup the cache provider if necessary.
       if (!weight_cache_provider_->IsActive() &&
           (options_.weight_cache_file_path ||
@@ -979,6 +986,7 @@ class Subgraph {
       }
 
       switch (registration->builtin_code) {
+        case kTfLiteBuiltinBroadcastTo:
         case kTfLiteBuiltinExpandDims:
         case kTfLiteBuiltinMean:
         case kTfLiteBuiltinPad:
@@ -989,9 +997,11 @@ class Subgraph {
         case kTfLiteBuiltinResizeBilinear:
         case kTfLiteBuiltinStridedSlice:
         case kTfLiteBuiltinSlice:
+        case kTfLiteBuiltinTile:
           // Ignore all but the first input (axes, static padding, new shape,
-          // begins/offsets, sizes), because other inputs are represented as
-          // parameters of the XNNPACK operator rather than extra input.
+          // begins/offsets, sizes, multiples), because other inputs are
+          // represented as parameters of the XNNPACK operator rather than extra
+          // input.
           {
             const int t = node->inputs->data[0];
             tensors[t] = t;
@@ -2857,6 +2867,187 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  static TfLiteStatus CheckTensorsQuantizationMatch(
+      TfLiteContext* context, const TfLiteTensor& input_tensor,
+      const TfLiteTensor& output_tensor, BuiltinOperator op_type,
+      int node_index) {
+    if (output_tensor.type != kTfLiteUInt8 &&
+        output_tensor.type != kTfLiteInt8) {
+      return kTfLiteOk;
+    }
+    if (input_tensor.params.zero_point != output_tensor.params.zero_point) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          context,
+          "Mismatching quantization zero point across the input "
+          "(%" PRId32 ") and the output (%" PRId32 ") for %s operator #%d",
+          input_tensor.params.zero_point, output_tensor.params.zero_point,
+          EnumNameBuiltinOperator(op_type), node_index);
+      return kTfLiteError;
+    }
+    if (input_tensor.params.scale != output_tensor.params.scale) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          context,
+          "Mismatching quantization scale across the input (%f) "
+          "and the output (%f) for %s operator #%d",
+          input_tensor.params.scale, output_tensor.params.scale,
+          EnumNameBuiltinOperator(op_type), node_index);
+      return kTfLiteError;
+    }
+    return kTfLiteOk;
+  }
+
+  // Reads the static int32 or int64 1D tensor `tensor` (TILE multiples,
+  // BROADCAST_TO shape) into `values`.
+  static TfLiteStatus GetStaticIntTensorValues(
+      TfLiteContext* context, const TfLiteTensor& tensor, int tensor_index,
+      BuiltinOperator op_type, int node_index,
+      std::array<size_t, XNN_MAX_TENSOR_DIMS>& values, int& num_values) {
+    TF_LITE_ENSURE_STATUS(
+        CheckTensorInt32OrInt64Type(context, tensor, tensor_index, node_index));
+    TF_LITE_ENSURE_STATUS(CheckShapeTensorShape(context, tensor,
+                                                /*squeeze_dims=*/false,
+                                                tensor_index, op_type,
+                                                node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorStaticAllocation(
+        context, tensor, tensor_index, op_type, node_index));
+    num_values = NumElements(&tensor);
+    if (num_values > XNN_MAX_TENSOR_DIMS) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          context, "too many values (%d) in tensor #%d in %s node #%d",
+          num_values, tensor_index, EnumNameBuiltinOperator(op_type),
+          node_index);
+      return kTfLiteError;
+    }
+    for (int i = 0; i < num_values; ++i) {
+      const int64_t value = tensor.type == kTfLiteInt32
+                                ? GetTensorData<int32_t>(&tensor)[i]
+                                : GetTensorData<int64_t>(&tensor)[i];
+      if (value <= 0) {
+        TF_LITE_MAYBE_KERNEL_LOG(
+            context,
+            "invalid value %" PRId64 " at #%d in tensor #%d in %s node #%d",
+            value, i, tensor_index, EnumNameBuiltinOperator(op_type),
+            node_index);
+        return kTfLiteError;
+      }
+      values[i] = static_cast<size_t>(value);
+    }
+    return kTfLiteOk;
+  }
+
+  // Defines a value internal to the lowering of a single TFLite operator, with
+  // the datatype and quantization of `like_tensor`.
+  static TfLiteStatus DefineInternalTensor(xnn_subgraph_t subgraph,
+                                           TfLiteContext* logging_context,
+                                           const TfLiteTensor& like_tensor,
+                                           int like_tensor_index,
+                                           size_t num_dims, const size_t* dims,
+                                           uint32_t* xnnpack_id) {
+    *xnnpack_id = XNN_INVALID_VALUE_ID;
+    const xnn_datatype datatype =
+        GetXNNPackDatatype(logging_context, like_tensor, like_tensor_index);
+    xnn_status status = xnn_status_invalid_parameter;
+    switch (datatype) {
+      case xnn_datatype_fp32:
+      case xnn_datatype_fp16:
+        status = xnn_define_tensor_value(subgraph, datatype, num_dims, dims,
+                                         /*data=*/nullptr, XNN_INVALID_VALUE_ID,
+                                         /*flags=*/0, xnnpack_id);
+        break;
+      case xnn_datatype_qint8:
+      case xnn_datatype_quint8:
+        status = xnn_define_quantized_tensor_value(
+            subgraph, datatype, like_tensor.params.zero_point,
+            like_tensor.params.scale, num_dims, dims, /*data=*/nullptr,
+            XNN_INVALID_VALUE_ID, /*flags=*/0, xnnpack_id);
+        break;
+      default:
+        break;
+    }
+    if (status != xnn_status_success) {
+      TF_LITE_KERNEL_LOG(logging_context,
+                         "failed to define internal value like tensor #%d",
+                         like_tensor_index);
+      return kTfLiteError;
+    }
+    return kTfLiteOk;
+  }
+
+  // XNNPACK has no tile operator, so tiling is lowered to one concatenation of
+  // `multiples[i]` copies per tiled dimension. Larger multiples are left to the
+  // TFLite kernel.
+  static constexpr size_t kMaxTileMultiple = 64;
+
+  static TfLiteStatus CheckTileMultiples(
+      TfLiteContext* context,
+      const std::array<size_t, XNN_MAX_TENSOR_DIMS>& multiples, int num_dims,
+      BuiltinOperator op_type, int node_index) {
+    for (int i = 0; i < num_dims; ++i) {
+      if (multiples[i] > kMaxTileMultiple) {
+        TF_LITE_MAYBE_KERNEL_LOG(
+            context,
+            "unsupported multiple %zu for dimension #%d in %s node #%d: "
+            "at most %zu supported",
+            multiples[i], i, EnumNameBuiltinOperator(op_type), node_index,
+            kMaxTileMultiple);
+        return kTfLiteError;
+      }
+    }
+    return kTfLiteOk;
+  }
+
+  // Defines `output = tile(input, multiples)`, where `dims` are the dimensions
+  // of the input. Each tiled dimension but the last goes through an internal
+  // value with the datatype of `output_tensor`.
+  static TfLiteStatus DefineTile(
+      xnn_subgraph_t subgraph, TfLiteContext* logging_context,
+      const TfLiteTensor& output_tensor, int output_tensor_index,
+      BuiltinOperator op_type, int node_index, int num_dims,
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> dims,
+      const std::array<size_t, XNN_MAX_TENSOR_DIMS>& multiples,
+      uint32_t input_id, uint32_t output_id) {
+    int last_tiled_dim = -1;
+    for (int i = 0; i < num_dims; ++i) {
+      if (multiples[i] > 1) {
+        last_tiled_dim = i;
+      }
+    }
+    if (last_tiled_dim < 0) {
+      if (xnn_define_copy(subgraph, input_id, output_id, /*flags=*/0) !=
+          xnn_status_success) {
+        TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                           EnumNameBuiltinOperator(op_type), node_index);
+        return kTfLiteError;
+      }
+      return kTfLiteOk;
+    }
+
+    uint32_t current_id = input_id;
+    std::vector<uint32_t> copy_ids;
+    for (int i = 0; i <= last_tiled_dim; ++i) {
+      if (multiples[i] == 1) {
+        continue;
+      }
+      dims[i] *= multiples[i];
+      uint32_t next_id = output_id;
+      if (i != last_tiled_dim) {
+        TF_LITE_ENSURE_STATUS(DefineInternalTensor(
+            subgraph, logging_context, output_tensor, output_tensor_index,
+            num_dims, dims.data(), &next_id));
+      }
+      copy_ids.assign(multiples[i], current_id);
+      if (xnn_define_concatenate(subgraph, /*axis=*/i, copy_ids.size(),
+                                 copy_ids.data(), next_id,
+                                 /*flags=*/0) != xnn_status_success) {
+        TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                           EnumNameBuiltinOperator(op_type), node_index);
+        return kTfLiteError;
+      }
+      current_id = next_id;
+    }
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitNode(
       xnn_subgraph_t subgraph, Delegate& delegate, TfLiteContext* context,
       TfLiteRegistration* registration, TfLiteNode* node, int node_index,
@@ -2874,6 +3065,7 @@ class Subgraph {
 #endif
     switch (registration->builtin_code) {
       case kTfLiteBuiltinAbs:
+      case kTfLiteBuiltinCast:
       case kTfLiteBuiltinCeil:
       case kTfLiteBuiltinCos:
       case kTfLiteBuiltinDequantize:
@@ -2883,6 +3075,7 @@ class Subgraph {
       case kTfLiteBuiltinGelu:
       case kTfLiteBuiltinHardSwish:
       case kTfLiteBuiltinLeakyRelu:
+      case kTfLiteBuiltinLog:
       case kTfLiteBuiltinLogistic:
       case kTfLiteBuiltinNeg:
       case kTfLiteBuiltinQuantize:
@@ -2904,6 +3097,7 @@ class Subgraph {
       case kTfLiteBuiltinMaximum:
       case kTfLiteBuiltinMinimum:
       case kTfLiteBuiltinMul:
+      case kTfLiteBuiltinPow:
       case kTfLiteBuiltinPrelu:
       case kTfLiteBuiltinSquaredDifference:
       case kTfLiteBuiltinSub:
@@ -2932,6 +3126,10 @@ class Subgraph {
                                     node_index, node, context->tensors,
                                     batchmatmul_params, input_output_tensors);
       }
+      case kTfLiteBuiltinBroadcastTo:
+        return VisitBroadcastToNode(subgraph, delegate, logging_context,
+                                    node_index, node, context->tensors,
+                                    input_output_tensors);
       case kTfLiteBuiltinConcatenation: {
         const TfLiteConcatenationParams* concat_params =
             static_cast<const TfLiteConcatenationParams*>(node->builtin_data);
@@ -3026,6 +3224,13 @@ class Subgraph {
                                context->tensors, reducer_params,
                                input_output_tensors);
       }
+      case kTfLiteBuiltinPack: {
+        const TfLitePackParams* pack_params =
+            static_cast<const TfLitePackParams*>(node->builtin_data);
+        return VisitPackNode(subgraph, delegate, logging_context, node_index,
+                             node, context->tensors, pack_params,
+                             input_output_tensors);
+      }
       case kTfLiteBuiltinPad:
         return VisitPadNode(subgraph, delegate, logging_context, node_index,
                             node, context->tensors, input_output_tensors);
@@ -3082,6 +3287,9 @@ class Subgraph {
                                      node_index, node, context->tensors, params,
                                      input_output_tensors);
       }
+      case kTfLiteBuiltinTile:
+        return VisitTileNode(subgraph, delegate, logging_context, node_index,
+                             node, context->tensors, input_output_tensors);
       case kTfLiteBuiltinTranspose: {
         return VisitTransposeNode(subgraph, delegate, logging_context,
                                   node_index, node, context->tensors,
@@ -3096,6 +3304,13 @@ class Subgraph {
                                       deconv_params, quasi_static_tensors,
                                       input_output_tensors);
       }
+      case kTfLiteBuiltinUnpack: {
+        const TfLiteUnpackParams* unpack_params =
+            static_cast<const TfLiteUnpackParams*>(node->builtin_data);
+        return VisitUnpackNode(subgraph, delegate, logging_context, node_index,
+                               node, context->tensors, unpack_params,
+                               input_output_tensors);
+      }
       case kTfLiteBuiltinVarHandle:
         return VisitVarHandleNode(subgraph, delegate, logging_context,
                                   node_index, node);
@@ -3514,6 +3729,102 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  static TfLiteStatus VisitBroadcastToNode(
+      xnn_subgraph_t subgraph, const Delegate& delegate,
+      TfLiteContext* logging_context, int node_index, TfLiteNode* node,
+      const TfLiteTensor* tensors,
+      const std::unordered_map<int, uint32_t>& input_output_tensors) {
+    TF_LITE_ENSURE_STATUS(CheckNumInputsAndOutputs(
+        logging_context, node, 2, 1, BuiltinOperator_BROADCAST_TO, node_index));
+
+    const int input_id = node->inputs->data[0];
+    const int shape_id = node->inputs->data[1];
+    const int output_id = node->outputs->data[0];
+    const TfLiteTensor& input_tensor = tensors[input_id];
+    const TfLiteTensor& output_tensor = tensors[output_id];
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, input_tensor, input_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorShape(
+        logging_context, input_tensor, /*min_num_dims=*/0,
+        /*max_num_dims=*/XNN_MAX_TENSOR_DIMS, input_id,
+        BuiltinOperator_BROADCAST_TO, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, output_tensor, output_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorsQuantizationMatch(
+        logging_context, input_tensor, output_tensor,
+        BuiltinOperator_BROADCAST_TO, node_index));
+
+    std::array<size_t, XNN_MAX_TENSOR_DIMS> output_dims;
+    int num_output_dims = 0;
+    TF_LITE_ENSURE_STATUS(GetStaticIntTensorValues(
+        logging_context, tensors[shape_id], shape_id,
+        BuiltinOperator_BROADCAST_TO, node_index, output_dims,
+        num_output_dims));
+    const int num_input_dims = NumDimensions(&input_tensor);
+    if (num_input_dims > num_output_dims) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          logging_context,
+          "input rank (%d) exceeds output rank (%d) in %s node #%d",
+          num_input_dims, num_output_dims,
+          EnumNameBuiltinOperator(BuiltinOperator_BROADCAST_TO), node_index);
+      return kTfLiteError;
+    }
+
+    // Align the input with the output by prepending unit dimensions, then tile
+    // the unit dimensions up to the output size.
+    const int num_new_dims = num_output_dims - num_input_dims;
+    std::array<size_t, XNN_MAX_TENSOR_DIMS> input_dims;
+    std::array<size_t, XNN_MAX_TENSOR_DIMS> multiples;
+    for (int i = 0; i < num_output_dims; ++i) {
+      input_dims[i] = i < num_new_dims
+                          ? 1
+                          : SizeOfDimension(&input_tensor, i - num_new_dims);
+      if (input_dims[i] == output_dims[i]) {
+        multiples[i] = 1;
+      } else if (input_dims[i] == 1) {
+        multiples[i] = output_dims[i];
+      } else {
+        TF_LITE_MAYBE_KERNEL_LOG(
+            logging_context,
+            "cannot broadcast dimension #%d of size %zu to %zu in %s node #%d",
+            i, input_dims[i], output_dims[i],
+            EnumNameBuiltinOperator(BuiltinOperator_BROADCAST_TO), node_index);
+        return kTfLiteError;
+      }
+    }
+    TF_LITE_ENSURE_STATUS(CheckTileMultiples(logging_context, multiples,
+                                             num_output_dims,
+                                             BuiltinOperator_BROADCAST_TO,
+                                             node_index));
+
+    if (subgraph != nullptr) {
+      uint32_t aligned_input_id = input_output_tensors.at(input_id);
+      if (num_new_dims != 0) {
+        uint32_t reshaped_id = XNN_INVALID_VALUE_ID;
+        TF_LITE_ENSURE_STATUS(DefineInternalTensor(
+            subgraph, logging_context, output_tensor, output_id,
+            num_output_dims, input_dims.data(), &reshaped_id));
+        const xnn_status status = xnn_define_static_reshape(
+            subgraph, num_output_dims, input_dims.data(), aligned_input_id,
+            reshaped_id, /*flags=*/0);
+        if (status != xnn_status_success) {
+          TF_LITE_KERNEL_LOG(
+              logging_context, "failed to delegate %s node #%d",
+              EnumNameBuiltinOperator(BuiltinOperator_BROADCAST_TO),
+              node_index);
+          return kTfLiteError;
+        }
+        aligned_input_id = reshaped_id;
+      }
+      return DefineTile(subgraph, logging_context, output_tensor, output_id,
+                        BuiltinOperator_BROADCAST_TO, node_index,
+                        num_output_dims, input_dims, multiples,
+                        aligned_input_id, input_output_tensors.at(output_id));
+    }
+
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitConcatenationNode(
       xnn_subgraph_t subgraph, const Delegate& delegate,
       TfLiteContext* logging_context, int node_index, TfLiteNode* node,
@@ -4015,6 +4326,7 @@ class Subgraph {
       case BuiltinOperator_DIV:
       case BuiltinOperator_MAXIMUM:
       case BuiltinOperator_MINIMUM:
+      case BuiltinOperator_POW:
       case BuiltinOperator_PRELU:
       case BuiltinOperator_SQUARED_DIFFERENCE:
         TF_LITE_ENSURE_STATUS(CheckTensorFloat32Type(
@@ -4131,6 +4443,9 @@ class Subgraph {
         case BuiltinOperator_MUL:
           binary_op_type = xnn_binary_multiply;
           break;
+        case BuiltinOperator_POW:
+          binary_op_type = xnn_binary_pow;
+          break;
         case BuiltinOperator_PRELU:
           binary_op_type = xnn_binary_prelu;
           break;
@@ -4195,6 +4510,7 @@ class Subgraph {
       case BuiltinOperator_FLOOR:
       case BuiltinOperator_GELU:
       case BuiltinOperator_HARD_SWISH:
+      case BuiltinOperator_LOG:
       case BuiltinOperator_NEG:
       case BuiltinOperator_RELU_N1_TO_1:
       case BuiltinOperator_RELU:
@@ -4209,6 +4525,27 @@ class Subgraph {
         TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
             logging_context, output_tensor, output_id, node_index));
         break;
+      case BuiltinOperator_CAST:
+        // Only conversions between FP32 and FP16 are supported. Casts of
+        // static tensors are left to the CPU kernel, which can cache them.
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
+            logging_context, input_tensor, input_id, node_index));
+        TF_LITE_ENSURE_STATUS(CheckTensorFloatType(
+            logging_context, output_tensor, output_id, node_index));
+        if (input_tensor.type == output_tensor.type) {
+          TF_LITE_MAYBE_KERNEL_LOG(
+              logging_context,
+              "unsupported cast from %s to the same type in CAST node #%d",
+              TfLiteTypeGetName(input_tensor.type), node_index);
+          return kTfLiteError;
+        }
+        if (input_tensor.allocation_type == kTfLiteMmapRo) {
+          TF_LITE_MAYBE_KERNEL_LOG(
+              logging_context, "unsupported static input in CAST node #%d",
+              node_index);
+          return kTfLiteError;
+        }
+        break;
       case BuiltinOperator_DEQUANTIZE:
         TF_LITE_ENSURE_STATUS(CheckTensorQInt8OrQUInt8Type(
             delegate, logging_context, input_tensor, input_id, node_index));
@@ -4341,6 +4678,7 @@ class Subgraph {
         case BuiltinOperator_COS:
           unary_op_type = xnn_unary_cosine;
           break;
+        case BuiltinOperator_CAST:
         case BuiltinOperator_DEQUANTIZE:
         case BuiltinOperator_QUANTIZE:
           unary_op_type = xnn_unary_convert;
@@ -4372,6 +4710,9 @@ class Subgraph {
           unary_op_type = xnn_unary_leaky_relu;
           break;
         }
+        case BuiltinOperator_LOG:
+          unary_op_type = xnn_unary_log;
+          break;
         case BuiltinOperator_LOGISTIC:
           unary_op_type = xnn_unary_sigmoid;
           break;
@@ -5226,6 +5567,90 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  static TfLiteStatus VisitPackNode(
+      xnn_subgraph_t subgraph, const Delegate& delegate,
+      TfLiteContext* logging_context, int node_index, TfLiteNode* node,
+      const TfLiteTensor* tensors, const TfLitePackParams* pack_params,
+      const std::unordered_map<int, uint32_t>& input_output_tensors) {
+    TF_LITE_ENSURE_STATUS(CheckNumOutputs(logging_context, node, 1,
+                                          BuiltinOperator_PACK, node_index));
+    const int num_inputs = NumInputs(node);
+    const int output_id = node->outputs->data[0];
+    const TfLiteTensor& output_tensor = tensors[output_id];
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, output_tensor, output_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorShape(
+        logging_context, output_tensor, /*min_num_dims=*/1,
+        /*max_num_dims=*/XNN_MAX_TENSOR_DIMS, output_id, BuiltinOperator_PACK,
+        node_index));
+    for (int i = 0; i < num_inputs; i++) {
+      const int input_id = node->inputs->data[i];
+      const TfLiteTensor& input_tensor = tensors[input_id];
+      TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+          delegate, logging_context, input_tensor, input_id, node_index));
+      TF_LITE_ENSURE_STATUS(CheckTensorsQuantizationMatch(
+          logging_context, input_tensor, output_tensor, BuiltinOperator_PACK,
+          node_index));
+    }
+
+    const int num_dims = NumDimensions(&output_tensor);
+    int axis = pack_params->axis;
+    if (axis < 0) {
+      axis += num_dims;
+    }
+    if (axis < 0 || axis >= num_dims ||
+        SizeOfDimension(&output_tensor, axis) != num_inputs) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          logging_context, "invalid axis %d for %d inputs in %s node #%d",
+          pack_params->axis, num_inputs,
+          EnumNameBuiltinOperator(BuiltinOperator_PACK), node_index);
+      return kTfLiteError;
+    }
+
+    if (subgraph != nullptr) {
+      // Each input is reshaped to the output rank with a unit dimension at
+      // `axis`, and the reshaped inputs are concatenated along it.
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> dims;
+      for (int i = 0; i < num_dims; i++) {
+        dims[i] = SizeOfDimension(&output_tensor, i);
+      }
+      dims[axis] = 1;
+
+      std::vector<uint32_t> reshaped_ids(num_inputs,
+                                         input_output_tensors.at(output_id));
+      for (int i = 0; i < num_inputs; i++) {
+        if (num_inputs > 1) {
+          TF_LITE_ENSURE_STATUS(DefineInternalTensor(
+              subgraph, logging_context, output_tensor, output_id, num_dims,
+              dims.data(), &reshaped_ids[i]));
+        }
+        const xnn_status status = xnn_define_static_reshape(
+            subgraph, num_dims, dims.data(),
+            /*input_id=*/input_output_tensors.at(node->inputs->data[i]),
+            /*output_id=*/reshaped_ids[i], /*flags=*/0);
+        if (status != xnn_status_success) {
+          TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                             EnumNameBuiltinOperator(BuiltinOperator_PACK),
+                             node_index);
+          return kTfLiteError;
+        }
+      }
+      if (num_inputs > 1) {
+        const xnn_status status = xnn_define_concatenate(
+            subgraph, axis, num_inputs, reshaped_ids.data(),
+            /*output_id=*/input_output_tensors.at(output_id), /*flags=*/0);
+        if (status != xnn_status_success) {
+          TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                             EnumNameBuiltinOperator(BuiltinOperator_PACK),
+                             node_index);
+          return kTfLiteError;
+        }
+      }
+    }
+
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitReadVariableNode(
       xnn_subgraph_t subgraph, Delegate& delegate,
       TfLiteContext* logging_context, int node_index, const TfLiteNode* node,
@@ -5707,6 +6132,64 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  static TfLiteStatus VisitTileNode(
+      xnn_subgraph_t subgraph, const Delegate& delegate,
+      TfLiteContext* logging_context, int node_index, TfLiteNode* node,
+      const TfLiteTensor* tensors,
+      const std::unordered_map<int, uint32_t>& input_output_tensors) {
+    TF_LITE_ENSURE_STATUS(CheckNumInputsAndOutputs(
+        logging_context, node, 2, 1, BuiltinOperator_TILE, node_index));
+
+    const int input_id = node->inputs->data[0];
+    const int multiples_id = node->inputs->data[1];
+    const int output_id = node->outputs->data[0];
+    const TfLiteTensor& input_tensor = tensors[input_id];
+    const TfLiteTensor& output_tensor = tensors[output_id];
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, input_tensor, input_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorShape(
+        logging_context, input_tensor, /*min_num_dims=*/1,
+        /*max_num_dims=*/XNN_MAX_TENSOR_DIMS, input_id, BuiltinOperator_TILE,
+        node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, output_tensor, output_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorsQuantizationMatch(
+        logging_context, input_tensor, output_tensor, BuiltinOperator_TILE,
+        node_index));
+
+    std::array<size_t, XNN_MAX_TENSOR_DIMS> multiples;
+    int num_multiples = 0;
+    TF_LITE_ENSURE_STATUS(GetStaticIntTensorValues(
+        logging_context, tensors[multiples_id], multiples_id,
+        BuiltinOperator_TILE, node_index, multiples, num_multiples));
+    const int num_dims = NumDimensions(&input_tensor);
+    if (num_multiples != num_dims) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          logging_context,
+          "number of multiples (%d) doesn't match input rank (%d) in %s "
+          "node #%d",
+          num_multiples, num_dims,
+          EnumNameBuiltinOperator(BuiltinOperator_TILE), node_index);
+      return kTfLiteError;
+    }
+    TF_LITE_ENSURE_STATUS(CheckTileMultiples(
+        logging_context, multiples, num_dims, BuiltinOperator_TILE,
+        node_index));
+
+    if (subgraph != nullptr) {
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> dims;
+      for (int i = 0; i < num_dims; i++) {
+        dims[i] = SizeOfDimension(&input_tensor, i);
+      }
+      return DefineTile(subgraph, logging_context, output_tensor, output_id,
+                        BuiltinOperator_TILE, node_index, num_dims, dims,
+                        multiples, input_output_tensors.at(input_id),
+                        input_output_tensors.at(output_id));
+    }
+
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitTransposeNode(
       xnn_subgraph_t subgraph, const Delegate& delegate,
       TfLiteContext* logging_context, int node_index, TfLiteNode* node,
@@ -6623,6 +7106,95 @@ class Subgraph {
     return kTfLiteOk;
   }
 
+  static TfLiteStatus VisitUnpackNode(
+      xnn_subgraph_t subgraph, const Delegate& delegate,
+      TfLiteContext* logging_context, int node_index, TfLiteNode* node,
+      const TfLiteTensor* tensors, const TfLiteUnpackParams* unpack_params,
+      const std::unordered_map<int, uint32_t>& input_output_tensors) {
+    TF_LITE_ENSURE_STATUS(CheckNumInputs(logging_context, node, 1,
+                                         BuiltinOperator_UNPACK, node_index));
+    const int num_outputs = NumOutputs(node);
+    const int input_id = node->inputs->data[0];
+    const TfLiteTensor& input_tensor = tensors[input_id];
+    TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+        delegate, logging_context, input_tensor, input_id, node_index));
+    TF_LITE_ENSURE_STATUS(CheckTensorShape(
+        logging_context, input_tensor, /*min_num_dims=*/1,
+        /*max_num_dims=*/XNN_MAX_TENSOR_DIMS, input_id, BuiltinOperator_UNPACK,
+        node_index));
+    for (int i = 0; i < num_outputs; i++) {
+      const int output_id = node->outputs->data[i];
+      const TfLiteTensor& output_tensor = tensors[output_id];
+      TF_LITE_ENSURE_STATUS(CheckTensorFloat32OrQUInt8Type(
+          delegate, logging_context, output_tensor, output_id, node_index));
+      TF_LITE_ENSURE_STATUS(CheckTensorsQuantizationMatch(
+          logging_context, input_tensor, output_tensor, BuiltinOperator_UNPACK,
+          node_index));
+    }
+
+    const int num_dims = NumDimensions(&input_tensor);
+    int axis = unpack_params->axis;
+    if (axis < 0) {
+      axis += num_dims;
+    }
+    if (axis < 0 || axis >= num_dims ||
+        SizeOfDimension(&input_tensor, axis) != num_outputs) {
+      TF_LITE_MAYBE_KERNEL_LOG(
+          logging_context, "invalid axis %d for %d outputs in %s node #%d",
+          unpack_params->axis, num_outputs,
+          EnumNameBuiltinOperator(BuiltinOperator_UNPACK), node_index);
+      return kTfLiteError;
+    }
+
+    if (subgraph != nullptr) {
+      // The input is split evenly along `axis`, and the unit dimension is then
+      // reshaped away from each slice.
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> split_dims;
+      std::array<size_t, XNN_MAX_TENSOR_DIMS> output_dims;
+      for (int i = 0, j = 0; i < num_dims; i++) {
+        split_dims[i] = SizeOfDimension(&input_tensor, i);
+        if (i != axis) {
+          output_dims[j++] = split_dims[i];
+        }
+      }
+      split_dims[axis] = 1;
+
+      std::vector<uint32_t> split_ids(num_outputs,
+                                      input_output_tensors.at(input_id));
+      if (num_outputs > 1) {
+        for (int i = 0; i < num_outputs; i++) {
+          TF_LITE_ENSURE_STATUS(DefineInternalTensor(
+              subgraph, logging_context, input_tensor, input_id, num_dims,
+              split_dims.data(), &split_ids[i]));
+        }
+        const xnn_status status = xnn_define_even_split(
+            subgraph, axis, /*input_id=*/input_output_tensors.at(input_id),
+            num_outputs, split_ids.data(), /*flags=*/0);
+        if (status != xnn_status_success) {
+          TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                             EnumNameBuiltinOperator(BuiltinOperator_UNPACK),
+                             node_index);
+          return kTfLiteError;
+        }
+      }
+      for (int i = 0; i < num_outputs; i++) {
+        const xnn_status status = xnn_define_static_reshape(
+            subgraph, num_dims - 1, output_dims.data(),
+            /*input_id=*/split_ids[i],
+            /*output_id=*/input_output_tensors.at(node->outputs->data[i]),
+            /*flags=*/0);
+        if (status != xnn_status_success) {
+          TF_LITE_KERNEL_LOG(logging_context, "failed to delegate %s node #%d",
+                             EnumNameBuiltinOperator(BuiltinOperator_UNPACK),
+                             node_index);
+          return kTfLiteError;
+        }
+      }
+    }
+
+    return kTfLiteOk;
+  }
+
   static TfLiteStatus VisitVarHandleNode(xnn_subgraph_t subgraph,
                                          Delegate& delegate,
                                          TfLiteContext* logging_context,
@@ -121,6 +121,15 @@ typedef struct {
   // the weight cache will only be loaded from this if `weights_cache` is
   // undefined.
   void* weight_cache_provider;
+  // Points to a `tflite::MemoryPlacement` the weight cache is copied to when
+  // it is loaded, e.g. to give the delegates of the interpreters running on
+  // each NUMA node their own replica of the packed weights. See
+  // `MMapWeightCacheProvider::SetMemoryPlacement`. NULL reads the packed
+  // weights from the file mapping.
+  //
+  // Warning: Only read when the delegate is created, ownership is **NOT**
+  // taken by the XNNPack delegate.
+  const void* weight_cache_memory_placement;
 } TfLiteXNNPackDelegateOptions;
 
 // Returns true on systems that support running the in-memory weight cache
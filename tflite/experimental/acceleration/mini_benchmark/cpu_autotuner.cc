@@ -0,0 +1,269 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_autotuner.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "flatbuffers/buffer.h"  // from @flatbuffers
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/big_little_affinity.h"
+#include "tflite/experimental/acceleration/mini_benchmark/blocking_validator_runner.h"
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+#include "tflite/experimental/acceleration/mini_benchmark/validator_runner_options.h"
+#include "tflite/minimal_logging.h"
+
+namespace tflite {
+namespace acceleration {
+
+namespace {
+
+int64_t MedianInferenceTimeUs(const BenchmarkEvent& event) {
+  if (event.result() == nullptr ||
+      event.result()->inference_time_us() == nullptr) {
+    return -1;
+  }
+  std::vector<int64_t> latencies;
+  for (int64_t latency : *event.result()->inference_time_us()) {
+    if (latency >= 0) latencies.push_back(latency);
+  }
+  if (latencies.empty()) {
+    return -1;
+  }
+  auto middle = latencies.begin() + latencies.size() / 2;
+  std::nth_element(latencies.begin(), middle, latencies.end());
+  return *middle;
+}
+
+}  // namespace
+
+void FillDefaultCpuTuningSpace(CpuTuningSpace* space) {
+  const int num_cpus =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  if (space->num_threads.empty()) {
+    for (int n = 1; n < num_cpus; n *= 2) {
+      space->num_threads.push_back(n);
+    }
+    space->num_threads.push_back(num_cpus);
+  }
+  if (space->xnnpack_flags.empty()) {
+    const int32_t base = XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_QS8_QU8;
+    space->xnnpack_flags = {
+        base,
+        base | XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_FORCE_FP16,
+        base |
+            XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_DYNAMIC_FULLY_CONNECTED,
+        base |
+            XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_TRANSIENT_INDIRECTION_BUFFER,
+    };
+  }
+  if (space->affinity_masks.empty()) {
+    space->affinity_masks.push_back(0);
+    const BigLittleAffinity affinity = GetAffinity();
+    if (affinity.big_core_affinity != 0 && affinity.little_core_affinity != 0) {
+      space->affinity_masks.push_back(affinity.big_core_affinity);
+    }
+  }
+}
+
+CpuAutotuner::CpuAutotuner(const ValidatorRunnerOptions& options,
+                           CpuTuningSpace space)
+    : storage_path_(options.storage_path),
+      weight_cache_file_path_(
+          absl::StrCat(options.storage_path, ".xnnpack_cache")),
+      evaluator_(options.benchmark_result_evaluator),
+      space_(std::move(space)),
+      runner_(options) {
+  FillDefaultCpuTuningSpace(&space_);
+}
+
+MinibenchmarkStatus CpuAutotuner::Init() { return runner_.Init(); }
+
+std::vector<CpuAutotuner::Measurement> CpuAutotuner::Benchmark(
+    const std::vector<CpuTuningConfig>& configs) {
+  std::vector<Measurement> measurements;
+  std::vector<uint64_t> masks;
+  for (const CpuTuningConfig& config : configs) {
+    if (std::find(masks.begin(), masks.end(), config.affinity_mask) ==
+        masks.end()) {
+      masks.push_back(config.affinity_mask);
+    }
+  }
+
+  ScopedThreadAffinity affinity;
+  for (uint64_t mask : masks) {
+    std::vector<CpuTuningConfig> group;
+    std::vector<TFLiteSettingsT> group_settings;
+    std::vector<flatbuffers::FlatBufferBuilder> buffers;
+    std::vector<const TFLiteSettings*> for_settings;
+    for (const CpuTuningConfig& config : configs) {
+      if (config.affinity_mask != mask) continue;
+      TFLiteSettingsT settings;
+      CpuTuningConfigToSettings(config, &settings);
+      flatbuffers::FlatBufferBuilder fbb;
+      fbb.Finish(TFLiteSettings::Pack(fbb, &settings));
+      group.push_back(config);
+      group_settings.push_back(std::move(settings));
+      buffers.push_back(std::move(fbb));
+    }
+    for (const auto& fbb : buffers) {
+      for_settings.push_back(
+          flatbuffers::GetRoot<TFLiteSettings>(fbb.GetBufferPointer()));
+    }
+
+    // The validation process or thread inherits the affinity of the thread
+    // starting it.
+    if (affinity.Set(mask) != kMinibenchmarkSuccess) {
+      continue;
+    }
+    std::vector<flatbuffers::FlatBufferBuilder> results =
+        runner_.TriggerValidation(for_settings);
+    affinity.Restore();
+
+    // Results come back in completion order, so they are matched to the
+    // configurations by their settings.
+    for (auto& result : results) {
+      const BenchmarkEvent* event =
+          flatbuffers::GetRoot<BenchmarkEvent>(result.GetBufferPointer());
+      if (event->tflite_settings() == nullptr) continue;
+      TFLiteSettingsT event_settings;
+      event->tflite_settings()->UnPackTo(&event_settings);
+      auto it = std::find(group_settings.begin(), group_settings.end(),
+                          event_settings);
+      if (it == group_settings.end()) continue;
+
+      Measurement measurement;
+      measurement.config = group[it - group_settings.begin()];
+      if (evaluator_->IsValidationSuccessEvent(*event)) {
+        measurement.inference_time_us = MedianInferenceTimeUs(*event);
+      }
+      measurement.event = std::move(result);
+      measurements.push_back(std::move(measurement));
+    }
+  }
+  return measurements;
+}
+
+MinibenchmarkStatus CpuAutotuner::Tune(CpuTuningResult* result) {
+  CpuTuningConfig best;
+  best.num_threads = space_.num_threads.front();
+  best.xnnpack_flags = space_.xnnpack_flags.front();
+  best.affinity_mask = space_.affinity_masks.front();
+  int64_t best_time_us = -1;
+  flatbuffers::FlatBufferBuilder best_event;
+  int number_of_source_events = 0;
+
+  // Benchmarks the values of one dimension with the others fixed at the best
+  // found so far. The incumbent is re-run with them so that all are measured
+  // under the same conditions. Ties go to the configuration listed first,
+  // which is the incumbent if `incumbent_first`.
+  auto tune_dimension =
+      [&](size_t num_values, bool incumbent_first,
+          const std::function<void(size_t, CpuTuningConfig*)>& set_value) {
+        std::vector<CpuTuningConfig> configs;
+        if (incumbent_first) configs.push_back(best);
+        for (size_t i = 0; i < num_values; ++i) {
+          CpuTuningConfig config = best;
+          set_value(i, &config);
+          if (std::find(configs.begin(), configs.end(), config) ==
+              configs.end()) {
+            configs.push_back(config);
+          }
+        }
+        // Nothing to compare once the incumbent has been measured.
+        if (configs.size() < 2 && best_time_us >= 0) return;
+        std::vector<Measurement> measurements = Benchmark(configs);
+        number_of_source_events += static_cast<int>(measurements.size());
+        auto rank = [&](const Measurement& measurement) {
+          return std::find(configs.begin(), configs.end(), measurement.config) -
+                 configs.begin();
+        };
+        Measurement* fastest = nullptr;
+        for (Measurement& measurement : measurements) {
+          if (measurement.inference_time_us < 0) continue;
+          if (fastest == nullptr ||
+              measurement.inference_time_us < fastest->inference_time_us ||
+              (measurement.inference_time_us == fastest->inference_time_us &&
+               rank(measurement) < rank(*fastest))) {
+            fastest = &measurement;
+          }
+        }
+        if (fastest == nullptr) return;
+        best = fastest->config;
+        best_time_us = fastest->inference_time_us;
+        best_event = std::move(fastest->event);
+      };
+
+  tune_dimension(space_.num_threads.size(), /*incumbent_first=*/true,
+                 [&](size_t i, CpuTuningConfig* config) {
+                   config->num_threads = space_.num_threads[i];
+                 });
+  tune_dimension(space_.affinity_masks.size(), /*incumbent_first=*/true,
+                 [&](size_t i, CpuTuningConfig* config) {
+                   config->affinity_mask = space_.affinity_masks[i];
+                 });
+  tune_dimension(space_.xnnpack_flags.size(), /*incumbent_first=*/true,
+                 [&](size_t i, CpuTuningConfig* config) {
+                   config->xnnpack_flags = space_.xnnpack_flags[i];
+                 });
+  if (space_.try_weight_cache) {
+    // The cache is listed first so that it wins ties.
+    tune_dimension(2, /*incumbent_first=*/false,
+                   [&](size_t i, CpuTuningConfig* config) {
+                     config->weight_cache_file_path =
+                         i == 0 ? weight_cache_file_path_ : "";
+                   });
+  }
+
+  if (best_time_us < 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_WARNING,
+                    "No CPU configuration passed validation for %s.",
+                    storage_path_.c_str());
+    return kMinibenchmarkNoSettingsPassedValidation;
+  }
+
+  CpuTuningResult tuned;
+  tuned.config = best;
+  tuned.inference_time_us = best_time_us;
+  tuned.number_of_source_events = number_of_source_events;
+  MinibenchmarkStatus status = StoreCpuTuningResult(
+      storage_path_,
+      *flatbuffers::GetRoot<BenchmarkEvent>(best_event.GetBufferPointer()),
+      tuned);
+  if (status != kMinibenchmarkSuccess) {
+    return status;
+  }
+  TFLITE_LOG_PROD(TFLITE_LOG_INFO,
+                  "Tuned CPU settings for %s: %d threads, XNNPACK flags 0x%x, "
+                  "weight cache %s, affinity 0x%llx, %lld us.",
+                  storage_path_.c_str(), best.num_threads, best.xnnpack_flags,
+                  best.weight_cache_file_path.empty() ? "off" : "on",
+                  static_cast<unsigned long long>(best.affinity_mask),
+                  static_cast<long long>(best_time_us));
+  *result = std::move(tuned);
+  return kMinibenchmarkSuccess;
+}
+
+}  // namespace acceleration
+}  // namespace tflite
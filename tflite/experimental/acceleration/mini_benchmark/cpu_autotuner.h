@@ -0,0 +1,99 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_AUTOTUNER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_AUTOTUNER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/experimental/acceleration/mini_benchmark/blocking_validator_runner.h"
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+#include "tflite/experimental/acceleration/mini_benchmark/validator_runner_options.h"
+
+namespace tflite {
+namespace acceleration {
+
+// The values tried for each dimension of the CPU tuning space. Empty
+// dimensions are filled in by FillDefaultCpuTuningSpace().
+struct CpuTuningSpace {
+  // Defaults to the powers of two below the number of CPUs, and the number of
+  // CPUs.
+  std::vector<int> num_threads;
+  // Defaults to QS8 | QU8, alone and with each of FORCE_FP16,
+  // DYNAMIC_FULLY_CONNECTED and TRANSIENT_INDIRECTION_BUFFER.
+  std::vector<int32_t> xnnpack_flags;
+  // Defaults to all CPUs (0) and, on big.LITTLE hosts, the big cores.
+  std::vector<uint64_t> affinity_masks;
+  // Whether to try the XNNPACK weight cache.
+  bool try_weight_cache = true;
+};
+
+// Fills in the empty dimensions of `space` for the current host.
+void FillDefaultCpuTuningSpace(CpuTuningSpace* space);
+
+// Finds the fastest CPU configuration of a model on the current host by
+// running it in the mini-benchmark's validation process, and stores it where
+// LoadCpuTuningResult() finds it.
+//
+// Benchmarking every point of the space would take minutes, so it is searched
+// one dimension at a time, in the order threads, affinity, XNNPACK flags and
+// weight cache, keeping the fastest value of each dimension before moving to
+// the next. Configurations whose outputs fail validation (e.g. FORCE_FP16 on a
+// model that needs fp32 accuracy) are never picked. The weight cache mostly
+// saves initialization time and memory, so it is only kept if inference is at
+// least as fast with it.
+//
+// Like BlockingValidatorRunner, this is thread-safe as long as instances
+// don't share a storage_path.
+class CpuAutotuner {
+ public:
+  // `options.storage_path` must be model-specific; the results are stored
+  // next to it, keyed by CpuHostType().
+  explicit CpuAutotuner(const ValidatorRunnerOptions& options,
+                        CpuTuningSpace space = CpuTuningSpace());
+
+  MinibenchmarkStatus Init();
+
+  // Searches the tuning space and stores the best configuration found in the
+  // results file. On success, also returns it in `result`.
+  MinibenchmarkStatus Tune(CpuTuningResult* result);
+
+ private:
+  struct Measurement {
+    CpuTuningConfig config;
+    // Median inference latency, or -1 if the configuration failed.
+    int64_t inference_time_us = -1;
+    flatbuffers::FlatBufferBuilder event;
+  };
+
+  // Benchmarks `configs`, grouping them by affinity mask since the mask is
+  // applied to the whole validation run.
+  std::vector<Measurement> Benchmark(
+      const std::vector<CpuTuningConfig>& configs);
+
+  const std::string storage_path_;
+  const std::string weight_cache_file_path_;
+  AbstractBenchmarkResultEvaluator* evaluator_;
+  CpuTuningSpace space_;
+  BlockingValidatorRunner runner_;
+};
+
+}  // namespace acceleration
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_AUTOTUNER_H_
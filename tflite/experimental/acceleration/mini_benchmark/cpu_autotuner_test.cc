@@ -0,0 +1,112 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_autotuner.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/benchmark_result_evaluator.h"
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+#include "tflite/experimental/acceleration/mini_benchmark/embedded_mobilenet_validation_model.h"
+#include "tflite/experimental/acceleration/mini_benchmark/mini_benchmark_test_helper.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+#include "tflite/experimental/acceleration/mini_benchmark/validator_runner_options.h"
+
+namespace tflite {
+namespace acceleration {
+namespace {
+
+class AcceptAllResultEvaluator : public AbstractBenchmarkResultEvaluator {
+ public:
+  bool HasPassedAccuracyCheck(const BenchmarkResult& result) override {
+    return true;
+  }
+};
+
+TEST(CpuTuningSpaceTest, Defaults) {
+  CpuTuningSpace space;
+  FillDefaultCpuTuningSpace(&space);
+  const int num_cpus =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  ASSERT_FALSE(space.num_threads.empty());
+  EXPECT_EQ(space.num_threads.front(), 1);
+  EXPECT_EQ(space.num_threads.back(), num_cpus);
+  EXPECT_EQ(space.xnnpack_flags.size(), 4);
+  ASSERT_FALSE(space.affinity_masks.empty());
+  EXPECT_EQ(space.affinity_masks.front(), 0);
+  EXPECT_TRUE(space.try_weight_cache);
+
+  CpuTuningSpace custom;
+  custom.num_threads = {2};
+  FillDefaultCpuTuningSpace(&custom);
+  EXPECT_EQ(custom.num_threads, std::vector<int>({2}));
+}
+
+TEST(CpuAutotunerTest, TunesAndStoresResult) {
+  MiniBenchmarkTestHelper helper;
+  if (!helper.should_perform_test()) {
+    std::cerr << "Skipping test";
+    return;
+  }
+
+  AcceptAllResultEvaluator evaluator;
+  ValidatorRunnerOptions options;
+  options.model_path = helper.DumpToTempFile(
+      "mobilenet_quant_with_validation.tflite",
+      g_tflite_acceleration_embedded_mobilenet_validation_model,
+      g_tflite_acceleration_embedded_mobilenet_validation_model_len);
+  ASSERT_FALSE(options.model_path.empty());
+  options.data_directory_path = ::testing::TempDir();
+  options.storage_path =
+      absl::StrCat(::testing::TempDir(), "cpu_autotuner_storage.fb");
+  unlink(CpuTuningResultsPath(options.storage_path).c_str());
+  options.per_test_timeout_ms = 10000;
+  options.benchmark_result_evaluator = &evaluator;
+
+  CpuTuningSpace space;
+  space.num_threads = {1, 2};
+  space.xnnpack_flags = {XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_QS8_QU8};
+  space.affinity_masks = {0};
+  CpuAutotuner tuner(options, space);
+  ASSERT_EQ(tuner.Init(), kMinibenchmarkSuccess);
+
+  CpuTuningResult result;
+  ASSERT_EQ(tuner.Tune(&result), kMinibenchmarkSuccess);
+  EXPECT_TRUE(result.config.num_threads == 1 ||
+              result.config.num_threads == 2);
+  EXPECT_EQ(result.config.xnnpack_flags,
+            XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_QS8_QU8);
+  EXPECT_GT(result.inference_time_us, 0);
+  // Two thread counts and two weight cache settings. The single-valued
+  // dimensions aren't benchmarked.
+  EXPECT_EQ(result.number_of_source_events, 4);
+
+  CpuTuningResult loaded;
+  ASSERT_TRUE(LoadCpuTuningResult(options.storage_path, &loaded));
+  EXPECT_EQ(loaded.config, result.config);
+  EXPECT_EQ(loaded.inference_time_us, result.inference_time_us);
+}
+
+}  // namespace
+}  // namespace acceleration
+}  // namespace tflite
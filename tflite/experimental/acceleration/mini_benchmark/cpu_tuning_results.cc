@@ -0,0 +1,275 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "include/cpuinfo.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/fb_storage.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+#include "tflite/minimal_logging.h"
+
+namespace tflite {
+namespace acceleration {
+
+const char kCpuAffinityMaskMetric[] = "cpu_affinity_mask";
+
+namespace {
+
+constexpr int kAffinityMaskWords = 4;
+constexpr int kAffinityWordBits = 16;
+
+}  // namespace
+
+std::string CpuHostType() {
+  std::string host_type = "cpu";
+  if (cpuinfo_initialize() && cpuinfo_get_clusters_count() > 0) {
+    // Hosts are told apart by their core clusters: the same micro-architectures
+    // with the same core counts and clocks should agree on the best settings.
+    for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); ++i) {
+      const struct cpuinfo_cluster* cluster = cpuinfo_get_cluster(i);
+      absl::StrAppend(&host_type, "_",
+                      absl::Hex(static_cast<uint32_t>(cluster->uarch)), "x",
+                      cluster->core_count);
+      if (cluster->frequency > 0) {
+        absl::StrAppend(&host_type, "at", cluster->frequency / 1000000,
+                        "MHz");
+      }
+    }
+  } else {
+    absl::StrAppend(&host_type, "_unknownx",
+                    std::thread::hardware_concurrency());
+  }
+  for (char& c : host_type) {
+    if (!absl::ascii_isalnum(c)) c = '_';
+  }
+  return host_type;
+}
+
+std::string CpuTuningResultsPath(absl::string_view storage_path) {
+  return absl::StrCat(storage_path, ".cpu_tuning.", CpuHostType());
+}
+
+void CpuTuningConfigToSettings(const CpuTuningConfig& config,
+                               TFLiteSettingsT* settings) {
+  settings->delegate = Delegate_XNNPACK;
+  settings->xnnpack_settings = std::make_unique<XNNPackSettingsT>();
+  settings->xnnpack_settings->num_threads = config.num_threads;
+  settings->xnnpack_settings->flags =
+      static_cast<XNNPackFlags>(config.xnnpack_flags);
+  settings->xnnpack_settings->weight_cache_file_path =
+      config.weight_cache_file_path;
+  // Ops that XNNPACK doesn't take run on the interpreter's own threads.
+  settings->cpu_settings = std::make_unique<CPUSettingsT>();
+  settings->cpu_settings->num_threads = config.num_threads;
+}
+
+void CpuTuningConfigFromSettings(const TFLiteSettings& settings,
+                                 CpuTuningConfig* config) {
+  if (settings.cpu_settings() != nullptr) {
+    config->num_threads = settings.cpu_settings()->num_threads();
+  }
+  const XNNPackSettings* xnnpack_settings = settings.xnnpack_settings();
+  if (xnnpack_settings == nullptr) {
+    return;
+  }
+  config->num_threads = xnnpack_settings->num_threads();
+  config->xnnpack_flags = xnnpack_settings->flags();
+  if (xnnpack_settings->weight_cache_file_path() != nullptr) {
+    config->weight_cache_file_path =
+        xnnpack_settings->weight_cache_file_path()->str();
+  } else {
+    config->weight_cache_file_path.clear();
+  }
+}
+
+MinibenchmarkStatus StoreCpuTuningResult(absl::string_view storage_path,
+                                         const BenchmarkEvent& event,
+                                         const CpuTuningResult& result) {
+  auto min_latency_event = std::make_unique<BenchmarkEventT>();
+  event.UnPackTo(min_latency_event.get());
+  if (min_latency_event->result == nullptr) {
+    min_latency_event->result = std::make_unique<BenchmarkResultT>();
+  }
+  // Floats represent integers exactly only up to 2^24, so the mask is split
+  // into words.
+  auto affinity_metric = std::make_unique<BenchmarkMetricT>();
+  affinity_metric->name = kCpuAffinityMaskMetric;
+  for (int i = 0; i < kAffinityMaskWords; ++i) {
+    affinity_metric->values.push_back(static_cast<float>(
+        (result.config.affinity_mask >> (i * kAffinityWordBits)) & 0xffff));
+  }
+  min_latency_event->result->metrics.push_back(std::move(affinity_metric));
+
+  MiniBenchmarkEventT mini_benchmark_event;
+  mini_benchmark_event.best_acceleration_decision =
+      std::make_unique<BestAccelerationDecisionT>();
+  mini_benchmark_event.best_acceleration_decision->number_of_source_events =
+      result.number_of_source_events;
+  mini_benchmark_event.best_acceleration_decision->min_latency_event =
+      std::move(min_latency_event);
+  mini_benchmark_event.best_acceleration_decision->min_inference_time_us =
+      result.inference_time_us;
+
+  flatbuffers::FlatBufferBuilder fbb;
+  FlatbufferStorage<MiniBenchmarkEvent> storage(
+      CpuTuningResultsPath(storage_path));
+  return storage.Append(&fbb,
+                        MiniBenchmarkEvent::Pack(fbb, &mini_benchmark_event));
+}
+
+bool LoadCpuTuningResult(absl::string_view storage_path,
+                         CpuTuningResult* result) {
+  const std::string path = CpuTuningResultsPath(storage_path);
+  // Reading the storage creates the file, which shouldn't happen on hosts that
+  // have never been tuned.
+  if (access(path.c_str(), F_OK) != 0) {
+    return false;
+  }
+  FlatbufferStorage<MiniBenchmarkEvent> storage(path);
+  if (storage.Read() != kMinibenchmarkSuccess) {
+    return false;
+  }
+  for (int i = static_cast<int>(storage.Count()) - 1; i >= 0; --i) {
+    const MiniBenchmarkEvent* event = storage.Get(i);
+    if (event == nullptr || event->best_acceleration_decision() == nullptr) {
+      continue;
+    }
+    const BestAccelerationDecision* decision =
+        event->best_acceleration_decision();
+    const BenchmarkEvent* best_event = decision->min_latency_event();
+    if (best_event == nullptr || best_event->tflite_settings() == nullptr) {
+      continue;
+    }
+
+    *result = CpuTuningResult();
+    CpuTuningConfigFromSettings(*best_event->tflite_settings(),
+                                &result->config);
+    result->inference_time_us = decision->min_inference_time_us();
+    result->number_of_source_events = decision->number_of_source_events();
+    if (best_event->result() != nullptr &&
+        best_event->result()->metrics() != nullptr) {
+      for (const BenchmarkMetric* metric : *best_event->result()->metrics()) {
+        if (metric->name() == nullptr ||
+            metric->name()->str() != kCpuAffinityMaskMetric ||
+            metric->values() == nullptr) {
+          continue;
+        }
+        for (uint32_t w = 0;
+             w < metric->values()->size() && w < kAffinityMaskWords; ++w) {
+          result->config.affinity_mask |=
+              static_cast<uint64_t>(metric->values()->Get(w))
+              << (w * kAffinityWordBits);
+        }
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+uint64_t GetCurrentThreadAffinity() {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+    return 0;
+  }
+  uint64_t mask = 0;
+  for (int i = 0; i < 64; ++i) {
+    if (CPU_ISSET(i, &set)) mask |= uint64_t{1} << i;
+  }
+  return mask;
+#else   // !__linux__
+  return 0;
+#endif  // __linux__
+}
+
+MinibenchmarkStatus SetCurrentThreadAffinity(uint64_t mask) {
+  if (mask == 0) {
+    return kMinibenchmarkSuccess;
+  }
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int i = 0; i < 64; ++i) {
+    if (mask & (uint64_t{1} << i)) CPU_SET(i, &set);
+  }
+  // A pid of 0 is the calling thread, not the whole process.
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_WARNING,
+                    "Could not set CPU affinity to 0x%llx: errno %d",
+                    static_cast<unsigned long long>(mask), errno);
+    return kMinibenchmarkUnableToSetCpuAffinity;
+  }
+  return kMinibenchmarkSuccess;
+#else   // !__linux__
+  return kMinibenchmarkUnsupportedPlatform;
+#endif  // __linux__
+}
+
+ScopedThreadAffinity::ScopedThreadAffinity() {
+#if defined(__linux__)
+  CPU_ZERO(&saved_set_);
+  saved_ = sched_getaffinity(0, sizeof(saved_set_), &saved_set_) == 0;
+#endif  // __linux__
+}
+
+ScopedThreadAffinity::~ScopedThreadAffinity() { Restore(); }
+
+MinibenchmarkStatus ScopedThreadAffinity::Set(uint64_t mask) {
+  if (mask == 0) {
+    Restore();
+    return kMinibenchmarkSuccess;
+  }
+#if defined(__linux__)
+  // Without the saved set, the change couldn't be undone.
+  if (!saved_) {
+    return kMinibenchmarkUnableToSetCpuAffinity;
+  }
+#endif  // __linux__
+  const MinibenchmarkStatus status = SetCurrentThreadAffinity(mask);
+  if (status == kMinibenchmarkSuccess) changed_ = true;
+  return status;
+}
+
+void ScopedThreadAffinity::Restore() {
+  if (!changed_) return;
+  changed_ = false;
+#if defined(__linux__)
+  if (sched_setaffinity(0, sizeof(saved_set_), &saved_set_) != 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_WARNING,
+                    "Could not restore the CPU affinity: errno %d", errno);
+  }
+#endif  // __linux__
+}
+
+}  // namespace acceleration
+}  // namespace tflite
@@ -0,0 +1,136 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_TUNING_RESULTS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_TUNING_RESULTS_H_
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+
+namespace tflite {
+namespace acceleration {
+
+// One point of the CPU tuning space: how the XNNPACK delegate is configured
+// and which cores the inference threads may run on.
+struct CpuTuningConfig {
+  int num_threads = 1;
+  // Bitwise OR of TfLiteXNNPackDelegateFlags.
+  int32_t xnnpack_flags = 0;
+  // Empty if the weight cache isn't used.
+  std::string weight_cache_file_path;
+  // Bit i set if the threads may run on CPU i. 0 leaves the affinity alone.
+  uint64_t affinity_mask = 0;
+
+  bool operator==(const CpuTuningConfig& other) const {
+    return num_threads == other.num_threads &&
+           xnnpack_flags == other.xnnpack_flags &&
+           weight_cache_file_path == other.weight_cache_file_path &&
+           affinity_mask == other.affinity_mask;
+  }
+};
+
+// The best configuration found by the CPU autotuner for a model on a type of
+// host.
+struct CpuTuningResult {
+  CpuTuningConfig config;
+  // Median inference latency of `config` during tuning.
+  int64_t inference_time_us = -1;
+  // How many configurations were benchmarked to pick `config`.
+  int number_of_source_events = 0;
+};
+
+// Name of the BenchmarkMetric in which the affinity mask of the tuned
+// configuration is recorded, as 16-bit words, least significant first. The
+// mask isn't part of TFLiteSettings so it's kept next to the latencies.
+extern const char kCpuAffinityMaskMetric[];
+
+// Returns a string identifying the type of the host CPU (model name and core
+// count), safe to use as part of a file name. Tuning results are only valid on
+// the host type they were collected on.
+std::string CpuHostType();
+
+// Returns the path of the file holding the tuning results of the model whose
+// mini-benchmark storage is `storage_path`, for the current host type.
+std::string CpuTuningResultsPath(absl::string_view storage_path);
+
+// Builds the TFLiteSettings benchmarked for `config`.
+void CpuTuningConfigToSettings(const CpuTuningConfig& config,
+                               TFLiteSettingsT* settings);
+
+// Reads back the configuration from settings built with
+// CpuTuningConfigToSettings(). The affinity mask is left untouched.
+void CpuTuningConfigFromSettings(const TFLiteSettings& settings,
+                                 CpuTuningConfig* config);
+
+// Appends `result` to the results file of `storage_path` as a
+// MiniBenchmarkEvent with a best_acceleration_decision. `event` is the
+// benchmark event of the winning configuration.
+MinibenchmarkStatus StoreCpuTuningResult(absl::string_view storage_path,
+                                         const BenchmarkEvent& event,
+                                         const CpuTuningResult& result);
+
+// Reads the most recent result stored by StoreCpuTuningResult() for the
+// current host type. Returns false if the model hasn't been tuned on this host
+// type or the results file can't be read.
+bool LoadCpuTuningResult(absl::string_view storage_path,
+                         CpuTuningResult* result);
+
+// Returns the affinity mask of the calling thread, or 0 if it can't be queried
+// on this platform. Only covers the first 64 CPUs, use ScopedThreadAffinity to
+// save and restore the affinity.
+uint64_t GetCurrentThreadAffinity();
+
+// Restricts the calling thread, and the threads and processes it creates from
+// now on, to the CPUs in `mask`. Does nothing if `mask` is 0.
+MinibenchmarkStatus SetCurrentThreadAffinity(uint64_t mask);
+
+// Saves the affinity of the calling thread, and restores it on Restore() or
+// destruction if Set() changed it. The whole CPU set is saved, so this works on
+// hosts with more than 64 CPUs. Must be used on a single thread.
+class ScopedThreadAffinity {
+ public:
+  ScopedThreadAffinity();
+  ~ScopedThreadAffinity();
+
+  // Restricts the calling thread, and the threads and processes it creates
+  // until Restore(), to the CPUs in `mask`. A `mask` of 0 restores the saved
+  // affinity.
+  MinibenchmarkStatus Set(uint64_t mask);
+
+  // Restores the saved affinity if Set() changed it.
+  void Restore();
+
+ private:
+  bool changed_ = false;
+#if defined(__linux__)
+  bool saved_ = false;
+  cpu_set_t saved_set_;
+#endif  // __linux__
+
+  ScopedThreadAffinity(const ScopedThreadAffinity&) = delete;
+  ScopedThreadAffinity& operator=(const ScopedThreadAffinity&) = delete;
+};
+
+}  // namespace acceleration
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_ACCELERATION_MINI_BENCHMARK_CPU_TUNING_RESULTS_H_
@@ -0,0 +1,172 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/acceleration/mini_benchmark/cpu_tuning_results.h"
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "flatbuffers/buffer.h"  // from @flatbuffers
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "tflite/acceleration/configuration/configuration_generated.h"
+#include "tflite/experimental/acceleration/mini_benchmark/status_codes.h"
+
+namespace tflite {
+namespace acceleration {
+namespace {
+
+std::string GetStoragePath(const std::string& name) {
+  std::string path = absl::StrCat(::testing::TempDir(), "/", name);
+  unlink(CpuTuningResultsPath(path).c_str());
+  return path;
+}
+
+CpuTuningConfig TestConfig() {
+  CpuTuningConfig config;
+  config.num_threads = 4;
+  config.xnnpack_flags = XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_QS8_QU8 |
+                         XNNPackFlags_TFLITE_XNNPACK_DELEGATE_FLAG_FORCE_FP16;
+  config.weight_cache_file_path = "/data/model.xnnpack_cache";
+  config.affinity_mask = 0xf0;
+  return config;
+}
+
+// Returns the benchmark event the validator would produce for `config`.
+flatbuffers::FlatBufferBuilder MakeEvent(const CpuTuningConfig& config) {
+  BenchmarkEventT event;
+  event.tflite_settings = std::make_unique<TFLiteSettingsT>();
+  CpuTuningConfigToSettings(config, event.tflite_settings.get());
+  event.event_type = BenchmarkEventType_END;
+  event.result = std::make_unique<BenchmarkResultT>();
+  event.result->ok = true;
+  event.result->inference_time_us = {1200, 1000, 1100};
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(BenchmarkEvent::Pack(fbb, &event));
+  return fbb;
+}
+
+TEST(CpuTuningResultsTest, HostTypeIsUsableInFileNames) {
+  const std::string host_type = CpuHostType();
+  EXPECT_FALSE(host_type.empty());
+  EXPECT_EQ(host_type, CpuHostType());
+  for (char c : host_type) {
+    EXPECT_TRUE(absl::ascii_isalnum(c) || c == '_') << host_type;
+  }
+  EXPECT_EQ(CpuTuningResultsPath("/data/storage.fb"),
+            absl::StrCat("/data/storage.fb.cpu_tuning.", host_type));
+}
+
+TEST(CpuTuningResultsTest, SettingsRoundTrip) {
+  const CpuTuningConfig config = TestConfig();
+  TFLiteSettingsT settings;
+  CpuTuningConfigToSettings(config, &settings);
+  EXPECT_EQ(settings.delegate, Delegate_XNNPACK);
+  ASSERT_NE(settings.cpu_settings, nullptr);
+  EXPECT_EQ(settings.cpu_settings->num_threads, 4);
+
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(TFLiteSettings::Pack(fbb, &settings));
+  CpuTuningConfig read_back;
+  read_back.affinity_mask = config.affinity_mask;
+  CpuTuningConfigFromSettings(
+      *flatbuffers::GetRoot<TFLiteSettings>(fbb.GetBufferPointer()),
+      &read_back);
+  EXPECT_EQ(read_back, config);
+}
+
+TEST(CpuTuningResultsTest, StoreAndLoad) {
+  const std::string storage_path = GetStoragePath("store_and_load.fb");
+  CpuTuningResult result;
+  EXPECT_FALSE(LoadCpuTuningResult(storage_path, &result));
+  // Looking for results doesn't create the file.
+  EXPECT_NE(access(CpuTuningResultsPath(storage_path).c_str(), F_OK), 0);
+
+  CpuTuningResult first;
+  first.config = TestConfig();
+  first.config.affinity_mask = 0xf000000000000001;
+  first.inference_time_us = 1100;
+  first.number_of_source_events = 12;
+  flatbuffers::FlatBufferBuilder first_event = MakeEvent(first.config);
+  ASSERT_EQ(StoreCpuTuningResult(storage_path,
+                                 *flatbuffers::GetRoot<BenchmarkEvent>(
+                                     first_event.GetBufferPointer()),
+                                 first),
+            kMinibenchmarkSuccess);
+  ASSERT_TRUE(LoadCpuTuningResult(storage_path, &result));
+  EXPECT_EQ(result.config, first.config);
+  EXPECT_EQ(result.inference_time_us, 1100);
+  EXPECT_EQ(result.number_of_source_events, 12);
+
+  // The most recent result wins.
+  CpuTuningResult second;
+  second.config.num_threads = 2;
+  second.inference_time_us = 900;
+  second.number_of_source_events = 8;
+  flatbuffers::FlatBufferBuilder second_event = MakeEvent(second.config);
+  ASSERT_EQ(StoreCpuTuningResult(storage_path,
+                                 *flatbuffers::GetRoot<BenchmarkEvent>(
+                                     second_event.GetBufferPointer()),
+                                 second),
+            kMinibenchmarkSuccess);
+  ASSERT_TRUE(LoadCpuTuningResult(storage_path, &result));
+  EXPECT_EQ(result.config, second.config);
+  EXPECT_EQ(result.inference_time_us, 900);
+}
+
+TEST(CpuTuningResultsTest, SetCurrentThreadAffinity) {
+  EXPECT_EQ(SetCurrentThreadAffinity(0), kMinibenchmarkSuccess);
+  const uint64_t mask = GetCurrentThreadAffinity();
+  if (mask == 0) {
+    GTEST_SKIP() << "Thread affinity not supported.";
+  }
+  // Keep only the lowest CPU we may run on, then restore.
+  EXPECT_EQ(SetCurrentThreadAffinity(mask & -mask), kMinibenchmarkSuccess);
+  EXPECT_EQ(GetCurrentThreadAffinity(), mask & -mask);
+  EXPECT_EQ(SetCurrentThreadAffinity(mask), kMinibenchmarkSuccess);
+  EXPECT_EQ(GetCurrentThreadAffinity(), mask);
+}
+
+#if defined(__linux__)
+TEST(CpuTuningResultsTest, ScopedThreadAffinityRestoresEveryCpu) {
+  const uint64_t mask = GetCurrentThreadAffinity();
+  if (mask == 0) {
+    GTEST_SKIP() << "Thread affinity not supported.";
+  }
+  cpu_set_t before;
+  CPU_ZERO(&before);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(before), &before), 0);
+  {
+    ScopedThreadAffinity affinity;
+    EXPECT_EQ(affinity.Set(mask & -mask), kMinibenchmarkSuccess);
+    EXPECT_EQ(GetCurrentThreadAffinity(), mask & -mask);
+  }
+  // CPUs above 63 are restored as well.
+  cpu_set_t after;
+  CPU_ZERO(&after);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(after), &after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+#endif  // __linux__
+
+}  // namespace
+}  // namespace acceleration
+}  // namespace tflite
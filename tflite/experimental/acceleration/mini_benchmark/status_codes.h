@@ -109,11 +109,12 @@ enum MinibenchmarkStatus {
 
   // Validator runner status codes.
   //
-  // Next available code: 1505
+  // Next available code: 1506
   kMinibenchmarkChildProcessAlreadyRunning = 1501,
   kMinibenchmarkValidationEntrypointSymbolNotFound = 1502,
   kMinibenchmarkNoValidationRequestFound = 1503,
   kMinibenchmarkCompletionEventMissing = 1504,
+  kMinibenchmarkNoSettingsPassedValidation = 1505,
 
   // Validator runner recoverable errors
   //
@@ -16,7 +16,10 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_EXPERIMENTAL_GENAI_GENAI_OPS_H_
 #define TENSORFLOW_LITE_EXPERIMENTAL_GENAI_GENAI_OPS_H_
 
+#include <cstddef>
+
 #include "tflite/c/common.h"
+#include "tflite/experimental/resource/resource_base.h"
 #include "tflite/mutable_op_resolver.h"
 
 namespace tflite {
@@ -27,6 +30,20 @@ TfLiteRegistration* Register_KV_CACHE();
 TfLiteRegistration* Register_EXTERNAL_KV_CACHE();
 TfLiteRegistration* Register_SDPA();
 
+// Rolls the key and value caches of the KV_CACHE ops sharing `resources` back
+// to their first `num_positions` positions, e.g. to drop the entries of the
+// tokens rejected by speculative decoding without recomputing the accepted
+// ones. The next invocations overwrite the dropped entries at their positions.
+// Rolling back to 0 empties the caches, even after they evicted entries.
+// Fails if the caches already evicted positions at or after `num_positions`.
+TfLiteStatus TruncateKVCache(resource::ResourceMap& resources,
+                             size_t num_positions);
+
+// Returns the number of positions the caches of the KV_CACHE ops sharing
+// `resources` hold before they evict the oldest ones, or -1 if there are no
+// such caches, e.g. before the tensors are allocated.
+int KVCacheSize(const resource::ResourceMap& resources);
+
 extern "C" void GenAIOpsRegisterer(::tflite::MutableOpResolver* resolver);
 
 }  // namespace custom
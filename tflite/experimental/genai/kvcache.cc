@@ -49,7 +49,6 @@ struct OpData {
   int num_layers;
   int layer_index;
   int max_num_entries;
-  int first_slot_index;
   // Pointers to the key and value cache buffers that this Op doesn't own
   // (and therefore does not free on destruction of this Op).
   resource::CacheBuffer* key_cache_buffer;
@@ -66,7 +65,6 @@ void* KVCacheInit(TfLiteContext* context, const char* buffer, size_t length) {
   op_data->max_num_entries = -1;
   op_data->num_layers = -1;
   op_data->layer_index = -1;
-  op_data->first_slot_index = -1;
   op_data->key_cache_buffer = nullptr;
   op_data->value_cache_buffer = nullptr;
   op_data->is_initialized = false;
@@ -95,7 +93,6 @@ TfLiteStatus KVCachePrepare(TfLiteContext* context, TfLiteNode* node) {
         num_layers > 0 ? num_layers : kDefaultNumTransformerLayers;
     op_data->layer_index =
         layer_index > 0 ? layer_index : kDefaultTransformerLayerId;
-    op_data->first_slot_index = 0;
     op_data->is_initialized = true;
   }
 
@@ -251,6 +248,10 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   const int64_t max_num_entries = op_data->max_num_entries;
   int current_num_entries =
       op_data->key_cache_buffer->GetNumEntries(layer_index);
+  // The first slot is kept in the shared buffer rather than in the op, so
+  // that rolling the cache back also moves it.
+  int64_t first_slot_index =
+      op_data->key_cache_buffer->GetFirstSlotIndex(layer_index);
 
   // Compute some constants for various pieces of the cache.
   RuntimeShape shape(GetTensorShape(key));
@@ -280,7 +281,7 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   const int64_t input_last_idx = input_first_idx + num_slots_needed - 1;
 
   // Compute the span of the cache.
-  const int64_t cache_first_slot_idx = op_data->first_slot_index;
+  const int64_t cache_first_slot_idx = first_slot_index;
   const int64_t cache_last_slot_idx =
       cache_first_slot_idx + op_data->max_num_entries - 1;
 
@@ -291,12 +292,12 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
 
   // These values determine how we will write to the output tensor:
   // first_slot := the first cache entry that we will write to in the output
-  int64_t first_slot = input_first_idx - op_data->first_slot_index;
+  int64_t first_slot = input_first_idx - first_slot_index;
   if (first_slot < 0) {
     TF_LITE_KERNEL_LOG(
         context,
         "Can not specify a position before this cache's first slot index of %d",
-        op_data->first_slot_index);
+        static_cast<int>(first_slot_index));
     return kTfLiteError;
   }
 
@@ -324,10 +325,13 @@ TfLiteStatus KVCacheEval(TfLiteContext* context, TfLiteNode* node) {
   }
 
   // Update the first slot this cache now covers.
-  op_data->first_slot_index = op_data->first_slot_index + slots_to_shift;
+  first_slot_index = first_slot_index + slots_to_shift;
+  op_data->key_cache_buffer->SetFirstSlotIndex(layer_index, first_slot_index);
+  op_data->value_cache_buffer->SetFirstSlotIndex(layer_index,
+                                                 first_slot_index);
 
   // Recompute the first slot in case any shifting occurred.
-  first_slot = input_first_idx - op_data->first_slot_index;
+  first_slot = input_first_idx - first_slot_index;
   const int64_t bytes_offset_for_cache = first_slot * num_bytes_per_tensor;
 
   // 4. Put the key and value in their respective caches.
@@ -351,6 +355,25 @@ TfLiteRegistration* Register_KV_CACHE() {
   return &r;
 }
 
+TfLiteStatus TruncateKVCache(resource::ResourceMap& resources,
+                             size_t num_positions) {
+  for (const int resource_id :
+       {llm::KVCACHE_KEY_RESOURCE, llm::KVCACHE_VALUE_RESOURCE}) {
+    auto it = resources.find(resource_id);
+    if (it == resources.end()) continue;
+    TF_LITE_ENSURE_STATUS(static_cast<resource::CacheBuffer*>(it->second.get())
+                              ->Truncate(num_positions));
+  }
+  return kTfLiteOk;
+}
+
+int KVCacheSize(const resource::ResourceMap& resources) {
+  auto it = resources.find(llm::KVCACHE_KEY_RESOURCE);
+  if (it == resources.end()) return -1;
+  return static_cast<const resource::CacheBuffer*>(it->second.get())
+      ->GetMaxNumEntries();
+}
+
 }  // namespace custom
 }  // namespace ops
 }  // namespace tflite
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -69,6 +70,11 @@ class SimpleCacheOpModel : public SingleOpModel {
 
   TfLiteStatus ReAllocate() { return interpreter_->AllocateTensors(); }
 
+  TfLiteStatus TruncateCache(size_t num_positions) {
+    return ops::custom::TruncateKVCache(
+        interpreter_->primary_subgraph().resources(), num_positions);
+  }
+
  protected:
   int pos_;
   int k_;
@@ -235,6 +241,49 @@ TEST(SimpleCacheOp2Test, ShiftSlotsInCache) {
   m.SetValue(value3);
   m.SetPosition({0});
   ASSERT_EQ(m.Invoke(), kTfLiteError);
+
+  // The evicted positions can't be rolled back to, but the cache can be
+  // emptied to start again from position 0.
+  ASSERT_EQ(m.TruncateCache(2), kTfLiteError);
+  ASSERT_EQ(m.TruncateCache(0), kTfLiteOk);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+}
+
+TEST(SimpleCacheOp2Test, RollBackRejectedEntries) {
+  SimpleCacheOpModel m({TensorType_INT64, {2}},
+                       {TensorType_FLOAT32, {1, 2, 2, 3}},
+                       {TensorType_FLOAT32, {1, 2, 2, 3}});
+
+  std::vector<float> accepted = {1, 5, -6, 2, 4, 3, 8, 9, -8, 7, 2, 11};
+  m.SetPosition({0, 1});
+  m.SetKey(accepted);
+  m.SetValue(accepted);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> rejected = {9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9};
+  m.SetPosition({2, 3});
+  m.SetKey(rejected);
+  m.SetValue(rejected);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  // Drop positions 2 and 3 and write them again, positions 0 and 1 must be
+  // kept as they are.
+  ASSERT_EQ(m.TruncateCache(2), kTfLiteOk);
+  std::vector<float> rewritten = {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5, 8};
+  m.SetKey(rewritten);
+  m.SetValue(rewritten);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> fullk = m.GetFullK();
+  std::vector<float> fullv = m.GetFullV();
+  for (int i = 0; i < accepted.size(); ++i) {
+    ASSERT_EQ(fullk[i], accepted[i]);
+    ASSERT_EQ(fullv[i], accepted[i]);
+  }
+  for (int i = 0; i < rewritten.size(); ++i) {
+    ASSERT_EQ(fullk[accepted.size() + i], rewritten[i]);
+    ASSERT_EQ(fullv[accepted.size() + i], rewritten[i]);
+  }
 }
 
 }  // namespace
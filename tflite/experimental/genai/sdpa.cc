@@ -23,6 +23,7 @@ limitations under the License.
 #include "flatbuffers/flexbuffers.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/core/c/common.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/kernels/internal/common.h"
 #include "tflite/kernels/internal/reference/add.h"
 #include "tflite/kernels/internal/reference/batch_matmul.h"
@@ -470,6 +471,14 @@ TfLiteStatus SDPAEval(TfLiteContext* context, TfLiteNode* node) {
 
   OpData* op_data = reinterpret_cast<OpData*>(node->user_data);
 
+  // The attention is computed in stages over the temporaries allocated in
+  // Prepare, check between the expensive ones so that a cancelled invocation or
+  // one past its deadline stops without waiting for both matmuls.
+  const InvocationInterrupt* interrupt = InvocationInterrupt::Get(context);
+  auto should_stop = [interrupt]() {
+    return interrupt != nullptr && interrupt->ShouldStop();
+  };
+
   bool mqa = key_tensor->dims->data[2] == 1;
   bool gqa = !mqa && (key_tensor->dims->data[2] != query_tensor->dims->data[2]);
 
@@ -543,6 +552,8 @@ TfLiteStatus SDPAEval(TfLiteContext* context, TfLiteNode* node) {
                              reshape_k_or_q_out_data);
   }
 
+  if (should_stop()) return kTfLiteCancelled;
+
   // mqa FC (q, squeezed_k)
   // mha BMM(q, k) transpose_b = true
   if (mqa) {
@@ -564,6 +575,8 @@ TfLiteStatus SDPAEval(TfLiteContext* context, TfLiteNode* node) {
         reshape_k_or_q_out_data, matmul1_out_shape, matmul1_out_data);
   }
 
+  if (should_stop()) return kTfLiteCancelled;
+
   // add matmul_out + mask
   tflite::ArithmeticParams add_params;
   SetActivationParams(output_min, output_max, &add_params);
@@ -627,6 +640,8 @@ TfLiteStatus SDPAEval(TfLiteContext* context, TfLiteNode* node) {
                              reshape_v_or_add_out_data);
   }
 
+  if (should_stop()) return kTfLiteCancelled;
+
   // mqa FC (softmax_out, squeezed_v)
   // mha BMM(softmax_out, v) transpose_b = true
   if (mqa) {
@@ -0,0 +1,154 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/experimental/genai/signature_decoder_model.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "tflite/core/c/common.h"
+#include "tflite/experimental/genai/genai_ops.h"
+#include "tflite/interpreter.h"
+#include "tflite/kernels/kernel_util.h"
+#include "tflite/minimal_logging.h"
+#include "tflite/profiling/time.h"
+
+namespace tflite {
+namespace genai {
+namespace {
+
+bool IsIndexType(const TfLiteTensor* tensor) {
+  return tensor->type == kTfLiteInt32 || tensor->type == kTfLiteInt64;
+}
+
+void SetIndex(TfLiteTensor* tensor, int i, int64_t value) {
+  if (tensor->type == kTfLiteInt64) {
+    tensor->data.i64[i] = value;
+  } else {
+    tensor->data.i32[i] = static_cast<int32_t>(value);
+  }
+}
+
+}  // namespace
+
+std::unique_ptr<SignatureDecoderModel> SignatureDecoderModel::Create(
+    Interpreter* interpreter, const Names& names) {
+  SignatureRunner* runner =
+      interpreter->GetSignatureRunner(names.signature_key.c_str());
+  if (runner == nullptr) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR, "The model has no signature '%s'.",
+                    names.signature_key.c_str());
+    return nullptr;
+  }
+  const TfLiteTensor* tokens = runner->input_tensor(names.tokens.c_str());
+  const TfLiteTensor* positions =
+      runner->input_tensor(names.positions.c_str());
+  const TfLiteTensor* logits = runner->output_tensor(names.logits.c_str());
+  if (tokens == nullptr || positions == nullptr || logits == nullptr ||
+      !IsIndexType(tokens) || !IsIndexType(positions) ||
+      logits->type != kTfLiteFloat32) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "Signature '%s' must take integer '%s' and '%s' and "
+                    "return float '%s'.",
+                    names.signature_key.c_str(), names.tokens.c_str(),
+                    names.positions.c_str(), names.logits.c_str());
+    return nullptr;
+  }
+
+  std::unique_ptr<SignatureDecoderModel> model(
+      new SignatureDecoderModel(interpreter, runner, names));
+  if (model->PrepareInputs(1) != kTfLiteOk) return nullptr;
+  logits = runner->output_tensor(names.logits.c_str());
+  model->vocab_size_ = logits->dims->data[logits->dims->size - 1];
+  // The caches are resources of the interpreter, shared by its subgraphs,
+  // created when the tensors are allocated.
+  model->cache_size_ =
+      ops::custom::KVCacheSize(interpreter->primary_subgraph().resources());
+  return model;
+}
+
+TfLiteStatus SignatureDecoderModel::PrepareInputs(int num_tokens) {
+  if (num_tokens == num_tokens_) return kTfLiteOk;
+  const TfLiteTensor* tokens = runner_->input_tensor(names_.tokens.c_str());
+  if (tokens->dims->size == 2) {
+    TF_LITE_ENSURE_STATUS(
+        runner_->ResizeInputTensor(names_.tokens.c_str(), {1, num_tokens}));
+  } else {
+    TF_LITE_ENSURE_STATUS(
+        runner_->ResizeInputTensor(names_.tokens.c_str(), {num_tokens}));
+  }
+  TF_LITE_ENSURE_STATUS(
+      runner_->ResizeInputTensor(names_.positions.c_str(), {num_tokens}));
+  const uint64_t start_us = profiling::time::NowMicros();
+  TF_LITE_ENSURE_STATUS(runner_->AllocateTensors());
+  allocation_us_ += profiling::time::NowMicros() - start_us;
+  num_tokens_ = num_tokens;
+  return kTfLiteOk;
+}
+
+TfLiteStatus SignatureDecoderModel::Decode(absl::Span<const int> tokens,
+                                           int start_position,
+                                           std::vector<float>* logits) {
+  if (tokens.empty()) return kTfLiteError;
+  int num_tokens = tokens.size();
+  if (num_tokens < min_num_tokens_ && cache_size_ >= 0 &&
+      start_position + min_num_tokens_ <= cache_size_) {
+    num_tokens = min_num_tokens_;
+  }
+  TF_LITE_ENSURE_STATUS(PrepareInputs(num_tokens));
+  TfLiteTensor* tokens_tensor = runner_->input_tensor(names_.tokens.c_str());
+  TfLiteTensor* positions_tensor =
+      runner_->input_tensor(names_.positions.c_str());
+  for (int i = 0; i < num_tokens; ++i) {
+    SetIndex(tokens_tensor, i, tokens[std::min<size_t>(i, tokens.size() - 1)]);
+    SetIndex(positions_tensor, i, start_position + i);
+  }
+  TF_LITE_ENSURE_STATUS(runner_->Invoke());
+
+  const TfLiteTensor* logits_tensor =
+      runner_->output_tensor(names_.logits.c_str());
+  const int64_t num_logits = NumElements(logits_tensor);
+  if (num_logits != static_cast<int64_t>(num_tokens) * vocab_size_) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "Signature '%s' returned %d logits for %d tokens, it must "
+                    "return the logits of every token.",
+                    names_.signature_key.c_str(), static_cast<int>(num_logits),
+                    num_tokens);
+    return kTfLiteError;
+  }
+  // The logits of the padding are dropped.
+  logits->assign(logits_tensor->data.f,
+                 logits_tensor->data.f + tokens.size() * vocab_size_);
+  return kTfLiteOk;
+}
+
+TfLiteStatus SignatureDecoderModel::Rollback(int num_positions) {
+  if (ops::custom::TruncateKVCache(interpreter_->primary_subgraph().resources(),
+                                   num_positions) != kTfLiteOk) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "Can't roll the KV cache back to %d positions, it already "
+                    "evicted some of them.",
+                    num_positions);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace genai
+}  // namespace tflite
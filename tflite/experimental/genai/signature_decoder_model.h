@@ -0,0 +1,97 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SIGNATURE_DECODER_MODEL_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SIGNATURE_DECODER_MODEL_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "tflite/core/c/common.h"
+#include "tflite/experimental/genai/speculative_decoder.h"
+#include "tflite/interpreter.h"
+
+namespace tflite {
+namespace genai {
+
+/// WARNING: Experimental interface, subject to change.
+// A `DecoderModel` invoking a signature of an interpreter whose KV cache is
+// kept by the genai KV_CACHE ops, e.g. the "decode" signature of a model
+// converted with the genai ops. The signature takes the tokens, shaped
+// [1, num_tokens] or [num_tokens], and their positions, shaped [num_tokens],
+// and returns the logits shaped [1, num_tokens, vocab_size].
+//
+// Rollback truncates the `resource::CacheBuffer`s of the KV_CACHE ops, and
+// rolling back to 0 also undoes the evictions of a full cache. Models keeping
+// their cache in external tensors (EXTERNAL_KV_CACHE) only need the positions
+// to be rewound, since both ops write the entries at the positions they are
+// given and the attention mask is built from the positions.
+class SignatureDecoderModel : public DecoderModel {
+ public:
+  struct Names {
+    std::string signature_key = "decode";
+    std::string tokens = "tokens";
+    std::string positions = "input_pos";
+    std::string logits = "logits";
+  };
+
+  // Returns nullptr if the interpreter doesn't have the signature or its
+  // inputs and outputs don't match the above. `interpreter` must outlive the
+  // returned model.
+  static std::unique_ptr<SignatureDecoderModel> Create(
+      Interpreter* interpreter, const Names& names);
+
+  TfLiteStatus Decode(absl::Span<const int> tokens, int start_position,
+                      std::vector<float>* logits) override;
+  TfLiteStatus Rollback(int num_positions) override;
+  int vocab_size() const override { return vocab_size_; }
+  int cache_size() const override { return cache_size_; }
+
+  // Pads the calls on fewer tokens to `num_tokens`, e.g. k + 1 for the target
+  // of a speculative decoder, so that calls on different numbers of tokens
+  // share one allocation of the tensors instead of resizing them at each
+  // change. The padding repeats the last token at the following positions,
+  // adding KV cache entries past the decoded ones, which the attention mask
+  // hides and the next calls overwrite. Calls aren't padded past the end of
+  // the KV_CACHE ops' cache, nor for models without one.
+  void SetMinNumTokens(int num_tokens) { min_num_tokens_ = num_tokens; }
+
+  // Total time spent resizing and allocating the tensors, in microseconds.
+  uint64_t allocation_us() const { return allocation_us_; }
+
+ private:
+  SignatureDecoderModel(Interpreter* interpreter, SignatureRunner* runner,
+                        const Names& names)
+      : interpreter_(interpreter), runner_(runner), names_(names) {}
+
+  // Resizes the inputs for `num_tokens` tokens if needed.
+  TfLiteStatus PrepareInputs(int num_tokens);
+
+  Interpreter* interpreter_;
+  SignatureRunner* runner_;
+  Names names_;
+  int num_tokens_ = -1;
+  int min_num_tokens_ = 1;
+  int vocab_size_ = 0;
+  int cache_size_ = -1;
+  uint64_t allocation_us_ = 0;
+};
+
+}  // namespace genai
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SIGNATURE_DECODER_MODEL_H_
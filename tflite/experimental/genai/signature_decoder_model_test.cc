@@ -0,0 +1,365 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/experimental/genai/signature_decoder_model.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "flatbuffers/flatbuffers.h"  // from @flatbuffers
+#include "flatbuffers/flexbuffers.h"  // from @flatbuffers
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/interpreter_builder.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/model_builder.h"
+#include "tflite/experimental/genai/genai_ops.h"
+#include "tflite/experimental/genai/speculative_decoder.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace genai {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr int kVocabSize = 16;
+constexpr int kHiddenSize = 8;
+
+// Builds a one layer decoder keeping its keys and values in a KV_CACHE op of
+// `cache_size` positions: the embedding of each token attends to the cached
+// embeddings up to its position, and a fully connected layer turns the result
+// into logits.
+class DecoderModelBuilder {
+ public:
+  std::unique_ptr<FlatBufferModel> Build(const std::vector<float>& embeddings,
+                                         const std::vector<float>& output,
+                                         int cache_size) {
+    model_.version = 3;
+    // Buffer 0 is the empty buffer of the tensors without data.
+    model_.buffers.push_back(std::make_unique<BufferT>());
+    model_.subgraphs.push_back(std::make_unique<SubGraphT>());
+    subgraph_ = model_.subgraphs.back().get();
+
+    const int tokens = AddTensor(TensorType_INT32, {1, 1}, {1, -1});
+    const int positions = AddTensor(TensorType_INT64, {1}, {-1});
+
+    // The [1, T, H] embeddings are also the keys and the values.
+    const int embedding_table = AddConstTensor(
+        TensorType_FLOAT32, {kVocabSize, kHiddenSize}, embeddings);
+    const int embedded = AddTensor(TensorType_FLOAT32, {1, 1, kHiddenSize});
+    AddOp(BuiltinOperator_GATHER, {embedding_table, tokens}, {embedded},
+          GatherOptionsT());
+    const int entries = AddTensor(TensorType_FLOAT32, {1, 1, 1, kHiddenSize});
+    AddReshape(embedded, {1, -1, 1, kHiddenSize}, entries);
+
+    const int keys =
+        AddTensor(TensorType_FLOAT32, {1, cache_size, 1, kHiddenSize});
+    const int values =
+        AddTensor(TensorType_FLOAT32, {1, cache_size, 1, kHiddenSize});
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() {
+      fbb.Int("kv_cache_max", cache_size);
+      fbb.Int("num_layers", 1);
+      fbb.Int("layer_index", 0);
+    });
+    fbb.Finish();
+    OperatorT* kv_cache =
+        AddOp(BuiltinOperator_CUSTOM, {positions, entries, entries},
+              {keys, values}, "odml.update_kv_cache");
+    kv_cache->custom_options = fbb.GetBuffer();
+    const int keys_3d =
+        AddTensor(TensorType_FLOAT32, {1, cache_size, kHiddenSize});
+    AddReshape(keys, {1, cache_size, kHiddenSize}, keys_3d);
+    const int values_3d =
+        AddTensor(TensorType_FLOAT32, {1, cache_size, kHiddenSize});
+    AddReshape(values, {1, cache_size, kHiddenSize}, values_3d);
+
+    // Mask the slots past the position of each token. Slot i holds position
+    // i until the cache is full, after which all the slots hold past
+    // positions.
+    const int position_column = AddTensor(TensorType_INT64, {1, 1, 1});
+    AddReshape(positions, {1, -1, 1}, position_column);
+    std::vector<int64_t> slot_positions(cache_size);
+    for (int i = 0; i < cache_size; ++i) slot_positions[i] = i;
+    const int slots =
+        AddConstTensor(TensorType_INT64, {1, 1, cache_size}, slot_positions);
+    const int future = AddTensor(TensorType_BOOL, {1, 1, cache_size});
+    AddOp(BuiltinOperator_GREATER, {slots, position_column}, {future});
+    const int future_float = AddTensor(TensorType_FLOAT32, {1, 1, cache_size});
+    AddOp(BuiltinOperator_CAST, {future}, {future_float});
+    const int minus_infinity =
+        AddConstTensor(TensorType_FLOAT32, {1}, std::vector<float>{-1e9f});
+    const int mask = AddTensor(TensorType_FLOAT32, {1, 1, cache_size});
+    AddOp(BuiltinOperator_MUL, {future_float, minus_infinity}, {mask},
+          MulOptionsT());
+
+    const int scores = AddTensor(TensorType_FLOAT32, {1, 1, cache_size});
+    BatchMatMulOptionsT transpose_keys;
+    transpose_keys.adj_y = true;
+    AddOp(BuiltinOperator_BATCH_MATMUL, {embedded, keys_3d}, {scores},
+          transpose_keys);
+    const int masked_scores =
+        AddTensor(TensorType_FLOAT32, {1, 1, cache_size});
+    AddOp(BuiltinOperator_ADD, {scores, mask}, {masked_scores},
+          AddOptionsT());
+    const int attention = AddTensor(TensorType_FLOAT32, {1, 1, cache_size});
+    SoftmaxOptionsT softmax_options;
+    softmax_options.beta = 1.0f;
+    AddOp(BuiltinOperator_SOFTMAX, {masked_scores}, {attention},
+          softmax_options);
+    const int attended = AddTensor(TensorType_FLOAT32, {1, 1, kHiddenSize});
+    AddOp(BuiltinOperator_BATCH_MATMUL, {attention, values_3d}, {attended},
+          BatchMatMulOptionsT());
+
+    const int output_weights = AddConstTensor(
+        TensorType_FLOAT32, {kVocabSize, kHiddenSize}, output);
+    const int logits = AddTensor(TensorType_FLOAT32, {1, 1, kVocabSize});
+    FullyConnectedOptionsT keep_num_dims;
+    keep_num_dims.keep_num_dims = true;
+    AddOp(BuiltinOperator_FULLY_CONNECTED, {attended, output_weights, -1},
+          {logits}, keep_num_dims);
+
+    subgraph_->inputs = {tokens, positions};
+    subgraph_->outputs = {logits};
+    auto signature = std::make_unique<SignatureDefT>();
+    signature->signature_key = "decode";
+    signature->inputs.push_back(TensorMap("tokens", tokens));
+    signature->inputs.push_back(TensorMap("input_pos", positions));
+    signature->outputs.push_back(TensorMap("logits", logits));
+    model_.signature_defs.push_back(std::move(signature));
+
+    flatbuffers::FlatBufferBuilder builder;
+    FinishModelBuffer(builder, Model::Pack(builder, &model_));
+    buffer_.assign(builder.GetBufferPointer(),
+                   builder.GetBufferPointer() + builder.GetSize());
+    return FlatBufferModel::BuildFromBuffer(
+        reinterpret_cast<const char*>(buffer_.data()), buffer_.size());
+  }
+
+ private:
+  int AddTensor(TensorType type, const std::vector<int>& shape,
+                const std::vector<int>& shape_signature = {}) {
+    auto tensor = std::make_unique<TensorT>();
+    tensor->type = type;
+    tensor->shape = shape;
+    tensor->shape_signature = shape_signature;
+    tensor->name = "tensor_" + std::to_string(subgraph_->tensors.size());
+    subgraph_->tensors.push_back(std::move(tensor));
+    return subgraph_->tensors.size() - 1;
+  }
+
+  template <typename T>
+  int AddConstTensor(TensorType type, const std::vector<int>& shape,
+                     const std::vector<T>& data) {
+    auto buffer = std::make_unique<BufferT>();
+    buffer->data.resize(data.size() * sizeof(T));
+    std::memcpy(buffer->data.data(), data.data(), buffer->data.size());
+    model_.buffers.push_back(std::move(buffer));
+    const int tensor = AddTensor(type, shape);
+    subgraph_->tensors[tensor]->buffer = model_.buffers.size() - 1;
+    return tensor;
+  }
+
+  void AddReshape(int input, const std::vector<int>& shape, int output) {
+    const int new_shape = AddConstTensor(
+        TensorType_INT32, {static_cast<int>(shape.size())}, shape);
+    AddOp(BuiltinOperator_RESHAPE, {input, new_shape}, {output});
+  }
+
+  OperatorT* AddOp(BuiltinOperator type, const std::vector<int>& inputs,
+                   const std::vector<int>& outputs,
+                   const std::string& custom_code = "") {
+    const auto key = std::make_pair(type, custom_code);
+    if (opcodes_.count(key) == 0) {
+      auto opcode = std::make_unique<OperatorCodeT>();
+      opcode->builtin_code = type;
+      opcode->deprecated_builtin_code =
+          static_cast<int8_t>(std::min<int>(type, 127));
+      opcode->custom_code = custom_code;
+      model_.operator_codes.push_back(std::move(opcode));
+      opcodes_[key] = model_.operator_codes.size() - 1;
+    }
+    auto op = std::make_unique<OperatorT>();
+    op->opcode_index = opcodes_[key];
+    op->inputs = inputs;
+    op->outputs = outputs;
+    subgraph_->operators.push_back(std::move(op));
+    return subgraph_->operators.back().get();
+  }
+
+  template <typename Options>
+  void AddOp(BuiltinOperator type, const std::vector<int>& inputs,
+             const std::vector<int>& outputs, Options options) {
+    AddOp(type, inputs, outputs)->builtin_options.Set(std::move(options));
+  }
+
+  static std::unique_ptr<TensorMapT> TensorMap(const std::string& name,
+                                               int tensor_index) {
+    auto map = std::make_unique<TensorMapT>();
+    map->name = name;
+    map->tensor_index = tensor_index;
+    return map;
+  }
+
+  ModelT model_;
+  SubGraphT* subgraph_ = nullptr;
+  std::map<std::pair<BuiltinOperator, std::string>, int> opcodes_;
+  std::vector<uint8_t> buffer_;
+};
+
+std::vector<float> RandomWeights(std::mt19937* rng) {
+  std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+  std::vector<float> weights(kVocabSize * kHiddenSize);
+  for (float& w : weights) w = uniform(*rng);
+  return weights;
+}
+
+// A decoder model and everything it depends on.
+struct Decoder {
+  Decoder(const std::vector<float>& embeddings,
+          const std::vector<float>& output, int cache_size) {
+    flatbuffer = builder.Build(embeddings, output, cache_size);
+    ops::builtin::BuiltinOpResolver resolver;
+    ops::custom::GenAIOpsRegisterer(&resolver);
+    InterpreterBuilder(*flatbuffer, resolver)(&interpreter);
+    if (interpreter != nullptr) {
+      model = SignatureDecoderModel::Create(interpreter.get(),
+                                            SignatureDecoderModel::Names());
+    }
+  }
+
+  DecoderModelBuilder builder;
+  std::unique_ptr<FlatBufferModel> flatbuffer;
+  std::unique_ptr<Interpreter> interpreter;
+  std::unique_ptr<SignatureDecoderModel> model;
+};
+
+class SignatureDecoderModelTest : public ::testing::TestWithParam<int> {
+ protected:
+  void SetUp() override {
+    std::mt19937 rng(7);
+    embeddings_ = RandomWeights(&rng);
+    output_ = RandomWeights(&rng);
+    // The draft agrees with the target on some tokens only.
+    draft_output_ = output_;
+    std::normal_distribution<float> noise(0.0f, 0.5f);
+    for (float& w : draft_output_) w += noise(rng);
+  }
+
+  int cache_size() const { return GetParam(); }
+
+  std::vector<float> embeddings_;
+  std::vector<float> output_;
+  std::vector<float> draft_output_;
+};
+
+// The caches hold 64 positions, more than are generated, or 16 and evict
+// some of them.
+INSTANTIATE_TEST_SUITE_P(CacheSizes, SignatureDecoderModelTest,
+                         ::testing::Values(64, 16));
+
+TEST_P(SignatureDecoderModelTest, GreedySpeculativeMatchesPlainDecoding) {
+  Decoder target(embeddings_, output_, cache_size());
+  Decoder draft(embeddings_, draft_output_, cache_size());
+  ASSERT_NE(target.model, nullptr);
+  ASSERT_NE(draft.model, nullptr);
+  EXPECT_EQ(target.model->cache_size(), cache_size());
+  EXPECT_EQ(target.model->vocab_size(), kVocabSize);
+
+  const std::vector<int> prompt = {3, 1, 4, 1, 5};
+  constexpr int kNumTokens = 30;
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 0;
+  std::vector<int> expected;
+  ASSERT_EQ(SpeculativeDecoder(nullptr, target.model.get(), options)
+                .Generate(prompt, kNumTokens, &expected),
+            kTfLiteOk);
+  ASSERT_EQ(expected.size(), static_cast<size_t>(kNumTokens));
+
+  // The same models are reused, each run starting from cleared caches.
+  for (int k = 1; k <= 4; ++k) {
+    SCOPED_TRACE(k);
+    options.num_draft_tokens = k;
+    SpeculativeDecoder decoder(draft.model.get(), target.model.get(),
+                               options);
+    for (const int min_num_tokens : {1, k + 1}) {
+      SCOPED_TRACE(min_num_tokens);
+      target.model->SetMinNumTokens(min_num_tokens);
+      draft.model->SetMinNumTokens(std::min(min_num_tokens, 2));
+      std::vector<int> output;
+      ASSERT_EQ(decoder.Generate(prompt, kNumTokens, &output), kTfLiteOk);
+      EXPECT_THAT(output, ElementsAreArray(expected));
+      EXPECT_GT(decoder.stats().drafted_tokens, 0);
+    }
+  }
+
+  // Plain decoding is unchanged by the speculative runs and the padding.
+  target.model->SetMinNumTokens(3);
+  options.num_draft_tokens = 0;
+  std::vector<int> output;
+  ASSERT_EQ(SpeculativeDecoder(nullptr, target.model.get(), options)
+                .Generate(prompt, kNumTokens, &output),
+            kTfLiteOk);
+  EXPECT_THAT(output, ElementsAreArray(expected));
+}
+
+TEST_P(SignatureDecoderModelTest, RollbackDropsTheLaterPositions) {
+  Decoder target(embeddings_, output_, cache_size());
+  ASSERT_NE(target.model, nullptr);
+  SignatureDecoderModel* model = target.model.get();
+
+  std::vector<float> logits;
+  ASSERT_EQ(model->Decode({2, 7, 1}, 0, &logits), kTfLiteOk);
+  ASSERT_EQ(model->Decode({8}, 3, &logits), kTfLiteOk);
+  const std::vector<float> expected = logits;
+
+  // Overwrite position 3 and the ones after it, then roll back to 3.
+  ASSERT_EQ(model->Decode({9, 9, 9}, 3, &logits), kTfLiteOk);
+  ASSERT_EQ(model->Rollback(3), kTfLiteOk);
+  ASSERT_EQ(model->Decode({8}, 3, &logits), kTfLiteOk);
+  EXPECT_THAT(logits, ElementsAreArray(expected));
+}
+
+TEST(SignatureDecoderModelEvictionTest, RollbackBeforeEvictedPositionsFails) {
+  std::mt19937 rng(3);
+  constexpr int kCacheSize = 8;
+  Decoder target(RandomWeights(&rng), RandomWeights(&rng), kCacheSize);
+  ASSERT_NE(target.model, nullptr);
+  SignatureDecoderModel* model = target.model.get();
+
+  std::vector<float> logits;
+  for (int position = 0; position < kCacheSize + 2; ++position) {
+    ASSERT_EQ(model->Decode({1}, position, &logits), kTfLiteOk);
+  }
+  EXPECT_EQ(model->Rollback(1), kTfLiteError);
+  // Starting over is always possible.
+  ASSERT_EQ(model->Rollback(0), kTfLiteOk);
+  EXPECT_EQ(model->Decode({1}, 0, &logits), kTfLiteOk);
+}
+
+}  // namespace
+}  // namespace genai
+}  // namespace tflite
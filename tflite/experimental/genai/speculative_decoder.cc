@@ -0,0 +1,239 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/experimental/genai/speculative_decoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "tflite/core/c/common.h"
+#include "tflite/minimal_logging.h"
+
+namespace tflite {
+namespace genai {
+
+SpeculativeDecoder::SpeculativeDecoder(
+    DecoderModel* draft, DecoderModel* target,
+    const SpeculativeDecodingOptions& options)
+    : draft_(draft), target_(target), options_(options), rng_(options.seed) {}
+
+TfLiteStatus SpeculativeDecoder::Generate(absl::Span<const int> prompt,
+                                          int max_new_tokens,
+                                          std::vector<int>* output) {
+  output->clear();
+  stats_ = SpeculativeDecodingStats();
+  if (prompt.empty() || max_new_tokens <= 0) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "Nothing to generate without a prompt or tokens.");
+    return kTfLiteError;
+  }
+  const bool speculative = options_.num_draft_tokens > 0;
+  if (speculative &&
+      (draft_ == nullptr || draft_->vocab_size() != target_->vocab_size())) {
+    TFLITE_LOG_PROD(TFLITE_LOG_ERROR,
+                    "The draft model must share the vocabulary of the target "
+                    "model.");
+    return kTfLiteError;
+  }
+
+  sequence_.assign(prompt.begin(), prompt.end());
+  TF_LITE_ENSURE_STATUS(target_->Rollback(0));
+  TF_LITE_ENSURE_STATUS(target_->Decode(prompt, 0, &logits_));
+  ++stats_.target_calls;
+  target_positions_ = prompt.size();
+  sequence_.push_back(
+      Pick(logits_.data() + logits_.size() - target_->vocab_size(),
+           &target_probs_));
+  if (speculative) {
+    TF_LITE_ENSURE_STATUS(draft_->Rollback(0));
+    TF_LITE_ENSURE_STATUS(draft_->Decode(prompt, 0, &logits_));
+    ++stats_.draft_calls;
+    draft_positions_ = prompt.size();
+  }
+
+  const size_t end = prompt.size() + max_new_tokens;
+  while (sequence_.size() < end && sequence_.back() != options_.end_token) {
+    // A step generates up to num_draft_tokens + 1 tokens.
+    const int num_draft_tokens =
+        std::min<int>({options_.num_draft_tokens,
+                       static_cast<int>(end - sequence_.size() - 1),
+                       MaxDraftTokens()});
+    if (num_draft_tokens > 0) {
+      TF_LITE_ENSURE_STATUS(SpeculativeStep(num_draft_tokens));
+    } else {
+      TF_LITE_ENSURE_STATUS(DecodeStep());
+    }
+  }
+
+  output->assign(sequence_.begin() + prompt.size(), sequence_.end());
+  stats_.generated_tokens = output->size();
+  return kTfLiteOk;
+}
+
+TfLiteStatus SpeculativeDecoder::DecodeStep() {
+  TF_LITE_ENSURE_STATUS(target_->Decode(
+      absl::MakeConstSpan(sequence_).subspan(target_positions_),
+      target_positions_, &logits_));
+  ++stats_.target_calls;
+  target_positions_ = sequence_.size();
+  sequence_.push_back(
+      Pick(logits_.data() + logits_.size() - target_->vocab_size(),
+           &target_probs_));
+  return kTfLiteOk;
+}
+
+TfLiteStatus SpeculativeDecoder::SpeculativeStep(int num_draft_tokens) {
+  const int vocab_size = target_->vocab_size();
+  const bool sampling = options_.temperature > 0.0f;
+
+  // Draft one token at a time. The draft first catches up on the tokens it
+  // hasn't seen: the last one, and the last draft if all were accepted.
+  drafted_.clear();
+  drafted_.reserve(num_draft_tokens);
+  draft_probs_.resize(sampling ? num_draft_tokens * vocab_size : 0);
+  absl::Span<const int> tokens =
+      absl::MakeConstSpan(sequence_).subspan(draft_positions_);
+  for (int i = 0; i < num_draft_tokens; ++i) {
+    TF_LITE_ENSURE_STATUS(draft_->Decode(tokens, draft_positions_, &logits_));
+    ++stats_.draft_calls;
+    draft_positions_ += tokens.size();
+    drafted_.push_back(
+        Pick(logits_.data() + logits_.size() - vocab_size, &target_probs_));
+    if (sampling) {
+      std::copy(target_probs_.begin(), target_probs_.end(),
+                draft_probs_.begin() + i * vocab_size);
+    }
+    tokens = absl::MakeConstSpan(&drafted_.back(), 1);
+  }
+
+  // Verify all the drafts in one call of the target, on the last token and
+  // the drafts.
+  verified_.assign(sequence_.begin() + target_positions_, sequence_.end());
+  verified_.insert(verified_.end(), drafted_.begin(), drafted_.end());
+  TF_LITE_ENSURE_STATUS(target_->Decode(verified_, target_positions_,
+                                        &logits_));
+  ++stats_.target_calls;
+  // Row i has the logits of the target for the position of drafted_[i].
+  const float* rows = logits_.data() + logits_.size() -
+                      (num_draft_tokens + 1) * vocab_size;
+
+  int accepted = 0;
+  int next = -1;
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+  for (; accepted < num_draft_tokens; ++accepted) {
+    const float* row = rows + accepted * vocab_size;
+    const int draft = drafted_[accepted];
+    if (!sampling) {
+      next = Pick(row, nullptr);
+      if (next != draft) break;
+      continue;
+    }
+    // Accept with probability min(1, p / q), where p and q are the
+    // probabilities of the draft under the target and the draft models, and
+    // otherwise sample from the residual distribution max(0, p - q).
+    Softmax(row, &target_probs_);
+    const float* draft_probs = draft_probs_.data() + accepted * vocab_size;
+    if (uniform(rng_) * draft_probs[draft] < target_probs_[draft]) continue;
+    for (int v = 0; v < vocab_size; ++v) {
+      target_probs_[v] = std::max(0.0f, target_probs_[v] - draft_probs[v]);
+    }
+    next = Sample(target_probs_);
+    break;
+  }
+  // All the drafts were accepted, the target's next token comes for free.
+  if (accepted == num_draft_tokens) {
+    next = Pick(rows + num_draft_tokens * vocab_size, &target_probs_);
+  }
+  stats_.drafted_tokens += num_draft_tokens;
+  stats_.accepted_tokens += accepted;
+
+  const auto accepted_end = drafted_.begin() + accepted;
+  const auto end_token =
+      std::find(drafted_.begin(), accepted_end, options_.end_token);
+  if (end_token != accepted_end) {
+    sequence_.insert(sequence_.end(), drafted_.begin(), end_token + 1);
+  } else {
+    sequence_.insert(sequence_.end(), drafted_.begin(), accepted_end);
+    sequence_.push_back(next);
+  }
+
+  // Keep the cache entries of the accepted tokens and drop the others. The
+  // last token isn't in the caches yet, it is decoded by the next step.
+  target_positions_ = sequence_.size() - 1;
+  draft_positions_ = std::min(draft_positions_, target_positions_);
+  TF_LITE_ENSURE_STATUS(target_->Rollback(target_positions_));
+  TF_LITE_ENSURE_STATUS(draft_->Rollback(draft_positions_));
+  return kTfLiteOk;
+}
+
+int SpeculativeDecoder::MaxDraftTokens() const {
+  // Verifying k drafts writes the positions up to sequence_.size() - 1 + k
+  // in the target's cache, drafting them one less in the draft's.
+  int max_draft_tokens = options_.num_draft_tokens;
+  for (const DecoderModel* model : {draft_, target_}) {
+    if (model != nullptr && model->cache_size() >= 0) {
+      max_draft_tokens = std::min<int>(
+          max_draft_tokens, model->cache_size() - sequence_.size());
+    }
+  }
+  return max_draft_tokens;
+}
+
+int SpeculativeDecoder::Pick(const float* logits, std::vector<float>* probs) {
+  if (options_.temperature <= 0.0f) {
+    return std::max_element(logits, logits + target_->vocab_size()) - logits;
+  }
+  Softmax(logits, probs);
+  return Sample(*probs);
+}
+
+void SpeculativeDecoder::Softmax(const float* logits,
+                                 std::vector<float>* probs) const {
+  const int vocab_size = target_->vocab_size();
+  probs->resize(vocab_size);
+  const float max_logit = *std::max_element(logits, logits + vocab_size);
+  float sum = 0.0f;
+  for (int v = 0; v < vocab_size; ++v) {
+    (*probs)[v] = std::exp((logits[v] - max_logit) / options_.temperature);
+    sum += (*probs)[v];
+  }
+  for (float& p : *probs) p /= sum;
+}
+
+int SpeculativeDecoder::Sample(const std::vector<float>& weights) {
+  float total = 0.0f;
+  for (const float w : weights) total += w;
+  if (total <= 0.0f) {
+    return std::max_element(weights.begin(), weights.end()) - weights.begin();
+  }
+  float u = std::uniform_real_distribution<float>(0.0f, total)(rng_);
+  for (size_t v = 0; v < weights.size(); ++v) {
+    u -= weights[v];
+    if (u < 0.0f) return v;
+  }
+  // Rounding, fall back to the last token with a non-zero weight.
+  for (size_t v = weights.size(); v > 0; --v) {
+    if (weights[v - 1] > 0.0f) return v - 1;
+  }
+  return 0;
+}
+
+}  // namespace genai
+}  // namespace tflite
@@ -0,0 +1,150 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SPECULATIVE_DECODER_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SPECULATIVE_DECODER_H_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/types/span.h"  // from @com_google_absl
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace genai {
+
+/// WARNING: Experimental interface, subject to change.
+// An autoregressive model with a KV cache, decoding one or more tokens per
+// call.
+class DecoderModel {
+ public:
+  virtual ~DecoderModel() = default;
+
+  // Runs the model on `tokens` at positions `start_position`,
+  // `start_position + 1`..., adding them to the KV cache, and fills `logits`
+  // with the logits of the token following each of them: one row of
+  // `vocab_size()` floats per token.
+  virtual TfLiteStatus Decode(absl::Span<const int> tokens, int start_position,
+                              std::vector<float>* logits) = 0;
+
+  // Drops the KV cache entries of the positions from `num_positions` on, so
+  // that the next call can decode from `num_positions` again.
+  virtual TfLiteStatus Rollback(int num_positions) = 0;
+
+  virtual int vocab_size() const = 0;
+
+  // Number of positions the KV cache holds before it evicts the oldest ones
+  // to make room for new ones, or -1 if it doesn't evict. Evicted positions
+  // can't be rolled back to.
+  virtual int cache_size() const { return -1; }
+};
+
+struct SpeculativeDecodingOptions {
+  // Number of tokens the draft model proposes before the target model
+  // verifies them in one call (k). 0 decodes with the target model alone.
+  int num_draft_tokens = 4;
+  // 0 picks the most likely token, and the output is the one of greedy
+  // decoding with the target model. Otherwise the tokens are sampled with this
+  // temperature and the drafts are accepted by speculative sampling, which
+  // keeps the distribution of the target model.
+  float temperature = 0.0f;
+  uint32_t seed = 0;
+  // If non-negative, generation stops after this token.
+  int end_token = -1;
+};
+
+struct SpeculativeDecodingStats {
+  int generated_tokens = 0;
+  int draft_calls = 0;
+  // Includes the call on the prompt.
+  int target_calls = 0;
+  int drafted_tokens = 0;
+  int accepted_tokens = 0;
+
+  // Fraction of the drafted tokens accepted by the target model.
+  float AcceptanceRate() const {
+    return drafted_tokens == 0
+               ? 0.0f
+               : static_cast<float>(accepted_tokens) / drafted_tokens;
+  }
+};
+
+/// WARNING: Experimental interface, subject to change.
+// Generates tokens with speculative decoding: the small `draft` model proposes
+// `num_draft_tokens` tokens one at a time, the large `target` model runs on
+// all of them in one call, and the longest prefix of the drafts agreeing with
+// the target is kept along with the target's token following it. Each call of
+// the target so yields between 1 and k + 1 tokens, which pays off when a call
+// on k + 1 tokens costs about as much as a call on one, as for memory bound
+// decoding at batch 1.
+//
+// The entries the rejected drafts added to the KV caches of both models are
+// rolled back, the accepted ones are kept, so nothing is recomputed. Drafts
+// never extend past the end of a KV cache, where verifying them would evict
+// entries a rollback can't restore: from there on the target decodes one
+// token per call, as without drafts.
+class SpeculativeDecoder {
+ public:
+  // The models must outlive the decoder, and have the same vocabulary.
+  // `draft` may be null if `options.num_draft_tokens` is 0.
+  SpeculativeDecoder(DecoderModel* draft, DecoderModel* target,
+                     const SpeculativeDecodingOptions& options);
+
+  // Clears the KV caches, runs the models on `prompt` and sets `output` to
+  // the up to `max_new_tokens` tokens generated after it.
+  TfLiteStatus Generate(absl::Span<const int> prompt, int max_new_tokens,
+                        std::vector<int>* output);
+
+  // Statistics of the last call to `Generate`.
+  const SpeculativeDecodingStats& stats() const { return stats_; }
+
+ private:
+  // Decodes one token with the target model.
+  TfLiteStatus DecodeStep();
+  // Drafts `num_draft_tokens` tokens and verifies them.
+  TfLiteStatus SpeculativeStep(int num_draft_tokens);
+  // Returns how many tokens can be drafted without evicting entries of the
+  // KV caches.
+  int MaxDraftTokens() const;
+
+  // Picks the next token from a row of logits. When sampling, also sets
+  // `probs` to the distribution it was sampled from.
+  int Pick(const float* logits, std::vector<float>* probs);
+  void Softmax(const float* logits, std::vector<float>* probs) const;
+  int Sample(const std::vector<float>& weights);
+
+  DecoderModel* draft_;
+  DecoderModel* target_;
+  SpeculativeDecodingOptions options_;
+  std::mt19937 rng_;
+  SpeculativeDecodingStats stats_;
+
+  // The prompt and the tokens generated so far.
+  std::vector<int> sequence_;
+  // Number of positions in the KV cache of each model.
+  int draft_positions_ = 0;
+  int target_positions_ = 0;
+
+  std::vector<float> logits_;
+  std::vector<int> drafted_;
+  std::vector<int> verified_;
+  std::vector<float> draft_probs_;
+  std::vector<float> target_probs_;
+};
+
+}  // namespace genai
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_GENAI_SPECULATIVE_DECODER_H_
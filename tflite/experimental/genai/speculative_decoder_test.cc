@@ -0,0 +1,264 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/experimental/genai/speculative_decoder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/types/span.h"  // from @com_google_absl
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace genai {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr int kVocabSize = 16;
+
+// A model predicting the next token from the last token and its position. Its
+// "KV cache" records the tokens it was run on, and it fails if it isn't run
+// on the position following the cached ones. With a cache size, it evicts
+// the oldest positions past it, and fails to roll back to them.
+class FakeModel : public DecoderModel {
+ public:
+  explicit FakeModel(std::function<int(int, int)> next, int cache_size = -1)
+      : next_(next), cache_size_(cache_size) {}
+
+  TfLiteStatus Decode(absl::Span<const int> tokens, int start_position,
+                      std::vector<float>* logits) override {
+    if (start_position != static_cast<int>(cache_.size())) {
+      return kTfLiteError;
+    }
+    ++num_calls_;
+    logits->assign(tokens.size() * kVocabSize, 0.0f);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+      cache_.push_back(tokens[i]);
+      (*logits)[i * kVocabSize + next_(tokens[i], start_position + i)] = 4.0f;
+    }
+    if (cache_size_ >= 0) {
+      first_position_ = std::max<int>(first_position_,
+                                      cache_.size() - cache_size_);
+    }
+    return kTfLiteOk;
+  }
+
+  TfLiteStatus Rollback(int num_positions) override {
+    if (num_positions > static_cast<int>(cache_.size()) ||
+        (num_positions > 0 && num_positions < first_position_)) {
+      return kTfLiteError;
+    }
+    cache_.resize(num_positions);
+    if (num_positions == 0) first_position_ = 0;
+    return kTfLiteOk;
+  }
+
+  int vocab_size() const override { return kVocabSize; }
+  int cache_size() const override { return cache_size_; }
+
+  const std::vector<int>& cache() const { return cache_; }
+  int num_calls() const { return num_calls_; }
+
+ private:
+  std::function<int(int, int)> next_;
+  int cache_size_;
+  std::vector<int> cache_;
+  // The oldest position still in the cache.
+  int first_position_ = 0;
+  int num_calls_ = 0;
+};
+
+int TargetNext(int token, int position) {
+  return (3 * token + position) % kVocabSize;
+}
+
+// Disagrees with the target on every fourth position.
+int DraftNext(int token, int position) {
+  const int next = TargetNext(token, position);
+  return position % 4 == 3 ? (next + 1) % kVocabSize : next;
+}
+
+std::vector<int> Generate(DecoderModel* draft, DecoderModel* target,
+                          const SpeculativeDecodingOptions& options,
+                          const std::vector<int>& prompt, int max_new_tokens,
+                          SpeculativeDecodingStats* stats = nullptr) {
+  SpeculativeDecoder decoder(draft, target, options);
+  std::vector<int> output;
+  EXPECT_EQ(decoder.Generate(prompt, max_new_tokens, &output), kTfLiteOk);
+  if (stats != nullptr) *stats = decoder.stats();
+  return output;
+}
+
+TEST(SpeculativeDecoderTest, PlainDecoding) {
+  FakeModel target(TargetNext);
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 0;
+  SpeculativeDecodingStats stats;
+  const std::vector<int> output =
+      Generate(nullptr, &target, options, {1, 2}, 5, &stats);
+
+  std::vector<int> expected = {TargetNext(2, 1)};
+  for (int i = 1; i < 5; ++i) {
+    expected.push_back(TargetNext(expected.back(), i + 1));
+  }
+  EXPECT_THAT(output, ElementsAreArray(expected));
+  EXPECT_EQ(stats.generated_tokens, 5);
+  EXPECT_EQ(stats.target_calls, 5);
+  EXPECT_EQ(stats.draft_calls, 0);
+}
+
+TEST(SpeculativeDecoderTest, GreedyMatchesPlainDecoding) {
+  const std::vector<int> prompt = {3, 1, 4};
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 0;
+  FakeModel plain_target(TargetNext);
+  const std::vector<int> expected =
+      Generate(nullptr, &plain_target, options, prompt, 23);
+
+  for (int k = 1; k <= 6; ++k) {
+    SCOPED_TRACE(k);
+    FakeModel draft(DraftNext);
+    FakeModel target(TargetNext);
+    options.num_draft_tokens = k;
+    SpeculativeDecodingStats stats;
+    const std::vector<int> output =
+        Generate(&draft, &target, options, prompt, 23, &stats);
+    EXPECT_THAT(output, ElementsAreArray(expected));
+    EXPECT_EQ(stats.generated_tokens, 23);
+    EXPECT_GT(stats.accepted_tokens, 0);
+    EXPECT_LT(stats.accepted_tokens, stats.drafted_tokens);
+    EXPECT_LT(stats.target_calls, 23);
+
+    // The caches hold exactly the accepted tokens, all but the last one.
+    std::vector<int> cached = prompt;
+    cached.insert(cached.end(), output.begin(), output.end() - 1);
+    EXPECT_THAT(target.cache(), ElementsAreArray(cached));
+    EXPECT_LE(draft.cache().size(), cached.size());
+    EXPECT_THAT(draft.cache(), ElementsAreArray(cached.begin(),
+                                                cached.begin() +
+                                                    draft.cache().size()));
+  }
+}
+
+TEST(SpeculativeDecoderTest, PerfectDraftIsAlwaysAccepted) {
+  FakeModel draft(TargetNext);
+  FakeModel target(TargetNext);
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 4;
+  SpeculativeDecodingStats stats;
+  const std::vector<int> output =
+      Generate(&draft, &target, options, {5}, 21, &stats);
+
+  EXPECT_EQ(output.size(), 21);
+  EXPECT_EQ(stats.drafted_tokens, 16);
+  EXPECT_EQ(stats.accepted_tokens, 16);
+  EXPECT_EQ(stats.AcceptanceRate(), 1.0f);
+  // The prompt, then 4 steps of 5 tokens.
+  EXPECT_EQ(stats.target_calls, 5);
+  EXPECT_EQ(target.num_calls(), 5);
+}
+
+TEST(SpeculativeDecoderTest, StopsAtEndToken) {
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 0;
+  FakeModel plain_target(TargetNext);
+  const std::vector<int> plain =
+      Generate(nullptr, &plain_target, options, {1}, 16);
+  options.end_token = plain[5];
+  const int end = std::find(plain.begin(), plain.end(), options.end_token) -
+                  plain.begin();
+
+  for (int k = 0; k <= 4; ++k) {
+    SCOPED_TRACE(k);
+    FakeModel draft(DraftNext);
+    FakeModel target(TargetNext);
+    options.num_draft_tokens = k;
+    EXPECT_THAT(Generate(&draft, &target, options, {1}, 16),
+                ElementsAreArray(plain.begin(), plain.begin() + end + 1));
+  }
+}
+
+TEST(SpeculativeDecoderTest, DraftsStopAtTheEndOfTheCache) {
+  constexpr int kCacheSize = 12;
+  const std::vector<int> prompt = {3, 1, 4};
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 0;
+  FakeModel plain_target(TargetNext, kCacheSize);
+  const std::vector<int> expected =
+      Generate(nullptr, &plain_target, options, prompt, 20);
+
+  FakeModel draft(DraftNext, kCacheSize);
+  FakeModel target(TargetNext, kCacheSize);
+  options.num_draft_tokens = 4;
+  SpeculativeDecoder decoder(&draft, &target, options);
+  // The second run starts over from a cache that evicted positions.
+  for (int run = 0; run < 2; ++run) {
+    SCOPED_TRACE(run);
+    std::vector<int> output;
+    ASSERT_EQ(decoder.Generate(prompt, 20, &output), kTfLiteOk);
+    EXPECT_THAT(output, ElementsAreArray(expected));
+    // Past the end of the cache, one target call per token.
+    EXPECT_GE(decoder.stats().target_calls, 23 - kCacheSize);
+  }
+}
+
+TEST(SpeculativeDecoderTest, SamplingKeepsTheCachesConsistent) {
+  FakeModel draft(DraftNext);
+  FakeModel target(TargetNext);
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 3;
+  options.temperature = 1.0f;
+  options.seed = 42;
+  SpeculativeDecodingStats stats;
+  const std::vector<int> prompt = {2, 7};
+  const std::vector<int> output =
+      Generate(&draft, &target, options, prompt, 40, &stats);
+
+  EXPECT_EQ(output.size(), 40);
+  EXPECT_GT(stats.accepted_tokens, 0);
+  std::vector<int> cached = prompt;
+  cached.insert(cached.end(), output.begin(), output.end() - 1);
+  EXPECT_THAT(target.cache(), ElementsAreArray(cached));
+}
+
+TEST(SpeculativeDecoderTest, SamplingAcceptsTheTargetsOwnDrafts) {
+  FakeModel draft(TargetNext);
+  FakeModel target(TargetNext);
+  SpeculativeDecodingOptions options;
+  options.num_draft_tokens = 4;
+  options.temperature = 1.0f;
+  SpeculativeDecodingStats stats;
+  Generate(&draft, &target, options, {9}, 31, &stats);
+  EXPECT_EQ(stats.AcceptanceRate(), 1.0f);
+}
+
+TEST(SpeculativeDecoderTest, RejectsMismatchedModels) {
+  FakeModel target(TargetNext);
+  SpeculativeDecoder decoder(nullptr, &target, SpeculativeDecodingOptions());
+  std::vector<int> output;
+  EXPECT_EQ(decoder.Generate({1}, 4, &output), kTfLiteError);
+  const std::vector<int> empty_prompt;
+  EXPECT_EQ(decoder.Generate(empty_prompt, 4, &output), kTfLiteError);
+}
+
+}  // namespace
+}  // namespace genai
+}  // namespace tflite
@@ -0,0 +1,212 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Measures the decoding speed, in tokens/s, of a target model alone and with
+// speculative decoding from a draft model, for several numbers of drafted
+// tokens. Both models must be converted with the genai ops and have the
+// signature described in signature_decoder_model.h.
+//
+// Example:
+//   speculative_decoding_benchmark --target_model=/path/to/target.tflite \
+//     --draft_model=/path/to/draft.tflite --num_draft_tokens=1,2,4,8
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tflite/core/interpreter.h"
+#include "tflite/core/interpreter_builder.h"
+#include "tflite/core/kernels/register.h"
+#include "tflite/core/model_builder.h"
+#include "tflite/experimental/genai/genai_ops.h"
+#include "tflite/experimental/genai/signature_decoder_model.h"
+#include "tflite/experimental/genai/speculative_decoder.h"
+#include "tflite/profiling/time.h"
+#include "tflite/tools/benchmark/benchmark_utils.h"
+#include "tflite/tools/command_line_flags.h"
+#include "tflite/tools/logging.h"
+
+namespace tflite {
+namespace genai {
+namespace {
+
+std::unique_ptr<Interpreter> CreateInterpreter(const FlatBufferModel& model,
+                                               int num_threads) {
+  ops::builtin::BuiltinOpResolver resolver;
+  ops::custom::GenAIOpsRegisterer(&resolver);
+  std::unique_ptr<Interpreter> interpreter;
+  InterpreterBuilder builder(model, resolver);
+  if (builder.SetNumThreads(num_threads) != kTfLiteOk ||
+      builder(&interpreter) != kTfLiteOk) {
+    return nullptr;
+  }
+  return interpreter;
+}
+
+struct Result {
+  double tokens_per_second = 0.0;
+  // Average time per run spent resizing the tensors, excluded from the speed.
+  double allocation_ms = 0.0;
+  SpeculativeDecodingStats stats;
+};
+
+uint64_t AllocationMicros(const SignatureDecoderModel* draft,
+                          const SignatureDecoderModel* target) {
+  return target->allocation_us() +
+         (draft == nullptr ? 0 : draft->allocation_us());
+}
+
+// Generates `num_tokens` tokens `num_runs` times and returns the average
+// speed, including the prompt.
+bool Run(SignatureDecoderModel* draft, SignatureDecoderModel* target,
+         const SpeculativeDecodingOptions& options,
+         const std::vector<int>& prompt, int num_tokens, int num_runs,
+         Result* result) {
+  // Steps decode k + 1 tokens in the target, and 1 or 2 in the draft: pad
+  // them to one size so that only the prompt resizes the tensors.
+  target->SetMinNumTokens(options.num_draft_tokens + 1);
+  if (draft != nullptr) draft->SetMinNumTokens(2);
+  SpeculativeDecoder decoder(draft, target, options);
+  std::vector<int> output;
+  int64_t generated_tokens = 0;
+  const uint64_t start_allocation_us = AllocationMicros(draft, target);
+  const uint64_t start_us = profiling::time::NowMicros();
+  for (int i = 0; i < num_runs; ++i) {
+    if (decoder.Generate(prompt, num_tokens, &output) != kTfLiteOk) {
+      return false;
+    }
+    generated_tokens += output.size();
+  }
+  const uint64_t allocation_us =
+      AllocationMicros(draft, target) - start_allocation_us;
+  const uint64_t elapsed_us =
+      profiling::time::NowMicros() - start_us - allocation_us;
+  result->tokens_per_second = generated_tokens * 1e6 / elapsed_us;
+  result->allocation_ms = allocation_us * 1e-3 / num_runs;
+  result->stats = decoder.stats();
+  return true;
+}
+
+int Main(int argc, char** argv) {
+  std::string target_model_path;
+  std::string draft_model_path;
+  SignatureDecoderModel::Names names;
+  std::string prompt_tokens = "1";
+  std::string num_draft_tokens_list = "1,2,4,8";
+  int32_t num_tokens = 128;
+  int32_t num_runs = 3;
+  int32_t num_threads = -1;
+  float temperature = 0.0f;
+
+  std::vector<Flag> flag_list = {
+      Flag::CreateFlag("target_model", &target_model_path,
+                       "Path to the target model."),
+      Flag::CreateFlag("draft_model", &draft_model_path,
+                       "Path to the draft model."),
+      Flag::CreateFlag("signature", &names.signature_key,
+                       "Decoding signature of both models."),
+      Flag::CreateFlag("tokens_input", &names.tokens,
+                       "Name of the tokens input of the signature."),
+      Flag::CreateFlag("positions_input", &names.positions,
+                       "Name of the positions input of the signature."),
+      Flag::CreateFlag("logits_output", &names.logits,
+                       "Name of the logits output of the signature."),
+      Flag::CreateFlag("prompt", &prompt_tokens,
+                       "Comma-separated token ids of the prompt."),
+      Flag::CreateFlag("num_tokens", &num_tokens,
+                       "Number of tokens to generate per run."),
+      Flag::CreateFlag("num_draft_tokens", &num_draft_tokens_list,
+                       "Comma-separated numbers of tokens to draft per step "
+                       "to compare with plain decoding."),
+      Flag::CreateFlag("num_runs", &num_runs,
+                       "Number of runs averaged per configuration."),
+      Flag::CreateFlag("num_threads", &num_threads,
+                       "Number of threads of each interpreter."),
+      Flag::CreateFlag("temperature", &temperature,
+                       "Sampling temperature, 0 decodes greedily."),
+  };
+  std::vector<int> prompt;
+  std::vector<int> num_draft_tokens;
+  if (!Flags::Parse(&argc, const_cast<const char**>(argv), flag_list) ||
+      target_model_path.empty() || draft_model_path.empty() ||
+      !benchmark::util::SplitAndParse(prompt_tokens, ',', &prompt) ||
+      !benchmark::util::SplitAndParse(num_draft_tokens_list, ',',
+                                      &num_draft_tokens) ||
+      prompt.empty() || num_tokens <= 0 || num_runs <= 0) {
+    TFLITE_LOG(ERROR) << Flags::Usage(argv[0], flag_list);
+    return 1;
+  }
+
+  auto target_model = FlatBufferModel::BuildFromFile(target_model_path.c_str());
+  auto draft_model = FlatBufferModel::BuildFromFile(draft_model_path.c_str());
+  if (!target_model || !draft_model) {
+    TFLITE_LOG(ERROR) << "Failed to load the models.";
+    return 1;
+  }
+  auto target_interpreter = CreateInterpreter(*target_model, num_threads);
+  auto draft_interpreter = CreateInterpreter(*draft_model, num_threads);
+  if (!target_interpreter || !draft_interpreter) {
+    TFLITE_LOG(ERROR) << "Failed to create the interpreters.";
+    return 1;
+  }
+  auto target = SignatureDecoderModel::Create(target_interpreter.get(), names);
+  auto draft = SignatureDecoderModel::Create(draft_interpreter.get(), names);
+  if (!target || !draft) return 1;
+
+  SpeculativeDecodingOptions options;
+  options.temperature = temperature;
+  options.num_draft_tokens = 0;
+  Result plain;
+  // Warm up the kernels, allocations are timed apart.
+  if (!Run(nullptr, target.get(), options, prompt, num_tokens, 1, &plain) ||
+      !Run(nullptr, target.get(), options, prompt, num_tokens, num_runs,
+           &plain)) {
+    TFLITE_LOG(ERROR) << "Plain decoding failed.";
+    return 1;
+  }
+  TFLITE_LOG(INFO) << "Plain decoding: " << plain.tokens_per_second
+                   << " tokens/s, " << plain.allocation_ms
+                   << " ms allocating per run";
+
+  for (const int k : num_draft_tokens) {
+    options.num_draft_tokens = k;
+    Result speculative;
+    if (!Run(draft.get(), target.get(), options, prompt, num_tokens, 1,
+             &speculative) ||
+        !Run(draft.get(), target.get(), options, prompt, num_tokens, num_runs,
+             &speculative)) {
+      TFLITE_LOG(ERROR) << "Speculative decoding with " << k
+                        << " draft tokens failed.";
+      return 1;
+    }
+    TFLITE_LOG(INFO) << "Speculative decoding with " << k
+                     << " draft tokens: " << speculative.tokens_per_second
+                     << " tokens/s (x"
+                     << speculative.tokens_per_second / plain.tokens_per_second
+                     << "), acceptance rate "
+                     << speculative.stats.AcceptanceRate() << ", "
+                     << speculative.stats.target_calls
+                     << " target calls for "
+                     << speculative.stats.generated_tokens << " tokens, "
+                     << speculative.allocation_ms << " ms allocating per run";
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace genai
+}  // namespace tflite
+
+int main(int argc, char** argv) { return tflite::genai::Main(argc, argv); }
@@ -88,7 +88,7 @@ static uint16_t Sqrt32(uint32_t num) {
   return res;
 }
 
-static uint32_t Sqrt64(uint64_t num) {
+uint32_t FilterbankSqrt64(uint64_t num) {
   // Take a shortcut and just use 32 bit operations if the upper word is all
   // clear. This will cause a slight off by one issue for numbers close to 2^32,
   // but it probably isn't going to matter (and gives us a big performance win).
@@ -124,7 +124,7 @@ uint32_t* FilterbankSqrt(struct FilterbankState* state, int scale_down_shift) {
   uint32_t* output = (uint32_t*)state->work;
   int i;
   for (i = 0; i < num_channels; ++i) {
-    *output++ = Sqrt64(*work++) >> scale_down_shift;
+    *output++ = FilterbankSqrt64(*work++) >> scale_down_shift;
   }
   return (uint32_t*)state->work;
 }
@@ -54,6 +54,9 @@ void FilterbankAccumulateChannels(struct FilterbankState* state,
 // next time FilterbankAccumulateChannels is called.
 uint32_t* FilterbankSqrt(struct FilterbankState* state, int scale_down_shift);
 
+// The rounded integer square root FilterbankSqrt applies to each channel.
+uint32_t FilterbankSqrt64(uint64_t num);
+
 void FilterbankReset(struct FilterbankState* state);
 
 #ifdef __cplusplus
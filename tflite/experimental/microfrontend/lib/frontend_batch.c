@@ -0,0 +1,217 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/microfrontend/lib/frontend_batch.h"
+
+#include <string.h>
+
+#include "tflite/experimental/microfrontend/lib/bits.h"
+
+// Windows every stream and transforms it, leaving the energy of the filterbank
+// bins in state->energy. Returns 0 if there weren't enough samples for a
+// window yet.
+static int BatchWindowAndFft(struct FrontendBatchState* state,
+                             const int16_t* samples, size_t stream_stride,
+                             size_t num_samples, size_t* num_samples_read) {
+  const int num_streams = state->num_streams;
+  const int start_index = state->shared.filterbank.start_index;
+  const int end_index = state->shared.filterbank.end_index;
+  struct WindowState window = state->shared.window;
+  int ready = 0;
+  int s;
+  for (s = 0; s < num_streams; ++s) {
+    window.input = state->window_input + s * window.size;
+    window.input_used = state->input_used;
+    ready = WindowProcessSamples(&window, samples + s * stream_stride,
+                                 num_samples, num_samples_read);
+    if (!ready) {
+      continue;
+    }
+
+    const int input_shift =
+        15 - MostSignificantBit32(window.max_abs_output_value);
+    state->input_shift[s] = input_shift;
+    FftCompute(&state->shared.fft, window.output, input_shift);
+
+    const struct complex_int16_t* fft_output = state->shared.fft.output;
+    int32_t* energy = state->energy + s;
+    int i;
+    for (i = start_index; i < end_index; ++i) {
+      const int32_t real = fft_output[i].real;
+      const int32_t imag = fft_output[i].imag;
+      const uint32_t mag_squared = (real * real) + (imag * imag);
+      energy[i * num_streams] = mag_squared;
+    }
+  }
+  state->input_used = window.input_used;
+  return ready;
+}
+
+// FilterbankAccumulateChannels and FilterbankSqrt over all streams.
+static void BatchFilterbank(struct FrontendBatchState* state) {
+  const struct FilterbankState* filterbank = &state->shared.filterbank;
+  const int num_streams = state->num_streams;
+  const int num_channels = filterbank->num_channels;
+  uint64_t* carry = state->carry;
+  uint64_t* next_carry = state->next_carry;
+  int s;
+  memset(carry, 0, num_streams * sizeof(*carry));
+
+  int i;
+  for (i = 0; i < num_channels + 1; ++i) {
+    const int32_t* magnitudes =
+        state->energy + filterbank->channel_frequency_starts[i] * num_streams;
+    const int16_t* weights =
+        filterbank->weights + filterbank->channel_weight_starts[i];
+    const int16_t* unweights =
+        filterbank->unweights + filterbank->channel_weight_starts[i];
+    const int width = filterbank->channel_widths[i];
+    uint64_t* work = state->work + i * num_streams;
+
+    memcpy(work, carry, num_streams * sizeof(*work));
+    memset(next_carry, 0, num_streams * sizeof(*next_carry));
+    int j;
+    for (j = 0; j < width; ++j, magnitudes += num_streams) {
+      const int16_t weight = weights[j];
+      const int16_t unweight = unweights[j];
+      // Channels are padded with zero weights for alignment.
+      if (weight == 0 && unweight == 0) {
+        continue;
+      }
+      for (s = 0; s < num_streams; ++s) {
+        work[s] += weight * ((uint64_t)magnitudes[s]);
+        next_carry[s] += unweight * ((uint64_t)magnitudes[s]);
+      }
+    }
+    uint64_t* swap = carry;
+    carry = next_carry;
+    next_carry = swap;
+  }
+
+  const uint64_t* work = state->work + num_streams;
+  uint32_t* signal = state->signal;
+  for (i = 0; i < num_channels; ++i) {
+    for (s = 0; s < num_streams; ++s) {
+      *signal++ = FilterbankSqrt64(*work++) >> state->input_shift[s];
+    }
+  }
+}
+
+// NoiseReductionApply over all streams.
+static void BatchNoiseReduction(struct FrontendBatchState* state) {
+  const struct NoiseReductionState* noise_reduction =
+      &state->shared.noise_reduction;
+  const int num_streams = state->num_streams;
+  const int smoothing_bits = noise_reduction->smoothing_bits;
+  const uint32_t min_signal_remaining = noise_reduction->min_signal_remaining;
+  int i;
+  for (i = 0; i < noise_reduction->num_channels; ++i) {
+    const uint32_t smoothing = ((i & 1) == 0) ? noise_reduction->even_smoothing
+                                              : noise_reduction->odd_smoothing;
+    const uint32_t one_minus_smoothing = (1 << kNoiseReductionBits) - smoothing;
+    uint32_t* signal = state->signal + i * num_streams;
+    uint32_t* noise_estimate = state->noise_estimate + i * num_streams;
+    int s;
+    for (s = 0; s < num_streams; ++s) {
+      // Update the estimate of the noise.
+      const uint32_t signal_scaled_up = signal[s] << smoothing_bits;
+      uint32_t estimate =
+          (((uint64_t)signal_scaled_up * smoothing) +
+           ((uint64_t)noise_estimate[s] * one_minus_smoothing)) >>
+          kNoiseReductionBits;
+      noise_estimate[s] = estimate;
+
+      // Make sure that we can't get a negative value for the signal - estimate.
+      if (estimate > signal_scaled_up) {
+        estimate = signal_scaled_up;
+      }
+
+      const uint32_t floor =
+          ((uint64_t)signal[s] * min_signal_remaining) >> kNoiseReductionBits;
+      const uint32_t subtracted =
+          (signal_scaled_up - estimate) >> smoothing_bits;
+      signal[s] = subtracted > floor ? subtracted : floor;
+    }
+  }
+}
+
+// PcanGainControlApply over all streams.
+static void BatchPcanGainControl(struct FrontendBatchState* state) {
+  const struct PcanGainControlState* pcan = &state->shared.pcan_gain_control;
+  const size_t size =
+      (size_t)state->shared.filterbank.num_channels * state->num_streams;
+  uint32_t* signal = state->signal;
+  const uint32_t* noise_estimate = state->noise_estimate;
+  size_t i;
+  for (i = 0; i < size; ++i) {
+    const uint32_t gain =
+        WideDynamicFunction(noise_estimate[i], pcan->gain_lut);
+    const uint32_t snr = ((uint64_t)signal[i] * gain) >> pcan->snr_shift;
+    signal[i] = PcanShrink(snr);
+  }
+}
+
+struct FrontendBatchOutput FrontendBatchProcessSamples(
+    struct FrontendBatchState* state, const int16_t* samples,
+    size_t stream_stride, size_t num_samples, size_t* num_samples_read) {
+  struct FrontendBatchOutput output;
+  output.values = NULL;
+  output.num_streams = 0;
+  output.size = 0;
+
+  // Try to apply the window - if it fails, return and wait for more data.
+  if (!BatchWindowAndFft(state, samples, stream_stride, num_samples,
+                         num_samples_read)) {
+    return output;
+  }
+
+  BatchFilterbank(state);
+  BatchNoiseReduction(state);
+  if (state->shared.pcan_gain_control.enable_pcan) {
+    BatchPcanGainControl(state);
+  }
+
+  // Apply the log and scale. The log is elementwise, so it runs on the
+  // [channel][stream] signal in place before it is transposed for output.
+  const int num_streams = state->num_streams;
+  const int num_channels = state->shared.filterbank.num_channels;
+  int correction_bits = MostSignificantBit32(state->shared.fft.fft_size) - 1 -
+                        (kFilterbankBits / 2);
+  const uint16_t* logged_filterbank =
+      LogScaleApply(&state->shared.log_scale, state->signal,
+                    num_channels * num_streams, correction_bits);
+  int i;
+  for (i = 0; i < num_channels; ++i) {
+    int s;
+    for (s = 0; s < num_streams; ++s) {
+      state->output[s * num_channels + i] = *logged_filterbank++;
+    }
+  }
+
+  output.values = state->output;
+  output.num_streams = num_streams;
+  output.size = num_channels;
+  return output;
+}
+
+void FrontendBatchReset(struct FrontendBatchState* state) {
+  const size_t num_streams = state->num_streams;
+  memset(state->window_input, 0,
+         num_streams * state->shared.window.size *
+             sizeof(*state->window_input));
+  state->input_used = 0;
+  memset(state->noise_estimate, 0,
+         num_streams * state->shared.filterbank.num_channels *
+             sizeof(*state->noise_estimate));
+}
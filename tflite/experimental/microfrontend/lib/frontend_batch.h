@@ -0,0 +1,84 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "tflite/experimental/microfrontend/lib/frontend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Runs the frontend over many independent streams at once. All streams share
+// one configuration and are fed in lockstep, the same number of samples per
+// call. Every stream produces exactly the features FrontendProcessSamples
+// would produce for it.
+//
+// Stream state is kept as [index][stream] arrays, so the filterbank, noise
+// reduction, gain control and log stages run the same arithmetic over all
+// streams in their innermost loops, which compilers vectorize. The FFT tables
+// and scratch are shared by the streams.
+struct FrontendBatchState {
+  // Tables for all streams. Its buffers are used as scratch.
+  struct FrontendState shared;
+  int num_streams;
+
+  // Samples buffered for the next window of each stream, [stream][window].
+  int16_t* window_input;
+  size_t input_used;
+  // FFT input shift of each stream's current window.
+  int* input_shift;
+
+  // Energy of each FFT bin, [bin][stream].
+  int32_t* energy;
+  // Filterbank accumulators, [channel + 1][stream], and the running
+  // unweighted sums carried from one channel to the next.
+  uint64_t* work;
+  uint64_t* carry;
+  uint64_t* next_carry;
+  // Per channel signal and noise estimate, [channel][stream].
+  uint32_t* signal;
+  uint32_t* noise_estimate;
+
+  // Features of the last window, [stream][channel].
+  uint16_t* output;
+};
+
+struct FrontendBatchOutput {
+  // Features of stream `s` start at `values + s * size`.
+  const uint16_t* values;
+  size_t num_streams;
+  size_t size;
+};
+
+// Batched FrontendProcessSamples. Stream `s` reads its samples from
+// `samples + s * stream_stride`. Updates num_samples_read to contain the number
+// of samples that have been consumed from each stream. If not enough samples
+// were added to generate features, the returned size will be 0 and the values
+// pointer will be NULL. The output is invalidated by the next call.
+struct FrontendBatchOutput FrontendBatchProcessSamples(
+    struct FrontendBatchState* state, const int16_t* samples,
+    size_t stream_stride, size_t num_samples, size_t* num_samples_read);
+
+void FrontendBatchReset(struct FrontendBatchState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_H_
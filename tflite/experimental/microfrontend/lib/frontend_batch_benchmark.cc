@@ -0,0 +1,115 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+// Compares feeding N streams through N FrontendStates against one
+// FrontendBatchState. The "streams_per_core" counter is the number of seconds
+// of audio processed per CPU second, i.e. how many real-time streams a single
+// core keeps up with.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
+#include "tflite/experimental/microfrontend/lib/frontend.h"
+#include "tflite/experimental/microfrontend/lib/frontend_batch.h"
+#include "tflite/experimental/microfrontend/lib/frontend_batch_util.h"
+#include "tflite/experimental/microfrontend/lib/frontend_util.h"
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+
+// One window step of audio for every stream, [stream][sample].
+std::vector<int16_t> MakeChunks(int num_streams, size_t chunk_size) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> sample(-8000, 8000);
+  std::vector<int16_t> chunks(num_streams * chunk_size);
+  for (auto& value : chunks) {
+    value = static_cast<int16_t>(sample(rng));
+  }
+  return chunks;
+}
+
+void SetStreamsPerCore(benchmark::State& state, int num_streams,
+                       size_t chunk_size) {
+  const double audio_seconds = static_cast<double>(state.iterations()) *
+                               num_streams * chunk_size / kSampleRate;
+  state.counters["streams_per_core"] =
+      benchmark::Counter(audio_seconds, benchmark::Counter::kIsRate);
+}
+
+void BM_FrontendPerStream(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  FrontendConfig config;
+  FrontendFillConfigWithDefaults(&config);
+  std::vector<FrontendState> frontends(num_streams);
+  for (auto& frontend : frontends) {
+    if (!FrontendPopulateState(&config, &frontend, kSampleRate)) {
+      state.SkipWithError("FrontendPopulateState failed");
+      return;
+    }
+  }
+  const size_t chunk_size = frontends[0].window.step;
+  const std::vector<int16_t> chunks = MakeChunks(num_streams, chunk_size);
+
+  for (auto _ : state) {
+    for (int s = 0; s < num_streams; ++s) {
+      size_t num_samples_read;
+      const FrontendOutput output =
+          FrontendProcessSamples(&frontends[s], chunks.data() + s * chunk_size,
+                                 chunk_size, &num_samples_read);
+      benchmark::DoNotOptimize(output.values);
+    }
+  }
+  SetStreamsPerCore(state, num_streams, chunk_size);
+
+  for (auto& frontend : frontends) {
+    FrontendFreeStateContents(&frontend);
+  }
+}
+
+void BM_FrontendBatch(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  FrontendConfig config;
+  FrontendFillConfigWithDefaults(&config);
+  FrontendBatchState batch;
+  if (!FrontendBatchPopulateState(&config, &batch, kSampleRate,
+                                  num_streams)) {
+    state.SkipWithError("FrontendBatchPopulateState failed");
+    return;
+  }
+  const size_t chunk_size = batch.shared.window.step;
+  const std::vector<int16_t> chunks = MakeChunks(num_streams, chunk_size);
+
+  for (auto _ : state) {
+    size_t num_samples_read;
+    const FrontendBatchOutput output = FrontendBatchProcessSamples(
+        &batch, chunks.data(), chunk_size, chunk_size, &num_samples_read);
+    benchmark::DoNotOptimize(output.values);
+  }
+  SetStreamsPerCore(state, num_streams, chunk_size);
+
+  FrontendBatchFreeStateContents(&batch);
+}
+
+BENCHMARK(BM_FrontendPerStream)->ArgName("streams")->RangeMultiplier(4)->Range(
+    1, 1024);
+BENCHMARK(BM_FrontendBatch)->ArgName("streams")->RangeMultiplier(4)->Range(
+    1, 1024);
+
+}  // namespace
+
+BENCHMARK_MAIN();
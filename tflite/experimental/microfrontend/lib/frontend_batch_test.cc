@@ -0,0 +1,132 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/microfrontend/lib/frontend_batch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/experimental/microfrontend/lib/frontend.h"
+#include "tflite/experimental/microfrontend/lib/frontend_batch_util.h"
+#include "tflite/experimental/microfrontend/lib/frontend_util.h"
+
+namespace {
+
+constexpr int kSampleRate = 16000;
+constexpr int kNumStreams = 5;
+// Deliberately not a multiple of the window step.
+constexpr size_t kChunkSize = 70;
+constexpr size_t kNumSamples = 4000;
+
+// Streams of different loudness, with tones under white noise so that the
+// noise estimates and gains of the streams diverge.
+std::vector<std::vector<int16_t>> MakeStreams() {
+  std::mt19937 rng(1234);
+  std::vector<std::vector<int16_t>> streams(kNumStreams);
+  for (int s = 0; s < kNumStreams; ++s) {
+    const int amplitude = 100 << (2 * s);
+    std::uniform_int_distribution<int> noise(-amplitude / 4, amplitude / 4);
+    for (size_t i = 0; i < kNumSamples; ++i) {
+      const int tone = (i / (8 + s)) % 2 == 0 ? amplitude : -amplitude;
+      int sample = tone + noise(rng);
+      if (sample > INT16_MAX) sample = INT16_MAX;
+      if (sample < INT16_MIN) sample = INT16_MIN;
+      streams[s].push_back(static_cast<int16_t>(sample));
+    }
+  }
+  return streams;
+}
+
+void ExpectMatchesPerStreamFrontend(const FrontendConfig& config) {
+  const std::vector<std::vector<int16_t>> streams = MakeStreams();
+
+  std::vector<FrontendState> states(kNumStreams);
+  for (auto& state : states) {
+    ASSERT_TRUE(FrontendPopulateState(&config, &state, kSampleRate));
+  }
+  FrontendBatchState batch;
+  ASSERT_TRUE(
+      FrontendBatchPopulateState(&config, &batch, kSampleRate, kNumStreams));
+
+  // Stream s reads its chunk at `chunks + s * kChunkSize`.
+  std::vector<int16_t> chunks(kNumStreams * kChunkSize);
+  int num_outputs = 0;
+  for (size_t offset = 0; offset + kChunkSize <= kNumSamples;
+       offset += kChunkSize) {
+    for (int s = 0; s < kNumStreams; ++s) {
+      std::copy(streams[s].begin() + offset,
+                streams[s].begin() + offset + kChunkSize,
+                chunks.begin() + s * kChunkSize);
+    }
+
+    size_t batch_read = 0;
+    size_t batch_offset = 0;
+    std::vector<size_t> read(kNumStreams, 0);
+    while (batch_offset < kChunkSize) {
+      const FrontendBatchOutput output = FrontendBatchProcessSamples(
+          &batch, chunks.data() + batch_offset, kChunkSize,
+          kChunkSize - batch_offset, &batch_read);
+      for (int s = 0; s < kNumStreams; ++s) {
+        size_t stream_read = 0;
+        const FrontendOutput expected = FrontendProcessSamples(
+            &states[s], chunks.data() + s * kChunkSize + read[s],
+            kChunkSize - read[s], &stream_read);
+        read[s] += stream_read;
+        ASSERT_EQ(stream_read, batch_read);
+        ASSERT_EQ(expected.size, output.size);
+        if (expected.size == 0) continue;
+        ASSERT_EQ(output.num_streams, kNumStreams);
+        for (size_t i = 0; i < expected.size; ++i) {
+          ASSERT_EQ(output.values[s * output.size + i], expected.values[i])
+              << "stream " << s << ", channel " << i << ", output "
+              << num_outputs;
+        }
+      }
+      batch_offset += batch_read;
+      if (output.size > 0) ++num_outputs;
+    }
+  }
+  EXPECT_GT(num_outputs, 20);
+
+  FrontendBatchFreeStateContents(&batch);
+  for (auto& state : states) {
+    FrontendFreeStateContents(&state);
+  }
+}
+
+TEST(FrontendBatchTest, MatchesFrontendProcessSamples) {
+  FrontendConfig config;
+  FrontendFillConfigWithDefaults(&config);
+  ExpectMatchesPerStreamFrontend(config);
+}
+
+TEST(FrontendBatchTest, MatchesFrontendProcessSamplesWithPcan) {
+  FrontendConfig config;
+  FrontendFillConfigWithDefaults(&config);
+  config.pcan_gain_control.enable_pcan = 1;
+  ExpectMatchesPerStreamFrontend(config);
+}
+
+TEST(FrontendBatchTest, RejectsEmptyBatch) {
+  FrontendConfig config;
+  FrontendFillConfigWithDefaults(&config);
+  FrontendBatchState batch;
+  EXPECT_FALSE(FrontendBatchPopulateState(&config, &batch, kSampleRate, 0));
+}
+
+}  // namespace
@@ -0,0 +1,78 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/microfrontend/lib/frontend_batch_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+int FrontendBatchPopulateState(const struct FrontendConfig* config,
+                               struct FrontendBatchState* state,
+                               int sample_rate, int num_streams) {
+  memset(state, 0, sizeof(*state));
+
+  if (num_streams <= 0) {
+    fprintf(stderr, "Invalid number of streams %d\n", num_streams);
+    return 0;
+  }
+  state->num_streams = num_streams;
+
+  if (!FrontendPopulateState(config, &state->shared, sample_rate)) {
+    fprintf(stderr, "Failed to populate shared frontend state\n");
+    return 0;
+  }
+
+  const size_t window_size = state->shared.window.size;
+  // Sized like the FFT output buffer that FrontendProcessSamples reuses for
+  // the energy, since the padded filterbank channels may read past the last
+  // bin.
+  const size_t num_bins = (state->shared.fft.fft_size / 2 + 1) * 2;
+  const size_t num_channels = state->shared.filterbank.num_channels;
+  state->window_input =
+      calloc(num_streams * window_size, sizeof(*state->window_input));
+  state->input_shift = calloc(num_streams, sizeof(*state->input_shift));
+  state->energy = calloc(num_streams * num_bins, sizeof(*state->energy));
+  state->work = calloc(num_streams * (num_channels + 1), sizeof(*state->work));
+  state->carry = calloc(num_streams, sizeof(*state->carry));
+  state->next_carry = calloc(num_streams, sizeof(*state->next_carry));
+  state->signal = calloc(num_streams * num_channels, sizeof(*state->signal));
+  state->noise_estimate =
+      calloc(num_streams * num_channels, sizeof(*state->noise_estimate));
+  state->output = calloc(num_streams * num_channels, sizeof(*state->output));
+  if (state->window_input == NULL || state->input_shift == NULL ||
+      state->energy == NULL || state->work == NULL || state->carry == NULL ||
+      state->next_carry == NULL || state->signal == NULL ||
+      state->noise_estimate == NULL || state->output == NULL) {
+    fprintf(stderr, "Failed to alloc batch buffers\n");
+    return 0;
+  }
+
+  FrontendBatchReset(state);
+
+  // All good, return a true value.
+  return 1;
+}
+
+void FrontendBatchFreeStateContents(struct FrontendBatchState* state) {
+  FrontendFreeStateContents(&state->shared);
+  free(state->window_input);
+  free(state->input_shift);
+  free(state->energy);
+  free(state->work);
+  free(state->carry);
+  free(state->next_carry);
+  free(state->signal);
+  free(state->noise_estimate);
+  free(state->output);
+}
@@ -0,0 +1,37 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_UTIL_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_UTIL_H_
+
+#include "tflite/experimental/microfrontend/lib/frontend_batch.h"
+#include "tflite/experimental/microfrontend/lib/frontend_util.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Allocates any buffers for `num_streams` streams.
+int FrontendBatchPopulateState(const struct FrontendConfig* config,
+                               struct FrontendBatchState* state,
+                               int sample_rate, int num_streams);
+
+// Frees any allocated buffers.
+void FrontendBatchFreeStateContents(struct FrontendBatchState* state);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_MICROFRONTEND_LIB_FRONTEND_BATCH_UTIL_H_
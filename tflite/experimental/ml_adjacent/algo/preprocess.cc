@@ -0,0 +1,276 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/preprocess.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tflite/experimental/ml_adjacent/algo/preprocess_rows.h"
+#include "tflite/experimental/ml_adjacent/lib.h"
+#include "tflite/kernels/internal/compatibility.h"
+
+namespace ml_adj {
+namespace preprocess {
+namespace {
+
+using ::ml_adj::algo::Algo;
+using ::ml_adj::algo::InputPack;
+using ::ml_adj::algo::OutputPack;
+using ::ml_adj::data::DataRef;
+using ::ml_adj::data::MutableDataRef;
+
+constexpr dim_t kNumChannels = 3;
+
+// Rounds and saturates `value` for integer outputs.
+template <typename T>
+inline T CastOutput(float value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return value;
+  } else {
+    constexpr float kMin = std::numeric_limits<T>::min();
+    constexpr float kMax = std::numeric_limits<T>::max();
+    return static_cast<T>(std::round(std::min(std::max(value, kMin), kMax)));
+  }
+}
+
+// Writes three planes of `width` values either interleaved (NHWC) or
+// `channel_stride` elements apart (NCHW).
+template <typename T>
+void StorePlanes(const float* planes, dim_t width, bool interleave,
+                 ind_t channel_stride, T* out) {
+  const float* r = planes;
+  const float* g = planes + width;
+  const float* b = planes + 2 * width;
+  if (!interleave) {
+    for (dim_t c = 0; c < kNumChannels; ++c) {
+      const float* src = planes + c * width;
+      T* dst = out + c * channel_stride;
+      for (dim_t x = 0; x < width; ++x) {
+        dst[x] = CastOutput<T>(src[x]);
+      }
+    }
+    return;
+  }
+  if constexpr (std::is_same_v<T, float>) {
+    InterleaveRgb(r, g, b, width, out);
+  } else {
+    for (dim_t x = 0; x < width; ++x) {
+      out[kNumChannels * x] = CastOutput<T>(r[x]);
+      out[kNumChannels * x + 1] = CastOutput<T>(g[x]);
+      out[kNumChannels * x + 2] = CastOutput<T>(b[x]);
+    }
+  }
+}
+
+// Runs every tile on the calling thread.
+void ComputePreprocess(const InputPack& inputs, const OutputPack& outputs) {
+  const Preprocessor preprocessor(inputs, outputs);
+  for (dim_t tile = 0; tile < preprocessor.NumTiles(); ++tile) {
+    preprocessor.RunTile(tile);
+  }
+}
+
+}  // namespace
+
+Preprocessor::Preprocessor(const InputPack& inputs,
+                           const OutputPack& outputs) {
+  TFLITE_CHECK(inputs.size() == 6);
+  TFLITE_CHECK(outputs.size() == 1);
+
+  // Extract source image.
+  const DataRef* img = inputs[0];
+  TFLITE_CHECK(img->Type() == etype_t::u8);
+  TFLITE_CHECK(img->Dims().size() == 4);
+  img_data_ = reinterpret_cast<const uint8_t*>(img->Data());
+  format_ = reinterpret_cast<const int32_t*>(inputs[1]->Data())[0];
+  batches_ = img->Dims()[0];
+  img_width_ = img->Dims()[2];
+  if (format_ == kRgb) {
+    TFLITE_CHECK(img->Dims()[3] == kNumChannels);
+    img_height_ = img->Dims()[1];
+  } else {
+    TFLITE_CHECK(format_ == kNv21 || format_ == kNv12);
+    TFLITE_CHECK(img->Dims()[3] == 1);
+    TFLITE_CHECK(img->Dims()[1] % 3 == 0);
+    TFLITE_CHECK(img_width_ % 2 == 0);
+    img_height_ = img->Dims()[1] / 3 * 2;
+  }
+
+  // Extract bounding box. It is signed, so that negative values are rejected
+  // rather than wrapped around, and compared in 64 bits.
+  const int32_t* box = reinterpret_cast<const int32_t*>(inputs[2]->Data());
+  TFLITE_CHECK(box[0] >= 0 && box[1] >= 0);
+  TFLITE_CHECK(box[2] > 0 && box[3] > 0);
+  TFLITE_CHECK(int64_t{box[0]} <= int64_t{img_height_} - box[2]);
+  TFLITE_CHECK(int64_t{box[1]} <= int64_t{img_width_} - box[3]);
+  crop_y_ = box[0];
+  crop_x_ = box[1];
+  crop_height_ = box[2];
+  crop_width_ = box[3];
+
+  // Extract new image size.
+  const int32_t* size = reinterpret_cast<const int32_t*>(inputs[3]->Data());
+  TFLITE_CHECK(size[0] > 0 && size[1] > 0);
+  out_height_ = size[0];
+  out_width_ = size[1];
+
+  // Extract per channel mean and standard deviation.
+  const float* norm = reinterpret_cast<const float*>(inputs[4]->Data());
+  for (dim_t c = 0; c < kNumChannels; ++c) {
+    mean_[c] = norm[c];
+    inv_std_[c] = 1.0f / norm[kNumChannels + c];
+  }
+
+  layout_ = reinterpret_cast<const int32_t*>(inputs[5]->Data())[0];
+  TFLITE_CHECK(layout_ == kNhwc || layout_ == kNchw);
+
+  // Resize output buffer for the model input.
+  MutableDataRef* output = outputs[0];
+  out_type_ = output->Type();
+  TFLITE_CHECK(out_type_ == etype_t::f32 || out_type_ == etype_t::u8 ||
+               out_type_ == etype_t::i8);
+  if (layout_ == kNhwc) {
+    output->Resize({batches_, out_height_, out_width_, kNumChannels});
+  } else {
+    output->Resize({batches_, kNumChannels, out_height_, out_width_});
+  }
+  out_data_ = output->Data();
+
+  height_scale_ = static_cast<float>(crop_height_) / out_height_;
+  tiles_per_image_ = (out_height_ + kTileRows - 1) / kTileRows;
+
+  // Horizontal sampling positions, as in `Impl_Resize`.
+  const float width_scale = static_cast<float>(crop_width_) / out_width_;
+  x0_.resize(out_width_);
+  x1_.resize(out_width_);
+  x_frac_.resize(out_width_);
+  for (dim_t x = 0; x < out_width_; ++x) {
+    const float in_x = x * width_scale;
+    x0_[x] = std::max(static_cast<int32_t>(std::floor(in_x)), 0);
+    x1_[x] = std::min(static_cast<int32_t>(std::ceil(in_x)),
+                      static_cast<int32_t>(crop_width_) - 1);
+    x_frac_[x] = in_x - x0_[x];
+  }
+}
+
+void Preprocessor::LoadRow(dim_t b, dim_t y, float* planes) const {
+  float* r = planes;
+  float* g = planes + crop_width_;
+  float* bl = planes + 2 * crop_width_;
+  const ind_t row = crop_y_ + y;
+
+  if (format_ == kRgb) {
+    const uint8_t* src =
+        img_data_ +
+        ((b * img_height_ + row) * img_width_ + crop_x_) * kNumChannels;
+    DeinterleaveRgb(src, crop_width_, r, g, bl);
+    return;
+  }
+
+  const ind_t frame_size = static_cast<ind_t>(img_height_) * 3 / 2 * img_width_;
+  const uint8_t* frame = img_data_ + b * frame_size;
+  const uint8_t* luma = frame + row * img_width_;
+  const uint8_t* chroma = frame + (img_height_ + row / 2) * img_width_;
+  const dim_t u_offset = format_ == kNv12 ? 0 : 1;
+  YuvToRgb(luma, chroma, u_offset, crop_x_, crop_width_, r, g, bl);
+}
+
+void Preprocessor::StoreRow(dim_t b, dim_t y, const float* planes) const {
+  const bool nhwc = layout_ == kNhwc;
+  const ind_t plane_size = static_cast<ind_t>(out_height_) * out_width_;
+  const ind_t offset =
+      nhwc ? ((b * out_height_ + y) * out_width_) * kNumChannels
+           : b * kNumChannels * plane_size + y * out_width_;
+  switch (out_type_) {
+    case etype_t::u8:
+      StorePlanes(planes, out_width_, nhwc, plane_size,
+                  reinterpret_cast<uint8_t*>(out_data_) + offset);
+      break;
+    case etype_t::i8:
+      StorePlanes(planes, out_width_, nhwc, plane_size,
+                  reinterpret_cast<int8_t*>(out_data_) + offset);
+      break;
+    default:
+      StorePlanes(planes, out_width_, nhwc, plane_size,
+                  reinterpret_cast<float*>(out_data_) + offset);
+      break;
+  }
+}
+
+void Preprocessor::RunTile(dim_t tile) const {
+  const dim_t b = tile / tiles_per_image_;
+  const dim_t row_begin = (tile % tiles_per_image_) * kTileRows;
+  const dim_t row_end = std::min(row_begin + kTileRows, out_height_);
+
+  // Two cached source rows, their blend, and the resampled output row, each
+  // stored as three channel planes.
+  const dim_t src_size = kNumChannels * crop_width_;
+  std::vector<float> scratch(3 * src_size + kNumChannels * out_width_);
+  float* top = scratch.data();
+  float* bottom = top + src_size;
+  float* blend = bottom + src_size;
+  float* row = blend + src_size;
+  int64_t top_y = -1;
+  int64_t bottom_y = -1;
+
+  for (dim_t y = row_begin; y < row_end; ++y) {
+    const float in_y = y * height_scale_;
+    const int32_t y0 = std::max(static_cast<int32_t>(std::floor(in_y)), 0);
+    const int32_t y1 = std::min(static_cast<int32_t>(std::ceil(in_y)),
+                                static_cast<int32_t>(crop_height_) - 1);
+
+    // Consecutive output rows mostly share source rows, so only convert the
+    // ones that are not cached yet.
+    if (top_y != y0) {
+      if (bottom_y == y0) {
+        std::swap(top, bottom);
+        std::swap(top_y, bottom_y);
+      } else {
+        LoadRow(b, y0, top);
+        top_y = y0;
+      }
+    }
+    const float* src = top;
+    if (y1 != y0) {
+      if (bottom_y != y1) {
+        LoadRow(b, y1, bottom);
+        bottom_y = y1;
+      }
+      LerpRows(top, bottom, in_y - y0, src_size, blend);
+      src = blend;
+    }
+
+    for (dim_t c = 0; c < kNumChannels; ++c) {
+      float* dst_plane = row + c * out_width_;
+      GatherLerp(src + c * crop_width_, x0_.data(), x1_.data(),
+                 x_frac_.data(), out_width_, dst_plane);
+      NormalizeRow(mean_[c], inv_std_[c], out_width_, dst_plane);
+    }
+    StoreRow(b, y, row);
+  }
+}
+
+const Algo* Impl_Preprocess() {
+  static const Algo preprocess = {&ComputePreprocess, nullptr};
+  return &preprocess;
+}
+
+}  // namespace preprocess
+}  // namespace ml_adj
@@ -0,0 +1,125 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+namespace ml_adj {
+namespace preprocess {
+
+// Pixel formats accepted by `Impl_Preprocess`.
+enum PixelFormat : int32_t {
+  // Interleaved RGB, [batch, height, width, 3].
+  kRgb = 0,
+  // Semi-planar YUV 4:2:0 with a full resolution Y plane followed by a half
+  // resolution plane of interleaved V and U (NV21) or U and V (NV12) samples,
+  // [batch, height * 3 / 2, width, 1]. Height and width must be even.
+  kNv21 = 1,
+  kNv12 = 2,
+};
+
+// Layouts `Impl_Preprocess` can write.
+enum Layout : int32_t {
+  kNhwc = 0,
+  kNchw = 1,
+};
+
+// Fused Crop, Resize, Color Conversion and Normalization
+//
+// Inputs: [img: uint8, format: scalar<int>, box: vector<int>,
+//          size: vector<int>, norm: vector<float>, layout: scalar<int>]
+// Ouputs: [img: float | uint8 | int8]
+//
+// Turns a camera frame or decoded image into a model input in a single pass.
+// `img` is read in `format` (see `PixelFormat`). The bounding box
+// `box` = [offset_height, offset_width, target_height, target_width] is cut out
+// of it as in `tf.image.crop_to_bounding_box`, and resized to
+// `size` = [new_height, new_width] with the bilinear interpolation of
+// `Impl_Resize`. YUV frames are converted to RGB with full range BT.601
+// coefficients, then every channel `c` is normalized with
+// `(value - norm[c]) / norm[3 + c]`, where `value` is in [0, 255]. The result
+// is written in `layout` (see `Layout`) and in the type of the output. For
+// integer outputs the normalized values are rounded and saturated, so a
+// quantized model input is produced by folding its scale and zero point into
+// `norm`.
+//
+// No intermediate image is materialized: every output row samples the two
+// source rows it needs straight from `img`.
+
+const algo::Algo* Impl_Preprocess();
+
+// The same op split into row tiles that may be computed concurrently, for
+// callers that own a thread pool. `Impl_Preprocess` runs all of the tiles on
+// the calling thread.
+class Preprocessor {
+ public:
+  // Number of output rows in a tile.
+  static constexpr dim_t kTileRows = 16;
+
+  // Checks the inputs and resizes the output, which must outlive `this`.
+  Preprocessor(const algo::InputPack& inputs, const algo::OutputPack& outputs);
+
+  // Number of tiles over all batches.
+  dim_t NumTiles() const { return batches_ * tiles_per_image_; }
+
+  // Computes the output rows of `tile`. Calls for different tiles may run
+  // concurrently.
+  void RunTile(dim_t tile) const;
+
+ private:
+  // Converts row `y` of the crop in batch `b` into three float planes of
+  // `crop_width_` elements each.
+  void LoadRow(dim_t b, dim_t y, float* planes) const;
+
+  // Writes the normalized planes of output row `y` in batch `b`.
+  void StoreRow(dim_t b, dim_t y, const float* planes) const;
+
+  const uint8_t* img_data_ = nullptr;
+  int32_t format_ = kRgb;
+  int32_t layout_ = kNhwc;
+  dim_t batches_ = 0;
+  dim_t img_height_ = 0;
+  dim_t img_width_ = 0;
+
+  dim_t crop_y_ = 0;
+  dim_t crop_x_ = 0;
+  dim_t crop_height_ = 0;
+  dim_t crop_width_ = 0;
+
+  dim_t out_height_ = 0;
+  dim_t out_width_ = 0;
+  dim_t tiles_per_image_ = 0;
+  float height_scale_ = 0.0f;
+
+  float mean_[3] = {};
+  float inv_std_[3] = {};
+
+  etype_t out_type_ = etype_t::f32;
+  void* out_data_ = nullptr;
+
+  // Horizontal sampling positions, shared by all rows.
+  std::vector<int32_t> x0_;
+  std::vector<int32_t> x1_;
+  std::vector<float> x_frac_;
+};
+
+}  // namespace preprocess
+}  // namespace ml_adj
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_H_
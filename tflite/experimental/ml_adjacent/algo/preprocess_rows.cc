@@ -0,0 +1,368 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/preprocess_rows.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+#if defined(__SSSE3__)
+#define ML_ADJ_PREPROCESS_SSSE3
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define ML_ADJ_PREPROCESS_NEON
+#include <arm_neon.h>
+#endif
+
+namespace ml_adj {
+namespace preprocess {
+namespace {
+
+constexpr dim_t kNumChannels = 3;
+
+// Full range BT.601 coefficients.
+constexpr float kRFromV = 1.402f;
+constexpr float kGFromU = 0.344136f;
+constexpr float kGFromV = 0.714136f;
+constexpr float kBFromU = 1.772f;
+
+// Clamps a converted color value to the range of the source pixels.
+inline float ClampPixel(float value) {
+  return std::min(std::max(value, 0.0f), 255.0f);
+}
+
+#ifdef ML_ADJ_PREPROCESS_SSSE3
+inline __m128 ClampPixels(__m128 values) {
+  return _mm_min_ps(_mm_max_ps(values, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+}
+
+// Converts 4 pixels with their luma and centered chroma as floats.
+inline void StoreYuvAsRgb(__m128 l, __m128 u, __m128 v, float* r, float* g,
+                          float* b) {
+  _mm_storeu_ps(r, ClampPixels(_mm_add_ps(l, _mm_mul_ps(v, _mm_set1_ps(
+                                                            kRFromV)))));
+  _mm_storeu_ps(
+      g, ClampPixels(_mm_sub_ps(
+             _mm_sub_ps(l, _mm_mul_ps(u, _mm_set1_ps(kGFromU))),
+             _mm_mul_ps(v, _mm_set1_ps(kGFromV)))));
+  _mm_storeu_ps(b, ClampPixels(_mm_add_ps(l, _mm_mul_ps(u, _mm_set1_ps(
+                                                            kBFromU)))));
+}
+#endif
+
+#ifdef ML_ADJ_PREPROCESS_NEON
+inline float32x4_t ClampPixels(float32x4_t values) {
+  return vminq_f32(vmaxq_f32(values, vdupq_n_f32(0.0f)), vdupq_n_f32(255.0f));
+}
+
+// Widens 8 pixels to float.
+inline void WidenToFloat(uint8x8_t pixels, float* out) {
+  const uint16x8_t wide = vmovl_u8(pixels);
+  vst1q_f32(out, vcvtq_f32_u32(vmovl_u16(vget_low_u16(wide))));
+  vst1q_f32(out + 4, vcvtq_f32_u32(vmovl_u16(vget_high_u16(wide))));
+}
+
+// Widens 4 of the 8 values in `values` to float, the low ones if `high` is
+// false.
+inline float32x4_t WidenQuarter(uint16x8_t values, bool high) {
+  return vcvtq_f32_u32(
+      vmovl_u16(high ? vget_high_u16(values) : vget_low_u16(values)));
+}
+
+// Converts 4 pixels with their luma and centered chroma as floats.
+inline void StoreYuvAsRgb(float32x4_t l, float32x4_t u, float32x4_t v,
+                          float* r, float* g, float* b) {
+  vst1q_f32(r, ClampPixels(vaddq_f32(l, vmulq_n_f32(v, kRFromV))));
+  vst1q_f32(g, ClampPixels(vsubq_f32(vsubq_f32(l, vmulq_n_f32(u, kGFromU)),
+                                     vmulq_n_f32(v, kGFromV))));
+  vst1q_f32(b, ClampPixels(vaddq_f32(l, vmulq_n_f32(u, kBFromU))));
+}
+#endif
+
+}  // namespace
+
+void PortableDeinterleaveRgb(const uint8_t* src, dim_t width, float* r,
+                             float* g, float* b) {
+  for (dim_t x = 0; x < width; ++x) {
+    r[x] = src[kNumChannels * x];
+    g[x] = src[kNumChannels * x + 1];
+    b[x] = src[kNumChannels * x + 2];
+  }
+}
+
+void DeinterleaveRgb(const uint8_t* src, dim_t width, float* r, float* g,
+                     float* b) {
+  dim_t x = 0;
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  // Picks the bytes of one channel out of 4 pixels, zero extended to 32 bits.
+  const __m128i r_mask =
+      _mm_setr_epi8(0, -1, -1, -1, 3, -1, -1, -1, 6, -1, -1, -1, 9, -1, -1, -1);
+  const __m128i g_mask = _mm_setr_epi8(1, -1, -1, -1, 4, -1, -1, -1, 7, -1, -1,
+                                       -1, 10, -1, -1, -1);
+  const __m128i b_mask = _mm_setr_epi8(2, -1, -1, -1, 5, -1, -1, -1, 8, -1, -1,
+                                       -1, 11, -1, -1, -1);
+  // The 16 byte loads read 4 bytes past the 4 pixels they convert.
+  for (; x + 6 <= width; x += 4) {
+    const __m128i pixels = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src + kNumChannels * x));
+    _mm_storeu_ps(r + x, _mm_cvtepi32_ps(_mm_shuffle_epi8(pixels, r_mask)));
+    _mm_storeu_ps(g + x, _mm_cvtepi32_ps(_mm_shuffle_epi8(pixels, g_mask)));
+    _mm_storeu_ps(b + x, _mm_cvtepi32_ps(_mm_shuffle_epi8(pixels, b_mask)));
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  for (; x + 8 <= width; x += 8) {
+    const uint8x8x3_t pixels = vld3_u8(src + kNumChannels * x);
+    WidenToFloat(pixels.val[0], r + x);
+    WidenToFloat(pixels.val[1], g + x);
+    WidenToFloat(pixels.val[2], b + x);
+  }
+#endif
+  PortableDeinterleaveRgb(src + kNumChannels * x, width - x, r + x, g + x,
+                          b + x);
+}
+
+void PortableYuvToRgb(const uint8_t* luma, const uint8_t* chroma,
+                      dim_t u_offset, dim_t x_begin, dim_t width, float* r,
+                      float* g, float* b) {
+  const dim_t v_offset = 1 - u_offset;
+  for (dim_t x = 0; x < width; ++x) {
+    const dim_t src_x = x_begin + x;
+    const uint8_t* uv = chroma + (src_x & ~dim_t{1});
+    const float l = luma[src_x];
+    const float u = uv[u_offset] - 128.0f;
+    const float v = uv[v_offset] - 128.0f;
+    r[x] = ClampPixel(l + kRFromV * v);
+    g[x] = ClampPixel(l - kGFromU * u - kGFromV * v);
+    b[x] = ClampPixel(l + kBFromU * u);
+  }
+}
+
+void YuvToRgb(const uint8_t* luma, const uint8_t* chroma, dim_t u_offset,
+              dim_t x_begin, dim_t width, float* r, float* g, float* b) {
+  dim_t x = 0;
+#if defined(ML_ADJ_PREPROCESS_SSSE3) || defined(ML_ADJ_PREPROCESS_NEON)
+  // Blocks of 16 pixels start at an even column, so that they cover 8 whole
+  // chroma pairs.
+  if (x_begin % 2 == 1 && width > 0) {
+    PortableYuvToRgb(luma, chroma, u_offset, x_begin, 1, r, g, b);
+    x = 1;
+  }
+#endif
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 chroma_zero = _mm_set1_ps(128.0f);
+  for (; x + 16 <= width; x += 16) {
+    const dim_t src_x = x_begin + x;
+    const __m128i y =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(luma + src_x));
+    const __m128i uv =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(chroma + src_x));
+    // One chroma sample of each pair per 16 bit lane.
+    const __m128i first = _mm_and_si128(uv, _mm_set1_epi16(0xff));
+    const __m128i second = _mm_srli_epi16(uv, 8);
+    const __m128i u16 = u_offset == 0 ? first : second;
+    const __m128i v16 = u_offset == 0 ? second : first;
+    for (int half = 0; half < 2; ++half) {
+      const __m128i y16 =
+          half == 0 ? _mm_unpacklo_epi8(y, zero) : _mm_unpackhi_epi8(y, zero);
+      const __m128i u32 = half == 0 ? _mm_unpacklo_epi16(u16, zero)
+                                    : _mm_unpackhi_epi16(u16, zero);
+      const __m128i v32 = half == 0 ? _mm_unpacklo_epi16(v16, zero)
+                                    : _mm_unpackhi_epi16(v16, zero);
+      for (int quarter = 0; quarter < 2; ++quarter) {
+        const dim_t i = x + 8 * half + 4 * quarter;
+        // Each pair of pixels shares a chroma sample.
+        const __m128i y32 = quarter == 0 ? _mm_unpacklo_epi16(y16, zero)
+                                         : _mm_unpackhi_epi16(y16, zero);
+        const __m128i u_pairs =
+            quarter == 0 ? _mm_shuffle_epi32(u32, _MM_SHUFFLE(1, 1, 0, 0))
+                         : _mm_shuffle_epi32(u32, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m128i v_pairs =
+            quarter == 0 ? _mm_shuffle_epi32(v32, _MM_SHUFFLE(1, 1, 0, 0))
+                         : _mm_shuffle_epi32(v32, _MM_SHUFFLE(3, 3, 2, 2));
+        StoreYuvAsRgb(_mm_cvtepi32_ps(y32),
+                      _mm_sub_ps(_mm_cvtepi32_ps(u_pairs), chroma_zero),
+                      _mm_sub_ps(_mm_cvtepi32_ps(v_pairs), chroma_zero),
+                      r + i, g + i, b + i);
+      }
+    }
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  const float32x4_t chroma_zero = vdupq_n_f32(128.0f);
+  for (; x + 16 <= width; x += 16) {
+    const dim_t src_x = x_begin + x;
+    const uint8x16_t y = vld1q_u8(luma + src_x);
+    const uint8x8x2_t uv = vld2_u8(chroma + src_x);
+    // Each pair of pixels shares a chroma sample.
+    const uint8x8x2_t u_pairs = vzip_u8(uv.val[u_offset], uv.val[u_offset]);
+    const uint8x8x2_t v_pairs =
+        vzip_u8(uv.val[1 - u_offset], uv.val[1 - u_offset]);
+    for (int half = 0; half < 2; ++half) {
+      const uint16x8_t y16 =
+          vmovl_u8(half == 0 ? vget_low_u8(y) : vget_high_u8(y));
+      const uint16x8_t u16 = vmovl_u8(u_pairs.val[half]);
+      const uint16x8_t v16 = vmovl_u8(v_pairs.val[half]);
+      for (int quarter = 0; quarter < 2; ++quarter) {
+        const dim_t i = x + 8 * half + 4 * quarter;
+        StoreYuvAsRgb(WidenQuarter(y16, quarter == 1),
+                      vsubq_f32(WidenQuarter(u16, quarter == 1), chroma_zero),
+                      vsubq_f32(WidenQuarter(v16, quarter == 1), chroma_zero),
+                      r + i, g + i, b + i);
+      }
+    }
+  }
+#endif
+  PortableYuvToRgb(luma, chroma, u_offset, x_begin + x, width - x, r + x,
+                   g + x, b + x);
+}
+
+void PortableGatherLerp(const float* src, const int32_t* x0,
+                        const int32_t* x1, const float* frac, dim_t width,
+                        float* dst) {
+  for (dim_t x = 0; x < width; ++x) {
+    const float left = src[x0[x]];
+    dst[x] = left + (src[x1[x]] - left) * frac[x];
+  }
+}
+
+void GatherLerp(const float* src, const int32_t* x0, const int32_t* x1,
+                const float* frac, dim_t width, float* dst) {
+  dim_t x = 0;
+  // Neither instruction set has a gather, the samples are loaded one by one
+  // and interpolated 4 at a time.
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  for (; x + 4 <= width; x += 4) {
+    const __m128 left = _mm_setr_ps(src[x0[x]], src[x0[x + 1]],
+                                    src[x0[x + 2]], src[x0[x + 3]]);
+    const __m128 right = _mm_setr_ps(src[x1[x]], src[x1[x + 1]],
+                                     src[x1[x + 2]], src[x1[x + 3]]);
+    _mm_storeu_ps(dst + x,
+                  _mm_add_ps(left, _mm_mul_ps(_mm_sub_ps(right, left),
+                                              _mm_loadu_ps(frac + x))));
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  for (; x + 4 <= width; x += 4) {
+    const float left_values[4] = {src[x0[x]], src[x0[x + 1]], src[x0[x + 2]],
+                                  src[x0[x + 3]]};
+    const float right_values[4] = {src[x1[x]], src[x1[x + 1]],
+                                   src[x1[x + 2]], src[x1[x + 3]]};
+    const float32x4_t left = vld1q_f32(left_values);
+    const float32x4_t right = vld1q_f32(right_values);
+    vst1q_f32(dst + x, vaddq_f32(left, vmulq_f32(vsubq_f32(right, left),
+                                                 vld1q_f32(frac + x))));
+  }
+#endif
+  PortableGatherLerp(src, x0 + x, x1 + x, frac + x, width - x, dst + x);
+}
+
+void PortableLerpRows(const float* top, const float* bottom, float frac,
+                      dim_t size, float* out) {
+  for (dim_t i = 0; i < size; ++i) {
+    out[i] = top[i] + (bottom[i] - top[i]) * frac;
+  }
+}
+
+void LerpRows(const float* top, const float* bottom, float frac, dim_t size,
+              float* out) {
+  dim_t i = 0;
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  const __m128 frac_v = _mm_set1_ps(frac);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 t = _mm_loadu_ps(top + i);
+    const __m128 d = _mm_sub_ps(_mm_loadu_ps(bottom + i), t);
+    _mm_storeu_ps(out + i, _mm_add_ps(t, _mm_mul_ps(d, frac_v)));
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  for (; i + 4 <= size; i += 4) {
+    const float32x4_t t = vld1q_f32(top + i);
+    const float32x4_t d = vsubq_f32(vld1q_f32(bottom + i), t);
+    vst1q_f32(out + i, vaddq_f32(t, vmulq_n_f32(d, frac)));
+  }
+#endif
+  PortableLerpRows(top + i, bottom + i, frac, size - i, out + i);
+}
+
+void PortableNormalizeRow(float mean, float inv_std, dim_t size, float* data) {
+  for (dim_t i = 0; i < size; ++i) {
+    data[i] = (data[i] - mean) * inv_std;
+  }
+}
+
+void NormalizeRow(float mean, float inv_std, dim_t size, float* data) {
+  dim_t i = 0;
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  const __m128 mean_v = _mm_set1_ps(mean);
+  const __m128 inv_std_v = _mm_set1_ps(inv_std);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 centered = _mm_sub_ps(_mm_loadu_ps(data + i), mean_v);
+    _mm_storeu_ps(data + i, _mm_mul_ps(centered, inv_std_v));
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  const float32x4_t mean_v = vdupq_n_f32(mean);
+  for (; i + 4 <= size; i += 4) {
+    const float32x4_t centered = vsubq_f32(vld1q_f32(data + i), mean_v);
+    vst1q_f32(data + i, vmulq_n_f32(centered, inv_std));
+  }
+#endif
+  PortableNormalizeRow(mean, inv_std, size - i, data + i);
+}
+
+void PortableInterleaveRgb(const float* r, const float* g, const float* b,
+                           dim_t width, float* out) {
+  for (dim_t x = 0; x < width; ++x) {
+    out[kNumChannels * x] = r[x];
+    out[kNumChannels * x + 1] = g[x];
+    out[kNumChannels * x + 2] = b[x];
+  }
+}
+
+void InterleaveRgb(const float* r, const float* g, const float* b, dim_t width,
+                   float* out) {
+  dim_t x = 0;
+#if defined(ML_ADJ_PREPROCESS_SSSE3)
+  for (; x + 4 <= width; x += 4) {
+    const __m128 r_v = _mm_loadu_ps(r + x);
+    const __m128 g_v = _mm_loadu_ps(g + x);
+    const __m128 b_v = _mm_loadu_ps(b + x);
+    const __m128 rg_low = _mm_unpacklo_ps(r_v, g_v);   // r0 g0 r1 g1
+    const __m128 rg_high = _mm_unpackhi_ps(r_v, g_v);  // r2 g2 r3 g3
+    // b0 b0 r1 r1, g1 g1 b1 b1, b2 b2 r3 r3 and g3 g3 b3 b3.
+    const __m128 b0_r1 = _mm_shuffle_ps(b_v, r_v, _MM_SHUFFLE(1, 1, 0, 0));
+    const __m128 g1_b1 = _mm_shuffle_ps(g_v, b_v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 b2_r3 = _mm_shuffle_ps(b_v, rg_high, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 g3_b3 = _mm_shuffle_ps(g_v, b_v, _MM_SHUFFLE(3, 3, 3, 3));
+    float* dst = out + kNumChannels * x;
+    _mm_storeu_ps(dst, _mm_shuffle_ps(rg_low, b0_r1, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(dst + 4,
+                  _mm_shuffle_ps(g1_b1, rg_high, _MM_SHUFFLE(1, 0, 2, 0)));
+    _mm_storeu_ps(dst + 8,
+                  _mm_shuffle_ps(b2_r3, g3_b3, _MM_SHUFFLE(2, 0, 2, 0)));
+  }
+#elif defined(ML_ADJ_PREPROCESS_NEON)
+  for (; x + 4 <= width; x += 4) {
+    float32x4x3_t pixels;
+    pixels.val[0] = vld1q_f32(r + x);
+    pixels.val[1] = vld1q_f32(g + x);
+    pixels.val[2] = vld1q_f32(b + x);
+    vst3q_f32(out + kNumChannels * x, pixels);
+  }
+#endif
+  PortableInterleaveRgb(r + x, g + x, b + x, width - x,
+                        out + kNumChannels * x);
+}
+
+}  // namespace preprocess
+}  // namespace ml_adj
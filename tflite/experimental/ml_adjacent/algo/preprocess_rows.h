@@ -0,0 +1,71 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_ROWS_H_
+#define TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_ROWS_H_
+
+#include <cstdint>
+
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+namespace ml_adj {
+namespace preprocess {
+
+// Row kernels of `Preprocessor`. Each `Portable` function is a plain loop,
+// and the function of the same name without the prefix uses SSSE3 or NEON
+// when the target has them, falling back to the portable one otherwise.
+
+// Deinterleaves `width` RGB pixels into three float planes.
+void PortableDeinterleaveRgb(const uint8_t* src, dim_t width, float* r,
+                             float* g, float* b);
+void DeinterleaveRgb(const uint8_t* src, dim_t width, float* r, float* g,
+                     float* b);
+
+// Converts the `width` pixels of a semi-planar YUV 4:2:0 row starting at
+// column `x_begin` to RGB planes, clamped to [0, 255]. `luma` and `chroma`
+// point to the start of the Y row and of the interleaved chroma row, where U
+// is at `u_offset` (0 or 1) in each pair.
+void PortableYuvToRgb(const uint8_t* luma, const uint8_t* chroma,
+                      dim_t u_offset, dim_t x_begin, dim_t width, float* r,
+                      float* g, float* b);
+void YuvToRgb(const uint8_t* luma, const uint8_t* chroma, dim_t u_offset,
+              dim_t x_begin, dim_t width, float* r, float* g, float* b);
+
+// Computes `dst[x] = src[x0[x]] + (src[x1[x]] - src[x0[x]]) * frac[x]`.
+void PortableGatherLerp(const float* src, const int32_t* x0,
+                        const int32_t* x1, const float* frac, dim_t width,
+                        float* dst);
+void GatherLerp(const float* src, const int32_t* x0, const int32_t* x1,
+                const float* frac, dim_t width, float* dst);
+
+// Computes `out = top + (bottom - top) * frac` element-wise.
+void PortableLerpRows(const float* top, const float* bottom, float frac,
+                      dim_t size, float* out);
+void LerpRows(const float* top, const float* bottom, float frac, dim_t size,
+              float* out);
+
+// Computes `data = (data - mean) * inv_std` element-wise.
+void PortableNormalizeRow(float mean, float inv_std, dim_t size, float* data);
+void NormalizeRow(float mean, float inv_std, dim_t size, float* data);
+
+// Interleaves three float planes of `width` values into RGB pixels.
+void PortableInterleaveRgb(const float* r, const float* g, const float* b,
+                           dim_t width, float* out);
+void InterleaveRgb(const float* r, const float* g, const float* b, dim_t width,
+                   float* out);
+
+}  // namespace preprocess
+}  // namespace ml_adj
+
+#endif  // TENSORFLOW_LITE_EXPERIMENTAL_ML_ADJACENT_ALGO_PREPROCESS_ROWS_H_
@@ -0,0 +1,165 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/preprocess_rows.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+namespace ml_adj {
+namespace preprocess {
+namespace {
+
+// Widths around the SIMD block sizes, so that every kernel runs both its
+// vector loop and its tail.
+constexpr dim_t kMaxWidth = 41;
+
+std::vector<uint8_t> RandomBytes(int size, std::mt19937* rng) {
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& v : data) v = dist(*rng);
+  return data;
+}
+
+std::vector<float> RandomFloats(int size, std::mt19937* rng) {
+  std::uniform_real_distribution<float> dist(-300.0f, 300.0f);
+  std::vector<float> data(size);
+  for (auto& v : data) v = dist(*rng);
+  return data;
+}
+
+void ExpectNear(const std::vector<float>& actual,
+                const std::vector<float>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], 1e-3f) << "index " << i;
+  }
+}
+
+TEST(PreprocessRowsTest, DeinterleaveRgbMatchesPortable) {
+  std::mt19937 rng(1);
+  for (dim_t width = 0; width <= kMaxWidth; ++width) {
+    SCOPED_TRACE(width);
+    const std::vector<uint8_t> src = RandomBytes(3 * width, &rng);
+    std::vector<float> planes(3 * width, -1.0f);
+    std::vector<float> expected(3 * width, -1.0f);
+    DeinterleaveRgb(src.data(), width, planes.data(), planes.data() + width,
+                    planes.data() + 2 * width);
+    PortableDeinterleaveRgb(src.data(), width, expected.data(),
+                            expected.data() + width,
+                            expected.data() + 2 * width);
+    EXPECT_EQ(planes, expected);
+  }
+}
+
+TEST(PreprocessRowsTest, YuvToRgbMatchesPortable) {
+  std::mt19937 rng(2);
+  constexpr dim_t kRowWidth = 2 * kMaxWidth;
+  const std::vector<uint8_t> luma = RandomBytes(kRowWidth, &rng);
+  const std::vector<uint8_t> chroma = RandomBytes(kRowWidth, &rng);
+  for (dim_t u_offset : {0, 1}) {
+    // Odd starting columns begin in the middle of a chroma pair.
+    for (dim_t x_begin : {0, 1, 2, 5}) {
+      for (dim_t width = 0; x_begin + width <= kRowWidth; width += 3) {
+        SCOPED_TRACE(testing::Message() << "u_offset " << u_offset
+                                        << " x_begin " << x_begin
+                                        << " width " << width);
+        std::vector<float> planes(3 * width, -1.0f);
+        std::vector<float> expected(3 * width, -1.0f);
+        YuvToRgb(luma.data(), chroma.data(), u_offset, x_begin, width,
+                 planes.data(), planes.data() + width,
+                 planes.data() + 2 * width);
+        PortableYuvToRgb(luma.data(), chroma.data(), u_offset, x_begin, width,
+                         expected.data(), expected.data() + width,
+                         expected.data() + 2 * width);
+        ExpectNear(planes, expected);
+      }
+    }
+  }
+}
+
+TEST(PreprocessRowsTest, GatherLerpMatchesPortable) {
+  std::mt19937 rng(3);
+  const std::vector<float> src = RandomFloats(kMaxWidth, &rng);
+  std::uniform_int_distribution<int32_t> index(0, kMaxWidth - 1);
+  std::uniform_real_distribution<float> fraction(0.0f, 1.0f);
+  for (dim_t width = 0; width <= kMaxWidth; ++width) {
+    SCOPED_TRACE(width);
+    std::vector<int32_t> x0(width);
+    std::vector<int32_t> x1(width);
+    std::vector<float> frac(width);
+    for (dim_t x = 0; x < width; ++x) {
+      x0[x] = index(rng);
+      x1[x] = index(rng);
+      frac[x] = fraction(rng);
+    }
+    std::vector<float> dst(width);
+    std::vector<float> expected(width);
+    GatherLerp(src.data(), x0.data(), x1.data(), frac.data(), width,
+               dst.data());
+    PortableGatherLerp(src.data(), x0.data(), x1.data(), frac.data(), width,
+                       expected.data());
+    ExpectNear(dst, expected);
+  }
+}
+
+TEST(PreprocessRowsTest, LerpRowsMatchesPortable) {
+  std::mt19937 rng(4);
+  for (dim_t size = 0; size <= kMaxWidth; ++size) {
+    SCOPED_TRACE(size);
+    const std::vector<float> top = RandomFloats(size, &rng);
+    const std::vector<float> bottom = RandomFloats(size, &rng);
+    std::vector<float> out(size);
+    std::vector<float> expected(size);
+    LerpRows(top.data(), bottom.data(), 0.375f, size, out.data());
+    PortableLerpRows(top.data(), bottom.data(), 0.375f, size,
+                     expected.data());
+    ExpectNear(out, expected);
+  }
+}
+
+TEST(PreprocessRowsTest, NormalizeRowMatchesPortable) {
+  std::mt19937 rng(5);
+  for (dim_t size = 0; size <= kMaxWidth; ++size) {
+    SCOPED_TRACE(size);
+    std::vector<float> data = RandomFloats(size, &rng);
+    std::vector<float> expected = data;
+    NormalizeRow(12.5f, 0.25f, size, data.data());
+    PortableNormalizeRow(12.5f, 0.25f, size, expected.data());
+    ExpectNear(data, expected);
+  }
+}
+
+TEST(PreprocessRowsTest, InterleaveRgbMatchesPortable) {
+  std::mt19937 rng(6);
+  for (dim_t width = 0; width <= kMaxWidth; ++width) {
+    SCOPED_TRACE(width);
+    const std::vector<float> planes = RandomFloats(3 * width, &rng);
+    std::vector<float> out(3 * width);
+    std::vector<float> expected(3 * width);
+    InterleaveRgb(planes.data(), planes.data() + width,
+                  planes.data() + 2 * width, width, out.data());
+    PortableInterleaveRgb(planes.data(), planes.data() + width,
+                          planes.data() + 2 * width, width, expected.data());
+    EXPECT_EQ(out, expected);
+  }
+}
+
+}  // namespace
+}  // namespace preprocess
+}  // namespace ml_adj
@@ -0,0 +1,228 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/experimental/ml_adjacent/algo/preprocess.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/experimental/ml_adjacent/algo/crop.h"
+#include "tflite/experimental/ml_adjacent/algo/resize.h"
+#include "tflite/experimental/ml_adjacent/data/owning_vector_ref.h"
+#include "tflite/experimental/ml_adjacent/lib.h"
+
+using ::ml_adj::algo::Algo;
+using ::ml_adj::data::OwningVectorRef;
+
+namespace ml_adj {
+namespace preprocess {
+namespace {
+
+template <typename T>
+void Fill(OwningVectorRef& ref, const dims_t& dims,
+          const std::vector<T>& data) {
+  ref.Resize(dims_t(dims));
+  ASSERT_EQ(ref.Bytes(), data.size() * sizeof(T));
+  std::memcpy(ref.Data(), data.data(), ref.Bytes());
+}
+
+// Holds the inputs of the fused op.
+struct PreprocessInputs {
+  PreprocessInputs(const dims_t& img_dims, const std::vector<uint8_t>& pixels,
+                   int32_t pixel_format, const std::vector<int32_t>& crop_box,
+                   const std::vector<int32_t>& new_size,
+                   const std::vector<float>& mean_std, int32_t out_layout) {
+    Fill(img, img_dims, pixels);
+    Fill(format, {1}, std::vector<int32_t>{pixel_format});
+    Fill(box, {4}, crop_box);
+    Fill(size, {2}, new_size);
+    Fill(norm, {6}, mean_std);
+    Fill(layout, {1}, std::vector<int32_t>{out_layout});
+  }
+
+  algo::InputPack Pack() {
+    return {&img, &format, &box, &size, &norm, &layout};
+  }
+
+  OwningVectorRef img{etype_t::u8};
+  OwningVectorRef format{etype_t::i32};
+  OwningVectorRef box{etype_t::i32};
+  OwningVectorRef size{etype_t::i32};
+  OwningVectorRef norm{etype_t::f32};
+  OwningVectorRef layout{etype_t::i32};
+};
+
+const std::vector<float> kIdentityNorm = {0, 0, 0, 1, 1, 1};
+
+std::vector<uint8_t> Pattern(int size) {
+  std::vector<uint8_t> data(size);
+  for (int i = 0; i < size; ++i) {
+    data[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+  }
+  return data;
+}
+
+TEST(PreprocessTest, RgbMatchesCropThenResize) {
+  const dims_t img_dims = {2, 6, 8, 3};
+  const std::vector<uint8_t> pixels = Pattern(2 * 6 * 8 * 3);
+  PreprocessInputs inputs(img_dims, pixels, kRgb, {1, 2, 4, 5}, {7, 3},
+                          kIdentityNorm, kNhwc);
+  OwningVectorRef output(etype_t::f32);
+  Impl_Preprocess()->process(inputs.Pack(), {&output});
+  ASSERT_EQ(output.Dims(), dims_t({2, 7, 3, 3}));
+
+  // Same image through the standalone algos.
+  OwningVectorRef img(etype_t::f32);
+  Fill(img, img_dims, std::vector<float>(pixels.begin(), pixels.end()));
+  std::vector<std::unique_ptr<OwningVectorRef>> box;
+  for (const int32_t v : {1, 2, 4, 5}) {
+    box.push_back(std::make_unique<OwningVectorRef>(etype_t::i32));
+    Fill(*box.back(), {1}, std::vector<int32_t>{v});
+  }
+  OwningVectorRef cropped(etype_t::f32);
+  crop::Impl_CropToBoundingBox()->process(
+      {&img, box[0].get(), box[1].get(), box[2].get(), box[3].get()},
+      {&cropped});
+  OwningVectorRef size(etype_t::i32);
+  Fill(size, {2}, std::vector<int32_t>{7, 3});
+  OwningVectorRef expected(etype_t::f32);
+  resize::Impl_Resize()->process({&cropped, &size}, {&expected});
+
+  ASSERT_EQ(output.NumElements(), expected.NumElements());
+  const float* out_data = reinterpret_cast<const float*>(output.Data());
+  const float* expected_data = reinterpret_cast<const float*>(expected.Data());
+  for (ind_t i = 0; i < output.NumElements(); ++i) {
+    EXPECT_NEAR(out_data[i], expected_data[i], 1e-3f) << "index " << i;
+  }
+}
+
+TEST(PreprocessTest, NormalizesToNchw) {
+  const std::vector<uint8_t> pixels = {0,  10, 20, 30,  40,  50,
+                                       60, 70, 80, 255, 128, 0};
+  PreprocessInputs inputs({1, 2, 2, 3}, pixels, kRgb, {0, 0, 2, 2}, {2, 2},
+                          {0, 10, 20, 1, 2, 4}, kNchw);
+  OwningVectorRef output(etype_t::f32);
+  Impl_Preprocess()->process(inputs.Pack(), {&output});
+  ASSERT_EQ(output.Dims(), dims_t({1, 3, 2, 2}));
+
+  const std::vector<float> expected = {0, 30, 60, 255,  // R
+                                       0, 15, 30, 59,   // G
+                                       0, 7.5, 15, -5};  // B
+  const float* out_data = reinterpret_cast<const float*>(output.Data());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_FLOAT_EQ(out_data[i], expected[i]) << "index " << i;
+  }
+}
+
+TEST(PreprocessTest, ConvertsNv21AndNv12) {
+  // 2x4 frame: a row of Y samples per image row, then one row of chroma
+  // samples for both.
+  const std::vector<uint8_t> nv21 = {100, 110, 120, 130,  //
+                                     140, 150, 160, 170,  //
+                                     200, 90, 128, 128};
+  const std::vector<uint8_t> nv12 = {100, 110, 120, 130,  //
+                                     140, 150, 160, 170,  //
+                                     90, 200, 128, 128};
+  PreprocessInputs nv21_inputs({1, 3, 4, 1}, nv21, kNv21, {0, 0, 2, 4},
+                               {2, 4}, kIdentityNorm, kNhwc);
+  PreprocessInputs nv12_inputs({1, 3, 4, 1}, nv12, kNv12, {0, 0, 2, 4},
+                               {2, 4}, kIdentityNorm, kNhwc);
+  OwningVectorRef nv21_output(etype_t::f32);
+  OwningVectorRef nv12_output(etype_t::f32);
+  Impl_Preprocess()->process(nv21_inputs.Pack(), {&nv21_output});
+  Impl_Preprocess()->process(nv12_inputs.Pack(), {&nv12_output});
+  ASSERT_EQ(nv21_output.Dims(), dims_t({1, 2, 4, 3}));
+  ASSERT_EQ(nv12_output.Dims(), dims_t({1, 2, 4, 3}));
+
+  const float* nv21_data = reinterpret_cast<const float*>(nv21_output.Data());
+  const float* nv12_data = reinterpret_cast<const float*>(nv12_output.Data());
+  for (ind_t i = 0; i < nv21_output.NumElements(); ++i) {
+    EXPECT_FLOAT_EQ(nv21_data[i], nv12_data[i]) << "index " << i;
+  }
+
+  // First pixel: Y = 100, U = 90, V = 200.
+  EXPECT_NEAR(nv21_data[0], 100 + 1.402f * 72, 1e-3f);
+  EXPECT_NEAR(nv21_data[1], 100 + 0.344136f * 38 - 0.714136f * 72, 1e-3f);
+  EXPECT_NEAR(nv21_data[2], 100 - 1.772f * 38, 1e-3f);
+  // Last pixel has neutral chroma and comes out gray.
+  EXPECT_FLOAT_EQ(nv21_data[21], 170);
+  EXPECT_FLOAT_EQ(nv21_data[22], 170);
+  EXPECT_FLOAT_EQ(nv21_data[23], 170);
+}
+
+TEST(PreprocessTest, SaturatesIntegerOutputs) {
+  const std::vector<uint8_t> pixels = {0, 127, 255};
+  PreprocessInputs inputs({1, 1, 1, 3}, pixels, kRgb, {0, 0, 1, 1}, {1, 1},
+                          {128, 128, 128, 1, 1, 1}, kNhwc);
+
+  OwningVectorRef int8_output(etype_t::i8);
+  Impl_Preprocess()->process(inputs.Pack(), {&int8_output});
+  const int8_t* int8_data = reinterpret_cast<const int8_t*>(int8_output.Data());
+  EXPECT_EQ(int8_data[0], -128);
+  EXPECT_EQ(int8_data[1], -1);
+  EXPECT_EQ(int8_data[2], 127);
+
+  OwningVectorRef uint8_output(etype_t::u8);
+  Impl_Preprocess()->process(inputs.Pack(), {&uint8_output});
+  const uint8_t* uint8_data =
+      reinterpret_cast<const uint8_t*>(uint8_output.Data());
+  EXPECT_EQ(uint8_data[0], 0);
+  EXPECT_EQ(uint8_data[1], 0);
+  EXPECT_EQ(uint8_data[2], 127);
+}
+
+TEST(PreprocessTest, TilesAreIndependent) {
+  const dims_t img_dims = {2, 30, 20, 3};
+  PreprocessInputs inputs(img_dims, Pattern(2 * 30 * 20 * 3), kRgb,
+                          {3, 1, 25, 17}, {40, 11}, kIdentityNorm, kNchw);
+  OwningVectorRef expected(etype_t::f32);
+  Impl_Preprocess()->process(inputs.Pack(), {&expected});
+
+  // Run the tiles backwards, as a thread pool might.
+  OwningVectorRef output(etype_t::f32);
+  const Preprocessor preprocessor(inputs.Pack(), {&output});
+  ASSERT_EQ(preprocessor.NumTiles(), 2 * 3);
+  for (dim_t tile = preprocessor.NumTiles(); tile > 0; --tile) {
+    preprocessor.RunTile(tile - 1);
+  }
+
+  ASSERT_EQ(output.Dims(), expected.Dims());
+  EXPECT_EQ(std::memcmp(output.Data(), expected.Data(), output.Bytes()), 0);
+}
+
+TEST(PreprocessDeathTest, RejectsBoxesOutsideTheImage) {
+  const std::vector<uint8_t> pixels = Pattern(4 * 4 * 3);
+  OwningVectorRef output(etype_t::f32);
+  // A negative offset used to wrap around and pass the bounds check.
+  PreprocessInputs negative({1, 4, 4, 3}, pixels, kRgb, {-1, 0, 2, 2}, {2, 2},
+                            kIdentityNorm, kNhwc);
+  EXPECT_DEATH(Impl_Preprocess()->process(negative.Pack(), {&output}), "");
+  PreprocessInputs overflow({1, 4, 4, 3}, pixels, kRgb,
+                            {0, std::numeric_limits<int32_t>::max(), 2, 2},
+                            {2, 2}, kIdentityNorm, kNhwc);
+  EXPECT_DEATH(Impl_Preprocess()->process(overflow.Pack(), {&output}), "");
+  PreprocessInputs negative_size({1, 4, 4, 3}, pixels, kRgb, {0, 0, 2, 2},
+                                 {-2, 2}, kIdentityNorm, kNhwc);
+  EXPECT_DEATH(Impl_Preprocess()->process(negative_size.Pack(), {&output}),
+               "");
+}
+
+}  // namespace
+}  // namespace preprocess
+}  // namespace ml_adj
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/experimental/ml_adjacent/tflite/extern_call.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -21,9 +22,12 @@ limitations under the License.
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/c/common.h"
 #include "tflite/experimental/ml_adjacent/algo/crop.h"
+#include "tflite/experimental/ml_adjacent/algo/preprocess.h"
 #include "tflite/experimental/ml_adjacent/algo/resize.h"
 #include "tflite/experimental/ml_adjacent/lib.h"
 #include "tflite/experimental/ml_adjacent/tflite/tfl_tensor_ref.h"
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/kernel_util.h"
 
 namespace tflite {
@@ -35,6 +39,7 @@ using ::ml_adj::algo::InputPack;
 using ::ml_adj::algo::OutputPack;
 using ::ml_adj::data::MutableTflTensorRef;
 using ::ml_adj::data::TflTensorRef;
+using ::ml_adj::preprocess::Preprocessor;
 
 // UniquePtr wrapper around vectors that hold the inputs/outputs to
 // library's `Algo`s.
@@ -52,9 +57,58 @@ struct PackDeleter {
 template <typename PackType>
 using UniquePack = std::unique_ptr<PackType, PackDeleter<PackType>>;
 
-constexpr uint8_t kNumFuncs = 2;
-static const Algo* const kReg[kNumFuncs] = {ml_adj::crop::Impl_CenterCrop(),
-                                            ml_adj::resize::Impl_Resize()};
+constexpr uint8_t kNumFuncs = 3;
+constexpr uint8_t kPreprocessFuncId = 2;
+static const Algo* const kReg[kNumFuncs] = {
+    ml_adj::crop::Impl_CenterCrop(), ml_adj::resize::Impl_Resize(),
+    ml_adj::preprocess::Impl_Preprocess()};
+
+// Computes a contiguous range of the fused preprocessing op's row tiles.
+struct PreprocessTask : cpu_backend_threadpool::Task {
+  PreprocessTask(const Preprocessor& preprocessor, int tile_start,
+                 int tile_end)
+      : preprocessor(preprocessor),
+        tile_start(tile_start),
+        tile_end(tile_end) {}
+
+  void Run() override {
+    for (int tile = tile_start; tile < tile_end; ++tile) {
+      preprocessor.RunTile(tile);
+    }
+  }
+
+  const Preprocessor& preprocessor;
+  const int tile_start;
+  const int tile_end;
+};
+
+// Runs the fused preprocessing op with its row tiles spread over the
+// interpreter's CPU backend threads instead of through `Algo::process`.
+void EvalPreprocess(TfLiteContext* context, const InputPack& inputs,
+                    const OutputPack& outputs) {
+  const Preprocessor preprocessor(inputs, outputs);
+  const int num_tiles = preprocessor.NumTiles();
+  CpuBackendContext* cpu_backend_context =
+      CpuBackendContext::GetFromContext(context);
+  const int thread_count =
+      std::min(num_tiles, cpu_backend_context->max_num_threads());
+  if (thread_count <= 1) {
+    PreprocessTask(preprocessor, 0, num_tiles).Run();
+    return;
+  }
+
+  std::vector<PreprocessTask> tasks;
+  tasks.reserve(thread_count);
+  int tile_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    const int tile_end =
+        tile_start + (num_tiles - tile_start) / (thread_count - i);
+    tasks.emplace_back(preprocessor, tile_start, tile_end);
+    tile_start = tile_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
 
 TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   for (int i = 0; i < NumOutputs(node); ++i) {
@@ -89,6 +143,11 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE(context,
                  options->func_id >= 0 && options->func_id < kNumFuncs);
 
+  if (options->func_id == kPreprocessFuncId) {
+    EvalPreprocess(context, *lib_inputs, *lib_outputs);
+    return kTfLiteOk;
+  }
+
   const Algo* const algo = kReg[options->func_id];
 
   algo->process(*lib_inputs, *lib_outputs);
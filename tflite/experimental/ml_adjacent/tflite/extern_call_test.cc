@@ -86,5 +86,26 @@ TEST(ExternCallTest, ResizeTest) {
   ASSERT_THAT(model.Output(0), DimsAre({1, 3, 3, 1}));
 }
 
+TEST(ExternCallTest, PreprocessTest) {
+  std::vector<TensorData> inputs = {{TensorType_UINT8, {2, 48, 20, 3}},
+                                    {TensorType_INT32, {}},
+                                    {TensorType_UINT32, {4}},
+                                    {TensorType_UINT32, {2}},
+                                    {TensorType_FLOAT32, {6}},
+                                    {TensorType_INT32, {}}};
+  std::vector<TensorData> output = {{TensorType_INT8, {}}};
+
+  ExternCallModel model(inputs, output, 2);
+  model.PopulateTensor<int32_t>(1, {0});
+  model.PopulateTensor<uint32_t>(2, {4, 2, 40, 16});
+  model.PopulateTensor<uint32_t>(3, {36, 8});
+  model.PopulateTensor<float>(4, {128, 128, 128, 1, 1, 1});
+  model.PopulateTensor<int32_t>(5, {1});
+
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  ASSERT_NE(model.Output(0), nullptr);
+  ASSERT_THAT(model.Output(0), DimsAre({2, 3, 36, 8}));
+}
+
 }  // namespace
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/experimental/resource/cache_buffer.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
@@ -35,6 +36,8 @@ TfLiteStatus CacheBuffer::Initialize(const TfLiteIntArray& shape) {
 
   num_entries_.reset(new size_t[shape.data[1]]);
   memset(num_entries_.get(), 0, sizeof(size_t) * shape.data[1]);
+  first_slot_index_.reset(new size_t[shape.data[1]]);
+  memset(first_slot_index_.get(), 0, sizeof(size_t) * shape.data[1]);
   is_initialized_ = true;
   return kTfLiteOk;
 }
@@ -52,5 +55,33 @@ void CacheBuffer::SetNumEntries(int idx, size_t count) {
   num_entries_[idx] = count;
 }
 
+size_t CacheBuffer::GetFirstSlotIndex(int idx) const {
+  return first_slot_index_[idx];
+}
+
+void CacheBuffer::SetFirstSlotIndex(int idx, size_t index) {
+  first_slot_index_[idx] = index;
+}
+
+size_t CacheBuffer::GetMaxNumEntries() const { return dims_->data[2]; }
+
+TfLiteStatus CacheBuffer::Truncate(size_t num_positions) {
+  if (num_positions == 0) {
+    for (int i = 0; i < dims_->data[1]; ++i) {
+      num_entries_[i] = 0;
+      first_slot_index_[i] = 0;
+    }
+    return kTfLiteOk;
+  }
+  for (int i = 0; i < dims_->data[1]; ++i) {
+    if (num_positions < first_slot_index_[i]) return kTfLiteError;
+  }
+  for (int i = 0; i < dims_->data[1]; ++i) {
+    num_entries_[i] =
+        std::min(num_entries_[i], num_positions - first_slot_index_[i]);
+  }
+  return kTfLiteOk;
+}
+
 }  // namespace resource
 }  // namespace tflite
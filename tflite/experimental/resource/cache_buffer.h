@@ -43,10 +43,25 @@ class CacheBuffer : public ResourceVariable {
   float *GetBuffer();
   size_t GetSize();
   void SetNumEntries(int idx, size_t count);
+  // The position of the first entry of a layer. It moves forward when the
+  // oldest entries are evicted to make room for new ones.
+  size_t GetFirstSlotIndex(int idx) const;
+  void SetFirstSlotIndex(int idx, size_t index);
+  // The number of entries a layer holds.
+  size_t GetMaxNumEntries() const;
+  // Drops the entries of the positions from `num_positions` on in every
+  // layer, e.g. those of the tokens rejected by speculative decoding. The
+  // dropped entries are not cleared, they are overwritten by the next writes
+  // to their positions. Truncating to 0 also moves the first slot back to
+  // position 0. Fails, leaving the buffer unchanged, if a layer already
+  // evicted positions at or after `num_positions`.
+  TfLiteStatus Truncate(size_t num_positions);
 
  private:
   // The number of entries currently used in the buffer;
   std::unique_ptr<size_t[]> num_entries_;
+  // The position of the first entry of each layer.
+  std::unique_ptr<size_t[]> first_slot_index_;
   // The float buffer for storage. Has shape:
   // <batch, num layers, seq length, num heads, head dim>
   std::unique_ptr<float[]> buffer_;
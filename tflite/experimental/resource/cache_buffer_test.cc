@@ -40,5 +40,38 @@ TEST(CacheBufferTest, Initialize) {
   TfLiteIntArrayFree(shape);
 }
 
+TEST(CacheBufferTest, Truncate) {
+  TfLiteIntArray* shape = TfLiteIntArrayCreate(4);
+  shape->data[0] = 1;
+  shape->data[1] = 3;
+  shape->data[2] = 5;
+  shape->data[3] = 7;
+
+  CacheBuffer cache_buffer;
+  cache_buffer.Initialize(*shape);
+  cache_buffer.SetNumEntries(0, 4);
+  cache_buffer.SetNumEntries(1, 2);
+  EXPECT_EQ(cache_buffer.Truncate(3), kTfLiteOk);
+  EXPECT_EQ(cache_buffer.GetNumEntries(0), 3);
+  EXPECT_EQ(cache_buffer.GetNumEntries(1), 2);
+  EXPECT_EQ(cache_buffer.GetNumEntries(2), 0);
+
+  // Layer 2 evicted positions 0 to 3, it now holds positions 4 to 8.
+  cache_buffer.SetFirstSlotIndex(2, 4);
+  cache_buffer.SetNumEntries(2, 5);
+  EXPECT_EQ(cache_buffer.Truncate(6), kTfLiteOk);
+  EXPECT_EQ(cache_buffer.GetNumEntries(2), 2);
+  EXPECT_EQ(cache_buffer.Truncate(3), kTfLiteError);
+  EXPECT_EQ(cache_buffer.GetNumEntries(0), 3);
+  EXPECT_EQ(cache_buffer.GetNumEntries(2), 2);
+
+  EXPECT_EQ(cache_buffer.Truncate(0), kTfLiteOk);
+  EXPECT_EQ(cache_buffer.GetNumEntries(0), 0);
+  EXPECT_EQ(cache_buffer.GetNumEntries(1), 0);
+  EXPECT_EQ(cache_buffer.GetNumEntries(2), 0);
+  EXPECT_EQ(cache_buffer.GetFirstSlotIndex(2), 0);
+  TfLiteIntArrayFree(shape);
+}
+
 }  // namespace resource
 }  // namespace tflite
@@ -92,9 +92,17 @@ class ExternalCpuBackendContext : public TfLiteExternalContext {
     return internal_backend_context_.get();
   }
 
+  // Sets the NUMA node the worker threads of the internal backend context are
+  // pinned to, or -1 to let them run wherever the threads invoking the
+  // interpreters may run. The invoking threads keep their own affinity.
+  void set_worker_numa_node(int numa_node) { worker_numa_node_ = numa_node; }
+
+  int worker_numa_node() const { return worker_numa_node_; }
+
  private:
   // Note the actual internal backend context object is lazily initialized.
   std::unique_ptr<TfLiteInternalBackendContext> internal_backend_context_;
+  int worker_numa_node_ = -1;
 
   ExternalCpuBackendContext(const ExternalCpuBackendContext&) = delete;
   ExternalCpuBackendContext& operator=(const ExternalCpuBackendContext&) =
@@ -19,6 +19,9 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_INTERPRETER_OPTIONS_H_
 #define TENSORFLOW_LITE_INTERPRETER_OPTIONS_H_
 
+#include "tflite/core/c/c_api_types.h"
+#include "tflite/memory_placement.h"
+
 namespace tflite {
 
 /// Options class for `Interpreter`.
@@ -148,6 +151,113 @@ class InterpreterOptions {
     return experimental_compress_quantization_zero_points_;
   }
 
+  // If set to `true`, control flow ops (IF, WHILE, STABLEHLO_CASE and
+  // STABLEHLO_COMPOSITE) keep the memory of the subgraphs they invoke
+  // allocated between invocations instead of releasing it after each one.
+  // While the input shapes of such a subgraph don't change, invoking it again
+  // then requires neither memory planning nor allocation, at the cost of
+  // holding the arenas of all invoked subgraphs at the same time.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetKeepControlFlowSubgraphsResident(bool value) {
+    experimental_keep_control_flow_subgraphs_resident_ = value;
+  }
+
+  // If `true`, control flow ops keep the memory of the subgraphs they invoke
+  // allocated between invocations.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetKeepControlFlowSubgraphsResident() const {
+    return experimental_keep_control_flow_subgraphs_resident_;
+  }
+
+  // Sets the type float32 intermediate activations are stored in. If set to
+  // `kTfLiteFloat16` or `kTfLiteBFloat16`, activations that are only read and
+  // written by builtin CPU kernels converting to and from float32 on the fly
+  // (ADD, MUL, SUB and the layout and activation ops between them) are stored
+  // in that type, which halves the memory traffic for them at the cost of
+  // precision. Subgraph inputs, outputs and variables keep their declared
+  // type. Any other value keeps all activations in float32.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetActivationStorageType(TfLiteType type) {
+    experimental_activation_storage_type_ =
+        type == kTfLiteFloat16 || type == kTfLiteBFloat16 ? type
+                                                          : kTfLiteFloat32;
+  }
+
+  // Returns the type eligible float32 activations are stored in.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  TfLiteType GetActivationStorageType() const {
+    return experimental_activation_storage_type_;
+  }
+
+  // If `value` is positive, activations are only stored in reduced precision
+  // once a check accepted it: the subgraph is run with float32 and reduced
+  // precision activations, and reduced precision storage is kept if the float
+  // outputs of the two runs differ by at most `value` relative to the largest
+  // float32 output magnitude. The outcome, together with the arena sizes and
+  // latencies of both runs, is available from
+  // `Subgraph::activation_storage_report()`.
+  //
+  // Until then tensors are allocated with float32 storage. The check runs in
+  // the first `AllocateTensors()` call made while the tensors are already
+  // allocated, on the data the inputs hold at that point, so fill them with
+  // representative data and call `AllocateTensors()` again. As for any call
+  // to `AllocateTensors()`, tensor data pointers must be looked up again
+  // after it. `Invoke()` never re-allocates tensors for the check. As the
+  // check runs the subgraph twice, it shouldn't be enabled for models
+  // updating resource variables.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetActivationStorageTolerance(float value) {
+    experimental_activation_storage_tolerance_ = value;
+  }
+
+  // Returns the tolerance of the reduced precision activation storage check,
+  // or a non-positive value if the check is disabled.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  float GetActivationStorageTolerance() const {
+    return experimental_activation_storage_tolerance_;
+  }
+
+  // Sets where the tensor arenas of the interpreter's subgraphs are placed in
+  // memory, e.g. backed by huge pages on a given NUMA node. Only arenas of at
+  // least `placement.min_bytes` are placed, smaller ones stay on the heap.
+  // To also run the kernels next to that memory, see `SetPinWorkerThreads`.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetMemoryPlacement(const MemoryPlacement& placement) {
+    experimental_memory_placement_ = placement;
+  }
+
+  // Returns where the tensor arenas are placed in memory.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  const MemoryPlacement& GetMemoryPlacement() const {
+    return experimental_memory_placement_;
+  }
+
+  // If set to `true` and the memory placement names a NUMA node, the worker
+  // threads of the interpreter's CPU backend context are pinned to the CPUs
+  // of that node. The threads invoking the interpreter keep their affinity,
+  // pin them with `PinCurrentThreadToNumaNode` to run the whole invocation
+  // on the node. Has no effect on a context set with `SetExternalContext`,
+  // see `ExternalCpuBackendContext::set_worker_numa_node` instead.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetPinWorkerThreads(bool value) {
+    experimental_pin_worker_threads_ = value;
+  }
+
+  // Returns whether the worker threads are pinned to the NUMA node of the
+  // memory placement.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetPinWorkerThreads() const { return experimental_pin_worker_threads_; }
+
  private:
   bool experimental_preserve_all_tensors_ = false;
   bool experimental_ensure_dynamic_tensors_are_released_ = false;
@@ -157,6 +267,11 @@ class InterpreterOptions {
   bool experimental_shlo_composite_inlining_ = false;
   bool experimental_use_signature_tensor_names_ = false;
   bool experimental_compress_quantization_zero_points_ = false;
+  bool experimental_keep_control_flow_subgraphs_resident_ = false;
+  TfLiteType experimental_activation_storage_type_ = kTfLiteFloat32;
+  float experimental_activation_storage_tolerance_ = 0.0f;
+  MemoryPlacement experimental_memory_placement_;
+  bool experimental_pin_worker_threads_ = false;
 };
 
 }  // namespace tflite
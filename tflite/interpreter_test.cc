@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdlib.h>
 #include <string.h>
 
+#include <chrono>  // NOLINT(build/c++11)
 #include <map>
 #include <memory>
 #include <string>
@@ -1647,6 +1648,16 @@ TEST_F(CancelTest, CancelOnlyAffectsOngoingInvoke) {
   EXPECT_EQ(kTfLiteOk, interpreter_->Invoke());
 }
 
+TEST_F(CancelTest, CancelAfterLastNodeIsNotReported) {
+  MakeOkNode(0, 1);
+  MakeCancelNode(1, 2);
+  interpreter_->EnableCancellation();
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  // Every node ran to completion, so there is nothing to report.
+  EXPECT_EQ(kTfLiteOk, interpreter_->Invoke());
+  ASSERT_EQ(kTfLiteOk, GetCancellationData().cancellation_status);
+}
+
 TEST_F(CancelTest, CancellationAffectsOtherSubgraphs) {
   MakeCancelAndCallNode(0, 1);
   MakeOkNode(1, 2);
@@ -1664,6 +1675,40 @@ TEST_F(CancelTest, CancellationAffectsOtherSubgraphs) {
   EXPECT_EQ(kTfLiteOk, interpreter_->Invoke());
 }
 
+TEST_F(CancelTest, ExpiredDeadlineStopsInvoke) {
+  MakeOkNode(0, 1);
+  MakeOkNode(1, 2);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  // Deadlines don't need EnableCancellation().
+  interpreter_->SetInvocationDeadline(std::chrono::steady_clock::now() -
+                                      std::chrono::seconds(1));
+  EXPECT_EQ(kTfLiteCancelled, interpreter_->Invoke());
+
+  // The interpreter stays usable without re-allocating.
+  interpreter_->ClearInvocationDeadline();
+  EXPECT_EQ(kTfLiteOk, interpreter_->Invoke());
+}
+
+TEST_F(CancelTest, FutureDeadlineDoesNotStopInvoke) {
+  MakeOkNode(0, 1);
+  MakeOkNode(1, 2);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  interpreter_->SetInvocationDeadline(std::chrono::steady_clock::now() +
+                                      std::chrono::hours(1));
+  EXPECT_EQ(kTfLiteOk, interpreter_->Invoke());
+}
+
+TEST_F(CancelTest, ExpiredDeadlineAffectsOtherSubgraphs) {
+  MakeOkNode(0, 1);
+  MakeOkNode(1, 2);
+  SetUpCalleeSubgraph();
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->subgraph(1)->AllocateTensors(), kTfLiteOk);
+  interpreter_->SetInvocationDeadline(std::chrono::steady_clock::now() -
+                                      std::chrono::seconds(1));
+  EXPECT_EQ(kTfLiteCancelled, interpreter_->subgraph(1)->Invoke());
+}
+
 // Test fixture to test SetCancellationFunction within the Interpreter.
 class SetCancellationFunctionTest : public InterpreterTest {
  public:
@@ -0,0 +1,202 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_INVOCATION_INTERRUPT_H_
+#define TENSORFLOW_LITE_INVOCATION_INTERRUPT_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <limits>
+
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+
+// The 'kTfLiteInterruptContext'-typed external context through which an
+// in-flight invocation is asked to stop early, either because the application
+// cancelled it or because its deadline has passed.
+//
+// The interpreter owns one instance shared by all of its subgraphs. The
+// subgraph checks it between nodes, and kernels that may run for a long time
+// (control flow loops, attention, large GEMMs) check it between iterations or
+// tiles with:
+//
+//   if (InvocationInterrupt::ShouldStop(context)) return kTfLiteCancelled;
+//
+// Every way of stopping sets a bit in one atomic word, so checking is a single
+// relaxed load while nothing can stop the invocation. A read of the steady
+// clock is added while a deadline is set, and a call to the legacy
+// cancellation function while one is registered. Kernels must only stop at
+// points where returning leaves their persistent state (allocations, scratch
+// tensors, variables) valid, so that the interpreter can be invoked again
+// without re-allocating.
+class InvocationInterrupt : public TfLiteExternalContext {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Why `ShouldStop` returned true.
+  enum class Reason {
+    kNone,
+    // `Cancel` was called.
+    kCancelled,
+    // The deadline passed.
+    kDeadlineExceeded,
+    // The function set with `SetCancellationFunction` returned true.
+    kCancellationFunction,
+  };
+
+  InvocationInterrupt() {
+    type = kTfLiteInterruptContext;
+    Refresh = nullptr;
+  }
+
+  // Marks that invocations may be cancelled with `Cancel`.
+  void EnableCancellation() {
+    cancellable_.store(true, std::memory_order_relaxed);
+  }
+
+  // Asks the in-flight invocation, if any, to stop. Sticky until
+  // `ResetCancellation` is called.
+  void Cancel() { state_.fetch_or(kCancelledBit, std::memory_order_relaxed); }
+
+  void ResetCancellation() {
+    state_.fetch_and(~kCancelledBit, std::memory_order_relaxed);
+  }
+
+  bool IsCancelled() const {
+    return state_.load(std::memory_order_relaxed) & kCancelledBit;
+  }
+
+  // Sets the absolute time past which invocations should stop.
+  void SetDeadline(Clock::time_point deadline) {
+    deadline_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           deadline.time_since_epoch())
+                           .count(),
+                       std::memory_order_relaxed);
+    state_.fetch_or(kDeadlineBit, std::memory_order_relaxed);
+  }
+
+  void ClearDeadline() {
+    state_.fetch_and(~kDeadlineBit, std::memory_order_relaxed);
+  }
+
+  bool HasDeadline() const {
+    return state_.load(std::memory_order_relaxed) & kDeadlineBit;
+  }
+
+  bool DeadlineExceeded() const {
+    return HasDeadline() && DeadlineExceededImpl();
+  }
+
+  // Polls `check_cancelled_func(data)` as well, see
+  // `Interpreter::SetCancellationFunction`. Passing a null function stops
+  // polling. Must not be called while an invocation is in flight.
+  void SetCancellationFunction(void* data,
+                               bool (*check_cancelled_func)(void*)) {
+    cancellation_data_ = data;
+    check_cancelled_func_ = check_cancelled_func;
+    if (check_cancelled_func_ != nullptr) {
+      state_.fetch_or(kCancellationFunctionBit, std::memory_order_relaxed);
+    } else {
+      state_.fetch_and(~kCancellationFunctionBit, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns why the in-flight invocation should stop, or `Reason::kNone`.
+  Reason StopReason() const {
+    const uint32_t state = state_.load(std::memory_order_relaxed);
+    if (state == 0) return Reason::kNone;
+    if (state & kCancelledBit) return Reason::kCancelled;
+    if ((state & kDeadlineBit) && DeadlineExceededImpl()) {
+      return Reason::kDeadlineExceeded;
+    }
+    if ((state & kCancellationFunctionBit) &&
+        check_cancelled_func_(cancellation_data_)) {
+      return Reason::kCancellationFunction;
+    }
+    return Reason::kNone;
+  }
+
+  // Returns true if the in-flight invocation should stop.
+  bool ShouldStop() const { return StopReason() != Reason::kNone; }
+
+  // Returns true if invocations may be asked to stop at all. Kernels that have
+  // to restructure their work to check `ShouldStop` (e.g. by splitting a GEMM
+  // into chunks) should only do so when this is true.
+  bool Interruptible() const {
+    return cancellable_.load(std::memory_order_relaxed) ||
+           (state_.load(std::memory_order_relaxed) &
+            (kDeadlineBit | kCancellationFunctionBit));
+  }
+
+  // Kernels that stop part way through without failing (e.g. a GEMM split into
+  // chunks) call this so that the subgraph reports the invocation as stopped
+  // even when no node is left to check before.
+  void MarkIncomplete() { incomplete_.store(true, std::memory_order_relaxed); }
+
+  bool Incomplete() const {
+    return incomplete_.load(std::memory_order_relaxed);
+  }
+
+  void ResetIncomplete() {
+    incomplete_.store(false, std::memory_order_relaxed);
+  }
+
+  // Returns the interrupt registered in `context`, or nullptr if there is none
+  // (e.g. the subgraph isn't owned by an interpreter).
+  static InvocationInterrupt* Get(TfLiteContext* context) {
+    if (context == nullptr || context->GetExternalContext == nullptr) {
+      return nullptr;
+    }
+    return static_cast<InvocationInterrupt*>(
+        context->GetExternalContext(context, kTfLiteInterruptContext));
+  }
+
+  // Convenience for kernels. Looks the interrupt up on every call, so kernels
+  // checking in a tight loop should hoist `Get` out of it.
+  static bool ShouldStop(TfLiteContext* context) {
+    const InvocationInterrupt* interrupt = Get(context);
+    return interrupt != nullptr && interrupt->ShouldStop();
+  }
+
+ private:
+  static constexpr uint32_t kCancelledBit = 1u << 0;
+  static constexpr uint32_t kDeadlineBit = 1u << 1;
+  static constexpr uint32_t kCancellationFunctionBit = 1u << 2;
+
+  bool DeadlineExceededImpl() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+               .count() >= deadline_ns_.load(std::memory_order_relaxed);
+  }
+
+  // The reasons the in-flight invocation may have to stop, as a combination of
+  // the bits above. Zero while nothing can stop it.
+  std::atomic<uint32_t> state_{0};
+  std::atomic<bool> cancellable_{false};
+  std::atomic<bool> incomplete_{false};
+  // Deadline in nanoseconds since the steady clock's epoch, only read while
+  // `kDeadlineBit` is set.
+  std::atomic<int64_t> deadline_ns_{std::numeric_limits<int64_t>::max()};
+  void* cancellation_data_ = nullptr;
+  bool (*check_cancelled_func_)(void*) = nullptr;
+
+  InvocationInterrupt(const InvocationInterrupt&) = delete;
+  InvocationInterrupt& operator=(const InvocationInterrupt&) = delete;
+};
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_INVOCATION_INTERRUPT_H_
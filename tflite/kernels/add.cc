@@ -36,6 +36,7 @@ limitations under the License.
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/kernels/op_macros.h"
+#include "tflite/kernels/reduced_precision_storage.h"
 
 namespace tflite {
 namespace ops {
@@ -74,6 +75,9 @@ struct OpData {
   // parameter scale is power of two.
   // It is used in 16-bit -> 16-bit quantization.
   bool pot_scale_int16;
+
+  // Float32 copies of reduced precision operands of a broadcast.
+  int float_copies_index = kFloatCopiesNotAllocated;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -104,8 +108,15 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_OK(context,
                     GetOutputSafe(context, node, kOutputTensor, &output));
 
-  TF_LITE_ENSURE_TYPES_EQ(context, input1->type, input2->type);
-  output->type = input2->type;
+  if (HasReducedPrecisionStorage({input1, input2, output})) {
+    // Float32 activations, some stored in reduced precision.
+    TF_LITE_ENSURE(context, IsFloatStorageType(input1->type) &&
+                                IsFloatStorageType(input2->type) &&
+                                IsFloatStorageType(output->type));
+  } else {
+    TF_LITE_ENSURE_TYPES_EQ(context, input1->type, input2->type);
+    output->type = input2->type;
+  }
 
   const bool requires_broadcast = !HaveSameShapes(input1, input2);
 
@@ -231,6 +242,14 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
         &data->output_activation_max));
   }
 
+  if (requires_broadcast &&
+      HasReducedPrecisionStorage({input1, input2, output})) {
+    TF_LITE_ENSURE_OK(
+        context, PrepareFloatCopies(context, node, input1, input2, output,
+                                    output_size, /*allocate_now=*/false,
+                                    &data->float_copies_index));
+  }
+
   return context->ResizeTensor(context, output, output_size);
 }
 
@@ -307,6 +326,35 @@ void EvalAdd(TfLiteContext* context, TfLiteNode* node, TfLiteAddParams* params,
 #undef TF_LITE_ADD
 }
 
+TfLiteStatus EvalAddReducedPrecision(TfLiteContext* context, TfLiteNode* node,
+                                     const TfLiteAddParams* params,
+                                     const TfLiteTensor* input1,
+                                     const TfLiteTensor* input2,
+                                     TfLiteTensor* output) {
+  float output_activation_min, output_activation_max;
+  CalculateActivationRange(params->activation, &output_activation_min,
+                           &output_activation_max);
+  if (HaveSameShapes(input1, input2)) {
+    ElementwiseWithFloatStorage(input1, input2, output_activation_min,
+                                output_activation_max, output,
+                                [](float a, float b) { return a + b; });
+    return kTfLiteOk;
+  }
+  TfLiteTensor* scratch;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, 0, &scratch));
+  tflite::ArithmeticParams op_params;
+  SetActivationParams(output_activation_min, output_activation_max,
+                      &op_params);
+  WithFloatCopies(input1, input2, output, scratch,
+                  [&](const float* in1, const float* in2, float* out) {
+                    reference_ops::BroadcastAdd6DSlow(
+                        op_params, GetTensorShape(input1), in1,
+                        GetTensorShape(input2), in2, GetTensorShape(output),
+                        out);
+                  });
+  return kTfLiteOk;
+}
+
 template <KernelType kernel_type>
 TfLiteStatus EvalAddQuantized(TfLiteContext* context, TfLiteNode* node,
                               TfLiteAddParams* params, const OpData* data,
@@ -417,10 +465,13 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_OK(context,
                     GetOutputSafe(context, node, kOutputTensor, &output));
 
-  if (output->type == kTfLiteFloat32 || output->type == kTfLiteInt32 ||
-      output->type == kTfLiteInt64 ||
-      (output->quantization.type == kTfLiteNoQuantization &&
-       output->type == kTfLiteInt16)) {
+  if (HasReducedPrecisionStorage({input1, input2, output})) {
+    TF_LITE_ENSURE_OK(context, EvalAddReducedPrecision(context, node, params,
+                                                       input1, input2, output));
+  } else if (output->type == kTfLiteFloat32 || output->type == kTfLiteInt32 ||
+             output->type == kTfLiteInt64 ||
+             (output->quantization.type == kTfLiteNoQuantization &&
+              output->type == kTfLiteInt16)) {
     EvalAdd<kernel_type>(context, node, params, data, input1, input2, output);
   } else if (output->type == kTfLiteUInt8 || output->type == kTfLiteInt8 ||
              output->type == kTfLiteInt16) {
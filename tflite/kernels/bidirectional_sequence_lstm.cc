@@ -157,6 +157,9 @@ struct OpData {
   int scratch_tensor_index;
   bool compute_fw_row_sums = false;
   bool compute_bw_row_sums = false;
+  // Buffers of the fused float evaluation.
+  lstm_eval::FusedFloatLstmBuffers fw_fused_float_buffers;
+  lstm_eval::FusedFloatLstmBuffers bw_fused_float_buffers;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -1175,6 +1178,72 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   switch (fw_input_to_output_weights->type) {
     case kTfLiteFloat32: {
+      lstm_eval::FloatLstmDirection fw;
+      fw.input = input;
+      fw.aux_input = real_aux_input;
+      fw.input_to_input_weights = fw_input_to_input_weights;
+      fw.input_to_forget_weights = fw_input_to_forget_weights;
+      fw.input_to_cell_weights = fw_input_to_cell_weights;
+      fw.input_to_output_weights = fw_input_to_output_weights;
+      fw.aux_input_to_input_weights = fw_aux_input_to_input_weights;
+      fw.aux_input_to_forget_weights = fw_aux_input_to_forget_weights;
+      fw.aux_input_to_cell_weights = fw_aux_input_to_cell_weights;
+      fw.aux_input_to_output_weights = fw_aux_input_to_output_weights;
+      fw.recurrent_to_input_weights = fw_recurrent_to_input_weights;
+      fw.recurrent_to_forget_weights = fw_recurrent_to_forget_weights;
+      fw.recurrent_to_cell_weights = fw_recurrent_to_cell_weights;
+      fw.recurrent_to_output_weights = fw_recurrent_to_output_weights;
+      fw.cell_to_input_weights = fw_cell_to_input_weights;
+      fw.cell_to_forget_weights = fw_cell_to_forget_weights;
+      fw.cell_to_output_weights = fw_cell_to_output_weights;
+      fw.input_gate_bias = fw_input_gate_bias;
+      fw.forget_gate_bias = fw_forget_gate_bias;
+      fw.cell_gate_bias = fw_cell_gate_bias;
+      fw.output_gate_bias = fw_output_gate_bias;
+      fw.projection_weights = fw_projection_weights;
+      fw.projection_bias = fw_projection_bias;
+      fw.output_state = fw_activation_state;
+      fw.cell_state = fw_cell_state;
+      fw.output = fw_output;
+
+      lstm_eval::FloatLstmDirection bw;
+      bw.input = bw_input;
+      bw.aux_input = real_aux_input;
+      bw.input_to_input_weights = bw_input_to_input_weights;
+      bw.input_to_forget_weights = bw_input_to_forget_weights;
+      bw.input_to_cell_weights = bw_input_to_cell_weights;
+      bw.input_to_output_weights = bw_input_to_output_weights;
+      bw.aux_input_to_input_weights = bw_aux_input_to_input_weights;
+      bw.aux_input_to_forget_weights = bw_aux_input_to_forget_weights;
+      bw.aux_input_to_cell_weights = bw_aux_input_to_cell_weights;
+      bw.aux_input_to_output_weights = bw_aux_input_to_output_weights;
+      bw.recurrent_to_input_weights = bw_recurrent_to_input_weights;
+      bw.recurrent_to_forget_weights = bw_recurrent_to_forget_weights;
+      bw.recurrent_to_cell_weights = bw_recurrent_to_cell_weights;
+      bw.recurrent_to_output_weights = bw_recurrent_to_output_weights;
+      bw.cell_to_input_weights = bw_cell_to_input_weights;
+      bw.cell_to_forget_weights = bw_cell_to_forget_weights;
+      bw.cell_to_output_weights = bw_cell_to_output_weights;
+      bw.input_gate_bias = bw_input_gate_bias;
+      bw.forget_gate_bias = bw_forget_gate_bias;
+      bw.cell_gate_bias = bw_cell_gate_bias;
+      bw.output_gate_bias = bw_output_gate_bias;
+      bw.projection_weights = bw_projection_weights;
+      bw.projection_bias = bw_projection_bias;
+      bw.output_state = bw_activation_state;
+      bw.cell_state = bw_cell_state;
+      bw.output = actual_bw_output;
+      bw.forward_sequence = false;
+      bw.output_offset = bw_output_offset;
+
+      if (lstm_eval::CanUseFusedEvalFloat(fw) &&
+          lstm_eval::CanUseFusedEvalFloat(bw)) {
+        return lstm_eval::EvalBidirectionalFloatFused(
+            fw, bw, &lstm_params, time_major, &op_data->fw_fused_float_buffers,
+            &op_data->bw_fused_float_buffers,
+            CpuBackendContext::GetFromContext(context));
+      }
+
       TfLiteStatus fw_pass_status = lstm_eval::EvalFloat(
           input, fw_input_to_input_weights, fw_input_to_forget_weights,
           fw_input_to_cell_weights, fw_input_to_output_weights,
@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 // Unit test for TFLite Bidirectional LSTM op.
 
+#include <cmath>
 #include <tuple>
 #include <vector>
 
@@ -2969,5 +2970,116 @@ TEST_P(LSTMOpTest, BlackBoxTestWithAuxInput) {
                   ArrayFloatNear(bw_expected, quantize_weights ? 1e-2 : 1e-5)));
 }
 
+// Returns `size` deterministic values in [-0.5, 0.5].
+std::vector<float> TestValues(int size, float seed) {
+  std::vector<float> values(size);
+  for (int i = 0; i < size; ++i) {
+    values[i] = 0.5f * std::sin(0.7f * i + seed);
+  }
+  return values;
+}
+
+// Runs a float model with distinct weights and `num_threads` threads, which
+// lets the two directions run concurrently from 2 threads on. Returns the
+// forward output followed by the backward one, or the merged output.
+std::vector<float> RunFloatBidirectionalLstm(int num_threads,
+                                             bool merge_outputs) {
+  const int n_batch = 2;
+  const int n_input = 3;
+  // n_cell and n_output have the same size when there is no projection.
+  const int n_cell = 5;
+  const int n_output = 5;
+  const int sequence_length = 4;
+
+  std::vector<std::vector<int>> input_shapes = {
+      {sequence_length, n_batch, n_input}};  // input tensor
+  for (int direction = 0; direction < 2; ++direction) {
+    input_shapes.insert(input_shapes.end(),
+                        {
+                            {n_cell, n_input},   // input_to_input_weight
+                            {n_cell, n_input},   // input_to_forget_weight
+                            {n_cell, n_input},   // input_to_cell_weight
+                            {n_cell, n_input},   // input_to_output_weight
+                            {n_cell, n_output},  // recurrent_to_input_weight
+                            {n_cell, n_output},  // recurrent_to_forget_weight
+                            {n_cell, n_output},  // recurrent_to_cell_weight
+                            {n_cell, n_output},  // recurrent_to_output_weight
+                            {0},                 // cell_to_input_weight
+                            {0},                 // cell_to_forget_weight
+                            {0},                 // cell_to_output_weight
+                            {n_cell},            // input_gate_bias
+                            {n_cell},            // forget_gate_bias
+                            {n_cell},            // cell_gate_bias
+                            {n_cell},            // output_gate_bias
+                            {0, 0},              // projection_weight
+                            {0},                 // projection_bias
+                        });
+  }
+  input_shapes.insert(input_shapes.end(),
+                      {
+                          {n_batch, n_output},  // fw activation_state
+                          {n_batch, n_cell},    // fw cell_state
+                          {n_batch, n_output},  // bw activation_state
+                          {n_batch, n_cell},    // bw cell_state
+                          {sequence_length, n_batch, 0},  // aux_input
+                          {0},  // aux_fw_input_to_input
+                          {0},  // aux_fw_input_to_forget
+                          {0},  // aux_fw_input_to_cell
+                          {0},  // aux_fw_input_to_output
+                          {0},  // aux_bw_input_to_input
+                          {0},  // aux_bw_input_to_forget
+                          {0},  // aux_bw_input_to_cell
+                          {0},  // aux_bw_input_to_output
+                      });
+
+  BidirectionalLSTMOpModel lstm(
+      n_batch, n_input, n_cell, n_output, sequence_length, /*use_cifg=*/false,
+      /*use_peephole=*/false, /*use_projection_weights=*/false,
+      /*use_projection_bias=*/false, merge_outputs,
+      /*use_aux_input=*/false, /*cell_clip=*/0.0,
+      /*proj_clip=*/0.0, /*quantize_weights=*/false, /*time_major=*/true,
+      input_shapes);
+  lstm.SetNumThreads(num_threads);
+
+  lstm.SetInputToInputWeights(TestValues(n_cell * n_input, 1));
+  lstm.SetInputToForgetWeights(TestValues(n_cell * n_input, 2));
+  lstm.SetInputToCellWeights(TestValues(n_cell * n_input, 3));
+  lstm.SetInputToOutputWeights(TestValues(n_cell * n_input, 4));
+  lstm.SetRecurrentToInputWeights(TestValues(n_cell * n_output, 5));
+  lstm.SetRecurrentToForgetWeights(TestValues(n_cell * n_output, 6));
+  lstm.SetRecurrentToCellWeights(TestValues(n_cell * n_output, 7));
+  lstm.SetRecurrentToOutputWeights(TestValues(n_cell * n_output, 8));
+  lstm.SetInputGateBias(TestValues(n_cell, 9));
+  lstm.SetForgetGateBias(TestValues(n_cell, 10));
+  lstm.SetCellBias(TestValues(n_cell, 11));
+  lstm.SetOutputGateBias(TestValues(n_cell, 12));
+
+  std::vector<float> input =
+      TestValues(sequence_length * n_batch * n_input, 13);
+  lstm.SetInput(0, input.data(), input.data() + input.size());
+
+  EXPECT_EQ(lstm.Invoke(), kTfLiteOk);
+
+  std::vector<float> output = lstm.GetFwOutput();
+  if (!merge_outputs) {
+    const std::vector<float> bw_output = lstm.GetBwOutput();
+    output.insert(output.end(), bw_output.begin(), bw_output.end());
+  }
+  return output;
+}
+
+TEST(LSTMOpTest, MultiThreadedMatchesSingleThreaded) {
+  for (const bool merge_outputs : {false, true}) {
+    SCOPED_TRACE(merge_outputs ? "Merged outputs" : "Separate outputs");
+    const std::vector<float> expected =
+        RunFloatBidirectionalLstm(/*num_threads=*/1, merge_outputs);
+    ASSERT_FALSE(expected.empty());
+    for (const int num_threads : {2, 4}) {
+      EXPECT_THAT(RunFloatBidirectionalLstm(num_threads, merge_outputs),
+                  ElementsAreArray(ArrayFloatNear(expected, 1e-6)));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace tflite
@@ -16,11 +16,75 @@ limitations under the License.
 #include "tflite/kernels/control_flow_common.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
+#include "tflite/context_util.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/kernels/kernel_util.h"
+
 namespace tflite {
 namespace ops {
 namespace builtin {
+namespace {
+
+// Returns true if the heap buffer of the `pos`-th source tensor can be handed
+// over to `dst_tensor` instead of being copied.
+bool CanMoveTensorData(Subgraph* src_subgraph,
+                       const std::vector<int>& src_tensor_indices, int pos,
+                       const TfLiteTensor* dst_tensor) {
+  const int src_idx = src_tensor_indices[pos];
+  if (src_idx == kTfLiteOptionalTensor) return false;
+  // Preserved tensors must keep their values for inspection.
+  if (src_subgraph->ShouldPreserveAllTensors()) return false;
+  // A source tensor which is returned more than once must stay valid until
+  // all of its destinations have been filled.
+  if (std::count(src_tensor_indices.begin(), src_tensor_indices.end(),
+                 src_idx) != 1) {
+    return false;
+  }
+  const TfLiteTensor* src_tensor = src_subgraph->tensor(src_idx);
+  return src_tensor->allocation_type == kTfLiteDynamic &&
+         dst_tensor->allocation_type == kTfLiteDynamic &&
+         src_tensor->type == dst_tensor->type &&
+         !IsResourceOrVariant(src_tensor) && src_tensor->dims != nullptr &&
+         dst_tensor->dims != nullptr &&
+         src_tensor->buffer_handle == kTfLiteNullBufferHandle &&
+         dst_tensor->buffer_handle == kTfLiteNullBufferHandle;
+}
+
+}  // namespace
+
+TfLiteStatus MoveOrDeepCopyTensorsShapeTypeData(
+    TfLiteContext* context, TfLiteNode* node, Subgraph* src_subgraph,
+    const std::vector<int>& src_tensor_indices, Subgraph* dst_subgraph,
+    const TfLiteIntArrayView& dst_tensor_indices) {
+  TF_LITE_ENSURE_EQ(context, src_tensor_indices.size(),
+                    dst_tensor_indices.size());
+  std::vector<int> copied_src_indices;
+  std::vector<int> copied_dst_indices;
+  for (int i = 0; i < src_tensor_indices.size(); ++i) {
+    // Skip copying unused destination tensors.
+    if (dst_tensor_indices[i] == kTfLiteOptionalTensor) continue;
+
+    TfLiteTensor* dst_tensor = dst_subgraph->tensor(dst_tensor_indices[i]);
+    if (CanMoveTensorData(src_subgraph, src_tensor_indices, i, dst_tensor)) {
+      // Swap buffers together with their shapes so that both tensors stay
+      // consistent and the source can resize its buffer when invoked again.
+      TfLiteTensor* src_tensor = src_subgraph->tensor(src_tensor_indices[i]);
+      std::swap(src_tensor->data.raw, dst_tensor->data.raw);
+      std::swap(src_tensor->bytes, dst_tensor->bytes);
+      std::swap(src_tensor->dims, dst_tensor->dims);
+    } else {
+      copied_src_indices.push_back(src_tensor_indices[i]);
+      copied_dst_indices.push_back(dst_tensor_indices[i]);
+    }
+  }
+  return DeepCopyTensorsShapeTypeData(
+      context, node, src_subgraph, copied_src_indices, dst_subgraph,
+      copied_dst_indices, /*body_has_dynamic_output_tensors=*/true);
+}
 
 int OutputIsInput(int output_idx, const std::vector<int>& subgraph_inputs) {
   auto e =
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <vector>
 
+#include "tflite/context_util.h"
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
 #include "tflite/kernels/kernel_util.h"
@@ -113,30 +114,63 @@ TfLiteStatus DeepCopyTensorsShapeTypeData(
   return kTfLiteOk;
 }
 
+// Returns true if `dst_subgraph` is allocated for inputs with the shapes and
+// types of `src_tensor_indices` in `src_subgraph`, so that binding them to
+// `dst_tensor_indices` only requires aliasing their data.
 template <typename SrcVector, typename DstVector>
-TfLiteStatus DeepOrShallowCopyTensorsShapeTypeData(
-    TfLiteContext* context, TfLiteNode* node, Subgraph* src_subgraph,
-    const SrcVector& src_tensor_indices, Subgraph* dst_subgraph,
-    const DstVector& dst_tensor_indices) {
-  // Resize the destination subgraph inputs.
+bool IsSubgraphAllocatedForInputs(Subgraph* src_subgraph,
+                                  const SrcVector& src_tensor_indices,
+                                  Subgraph* dst_subgraph,
+                                  const DstVector& dst_tensor_indices) {
+  if (!dst_subgraph->IsInvokable()) return false;
   for (int i = 0; i < src_tensor_indices.size(); ++i) {
-    // Skip copying unused destination tensors.
     if (dst_tensor_indices[i] == kTfLiteOptionalTensor) continue;
     if (src_tensor_indices[i] == kTfLiteOptionalTensor) continue;
 
     const TfLiteTensor* src_tensor =
         src_subgraph->tensor(src_tensor_indices[i]);
-    TfLiteTensor* dst_tensor = dst_subgraph->tensor(dst_tensor_indices[i]);
-    std::vector<int> dims(src_tensor->dims->data,
-                          src_tensor->dims->data + src_tensor->dims->size);
-    dst_subgraph->ResizeInputTensor(dst_tensor_indices[i], dims);
-    dst_tensor->type = src_tensor->type;
-    if (!IsResourceOrVariant(src_tensor)) {
-      dst_tensor->bytes = 0;  // Don't allocate memory with AllocateTensors().
-      dst_tensor->data.raw = nullptr;
+    const TfLiteTensor* dst_tensor =
+        dst_subgraph->tensor(dst_tensor_indices[i]);
+    if (IsResourceOrVariant(src_tensor) ||
+        dst_tensor->allocation_type != kTfLiteCustom ||
+        dst_tensor->type != src_tensor->type ||
+        !TfLiteIntArrayEqual(dst_tensor->dims, src_tensor->dims)) {
+      return false;
     }
   }
-  TF_LITE_ENSURE_OK(context, dst_subgraph->AllocateTensors());
+  return true;
+}
+
+template <typename SrcVector, typename DstVector>
+TfLiteStatus DeepOrShallowCopyTensorsShapeTypeData(
+    TfLiteContext* context, TfLiteNode* node, Subgraph* src_subgraph,
+    const SrcVector& src_tensor_indices, Subgraph* dst_subgraph,
+    const DstVector& dst_tensor_indices) {
+  // The memory plan of the destination subgraph only depends on the shapes
+  // and types of its inputs. If it is still allocated for them, e.g. because
+  // it is invoked repeatedly with the same shapes, skip planning altogether.
+  if (!IsSubgraphAllocatedForInputs(src_subgraph, src_tensor_indices,
+                                    dst_subgraph, dst_tensor_indices)) {
+    // Resize the destination subgraph inputs.
+    for (int i = 0; i < src_tensor_indices.size(); ++i) {
+      // Skip copying unused destination tensors.
+      if (dst_tensor_indices[i] == kTfLiteOptionalTensor) continue;
+      if (src_tensor_indices[i] == kTfLiteOptionalTensor) continue;
+
+      const TfLiteTensor* src_tensor =
+          src_subgraph->tensor(src_tensor_indices[i]);
+      TfLiteTensor* dst_tensor = dst_subgraph->tensor(dst_tensor_indices[i]);
+      std::vector<int> dims(src_tensor->dims->data,
+                            src_tensor->dims->data + src_tensor->dims->size);
+      dst_subgraph->ResizeInputTensor(dst_tensor_indices[i], dims);
+      dst_tensor->type = src_tensor->type;
+      if (!IsResourceOrVariant(src_tensor)) {
+        dst_tensor->bytes = 0;  // Don't allocate memory with AllocateTensors().
+        dst_tensor->data.raw = nullptr;
+      }
+    }
+    TF_LITE_ENSURE_OK(context, dst_subgraph->AllocateTensors());
+  }
   // Deep or shallow copy the data from src subgraph to dst.
   for (int i = 0; i < src_tensor_indices.size(); ++i) {
     // Skip copying unused destination tensors.
@@ -161,6 +195,20 @@ TfLiteStatus DeepOrShallowCopyTensorsShapeTypeData(
   return kTfLiteOk;
 }
 
+// Propagates shapes, types and data from the outputs `src_tensor_indices` of
+// `src_subgraph` to the dynamic tensors `dst_tensor_indices` of the subgraph
+// owning `context`, e.g. the outputs of a control flow op.
+//
+// Rather than being copied, the heap buffer of a dynamic source tensor is
+// handed over to its destination, which hands its previous buffer back. The
+// source subgraph reuses that buffer when it is invoked again, so repeated
+// invocations ping-pong between two buffers without allocating or copying.
+// All other tensors are deep copied.
+TfLiteStatus MoveOrDeepCopyTensorsShapeTypeData(
+    TfLiteContext* context, TfLiteNode* node, Subgraph* src_subgraph,
+    const std::vector<int>& src_tensor_indices, Subgraph* dst_subgraph,
+    const TfLiteIntArrayView& dst_tensor_indices);
+
 // Returns the subgraph input tensor index if the given output is also an input.
 // Otherwise returns -1.
 int OutputIsInput(int output_idx, const std::vector<int>& subgraph_inputs);
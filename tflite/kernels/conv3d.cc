@@ -22,12 +22,12 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/internal/optimized/conv3d_multithread.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
 #include "tflite/kernels/padding.h"
-#include "tflite/util.h"
 
 namespace tflite {
 namespace ops {
@@ -40,20 +40,11 @@ enum KernelType {
 };
 
 // Struct to carry data from Prepare to Eval.
-const int kTensorNotAllocated = -1;
-static constexpr size_t kMaxIm2colBufferSizeMobile = 1024 * 1024 * 1024;  // 1GB
-
 struct OpData {
   Padding3DValues padding;
-  int im2col_tensor_id = kTensorNotAllocated;
-
-  bool need_im2col = false;
-
-  // Disable im2col if the temporary im2col tensor requires too much memory
-  // (i.e. >= kMaxIm2colBufferSizeMobile).
-  bool im2col_oversized = false;
-
-  int32_t im2col_index;
+  // Pointwise convolutions are a plain GEMM over the input. All other
+  // convolutions use the im2col-free multithreaded kernel.
+  bool is_pointwise = false;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -65,43 +56,6 @@ void Free(TfLiteContext* context, void* buffer) {
   delete static_cast<OpData*>(buffer);
 }
 
-TfLiteStatus AllocateTemporaryTensorsIfRequired(
-    KernelType kernel_type, TfLiteContext* context, TfLiteNode* node,
-    OpData* opdata, TfLiteConv3DParams* params, const TfLiteTensor* filter,
-    size_t im2col_bytes) {
-  int temporaries_count = 0;
-  const bool need_dilated_im2col = params->dilation_width_factor != 1 ||
-                                   params->dilation_height_factor != 1 ||
-                                   params->dilation_depth_factor != 1;
-  const bool need_non_dilated_im2col =
-      params->stride_depth != 1 || params->stride_width != 1 ||
-      params->stride_height != 1 || filter->dims->data[2] != 1 ||
-      filter->dims->data[1] != 1 || filter->dims->data[0] != 1;
-
-  opdata->need_im2col = (kernel_type == kGenericOptimized) &&
-                        (need_dilated_im2col || need_non_dilated_im2col);
-
-  // On mobile platforms, the generic optimized kernel will not be used if the
-  // temporary im2col tensor requires too much memory.
-  if (IsMobilePlatform() && opdata->need_im2col &&
-      im2col_bytes >= kMaxIm2colBufferSizeMobile) {
-    opdata->need_im2col = false;
-    opdata->im2col_oversized = true;
-  }
-
-  if (opdata->need_im2col) {
-    if (opdata->im2col_tensor_id == kTensorNotAllocated) {
-      TF_LITE_ENSURE_OK(
-          context, context->AddTensors(context, 1, &opdata->im2col_tensor_id));
-    }
-    opdata->im2col_index = temporaries_count++;
-  }
-
-  TfLiteIntArrayFree(node->temporaries);
-  node->temporaries = TfLiteIntArrayCreate(temporaries_count);
-  return kTfLiteOk;
-}
-
 TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
                      TfLiteNode* node) {
   auto* params = static_cast<TfLiteConv3DParams*>(node->builtin_data);
@@ -147,7 +101,6 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
   int filter_depth = filter->dims->data[0];
   int filter_height = filter->dims->data[1];
   int filter_width = filter->dims->data[2];
-  int input_channel = filter->dims->data[3];
 
   // Matching GetWindowedOutputSize in TensorFlow.
   int out_width, out_height, out_depth;
@@ -167,35 +120,12 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
   TF_LITE_ENSURE_OK(context,
                     context->ResizeTensor(context, output, output_size));
 
-  // Allocate temporary tensors.
-  size_t input_type_size;
-  TF_LITE_ENSURE_STATUS(GetSizeOfType(context, input->type, &input_type_size));
-  const size_t im2col_bytes = batches * out_depth * out_height * out_width *
-                              input_channel * filter_depth * filter_height *
-                              filter_width * input_type_size;
-  TF_LITE_ENSURE_OK(context, AllocateTemporaryTensorsIfRequired(
-                                 kernel_type, context, node, opdata, params,
-                                 filter, im2col_bytes));
-
-  if (opdata->need_im2col) {
-    TfLiteIntArray* im2col_size = TfLiteIntArrayCreate(5);
-    im2col_size->data[0] = output_size->data[0];
-    im2col_size->data[1] = output_size->data[1];
-    im2col_size->data[2] = output_size->data[2];
-    im2col_size->data[3] = output_size->data[3];
-    im2col_size->data[4] =
-        input_channel * filter_depth * filter_height * filter_width;
-
-    TfLiteTensor* im2col;
-    node->temporaries->data[opdata->im2col_index] = opdata->im2col_tensor_id;
-    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
-                                                opdata->im2col_index, &im2col));
-    im2col->type = input->type;
-    im2col->allocation_type = kTfLiteArenaRw;
-    TF_LITE_ENSURE_OK(context,
-                      context->ResizeTensor(context, im2col, im2col_size));
-  }
-
+  opdata->is_pointwise =
+      params->stride_depth == 1 && params->stride_height == 1 &&
+      params->stride_width == 1 && params->dilation_depth_factor == 1 &&
+      params->dilation_height_factor == 1 &&
+      params->dilation_width_factor == 1 && filter_depth == 1 &&
+      filter_height == 1 && filter_width == 1;
   return kTfLiteOk;
 }
 
@@ -208,7 +138,7 @@ TfLiteStatus EvalFloat(KernelType kernel_type, TfLiteContext* context,
                        TfLiteNode* node, TfLiteConv3DParams* params,
                        OpData* opdata, const TfLiteTensor* input,
                        const TfLiteTensor* filter, const TfLiteTensor* bias,
-                       TfLiteTensor* im2col, TfLiteTensor* output) {
+                       TfLiteTensor* output) {
   float output_activation_min, output_activation_max;
   CalculateActivationRange(params->activation, &output_activation_min,
                            &output_activation_max);
@@ -233,13 +163,22 @@ TfLiteStatus EvalFloat(KernelType kernel_type, TfLiteContext* context,
       return kTfLiteOk;
     }
     case kGenericOptimized: {
-      return optimized_ops::Conv3D(
+      if (opdata->is_pointwise) {
+        return optimized_ops::Conv3D(
+            runtime_params, GetTensorShape(input), GetTensorData<float>(input),
+            GetTensorShape(filter), GetTensorData<float>(filter),
+            GetTensorShape(bias), GetTensorData<float>(bias),
+            GetTensorShape(output), GetTensorData<float>(output),
+            RuntimeShape(), /*im2col_data=*/nullptr,
+            CpuBackendContext::GetFromContext(context));
+      }
+      optimized_ops::Conv3DMultithread(
           runtime_params, GetTensorShape(input), GetTensorData<float>(input),
           GetTensorShape(filter), GetTensorData<float>(filter),
           GetTensorShape(bias), GetTensorData<float>(bias),
           GetTensorShape(output), GetTensorData<float>(output),
-          GetTensorShape(im2col), GetTensorData<float>(im2col),
           CpuBackendContext::GetFromContext(context));
+      return kTfLiteOk;
     }
   }
 }
@@ -257,18 +196,10 @@ TfLiteStatus Eval(KernelType kernel_type, TfLiteContext* context,
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, 1, &filter));
   const TfLiteTensor* bias = GetInput(context, node, 2);
 
-  TfLiteTensor* im2col = opdata->need_im2col
-                             ? &context->tensors[opdata->im2col_tensor_id]
-                             : nullptr;
-  // Fallback to reference execution path when im2col is needed but disabled.
-  if (opdata->im2col_oversized) {
-    kernel_type = kReference;
-  }
-
   switch (input->type) {
     case kTfLiteFloat32:
       return EvalFloat(kernel_type, context, node, params, opdata, input,
-                       filter, bias, im2col, output);
+                       filter, bias, output);
     default:
       TF_LITE_KERNEL_LOG(context, "Type %s currently not supported.",
                          TfLiteTypeGetName(input->type));
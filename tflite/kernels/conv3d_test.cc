@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
 #include "tflite/kernels/test_util.h"
 #include "tflite/schema/schema_generated.h"
 
@@ -269,5 +270,100 @@ TEST(Conv3dOpModel, NoIm2ColTensorTest) {
                         708, 794, 632, 734, 836, 938, 728, 846, 964, 1082}));
 }
 
+// Uses enough output channels and output columns to exercise both the full
+// register tiles and the remainder paths of the optimized kernel.
+TEST(Conv3dOpModel, ChannelAndWidthRemainderTest) {
+  const int batches = 2, in_depth = 3, in_height = 7, in_width = 19;
+  const int in_channels = 3, out_channels = 19;
+  const int filter_depth = 2, filter_height = 3, filter_width = 3;
+  const int stride_width = 2, dilation_height = 2;
+  const int out_depth = in_depth - filter_depth + 1;
+  const int out_height = in_height - (filter_height - 1) * dilation_height;
+  const int out_width = (in_width - filter_width) / stride_width + 1;
+  Conv3dOpModel m(
+      {TensorType_FLOAT32,
+       {batches, in_depth, in_height, in_width, in_channels}},
+      {TensorType_FLOAT32,
+       {filter_depth, filter_height, filter_width, in_channels, out_channels}},
+      {TensorType_FLOAT32, {}}, Padding_VALID, /*stride_depth=*/1,
+      stride_width, /*stride_height=*/1,
+      /*activation=*/ActivationFunctionType_NONE,
+      /*dilation_depth=*/1, /*dilation_width=*/1, dilation_height);
+
+  std::vector<float> input(batches * in_depth * in_height * in_width *
+                           in_channels);
+  for (int i = 0; i < input.size(); ++i) input[i] = (i % 13) - 6;
+  std::vector<float> filter(filter_depth * filter_height * filter_width *
+                            in_channels * out_channels);
+  for (int i = 0; i < filter.size(); ++i) filter[i] = (i % 7) - 3;
+  m.SetInput(input);
+  m.SetFilter(filter);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> expected;
+  for (int b = 0; b < batches; ++b) {
+    for (int od = 0; od < out_depth; ++od) {
+      for (int oh = 0; oh < out_height; ++oh) {
+        for (int ow = 0; ow < out_width; ++ow) {
+          for (int oc = 0; oc < out_channels; ++oc) {
+            float sum = 0;
+            for (int fd = 0; fd < filter_depth; ++fd) {
+              for (int fh = 0; fh < filter_height; ++fh) {
+                for (int fw = 0; fw < filter_width; ++fw) {
+                  for (int ic = 0; ic < in_channels; ++ic) {
+                    const int id = od + fd;
+                    const int ih = oh + fh * dilation_height;
+                    const int iw = ow * stride_width + fw;
+                    sum += input[(((b * in_depth + id) * in_height + ih) *
+                                      in_width +
+                                  iw) *
+                                     in_channels +
+                                 ic] *
+                           filter[(((fd * filter_height + fh) * filter_width +
+                                    fw) *
+                                       in_channels +
+                                   ic) *
+                                      out_channels +
+                                  oc];
+                  }
+                }
+              }
+            }
+            expected.push_back(sum);
+          }
+        }
+      }
+    }
+  }
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(batches, out_depth, out_height,
+                                              out_width, out_channels));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+}
+
+// Run with --benchmark_filter=BM_Conv3d.
+void BM_Conv3d(benchmark::State& state) {
+  const int kernel_size = state.range(0);
+  const int stride = state.range(1);
+  const int channels = state.range(2);
+  Conv3dOpModel m({TensorType_FLOAT32, {1, 16, 32, 32, channels}},
+                  {TensorType_FLOAT32,
+                   {kernel_size, kernel_size, kernel_size, channels, channels}},
+                  {TensorType_FLOAT32, {}}, Padding_SAME, stride, stride,
+                  stride);
+  m.SetInput(std::vector<float>(16 * 32 * 32 * channels, 1.0f));
+  m.SetFilter(std::vector<float>(
+      kernel_size * kernel_size * kernel_size * channels * channels, 0.5f));
+  for (auto _ : state) {
+    if (m.Invoke() != kTfLiteOk) {
+      state.SkipWithError("Invoke failed");
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_Conv3d)
+    ->ArgNames({"kernel", "stride", "channels"})
+    ->ArgsProduct({{1, 3, 5}, {1, 2}, {16, 64}});
+
 }  // namespace
 }  // namespace tflite
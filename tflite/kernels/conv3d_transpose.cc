@@ -20,7 +20,7 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/cpu_backend_context.h"
-#include "tflite/kernels/internal/optimized/optimized_ops.h"
+#include "tflite/kernels/internal/optimized/conv3d_multithread.h"
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
@@ -41,13 +41,17 @@ const int kTensorNotAllocated = -1;
 struct OpData {
   Padding3DValues padding;
 
-  // The id of the temporary col2im tensor.
-  int col2im_id = kTensorNotAllocated;
+  // The id of the temporary tensor holding the filter in [depth, height,
+  // width, input_channels, output_channels] layout.
+  int transposed_filter_id = kTensorNotAllocated;
 
-  // The index of col2im tensor in the temporaries list.
-  int col2im_index;
+  // The index of the transposed filter tensor in the temporaries list.
+  int transposed_filter_index;
 
-  bool need_col2im = false;
+  bool need_transposed_filter = false;
+  // Whether the transposed filter holds the transpose of a constant filter,
+  // which is then only computed once.
+  bool filter_transposed = false;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -65,13 +69,13 @@ static TfLiteStatus AllocateTemporaryTensorsIfRequired(TfLiteContext* context,
   OpData* data = reinterpret_cast<OpData*>(node->user_data);
   int temporaries_count = 0;
 
-  // Allocate col2im tensor for the optimized kernel.
+  // Allocate the transposed filter tensor for the optimized kernel.
   if (kernel_type == kGenericOptimized) {
-    if (data->col2im_id == kTensorNotAllocated) {
-      context->AddTensors(context, 1, &data->col2im_id);
+    if (data->transposed_filter_id == kTensorNotAllocated) {
+      context->AddTensors(context, 1, &data->transposed_filter_id);
     }
-    data->col2im_index = temporaries_count++;
-    data->need_col2im = true;
+    data->transposed_filter_index = temporaries_count++;
+    data->need_transposed_filter = true;
   }
 
   TfLiteIntArrayFree(node->temporaries);
@@ -80,10 +84,12 @@ static TfLiteStatus AllocateTemporaryTensorsIfRequired(TfLiteContext* context,
   return kTfLiteOk;
 }
 
-TfLiteStatus ResizeOutputAndTemporaryTensors(
-    TfLiteContext* context, OpData* opdata, TfLiteConv3DTransposeParams* params,
-    const TfLiteTensor* shape_tensor, const TfLiteTensor* filter,
-    const TfLiteTensor* input, TfLiteTensor* col2im, TfLiteTensor* output) {
+TfLiteStatus ResizeOutputTensor(TfLiteContext* context, OpData* opdata,
+                                TfLiteConv3DTransposeParams* params,
+                                const TfLiteTensor* shape_tensor,
+                                const TfLiteTensor* filter,
+                                const TfLiteTensor* input,
+                                TfLiteTensor* output) {
   auto shape_data = GetTensorData<int32_t>(shape_tensor);
   // Output and input tensor must have the same batch size.
   TF_LITE_ENSURE_EQ(context, shape_data[0], SizeOfDimension(input, 0));
@@ -116,22 +122,7 @@ TfLiteStatus ResizeOutputAndTemporaryTensors(
     output_shape->data[i] = GetTensorData<int32_t>(shape_tensor)[i];
   }
 
-  TF_LITE_ENSURE_STATUS(context->ResizeTensor(context, output, output_shape));
-
-  // Resize col2im tensor.
-  if (opdata->need_col2im) {
-    TfLiteIntArray* col2im_shape_array = TfLiteIntArrayCreate(2);
-    const RuntimeShape& input_shape = GetTensorShape(input);
-    col2im_shape_array->data[0] =
-        input_shape.Dims(1) * input_shape.Dims(2) * input_shape.Dims(3);
-    col2im_shape_array->data[1] =
-        filter_depth * filter_height * filter_width * filter_shape.Dims(3);
-
-    col2im->type = kTfLiteFloat32;
-    col2im->allocation_type = kTfLiteDynamic;
-    return context->ResizeTensor(context, col2im, col2im_shape_array);
-  }
-  return kTfLiteOk;
+  return context->ResizeTensor(context, output, output_shape);
 }
 
 TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
@@ -174,33 +165,37 @@ TfLiteStatus Prepare(KernelType kernel_type, TfLiteContext* context,
     TF_LITE_ENSURE_EQ(context, NumElements(bias), SizeOfDimension(filter, 3));
   }
 
-  // GenericOptimized kernel currently doesn't support dilation.
-  if (params->dilation_depth_factor > 1 || params->dilation_height_factor > 1 ||
-      params->dilation_width_factor > 1) {
-    kernel_type = kReference;
-  }
-
   // Allocate temporary tensors.
   TF_LITE_ENSURE_STATUS(
       AllocateTemporaryTensorsIfRequired(context, node, kernel_type));
 
-  // Check temporary tensors.
-  TfLiteTensor* col2im = nullptr;
-  if (opdata->need_col2im) {
-    node->temporaries->data[opdata->col2im_index] = opdata->col2im_id;
-    TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node,
-                                                opdata->col2im_index, &col2im));
+  // The transposed filter only depends on the filter shape.
+  if (opdata->need_transposed_filter) {
+    node->temporaries->data[opdata->transposed_filter_index] =
+        opdata->transposed_filter_id;
+    TfLiteTensor* transposed_filter;
+    TF_LITE_ENSURE_OK(context,
+                      GetTemporarySafe(context, node,
+                                       opdata->transposed_filter_index,
+                                       &transposed_filter));
+    transposed_filter->type = kTfLiteFloat32;
+    // A constant filter is transposed once, on the first Eval, into a
+    // persistent tensor.
+    transposed_filter->allocation_type = IsConstantOrPersistentTensor(filter)
+                                             ? kTfLiteArenaRwPersistent
+                                             : kTfLiteArenaRw;
+    TF_LITE_ENSURE_STATUS(context->ResizeTensor(
+        context, transposed_filter, TfLiteIntArrayCopy(filter->dims)));
+    opdata->filter_transposed = false;
   }
 
   // Resize the output tensor.
   if (!IsConstantOrPersistentTensor(output_shape)) {
     SetTensorToDynamic(output);
-    if (opdata->need_col2im) {
-      SetTensorToDynamic(col2im);
-    }
   } else {
-    TF_LITE_ENSURE_STATUS(ResizeOutputAndTemporaryTensors(
-        context, opdata, params, output_shape, filter, input, col2im, output));
+    TF_LITE_ENSURE_STATUS(ResizeOutputTensor(context, opdata, params,
+                                             output_shape, filter, input,
+                                             output));
   }
   return kTfLiteOk;
 }
@@ -213,7 +208,7 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 void EvalFloat(KernelType kernel_type, TfLiteContext* context, TfLiteNode* node,
                TfLiteConv3DTransposeParams* params, OpData* opdata,
                const TfLiteTensor* input, const TfLiteTensor* filter,
-               const TfLiteTensor* bias, TfLiteTensor* col2im,
+               const TfLiteTensor* bias, TfLiteTensor* transposed_filter,
                TfLiteTensor* output) {
   float output_activation_min, output_activation_max;
   CalculateActivationRange(params->activation, &output_activation_min,
@@ -240,12 +235,17 @@ void EvalFloat(KernelType kernel_type, TfLiteContext* context, TfLiteNode* node,
       break;
     }
     case kGenericOptimized: {
-      optimized_ops::Conv3DTranspose(
+      if (!opdata->filter_transposed) {
+        optimized_ops::TransposeConv3DTransposeFilter(
+            GetTensorShape(filter), GetTensorData<float>(filter),
+            GetTensorData<float>(transposed_filter));
+        opdata->filter_transposed = IsConstantOrPersistentTensor(filter);
+      }
+      optimized_ops::Conv3DTransposeMultithread(
           runtime_params, GetTensorShape(input), GetTensorData<float>(input),
-          GetTensorShape(filter), GetTensorData<float>(filter),
+          GetTensorShape(filter), GetTensorData<float>(transposed_filter),
           GetTensorShape(bias), GetTensorData<float>(bias),
           GetTensorShape(output), GetTensorData<float>(output),
-          GetTensorShape(col2im), GetTensorData<float>(col2im),
           CpuBackendContext::GetFromContext(context));
     } break;
   }
@@ -266,26 +266,21 @@ TfLiteStatus Eval(KernelType kernel_type, TfLiteContext* context,
   const TfLiteTensor* input;
   TF_LITE_ENSURE_OK(context, GetInputSafe(context, node, 2, &input));
   const TfLiteTensor* bias = GetInput(context, node, 3);
-  TfLiteTensor* col2im = opdata->need_col2im
-                             ? GetTemporary(context, node, opdata->col2im_index)
-                             : nullptr;
+  TfLiteTensor* transposed_filter =
+      opdata->need_transposed_filter
+          ? GetTemporary(context, node, opdata->transposed_filter_index)
+          : nullptr;
 
   if (IsDynamicTensor(output)) {
-    TF_LITE_ENSURE_OK(context, ResizeOutputAndTemporaryTensors(
-                                   context, opdata, params, output_shape,
-                                   filter, input, col2im, output));
-  }
-
-  // GenericOptimized kernel currently doesn't support dilation.
-  if (params->dilation_depth_factor > 1 || params->dilation_height_factor > 1 ||
-      params->dilation_width_factor > 1) {
-    kernel_type = kReference;
+    TF_LITE_ENSURE_OK(context,
+                      ResizeOutputTensor(context, opdata, params, output_shape,
+                                         filter, input, output));
   }
 
   switch (input->type) {
     case kTfLiteFloat32:
       EvalFloat(kernel_type, context, node, params, opdata, input, filter, bias,
-                col2im, output);
+                transposed_filter, output);
       break;
     default:
       TF_LITE_KERNEL_LOG(context, "Type %s currently not supported.",
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "benchmark/benchmark.h"  // from @com_google_benchmark
 #include "tflite/kernels/test_util.h"
 #include "tflite/schema/schema_generated.h"
 
@@ -112,6 +113,39 @@ class Conv3dTransposeOpModel : public SingleOpModel {
   int output_;
 };
 
+// Conv3DTranspose with a constant filter, which the optimized kernel only
+// transposes once.
+class ConstFilterConv3dTransposeOpModel : public SingleOpModel {
+ public:
+  ConstFilterConv3dTransposeOpModel(
+      std::initializer_list<int> output_shape_data,
+      std::initializer_list<int> filter_shape,
+      std::initializer_list<float> filter_data, const TensorData& input,
+      const TensorData& output) {
+    output_shape_ = AddConstInput(TensorType_INT32, output_shape_data, {5});
+    filter_ = AddConstInput(TensorType_FLOAT32, filter_data, filter_shape);
+    input_ = AddInput(input);
+    output_ = AddOutput(output);
+    SetBuiltinOp(BuiltinOperator_CONV_3D_TRANSPOSE,
+                 BuiltinOptions_Conv3DOptions,
+                 CreateConv3DOptions(builder_, Padding_VALID, /*stride_d=*/1,
+                                     /*stride_w=*/1, /*stride_h=*/1)
+                     .Union());
+    BuildInterpreter(
+        {GetShape(output_shape_), GetShape(filter_), GetShape(input_)});
+  }
+
+  void SetInput(std::vector<float> data) { PopulateTensor(input_, data); }
+
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+
+ private:
+  int output_shape_;
+  int filter_;
+  int input_;
+  int output_;
+};
+
 template <typename T>
 std::vector<T> CreateRangeVector(int N) {
   std::vector<T> result;
@@ -181,6 +215,29 @@ TEST_P(Conv3dTransposeOpTest, SimpleFloat32Test) {
            60,  0,   -49, 1,   -54, 0,   -58, 0,   -62, 0,   -1,  -1}));
 }
 
+// A filter that isn't constant may change between invocations and must be
+// transposed again.
+TEST_P(Conv3dTransposeOpTest, UpdatedFilterTest) {
+  Conv3dTransposeOpModel m(
+      {1, 3, 3, 5, 2}, {TensorType_FLOAT32, {2, 2, 2, 2, 2}},
+      {TensorType_FLOAT32, {1, 2, 2, 4, 2}}, {TensorType_FLOAT32, {}},
+      Conv3dTransposeOpTest::GetParam());
+
+  m.SetInput(CreateRangeVector<float>(32));
+  std::vector<float> filter = {-1, -1, -1, -1, -1, 1,  -1, 1,  -1, 1, 1,
+                               1,  1,  1,  -1, -1, 1,  -1, 1,  1,  1, 1,
+                               -1, 1,  -1, -1, -1, 1,  1,  -1, 1,  -1};
+  m.SetFilter(filter);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  std::vector<float> expected = m.GetOutput();
+
+  for (float& f : filter) f = -f;
+  m.SetFilter(filter);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  for (float& e : expected) e = -e;
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+}
+
 TEST_P(Conv3dTransposeOpTest, PaddingValidTest) {
   Conv3dTransposeOpModel m(
       {1, 4, 5, 6, 2}, {TensorType_FLOAT32, {2, 2, 2, 2, 2}},
@@ -361,6 +418,139 @@ TEST_P(Conv3dTransposeOpTest, BiasTest) {
            -1, -80, 3, 84, 0,  43,  2, 1,  -1, 6,   3, 42, 0,  -43, 2, 47}));
 }
 
+// Uses enough output channels and input columns to exercise both the full
+// register tiles and the remainder paths of the optimized kernel.
+TEST_P(Conv3dTransposeOpTest, ChannelAndWidthRemainderTest) {
+  const int batches = 2, in_depth = 2, in_height = 3, in_width = 9;
+  const int in_channels = 3, out_channels = 19;
+  const int filter_depth = 2, filter_height = 3, filter_width = 3;
+  const int stride_width = 2, dilation_height = 2;
+  const int out_depth = in_depth + filter_depth - 1;
+  const int out_height = in_height + (filter_height - 1) * dilation_height;
+  const int out_width = (in_width - 1) * stride_width + filter_width;
+  Conv3dTransposeOpModel m(
+      {batches, out_depth, out_height, out_width, out_channels},
+      {TensorType_FLOAT32,
+       {filter_depth, filter_height, filter_width, out_channels, in_channels}},
+      {TensorType_FLOAT32,
+       {batches, in_depth, in_height, in_width, in_channels}},
+      {TensorType_FLOAT32, {}}, Conv3dTransposeOpTest::GetParam(),
+      Padding_VALID, /*stride_depth=*/1, stride_width, /*stride_height=*/1,
+      /*activation=*/ActivationFunctionType_NONE,
+      /*dilation_depth=*/1, /*dilation_width=*/1, dilation_height);
+
+  std::vector<float> input(batches * in_depth * in_height * in_width *
+                           in_channels);
+  for (int i = 0; i < input.size(); ++i) input[i] = (i % 13) - 6;
+  std::vector<float> filter(filter_depth * filter_height * filter_width *
+                            out_channels * in_channels);
+  for (int i = 0; i < filter.size(); ++i) filter[i] = (i % 7) - 3;
+  m.SetInput(input);
+  m.SetFilter(filter);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+
+  std::vector<float> expected(batches * out_depth * out_height * out_width *
+                              out_channels);
+  for (int b = 0; b < batches; ++b) {
+    for (int id = 0; id < in_depth; ++id) {
+      for (int ih = 0; ih < in_height; ++ih) {
+        for (int iw = 0; iw < in_width; ++iw) {
+          for (int fd = 0; fd < filter_depth; ++fd) {
+            for (int fh = 0; fh < filter_height; ++fh) {
+              for (int fw = 0; fw < filter_width; ++fw) {
+                const int od = id + fd;
+                const int oh = ih + fh * dilation_height;
+                const int ow = iw * stride_width + fw;
+                for (int oc = 0; oc < out_channels; ++oc) {
+                  for (int ic = 0; ic < in_channels; ++ic) {
+                    expected[(((b * out_depth + od) * out_height + oh) *
+                                  out_width +
+                              ow) *
+                                 out_channels +
+                             oc] +=
+                        input[(((b * in_depth + id) * in_height + ih) *
+                                   in_width +
+                               iw) *
+                                  in_channels +
+                              ic] *
+                        filter[(((fd * filter_height + fh) * filter_width +
+                                 fw) *
+                                    out_channels +
+                                oc) *
+                                   in_channels +
+                               ic];
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  EXPECT_THAT(m.GetOutputShape(), ElementsAre(batches, out_depth, out_height,
+                                              out_width, out_channels));
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+}
+
+TEST(Conv3dTransposeOpTest, ConstFilterTest) {
+  ConstFilterConv3dTransposeOpModel m(
+      {1, 3, 3, 5, 2}, {2, 2, 2, 2, 2},
+      {-1, -1, -1, -1, -1, 1, -1, 1, -1, 1,  1,  1, 1, 1,  -1, -1,
+       1,  -1, 1,  1,  1,  1, -1, 1, -1, -1, -1, 1, 1, -1, 1,  -1},
+      {TensorType_FLOAT32, {1, 2, 2, 4, 2}}, {TensorType_FLOAT32, {}});
+
+  const std::vector<float> expected = {
+      -1,  -1,  -4,  -4,  -8,  -8,  -12, -12, 1,   1,   -16, -16, -18,
+      -16, -18, -20, -18, -24, 14,  -12, 1,   17,  18,  4,   22,  4,
+      26,  4,   29,  -29, -34, -32, -36, -30, -36, -30, -36, -30, 14,
+      2,   -50, 2,   -8,  -26, -8,  -26, -8,  -26, 74,  -44, -16, 50,
+      28,  4,   28,  4,   28,  4,   60,  -62, -1,  33,  32,  38,  36,
+      42,  40,  46,  45,  1,   -34, 50,  10,  54,  10,  58,  10,  62,
+      60,  0,   -49, 1,   -54, 0,   -58, 0,   -62, 0,   -1,  -1};
+  m.SetInput(CreateRangeVector<float>(32));
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(expected));
+
+  // The second invocation reuses the filter transposed by the first.
+  std::vector<float> input = CreateRangeVector<float>(32);
+  for (float& i : input) i = -i;
+  m.SetInput(input);
+  ASSERT_EQ(m.Invoke(), kTfLiteOk);
+  std::vector<float> negated = expected;
+  for (float& e : negated) e = -e;
+  EXPECT_THAT(m.GetOutput(), ElementsAreArray(negated));
+}
+
+// Run with --benchmark_filter=BM_Conv3dTranspose.
+void BM_Conv3dTranspose(benchmark::State& state) {
+  const int kernel_size = state.range(0);
+  const int stride = state.range(1);
+  const int channels = state.range(2);
+  const int in_size = 16 / stride;
+  Conv3dTransposeOpModel m(
+      {1, 16, 32, 32, channels},
+      {TensorType_FLOAT32,
+       {kernel_size, kernel_size, kernel_size, channels, channels}},
+      {TensorType_FLOAT32, {1, in_size, 2 * in_size, 2 * in_size, channels}},
+      {TensorType_FLOAT32, {}}, TestType::kConst, Padding_SAME, stride,
+      stride, stride);
+  m.SetInput(std::vector<float>(4 * in_size * in_size * in_size * channels,
+                                1.0f));
+  m.SetFilter(std::vector<float>(
+      kernel_size * kernel_size * kernel_size * channels * channels, 0.5f));
+  for (auto _ : state) {
+    if (m.Invoke() != kTfLiteOk) {
+      state.SkipWithError("Invoke failed");
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_Conv3dTranspose)
+    ->ArgNames({"kernel", "stride", "channels"})
+    ->ArgsProduct({{1, 3, 5}, {1, 2}, {16, 64}});
+
 INSTANTIATE_TEST_SUITE_P(Conv3dTransposeOpTest, Conv3dTransposeOpTest,
                          ::testing::Values(TestType::kConst,
                                            TestType::kDynamic));
@@ -15,7 +15,10 @@ limitations under the License.
 
 #include "tflite/kernels/cpu_backend_context.h"
 
+#include <algorithm>
 #include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #ifdef TFLITE_KERNEL_USE_XNNPACK
 #include "pthreadpool.h"  // from @pthreadpool
@@ -28,15 +31,47 @@ limitations under the License.
 #include "public/gemmlowp.h"
 #include "ruy/context.h"  // from @ruy
 #include "ruy/path.h"  // from @ruy
+#include "ruy/thread_pool.h"  // from @ruy
 #include "tflite/core/c/common.h"
 #include "tflite/core/macros.h"
 #include "tflite/external_cpu_backend_context.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/op_macros.h"
+#include "tflite/memory_placement.h"
 
 namespace {
 const int kDefaultNumThreadpoolThreads = 1;
 
+// Restricts the thread running it to `cpus`, unless it is the thread that
+// handed out the tasks.
+template <typename TaskBase>
+class SetAffinityTask : public TaskBase {
+ public:
+  explicit SetAffinityTask(const std::vector<int>* cpus)
+      : cpus_(cpus), caller_(std::this_thread::get_id()) {}
+
+  void Run() override {
+    if (std::this_thread::get_id() != caller_) {
+      tflite::SetCurrentThreadCpus(*cpus_);
+    }
+  }
+
+ private:
+  const std::vector<int>* cpus_;
+  std::thread::id caller_;
+};
+
+// Runs one task per thread on `pool`. The pools run all tasks but one on
+// distinct workers, creating the workers they lack, so this reaches every
+// worker of a pool used with up to `num_threads` threads.
+template <typename TaskBase, typename Pool>
+void SetWorkersCpus(Pool* pool, int num_threads, const std::vector<int>& cpus) {
+  std::vector<SetAffinityTask<TaskBase>> tasks(
+      num_threads, SetAffinityTask<TaskBase>(&cpus));
+  pool->Execute(num_threads, tasks.data());
+}
+
 }  // namespace
 
 namespace tflite {
@@ -122,6 +157,8 @@ CpuBackendContext* CpuBackendContext::GetFromContext(TfLiteContext* context) {
     external_context->set_internal_backend_context(
         std::unique_ptr<TfLiteInternalBackendContext>(cpu_backend_context));
   }
+  cpu_backend_context->set_interrupt(InvocationInterrupt::Get(context));
+  cpu_backend_context->SetWorkerNumaNode(external_context->worker_numa_node());
 
   return cpu_backend_context;
 }
@@ -151,11 +188,41 @@ void CpuBackendContext::SetMaxNumThreads(int max_num_threads) {
 
 void CpuBackendContext::SetUseCaching(bool flag) { use_caching_ = flag; }
 
+void CpuBackendContext::SetWorkerNumaNode(int numa_node) {
+  const int num_threads = std::max(max_num_threads_, 1);
+  if (numa_node == worker_numa_node_ &&
+      (numa_node < 0 || num_pinned_threads_ >= num_threads)) {
+    return;
+  }
+  // Whether or not it succeeds, pinning is only attempted once per node and
+  // number of threads, as the node's CPUs are read from sysfs.
+  worker_numa_node_ = numa_node;
+  num_pinned_threads_ = num_threads;
+  const std::vector<int> cpus =
+      numa_node >= 0 ? NumaNodeCpus(numa_node) : CurrentThreadCpus();
+  if (cpus.empty() || num_threads == 1) return;
+  SetWorkersCpus<ruy::Task>(ruy_context_->mutable_thread_pool(), num_threads,
+                            cpus);
+#ifndef TFLITE_WITH_RUY
+  // cpu_backend_threadpool runs on the gemmlowp workers in this case.
+  SetWorkersCpus<gemmlowp::Task>(gemmlowp_context_->workers_pool(),
+                                 num_threads, cpus);
+#endif
+}
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
 pthreadpool_t CpuBackendContext::get_xnnpack_threadpool() {
   if (!xnnpack_threadpool_ && max_num_threads_ > 1) {
+    // The workers are started here and inherit the calling thread's affinity,
+    // which is restored once they are.
+    std::vector<int> caller_cpus;
+    if (worker_numa_node_ >= 0) {
+      caller_cpus = CurrentThreadCpus();
+      if (!PinCurrentThreadToNumaNode(worker_numa_node_)) caller_cpus.clear();
+    }
     xnnpack_threadpool_.reset(
         pthreadpool_create(static_cast<size_t>(max_num_threads_)));
+    if (!caller_cpus.empty()) SetCurrentThreadCpus(caller_cpus);
   }
   return xnnpack_threadpool_.get();
 }
@@ -22,6 +22,7 @@ limitations under the License.
 #endif
 
 #include <memory>
+#include <vector>
 
 #include "public/gemmlowp.h"
 #ifdef TFLITE_KERNEL_USE_XNNPACK
@@ -30,6 +31,7 @@ limitations under the License.
 #include "ruy/context.h"  // from @ruy
 #include "tflite/core/c/common.h"
 #include "tflite/external_cpu_backend_context.h"
+#include "tflite/invocation_interrupt.h"
 
 namespace tflite {
 
@@ -56,6 +58,25 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
 
   bool use_caching() const { return use_caching_; }
 
+  // The interrupt of the invocation the calling kernel runs in, nullptr if
+  // there is none. Refreshed by `GetFromContext`.
+  InvocationInterrupt* interrupt() const { return interrupt_; }
+
+  void set_interrupt(InvocationInterrupt* interrupt) {
+    interrupt_ = interrupt;
+  }
+
+  // Pins the worker threads of the ruy thread pool, and of the gemmlowp one
+  // when cpu_backend_threadpool uses it, to the CPUs of `numa_node`, or lets
+  // them run wherever the calling thread may run if `numa_node` is negative.
+  // The calling thread itself keeps its affinity. Workers added later by
+  // raising the number of threads are pinned by the next call. The XNNPACK
+  // thread pool is pinned when it is created, so the node has to be set
+  // before its first use. Refreshed by `GetFromContext`.
+  void SetWorkerNumaNode(int numa_node);
+
+  int worker_numa_node() const { return worker_numa_node_; }
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   pthreadpool_t get_xnnpack_threadpool();
 #endif
@@ -122,6 +143,14 @@ class CpuBackendContext final : public TfLiteInternalBackendContext {
   // (currently the Ruy library only).
   bool use_caching_;
 
+  // Lets long running backend calls check whether the invocation should stop.
+  InvocationInterrupt* interrupt_ = nullptr;
+
+  // See `SetWorkerNumaNode`. `worker_numa_node_` applies to the workers used
+  // with up to `num_pinned_threads_` threads, the calling thread included.
+  int worker_numa_node_ = -1;
+  int num_pinned_threads_ = 0;
+
 #ifdef TFLITE_KERNEL_USE_XNNPACK
   // A smart pointer for the xnnpack threadpool. Is created by a call from the
   // interpreter, and then consumed by xnnpack, possibly via a TFLite kernel.
@@ -16,9 +16,12 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_KERNELS_CPU_BACKEND_GEMM_H_
 #define TENSORFLOW_LITE_KERNELS_CPU_BACKEND_GEMM_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 
 #include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/invocation_interrupt.h"
 #include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/cpu_backend_gemm_custom_gemv.h"
 #include "tflite/kernels/cpu_backend_gemm_params.h"
@@ -112,6 +115,47 @@ struct GemmImpl<float, float, float, float, QuantizationFlavor::kFloatingPoint>
 
 #endif  // not TFLITE_WITH_RUY and TFLITE_X86_PLATFORM
 
+/* Interruptible GEMM */
+
+namespace detail {
+
+// Multiply-accumulates per chunk when a GEMM is split so that an interrupted
+// invocation can stop part way through it. Large enough that the per call
+// overhead, including packing an uncached LHS again, stays in the noise.
+constexpr std::int64_t kInterruptibleGemmChunkMacs = std::int64_t{1} << 24;
+
+// Returns the number of destination columns per chunk if the GEMM should be
+// split into interruptible chunks, or 0 if it should run in one call.
+template <typename LhsScalar, typename RhsScalar, typename DstScalar>
+int InterruptibleGemmChunkCols(const MatrixParams<LhsScalar>& lhs_params,
+                               const MatrixParams<RhsScalar>& rhs_params,
+                               const MatrixParams<DstScalar>& dst_params,
+                               const CpuBackendContext* context) {
+  const InvocationInterrupt* interrupt = context->interrupt();
+  if (interrupt == nullptr || !interrupt->Interruptible()) {
+    return 0;
+  }
+  // Column chunks of column-major matrices are contiguous, and the
+  // quantization parameters are per row, so each chunk is a plain GEMM.
+  if (rhs_params.order != Order::kColMajor ||
+      dst_params.order != Order::kColMajor) {
+    return 0;
+  }
+  const std::int64_t macs_per_col =
+      static_cast<std::int64_t>(lhs_params.rows) * lhs_params.cols;
+  if (macs_per_col == 0) {
+    return 0;
+  }
+  const std::int64_t chunk_cols =
+      std::max<std::int64_t>(1, kInterruptibleGemmChunkMacs / macs_per_col);
+  if (dst_params.cols < 2 * chunk_cols) {
+    return 0;
+  }
+  return static_cast<int>(chunk_cols);
+}
+
+}  // namespace detail
+
 /* Public entry point */
 
 template <typename LhsScalar, typename RhsScalar, typename AccumScalar,
@@ -130,6 +174,30 @@ void Gemm(const MatrixParams<LhsScalar>& lhs_params, const LhsScalar* lhs_data,
     TFLITE_DCHECK(false);
     return;
   }
+  // When the invocation may be cancelled or has a deadline, large GEMMs run in
+  // chunks of destination columns and stop between chunks once the invocation
+  // should. The remaining columns are left unwritten and marked incomplete so
+  // that the subgraph reports the invocation as stopped.
+  if (const int chunk_cols = detail::InterruptibleGemmChunkCols(
+          lhs_params, rhs_params, dst_params, context)) {
+    InvocationInterrupt* interrupt = context->interrupt();
+    for (int col = 0; col < dst_params.cols; col += chunk_cols) {
+      if (interrupt->ShouldStop()) {
+        interrupt->MarkIncomplete();
+        return;
+      }
+      MatrixParams<RhsScalar> rhs_chunk_params = rhs_params;
+      MatrixParams<DstScalar> dst_chunk_params = dst_params;
+      rhs_chunk_params.cols = std::min(chunk_cols, dst_params.cols - col);
+      dst_chunk_params.cols = rhs_chunk_params.cols;
+      Gemm(lhs_params, lhs_data, rhs_chunk_params,
+           rhs_data + static_cast<std::ptrdiff_t>(col) * rhs_params.rows,
+           dst_chunk_params,
+           dst_data + static_cast<std::ptrdiff_t>(col) * dst_params.rows,
+           params, context);
+    }
+    return;
+  }
   // In some cases we want to unconditionally use ruy as the backend, overriding
   // the `tflite_with_ruy` setting and the platform default.
   bool must_use_ruy = false;
@@ -20,11 +20,13 @@ limitations under the License.
 #include <stdlib.h>
 
 #include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
 #include <iterator>
 #include <limits>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -35,6 +37,7 @@ limitations under the License.
 #include "tflite/kernels/cpu_backend_context.h"
 #include "tflite/kernels/cpu_backend_gemm_params.h"
 #include "tflite/kernels/cpu_backend_gemm_ruy.h"
+#include "tflite/invocation_interrupt.h"
 
 namespace tflite {
 
@@ -750,6 +753,95 @@ TYPED_TEST(CpuBackendGemmTest, OuterProduct) {
   TestRandomGemms<TypeParam>(shapes);
 }
 
+// A float GEMM of `rows` x `depth` by `depth` x `cols` with small integer
+// values, so that results are exact regardless of how the work is split.
+struct InterruptibleGemm {
+  InterruptibleGemm(int rows, int depth, int cols)
+      : lhs(rows * depth), rhs(depth * cols), dst(rows * cols, -1.0f) {
+    lhs_params.order = cpu_backend_gemm::Order::kRowMajor;
+    lhs_params.rows = rows;
+    lhs_params.cols = depth;
+    rhs_params.order = cpu_backend_gemm::Order::kColMajor;
+    rhs_params.rows = depth;
+    rhs_params.cols = cols;
+    dst_params.order = cpu_backend_gemm::Order::kColMajor;
+    dst_params.rows = rows;
+    dst_params.cols = cols;
+    for (int i = 0; i < lhs.size(); ++i) lhs[i] = i % 7 - 3;
+    for (int i = 0; i < rhs.size(); ++i) rhs[i] = i % 5 - 2;
+  }
+
+  void Run(CpuBackendContext* context) {
+    Gemm(lhs_params, lhs.data(), rhs_params, rhs.data(), dst_params,
+         dst.data(), GemmParams<float, float>(), context);
+  }
+
+  MatrixParams<float> lhs_params;
+  MatrixParams<float> rhs_params;
+  MatrixParams<float> dst_params;
+  std::vector<float> lhs;
+  std::vector<float> rhs;
+  std::vector<float> dst;
+};
+
+TEST(CpuBackendGemmInterruptTest, ChunkedResultIsUnchanged) {
+  InterruptibleGemm expected(64, 256, 4096);
+  CpuBackendContext context;
+  expected.Run(&context);
+
+  InterruptibleGemm actual(64, 256, 4096);
+  InvocationInterrupt interrupt;
+  interrupt.EnableCancellation();
+  context.set_interrupt(&interrupt);
+  // 64 * 256 multiply-accumulates per column, split into 4 chunks.
+  EXPECT_EQ(cpu_backend_gemm::detail::InterruptibleGemmChunkCols(
+                actual.lhs_params, actual.rhs_params, actual.dst_params,
+                &context),
+            1024);
+  actual.Run(&context);
+  EXPECT_FALSE(interrupt.Incomplete());
+  EXPECT_EQ(actual.dst, expected.dst);
+}
+
+TEST(CpuBackendGemmInterruptTest, CancelledBeforeGemm) {
+  InterruptibleGemm gemm(64, 256, 4096);
+  CpuBackendContext context;
+  InvocationInterrupt interrupt;
+  interrupt.EnableCancellation();
+  interrupt.Cancel();
+  context.set_interrupt(&interrupt);
+  gemm.Run(&context);
+  EXPECT_TRUE(interrupt.Incomplete());
+  EXPECT_EQ(gemm.dst, std::vector<float>(gemm.dst.size(), -1.0f));
+}
+
+TEST(CpuBackendGemmInterruptTest, CancelDuringGemm) {
+  // 128 chunks of 64 columns, far more work than it takes to start a thread.
+  InterruptibleGemm gemm(512, 512, 8192);
+  CpuBackendContext context;
+  InvocationInterrupt interrupt;
+  interrupt.EnableCancellation();
+  context.set_interrupt(&interrupt);
+  std::thread canceller([&interrupt]() { interrupt.Cancel(); });
+  gemm.Run(&context);
+  canceller.join();
+  EXPECT_TRUE(interrupt.Incomplete());
+  // The last chunk is never written.
+  EXPECT_EQ(gemm.dst.back(), -1.0f);
+}
+
+TEST(CpuBackendGemmInterruptTest, DeadlineDuringGemm) {
+  InterruptibleGemm gemm(512, 512, 8192);
+  CpuBackendContext context;
+  InvocationInterrupt interrupt;
+  interrupt.SetDeadline(InvocationInterrupt::Clock::now() +
+                        std::chrono::milliseconds(1));
+  context.set_interrupt(&interrupt);
+  gemm.Run(&context);
+  EXPECT_TRUE(interrupt.Incomplete());
+  EXPECT_EQ(gemm.dst.back(), -1.0f);
+}
+
 }  // namespace
 
 }  // namespace tflite
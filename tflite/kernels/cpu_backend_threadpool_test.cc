@@ -15,10 +15,13 @@ limitations under the License.
 
 #include "tflite/kernels/cpu_backend_threadpool.h"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 #include <gtest/gtest.h>
 #include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/memory_placement.h"
 
 namespace tflite {
 
@@ -89,6 +92,58 @@ TEST(CpuBackendThreadpoolTest, TenThreadsSize1234567) {
   TestGenerateArrayOfIncrementingInts(10, 1234567);
 }
 
+#if defined(__linux__)
+
+// Records the CPUs the thread running it may run on.
+class RecordCpusTask : public cpu_backend_threadpool::Task {
+ public:
+  void Run() override { cpus = CurrentThreadCpus(); }
+
+  std::vector<int> cpus;
+};
+
+TEST(CpuBackendThreadpoolTest, PinsWorkersButNotTheCaller) {
+  const int node = CurrentNumaNode();
+  const std::vector<int> node_cpus = NumaNodeCpus(node);
+  const std::vector<int> caller_cpus = CurrentThreadCpus();
+  // Pinned threads only get the node's CPUs they are allowed to run on.
+  std::vector<int> pinned_cpus;
+  std::set_intersection(node_cpus.begin(), node_cpus.end(),
+                        caller_cpus.begin(), caller_cpus.end(),
+                        std::back_inserter(pinned_cpus));
+  if (pinned_cpus.size() < 2) {
+    GTEST_SKIP() << "Needs a NUMA node with several usable CPUs.";
+  }
+  // Narrow the caller down to one CPU, which the workers it creates inherit
+  // unless they are pinned.
+  const std::vector<int> narrowed_cpus = {pinned_cpus.front()};
+  ASSERT_TRUE(SetCurrentThreadCpus(narrowed_cpus));
+
+  constexpr int kNumThreads = 3;
+  CpuBackendContext context;
+  context.SetMaxNumThreads(kNumThreads);
+  context.SetWorkerNumaNode(node);
+  std::vector<RecordCpusTask> tasks(kNumThreads);
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(), &context);
+
+  // One task runs on the caller, the others on pinned workers.
+  EXPECT_EQ(std::count_if(tasks.begin(), tasks.end(),
+                          [&](const RecordCpusTask& task) {
+                            return task.cpus == narrowed_cpus;
+                          }),
+            1);
+  EXPECT_EQ(std::count_if(tasks.begin(), tasks.end(),
+                          [&](const RecordCpusTask& task) {
+                            return task.cpus == pinned_cpus;
+                          }),
+            kNumThreads - 1);
+  EXPECT_EQ(CurrentThreadCpus(), narrowed_cpus);
+
+  ASSERT_TRUE(SetCurrentThreadCpus(caller_cpus));
+}
+
+#endif  // __linux__
+
 }  // namespace
 
 }  // namespace tflite
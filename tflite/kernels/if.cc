@@ -152,7 +152,6 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
                           Subgraph* active_branch_subgraph) {
   Subgraph* this_subgraph = reinterpret_cast<Subgraph*>(context->impl_);
 
-  TF_LITE_ENSURE_OK(context, active_branch_subgraph->AllocateTensors());
   const int num_inputs = node->inputs->size - 1;
   const int num_outputs = node->outputs->size;
   const int* const start = node->inputs->data + 1;
@@ -171,10 +170,10 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
 
   // subgraph->outputs -> node->outputs
   TF_LITE_ENSURE_OK(context,
-                    DeepCopyTensorsShapeTypeData(
+                    MoveOrDeepCopyTensorsShapeTypeData(
                         context, node, active_branch_subgraph,
                         active_branch_subgraph->outputs(), this_subgraph,
-                        TfLiteIntArrayView(node->outputs), true));
+                        TfLiteIntArrayView(node->outputs)));
 
   for (int i = 0; i < num_outputs; ++i) {
     const int input_pos = OutputIsInput(active_branch_subgraph->outputs()[i],
@@ -203,8 +202,13 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node,
     if (output_idx == kTfLiteOptionalTensor) continue;
     TfLiteTensor* subgraph_output = active_branch_subgraph->tensor(output_idx);
     if (!IsResourceOrVariant(subgraph_output) &&
-        !IsConstantTensor(subgraph_output)) {
+        !IsConstantTensor(subgraph_output) &&
+        subgraph_output->allocation_type != kTfLiteCustom) {
       subgraph_output->allocation_type = kTfLiteCustom;
+      // The output was planned in the arena, make sure the subgraph gets
+      // planned again.
+      TF_LITE_ENSURE_OK(context,
+                        active_branch_subgraph->ReleaseNonPersistentMemory());
     }
   }
   // node->inputs -> subgraph->inputs
@@ -278,7 +282,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                       Eval_static(context, node, active_branch_subgraph));
   }
 
-  if (!this_subgraph->ShouldPreserveAllTensors()) {
+  if (!this_subgraph->ShouldPreserveAllTensors() &&
+      !this_subgraph->ShouldKeepControlFlowSubgraphsResident()) {
     TF_LITE_ENSURE_OK(context, active_branch_subgraph->ReleaseMemory());
   }
 
@@ -122,6 +122,52 @@ TEST_F(SimpleIfTest, TestIfFalseWithLargeInputsTwice) {
   CheckIntTensor(output, {kNumLargeTensors}, expected2);
 }
 
+TEST_F(SimpleIfTest, TestKeepSubgraphsResident) {
+  InterpreterOptions options;
+  options.SetKeepControlFlowSubgraphsResident(true);
+  ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+  Subgraph* then_subgraph = interpreter_->subgraph(1);
+  Subgraph* else_subgraph = interpreter_->subgraph(2);
+
+  interpreter_->typed_input_tensor<bool>(0)[0] = true;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  TfLiteTensor* output = interpreter_->tensor(interpreter_->outputs()[0]);
+  CheckIntTensor(output, {1, 2}, {6, 9});
+  // The branch stays allocated, with its inputs aliasing the IF op inputs.
+  EXPECT_TRUE(then_subgraph->IsInvokable());
+  EXPECT_EQ(then_subgraph->tensor(then_subgraph->inputs()[1])->data.raw,
+            interpreter_->tensor(interpreter_->inputs()[2])->data.raw);
+
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[2]), {3, 4});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {1, 2}, {8, 11});
+  interpreter_->typed_input_tensor<bool>(0)[0] = false;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {1, 2}, {15, 28});
+  EXPECT_TRUE(then_subgraph->IsInvokable());
+  EXPECT_TRUE(else_subgraph->IsInvokable());
+
+  // Different input shapes require the branches to be planned again.
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {3});
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[2], {1});
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[1]), {1, 2, 3});
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[2]), {2});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  output = interpreter_->tensor(interpreter_->outputs()[0]);
+  CheckIntTensor(output, {3}, {2, 4, 6});
+  interpreter_->typed_input_tensor<bool>(0)[0] = true;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {3}, {3, 4, 5});
+
+  // By default, the memory of the branches is released after each use.
+  options.SetKeepControlFlowSubgraphsResident(false);
+  ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {3}, {3, 4, 5});
+  EXPECT_FALSE(then_subgraph->IsInvokable());
+}
+
 // Test IF op using subgraphs with dynamically sized outputs.
 // The computation is: `cond ? a + b : pad(a, b)`.
 class DynamicSubgraphIfTest : public ControlFlowOpTest {
@@ -161,6 +207,33 @@ TEST_F(DynamicSubgraphIfTest, TestIfFalse) {
   CheckIntTensor(output, {5}, {0, 5, 7, 0, 0});
 }
 
+TEST_F(DynamicSubgraphIfTest, TestDynamicOutputBuffersAreHandedOver) {
+  InterpreterOptions options;
+  options.SetKeepControlFlowSubgraphsResident(true);
+  ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+  interpreter_->typed_input_tensor<bool>(0)[0] = false;
+
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  TfLiteTensor* output = interpreter_->tensor(interpreter_->outputs()[0]);
+  CheckIntTensor(output, {5}, {0, 5, 7, 0, 0});
+  const void* first_buffer = output->data.raw;
+
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[1]), {6, 8});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {5}, {0, 6, 8, 0, 0});
+  EXPECT_NE(output->data.raw, first_buffer);
+
+  // The output and the branch swap buffers instead of copying.
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[1]), {1, 3});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {5}, {0, 1, 3, 0, 0});
+  EXPECT_EQ(output->data.raw, first_buffer);
+
+  interpreter_->typed_input_tensor<bool>(0)[0] = true;
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(output, {1, 2}, {2, 5});
+}
+
 class IfTest : public ControlFlowOpTest {};
 
 TEST_F(IfTest, TestWithXNNPACK) {
@@ -0,0 +1,505 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_CONV3D_MULTITHREAD_H_
+#define TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_CONV3D_MULTITHREAD_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"  // from @eigen_archive
+#include "ruy/profiler/instrumentation.h"  // from @ruy
+#include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
+#include "tflite/kernels/internal/compatibility.h"
+#include "tflite/kernels/internal/runtime_shape.h"
+#include "tflite/kernels/internal/types.h"
+
+// Float 3D convolution and transposed convolution without an im2col buffer.
+//
+// The output is split into rows, one row being all output pixels sharing the
+// same (batch, depth, height) coordinates, and contiguous ranges of rows are
+// computed by separate tasks of the CpuBackendContext thread pool.
+//
+// Within a row, output pixels are processed in tiles of kPixelTile pixels.
+// For each tile an indirection buffer holds, per filter tap, a pointer to the
+// input channels each pixel reads from, or to a zero buffer for padding. A
+// register-blocked micro kernel then accumulates kPixelTile x kChannelTile
+// outputs at a time over all taps and input channels, reading the filter in
+// its native [taps, input_depth, output_depth] layout. This is equivalent to
+// a GEMM against the im2col matrix, without ever materializing it.
+namespace tflite {
+namespace optimized_ops {
+namespace conv3d_multithread {
+
+// Output pixels and output channels computed together by the micro kernel.
+// The accumulators take kPixelTile * kChannelTile floats, which should fill
+// about half of the SIMD register file.
+constexpr int kPixelTile = 8;
+#if defined(__AVX__)
+constexpr int kChannelTile = 16;
+#else
+constexpr int kChannelTile = 8;
+#endif
+
+// How many scalar multiplications are needed to make it worth using one more
+// thread.
+constexpr int64_t kMinMulPerThread = 1 << 16;
+
+// Indirection buffer for one output row, split into tiles of kPixelTile
+// pixels. The taps of tile j are [tap_begin[j], tap_begin[j + 1]).
+// `inputs[t * kPixelTile + p]` points to the input channels read by pixel p
+// for tap t, `filters[t]` to the [input_depth, output_depth] filter slice of
+// tap t. `outputs[j * kPixelTile + p]` is the output of pixel p of tile j, or
+// nullptr past the end of the row.
+struct RowTaps {
+  std::vector<const float*> inputs;
+  std::vector<const float*> filters;
+  std::vector<int> tap_begin;
+  std::vector<float*> outputs;
+
+  void Clear() {
+    inputs.clear();
+    filters.clear();
+    tap_begin.assign(1, 0);
+    outputs.clear();
+  }
+  int num_tiles() const { return static_cast<int>(tap_begin.size()) - 1; }
+};
+
+// Computes kChannelTile output channels, starting at `channel`, of the
+// kPixelTile pixels of tile `tile`. The accumulators are fixed-size Eigen
+// arrays so that they stay in SIMD registers.
+inline void ComputeFullTile(const RowTaps& taps, int tile, int input_depth,
+                            int output_depth, int channel,
+                            const float* bias_data, float activation_min,
+                            float activation_max) {
+  using Channels = Eigen::Array<float, kChannelTile, 1>;
+  using ConstChannelsMap = Eigen::Map<const Channels, Eigen::Unaligned>;
+  Channels acc[kPixelTile];
+  for (int p = 0; p < kPixelTile; ++p) {
+    if (bias_data) {
+      acc[p] = ConstChannelsMap(bias_data + channel);
+    } else {
+      acc[p].setZero();
+    }
+  }
+  for (int t = taps.tap_begin[tile]; t < taps.tap_begin[tile + 1]; ++t) {
+    const float* const* in = &taps.inputs[t * kPixelTile];
+    const float* filter = taps.filters[t] + channel;
+    for (int i = 0; i < input_depth; ++i) {
+      const Channels f = ConstChannelsMap(filter);
+      for (int p = 0; p < kPixelTile; ++p) acc[p] += in[p][i] * f;
+      filter += output_depth;
+    }
+  }
+  for (int p = 0; p < kPixelTile; ++p) {
+    float* out = taps.outputs[tile * kPixelTile + p];
+    if (out == nullptr) break;
+    Eigen::Map<Channels, Eigen::Unaligned>(out + channel) =
+        acc[p].max(activation_min).min(activation_max);
+  }
+}
+
+// Same as ComputeFullTile for the last `num_channels` < kChannelTile output
+// channels.
+inline void ComputePartialTile(const RowTaps& taps, int tile, int input_depth,
+                               int output_depth, int channel, int num_channels,
+                               const float* bias_data, float activation_min,
+                               float activation_max) {
+  float acc[kPixelTile][kChannelTile];
+  for (int p = 0; p < kPixelTile; ++p) {
+    for (int c = 0; c < num_channels; ++c) {
+      acc[p][c] = bias_data ? bias_data[channel + c] : 0.0f;
+    }
+  }
+  for (int t = taps.tap_begin[tile]; t < taps.tap_begin[tile + 1]; ++t) {
+    const float* const* in = &taps.inputs[t * kPixelTile];
+    const float* filter = taps.filters[t] + channel;
+    for (int i = 0; i < input_depth; ++i) {
+      for (int p = 0; p < kPixelTile; ++p) {
+        const float value = in[p][i];
+        for (int c = 0; c < num_channels; ++c) {
+          acc[p][c] += value * filter[c];
+        }
+      }
+      filter += output_depth;
+    }
+  }
+  for (int p = 0; p < kPixelTile; ++p) {
+    float* out = taps.outputs[tile * kPixelTile + p];
+    if (out == nullptr) break;
+    for (int c = 0; c < num_channels; ++c) {
+      out[channel + c] =
+          std::min(std::max(acc[p][c], activation_min), activation_max);
+    }
+  }
+}
+
+// Maps an output coordinate to the input coordinate read by filter offset
+// `k`. Returns -1 if the filter offset falls into padding, or, for
+// transposed convolutions, in between strided input positions.
+inline int ConvInputIndex(int out, int k, int stride, int dilation, int pad,
+                          int input_size) {
+  const int in = out * stride - pad + k * dilation;
+  return in >= 0 && in < input_size ? in : -1;
+}
+
+inline int TransposeConvInputIndex(int out, int k, int stride, int dilation,
+                                   int pad, int input_size) {
+  const int offset = out + pad - k * dilation;
+  if (offset < 0 || offset % stride != 0) return -1;
+  const int in = offset / stride;
+  return in < input_size ? in : -1;
+}
+
+struct Conv3DGeometry {
+  int batches;
+  int input_depth, input_height, input_width, input_channels;
+  int output_depth, output_height, output_width, output_channels;
+  int filter_depth, filter_height, filter_width;
+  int stride_depth, stride_height, stride_width;
+  int dilation_depth, dilation_height, dilation_width;
+  int pad_depth, pad_height, pad_width;
+  // True for transposed convolutions.
+  bool transposed;
+
+  int InputIndex(int out, int k, int stride, int dilation, int pad,
+                 int input_size) const {
+    return transposed
+               ? TransposeConvInputIndex(out, k, stride, dilation, pad,
+                                         input_size)
+               : ConvInputIndex(out, k, stride, dilation, pad, input_size);
+  }
+
+  int64_t NumRows() const {
+    return static_cast<int64_t>(batches) * output_depth * output_height;
+  }
+};
+
+// Fills `taps` with the indirection buffer of output row `row`. `zeros` must
+// hold input_channels zeros.
+inline void BuildRowTaps(const Conv3DGeometry& g, const float* input_data,
+                         const float* filter_data, const float* zeros,
+                         float* output_data, int row,
+                         std::vector<std::pair<const float*, const float*>>*
+                             plane_taps,
+                         RowTaps* taps) {
+  const int out_y = row % g.output_height;
+  const int out_d = (row / g.output_height) % g.output_depth;
+  const int batch = row / (g.output_height * g.output_depth);
+  const int tap_size = g.input_channels * g.output_channels;
+  float* output_row =
+      output_data +
+      static_cast<int64_t>(row) * g.output_width * g.output_channels;
+
+  // Pointers to the first input pixel of the valid (depth, height) planes
+  // and to the matching filter slices.
+  plane_taps->clear();
+  for (int kd = 0; kd < g.filter_depth; ++kd) {
+    const int in_d = g.InputIndex(out_d, kd, g.stride_depth, g.dilation_depth,
+                                  g.pad_depth, g.input_depth);
+    if (in_d < 0) continue;
+    for (int ky = 0; ky < g.filter_height; ++ky) {
+      const int in_y = g.InputIndex(out_y, ky, g.stride_height,
+                                    g.dilation_height, g.pad_height,
+                                    g.input_height);
+      if (in_y < 0) continue;
+      const int64_t input_offset =
+          ((static_cast<int64_t>(batch) * g.input_depth + in_d) *
+               g.input_height +
+           in_y) *
+          g.input_width * g.input_channels;
+      const int64_t filter_offset =
+          static_cast<int64_t>(kd * g.filter_height + ky) * g.filter_width *
+          tap_size;
+      plane_taps->emplace_back(input_data + input_offset,
+                               filter_data + filter_offset);
+    }
+  }
+
+  // Transposed convolutions only read every stride-th filter offset along the
+  // width for a given output pixel. Pixels are grouped by phase so that all
+  // pixels of a tile share the same taps.
+  const int pixel_step = g.transposed ? g.stride_width : 1;
+  int pixels[kPixelTile];
+  const float* pixel_inputs[kPixelTile];
+  taps->Clear();
+  for (int phase = 0; phase < pixel_step; ++phase) {
+    for (int first = phase; first < g.output_width;
+         first += kPixelTile * pixel_step) {
+      for (int p = 0; p < kPixelTile; ++p) {
+        const int out_x = first + p * pixel_step;
+        pixels[p] = out_x < g.output_width ? out_x : -1;
+        taps->outputs.push_back(
+            pixels[p] < 0
+                ? nullptr
+                : output_row + static_cast<int64_t>(out_x) * g.output_channels);
+      }
+      for (const auto& plane : *plane_taps) {
+        for (int kx = 0; kx < g.filter_width; ++kx) {
+          bool any_valid = false;
+          for (int p = 0; p < kPixelTile; ++p) {
+            const int in_x =
+                pixels[p] < 0 ? -1
+                              : g.InputIndex(pixels[p], kx, g.stride_width,
+                                             g.dilation_width, g.pad_width,
+                                             g.input_width);
+            pixel_inputs[p] =
+                in_x < 0 ? zeros
+                         : plane.first +
+                               static_cast<int64_t>(in_x) * g.input_channels;
+            any_valid |= in_x >= 0;
+          }
+          if (!any_valid) continue;
+          taps->inputs.insert(taps->inputs.end(), pixel_inputs,
+                              pixel_inputs + kPixelTile);
+          taps->filters.push_back(plane.second +
+                                  static_cast<int64_t>(kx) * tap_size);
+        }
+      }
+      taps->tap_begin.push_back(taps->filters.size());
+    }
+  }
+}
+
+// Computes output rows [row_start, row_end). `filter_data` must be in
+// [filter_depth, filter_height, filter_width, input_channels,
+// output_channels] layout.
+inline void Conv3DRows(const Conv3DGeometry& g, const float* input_data,
+                       const float* filter_data, const float* bias_data,
+                       float activation_min, float activation_max,
+                       float* output_data, int row_start, int row_end) {
+  const std::vector<float> zeros(g.input_channels, 0.0f);
+  std::vector<std::pair<const float*, const float*>> plane_taps;
+  RowTaps taps;
+  for (int row = row_start; row < row_end; ++row) {
+    BuildRowTaps(g, input_data, filter_data, zeros.data(), output_data, row,
+                 &plane_taps, &taps);
+    // Output channels are the outer loop so that the filter slice of a
+    // channel block stays in cache while the whole row is computed.
+    int channel = 0;
+    for (; channel + kChannelTile <= g.output_channels;
+         channel += kChannelTile) {
+      for (int tile = 0; tile < taps.num_tiles(); ++tile) {
+        ComputeFullTile(taps, tile, g.input_channels, g.output_channels,
+                        channel, bias_data, activation_min, activation_max);
+      }
+    }
+    if (channel < g.output_channels) {
+      for (int tile = 0; tile < taps.num_tiles(); ++tile) {
+        ComputePartialTile(taps, tile, g.input_channels, g.output_channels,
+                           channel, g.output_channels - channel, bias_data,
+                           activation_min, activation_max);
+      }
+    }
+  }
+}
+
+struct Conv3DWorkerTask : cpu_backend_threadpool::Task {
+  Conv3DWorkerTask(const Conv3DGeometry& geometry, const float* input_data,
+                   const float* filter_data, const float* bias_data,
+                   float activation_min, float activation_max,
+                   float* output_data, int row_start, int row_end)
+      : geometry_(geometry),
+        input_data_(input_data),
+        filter_data_(filter_data),
+        bias_data_(bias_data),
+        activation_min_(activation_min),
+        activation_max_(activation_max),
+        output_data_(output_data),
+        row_start_(row_start),
+        row_end_(row_end) {}
+
+  void Run() override {
+    Conv3DRows(geometry_, input_data_, filter_data_, bias_data_,
+               activation_min_, activation_max_, output_data_, row_start_,
+               row_end_);
+  }
+
+ private:
+  const Conv3DGeometry& geometry_;
+  const float* input_data_;
+  const float* filter_data_;
+  const float* bias_data_;
+  float activation_min_;
+  float activation_max_;
+  float* output_data_;
+  int row_start_;
+  int row_end_;
+};
+
+inline int HowManyConv3DThreads(const Conv3DGeometry& g,
+                                int max_num_threads) {
+  const int64_t num_muls =
+      g.NumRows() * g.output_width * g.output_channels * g.input_channels *
+      g.filter_depth * g.filter_height * g.filter_width;
+  const int64_t thread_count =
+      std::min<int64_t>(num_muls / kMinMulPerThread, g.NumRows());
+  return static_cast<int>(
+      std::max<int64_t>(1, std::min<int64_t>(thread_count, max_num_threads)));
+}
+
+inline void Run(const Conv3DGeometry& g, const float* input_data,
+                const float* filter_data, const float* bias_data,
+                float activation_min, float activation_max,
+                float* output_data, CpuBackendContext* cpu_backend_context) {
+  const int num_rows = static_cast<int>(g.NumRows());
+  const int thread_count =
+      HowManyConv3DThreads(g, cpu_backend_context->max_num_threads());
+  if (thread_count == 1) {
+    Conv3DRows(g, input_data, filter_data, bias_data, activation_min,
+               activation_max, output_data, 0, num_rows);
+    return;
+  }
+
+  std::vector<Conv3DWorkerTask> tasks;
+  tasks.reserve(thread_count);
+  int row_start = 0;
+  for (int i = 0; i < thread_count; ++i) {
+    const int row_end =
+        row_start + (num_rows - row_start) / (thread_count - i);
+    tasks.emplace_back(g, input_data, filter_data, bias_data, activation_min,
+                       activation_max, output_data, row_start, row_end);
+    row_start = row_end;
+  }
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(),
+                                  cpu_backend_context);
+}
+
+}  // namespace conv3d_multithread
+
+// Multithreaded float Conv3D that doesn't need an im2col buffer. Supports
+// any stride and dilation.
+inline void Conv3DMultithread(const Conv3DParams& params,
+                              const RuntimeShape& input_shape,
+                              const float* input_data,
+                              const RuntimeShape& filter_shape,
+                              const float* filter_data,
+                              const RuntimeShape& bias_shape,
+                              const float* bias_data,
+                              const RuntimeShape& output_shape,
+                              float* output_data,
+                              CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("Conv3D/Multithread");
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 5);
+
+  conv3d_multithread::Conv3DGeometry g;
+  g.batches = MatchingDim(input_shape, 0, output_shape, 0);
+  g.input_depth = input_shape.Dims(1);
+  g.input_height = input_shape.Dims(2);
+  g.input_width = input_shape.Dims(3);
+  g.input_channels = MatchingDim(input_shape, 4, filter_shape, 3);
+  g.output_depth = output_shape.Dims(1);
+  g.output_height = output_shape.Dims(2);
+  g.output_width = output_shape.Dims(3);
+  g.output_channels = MatchingDim(filter_shape, 4, output_shape, 4);
+  g.filter_depth = filter_shape.Dims(0);
+  g.filter_height = filter_shape.Dims(1);
+  g.filter_width = filter_shape.Dims(2);
+  g.stride_depth = params.stride_depth;
+  g.stride_height = params.stride_height;
+  g.stride_width = params.stride_width;
+  g.dilation_depth = params.dilation_depth;
+  g.dilation_height = params.dilation_height;
+  g.dilation_width = params.dilation_width;
+  g.pad_depth = params.padding_values.depth;
+  g.pad_height = params.padding_values.height;
+  g.pad_width = params.padding_values.width;
+  g.transposed = false;
+  conv3d_multithread::Run(g, input_data, filter_data, bias_data,
+                          params.float_activation_min,
+                          params.float_activation_max, output_data,
+                          cpu_backend_context);
+}
+
+// Stores a Conv3DTranspose filter, in the [depth, height, width,
+// output_channels, input_channels] layout of the op, as [depth, height, width,
+// input_channels, output_channels] for Conv3DTransposeMultithread.
+// `transposed_filter_data` must have room for the same number of elements.
+inline void TransposeConv3DTransposeFilter(const RuntimeShape& filter_shape,
+                                           const float* filter_data,
+                                           float* transposed_filter_data) {
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 5);
+  const int num_taps =
+      filter_shape.Dims(0) * filter_shape.Dims(1) * filter_shape.Dims(2);
+  const int output_channels = filter_shape.Dims(3);
+  const int input_channels = filter_shape.Dims(4);
+  const int tap_size = input_channels * output_channels;
+  for (int t = 0; t < num_taps; ++t) {
+    const float* src = filter_data + static_cast<int64_t>(t) * tap_size;
+    float* dst = transposed_filter_data + static_cast<int64_t>(t) * tap_size;
+    for (int o = 0; o < output_channels; ++o) {
+      for (int i = 0; i < input_channels; ++i) {
+        dst[i * output_channels + o] = src[o * input_channels + i];
+      }
+    }
+  }
+}
+
+// Multithreaded float Conv3DTranspose that gathers the contributions of each
+// output pixel instead of scattering a col2im buffer. `filter_shape` is the
+// shape of the filter of the op, `transposed_filter_data` the filter as
+// transposed by TransposeConv3DTransposeFilter. Supports any stride and
+// dilation.
+inline void Conv3DTransposeMultithread(
+    const Conv3DTransposeParams& params, const RuntimeShape& input_shape,
+    const float* input_data, const RuntimeShape& filter_shape,
+    const float* transposed_filter_data, const RuntimeShape& bias_shape,
+    const float* bias_data, const RuntimeShape& output_shape,
+    float* output_data, CpuBackendContext* cpu_backend_context) {
+  ruy::profiler::ScopeLabel label("Conv3DTranspose/Multithread");
+  TFLITE_DCHECK_EQ(input_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(filter_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 5);
+  TFLITE_DCHECK(transposed_filter_data);
+
+  conv3d_multithread::Conv3DGeometry g;
+  g.batches = MatchingDim(input_shape, 0, output_shape, 0);
+  g.input_depth = input_shape.Dims(1);
+  g.input_height = input_shape.Dims(2);
+  g.input_width = input_shape.Dims(3);
+  g.input_channels = MatchingDim(input_shape, 4, filter_shape, 4);
+  g.output_depth = output_shape.Dims(1);
+  g.output_height = output_shape.Dims(2);
+  g.output_width = output_shape.Dims(3);
+  g.output_channels = MatchingDim(filter_shape, 3, output_shape, 4);
+  g.filter_depth = filter_shape.Dims(0);
+  g.filter_height = filter_shape.Dims(1);
+  g.filter_width = filter_shape.Dims(2);
+  g.stride_depth = params.stride_depth;
+  g.stride_height = params.stride_height;
+  g.stride_width = params.stride_width;
+  g.dilation_depth = params.dilation_depth;
+  g.dilation_height = params.dilation_height;
+  g.dilation_width = params.dilation_width;
+  g.pad_depth = params.padding_values.depth;
+  g.pad_height = params.padding_values.height;
+  g.pad_width = params.padding_values.width;
+  g.transposed = true;
+
+  conv3d_multithread::Run(g, input_data, transposed_filter_data, bias_data,
+                          params.float_activation_min,
+                          params.float_activation_max, output_data,
+                          cpu_backend_context);
+}
+
+}  // namespace optimized_ops
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_CONV3D_MULTITHREAD_H_
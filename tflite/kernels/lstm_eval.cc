@@ -19,6 +19,7 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -29,6 +30,7 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/kernels/cpu_backend_threadpool.h"
 #include "tflite/kernels/internal/compatibility.h"
 #include "tflite/kernels/internal/kernel_utils.h"
 #include "tflite/kernels/internal/optimized/optimized_ops.h"
@@ -1984,6 +1986,381 @@ TfLiteStatus EvalFloat(
 }
 // LINT.ThenChange(//tflite/tools/optimize/calibration/builtin_logging_ops/lstm.cc)
 
+namespace {
+
+// Dimensions of a fused float LSTM direction.
+struct FusedLstmShape {
+  int max_time;
+  int n_batch;
+  int n_input;
+  int n_aux_input;
+  int n_cell;
+  int n_output;
+  int n_gates;
+  int output_batch_leading_dim;
+};
+
+FusedLstmShape GetFusedLstmShape(const FloatLstmDirection& d,
+                                 bool time_major) {
+  FusedLstmShape shape;
+  const TfLiteIntArray* dims = d.input->dims;
+  if (dims->size == 3) {
+    shape.max_time = time_major ? dims->data[0] : dims->data[1];
+    shape.n_batch = time_major ? dims->data[1] : dims->data[0];
+  } else {
+    shape.max_time = 1;
+    shape.n_batch = dims->data[0];
+  }
+  shape.n_input = dims->data[dims->size - 1];
+  shape.n_aux_input =
+      d.aux_input ? d.aux_input->dims->data[d.aux_input->dims->size - 1] : 0;
+  shape.n_cell = d.input_to_output_weights->dims->data[0];
+  shape.n_output = d.recurrent_to_output_weights->dims->data[1];
+  shape.n_gates = d.input_to_input_weights == nullptr ? 3 : 4;
+  shape.output_batch_leading_dim =
+      d.output->dims->data[d.output->dims->size - 1];
+  return shape;
+}
+
+// The per gate tensors of `d`, in the order the gates are stacked.
+struct FusedGate {
+  const TfLiteTensor* input_weights;
+  const TfLiteTensor* aux_input_weights;
+  const TfLiteTensor* recurrent_weights;
+  const TfLiteTensor* bias;
+};
+
+int GetFusedGates(const FloatLstmDirection& d, FusedGate* gates) {
+  int n_gates = 0;
+  if (d.input_to_input_weights != nullptr) {
+    gates[n_gates++] = {d.input_to_input_weights, d.aux_input_to_input_weights,
+                        d.recurrent_to_input_weights, d.input_gate_bias};
+  }
+  gates[n_gates++] = {d.input_to_forget_weights, d.aux_input_to_forget_weights,
+                      d.recurrent_to_forget_weights, d.forget_gate_bias};
+  gates[n_gates++] = {d.input_to_cell_weights, d.aux_input_to_cell_weights,
+                      d.recurrent_to_cell_weights, d.cell_gate_bias};
+  gates[n_gates++] = {d.input_to_output_weights, d.aux_input_to_output_weights,
+                      d.recurrent_to_output_weights, d.output_gate_bias};
+  return n_gates;
+}
+
+bool AreFusedWeightsConstant(const FloatLstmDirection& d) {
+  FusedGate gates[4];
+  const int n_gates = GetFusedGates(d, gates);
+  for (int g = 0; g < n_gates; ++g) {
+    for (const TfLiteTensor* tensor :
+         {gates[g].input_weights, gates[g].aux_input_weights,
+          gates[g].recurrent_weights, gates[g].bias}) {
+      if (tensor != nullptr && tensor->allocation_type != kTfLiteMmapRo) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void PackFusedWeights(const FloatLstmDirection& d, const FusedLstmShape& shape,
+                      FusedFloatLstmBuffers* buffers) {
+  FusedGate gates[4];
+  const int n_gates = GetFusedGates(d, gates);
+  const int n_cell = shape.n_cell;
+  const int depth = shape.n_input + shape.n_aux_input;
+  buffers->input_weights.resize(n_gates * n_cell * depth);
+  buffers->recurrent_weights.resize(n_gates * n_cell * shape.n_output);
+  buffers->gate_bias.resize(n_gates * n_cell);
+  for (int g = 0; g < n_gates; ++g) {
+    const float* input_weights = GetTensorData<float>(gates[g].input_weights);
+    const float* aux_input_weights =
+        GetTensorData<float>(gates[g].aux_input_weights);
+    for (int row = 0; row < n_cell; ++row) {
+      float* packed =
+          buffers->input_weights.data() + (g * n_cell + row) * depth;
+      std::copy_n(input_weights + row * shape.n_input, shape.n_input, packed);
+      if (shape.n_aux_input > 0) {
+        std::copy_n(aux_input_weights + row * shape.n_aux_input,
+                    shape.n_aux_input, packed + shape.n_input);
+      }
+    }
+    const int recurrent_size = n_cell * shape.n_output;
+    std::copy_n(GetTensorData<float>(gates[g].recurrent_weights),
+                recurrent_size,
+                buffers->recurrent_weights.data() + g * recurrent_size);
+    std::copy_n(GetTensorData<float>(gates[g].bias), n_cell,
+                buffers->gate_bias.data() + g * n_cell);
+  }
+}
+
+// Computes result += matrix * vectors, on the thread pool of `context`, or on
+// the calling thread only if `context` is nullptr.
+void FusedMatMulAccumulate(const float* matrix, int m_rows, int m_cols,
+                           const float* vectors, int n_batch, float* result,
+                           float* scratch, CpuBackendContext* context) {
+  if (context == nullptr) {
+    tensor_utils::MatrixBatchVectorMultiplyAccumulate(matrix, m_rows, m_cols,
+                                                      vectors, n_batch, result);
+    return;
+  }
+  MatrixBatchVectorMultiplyAccumulate(matrix, vectors, result, scratch, m_rows,
+                                      m_cols, n_batch, context);
+  std::copy_n(scratch, m_rows * n_batch, result);
+}
+
+// Packs the weights if needed and computes the input contribution to the
+// gates of all time steps with a single matmul.
+void ProjectFusedLstmInputs(const FloatLstmDirection& d,
+                            const FusedLstmShape& shape,
+                            FusedFloatLstmBuffers* buffers,
+                            CpuBackendContext* context) {
+  ruy::profiler::ScopeLabel label("ProjectFusedLstmInputs");
+  const bool weights_constant = AreFusedWeightsConstant(d);
+  if (!buffers->weights_packed) {
+    PackFusedWeights(d, shape, buffers);
+    buffers->weights_packed = weights_constant;
+  }
+
+  const int n_rows = shape.max_time * shape.n_batch;
+  const int depth = shape.n_input + shape.n_aux_input;
+  const int gate_size = shape.n_gates * shape.n_cell;
+  const float* gemm_input = GetTensorData<float>(d.input);
+  if (shape.n_aux_input > 0) {
+    const float* aux_input = GetTensorData<float>(d.aux_input);
+    buffers->concat_input.resize(n_rows * depth);
+    for (int row = 0; row < n_rows; ++row) {
+      float* concat = buffers->concat_input.data() + row * depth;
+      std::copy_n(gemm_input + row * shape.n_input, shape.n_input, concat);
+      std::copy_n(aux_input + row * shape.n_aux_input, shape.n_aux_input,
+                  concat + shape.n_input);
+    }
+    gemm_input = buffers->concat_input.data();
+  }
+
+  // With layer norm, the bias is added after normalization.
+  const bool use_layer_norm = d.forget_layer_norm_coefficients != nullptr;
+  tflite::FullyConnectedParams fc_params;
+  fc_params.float_activation_min = std::numeric_limits<float>::lowest();
+  fc_params.float_activation_max = std::numeric_limits<float>::max();
+  // Weights that are repacked on every invocation must not be cached.
+  fc_params.lhs_cacheable = weights_constant;
+  fc_params.rhs_cacheable = false;
+  buffers->input_projection.resize(n_rows * gate_size);
+  optimized_ops::FullyConnected(
+      fc_params, RuntimeShape({n_rows, depth}), gemm_input,
+      RuntimeShape({gate_size, depth}), buffers->input_weights.data(),
+      RuntimeShape({gate_size}),
+      use_layer_norm ? nullptr : buffers->gate_bias.data(),
+      RuntimeShape({n_rows, gate_size}), buffers->input_projection.data(),
+      context);
+}
+
+// Adds the peephole connection, normalizes and activates one gate of one
+// batch.
+void FinishFusedGate(float* gate, int n_cell, const float* cell_state,
+                     const TfLiteTensor* cell_to_gate_weights,
+                     const TfLiteTensor* layer_norm_coefficients,
+                     const TfLiteTensor* bias,
+                     TfLiteFusedActivation activation) {
+  if (cell_to_gate_weights != nullptr) {
+    tensor_utils::VectorBatchVectorCwiseProductAccumulate(
+        GetTensorData<float>(cell_to_gate_weights), n_cell, cell_state,
+        /*n_batch=*/1, gate);
+  }
+  if (layer_norm_coefficients != nullptr) {
+    tensor_utils::MeanStddevNormalization(gate, gate, n_cell, /*n_batch=*/1);
+    tensor_utils::VectorBatchVectorCwiseProduct(
+        GetTensorData<float>(layer_norm_coefficients), n_cell, gate,
+        /*n_batch=*/1, gate);
+    tensor_utils::VectorBatchVectorAdd(GetTensorData<float>(bias), n_cell,
+                                       /*n_batch=*/1, gate);
+  }
+  tensor_utils::ApplyActivationToVector(gate, n_cell, activation, gate);
+}
+
+// Runs the recurrence over all time steps. `context` may be nullptr, see
+// FusedMatMulAccumulate.
+void RunFusedLstmRecurrence(const FloatLstmDirection& d,
+                            const TfLiteLSTMParams* params, bool time_major,
+                            const FusedLstmShape& shape,
+                            FusedFloatLstmBuffers* buffers,
+                            CpuBackendContext* context) {
+  ruy::profiler::ScopeLabel label("RunFusedLstmRecurrence");
+  const int n_batch = shape.n_batch;
+  const int n_cell = shape.n_cell;
+  const int n_output = shape.n_output;
+  const int gate_size = shape.n_gates * n_cell;
+  const bool use_cifg = shape.n_gates == 3;
+  const int forget_offset = use_cifg ? 0 : n_cell;
+  const int cell_offset = forget_offset + n_cell;
+  const int output_offset = cell_offset + n_cell;
+
+  buffers->gates.resize(n_batch * gate_size);
+  buffers->gates_scratch.resize(
+      n_batch * std::max(gate_size, d.projection_weights ? n_output : 0));
+  buffers->hidden.resize(n_batch * n_cell);
+  float* gates = buffers->gates.data();
+  float* hidden = buffers->hidden.data();
+  float* output_state = GetTensorData<float>(d.output_state);
+  float* cell_state = GetTensorData<float>(d.cell_state);
+  float* output = GetTensorData<float>(d.output);
+
+  for (int t = 0; t < shape.max_time; ++t) {
+    const int t_rel = d.forward_sequence ? t : shape.max_time - t - 1;
+    for (int b = 0; b < n_batch; ++b) {
+      const int row =
+          time_major ? t_rel * n_batch + b : b * shape.max_time + t_rel;
+      std::copy_n(buffers->input_projection.data() + row * gate_size,
+                  gate_size, gates + b * gate_size);
+    }
+    FusedMatMulAccumulate(buffers->recurrent_weights.data(), gate_size,
+                          n_output, output_state, n_batch, gates,
+                          buffers->gates_scratch.data(), context);
+
+    for (int b = 0; b < n_batch; ++b) {
+      float* batch_gates = gates + b * gate_size;
+      float* batch_cell_state = cell_state + b * n_cell;
+      float* input_gate = use_cifg ? nullptr : batch_gates;
+      float* forget_gate = batch_gates + forget_offset;
+      float* cell_gate = batch_gates + cell_offset;
+      float* output_gate = batch_gates + output_offset;
+      if (!use_cifg) {
+        FinishFusedGate(input_gate, n_cell, batch_cell_state,
+                        d.cell_to_input_weights,
+                        d.input_layer_norm_coefficients, d.input_gate_bias,
+                        kTfLiteActSigmoid);
+      }
+      FinishFusedGate(forget_gate, n_cell, batch_cell_state,
+                      d.cell_to_forget_weights,
+                      d.forget_layer_norm_coefficients, d.forget_gate_bias,
+                      kTfLiteActSigmoid);
+      FinishFusedGate(cell_gate, n_cell, batch_cell_state,
+                      /*cell_to_gate_weights=*/nullptr,
+                      d.cell_layer_norm_coefficients, d.cell_gate_bias,
+                      params->activation);
+      UpdateLstmCellFloat(/*n_batch=*/1, n_cell, batch_cell_state, input_gate,
+                          forget_gate, cell_gate, use_cifg, params->cell_clip);
+      FinishFusedGate(output_gate, n_cell, batch_cell_state,
+                      d.cell_to_output_weights,
+                      d.output_layer_norm_coefficients, d.output_gate_bias,
+                      kTfLiteActSigmoid);
+      float* batch_hidden = hidden + b * n_cell;
+      std::copy_n(batch_cell_state, n_cell, batch_hidden);
+      tensor_utils::ApplyActivationToVector(batch_hidden, n_cell,
+                                            params->activation, batch_hidden);
+      tensor_utils::VectorVectorCwiseProduct(output_gate, batch_hidden, n_cell,
+                                             batch_hidden);
+    }
+
+    if (d.projection_weights != nullptr) {
+      if (d.projection_bias != nullptr) {
+        tensor_utils::VectorBatchVectorAssign(
+            GetTensorData<float>(d.projection_bias), n_output, n_batch,
+            output_state);
+      } else {
+        std::fill_n(output_state, n_batch * n_output, 0.0f);
+      }
+      FusedMatMulAccumulate(GetTensorData<float>(d.projection_weights),
+                            n_output, n_cell, hidden, n_batch, output_state,
+                            buffers->gates_scratch.data(), context);
+      if (params->proj_clip > 0.0f) {
+        tensor_utils::CwiseClipping(output_state, n_batch * n_output,
+                                    params->proj_clip);
+      }
+    } else {
+      std::copy_n(hidden, n_batch * n_output, output_state);
+    }
+
+    for (int b = 0; b < n_batch; ++b) {
+      const int row =
+          time_major ? t_rel * n_batch + b : b * shape.max_time + t_rel;
+      std::copy_n(output_state + b * n_output, n_output,
+                  output + row * shape.output_batch_leading_dim +
+                      d.output_offset);
+    }
+  }
+}
+
+struct FusedLstmRecurrenceTask : cpu_backend_threadpool::Task {
+  FusedLstmRecurrenceTask(const FloatLstmDirection& direction,
+                          const TfLiteLSTMParams* params, bool time_major,
+                          const FusedLstmShape& shape,
+                          FusedFloatLstmBuffers* buffers)
+      : direction(direction),
+        params(params),
+        time_major(time_major),
+        shape(shape),
+        buffers(buffers) {}
+
+  void Run() override {
+    // The CpuBackendContext can not be shared with the other task.
+    RunFusedLstmRecurrence(direction, params, time_major, shape, buffers,
+                           /*context=*/nullptr);
+  }
+
+  const FloatLstmDirection& direction;
+  const TfLiteLSTMParams* params;
+  bool time_major;
+  FusedLstmShape shape;
+  FusedFloatLstmBuffers* buffers;
+};
+
+}  // namespace
+
+bool CanUseFusedEvalFloat(const FloatLstmDirection& direction) {
+  for (const TfLiteTensor* tensor :
+       {direction.recurrent_to_input_weights,
+        direction.recurrent_to_forget_weights,
+        direction.recurrent_to_cell_weights,
+        direction.recurrent_to_output_weights}) {
+    if (tensor != nullptr && tensor->dims->size != 2) return false;
+  }
+  // The auxiliary input is only used together with its weights.
+  return (direction.aux_input == nullptr) ==
+         (direction.aux_input_to_forget_weights == nullptr);
+}
+
+TfLiteStatus EvalFloatFused(const FloatLstmDirection& direction,
+                            const TfLiteLSTMParams* params, bool time_major,
+                            FusedFloatLstmBuffers* buffers,
+                            CpuBackendContext* context) {
+  TF_LITE_ASSERT(direction.input->dims->size >= 2 &&
+                 direction.input->dims->size <= 3);
+  const FusedLstmShape shape = GetFusedLstmShape(direction, time_major);
+  ProjectFusedLstmInputs(direction, shape, buffers, context);
+  RunFusedLstmRecurrence(direction, params, time_major, shape, buffers,
+                         context);
+  return kTfLiteOk;
+}
+
+TfLiteStatus EvalBidirectionalFloatFused(const FloatLstmDirection& fw,
+                                         const FloatLstmDirection& bw,
+                                         const TfLiteLSTMParams* params,
+                                         bool time_major,
+                                         FusedFloatLstmBuffers* fw_buffers,
+                                         FusedFloatLstmBuffers* bw_buffers,
+                                         CpuBackendContext* context) {
+  TF_LITE_ASSERT(fw.input->dims->size >= 2 && fw.input->dims->size <= 3);
+  TF_LITE_ASSERT(bw.input->dims->size >= 2 && bw.input->dims->size <= 3);
+  const FusedLstmShape fw_shape = GetFusedLstmShape(fw, time_major);
+  const FusedLstmShape bw_shape = GetFusedLstmShape(bw, time_major);
+  ProjectFusedLstmInputs(fw, fw_shape, fw_buffers, context);
+  ProjectFusedLstmInputs(bw, bw_shape, bw_buffers, context);
+
+  if (context->max_num_threads() < 2) {
+    RunFusedLstmRecurrence(fw, params, time_major, fw_shape, fw_buffers,
+                           context);
+    RunFusedLstmRecurrence(bw, params, time_major, bw_shape, bw_buffers,
+                           context);
+    return kTfLiteOk;
+  }
+  // Both directions write disjoint parts of the outputs.
+  std::vector<FusedLstmRecurrenceTask> tasks;
+  tasks.reserve(2);
+  tasks.emplace_back(fw, params, time_major, fw_shape, fw_buffers);
+  tasks.emplace_back(bw, params, time_major, bw_shape, bw_buffers);
+  cpu_backend_threadpool::Execute(tasks.size(), tasks.data(), context);
+  return kTfLiteOk;
+}
+
 TfLiteStatus EvalHybrid(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
     const TfLiteTensor* input_to_input_weights_ledger,
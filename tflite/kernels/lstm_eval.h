@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
@@ -126,6 +127,90 @@ TfLiteStatus EvalFloat(
     bool recurrent_to_cell_is_diag, bool recurrent_to_output_is_diag,
     CpuBackendContext* context);
 
+// The tensors of one direction of a float sequence LSTM, see EvalFloat for
+// their meaning. Optional tensors are nullptr.
+struct FloatLstmDirection {
+  const TfLiteTensor* input = nullptr;
+  const TfLiteTensor* aux_input = nullptr;
+  const TfLiteTensor* input_to_input_weights = nullptr;
+  const TfLiteTensor* input_to_forget_weights = nullptr;
+  const TfLiteTensor* input_to_cell_weights = nullptr;
+  const TfLiteTensor* input_to_output_weights = nullptr;
+  const TfLiteTensor* aux_input_to_input_weights = nullptr;
+  const TfLiteTensor* aux_input_to_forget_weights = nullptr;
+  const TfLiteTensor* aux_input_to_cell_weights = nullptr;
+  const TfLiteTensor* aux_input_to_output_weights = nullptr;
+  const TfLiteTensor* recurrent_to_input_weights = nullptr;
+  const TfLiteTensor* recurrent_to_forget_weights = nullptr;
+  const TfLiteTensor* recurrent_to_cell_weights = nullptr;
+  const TfLiteTensor* recurrent_to_output_weights = nullptr;
+  const TfLiteTensor* cell_to_input_weights = nullptr;
+  const TfLiteTensor* cell_to_forget_weights = nullptr;
+  const TfLiteTensor* cell_to_output_weights = nullptr;
+  const TfLiteTensor* input_layer_norm_coefficients = nullptr;
+  const TfLiteTensor* forget_layer_norm_coefficients = nullptr;
+  const TfLiteTensor* cell_layer_norm_coefficients = nullptr;
+  const TfLiteTensor* output_layer_norm_coefficients = nullptr;
+  const TfLiteTensor* input_gate_bias = nullptr;
+  const TfLiteTensor* forget_gate_bias = nullptr;
+  const TfLiteTensor* cell_gate_bias = nullptr;
+  const TfLiteTensor* output_gate_bias = nullptr;
+  const TfLiteTensor* projection_weights = nullptr;
+  const TfLiteTensor* projection_bias = nullptr;
+  TfLiteTensor* output_state = nullptr;
+  TfLiteTensor* cell_state = nullptr;
+  TfLiteTensor* output = nullptr;
+  bool forward_sequence = true;
+  int output_offset = 0;
+};
+
+// Buffers of the fused float LSTM evaluation. They are owned by the op, like
+// the effective biases of IntegerLstmParameter, because their size depends on
+// the sequence length and the packed weights are reused across invocations.
+struct FusedFloatLstmBuffers {
+  // The weights and biases of all gates stacked in [input, forget, cell,
+  // output] order, without the input gate for CIFG. The auxiliary input
+  // weights are appended to the columns of the input weights.
+  std::vector<float> input_weights;
+  std::vector<float> recurrent_weights;
+  std::vector<float> gate_bias;
+  // Set once constant weights have been packed.
+  bool weights_packed = false;
+  // Input rows concatenated with the auxiliary input rows.
+  std::vector<float> concat_input;
+  // The input contribution to the gates of every time step.
+  std::vector<float> input_projection;
+  // The gates of the current time step, and matmul scratch of the same size.
+  std::vector<float> gates;
+  std::vector<float> gates_scratch;
+  // The output of the current time step before the projection.
+  std::vector<float> hidden;
+};
+
+// Returns whether EvalFloatFused supports `direction`: the recurrent weights
+// must be full matrices.
+bool CanUseFusedEvalFloat(const FloatLstmDirection& direction);
+
+// Same as EvalFloat, but the input to gate projections of all time steps are
+// computed by a single matmul up front, and the recurrent projections of all
+// gates by a single matmul per time step. Results match EvalFloat up to
+// floating point rounding.
+TfLiteStatus EvalFloatFused(const FloatLstmDirection& direction,
+                            const TfLiteLSTMParams* params, bool time_major,
+                            FusedFloatLstmBuffers* buffers,
+                            CpuBackendContext* context);
+
+// Evaluates both directions of a bidirectional LSTM with EvalFloatFused. The
+// input projections use the whole thread pool, then the two recurrences run
+// concurrently if the context has more than one thread.
+TfLiteStatus EvalBidirectionalFloatFused(const FloatLstmDirection& fw,
+                                         const FloatLstmDirection& bw,
+                                         const TfLiteLSTMParams* params,
+                                         bool time_major,
+                                         FusedFloatLstmBuffers* fw_buffers,
+                                         FusedFloatLstmBuffers* bw_buffers,
+                                         CpuBackendContext* context);
+
 TfLiteStatus EvalHybrid(
     const TfLiteTensor* input, const TfLiteTensor* input_to_input_weights,
     const TfLiteTensor* input_to_input_weights_ledger,
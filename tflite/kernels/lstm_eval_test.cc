@@ -18,7 +18,10 @@ limitations under the License.
 #include <stdlib.h>
 
 #include <algorithm>
+#include <cmath>
+#include <deque>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -969,5 +972,172 @@ TEST(TestOneHybridAsymmLSTM, TestOneHybridAsymmLSTM) {
   TestOneHybridAsymmLSTM();
 }
 
+// Owns float tensors with random contents.
+class FloatTensors {
+ public:
+  ~FloatTensors() {
+    for (TfLiteTensor& tensor : tensors_) TfLiteIntArrayFree(tensor.dims);
+  }
+
+  TfLiteTensor* Add(std::vector<int> dims, bool zero = false) {
+    int size = 1;
+    for (int dim : dims) size *= dim;
+    data_.emplace_back(size);
+    std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+    if (!zero) {
+      for (float& value : data_.back()) value = dist(rng_);
+    }
+    tensors_.emplace_back();
+    TfLiteTensor& tensor = tensors_.back();
+    tensor.type = kTfLiteFloat32;
+    tensor.allocation_type = kTfLiteMmapRo;
+    tensor.data.f = data_.back().data();
+    tensor.dims = TfLiteIntArrayCreate(dims.size());
+    for (int i = 0; i < dims.size(); ++i) tensor.dims->data[i] = dims[i];
+    return &tensor;
+  }
+
+  // Adds a copy of `tensor`, with the same contents.
+  TfLiteTensor* Clone(const TfLiteTensor* tensor) {
+    std::vector<int> dims(tensor->dims->data,
+                          tensor->dims->data + tensor->dims->size);
+    TfLiteTensor* clone = Add(dims);
+    std::copy_n(tensor->data.f, data_.back().size(), clone->data.f);
+    return clone;
+  }
+
+ private:
+  std::mt19937 rng_{1234};
+  std::deque<std::vector<float>> data_;
+  std::deque<TfLiteTensor> tensors_;
+};
+
+struct FusedFloatLstmTestParams {
+  bool use_cifg;
+  bool use_peephole;
+  bool use_layer_norm;
+  bool use_projection;
+  bool use_aux_input;
+  bool time_major;
+  bool forward_sequence;
+};
+
+class FusedFloatLstmTest
+    : public ::testing::TestWithParam<FusedFloatLstmTestParams> {};
+
+// The fused evaluation must match EvalFloat.
+TEST_P(FusedFloatLstmTest, MatchesEvalFloat) {
+  const FusedFloatLstmTestParams& p = GetParam();
+  const int n_batch = 3, max_time = 5, n_input = 7, n_cell = 9;
+  const int n_output = p.use_projection ? 6 : n_cell;
+  const std::vector<int> input_dims =
+      p.time_major ? std::vector<int>{max_time, n_batch, n_input}
+                   : std::vector<int>{n_batch, max_time, n_input};
+  const std::vector<int> output_dims =
+      p.time_major ? std::vector<int>{max_time, n_batch, n_output}
+                   : std::vector<int>{n_batch, max_time, n_output};
+
+  FloatTensors t;
+  ops::builtin::lstm_eval::FloatLstmDirection d;
+  d.input = t.Add(input_dims);
+  // EvalFloat requires the auxiliary input to have the input's size.
+  if (p.use_aux_input) d.aux_input = t.Add(input_dims);
+  if (!p.use_cifg) {
+    d.input_to_input_weights = t.Add({n_cell, n_input});
+    d.recurrent_to_input_weights = t.Add({n_cell, n_output});
+    d.input_gate_bias = t.Add({n_cell});
+    if (p.use_aux_input) {
+      d.aux_input_to_input_weights = t.Add({n_cell, n_input});
+    }
+    if (p.use_peephole) d.cell_to_input_weights = t.Add({n_cell});
+    if (p.use_layer_norm) d.input_layer_norm_coefficients = t.Add({n_cell});
+  }
+  d.input_to_forget_weights = t.Add({n_cell, n_input});
+  d.input_to_cell_weights = t.Add({n_cell, n_input});
+  d.input_to_output_weights = t.Add({n_cell, n_input});
+  d.recurrent_to_forget_weights = t.Add({n_cell, n_output});
+  d.recurrent_to_cell_weights = t.Add({n_cell, n_output});
+  d.recurrent_to_output_weights = t.Add({n_cell, n_output});
+  if (p.use_aux_input) {
+    d.aux_input_to_forget_weights = t.Add({n_cell, n_input});
+    d.aux_input_to_cell_weights = t.Add({n_cell, n_input});
+    d.aux_input_to_output_weights = t.Add({n_cell, n_input});
+  }
+  if (p.use_peephole) {
+    d.cell_to_forget_weights = t.Add({n_cell});
+    d.cell_to_output_weights = t.Add({n_cell});
+  }
+  if (p.use_layer_norm) {
+    d.forget_layer_norm_coefficients = t.Add({n_cell});
+    d.cell_layer_norm_coefficients = t.Add({n_cell});
+    d.output_layer_norm_coefficients = t.Add({n_cell});
+  }
+  d.forget_gate_bias = t.Add({n_cell});
+  d.cell_gate_bias = t.Add({n_cell});
+  d.output_gate_bias = t.Add({n_cell});
+  if (p.use_projection) {
+    d.projection_weights = t.Add({n_output, n_cell});
+    d.projection_bias = t.Add({n_output});
+  }
+  d.forward_sequence = p.forward_sequence;
+  d.output_state = t.Add({n_batch, n_output});
+  d.cell_state = t.Add({n_batch, n_cell});
+  d.output = t.Add(output_dims, /*zero=*/true);
+
+  ops::builtin::lstm_eval::FloatLstmDirection fused = d;
+  fused.output_state = t.Clone(d.output_state);
+  fused.cell_state = t.Clone(d.cell_state);
+  fused.output = t.Clone(d.output);
+
+  TfLiteLSTMParams params = {kTfLiteActTanh, /*cell_clip=*/2.0f,
+                             /*proj_clip=*/p.use_projection ? 0.3f : 0.0f,
+                             kTfLiteLSTMFullKernel,
+                             /*asymmetric_quantize_inputs=*/false};
+  TfLiteTensor* scratch_buffer = t.Add({n_batch, 5 * n_cell});
+  CpuBackendContext context;
+  ASSERT_EQ(
+      ops::builtin::lstm_eval::EvalFloat(
+          d.input, d.input_to_input_weights, d.input_to_forget_weights,
+          d.input_to_cell_weights, d.input_to_output_weights,
+          d.recurrent_to_input_weights, d.recurrent_to_forget_weights,
+          d.recurrent_to_cell_weights, d.recurrent_to_output_weights,
+          d.cell_to_input_weights, d.cell_to_forget_weights,
+          d.cell_to_output_weights, d.input_layer_norm_coefficients,
+          d.forget_layer_norm_coefficients, d.cell_layer_norm_coefficients,
+          d.output_layer_norm_coefficients, d.aux_input,
+          d.aux_input_to_input_weights, d.aux_input_to_forget_weights,
+          d.aux_input_to_cell_weights, d.aux_input_to_output_weights,
+          d.input_gate_bias, d.forget_gate_bias, d.cell_gate_bias,
+          d.output_gate_bias, d.projection_weights, d.projection_bias,
+          &params, d.forward_sequence, p.time_major, /*output_offset=*/0,
+          scratch_buffer, d.output_state, d.cell_state, d.output,
+          /*recurrent_to_input_is_diag=*/false,
+          /*recurrent_to_forget_is_diag=*/false,
+          /*recurrent_to_cell_is_diag=*/false,
+          /*recurrent_to_output_is_diag=*/false, &context),
+      kTfLiteOk);
+  ASSERT_TRUE(ops::builtin::lstm_eval::CanUseFusedEvalFloat(fused));
+  ops::builtin::lstm_eval::FusedFloatLstmBuffers buffers;
+  ASSERT_EQ(ops::builtin::lstm_eval::EvalFloatFused(
+                fused, &params, p.time_major, &buffers, &context),
+            kTfLiteOk);
+
+  const int output_size = n_batch * max_time * n_output;
+  EXPECT_TRUE(ArrayFloatNear(fused.output->data.f, d.output->data.f,
+                             output_size, 1e-5));
+  EXPECT_TRUE(ArrayFloatNear(fused.cell_state->data.f, d.cell_state->data.f,
+                             n_batch * n_cell, 1e-5));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FusedFloatLstmTest, FusedFloatLstmTest,
+    ::testing::Values(
+        FusedFloatLstmTestParams{false, false, false, false, false, true, true},
+        FusedFloatLstmTestParams{true, false, false, false, false, true, true},
+        FusedFloatLstmTestParams{false, true, false, true, false, true, false},
+        FusedFloatLstmTestParams{true, true, true, true, false, false, true},
+        FusedFloatLstmTestParams{false, false, true, false, true, false, false},
+        FusedFloatLstmTestParams{false, true, true, true, true, true, true}));
+
 }  // namespace
 }  // namespace tflite
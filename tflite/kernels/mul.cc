@@ -36,6 +36,7 @@ limitations under the License.
 #include "tflite/kernels/internal/tensor_ctypes.h"
 #include "tflite/kernels/internal/types.h"
 #include "tflite/kernels/kernel_util.h"
+#include "tflite/kernels/reduced_precision_storage.h"
 
 namespace tflite {
 namespace ops {
@@ -63,6 +64,8 @@ struct OpData {
   int output_shift;
   // Indicates that 'Eval' is a noop as the output as written during 'Prepare'.
   bool noop;
+  // Float32 copies of reduced precision operands of a broadcast.
+  int float_copies_index;
 };
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -84,6 +87,7 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   auto* params = reinterpret_cast<TfLiteMulParams*>(node->builtin_data);
   OpData* data = reinterpret_cast<OpData*>(node->user_data);
   data->noop = false;
+  data->float_copies_index = kFloatCopiesNotAllocated;
 
   TF_LITE_ENSURE_EQ(context, NumInputs(node), 2);
   TF_LITE_ENSURE_EQ(context, NumOutputs(node), 1);
@@ -98,7 +102,14 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   TF_LITE_ENSURE_OK(context,
                     GetOutputSafe(context, node, kOutputTensor, &output));
 
-  TF_LITE_ENSURE_TYPES_EQ(context, input1->type, input2->type);
+  if (HasReducedPrecisionStorage({input1, input2, output})) {
+    // Float32 activations, some stored in reduced precision.
+    TF_LITE_ENSURE(context, IsFloatStorageType(input1->type) &&
+                                IsFloatStorageType(input2->type) &&
+                                IsFloatStorageType(output->type));
+  } else {
+    TF_LITE_ENSURE_TYPES_EQ(context, input1->type, input2->type);
+  }
 
   if (output->type == kTfLiteComplex64 && params->activation) {
     TF_LITE_KERNEL_LOG(context,
@@ -127,8 +138,18 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
                        &data->output_shift);
   }
 
-  if (IsConstantOrPersistentTensor(input1) &&
-      IsConstantOrPersistentTensor(input2)) {
+  const bool constant_inputs = IsConstantOrPersistentTensor(input1) &&
+                               IsConstantOrPersistentTensor(input2);
+  if (requires_broadcast &&
+      HasReducedPrecisionStorage({input1, input2, output})) {
+    TF_LITE_ENSURE_OK(
+        context, PrepareFloatCopies(context, node, input1, input2, output,
+                                    output_size,
+                                    /*allocate_now=*/constant_inputs,
+                                    &data->float_copies_index));
+  }
+
+  if (constant_inputs) {
     SetTensorToPersistentRo(output);
     data->noop = true;
     context->ResizeTensor(context, output, output_size);
@@ -231,6 +252,35 @@ void EvalMul(TfLiteContext* context, TfLiteNode* node, TfLiteMulParams* params,
   }
 }
 
+TfLiteStatus EvalMulReducedPrecision(TfLiteContext* context, TfLiteNode* node,
+                                     const TfLiteMulParams* params,
+                                     const TfLiteTensor* input1,
+                                     const TfLiteTensor* input2,
+                                     TfLiteTensor* output) {
+  float output_activation_min, output_activation_max;
+  CalculateActivationRange(params->activation, &output_activation_min,
+                           &output_activation_max);
+  if (HaveSameShapes(input1, input2)) {
+    ElementwiseWithFloatStorage(input1, input2, output_activation_min,
+                                output_activation_max, output,
+                                [](float a, float b) { return a * b; });
+    return kTfLiteOk;
+  }
+  TfLiteTensor* scratch;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, 0, &scratch));
+  tflite::ArithmeticParams op_params;
+  SetActivationParams(output_activation_min, output_activation_max,
+                      &op_params);
+  WithFloatCopies(input1, input2, output, scratch,
+                  [&](const float* in1, const float* in2, float* out) {
+                    reference_ops::BroadcastMul6DSlow(
+                        op_params, GetTensorShape(input1), in1,
+                        GetTensorShape(input2), in2, GetTensorShape(output),
+                        out);
+                  });
+  return kTfLiteOk;
+}
+
 template <KernelType kernel_type>
 TfLiteStatus EvalQuantized(TfLiteContext* context, TfLiteNode* node,
                            TfLiteMulParams* params, const OpData* data,
@@ -335,10 +385,14 @@ TfLiteStatus EvalImpl(TfLiteContext* context, TfLiteNode* node, OpData* data,
                       TfLiteMulParams* params, const TfLiteTensor* input1,
                       const TfLiteTensor* input2, TfLiteTensor* output) {
   bool output_quantized = output->quantization.type != kTfLiteNoQuantization;
-  if (output->type == kTfLiteFloat32 || output->type == kTfLiteInt32 ||
-      output->type == kTfLiteInt64 || output->type == kTfLiteComplex64 ||
-      (!output_quantized && output->type == kTfLiteInt16) ||
-      output->type == kTfLiteUInt32) {
+  if (HasReducedPrecisionStorage({input1, input2, output})) {
+    TF_LITE_ENSURE_OK(context, EvalMulReducedPrecision(context, node, params,
+                                                       input1, input2, output));
+  } else if (output->type == kTfLiteFloat32 || output->type == kTfLiteInt32 ||
+             output->type == kTfLiteInt64 ||
+             output->type == kTfLiteComplex64 ||
+             (!output_quantized && output->type == kTfLiteInt16) ||
+             output->type == kTfLiteUInt32) {
     EvalMul<kernel_type>(context, node, params, data, input1, input2, output);
   } else if (output->type == kTfLiteUInt8 || output->type == kTfLiteInt8 ||
              output->type == kTfLiteInt16) {
@@ -0,0 +1,203 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_KERNELS_REDUCED_PRECISION_STORAGE_H_
+#define TENSORFLOW_LITE_KERNELS_REDUCED_PRECISION_STORAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "tflite/core/c/common.h"
+#include "tflite/experimental/shlo/bf16.h"
+#include "tflite/experimental/shlo/f16.h"
+#include "tflite/kernels/kernel_util.h"
+
+namespace tflite {
+
+// With InterpreterOptions::SetActivationStorageType(), intermediate float32
+// activations may be stored as fp16 or bf16 in the arena. Kernels that accept
+// such tensors still compute in float32 and use the helpers below to convert
+// while reading and writing them. Conversions are done in blocks small enough
+// to stay in L1, so only the reduced precision bytes go through memory.
+
+// Number of elements converted at a time.
+constexpr size_t kReducedPrecisionBlockSize = 256;
+
+// Returns true if `type` is a storage type of float32 activations.
+inline bool IsFloatStorageType(TfLiteType type) {
+  return type == kTfLiteFloat32 || type == kTfLiteFloat16 ||
+         type == kTfLiteBFloat16;
+}
+
+// Returns true if any of `tensors` is a float32 activation stored in reduced
+// precision.
+inline bool HasReducedPrecisionStorage(
+    std::initializer_list<const TfLiteTensor*> tensors) {
+  for (const TfLiteTensor* tensor : tensors) {
+    if (tensor->type == kTfLiteFloat16 || tensor->type == kTfLiteBFloat16) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Converts `size` elements of `tensor`, starting at element `offset`, to
+// float32.
+inline void LoadAsFloat(const TfLiteTensor* tensor, size_t offset, size_t size,
+                        float* dst) {
+  switch (tensor->type) {
+    case kTfLiteFloat16: {
+      const auto* src =
+          reinterpret_cast<const shlo_ref::F16*>(tensor->data.raw) + offset;
+      for (size_t i = 0; i < size; ++i) dst[i] = static_cast<float>(src[i]);
+      break;
+    }
+    case kTfLiteBFloat16: {
+      const auto* src =
+          reinterpret_cast<const shlo_ref::BF16*>(tensor->data.raw) + offset;
+      for (size_t i = 0; i < size; ++i) dst[i] = static_cast<float>(src[i]);
+      break;
+    }
+    default:
+      std::memcpy(dst, tensor->data.f + offset, size * sizeof(float));
+  }
+}
+
+// Converts `size` float32 values to the type of `tensor` and stores them
+// starting at element `offset`.
+inline void StoreFromFloat(const float* src, size_t offset, size_t size,
+                           TfLiteTensor* tensor) {
+  switch (tensor->type) {
+    case kTfLiteFloat16: {
+      auto* dst = reinterpret_cast<shlo_ref::F16*>(tensor->data.raw) + offset;
+      for (size_t i = 0; i < size; ++i) dst[i] = shlo_ref::F16(src[i]);
+      break;
+    }
+    case kTfLiteBFloat16: {
+      auto* dst = reinterpret_cast<shlo_ref::BF16*>(tensor->data.raw) + offset;
+      for (size_t i = 0; i < size; ++i) dst[i] = shlo_ref::BF16(src[i]);
+      break;
+    }
+    default:
+      std::memcpy(tensor->data.f + offset, src, size * sizeof(float));
+  }
+}
+
+// Computes `output[i] = clamp(op(input1[i], input2[i]))` for inputs of the
+// same shape, any of the tensors possibly being stored in reduced precision.
+// Float32 operands are used in place. The output may alias an input.
+template <typename Op>
+void ElementwiseWithFloatStorage(const TfLiteTensor* input1,
+                                 const TfLiteTensor* input2,
+                                 float activation_min, float activation_max,
+                                 TfLiteTensor* output, const Op& op) {
+  const size_t num_elements = NumElements(output);
+  float block1[kReducedPrecisionBlockSize];
+  float block2[kReducedPrecisionBlockSize];
+  float block_out[kReducedPrecisionBlockSize];
+  for (size_t offset = 0; offset < num_elements;
+       offset += kReducedPrecisionBlockSize) {
+    const size_t size =
+        std::min(kReducedPrecisionBlockSize, num_elements - offset);
+    const float* in1 = input1->data.f + offset;
+    if (input1->type != kTfLiteFloat32) {
+      LoadAsFloat(input1, offset, size, block1);
+      in1 = block1;
+    }
+    const float* in2 = input2->data.f + offset;
+    if (input2->type != kTfLiteFloat32) {
+      LoadAsFloat(input2, offset, size, block2);
+      in2 = block2;
+    }
+    float* out = output->type == kTfLiteFloat32 ? output->data.f + offset
+                                                : block_out;
+    for (size_t i = 0; i < size; ++i) {
+      out[i] = std::min(std::max(op(in1[i], in2[i]), activation_min),
+                        activation_max);
+    }
+    if (output->type != kTfLiteFloat32) {
+      StoreFromFloat(block_out, offset, size, output);
+    }
+  }
+}
+
+// Value of a kernel's scratch tensor index before PrepareFloatCopies() has
+// added the tensor.
+constexpr int kFloatCopiesNotAllocated = -1;
+
+// Sets up the float32 scratch tensor that WithFloatCopies() needs for the
+// reduced precision operands of a broadcast, as the node's only temporary.
+// `output_dims` is the shape the output is about to be resized to.
+// `*scratch_index` is kept in the kernel's OpData and should start as
+// kFloatCopiesNotAllocated. The scratch lives in the arena, unless
+// `allocate_now` because the kernel evaluates in Prepare.
+inline TfLiteStatus PrepareFloatCopies(TfLiteContext* context,
+                                       TfLiteNode* node,
+                                       const TfLiteTensor* input1,
+                                       const TfLiteTensor* input2,
+                                       const TfLiteTensor* output,
+                                       const TfLiteIntArray* output_dims,
+                                       bool allocate_now, int* scratch_index) {
+  int64_t size = 0;
+  if (input1->type != kTfLiteFloat32) size += NumElements(input1);
+  if (input2->type != kTfLiteFloat32) size += NumElements(input2);
+  if (output->type != kTfLiteFloat32) size += NumElements(output_dims);
+  if (*scratch_index == kFloatCopiesNotAllocated) {
+    TF_LITE_ENSURE_OK(context, context->AddTensors(context, 1, scratch_index));
+  }
+  TfLiteIntArrayFree(node->temporaries);
+  node->temporaries = TfLiteIntArrayCreate(1);
+  node->temporaries->data[0] = *scratch_index;
+  TfLiteTensor* scratch;
+  TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, 0, &scratch));
+  scratch->type = kTfLiteFloat32;
+  scratch->allocation_type = allocate_now ? kTfLiteDynamic : kTfLiteArenaRw;
+  TfLiteIntArray* scratch_dims = TfLiteIntArrayCreate(1);
+  scratch_dims->data[0] = static_cast<int>(size);
+  return context->ResizeTensor(context, scratch, scratch_dims);
+}
+
+// Runs `fn(input1_data, input2_data, output_data)`, a float32 kernel, on
+// tensors that may be stored in reduced precision, going through float32
+// copies of the ones that are. The copies are kept in `scratch`, sized by
+// PrepareFloatCopies(). Used for broadcasts, where the blocked conversion of
+// ElementwiseWithFloatStorage() doesn't apply.
+template <typename Fn>
+void WithFloatCopies(const TfLiteTensor* input1, const TfLiteTensor* input2,
+                     TfLiteTensor* output, TfLiteTensor* scratch,
+                     const Fn& fn) {
+  float* next_copy = scratch->data.f;
+  auto as_float = [&next_copy](const TfLiteTensor* tensor) -> const float* {
+    if (tensor->type == kTfLiteFloat32) return tensor->data.f;
+    float* copy = next_copy;
+    const size_t size = NumElements(tensor);
+    LoadAsFloat(tensor, 0, size, copy);
+    next_copy += size;
+    return copy;
+  };
+  const float* in1 = as_float(input1);
+  const float* in2 = as_float(input2);
+  float* out = output->type == kTfLiteFloat32 ? output->data.f : next_copy;
+  fn(in1, in2, out);
+  if (output->type != kTfLiteFloat32) {
+    StoreFromFloat(out, 0, NumElements(output), output);
+  }
+}
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_KERNELS_REDUCED_PRECISION_STORAGE_H_
@@ -0,0 +1,247 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/core/c/builtin_op_data.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/interpreter.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/interpreter_options.h"
+#include "tflite/kernels/register.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+enum { kX, kBias, kSquare, kSum, kTanh, kOutput };
+
+// Builds `output = tanh(x * x + bias) - x`, where only `square`, `sum` and
+// `tanh` are eligible for reduced precision storage.
+class ReducedPrecisionStorageTest : public ::testing::Test {
+ protected:
+  void Build(const std::vector<int>& x_shape,
+             const std::vector<int>& bias_shape) {
+    interpreter_ = std::make_unique<Interpreter>();
+    ASSERT_EQ(interpreter_->AddTensors(6), kTfLiteOk);
+    ASSERT_EQ(interpreter_->SetInputs({kX, kBias}), kTfLiteOk);
+    ASSERT_EQ(interpreter_->SetOutputs({kOutput}), kTfLiteOk);
+    for (int t : {kX, kSquare, kSum, kTanh, kOutput}) {
+      ASSERT_EQ(interpreter_->SetTensorParametersReadWrite(
+                    t, kTfLiteFloat32, "", x_shape, TfLiteQuantizationParams()),
+                kTfLiteOk);
+    }
+    ASSERT_EQ(
+        interpreter_->SetTensorParametersReadWrite(
+            kBias, kTfLiteFloat32, "", bias_shape, TfLiteQuantizationParams()),
+        kTfLiteOk);
+
+    AddNode<TfLiteMulParams>(BuiltinOperator_MUL, {kX, kX}, kSquare);
+    AddNode<TfLiteAddParams>(BuiltinOperator_ADD, {kSquare, kBias}, kSum);
+    AddNode<void>(BuiltinOperator_TANH, {kSum}, kTanh);
+    AddNode<TfLiteSubParams>(BuiltinOperator_SUB, {kTanh, kX}, kOutput);
+  }
+
+  template <typename Params>
+  void AddNode(BuiltinOperator op, const std::vector<int>& inputs,
+               int output) {
+    void* params = nullptr;
+    if constexpr (!std::is_void_v<Params>) {
+      params = calloc(1, sizeof(Params));
+    }
+    ASSERT_EQ(interpreter_->AddNodeWithParameters(
+                  inputs, {output}, nullptr, 0, params,
+                  resolver_.FindOp(op, /*version=*/1)),
+              kTfLiteOk);
+  }
+
+  void ApplyStorage(TfLiteType type, float tolerance = 0.0f) {
+    InterpreterOptions options;
+    options.SetActivationStorageType(type);
+    options.SetActivationStorageTolerance(tolerance);
+    ASSERT_EQ(interpreter_->ApplyOptions(&options), kTfLiteOk);
+  }
+
+  // Fills the inputs and returns the expected output.
+  std::vector<float> FillInputs() {
+    TfLiteTensor* x = interpreter_->tensor(kX);
+    TfLiteTensor* bias = interpreter_->tensor(kBias);
+    for (int i = 0; i < NumElements(x); ++i) x->data.f[i] = 0.01f * i - 0.5f;
+    for (int i = 0; i < NumElements(bias); ++i) bias->data.f[i] = 0.1f * i;
+    std::vector<float> expected(NumElements(x));
+    for (int i = 0; i < NumElements(x); ++i) {
+      const float b = bias->data.f[i % NumElements(bias)];
+      expected[i] =
+          std::tanh(x->data.f[i] * x->data.f[i] + b) - x->data.f[i];
+    }
+    return expected;
+  }
+
+  void ExpectOutputNear(const std::vector<float>& expected, float tolerance) {
+    const TfLiteTensor* output = interpreter_->tensor(kOutput);
+    ASSERT_EQ(output->type, kTfLiteFloat32);
+    ASSERT_EQ(NumElements(output), static_cast<int>(expected.size()));
+    for (int i = 0; i < NumElements(output); ++i) {
+      EXPECT_NEAR(output->data.f[i], expected[i], tolerance) << i;
+    }
+  }
+
+  static int NumElements(const TfLiteTensor* t) {
+    int count = 1;
+    for (int i = 0; i < t->dims->size; ++i) count *= t->dims->data[i];
+    return count;
+  }
+
+  ops::builtin::BuiltinOpResolver resolver_;
+  std::unique_ptr<Interpreter> interpreter_;
+};
+
+TEST_F(ReducedPrecisionStorageTest, DefaultsToFloat32) {
+  Build({2, 3}, {2, 3});
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  EXPECT_THAT(interpreter_->primary_subgraph().reduced_precision_tensors(),
+              IsEmpty());
+  for (int t = 0; t < interpreter_->tensors_size(); ++t) {
+    EXPECT_EQ(interpreter_->tensor(t)->type, kTfLiteFloat32);
+  }
+  const std::vector<float> expected = FillInputs();
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 1e-5f);
+}
+
+class ReducedPrecisionStorageTypeTest
+    : public ReducedPrecisionStorageTest,
+      public ::testing::WithParamInterface<TfLiteType> {};
+
+TEST_P(ReducedPrecisionStorageTypeTest, StoresIntermediates) {
+  Build({2, 3}, {2, 3});
+  ApplyStorage(GetParam());
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  EXPECT_THAT(interpreter_->primary_subgraph().reduced_precision_tensors(),
+              ElementsAre(kSquare, kSum, kTanh));
+  for (int t : {kSquare, kSum, kTanh}) {
+    EXPECT_EQ(interpreter_->tensor(t)->type, GetParam());
+    EXPECT_EQ(interpreter_->tensor(t)->bytes, 6 * sizeof(uint16_t));
+  }
+  for (int t : {kX, kBias, kOutput}) {
+    EXPECT_EQ(interpreter_->tensor(t)->type, kTfLiteFloat32);
+  }
+  const std::vector<float> expected = FillInputs();
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 2e-2f);
+}
+
+TEST_P(ReducedPrecisionStorageTypeTest, Broadcast) {
+  Build({4, 3}, {1, 3});
+  ApplyStorage(GetParam());
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  EXPECT_THAT(interpreter_->primary_subgraph().reduced_precision_tensors(),
+              ElementsAre(kSquare, kSum, kTanh));
+  const std::vector<float> expected = FillInputs();
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 2e-2f);
+}
+
+TEST_P(ReducedPrecisionStorageTypeTest, CheckAccepts) {
+  Build({16, 64}, {16, 64});
+  ApplyStorage(GetParam(), /*tolerance=*/0.1f);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  const Subgraph& subgraph = interpreter_->primary_subgraph();
+  // Storage stays float32 until the check ran.
+  EXPECT_THAT(subgraph.reduced_precision_tensors(), IsEmpty());
+  std::vector<float> expected = FillInputs();
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  const Subgraph::ActivationStorageReport& report =
+      subgraph.activation_storage_report();
+  EXPECT_TRUE(report.checked);
+  EXPECT_TRUE(report.accepted);
+  EXPECT_EQ(report.num_reduced_tensors, 3);
+  EXPECT_GT(report.max_relative_error, 0.0);
+  EXPECT_LE(report.max_relative_error, 0.1);
+  EXPECT_LT(report.reduced_arena_bytes, report.declared_arena_bytes);
+  EXPECT_THAT(subgraph.reduced_precision_tensors(),
+              ElementsAre(kSquare, kSum, kTanh));
+
+  // The check keeps the inputs it ran on.
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 2e-2f);
+  expected = FillInputs();
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 2e-2f);
+}
+
+TEST_P(ReducedPrecisionStorageTypeTest, CheckRejects) {
+  Build({16, 64}, {16, 64});
+  ApplyStorage(GetParam(), /*tolerance=*/1e-7f);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  std::vector<float> expected = FillInputs();
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  const Subgraph& subgraph = interpreter_->primary_subgraph();
+  EXPECT_TRUE(subgraph.activation_storage_report().checked);
+  EXPECT_FALSE(subgraph.activation_storage_report().accepted);
+  EXPECT_THAT(subgraph.reduced_precision_tensors(), IsEmpty());
+  EXPECT_EQ(interpreter_->tensor(kSum)->type, kTfLiteFloat32);
+
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 1e-5f);
+  // Later allocations don't check again.
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  EXPECT_THAT(subgraph.reduced_precision_tensors(), IsEmpty());
+  expected = FillInputs();
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  ExpectOutputNear(expected, 1e-5f);
+}
+
+TEST_P(ReducedPrecisionStorageTypeTest, InvokeKeepsTensorPointers) {
+  Build({16, 64}, {16, 64});
+  ApplyStorage(GetParam(), /*tolerance=*/0.1f);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  float* x = interpreter_->typed_input_tensor<float>(0);
+  float* bias = interpreter_->typed_input_tensor<float>(1);
+  const float* output = interpreter_->typed_output_tensor<float>(0);
+
+  for (int invocation = 0; invocation < 2; ++invocation) {
+    SCOPED_TRACE(invocation);
+    const std::vector<float> expected = FillInputs();
+    ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+    EXPECT_EQ(interpreter_->typed_input_tensor<float>(0), x);
+    EXPECT_EQ(interpreter_->typed_input_tensor<float>(1), bias);
+    EXPECT_EQ(interpreter_->typed_output_tensor<float>(0), output);
+    for (int i = 0; i < static_cast<int>(expected.size()); ++i) {
+      EXPECT_NEAR(output[i], expected[i], 1e-5f) << i;
+    }
+  }
+  // Without another allocation the check doesn't run.
+  EXPECT_FALSE(
+      interpreter_->primary_subgraph().activation_storage_report().checked);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReducedPrecisionStorageTypeTest,
+                         ReducedPrecisionStorageTypeTest,
+                         ::testing::Values(kTfLiteFloat16, kTfLiteBFloat16));
+
+}  // namespace
+}  // namespace tflite
@@ -193,8 +193,6 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
                           Subgraph* selected_subgraph) {
   Subgraph* this_subgraph = reinterpret_cast<Subgraph*>(context->impl_);
 
-  TF_LITE_ENSURE_OK(context, selected_subgraph->AllocateTensors());
-
   const int num_inputs = node->inputs->size - 1;
   const int num_outputs = node->outputs->size;
   const int* const start = node->inputs->data + 1;
@@ -213,10 +211,10 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
   }
 
   // subgraph->outputs tensor shape and type are copied to node->outputs
-  TF_LITE_ENSURE_OK(context, DeepCopyTensorsShapeTypeData(
+  TF_LITE_ENSURE_OK(context, MoveOrDeepCopyTensorsShapeTypeData(
                                  context, node, selected_subgraph,
                                  selected_subgraph->outputs(), this_subgraph,
-                                 TfLiteIntArrayView(node->outputs), true));
+                                 TfLiteIntArrayView(node->outputs)));
 
   for (int i = 0; i < num_outputs; ++i) {
     const int input_pos = OutputIsInput(selected_subgraph->outputs()[i],
@@ -244,8 +242,13 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node,
     if (output_idx == kTfLiteOptionalTensor) continue;
     TfLiteTensor* subgraph_output = selected_subgraph->tensor(output_idx);
     if (!IsResourceOrVariant(subgraph_output) &&
-        !IsConstantTensor(subgraph_output)) {
+        !IsConstantTensor(subgraph_output) &&
+        subgraph_output->allocation_type != kTfLiteCustom) {
       subgraph_output->allocation_type = kTfLiteCustom;
+      // The output was planned in the arena, make sure the subgraph gets
+      // planned again.
+      TF_LITE_ENSURE_OK(context,
+                        selected_subgraph->ReleaseNonPersistentMemory());
     }
   }
   // node->inputs tensor shape and type are copied subgraph->inputs
@@ -314,23 +317,13 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
 
   TF_LITE_ENSURE(context, selected_subgraph_index < subgraphs->size());
   Subgraph& selected_subgraph = *(*subgraphs)[selected_subgraph_index].get();
-  TF_LITE_ENSURE_OK(context, selected_subgraph.AllocateTensors());
   if (op_data->subgraph_has_dynamic_output_tensors) {
     TF_LITE_ENSURE_OK(context, Eval_dynamic(context, node, &selected_subgraph));
   } else {
     TF_LITE_ENSURE_OK(context, Eval_static(context, node, &selected_subgraph));
   }
-  for (int i = 0; i < node->outputs->size; ++i) {
-    const int output_idx = node->outputs->data[i];
-    if (output_idx == kTfLiteOptionalTensor) continue;
-    TfLiteTensor* output_tensor;
-    TF_LITE_ENSURE_OK(context, GetOutputSafe(context, node, i, &output_tensor));
-    TfLiteTensor* selected_output =
-        selected_subgraph.tensor(selected_subgraph.outputs()[i]);
-    TF_LITE_ENSURE_OK(context,
-                      TfLiteTensorCopy(output_tensor, selected_output));
-  }
-  if (!this_subgraph->ShouldPreserveAllTensors()) {
+  if (!this_subgraph->ShouldPreserveAllTensors() &&
+      !this_subgraph->ShouldKeepControlFlowSubgraphsResident()) {
     TF_LITE_ENSURE_OK(context, selected_subgraph.ReleaseMemory());
   }
   return kTfLiteOk;
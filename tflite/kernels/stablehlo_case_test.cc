@@ -333,5 +333,34 @@ TEST(StablehloCaseTest, DynamicCaseTestPad) {
   EXPECT_THAT(model.GetOutput<int>(), ElementsAreArray({0, 5, 7, 0, 0}));
 }
 
+TEST(StablehloCaseTest, DynamicCaseTestRepeatedInvocations) {
+  TfLiteStablehloCaseParams params = {
+      {1, 2},
+      2,
+  };
+
+  StablehloCaseDynamicOpModel model(
+      {TensorType_INT32, {}}, {TensorType_INT32, {2}},
+      {TensorType_INT32, {1, 2}}, {TensorType_INT32, {}}, params);
+  model.SetInput<int>(model.input(), {1});
+  model.SetInput<int>(model.subgraph_input1(), {5, 7});
+  model.SetInput<int>(model.subgraph_input2(), {1, 2});
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  EXPECT_THAT(model.GetOutput<int>(), ElementsAreArray({0, 5, 7, 0, 0}));
+
+  model.SetInput<int>(model.subgraph_input1(), {6, 8});
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  EXPECT_THAT(model.GetOutput<int>(), ElementsAreArray({0, 6, 8, 0, 0}));
+
+  model.SetInput<int>(model.input(), {0});
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  EXPECT_THAT(model.GetOutput<int>(), ElementsAreArray({7, 10}));
+
+  model.SetInput<int>(model.input(), {1});
+  model.SetInput<int>(model.subgraph_input1(), {1, 3});
+  ASSERT_EQ(model.Invoke(), kTfLiteOk);
+  EXPECT_THAT(model.GetOutput<int>(), ElementsAreArray({0, 1, 3, 0, 0}));
+}
+
 }  // namespace
 }  // namespace tflite
@@ -122,7 +122,6 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
 TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
                           Subgraph* this_subgraph,
                           Subgraph* decomposition_subgraph) {
-  TF_LITE_ENSURE_OK(context, decomposition_subgraph->AllocateTensors());
   const int num_inputs = node->inputs->size;
   const int num_outputs = node->outputs->size;
   const int* const start = node->inputs->data;
@@ -141,10 +140,10 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node,
 
   // subgraph->outputs -> node->outputs
   TF_LITE_ENSURE_OK(context,
-                    DeepCopyTensorsShapeTypeData(
+                    MoveOrDeepCopyTensorsShapeTypeData(
                         context, node, decomposition_subgraph,
                         decomposition_subgraph->outputs(), this_subgraph,
-                        TfLiteIntArrayView(node->outputs), true));
+                        TfLiteIntArrayView(node->outputs)));
 
   for (int i = 0; i < num_outputs; ++i) {
     const int input_pos = OutputIsInput(decomposition_subgraph->outputs()[i],
@@ -172,8 +171,13 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node,
     if (output_idx == kTfLiteOptionalTensor) continue;
     TfLiteTensor* subgraph_output = decomposition_subgraph->tensor(output_idx);
     if (!IsResourceOrVariant(subgraph_output) &&
-        !IsConstantTensor(subgraph_output)) {
+        !IsConstantTensor(subgraph_output) &&
+        subgraph_output->allocation_type != kTfLiteCustom) {
       subgraph_output->allocation_type = kTfLiteCustom;
+      // The output was planned in the arena, make sure the subgraph gets
+      // planned again.
+      TF_LITE_ENSURE_OK(context,
+                        decomposition_subgraph->ReleaseNonPersistentMemory());
     }
   }
   // node->inputs -> subgraph->inputs
@@ -235,7 +239,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
                                            decomposition_subgraph));
   }
 
-  if (!this_subgraph->ShouldPreserveAllTensors()) {
+  if (!this_subgraph->ShouldPreserveAllTensors() &&
+      !this_subgraph->ShouldKeepControlFlowSubgraphsResident()) {
     TF_LITE_ENSURE_OK(context, decomposition_subgraph->ReleaseMemory());
   }
 
@@ -149,6 +149,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       break;
     }
     case kTfLiteInt16:
+    case kTfLiteFloat16:
+    case kTfLiteBFloat16:
       TF_LITE_TRANSPOSE(reference_ops, int16_t);
       break;
     case kTfLiteInt64:
@@ -55,6 +55,9 @@ struct OpData {
   bool recurrent_to_output_is_diag = false;
 
   lstm_eval::IntegerLstmParameter integer_lstm_param;
+
+  // Buffers of the fused float evaluation.
+  lstm_eval::FusedFloatLstmBuffers fused_float_buffers;
 };
 
 TfLiteStatus PopulateQuantizedLstmParams8x8_16(
@@ -1372,6 +1375,37 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
       TfLiteTensor* scratch_buffer;
       TF_LITE_ENSURE_OK(context, GetTemporarySafe(context, node, kScratchBuffer,
                                                   &scratch_buffer));
+      lstm_eval::FloatLstmDirection direction;
+      direction.input = input;
+      direction.input_to_input_weights = input_to_input_weights;
+      direction.input_to_forget_weights = input_to_forget_weights;
+      direction.input_to_cell_weights = input_to_cell_weights;
+      direction.input_to_output_weights = input_to_output_weights;
+      direction.recurrent_to_input_weights = recurrent_to_input_weights;
+      direction.recurrent_to_forget_weights = recurrent_to_forget_weights;
+      direction.recurrent_to_cell_weights = recurrent_to_cell_weights;
+      direction.recurrent_to_output_weights = recurrent_to_output_weights;
+      direction.cell_to_input_weights = cell_to_input_weights;
+      direction.cell_to_forget_weights = cell_to_forget_weights;
+      direction.cell_to_output_weights = cell_to_output_weights;
+      direction.input_layer_norm_coefficients = input_layer_norm_coefficients;
+      direction.forget_layer_norm_coefficients = forget_layer_norm_coefficients;
+      direction.cell_layer_norm_coefficients = cell_layer_norm_coefficients;
+      direction.output_layer_norm_coefficients = output_layer_norm_coefficients;
+      direction.input_gate_bias = input_gate_bias;
+      direction.forget_gate_bias = forget_gate_bias;
+      direction.cell_gate_bias = cell_gate_bias;
+      direction.output_gate_bias = output_gate_bias;
+      direction.projection_weights = projection_weights;
+      direction.projection_bias = projection_bias;
+      direction.output_state = output_state;
+      direction.cell_state = cell_state;
+      direction.output = output;
+      if (lstm_eval::CanUseFusedEvalFloat(direction)) {
+        return lstm_eval::EvalFloatFused(
+            direction, &lstm_params, time_major, &op_data->fused_float_buffers,
+            CpuBackendContext::GetFromContext(context));
+      }
       return lstm_eval::EvalFloat(
           input, input_to_input_weights, input_to_forget_weights,
           input_to_cell_weights, input_to_output_weights,
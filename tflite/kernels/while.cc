@@ -22,6 +22,7 @@ limitations under the License.
 #include "tflite/core/c/builtin_op_data.h"
 #include "tflite/core/c/common.h"
 #include "tflite/core/subgraph.h"
+#include "tflite/invocation_interrupt.h"
 #include "tflite/kernels/control_flow_common.h"
 #include "tflite/kernels/kernel_util.h"
 
@@ -317,7 +318,12 @@ TfLiteStatus Eval_dynamic(TfLiteContext* context, TfLiteNode* node) {
 
   SetupUnconsumedOutputs(node, op_data, this_subgraph, body_subgraph);
 
+  const InvocationInterrupt* interrupt = InvocationInterrupt::Get(context);
   while (true) {
+    // Stop between iterations if the invocation was cancelled or ran past its
+    // deadline. The loop state is only in tensors, so this is always safe.
+    if (interrupt && interrupt->ShouldStop()) return kTfLiteCancelled;
+
     // Step 3. Eval cond subgraph
     bool cond_subgraph_output;
     TF_LITE_ENSURE_OK(
@@ -419,7 +425,12 @@ TfLiteStatus Eval_static(TfLiteContext* context, TfLiteNode* node) {
 
   SetupUnconsumedOutputs(node, op_data, this_subgraph, body_subgraph);
 
+  const InvocationInterrupt* interrupt = InvocationInterrupt::Get(context);
   while (true) {
+    // Stop between iterations if the invocation was cancelled or ran past its
+    // deadline. The loop state is only in tensors, so this is always safe.
+    if (interrupt && interrupt->ShouldStop()) return kTfLiteCancelled;
+
     // Step 3. Eval cond subgraph
     bool cond_subgraph_output;
     TF_LITE_ENSURE_OK(
@@ -470,7 +481,8 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
     TF_LITE_ENSURE_OK(context, Eval_static(context, node));
   }
 
-  if (!this_subgraph->ShouldPreserveAllTensors()) {
+  if (!this_subgraph->ShouldPreserveAllTensors() &&
+      !this_subgraph->ShouldKeepControlFlowSubgraphsResident()) {
     TF_LITE_ENSURE_OK(context, cond_subgraph->ReleaseMemory());
     TF_LITE_ENSURE_OK(context, body_subgraph->ReleaseMemory());
   }
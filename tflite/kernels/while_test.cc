@@ -14,7 +14,10 @@ limitations under the License.
 ==============================================================================*/
 #include <stdint.h>
 
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
 #include <memory>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
@@ -383,6 +386,74 @@ TEST_F(WhileTest, TestTriangularNumberSequence) {
   }
 }
 
+TEST_F(WhileTest, TestDeadlineExpiresDuringLoop) {
+  interpreter_ = std::make_unique<Interpreter>();
+  AddSubgraphs(2);
+  builder_->BuildLargeLessEqualCondSubgraph(interpreter_->subgraph(1), 1 << 30,
+                                            1);
+  builder_->BuildCounterOnlySubgraph(interpreter_->subgraph(2));
+  builder_->BuildMultiInputWhileSubgraph(&interpreter_->primary_subgraph(), 1);
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[0]), {1});
+
+  // Counting to 2^30 takes far longer than the deadline, which passes while the
+  // loop runs rather than before it starts.
+  interpreter_->SetInvocationDeadline(std::chrono::steady_clock::now() +
+                                      std::chrono::milliseconds(20));
+  EXPECT_EQ(interpreter_->Invoke(), kTfLiteCancelled);
+}
+
+TEST_F(WhileTest, TestCancelDuringLoop) {
+  interpreter_ = std::make_unique<Interpreter>();
+  AddSubgraphs(2);
+  builder_->BuildLargeLessEqualCondSubgraph(interpreter_->subgraph(1), 1 << 30,
+                                            1);
+  builder_->BuildCounterOnlySubgraph(interpreter_->subgraph(2));
+  builder_->BuildMultiInputWhileSubgraph(&interpreter_->primary_subgraph(), 1);
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[0]), {1});
+  ASSERT_EQ(interpreter_->EnableCancellation(), kTfLiteOk);
+
+  // Invoke resets cancellation when it starts, so keep cancelling until it
+  // returns.
+  std::atomic<bool> done{false};
+  std::thread canceller([&]() {
+    while (!done.load()) {
+      interpreter_->Cancel();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  EXPECT_EQ(interpreter_->Invoke(), kTfLiteCancelled);
+  done.store(true);
+  canceller.join();
+}
+
+TEST_F(WhileTest, TestInterruptibleLoopResultIsUnchanged) {
+  interpreter_ = std::make_unique<Interpreter>();
+  AddSubgraphs(2);
+  builder_->BuildLessEqualCondSubgraph(interpreter_->subgraph(1), 6);
+  builder_->BuildAccumulateLoopBodySubgraph(interpreter_->subgraph(2));
+  builder_->BuildWhileSubgraph(&interpreter_->primary_subgraph());
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {1}),
+            kTfLiteOk);
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(interpreter_->EnableCancellation(), kTfLiteOk);
+  interpreter_->SetInvocationDeadline(std::chrono::steady_clock::now() +
+                                      std::chrono::hours(1));
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[0]), {1});
+  FillIntTensor(interpreter_->tensor(interpreter_->inputs()[1]), {1});
+
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  CheckIntTensor(interpreter_->tensor(interpreter_->outputs()[0]), {1}, {7});
+  CheckIntTensor(interpreter_->tensor(interpreter_->outputs()[1]), {1}, {28});
+}
+
 TEST_F(WhileTest, TestTriangularNumberSequenceWithShallowCopy) {
   const std::vector<int> expected = {1, 3, 6, 10, 15, 21, 28};
   for (int i = 0; i < expected.size(); ++i) {
@@ -0,0 +1,234 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/memory_placement.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace tflite {
+namespace {
+
+#if defined(__linux__)
+constexpr size_t kHugePageSize = size_t{2} << 20;
+// From <linux/mempolicy.h>, which isn't always installed.
+constexpr int kMpolPreferred = 1;
+
+size_t RoundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// Maps `bytes` of anonymous memory aligned to `alignment`, by over-allocating
+// and unmapping the misaligned head and the tail.
+void* MapAligned(size_t bytes, size_t alignment) {
+  const size_t padded_bytes = bytes + alignment;
+  void* mapping = mmap(nullptr, padded_bytes, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) return nullptr;
+  char* const begin = static_cast<char*>(mapping);
+  char* const aligned = reinterpret_cast<char*>(
+      RoundUp(reinterpret_cast<uintptr_t>(begin), alignment));
+  if (aligned != begin) {
+    munmap(begin, aligned - begin);
+  }
+  const size_t tail = (begin + padded_bytes) - (aligned + bytes);
+  if (tail > 0) {
+    munmap(aligned + bytes, tail);
+  }
+  return aligned;
+}
+
+// Prefers `node` for the pages of [data, data + bytes) that haven't been
+// touched yet.
+void BindToNode(void* data, size_t bytes, int node) {
+#if defined(SYS_mbind)
+  constexpr int kBitsPerMask = 8 * sizeof(unsigned long);  // NOLINT
+  std::vector<unsigned long> node_mask(node / kBitsPerMask + 1, 0);  // NOLINT
+  node_mask[node / kBitsPerMask] = 1UL << (node % kBitsPerMask);
+  // mbind expects the number of bits of the mask plus one.
+  syscall(SYS_mbind, data, bytes, kMpolPreferred, node_mask.data(),
+          node_mask.size() * kBitsPerMask + 1, 0);
+#endif  // SYS_mbind
+}
+
+// Parses a sysfs list such as "0-3,8,10-11".
+std::vector<int> ParseIdList(const std::string& list) {
+  std::vector<int> ids;
+  const char* cursor = list.c_str();
+  while (*cursor != '\0' && *cursor != '\n') {
+    char* end = nullptr;
+    const long first = std::strtol(cursor, &end, 10);  // NOLINT
+    if (end == cursor || first < 0) return {};
+    long last = first;  // NOLINT
+    cursor = end;
+    if (*cursor == '-') {
+      ++cursor;
+      last = std::strtol(cursor, &end, 10);
+      if (end == cursor || last < first) return {};
+      cursor = end;
+    }
+    for (long id = first; id <= last; ++id) {  // NOLINT
+      ids.push_back(static_cast<int>(id));
+    }
+    if (*cursor == ',') ++cursor;
+  }
+  return ids;
+}
+
+std::string ReadFirstLine(const std::string& path) {
+  std::string line;
+  FILE* file = std::fopen(path.c_str(), "r");
+  if (file == nullptr) return line;
+  char buffer[4096];
+  if (std::fgets(buffer, sizeof(buffer), file) != nullptr) {
+    line = buffer;
+  }
+  std::fclose(file);
+  return line;
+}
+#endif  // __linux__
+
+}  // namespace
+
+PlacedAllocation AllocatePlaced(size_t bytes,
+                                const MemoryPlacement& placement) {
+  PlacedAllocation allocation;
+#if defined(__linux__)
+  if (bytes == 0) return allocation;
+  if (placement.huge_pages == HugePageMode::kNone) {
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    allocation.mapped_bytes = RoundUp(bytes, page_size);
+    allocation.data = MapAligned(allocation.mapped_bytes, page_size);
+  } else {
+    allocation.mapped_bytes = RoundUp(bytes, kHugePageSize);
+#if defined(MAP_HUGETLB)
+    if (placement.huge_pages == HugePageMode::kExplicit) {
+      void* mapping =
+          mmap(nullptr, allocation.mapped_bytes, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      allocation.data = mapping == MAP_FAILED ? nullptr : mapping;
+    }
+#endif  // MAP_HUGETLB
+    if (allocation.data == nullptr) {
+      allocation.data = MapAligned(allocation.mapped_bytes, kHugePageSize);
+#if defined(MADV_HUGEPAGE)
+      if (allocation.data != nullptr) {
+        madvise(allocation.data, allocation.mapped_bytes, MADV_HUGEPAGE);
+      }
+#endif  // MADV_HUGEPAGE
+    }
+  }
+  if (allocation.data == nullptr) {
+    return PlacedAllocation();
+  }
+  if (placement.numa_node >= 0) {
+    BindToNode(allocation.data, allocation.mapped_bytes, placement.numa_node);
+  }
+#endif  // __linux__
+  return allocation;
+}
+
+void FreePlaced(const PlacedAllocation& allocation) {
+#if defined(__linux__)
+  if (allocation.data != nullptr) {
+    munmap(allocation.data, allocation.mapped_bytes);
+  }
+#endif  // __linux__
+}
+
+std::unique_ptr<PlacedBuffer> PlacedBuffer::CopyOf(
+    const void* data, size_t bytes, const MemoryPlacement& placement) {
+  const PlacedAllocation allocation = AllocatePlaced(bytes, placement);
+  if (allocation.data == nullptr) return nullptr;
+  // The copy faults the pages in, on the preferred node.
+  std::memcpy(allocation.data, data, bytes);
+  return std::unique_ptr<PlacedBuffer>(new PlacedBuffer(allocation, bytes));
+}
+
+int NumNumaNodes() {
+#if defined(__linux__)
+  const std::vector<int> nodes =
+      ParseIdList(ReadFirstLine("/sys/devices/system/node/online"));
+  if (!nodes.empty()) return nodes.back() + 1;
+#endif  // __linux__
+  return 1;
+}
+
+int CurrentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif  // __linux__ && SYS_getcpu
+  return -1;
+}
+
+std::vector<int> NumaNodeCpus(int node) {
+#if defined(__linux__)
+  if (node >= 0) {
+    return ParseIdList(ReadFirstLine("/sys/devices/system/node/node" +
+                                     std::to_string(node) + "/cpulist"));
+  }
+#endif  // __linux__
+  return {};
+}
+
+bool PinCurrentThreadToNumaNode(int node) {
+  return SetCurrentThreadCpus(NumaNodeCpus(node));
+}
+
+std::vector<int> CurrentThreadCpus() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+  }
+#endif  // __linux__
+  return cpus;
+}
+
+bool SetCurrentThreadCpus(const std::vector<int>& cpus) {
+#if defined(__linux__)
+  if (cpus.empty()) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+  }
+  // A pid of 0 is the calling thread, not the whole process.
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else   // !__linux__
+  return false;
+#endif  // __linux__
+}
+
+}  // namespace tflite
@@ -0,0 +1,128 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_MEMORY_PLACEMENT_H_
+#define TENSORFLOW_LITE_MEMORY_PLACEMENT_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tflite {
+
+// How large allocations are backed with huge pages.
+enum class HugePageMode {
+  // Regular pages.
+  kNone,
+  // Anonymous memory aligned to and advised for transparent huge pages
+  // (MADV_HUGEPAGE). The kernel backs it with huge pages when it can.
+  kTransparent,
+  // Pages from the hugetlbfs pool (MAP_HUGETLB), which must have been
+  // reserved, e.g. through /proc/sys/vm/nr_hugepages. Falls back to
+  // kTransparent when the pool is exhausted.
+  kExplicit,
+};
+
+// Where large buffers such as arenas and weight replicas are placed in
+// memory. The default placement leaves allocations to the heap.
+//
+// WARNING: This is an experimental API and subject to change.
+struct MemoryPlacement {
+  HugePageMode huge_pages = HugePageMode::kNone;
+  // NUMA node the pages are preferably allocated on, or -1 for the default
+  // policy of the calling thread. The binding is a preference, pages come
+  // from other nodes when the node is out of memory.
+  int numa_node = -1;
+  // Buffers smaller than this are left to the heap.
+  size_t min_bytes = size_t{2} << 20;
+
+  // Returns true if a buffer of `bytes` should be placed.
+  bool Applies(size_t bytes) const {
+    return (huge_pages != HugePageMode::kNone || numa_node >= 0) &&
+           bytes >= min_bytes;
+  }
+};
+
+// A buffer returned by `AllocatePlaced`. `data` is aligned to at least the
+// page size.
+struct PlacedAllocation {
+  void* data = nullptr;
+  // Size of the mapping backing `data`, 0 if the allocation failed.
+  size_t mapped_bytes = 0;
+};
+
+// Maps at least `bytes` of zeroed anonymous memory placed according to
+// `placement`. Returns an empty allocation if the platform doesn't support
+// placing memory or mapping fails, in which case callers should fall back to
+// the heap.
+PlacedAllocation AllocatePlaced(size_t bytes, const MemoryPlacement& placement);
+
+// Unmaps an allocation returned by `AllocatePlaced`. Empty allocations are
+// ignored.
+void FreePlaced(const PlacedAllocation& allocation);
+
+// A read-only copy of a buffer placed according to a `MemoryPlacement`, e.g.
+// to give each NUMA node its own replica of large model weights.
+class PlacedBuffer {
+ public:
+  // Copies `bytes` from `data`. Returns nullptr if the memory couldn't be
+  // placed.
+  static std::unique_ptr<PlacedBuffer> CopyOf(const void* data, size_t bytes,
+                                              const MemoryPlacement& placement);
+
+  ~PlacedBuffer() { FreePlaced(allocation_); }
+
+  const char* data() const {
+    return static_cast<const char*>(allocation_.data);
+  }
+  size_t size() const { return size_; }
+
+ private:
+  PlacedBuffer(PlacedAllocation allocation, size_t size)
+      : allocation_(allocation), size_(size) {}
+  PlacedBuffer(const PlacedBuffer&) = delete;
+  PlacedBuffer& operator=(const PlacedBuffer&) = delete;
+
+  const PlacedAllocation allocation_;
+  const size_t size_;
+};
+
+// Returns the number of NUMA nodes of the host, 1 if it can't be determined.
+int NumNumaNodes();
+
+// Returns the NUMA node the calling thread runs on, or -1 if it can't be
+// determined.
+int CurrentNumaNode();
+
+// Returns the CPUs of NUMA node `node`, empty if it can't be determined.
+std::vector<int> NumaNodeCpus(int node);
+
+// Restricts the calling thread to the CPUs of NUMA node `node`. Threads it
+// creates afterwards, e.g. the workers of thread pools created lazily, inherit
+// the restriction. Returns false if the node's CPUs are unknown or the
+// affinity couldn't be set.
+bool PinCurrentThreadToNumaNode(int node);
+
+// Returns the CPUs the calling thread may run on, empty if they can't be
+// determined.
+std::vector<int> CurrentThreadCpus();
+
+// Restricts the calling thread to `cpus`, e.g. to restore an affinity saved
+// with `CurrentThreadCpus`. Returns false if `cpus` is empty or the affinity
+// couldn't be set.
+bool SetCurrentThreadCpus(const std::vector<int>& cpus);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MEMORY_PLACEMENT_H_
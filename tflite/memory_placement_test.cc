@@ -0,0 +1,150 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/memory_placement.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif  // __linux__
+
+namespace tflite {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr size_t kHugePageSize = size_t{2} << 20;
+
+TEST(MemoryPlacementTest, Applies) {
+  MemoryPlacement placement;
+  EXPECT_FALSE(placement.Applies(size_t{1} << 30));
+
+  placement.huge_pages = HugePageMode::kTransparent;
+  EXPECT_TRUE(placement.Applies(placement.min_bytes));
+  EXPECT_FALSE(placement.Applies(placement.min_bytes - 1));
+
+  placement.huge_pages = HugePageMode::kNone;
+  placement.numa_node = 0;
+  EXPECT_TRUE(placement.Applies(placement.min_bytes));
+}
+
+#if defined(__linux__)
+
+void ExpectUsable(const PlacedAllocation& allocation, size_t bytes,
+                  size_t alignment) {
+  ASSERT_NE(allocation.data, nullptr);
+  EXPECT_GE(allocation.mapped_bytes, bytes);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation.data) % alignment, 0);
+  const char* data = static_cast<const char*>(allocation.data);
+  EXPECT_EQ(data[0], 0);
+  EXPECT_EQ(data[bytes - 1], 0);
+  std::memset(allocation.data, 1, bytes);
+}
+
+TEST(MemoryPlacementTest, AllocatesRegularPagesOnNode) {
+  MemoryPlacement placement;
+  placement.numa_node = std::max(CurrentNumaNode(), 0);
+  const size_t bytes = 12345;
+  const PlacedAllocation allocation = AllocatePlaced(bytes, placement);
+  ExpectUsable(allocation, bytes, 4096);
+  FreePlaced(allocation);
+}
+
+TEST(MemoryPlacementTest, AllocatesTransparentHugePages) {
+  MemoryPlacement placement;
+  placement.huge_pages = HugePageMode::kTransparent;
+  const size_t bytes = kHugePageSize + 1;
+  const PlacedAllocation allocation = AllocatePlaced(bytes, placement);
+  ExpectUsable(allocation, bytes, kHugePageSize);
+  EXPECT_EQ(allocation.mapped_bytes, 2 * kHugePageSize);
+  FreePlaced(allocation);
+}
+
+TEST(MemoryPlacementTest, ExplicitHugePagesFallBack) {
+  // Succeeds whether or not huge pages are reserved on the host.
+  MemoryPlacement placement;
+  placement.huge_pages = HugePageMode::kExplicit;
+  const PlacedAllocation allocation = AllocatePlaced(kHugePageSize, placement);
+  ExpectUsable(allocation, kHugePageSize, kHugePageSize);
+  FreePlaced(allocation);
+}
+
+TEST(MemoryPlacementTest, EmptyAllocation) {
+  const PlacedAllocation allocation = AllocatePlaced(0, MemoryPlacement());
+  EXPECT_EQ(allocation.data, nullptr);
+  EXPECT_EQ(allocation.mapped_bytes, 0);
+  FreePlaced(allocation);
+}
+
+TEST(MemoryPlacementTest, PlacedBufferCopies) {
+  std::vector<char> weights(100000);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    weights[i] = static_cast<char>(i * 7);
+  }
+  MemoryPlacement placement;
+  placement.huge_pages = HugePageMode::kTransparent;
+  std::unique_ptr<PlacedBuffer> copy =
+      PlacedBuffer::CopyOf(weights.data(), weights.size(), placement);
+  ASSERT_NE(copy, nullptr);
+  EXPECT_EQ(copy->size(), weights.size());
+  EXPECT_EQ(std::memcmp(copy->data(), weights.data(), weights.size()), 0);
+}
+
+TEST(MemoryPlacementTest, PinsToNode) {
+  EXPECT_GE(NumNumaNodes(), 1);
+  const int node = CurrentNumaNode();
+  const std::vector<int> cpus = NumaNodeCpus(node);
+  if (cpus.empty()) {
+    GTEST_SKIP() << "NUMA topology not available.";
+  }
+  cpu_set_t original;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(original), &original), 0);
+
+  ASSERT_TRUE(PinCurrentThreadToNumaNode(node));
+  EXPECT_EQ(CurrentNumaNode(), node);
+
+  ASSERT_EQ(sched_setaffinity(0, sizeof(original), &original), 0);
+}
+
+TEST(MemoryPlacementTest, RestoresThreadCpus) {
+  const std::vector<int> original = CurrentThreadCpus();
+  ASSERT_FALSE(original.empty());
+
+  ASSERT_TRUE(SetCurrentThreadCpus({original.front()}));
+  EXPECT_THAT(CurrentThreadCpus(), ElementsAre(original.front()));
+
+  ASSERT_TRUE(SetCurrentThreadCpus(original));
+  EXPECT_EQ(CurrentThreadCpus(), original);
+}
+
+#endif  // __linux__
+
+TEST(MemoryPlacementTest, UnknownNode) {
+  EXPECT_TRUE(NumaNodeCpus(-1).empty());
+  EXPECT_FALSE(PinCurrentThreadToNumaNode(-1));
+  EXPECT_FALSE(SetCurrentThreadCpus({}));
+}
+
+}  // namespace
+}  // namespace tflite
@@ -15,12 +15,32 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_MEMORY_PLANNER_H_
 #define TENSORFLOW_LITE_MEMORY_PLANNER_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "tflite/core/c/common.h"
 
 namespace tflite {
 
+// The arena placement of a single tensor, as decided by a MemoryPlanner.
+struct PlannedAllocation {
+  int32_t tensor;
+  // True for tensors placed in the persistent arena.
+  bool persistent;
+  size_t offset;
+  size_t size;
+  int32_t first_node;
+  int32_t last_node;
+};
+
+// The arena placements of all tensors of a subgraph. A snapshot exported
+// after AllocateTensors() can be imported into a fresh planner for the same
+// graph to reproduce the same plan without searching for offsets again.
+struct MemoryPlanSnapshot {
+  std::vector<PlannedAllocation> allocations;
+};
+
 // A MemoryPlanner is responsible for planning and executing a number of
 // memory-related operations that are necessary in TF Lite.
 class MemoryPlanner {
@@ -69,6 +89,21 @@ class MemoryPlanner {
   // Returns a map of allocation information. It's only used for debugging.
   virtual void GetAllocInfo(size_t *arena_size,
                             size_t *arena_persist_size) const = 0;
+
+  // Exports the placements computed by the last ExecuteAllocations() calls.
+  // Returns kTfLiteError if the planner doesn't support snapshots.
+  virtual TfLiteStatus ExportPlan(MemoryPlanSnapshot* snapshot) const {
+    return kTfLiteError;
+  }
+
+  // Makes the next ExecuteAllocations() calls reuse the placements of
+  // `snapshot` for every tensor whose size and lifetime still match. The
+  // planner falls back to computing placements as soon as a tensor doesn't
+  // match. The imported plan is dropped by ResetAllocations().
+  // Returns kTfLiteError if the planner doesn't support snapshots.
+  virtual TfLiteStatus ImportPlan(const MemoryPlanSnapshot& snapshot) {
+    return kTfLiteError;
+  }
 };
 
 }  // namespace tflite
@@ -0,0 +1,180 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/profiling/delegate_partition_profiler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/str_join.h"  // from @com_google_absl
+#include "tflite/core/api/profiler.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/profiling/proto/model_runtime_info.pb.h"
+#include "tflite/profiling/time.h"
+
+namespace tflite::profiling {
+
+uint32_t DelegatePartitionProfiler::BeginEvent(const char* tag,
+                                               EventType event_type,
+                                               int64_t event_metadata1,
+                                               int64_t event_metadata2) {
+  Event event;
+  if (enabled_) {
+    if (event_type == EventType::OPERATOR_INVOKE_EVENT &&
+        active_partition_ == nullptr) {
+      // `event_metadata1` is the node index and `event_metadata2` the subgraph
+      // index.
+      const Subgraph* subgraph = interpreter_.subgraph(event_metadata2);
+      const auto* node_and_reg =
+          subgraph == nullptr
+              ? nullptr
+              : subgraph->node_and_registration(event_metadata1);
+      if (node_and_reg != nullptr && node_and_reg->first.delegate != nullptr) {
+        event.partition = &stats_[{event_metadata2, event_metadata1}];
+        active_partition_ = event.partition;
+        delegate_op_depth_ = 0;
+      }
+    } else if (event_type == EventType::DELEGATE_OPERATOR_INVOKE_EVENT &&
+               active_partition_ != nullptr) {
+      // Delegate ops may nest, only the outermost ones are timed.
+      event.is_delegate_op = true;
+      event.is_outermost_delegate_op = delegate_op_depth_++ == 0;
+    }
+    if (event.partition != nullptr || event.is_outermost_delegate_op) {
+      event.begin_us = time::NowMicros();
+    }
+  }
+  events_.push_back(event);
+  return events_.size();
+}
+
+void DelegatePartitionProfiler::EndEvent(uint32_t event_handle) {
+  if (!event_handle || events_.size() < event_handle) {
+    return;
+  }
+  const Event event = events_[event_handle - 1];
+  events_.resize(event_handle - 1);
+
+  if (event.partition != nullptr) {
+    event.partition->num_invocations++;
+    event.partition->invoke_us += time::NowMicros() - event.begin_us;
+    active_partition_ = nullptr;
+  } else if (event.is_delegate_op && active_partition_ != nullptr) {
+    --delegate_op_depth_;
+    if (event.is_outermost_delegate_op) {
+      active_partition_->delegate_ops_us += time::NowMicros() - event.begin_us;
+      active_partition_->has_delegate_ops = true;
+    }
+  }
+}
+
+void DelegatePartitionProfiler::AddEvent(const char* tag, EventType event_type,
+                                         uint64_t metric,
+                                         int64_t event_metadata1,
+                                         int64_t event_metadata2) {
+  // Delegates that profile their ops themselves report them after the fact,
+  // with `metric` being the elapsed time in microseconds.
+  if (!enabled_ || active_partition_ == nullptr ||
+      (event_type != EventType::DELEGATE_OPERATOR_INVOKE_EVENT &&
+       event_type != EventType::DELEGATE_PROFILED_OPERATOR_INVOKE_EVENT)) {
+    return;
+  }
+  active_partition_->delegate_ops_us += metric;
+  active_partition_->has_delegate_ops = true;
+}
+
+void DelegatePartitionProfiler::AddTimings(
+    ModelRuntimeDetails& model_runtime_details) const {
+  for (RuntimeSubgraph& subgraph : *model_runtime_details.mutable_subgraphs()) {
+    for (DelegatePartition& partition : *subgraph.mutable_partitions()) {
+      const auto it =
+          stats_.find({subgraph.subgraph_id(), partition.node_id()});
+      if (it == stats_.end() || it->second.num_invocations == 0) {
+        continue;
+      }
+      const PartitionStats& stats = it->second;
+      const double num_invocations = stats.num_invocations;
+      partition.set_invoke_us(stats.invoke_us / num_invocations);
+      if (stats.has_delegate_ops) {
+        partition.set_delegate_ops_us(stats.delegate_ops_us / num_invocations);
+        // Delegates may report ops that overlap, e.g. when running them on
+        // several threads, so the difference can be negative.
+        partition.set_handoff_us(std::max(
+            0.0, partition.invoke_us() - partition.delegate_ops_us()));
+      }
+    }
+  }
+}
+
+std::string DelegatePartitionReport(
+    const ModelRuntimeDetails& model_runtime_details) {
+  std::string report;
+  for (const RuntimeSubgraph& subgraph : model_runtime_details.subgraphs()) {
+    if (subgraph.partitions().empty()) {
+      continue;
+    }
+    int num_delegated_ops = 0;
+    for (const DelegatePartition& partition : subgraph.partitions()) {
+      num_delegated_ops += partition.num_ops();
+    }
+    const int num_cpu_ops =
+        subgraph.execution_plan_size() - subgraph.partitions_size();
+    absl::StrAppendFormat(
+        &report,
+        "Subgraph #%d (%s): %d delegate partitions with %d ops, %d ops on "
+        "CPU\n",
+        subgraph.subgraph_id(), subgraph.name(), subgraph.partitions_size(),
+        num_delegated_ops, num_cpu_ops);
+
+    for (const DelegatePartition& partition : subgraph.partitions()) {
+      absl::StrAppendFormat(&report, "  Partition node #%d (%s): %d ops\n",
+                            partition.node_id(), partition.delegate_name(),
+                            partition.num_ops());
+      auto append_edges = [&](const char* direction, const auto& edge_ids) {
+        for (const int edge_id : edge_ids) {
+          const Edge& edge = subgraph.edges(edge_id);
+          absl::StrAppendFormat(&report, "    %s tensor #%d (%s): %d bytes\n",
+                                direction, edge.id(), edge.name(), edge.size());
+        }
+      };
+      append_edges("input", partition.input_edge_ids());
+      append_edges("output", partition.output_edge_ids());
+      absl::StrAppendFormat(&report,
+                            "    boundary bytes per invocation: %d\n",
+                            partition.boundary_bytes());
+      if (partition.has_invoke_us()) {
+        absl::StrAppendFormat(&report, "    invoke: %.3f us",
+                              partition.invoke_us());
+        if (partition.has_delegate_ops_us()) {
+          absl::StrAppendFormat(&report,
+                                ", delegate ops: %.3f us, hand-off: %.3f us",
+                                partition.delegate_ops_us(),
+                                partition.handoff_us());
+        }
+        report += "\n";
+      }
+      if (!partition.split_ops().empty()) {
+        absl::StrAppendFormat(&report,
+                              "    split from the next partition by: %s\n",
+                              absl::StrJoin(partition.split_ops(), ", "));
+      }
+    }
+  }
+  return report;
+}
+
+}  // namespace tflite::profiling
@@ -0,0 +1,103 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_DELEGATE_PARTITION_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_DELEGATE_PARTITION_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tflite/core/api/profiler.h"
+#include "tflite/interpreter.h"
+#include "tflite/profiling/proto/model_runtime_info.pb.h"
+
+namespace tflite::profiling {
+
+// Measures how long the delegate nodes of an interpreter take and how much of
+// that is spent in the ops of the delegate, so that the cost of handing data
+// over to and back from each delegate partition can be told apart from the
+// work the delegate does.
+//
+// Delegates only report their ops to profilers that are installed before they
+// are applied, so this should be added to the interpreter (see
+// `Interpreter::AddProfiler`) before `ModifyGraphWithDelegate` is called.
+// Otherwise only the total time of each partition is measured.
+class DelegatePartitionProfiler : public tflite::Profiler {
+ public:
+  explicit DelegatePartitionProfiler(const Interpreter& interpreter)
+      : interpreter_(interpreter) {}
+
+  // Only events between `StartProfiling` and `StopProfiling` are measured.
+  void StartProfiling() { enabled_ = true; }
+  void StopProfiling() { enabled_ = false; }
+
+  // Drops the measurements so far. Must not be called during an invocation.
+  void Reset() { stats_.clear(); }
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override;
+
+  void EndEvent(uint32_t event_handle) override;
+
+  void AddEvent(const char* tag, EventType event_type, uint64_t metric,
+                int64_t event_metadata1, int64_t event_metadata2) override;
+
+  // Sets the timing fields of the partitions of `model_runtime_details`, which
+  // must have been generated from the interpreter being profiled.
+  void AddTimings(ModelRuntimeDetails& model_runtime_details) const;
+
+ private:
+  struct PartitionStats {
+    uint64_t num_invocations = 0;
+    uint64_t invoke_us = 0;
+    uint64_t delegate_ops_us = 0;
+    bool has_delegate_ops = false;
+  };
+
+  struct Event {
+    uint64_t begin_us = 0;
+    // Stats of the partition whose invocation this event is, if any.
+    PartitionStats* partition = nullptr;
+    // Whether this event is a delegate op of `active_partition_`, and if so
+    // whether it is not nested in another one.
+    bool is_delegate_op = false;
+    bool is_outermost_delegate_op = false;
+  };
+
+  const Interpreter& interpreter_;
+  bool enabled_ = false;
+
+  // Stack of the events that have begun but not ended yet.
+  std::vector<Event> events_;
+  // The partition being invoked, if any.
+  PartitionStats* active_partition_ = nullptr;
+  // Number of nested delegate op events of `active_partition_`.
+  int delegate_op_depth_ = 0;
+
+  // Keyed by subgraph and node index.
+  std::map<std::pair<int64_t, int64_t>, PartitionStats> stats_;
+};
+
+// Formats the delegate partitions of `model_runtime_details` as a human
+// readable report.
+std::string DelegatePartitionReport(
+    const ModelRuntimeDetails& model_runtime_details);
+
+}  // namespace tflite::profiling
+
+#endif  // TENSORFLOW_LITE_PROFILING_DELEGATE_PARTITION_PROFILER_H_
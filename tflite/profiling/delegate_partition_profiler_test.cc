@@ -0,0 +1,158 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/profiling/delegate_partition_profiler.h"
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/c/c_api_types.h"
+#include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tflite/interpreter.h"
+#include "tflite/kernels/test_util.h"
+#include "tflite/profiling/model_runtime_info.h"
+#include "tflite/profiling/proto/model_runtime_info.pb.h"
+#include "tflite/schema/schema_generated.h"
+
+namespace tflite {
+namespace profiling {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+
+// A model that runs add -> cumsum -> add. XNNPACK doesn't support cumsum, so
+// it claims the two adds as separate partitions.
+class SplitByCumsumModel : public MultiOpModel {
+ public:
+  explicit SplitByCumsumModel(TfLiteDelegate* delegate) {
+    input_ = AddInput({TensorType_FLOAT32, {1, 4}});
+    const int add_out = AddInnerTensor<float>({TensorType_FLOAT32, {1, 4}});
+    const int cumsum_out =
+        AddInnerTensor<float>({TensorType_FLOAT32, {1, 4}});
+    output_ = AddOutput({TensorType_FLOAT32, {1, 4}});
+    const int axis = AddConstInput({TensorType_INT32, {}}, {1});
+
+    AddBuiltinOp(BuiltinOperator_ADD, BuiltinOptions_AddOptions,
+                 CreateAddOptions(builder_).Union(), {input_, input_},
+                 {add_out});
+    AddBuiltinOp(BuiltinOperator_CUMSUM, BuiltinOptions_CumsumOptions,
+                 CreateCumsumOptions(builder_).Union(), {add_out, axis},
+                 {cumsum_out});
+    AddBuiltinOp(BuiltinOperator_ADD, BuiltinOptions_AddOptions,
+                 CreateAddOptions(builder_).Union(), {cumsum_out, cumsum_out},
+                 {output_});
+
+    SetDelegate(delegate);
+    BuildInterpreter({GetShape(input_)}, /*num_threads=*/-1,
+                     /*allow_fp32_relax_to_fp16=*/false,
+                     /*apply_delegate=*/true,
+                     /*allocate_and_delegate=*/false);
+  }
+
+  int input() const { return input_; }
+  int output() const { return output_; }
+  Interpreter* interpreter() const { return interpreter_.get(); }
+
+ private:
+  int input_;
+  int output_;
+};
+
+class DelegatePartitionProfilerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    model_ = std::make_unique<SplitByCumsumModel>(xnnpack_delegate_.get());
+    profiler_ =
+        std::make_unique<DelegatePartitionProfiler>(*model_->interpreter());
+    model_->interpreter()->AddProfiler(profiler_.get());
+    model_->AllocateAndDelegate(/*apply_delegate=*/true);
+  }
+
+  std::unique_ptr<TfLiteDelegate, decltype(&TfLiteXNNPackDelegateDelete)>
+      xnnpack_delegate_{TfLiteXNNPackDelegateCreate(nullptr),
+                        TfLiteXNNPackDelegateDelete};
+  // Outlives the model, whose interpreter refers to it.
+  std::unique_ptr<DelegatePartitionProfiler> profiler_;
+  std::unique_ptr<SplitByCumsumModel> model_;
+};
+
+TEST_F(DelegatePartitionProfilerTest, Topology) {
+  ModelRuntimeDetails details;
+  ASSERT_EQ(GenerateModelRuntimeInfo(*model_->interpreter(), details),
+            kTfLiteOk);
+  ASSERT_EQ(details.subgraphs_size(), 1);
+  const RuntimeSubgraph& subgraph = details.subgraphs(0);
+  ASSERT_EQ(subgraph.partitions_size(), 2);
+
+  // Tensors: 0 input, 1 add_out, 2 cumsum_out, 3 output, 4 axis.
+  const DelegatePartition& first = subgraph.partitions(0);
+  EXPECT_EQ(first.delegate_name(), "TfLiteXNNPackDelegate");
+  EXPECT_EQ(first.num_ops(), 1);
+  EXPECT_THAT(first.input_edge_ids(), ElementsAre(model_->input()));
+  EXPECT_THAT(first.output_edge_ids(), ElementsAre(1));
+  EXPECT_EQ(first.boundary_bytes(), 32);
+  EXPECT_THAT(first.split_ops(), ElementsAre("CUMSUM"));
+
+  const DelegatePartition& second = subgraph.partitions(1);
+  EXPECT_EQ(second.num_ops(), 1);
+  EXPECT_THAT(second.input_edge_ids(), ElementsAre(2));
+  EXPECT_THAT(second.output_edge_ids(), ElementsAre(model_->output()));
+  EXPECT_EQ(second.boundary_bytes(), 32);
+  EXPECT_THAT(second.split_ops(), IsEmpty());
+  EXPECT_FALSE(second.has_invoke_us());
+}
+
+TEST_F(DelegatePartitionProfilerTest, Timings) {
+  profiler_->StartProfiling();
+  model_->PopulateTensor<float>(model_->input(), {1.0f, 2.0f, 3.0f, 4.0f});
+  ASSERT_EQ(model_->Invoke(), kTfLiteOk);
+  ASSERT_EQ(model_->Invoke(), kTfLiteOk);
+  profiler_->StopProfiling();
+  // Not measured.
+  ASSERT_EQ(model_->Invoke(), kTfLiteOk);
+
+  ModelRuntimeDetails details;
+  ASSERT_EQ(GenerateModelRuntimeInfo(*model_->interpreter(), details),
+            kTfLiteOk);
+  profiler_->AddTimings(details);
+  for (const DelegatePartition& partition : details.subgraphs(0).partitions()) {
+    EXPECT_TRUE(partition.has_invoke_us());
+    EXPECT_GE(partition.invoke_us(), 0.0);
+    if (partition.has_delegate_ops_us()) {
+      EXPECT_GE(partition.handoff_us(), 0.0);
+      EXPECT_LE(partition.handoff_us(), partition.invoke_us());
+    }
+  }
+
+  const std::string report = DelegatePartitionReport(details);
+  EXPECT_THAT(report, HasSubstr("2 delegate partitions with 2 ops, 1 ops"));
+  EXPECT_THAT(report, HasSubstr("split from the next partition by: CUMSUM"));
+  EXPECT_THAT(report, HasSubstr("invoke: "));
+
+  profiler_->Reset();
+  details.Clear();
+  ASSERT_EQ(GenerateModelRuntimeInfo(*model_->interpreter(), details),
+            kTfLiteOk);
+  profiler_->AddTimings(details);
+  EXPECT_FALSE(details.subgraphs(0).partitions(0).has_invoke_us());
+}
+
+}  // namespace
+}  // namespace profiling
+}  // namespace tflite
@@ -0,0 +1,319 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/profiling/memory_timeline_profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/str_format.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "tflite/core/api/profiler.h"
+#include "tflite/core/c/common.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/memory_planner.h"
+#include "tflite/profiling/time.h"
+#include "tflite/util.h"
+
+namespace tflite::profiling {
+namespace {
+
+std::string TensorName(const TfLiteTensor& tensor) {
+  return tensor.name == nullptr ? "" : tensor.name;
+}
+
+void AppendJsonString(std::string* out, absl::string_view value) {
+  out->push_back('"');
+  for (const char c : value) {
+    if (c == '"' || c == '\\') {
+      out->push_back('\\');
+      out->push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      absl::StrAppendFormat(out, "\\u%04x", static_cast<int>(c));
+    } else {
+      out->push_back(c);
+    }
+  }
+  out->push_back('"');
+}
+
+}  // namespace
+
+uint32_t MemoryTimelineProfiler::BeginEvent(const char* tag,
+                                            EventType event_type,
+                                            int64_t event_metadata1,
+                                            int64_t event_metadata2) {
+  // Subgraph events carry the subgraph index in `event_metadata2`, operator
+  // events the node index in `event_metadata1`.
+  Event event;
+  event.subgraph_index = event_metadata2;
+  event.node_index = event_metadata1;
+  if (event_type == EventType::OPERATOR_INVOKE_EVENT) {
+    event.kind = EventKind::kOperator;
+  } else if (event_type == EventType::DEFAULT && tag != nullptr) {
+    if (!strcmp(tag, "AllocateTensors")) {
+      event.kind = EventKind::kAllocateTensors;
+    } else if (!strcmp(tag, "Invoke")) {
+      event.kind = EventKind::kInvoke;
+      BeginInvoke(event.subgraph_index);
+    }
+  }
+  events_.push_back(event);
+  return events_.size();
+}
+
+void MemoryTimelineProfiler::EndEvent(uint32_t event_handle) {
+  if (!event_handle || events_.size() < event_handle) {
+    return;
+  }
+  const Event event = events_[event_handle - 1];
+  events_.resize(event_handle - 1);
+
+  switch (event.kind) {
+    case EventKind::kAllocateTensors:
+    case EventKind::kInvoke:
+      RecordPlan(event.subgraph_index);
+      break;
+    case EventKind::kOperator:
+      EndOperator(event.subgraph_index, event.node_index);
+      break;
+    case EventKind::kOther:
+      break;
+  }
+}
+
+void MemoryTimelineProfiler::RecordPlan(int64_t subgraph_index) {
+  const Subgraph* subgraph = interpreter_.subgraph(subgraph_index);
+  if (subgraph == nullptr) return;
+  SubgraphRecord& record = subgraphs_[subgraph_index];
+  if (subgraph->ExportMemoryPlan(&record.plan) != kTfLiteOk) {
+    record.plan.allocations.clear();
+  }
+  Subgraph::SubgraphAllocInfo alloc_info;
+  subgraph->GetMemoryAllocInfo(&alloc_info);
+  record.arena_bytes = alloc_info.arena_size;
+  record.persistent_arena_bytes = alloc_info.arena_persist_size;
+}
+
+void MemoryTimelineProfiler::BeginInvoke(int64_t subgraph_index) {
+  const Subgraph* subgraph = interpreter_.subgraph(subgraph_index);
+  if (subgraph == nullptr) return;
+  SubgraphRecord& record = subgraphs_[subgraph_index];
+  const std::vector<int>& execution_plan = subgraph->execution_plan();
+  record.node_steps.assign(subgraph->nodes_size(), -1);
+  for (int step = 0; step < execution_plan.size(); ++step) {
+    record.node_steps[execution_plan[step]] = step;
+  }
+  record.step_end_us.assign(execution_plan.size(), -1);
+  record.step_dynamic_bytes.assign(execution_plan.size(), 0);
+  record.dynamic_allocations.clear();
+  record.invoke_begin_us = time::NowMicros();
+}
+
+void MemoryTimelineProfiler::EndOperator(int64_t subgraph_index,
+                                         int64_t node_index) {
+  const Subgraph* subgraph = interpreter_.subgraph(subgraph_index);
+  const auto it = subgraphs_.find(subgraph_index);
+  if (subgraph == nullptr || it == subgraphs_.end()) return;
+  SubgraphRecord& record = it->second;
+  if (node_index < 0 || node_index >= record.node_steps.size() ||
+      record.node_steps[node_index] < 0) {
+    return;
+  }
+  const int step = record.node_steps[node_index];
+
+  const int num_tensors = subgraph->tensors_size();
+  record.dynamic_data.resize(num_tensors, nullptr);
+  record.dynamic_bytes.resize(num_tensors, 0);
+  size_t dynamic_bytes = 0;
+  for (int i = 0; i < num_tensors; ++i) {
+    const TfLiteTensor& tensor = *subgraph->tensor(i);
+    if (tensor.allocation_type != kTfLiteDynamic ||
+        tensor.data.raw == nullptr) {
+      continue;
+    }
+    dynamic_bytes += tensor.bytes;
+    if (tensor.data.raw != record.dynamic_data[i] ||
+        tensor.bytes != record.dynamic_bytes[i]) {
+      record.dynamic_data[i] = tensor.data.raw;
+      record.dynamic_bytes[i] = tensor.bytes;
+      record.dynamic_allocations.push_back(
+          {step, i, TensorName(tensor), tensor.bytes});
+    }
+  }
+  record.step_dynamic_bytes[step] = dynamic_bytes;
+  record.step_end_us[step] = time::NowMicros() - record.invoke_begin_us;
+}
+
+std::vector<SubgraphMemoryTimeline> MemoryTimelineProfiler::GetTimelines()
+    const {
+  std::vector<SubgraphMemoryTimeline> timelines;
+  for (const auto& [subgraph_index, record] : subgraphs_) {
+    const Subgraph* subgraph = interpreter_.subgraph(subgraph_index);
+    if (subgraph == nullptr) continue;
+    const std::vector<int>& execution_plan = subgraph->execution_plan();
+    const int last_step =
+        std::max(static_cast<int>(execution_plan.size()) - 1, 0);
+
+    SubgraphMemoryTimeline timeline;
+    timeline.subgraph_index = subgraph_index;
+    timeline.arena_bytes = record.arena_bytes;
+    timeline.persistent_arena_bytes = record.persistent_arena_bytes;
+    for (const PlannedAllocation& alloc : record.plan.allocations) {
+      ArenaTensor tensor;
+      tensor.tensor = alloc.tensor;
+      tensor.name = TensorName(*subgraph->tensor(alloc.tensor));
+      tensor.persistent = alloc.persistent;
+      tensor.offset = alloc.offset;
+      tensor.size = alloc.size;
+      tensor.first_step = std::clamp<int>(alloc.first_node, 0, last_step);
+      tensor.last_step = alloc.persistent
+                             ? last_step
+                             : std::clamp<int>(alloc.last_node, 0, last_step);
+      timeline.arena_tensors.push_back(std::move(tensor));
+    }
+
+    for (int i = 0; i < execution_plan.size(); ++i) {
+      MemoryTimelineStep step;
+      step.step = i;
+      step.node_index = execution_plan[i];
+      step.op_name = GetOpNameByRegistration(
+          subgraph->node_and_registration(step.node_index)->second);
+      if (i < record.step_end_us.size()) {
+        step.end_us = record.step_end_us[i];
+        step.dynamic_bytes = record.step_dynamic_bytes[i];
+      }
+      for (const ArenaTensor& tensor : timeline.arena_tensors) {
+        if (tensor.persistent || i < tensor.first_step ||
+            i > tensor.last_step) {
+          continue;
+        }
+        step.live_tensors.push_back(tensor.tensor);
+        step.live_bytes += tensor.size;
+        step.extent_bytes =
+            std::max(step.extent_bytes, tensor.offset + tensor.size);
+      }
+      if (step.extent_bytes > 0) {
+        step.fragmentation =
+            1.0 - static_cast<double>(step.live_bytes) / step.extent_bytes;
+      }
+      timeline.high_water_mark_bytes =
+          std::max(timeline.high_water_mark_bytes, step.extent_bytes);
+      timeline.steps.push_back(std::move(step));
+    }
+    timeline.dynamic_allocations = record.dynamic_allocations;
+    timelines.push_back(std::move(timeline));
+  }
+  return timelines;
+}
+
+std::string MemoryTimelineToJson(
+    const std::vector<SubgraphMemoryTimeline>& timelines) {
+  std::string json = "{\"subgraphs\":[";
+  for (int s = 0; s < timelines.size(); ++s) {
+    const SubgraphMemoryTimeline& timeline = timelines[s];
+    absl::StrAppend(&json, s ? ",\n" : "\n", "{\"index\":",
+                    timeline.subgraph_index,
+                    ",\"arena_bytes\":", timeline.arena_bytes,
+                    ",\"persistent_arena_bytes\":",
+                    timeline.persistent_arena_bytes,
+                    ",\"high_water_mark_bytes\":",
+                    timeline.high_water_mark_bytes, ",\"arena_tensors\":[");
+    for (int i = 0; i < timeline.arena_tensors.size(); ++i) {
+      const ArenaTensor& tensor = timeline.arena_tensors[i];
+      absl::StrAppend(&json, i ? "," : "", "{\"tensor\":", tensor.tensor,
+                      ",\"name\":");
+      AppendJsonString(&json, tensor.name);
+      absl::StrAppend(&json, ",\"persistent\":",
+                      tensor.persistent ? "true" : "false",
+                      ",\"offset\":", tensor.offset, ",\"size\":", tensor.size,
+                      ",\"first_step\":", tensor.first_step,
+                      ",\"last_step\":", tensor.last_step, "}");
+    }
+    absl::StrAppend(&json, "],\"steps\":[");
+    for (int i = 0; i < timeline.steps.size(); ++i) {
+      const MemoryTimelineStep& step = timeline.steps[i];
+      absl::StrAppend(&json, i ? "," : "", "{\"step\":", step.step,
+                      ",\"node\":", step.node_index, ",\"op\":");
+      AppendJsonString(&json, step.op_name);
+      absl::StrAppend(&json, ",\"end_us\":", step.end_us,
+                      ",\"live_tensors\":[");
+      for (int j = 0; j < step.live_tensors.size(); ++j) {
+        absl::StrAppend(&json, j ? "," : "", step.live_tensors[j]);
+      }
+      absl::StrAppend(&json, "],\"live_bytes\":", step.live_bytes,
+                      ",\"extent_bytes\":", step.extent_bytes,
+                      ",\"fragmentation\":",
+                      absl::StrFormat("%.4f", step.fragmentation),
+                      ",\"dynamic_bytes\":", step.dynamic_bytes, "}");
+    }
+    absl::StrAppend(&json, "],\"dynamic_allocations\":[");
+    for (int i = 0; i < timeline.dynamic_allocations.size(); ++i) {
+      const DynamicTensorAllocation& alloc = timeline.dynamic_allocations[i];
+      absl::StrAppend(&json, i ? "," : "", "{\"step\":", alloc.step,
+                      ",\"tensor\":", alloc.tensor, ",\"name\":");
+      AppendJsonString(&json, alloc.name);
+      absl::StrAppend(&json, ",\"bytes\":", alloc.bytes, "}");
+    }
+    absl::StrAppend(&json, "]}");
+  }
+  absl::StrAppend(&json, "\n]}\n");
+  return json;
+}
+
+std::string MemoryTimelineToChromeTrace(
+    const std::vector<SubgraphMemoryTimeline>& timelines) {
+  std::string trace =
+      "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+      "\"args\":{\"name\":\"TFLite memory\"}}";
+  for (const SubgraphMemoryTimeline& timeline : timelines) {
+    const int tid = timeline.subgraph_index;
+    absl::StrAppend(&trace,
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                    "\"tid\":",
+                    tid, ",\"args\":{\"name\":\"Subgraph ", tid, "\"}}");
+    // Steps that didn't run are laid out one microsecond apart.
+    int64_t begin_us = 0;
+    for (const MemoryTimelineStep& step : timeline.steps) {
+      const int64_t end_us =
+          step.end_us >= 0 ? std::max(step.end_us, begin_us) : begin_us + 1;
+      absl::StrAppend(&trace, ",\n{\"name\":");
+      AppendJsonString(&trace, step.op_name);
+      absl::StrAppend(&trace, ",\"ph\":\"X\",\"pid\":0,\"tid\":", tid,
+                      ",\"ts\":", begin_us, ",\"dur\":", end_us - begin_us,
+                      ",\"args\":{\"step\":", step.step,
+                      ",\"node\":", step.node_index, "}}");
+      absl::StrAppend(&trace, ",\n{\"name\":\"Subgraph ", tid,
+                      " arena\",\"ph\":\"C\",\"pid\":0,\"ts\":", begin_us,
+                      ",\"args\":{\"live\":", step.live_bytes,
+                      ",\"fragmented\":", step.extent_bytes - step.live_bytes,
+                      "}}");
+      absl::StrAppend(&trace, ",\n{\"name\":\"Subgraph ", tid,
+                      " dynamic\",\"ph\":\"C\",\"pid\":0,\"ts\":", end_us,
+                      ",\"args\":{\"bytes\":", step.dynamic_bytes, "}}");
+      begin_us = end_us;
+    }
+  }
+  absl::StrAppend(&trace, "\n]}\n");
+  return trace;
+}
+
+}  // namespace tflite::profiling
@@ -0,0 +1,160 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_PROFILING_MEMORY_TIMELINE_PROFILER_H_
+#define TENSORFLOW_LITE_PROFILING_MEMORY_TIMELINE_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tflite/core/api/profiler.h"
+#include "tflite/interpreter.h"
+#include "tflite/memory_planner.h"
+
+namespace tflite::profiling {
+
+// A tensor placed in the arena of a subgraph. Tensors sharing the buffer of
+// another tensor aren't placed themselves.
+struct ArenaTensor {
+  int tensor = 0;
+  std::string name;
+  // True for tensors in the persistent arena, which are live at all steps.
+  bool persistent = false;
+  size_t offset = 0;
+  size_t size = 0;
+  // First and last execution plan steps during which the tensor is live.
+  int first_step = 0;
+  int last_step = 0;
+};
+
+// A dynamic tensor (re)allocated while invoking a subgraph.
+struct DynamicTensorAllocation {
+  // Execution plan step during which the tensor was allocated.
+  int step = 0;
+  int tensor = 0;
+  std::string name;
+  size_t bytes = 0;
+};
+
+// Memory usage of a subgraph during one step of its execution plan.
+struct MemoryTimelineStep {
+  int step = 0;
+  int node_index = 0;
+  std::string op_name;
+  // Microseconds from the start of the last invocation to the end of the
+  // step, or -1 if the subgraph hasn't been invoked.
+  int64_t end_us = -1;
+  // Tensors of the non-persistent arena that are live during the step.
+  std::vector<int> live_tensors;
+  size_t live_bytes = 0;
+  // End of the highest live tensor in the non-persistent arena.
+  size_t extent_bytes = 0;
+  // Share of the bytes below `extent_bytes` not used by live tensors.
+  double fragmentation = 0.0;
+  // Bytes held by dynamic tensors at the end of the step.
+  size_t dynamic_bytes = 0;
+};
+
+// Memory timeline of a subgraph, as of its last allocation and invocation.
+struct SubgraphMemoryTimeline {
+  int subgraph_index = 0;
+  size_t arena_bytes = 0;
+  size_t persistent_arena_bytes = 0;
+  // Largest `extent_bytes` over all steps. The difference to `arena_bytes`
+  // is memory the arena holds without any step using it.
+  size_t high_water_mark_bytes = 0;
+  std::vector<ArenaTensor> arena_tensors;
+  std::vector<MemoryTimelineStep> steps;
+  std::vector<DynamicTensorAllocation> dynamic_allocations;
+};
+
+// Records, for each subgraph of an interpreter, where its tensors are placed
+// in the arena and which of them are live at each step of the execution plan,
+// along with the dynamic tensors allocated while invoking it.
+//
+// Arena placements are captured at the end of each `AllocateTensors` and
+// `Invoke`, so the planner must support `MemoryPlanner::ExportPlan`. Dynamic
+// tensors are looked up after each op, which slows invocations down in
+// proportion to the number of tensors; only the last invocation of each
+// subgraph is kept.
+class MemoryTimelineProfiler : public tflite::Profiler {
+ public:
+  explicit MemoryTimelineProfiler(const Interpreter& interpreter)
+      : interpreter_(interpreter) {}
+
+  uint32_t BeginEvent(const char* tag, EventType event_type,
+                      int64_t event_metadata1,
+                      int64_t event_metadata2) override;
+
+  void EndEvent(uint32_t event_handle) override;
+
+  // Returns the timelines of the subgraphs allocated or invoked since the
+  // profiler was added, ordered by subgraph index.
+  std::vector<SubgraphMemoryTimeline> GetTimelines() const;
+
+ private:
+  enum class EventKind { kOther, kAllocateTensors, kInvoke, kOperator };
+
+  struct Event {
+    EventKind kind = EventKind::kOther;
+    int64_t subgraph_index = 0;
+    int64_t node_index = 0;
+  };
+
+  struct SubgraphRecord {
+    MemoryPlanSnapshot plan;
+    size_t arena_bytes = 0;
+    size_t persistent_arena_bytes = 0;
+    uint64_t invoke_begin_us = 0;
+    // Indexed by node.
+    std::vector<int> node_steps;
+    // Indexed by execution plan step, for the last invocation.
+    std::vector<int64_t> step_end_us;
+    std::vector<size_t> step_dynamic_bytes;
+    std::vector<DynamicTensorAllocation> dynamic_allocations;
+    // Data of each dynamic tensor when last seen, indexed by tensor.
+    std::vector<const void*> dynamic_data;
+    std::vector<size_t> dynamic_bytes;
+  };
+
+  // Captures the arena placements and sizes of `subgraph_index`.
+  void RecordPlan(int64_t subgraph_index);
+  // Resets the per step data of `subgraph_index` before it is invoked.
+  void BeginInvoke(int64_t subgraph_index);
+  // Records the dynamic tensors of `subgraph_index` after `node_index` ran.
+  void EndOperator(int64_t subgraph_index, int64_t node_index);
+
+  const Interpreter& interpreter_;
+  // Stack of the events that have begun but not ended yet.
+  std::vector<Event> events_;
+  std::map<int64_t, SubgraphRecord> subgraphs_;
+};
+
+// Formats `timelines` as JSON, with the arena placements, the live tensors of
+// each step and the dynamic allocations of each subgraph.
+std::string MemoryTimelineToJson(
+    const std::vector<SubgraphMemoryTimeline>& timelines);
+
+// Formats `timelines` in the Chrome trace event format, with a slice per op
+// and counter tracks for the live, fragmented and dynamic memory of each
+// subgraph. The result can be loaded in chrome://tracing or Perfetto.
+std::string MemoryTimelineToChromeTrace(
+    const std::vector<SubgraphMemoryTimeline>& timelines);
+
+}  // namespace tflite::profiling
+
+#endif  // TENSORFLOW_LITE_PROFILING_MEMORY_TIMELINE_PROFILER_H_
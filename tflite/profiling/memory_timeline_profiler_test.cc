@@ -0,0 +1,165 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tflite/profiling/memory_timeline_profiler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+#include "tflite/core/subgraph.h"
+#include "tflite/kernels/subgraph_test_util.h"
+
+namespace tflite::profiling {
+namespace {
+
+using ::testing::Contains;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+class MemoryTimelineProfilerTest
+    : public subgraph_test_util::ControlFlowOpTest {};
+
+// ADD -> RESHAPE -> ADD, where the reshape shares the buffer of the first ADD.
+TEST_F(MemoryTimelineProfilerTest, RecordsArenaTimeline) {
+  builder_->BuildInplaceOpSubgraph(&interpreter_->primary_subgraph());
+  MemoryTimelineProfiler profiler(*interpreter_);
+  interpreter_->AddProfiler(&profiler);
+
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {2});
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {2});
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[0]), {1, 2});
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[1]), {3, 4});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+  const std::vector<SubgraphMemoryTimeline> timelines =
+      profiler.GetTimelines();
+  ASSERT_THAT(timelines, SizeIs(1));
+  const SubgraphMemoryTimeline& timeline = timelines[0];
+  EXPECT_EQ(timeline.subgraph_index, 0);
+  EXPECT_GT(timeline.high_water_mark_bytes, 0);
+  EXPECT_LE(timeline.high_water_mark_bytes, timeline.arena_bytes);
+  EXPECT_THAT(timeline.dynamic_allocations, IsEmpty());
+
+  ASSERT_THAT(timeline.steps, SizeIs(3));
+  EXPECT_EQ(timeline.steps[0].op_name, "ADD");
+  EXPECT_EQ(timeline.steps[1].op_name, "RESHAPE");
+  EXPECT_EQ(timeline.steps[2].op_name, "ADD");
+  size_t high_water_mark = 0;
+  for (const MemoryTimelineStep& step : timeline.steps) {
+    EXPECT_GE(step.end_us, 0);
+    EXPECT_EQ(step.dynamic_bytes, 0);
+    EXPECT_GT(step.live_bytes, 0);
+    EXPECT_LE(step.live_bytes, step.extent_bytes);
+    EXPECT_GE(step.fragmentation, 0.0);
+    EXPECT_LT(step.fragmentation, 1.0);
+    high_water_mark = std::max(high_water_mark, step.extent_bytes);
+  }
+  EXPECT_EQ(timeline.high_water_mark_bytes, high_water_mark);
+
+  // The second input is read by both ADDs, so it is live at every step.
+  const int input1 = interpreter_->inputs()[1];
+  for (const MemoryTimelineStep& step : timeline.steps) {
+    EXPECT_THAT(step.live_tensors, Contains(input1));
+  }
+}
+
+// PAD with non-constant paddings, whose output is a dynamic tensor.
+TEST_F(MemoryTimelineProfilerTest, RecordsDynamicAllocations) {
+  builder_->BuildPadSubgraph(&interpreter_->primary_subgraph());
+  MemoryTimelineProfiler profiler(*interpreter_);
+  interpreter_->AddProfiler(&profiler);
+
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {2});
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {1, 2});
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[0]), {5, 7});
+  subgraph_test_util::FillIntTensor(
+      interpreter_->tensor(interpreter_->inputs()[1]), {1, 2});
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+
+  const std::vector<SubgraphMemoryTimeline> timelines =
+      profiler.GetTimelines();
+  ASSERT_THAT(timelines, SizeIs(1));
+  const SubgraphMemoryTimeline& timeline = timelines[0];
+  const int output = interpreter_->outputs()[0];
+  ASSERT_THAT(timeline.dynamic_allocations, SizeIs(1));
+  EXPECT_EQ(timeline.dynamic_allocations[0].step, 0);
+  EXPECT_EQ(timeline.dynamic_allocations[0].tensor, output);
+  EXPECT_EQ(timeline.dynamic_allocations[0].bytes, 5 * sizeof(int));
+  ASSERT_THAT(timeline.steps, SizeIs(1));
+  EXPECT_EQ(timeline.steps[0].op_name, "PAD");
+  EXPECT_EQ(timeline.steps[0].dynamic_bytes, 5 * sizeof(int));
+  for (const ArenaTensor& tensor : timeline.arena_tensors) {
+    EXPECT_NE(tensor.tensor, output);
+  }
+
+  // Invoking again with the same shapes reuses the buffer.
+  ASSERT_EQ(interpreter_->Invoke(), kTfLiteOk);
+  EXPECT_THAT(profiler.GetTimelines()[0].dynamic_allocations, IsEmpty());
+}
+
+TEST_F(MemoryTimelineProfilerTest, ExportsJsonAndChromeTrace) {
+  builder_->BuildInplaceOpSubgraph(&interpreter_->primary_subgraph());
+  MemoryTimelineProfiler profiler(*interpreter_);
+  interpreter_->AddProfiler(&profiler);
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[0], {2});
+  interpreter_->ResizeInputTensor(interpreter_->inputs()[1], {2});
+  ASSERT_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+
+  // Not invoked yet, so there are no timings.
+  const std::vector<SubgraphMemoryTimeline> timelines =
+      profiler.GetTimelines();
+  ASSERT_THAT(timelines, SizeIs(1));
+  EXPECT_EQ(timelines[0].steps[0].end_us, -1);
+
+  const std::string json = MemoryTimelineToJson(timelines);
+  EXPECT_THAT(json, HasSubstr("\"subgraphs\":["));
+  EXPECT_THAT(json, HasSubstr("\"op\":\"RESHAPE\""));
+  EXPECT_THAT(json, HasSubstr("\"end_us\":-1"));
+  EXPECT_THAT(json, HasSubstr("\"dynamic_allocations\":[]"));
+
+  const std::string trace = MemoryTimelineToChromeTrace(timelines);
+  EXPECT_THAT(trace, HasSubstr("\"traceEvents\":["));
+  EXPECT_THAT(trace, HasSubstr("\"name\":\"Subgraph 0 arena\",\"ph\":\"C\""));
+  EXPECT_THAT(trace,
+              HasSubstr("\"name\":\"Subgraph 0 dynamic\",\"ph\":\"C\""));
+  EXPECT_THAT(trace, HasSubstr("\"name\":\"ADD\",\"ph\":\"X\""));
+}
+
+TEST(MemoryTimelineExportTest, EscapesNames) {
+  SubgraphMemoryTimeline timeline;
+  ArenaTensor tensor;
+  tensor.name = "a\"b\\c\n";
+  timeline.arena_tensors.push_back(tensor);
+  EXPECT_THAT(MemoryTimelineToJson({timeline}),
+              HasSubstr("\"name\":\"a\\\"b\\\\c\\u000a\""));
+  EXPECT_THAT(MemoryTimelineToJson({}), HasSubstr("\"subgraphs\":["));
+  EXPECT_THAT(MemoryTimelineToChromeTrace({}),
+              Not(HasSubstr("\"ph\":\"C\"")));
+}
+
+}  // namespace
+}  // namespace tflite::profiling
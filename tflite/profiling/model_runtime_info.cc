@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tflite/profiling/model_runtime_info.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <fstream>
@@ -161,6 +162,82 @@ TfLiteStatus TfliteNodeToNode(const TfLiteNode& node,
 
   return kTfLiteOk;
 }
+
+std::string GetNodeName(const TfLiteRegistration& reg) {
+  if (reg.custom_name != nullptr) {
+    return reg.custom_name;
+  }
+  return EnumNamesBuiltinOperator()[reg.builtin_code];
+}
+
+// Adds the non-constant tensors of `tensors` to `edge_ids` and their sizes to
+// `bytes`.
+void AddBoundaryEdges(const Subgraph& subgraph, const TfLiteIntArray* tensors,
+                      google::protobuf::RepeatedField<int32_t>* edge_ids,
+                      int64_t& bytes) {
+  if (tensors == nullptr) {
+    return;
+  }
+  for (int i = 0; i < tensors->size; ++i) {
+    const int tensor_index = tensors->data[i];
+    if (tensor_index == kTfLiteOptionalTensor ||
+        std::find(edge_ids->begin(), edge_ids->end(), tensor_index) !=
+            edge_ids->end()) {
+      continue;
+    }
+    const TfLiteTensor* tensor = subgraph.tensor(tensor_index);
+    if (tensor->allocation_type == kTfLiteMmapRo ||
+        tensor->allocation_type == kTfLitePersistentRo) {
+      continue;
+    }
+    edge_ids->Add(tensor_index);
+    bytes += tensor->bytes;
+  }
+}
+
+// Adds the delegate nodes of the execution plan of `subgraph` as partitions of
+// `runtime_subgraph`.
+void AddDelegatePartitions(const Subgraph& subgraph,
+                           RuntimeSubgraph& runtime_subgraph) {
+  DelegatePartition* previous_partition = nullptr;
+  std::vector<std::string> cpu_ops_since_previous_partition;
+  for (const int node_index : subgraph.execution_plan()) {
+    const std::pair<TfLiteNode, TfLiteRegistration>* node_and_reg =
+        subgraph.node_and_registration(node_index);
+    const TfLiteNode& node = node_and_reg->first;
+    const TfLiteRegistration& reg = node_and_reg->second;
+    if (node.delegate == nullptr) {
+      if (previous_partition != nullptr) {
+        cpu_ops_since_previous_partition.push_back(GetNodeName(reg));
+      }
+      continue;
+    }
+
+    if (previous_partition != nullptr) {
+      for (std::string& op : cpu_ops_since_previous_partition) {
+        previous_partition->add_split_ops(std::move(op));
+      }
+      cpu_ops_since_previous_partition.clear();
+    }
+
+    DelegatePartition* partition = runtime_subgraph.add_partitions();
+    partition->set_node_id(node_index);
+    partition->set_delegate_name(GetNodeName(reg));
+    const auto* delegate_params =
+        static_cast<const TfLiteDelegateParams*>(node.builtin_data);
+    if (delegate_params != nullptr &&
+        delegate_params->nodes_to_replace != nullptr) {
+      partition->set_num_ops(delegate_params->nodes_to_replace->size);
+    }
+    int64_t boundary_bytes = 0;
+    AddBoundaryEdges(subgraph, node.inputs,
+                     partition->mutable_input_edge_ids(), boundary_bytes);
+    AddBoundaryEdges(subgraph, node.outputs,
+                     partition->mutable_output_edge_ids(), boundary_bytes);
+    partition->set_boundary_bytes(boundary_bytes);
+    previous_partition = partition;
+  }
+}
 }  // namespace
 
 TfLiteStatus GenerateModelRuntimeInfo(
@@ -223,6 +300,8 @@ TfLiteStatus GenerateModelRuntimeInfo(
     // Save the execution plan to runtime subgraph.
     runtime_subgraph->mutable_execution_plan()->Add(
         subgraph.execution_plan().begin(), subgraph.execution_plan().end());
+
+    AddDelegatePartitions(subgraph, *runtime_subgraph);
   }
   return kTfLiteOk;
 }
@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "tflite/core/c/common.h"
 #include "tflite/core/macros.h"
+#include "tflite/memory_placement.h"
 
 #ifdef TF_LITE_TENSORFLOW_PROFILER
 #include "tflite/tensorflow_profiler_logger.h"
@@ -163,10 +164,31 @@ bool ResizableAlignedBuffer::Resize(size_t new_size) {
                          reinterpret_cast<std::uintptr_t>(this), data_size_);
   }
 #endif
-  auto new_buffer = AlignedRealloc(buffer_, data_size_, new_size, alignment_);
+  PointerAlignedPointerPair new_buffer{nullptr, nullptr};
+  size_t new_mapped_bytes = 0;
+  // Placed memory is page aligned, which covers any tensor alignment.
+  if (placement_.Applies(new_size) && alignment_ <= 4096) {
+    const PlacedAllocation placed = AllocatePlaced(new_size, placement_);
+    new_buffer.pointer = static_cast<char*>(placed.data);
+    new_buffer.aligned_pointer = new_buffer.pointer;
+    new_mapped_bytes = placed.mapped_bytes;
+  }
+  if (new_mapped_bytes == 0 && mapped_bytes_ == 0) {
+    new_buffer = AlignedRealloc(buffer_, data_size_, new_size, alignment_);
+  } else {
+    if (new_mapped_bytes == 0) {
+      new_buffer = AlignedAlloc(new_size, alignment_);
+    }
+    if (data_size_ > 0) {
+      std::memcpy(new_buffer.aligned_pointer, buffer_.aligned_pointer,
+                  data_size_);
+    }
+    FreeBuffer();
+  }
   bool reallocated = (new_buffer.aligned_pointer != buffer_.aligned_pointer);
   buffer_ = new_buffer;
   data_size_ = new_size;
+  mapped_bytes_ = new_mapped_bytes;
 #ifdef TF_LITE_TENSORFLOW_PROFILER
   PauseHeapMonitoring(/*pause=*/false);
 #endif
@@ -181,12 +203,21 @@ void ResizableAlignedBuffer::Release() {
   OnTfLiteArenaDealloc(subgraph_index_, reinterpret_cast<std::uintptr_t>(this),
                        data_size_);
 #endif
-  AlignedFree(buffer_);
+  FreeBuffer();
   buffer_.pointer = nullptr;
   buffer_.aligned_pointer = nullptr;
   data_size_ = 0;
 }
 
+void ResizableAlignedBuffer::FreeBuffer() {
+  if (mapped_bytes_ > 0) {
+    FreePlaced({buffer_.pointer, mapped_bytes_});
+    mapped_bytes_ = 0;
+  } else {
+    AlignedFree(buffer_);
+  }
+}
+
 void SimpleMemoryArena::PurgeAfter(int32_t node) {
   for (int i = 0; i < active_allocs_.size(); ++i) {
     if (active_allocs_[i].first_node > node) {
@@ -284,6 +315,28 @@ TfLiteStatus SimpleMemoryArena::Allocate(
   return kTfLiteOk;
 }
 
+TfLiteStatus SimpleMemoryArena::AllocateAt(
+    TfLiteContext* context, size_t alignment, size_t offset, size_t size,
+    int32_t tensor, int32_t first_node, int32_t last_node,
+    ArenaAllocWithUsageInterval* new_alloc) {
+  TF_LITE_ENSURE(context, alignment <= underlying_buffer_.GetAlignment());
+  TF_LITE_ENSURE(context, offset % alignment == 0);
+  new_alloc->tensor = tensor;
+  new_alloc->first_node = first_node;
+  new_alloc->last_node = last_node;
+  new_alloc->size = size;
+  new_alloc->offset = offset;
+  if (size == 0) {
+    new_alloc->offset = 0;
+    return kTfLiteOk;
+  }
+  high_water_mark_ = std::max(high_water_mark_, offset + size);
+  auto insertion_it = std::upper_bound(active_allocs_.begin(),
+                                       active_allocs_.end(), *new_alloc);
+  active_allocs_.insert(insertion_it, *new_alloc);
+  return kTfLiteOk;
+}
+
 TfLiteStatus SimpleMemoryArena::Commit(bool* arena_reallocated) {
   // Resize the arena to the high water mark (calculated by Allocate), retaining
   // old contents and alignment in the process. Since Alloc pointers are offset
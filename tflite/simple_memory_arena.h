@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "tflite/core/c/common.h"
+#include "tflite/memory_placement.h"
 
 namespace tflite {
 
@@ -87,7 +88,17 @@ class ResizableAlignedBuffer {
   // Alignment of the data array.
   size_t GetAlignment() const { return alignment_; }
 
+  // Backs the buffer with memory placed according to `placement` when it
+  // grows to at least `placement.min_bytes`. Takes effect at the next
+  // reallocation.
+  void SetPlacement(const MemoryPlacement& placement) {
+    placement_ = placement;
+  }
+
  private:
+  // Frees `buffer_`, whether it was placed or comes from the heap.
+  void FreeBuffer();
+
   ResizableAlignedBuffer(const ResizableAlignedBuffer&) = delete;
   ResizableAlignedBuffer& operator=(const ResizableAlignedBuffer&) = delete;
   ResizableAlignedBuffer(ResizableAlignedBuffer&&) = delete;
@@ -96,6 +107,9 @@ class ResizableAlignedBuffer {
   PointerAlignedPointerPair buffer_;
   size_t data_size_;
   size_t alignment_;
+  MemoryPlacement placement_;
+  // Size of the mapping backing `buffer_` if it was placed, 0 otherwise.
+  size_t mapped_bytes_ = 0;
 
   int subgraph_index_;
 };
@@ -142,6 +156,15 @@ class SimpleMemoryArena {
                         int32_t tensor, int32_t first_node, int32_t last_node,
                         ArenaAllocWithUsageInterval* new_alloc);
 
+  // Schedule memory allocation for a tensor at a known `offset`, e.g. one
+  // computed by `Allocate` in an earlier run with the same allocation pattern.
+  // The caller is responsible for `offset` not overlapping with other allocs
+  // whose usage interval intersects [first_node, last_node].
+  TfLiteStatus AllocateAt(TfLiteContext* context, size_t alignment,
+                          size_t offset, size_t size, int32_t tensor,
+                          int32_t first_node, int32_t last_node,
+                          ArenaAllocWithUsageInterval* new_alloc);
+
   TfLiteStatus Commit(bool* arena_reallocated);
 
   TfLiteStatus ResolveAlloc(TfLiteContext* context,
@@ -160,6 +183,12 @@ class SimpleMemoryArena {
 
   size_t GetBufferSize() const { return underlying_buffer_.GetSize(); }
 
+  // Places the underlying buffer according to `placement` from the next
+  // reallocation on, see ResizableAlignedBuffer::SetPlacement.
+  void SetPlacement(const MemoryPlacement& placement) {
+    underlying_buffer_.SetPlacement(placement);
+  }
+
   std::intptr_t BasePointer() const {
     return reinterpret_cast<std::intptr_t>(underlying_buffer_.GetPtr());
   }
@@ -321,6 +321,44 @@ TEST(SimpleMemoryArenaTest, TestClearBuffer) {
   EXPECT_NE(resolved_ptr, nullptr);
 }
 
+TEST(SimpleMemoryArenaTest, TestPlacedBuffer) {
+  TfLiteContext context;
+  context.ReportError = ReportError;
+  SimpleMemoryArena arena(64);
+  MemoryPlacement placement;
+  placement.huge_pages = HugePageMode::kTransparent;
+  placement.min_bytes = 4096;
+  arena.SetPlacement(placement);
+  ArenaAllocWithUsageInterval allocs[2];
+
+  // Below `min_bytes`, the buffer comes from the heap.
+  arena.Allocate(&context, 32, 2047, 0, 0, 2, &allocs[0]);
+  bool reallocated = false;
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  char* resolved_ptr = nullptr;
+  ASSERT_EQ(arena.ResolveAlloc(&context, allocs[0], &resolved_ptr), kTfLiteOk);
+  resolved_ptr[0] = 42;
+  resolved_ptr[2046] = 43;
+
+  // Growing past it moves the buffer to placed memory and keeps the data.
+  arena.Allocate(&context, 32, 1 << 20, 1, 1, 2, &allocs[1]);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  ASSERT_TRUE(reallocated);
+#if defined(__linux__)
+  EXPECT_EQ(arena.BasePointer() % (2 << 20), 0);
+#endif
+  ASSERT_EQ(arena.ResolveAlloc(&context, allocs[0], &resolved_ptr), kTfLiteOk);
+  EXPECT_EQ(resolved_ptr[0], 42);
+  EXPECT_EQ(resolved_ptr[2046], 43);
+  ASSERT_EQ(arena.ResolveAlloc(&context, allocs[1], &resolved_ptr), kTfLiteOk);
+  resolved_ptr[(1 << 20) - 1] = 44;
+
+  ASSERT_EQ(arena.ReleaseBuffer(), kTfLiteOk);
+  ASSERT_EQ(arena.BasePointer(), 0);
+  ASSERT_EQ(arena.Commit(&reallocated), kTfLiteOk);
+  ASSERT_NE(arena.BasePointer(), 0);
+}
+
 // Test parameterized by whether ClearBuffer() is called before ClearPlan(), or
 // vice versa.
 class BufferAndPlanClearingTest : public ::testing::Test,
@@ -50,8 +50,11 @@ limitations under the License.
 #include "tflite/core/subgraph.h"
 #include "tflite/interpreter.h"
 #include "tflite/kernels/cpu_backend_context.h"
+#include "tflite/memory_placement.h"
 #include "tflite/op_resolver.h"
 #include "tflite/optional_debug_tools.h"
+#include "tflite/profiling/delegate_partition_profiler.h"
+#include "tflite/profiling/memory_timeline_profiler.h"
 #include "tflite/profiling/model_runtime_info.h"
 #include "tflite/profiling/profile_summary_formatter.h"
 #include "tflite/string_util.h"
@@ -266,6 +269,117 @@ class ModelRuntimeInfoListener : public BenchmarkListener {
   Interpreter* const interpreter_ = nullptr;  // not own the memory.
 };
 
+// Logs the delegate partitions of the graph, the tensors crossing their
+// boundaries and the time spent handing them over, when
+// report_delegate_partitions is set to true.
+class DelegatePartitionReportListener : public BenchmarkListener {
+ public:
+  // The profiler is installed right away so that delegates applied afterwards
+  // report their ops to it.
+  explicit DelegatePartitionReportListener(Interpreter* interpreter)
+      : interpreter_(interpreter) {
+    auto profiler =
+        std::make_unique<profiling::DelegatePartitionProfiler>(*interpreter);
+    profiler_ = profiler.get();
+    interpreter_->AddProfiler(std::move(profiler));
+  }
+
+  void OnSingleRunStart(RunType run_type) override {
+    if (run_type == REGULAR) {
+      profiler_->StartProfiling();
+    }
+  }
+
+  void OnSingleRunEnd() override { profiler_->StopProfiling(); }
+
+  void OnBenchmarkEnd(const BenchmarkResults& results) override {
+    profiling::ModelRuntimeDetails model_runtime_details;
+    if (profiling::GenerateModelRuntimeInfo(
+            *interpreter_, model_runtime_details) != kTfLiteOk) {
+      TFLITE_LOG(ERROR) << "Failed to generate the delegate partition report.";
+      return;
+    }
+    profiler_->AddTimings(model_runtime_details);
+    const std::string report =
+        profiling::DelegatePartitionReport(model_runtime_details);
+    if (report.empty()) {
+      TFLITE_LOG(INFO) << "No delegate partitions.";
+    } else {
+      TFLITE_LOG(INFO) << "Delegate partitions:\n" << report;
+    }
+  }
+
+ private:
+  Interpreter* const interpreter_ = nullptr;  // not own the memory.
+  // Owned by the interpreter.
+  profiling::DelegatePartitionProfiler* profiler_ = nullptr;
+};
+
+// Logs the outcome of the reduced precision activation storage check of each
+// subgraph, when activation_storage_tolerance is set.
+class ActivationStorageReportListener : public BenchmarkListener {
+ public:
+  explicit ActivationStorageReportListener(Interpreter* interpreter)
+      : interpreter_(interpreter) {}
+
+  void OnBenchmarkEnd(const BenchmarkResults& results) override {
+    for (int i = 0; i < interpreter_->subgraphs_size(); ++i) {
+      const Subgraph::ActivationStorageReport& report =
+          interpreter_->subgraph(i)->activation_storage_report();
+      if (!report.checked) continue;
+      TFLITE_LOG(INFO) << "Subgraph " << i << " activation storage "
+                       << (report.accepted ? "accepted" : "rejected") << ": "
+                       << report.num_reduced_tensors
+                       << " tensors, max relative error "
+                       << report.max_relative_error << ", arena "
+                       << report.declared_arena_bytes << " -> "
+                       << report.reduced_arena_bytes << " bytes, invoke "
+                       << report.declared_invoke_us << " -> "
+                       << report.reduced_invoke_us << " us";
+    }
+  }
+
+ private:
+  Interpreter* const interpreter_ = nullptr;  // not own the memory.
+};
+
+// Writes the memory timeline of each subgraph, as of the last run, to
+// memory_timeline_file when it is set.
+class MemoryTimelineListener : public BenchmarkListener {
+ public:
+  // The profiler is installed right away so that it sees the first
+  // AllocateTensors call.
+  MemoryTimelineListener(Interpreter* interpreter, std::string file_path,
+                         std::string format)
+      : file_path_(std::move(file_path)), format_(std::move(format)) {
+    auto profiler =
+        std::make_unique<profiling::MemoryTimelineProfiler>(*interpreter);
+    profiler_ = profiler.get();
+    interpreter->AddProfiler(std::move(profiler));
+  }
+
+  void OnBenchmarkEnd(const BenchmarkResults& results) override {
+    const std::vector<profiling::SubgraphMemoryTimeline> timelines =
+        profiler_->GetTimelines();
+    std::ofstream out(file_path_, std::ios::out | std::ios::trunc);
+    if (!out) {
+      TFLITE_LOG(ERROR) << "Failed to open " << file_path_
+                        << " to write the memory timeline.";
+      return;
+    }
+    out << (format_ == "json" ? profiling::MemoryTimelineToJson(timelines)
+                              : profiling::MemoryTimelineToChromeTrace(
+                                    timelines));
+    TFLITE_LOG(INFO) << "Memory timeline written to " << file_path_;
+  }
+
+ private:
+  const std::string file_path_;
+  const std::string format_;
+  // Owned by the interpreter.
+  profiling::MemoryTimelineProfiler* profiler_ = nullptr;
+};
+
 // Dumps the benchmark result to a file in proto format if result_file_path is
 // set.
 class ProtoBenchmarkReporter : public BenchmarkListener {
@@ -673,6 +787,12 @@ BenchmarkParams BenchmarkTfLiteModel::DefaultParams() {
                           BenchmarkParam::Create<bool>(false));
   default_params.AddParam("model_runtime_info_output_file",
                           BenchmarkParam::Create<std::string>(""));
+  default_params.AddParam("report_delegate_partitions",
+                          BenchmarkParam::Create<bool>(false));
+  default_params.AddParam("memory_timeline_file",
+                          BenchmarkParam::Create<std::string>(""));
+  default_params.AddParam("memory_timeline_format",
+                          BenchmarkParam::Create<std::string>("chrome_trace"));
   default_params.AddParam("print_preinvoke_state",
                           BenchmarkParam::Create<bool>(false));
   default_params.AddParam("print_postinvoke_state",
@@ -685,6 +805,15 @@ BenchmarkParams BenchmarkTfLiteModel::DefaultParams() {
                           BenchmarkParam::Create<bool>(false));
   default_params.AddParam("enable_builtin_cast_constant_cache",
                           BenchmarkParam::Create<bool>(false));
+  default_params.AddParam("activation_storage",
+                          BenchmarkParam::Create<std::string>(""));
+  default_params.AddParam("activation_storage_tolerance",
+                          BenchmarkParam::Create<float>(0.0f));
+  default_params.AddParam("huge_pages",
+                          BenchmarkParam::Create<std::string>(""));
+  default_params.AddParam("numa_node", BenchmarkParam::Create<int32_t>(-1));
+  default_params.AddParam("numa_replicate_weights",
+                          BenchmarkParam::Create<bool>(false));
   default_params.AddParam("output_filepath",
                           BenchmarkParam::Create<std::string>(""));
   default_params.AddParam("output_proto_filepath",
@@ -775,6 +904,15 @@ std::vector<Flag> BenchmarkTfLiteModel::GetFlags() {
                        "Enable Model Runtime Info Export"),
       CreateFlag<std::string>("model_runtime_info_output_file", &params_,
                               "Proto File to export model runtime info to"),
+      CreateFlag<bool>("report_delegate_partitions", &params_,
+                       "Report the delegate partitions, the tensors crossing "
+                       "their boundaries and the measured hand-off overhead"),
+      CreateFlag<std::string>(
+          "memory_timeline_file", &params_,
+          "File to write the tensor memory timeline of each subgraph to"),
+      CreateFlag<std::string>(
+          "memory_timeline_format", &params_,
+          "Format of memory_timeline_file, 'chrome_trace' or 'json'"),
       CreateFlag<bool>(
           "print_preinvoke_state", &params_,
           "print out the interpreter internals just before calling Invoke. The "
@@ -796,6 +934,24 @@ std::vector<Flag> BenchmarkTfLiteModel::GetFlags() {
           "enable_builtin_cast_constant_cache", &params_,
           "Cache the output of the builtin cast operation when its input "
           "is a constant tensor."),
+      CreateFlag<std::string>(
+          "activation_storage", &params_,
+          "Store eligible float32 activations as 'fp16' or 'bf16'."),
+      CreateFlag<float>(
+          "activation_storage_tolerance", &params_,
+          "If positive, keep float32 activations unless the outputs with "
+          "reduced precision storage are within this relative error."),
+      CreateFlag<std::string>(
+          "huge_pages", &params_,
+          "Back large arenas with 'transparent' or 'explicit' huge pages."),
+      CreateFlag<int32_t>(
+          "numa_node", &params_,
+          "If non-negative, run on the CPUs of this NUMA node and allocate "
+          "the arenas from its memory."),
+      CreateFlag<bool>("numa_replicate_weights", &params_,
+                       "Copy the model and the XNNPACK weight cache into "
+                       "memory placed like the arenas, e.g. local to "
+                       "numa_node."),
       CreateFlag<std::string>(
           "output_filepath", &params_,
           "File path to export outputs layer as binary data."),
@@ -873,6 +1029,12 @@ void BenchmarkTfLiteModel::LogParams() {
                       "Enable Model Runtime Info Export", verbose);
   LOG_BENCHMARK_PARAM(std::string, "model_runtime_info_output_file",
                       "Proto File to export model runtime info to", verbose);
+  LOG_BENCHMARK_PARAM(bool, "report_delegate_partitions",
+                      "Report delegate partitions", verbose);
+  LOG_BENCHMARK_PARAM(std::string, "memory_timeline_file",
+                      "Memory timeline file", verbose);
+  LOG_BENCHMARK_PARAM(std::string, "memory_timeline_format",
+                      "Memory timeline format", verbose);
   LOG_BENCHMARK_PARAM(bool, "print_preinvoke_state",
                       "Print pre-invoke interpreter state", verbose);
   LOG_BENCHMARK_PARAM(bool, "print_postinvoke_state",
@@ -885,6 +1047,14 @@ void BenchmarkTfLiteModel::LogParams() {
                       "Disable delegate clustering", verbose);
   LOG_BENCHMARK_PARAM(bool, "enable_builtin_cast_constant_cache",
                       "Constant CAST output cache", verbose);
+  LOG_BENCHMARK_PARAM(std::string, "activation_storage",
+                      "Activation storage type", verbose);
+  LOG_BENCHMARK_PARAM(float, "activation_storage_tolerance",
+                      "Activation storage tolerance", verbose);
+  LOG_BENCHMARK_PARAM(std::string, "huge_pages", "Huge pages", verbose);
+  LOG_BENCHMARK_PARAM(int32_t, "numa_node", "NUMA node", verbose);
+  LOG_BENCHMARK_PARAM(bool, "numa_replicate_weights",
+                      "Replicate weights on the NUMA node", verbose);
   LOG_BENCHMARK_PARAM(std::string, "output_filepath",
                       "File path to export outputs layer to", verbose);
   LOG_BENCHMARK_PARAM(std::string, "output_proto_filepath",
@@ -1073,6 +1243,16 @@ TfLiteStatus BenchmarkTfLiteModel::PrepareInputData() {
     }
     inputs_data_.push_back(std::move(t_data));
   }
+
+  // The reduced precision storage check runs when the tensors are allocated
+  // again with the inputs filled in.
+  if (params_.Get<float>("activation_storage_tolerance") > 0) {
+    TF_LITE_ENSURE_STATUS(ResetInputsAndOutputs());
+    if (interpreter_runner_->AllocateTensors() != kTfLiteOk) {
+      TFLITE_LOG(ERROR) << "Failed to check the activation storage!";
+      return kTfLiteError;
+    }
+  }
   return kTfLiteOk;
 }
 
@@ -1118,6 +1298,23 @@ TfLiteStatus BenchmarkTfLiteModel::InitInterpreter() {
       params_.Get<bool>("disable_delegate_clustering"));
   options.SetCacheConstantCastOp(
       params_.Get<bool>("enable_builtin_cast_constant_cache"));
+  const std::string activation_storage =
+      params_.Get<std::string>("activation_storage");
+  if (activation_storage == "fp16") {
+    options.SetActivationStorageType(kTfLiteFloat16);
+  } else if (activation_storage == "bf16") {
+    options.SetActivationStorageType(kTfLiteBFloat16);
+  } else if (!activation_storage.empty()) {
+    TFLITE_LOG(ERROR) << "Unsupported activation storage type: "
+                      << activation_storage;
+    return kTfLiteError;
+  }
+  options.SetActivationStorageTolerance(
+      params_.Get<float>("activation_storage_tolerance"));
+  MemoryPlacement placement;
+  TF_LITE_ENSURE_STATUS(GetMemoryPlacement(&placement));
+  options.SetMemoryPlacement(placement);
+  options.SetPinWorkerThreads(true);
 
   tflite::InterpreterBuilder builder(*model_, *resolver, &options);
   if (builder.SetNumThreads(num_threads) != kTfLiteOk) {
@@ -1139,6 +1336,7 @@ TfLiteStatus BenchmarkTfLiteModel::InitInterpreter() {
     cpu_backend_context->SetMaxNumThreads(num_threads);
     external_context_->set_internal_backend_context(
         std::move(cpu_backend_context));
+    external_context_->set_worker_numa_node(placement.numa_node);
     interpreter_->SetExternalContext(kTfLiteCpuBackendContext,
                                      external_context_.get());
   }
@@ -1146,7 +1344,32 @@ TfLiteStatus BenchmarkTfLiteModel::InitInterpreter() {
   return kTfLiteOk;
 }
 
+TfLiteStatus BenchmarkTfLiteModel::GetMemoryPlacement(
+    MemoryPlacement* placement) const {
+  const std::string huge_pages = params_.Get<std::string>("huge_pages");
+  if (huge_pages == "transparent") {
+    placement->huge_pages = HugePageMode::kTransparent;
+  } else if (huge_pages == "explicit") {
+    placement->huge_pages = HugePageMode::kExplicit;
+  } else if (!huge_pages.empty()) {
+    TFLITE_LOG(ERROR) << "Unsupported huge page mode: " << huge_pages;
+    return kTfLiteError;
+  }
+  placement->numa_node = params_.Get<int32_t>("numa_node");
+  return kTfLiteOk;
+}
+
 TfLiteStatus BenchmarkTfLiteModel::Init() {
+  // Pin first: the thread pools of the delegates and of the CPU backend are
+  // created later from this thread and inherit its affinity.
+  const int32_t numa_node = params_.Get<int32_t>("numa_node");
+  if (numa_node >= 0) {
+    if (numa_node >= NumNumaNodes() || !PinCurrentThreadToNumaNode(numa_node)) {
+      TFLITE_LOG(ERROR) << "Failed to run on NUMA node " << numa_node;
+      return kTfLiteError;
+    }
+    TFLITE_LOG(INFO) << "Running on the CPUs of NUMA node " << numa_node;
+  }
   TF_LITE_ENSURE_STATUS(LoadModel());
   TF_LITE_ENSURE_STATUS(InitInterpreter());
 
@@ -1189,6 +1412,30 @@ TfLiteStatus BenchmarkTfLiteModel::Init() {
         new ModelRuntimeInfoListener(interpreter_.get())));
   }
 
+  if (params_.Get<bool>("report_delegate_partitions")) {
+    AddOwnedListener(std::unique_ptr<BenchmarkListener>(
+        new DelegatePartitionReportListener(interpreter_.get())));
+  }
+
+  const std::string memory_timeline_file =
+      params_.Get<std::string>("memory_timeline_file");
+  if (!memory_timeline_file.empty()) {
+    const std::string format =
+        params_.Get<std::string>("memory_timeline_format");
+    if (format != "chrome_trace" && format != "json") {
+      TFLITE_LOG(ERROR) << "Unknown memory_timeline_format: " << format;
+      return kTfLiteError;
+    }
+    AddOwnedListener(std::unique_ptr<BenchmarkListener>(
+        new MemoryTimelineListener(interpreter_.get(), memory_timeline_file,
+                                   format)));
+  }
+
+  if (params_.Get<float>("activation_storage_tolerance") > 0) {
+    AddOwnedListener(std::unique_ptr<BenchmarkListener>(
+        new ActivationStorageReportListener(interpreter_.get())));
+  }
+
   interpreter_->SetAllowFp16PrecisionForFp32(params_.Get<bool>("allow_fp16"));
 
   std::pair<TfLiteStatus, std::unique_ptr<BenchmarkInterpreterRunner>>
@@ -1317,6 +1564,34 @@ TfLiteStatus BenchmarkTfLiteModel::Init() {
     }
   }
 
+  if (!created_delegates.empty()) {
+    // Each delegate kernel in the final execution plan is one partition. Every
+    // switch between a delegate partition and CPU kernels costs a sync and
+    // usually a copy, so fragmented plans are worth flagging. Adjacent kernels
+    // on the same target (e.g. two partitions of one delegate) don't count.
+    int num_partitions = 0;
+    int num_cpu_nodes = 0;
+    int num_boundaries = 0;
+    const TfLiteDelegate* prev_target = nullptr;
+    const auto& execution_plan = interpreter_runner_->execution_plan();
+    for (int i = 0; i < execution_plan.size(); ++i) {
+      const TfLiteNode& node =
+          interpreter_runner_->node_and_registration(execution_plan[i])->first;
+      // CPU kernels have no delegate.
+      const TfLiteDelegate* target = node.delegate;
+      if (target != nullptr) {
+        ++num_partitions;
+      } else {
+        ++num_cpu_nodes;
+      }
+      if (i > 0 && target != prev_target) ++num_boundaries;
+      prev_target = target;
+    }
+    TFLITE_LOG(INFO) << "Delegate partitions: " << num_partitions
+                     << ", nodes on CPU: " << num_cpu_nodes
+                     << ", execution target boundaries: " << num_boundaries;
+  }
+
   if (interpreter_runner_->AllocateTensors() != kTfLiteOk) {
     TFLITE_LOG(ERROR) << "Failed to allocate tensors!";
     return kTfLiteError;
@@ -1346,10 +1621,23 @@ TfLiteStatus BenchmarkTfLiteModel::LoadModel() {
     TFLITE_LOG(ERROR) << "Failed to load model " << fd_or_graph_path;
     return kTfLiteError;
   }
-  model_ = tflite::FlatBufferModel::BuildFromBuffer(
-      reinterpret_cast<const char*>(
-          model_loader_->GetModel()->allocation()->base()),
-      model_loader_->GetModel()->allocation()->bytes());
+  const char* model_data = reinterpret_cast<const char*>(
+      model_loader_->GetModel()->allocation()->base());
+  size_t model_bytes = model_loader_->GetModel()->allocation()->bytes();
+  if (params_.Get<bool>("numa_replicate_weights")) {
+    MemoryPlacement placement;
+    TF_LITE_ENSURE_STATUS(GetMemoryPlacement(&placement));
+    // Replicate even small models, they are read on every run.
+    placement.min_bytes = 0;
+    placed_model_ = PlacedBuffer::CopyOf(model_data, model_bytes, placement);
+    if (!placed_model_) {
+      TFLITE_LOG(ERROR) << "Failed to replicate the model";
+      return kTfLiteError;
+    }
+    model_data = static_cast<const char*>(placed_model_->data());
+    model_bytes = placed_model_->size();
+  }
+  model_ = tflite::FlatBufferModel::BuildFromBuffer(model_data, model_bytes);
   TFLITE_LOG(INFO) << "Loaded model " << fd_or_graph_path;
   return kTfLiteOk;
 }
@@ -27,6 +27,7 @@ limitations under the License.
 
 #include "tflite/core/model.h"
 #include "tflite/core/subgraph.h"
+#include "tflite/memory_placement.h"
 #include "tflite/profiling/profiler.h"
 #include "tflite/signature_runner.h"
 #include "tflite/tools/benchmark/benchmark_model.h"
@@ -184,6 +185,9 @@ class BenchmarkTfLiteModel : public BenchmarkModel {
   // Allow subclass to initialize a customized tflite interpreter.
   virtual TfLiteStatus InitInterpreter();
 
+  // Fills `placement` from the huge_pages and numa_node params.
+  TfLiteStatus GetMemoryPlacement(MemoryPlacement* placement) const;
+
   // Create a BenchmarkListener that's specifically for TFLite profiling if
   // necessary.
   virtual std::unique_ptr<BenchmarkListener> MayCreateProfilingListener() const;
@@ -195,6 +199,8 @@ class BenchmarkTfLiteModel : public BenchmarkModel {
 
   std::vector<InputLayerInfo> inputs_;
   std::vector<utils::InputTensorData> inputs_data_;
+  // Placed copy of the model with numa_replicate_weights, must outlive model_.
+  std::unique_ptr<tflite::PlacedBuffer> placed_model_;
   std::unique_ptr<tflite::FlatBufferModel> model_;
   std::unique_ptr<tflite::Interpreter> interpreter_;
   std::unique_ptr<BenchmarkInterpreterRunner> interpreter_runner_;
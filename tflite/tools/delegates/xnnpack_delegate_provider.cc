@@ -18,6 +18,7 @@ limitations under the License.
 #include <vector>
 
 #include "tflite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tflite/memory_placement.h"
 #include "tflite/tools/delegates/delegate_provider.h"
 #include "tflite/tools/evaluation/utils.h"
 #include "tflite/tools/tool_params.h"
@@ -98,6 +99,30 @@ TfLiteDelegatePtr XnnpackDelegateProvider::CreateTfLiteDelegate(
     if (!path.empty()) {
       opts.weight_cache_file_path = path.c_str();
     }
+    // benchmark_model's --numa_replicate_weights also replicates the packed
+    // weights. The plugin settings CreateXNNPACKDelegate goes through can't
+    // carry the placement, so the delegate is created directly.
+    if (!path.empty() && params.HasParam("numa_replicate_weights") &&
+        params.Get<bool>("numa_replicate_weights")) {
+      MemoryPlacement placement;
+      placement.numa_node = params.Get<int32_t>("numa_node");
+      const std::string huge_pages = params.Get<std::string>("huge_pages");
+      if (huge_pages == "transparent") {
+        placement.huge_pages = HugePageMode::kTransparent;
+      } else if (huge_pages == "explicit") {
+        placement.huge_pages = HugePageMode::kExplicit;
+      }
+      // Replicate even small caches, they are read on every run.
+      placement.min_bytes = 0;
+      opts.weight_cache_memory_placement = &placement;
+      return TfLiteDelegatePtr(
+          reinterpret_cast<TfLiteOpaqueDelegate*>(
+              TfLiteXNNPackDelegateCreate(&opts)),
+          [](TfLiteOpaqueDelegate* delegate) {
+            TfLiteXNNPackDelegateDelete(
+                reinterpret_cast<TfLiteDelegate*>(delegate));
+          });
+    }
     return evaluation::CreateXNNPACKDelegate(&opts);
   }
   return CreateNullDelegate();
@@ -0,0 +1,252 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_EVALUATION_PIPELINED_EXECUTOR_H_
+#define TENSORFLOW_LITE_TOOLS_EVALUATION_PIPELINED_EXECUTOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace evaluation {
+
+// A FIFO queue holding at most `capacity` elements. Push() blocks while the
+// queue is full and Pop() while it is empty. After Close(), Push() fails and
+// Pop() fails once the queue has been drained.
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity)
+      : capacity_(std::max<size_t>(capacity, 1)) {}
+
+  // Returns false if the queue was closed.
+  bool Push(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock,
+                   [this] { return closed_ || queue_.size() < capacity_; });
+    if (closed_) return false;
+    queue_.push_back(std::move(value));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Returns false if the queue is closed and empty.
+  bool Pop(T* value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+    if (queue_.empty()) return false;
+    *value = std::move(queue_.front());
+    queue_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<T> queue_;
+  bool closed_ = false;
+};
+
+// How the evaluation stages running a PipelinedExecutor spread their work over
+// threads.
+struct PipelineOptions {
+  // Threads reading input files.
+  int num_reader_threads = 1;
+  // Threads decoding and preprocessing inputs.
+  int num_preprocessing_threads = 1;
+  // Interpreters running inference, each on its own thread.
+  int num_interpreters = 1;
+  // Maximum number of inputs being worked on at once.
+  int max_in_flight = 64;
+
+  // Returns true if any step runs on more than one thread, i.e. if running
+  // the pipeline overlaps the steps of consecutive inputs.
+  bool IsPipelined() const {
+    return num_reader_threads > 1 || num_preprocessing_threads > 1 ||
+           num_interpreters > 1;
+  }
+};
+
+// Runs a list of items through a sequence of stages, each with its own pool
+// of worker threads, and hands the results to a sink in input order.
+//
+// Evaluation tasks use it to overlap file reading, preprocessing and inference
+// across images, e.g.:
+//
+//   PipelinedExecutor<Example> executor(/*max_in_flight=*/64);
+//   executor.AddStage(/*num_workers=*/2, ReadFile);
+//   executor.AddStage(/*num_workers=*/4, Preprocess);
+//   executor.AddStage(num_interpreters, [&](int worker, Example* example) {
+//     return RunInference(interpreters[worker], example);
+//   });
+//   executor.Run(std::move(examples), AccumulateMetrics);
+//
+// Each worker of a stage has an index, and a worker only processes one item
+// at a time, so stages can keep per-worker state such as an interpreter. The
+// sink runs on the calling thread and sees the items in the order they were
+// given, so metrics accumulated by it don't depend on scheduling.
+//
+// At most `max_in_flight` items are between being fed to the first stage and
+// being consumed by the sink, which bounds the memory held by the queues.
+// `Item` must be default-constructible and movable.
+template <typename Item>
+class PipelinedExecutor {
+ public:
+  // Processes `item` on the stage worker with index `worker`.
+  using StageFn = std::function<TfLiteStatus(int worker, Item* item)>;
+  // Consumes the item with input index `index`.
+  using SinkFn = std::function<TfLiteStatus(size_t index, Item* item)>;
+
+  explicit PipelinedExecutor(size_t max_in_flight)
+      : max_in_flight_(std::max<size_t>(max_in_flight, 1)) {}
+
+  // Appends a stage run by `num_workers` threads.
+  void AddStage(int num_workers, StageFn fn) {
+    stages_.push_back({std::max(num_workers, 1), std::move(fn)});
+  }
+
+  // Runs every item through all stages and the sink. Stops early and returns
+  // kTfLiteError as soon as a stage or the sink fails.
+  TfLiteStatus Run(std::vector<Item> items, const SinkFn& sink);
+
+ private:
+  struct Stage {
+    int num_workers;
+    StageFn fn;
+  };
+  using Entry = std::pair<size_t, Item>;
+
+  const size_t max_in_flight_;
+  std::vector<Stage> stages_;
+};
+
+template <typename Item>
+TfLiteStatus PipelinedExecutor<Item>::Run(std::vector<Item> items,
+                                          const SinkFn& sink) {
+  const size_t num_items = items.size();
+  const size_t num_stages = stages_.size();
+  // queues[s] feeds stage s, queues[num_stages] feeds the sink.
+  std::vector<std::unique_ptr<BoundedQueue<Entry>>> queues;
+  for (size_t s = 0; s <= num_stages; ++s) {
+    queues.push_back(std::make_unique<BoundedQueue<Entry>>(max_in_flight_));
+  }
+
+  std::mutex window_mutex;
+  std::condition_variable window_cv;
+  size_t consumed = 0;
+  bool failed = false;
+  auto abort = [&] {
+    {
+      std::lock_guard<std::mutex> lock(window_mutex);
+      failed = true;
+    }
+    window_cv.notify_all();
+    for (auto& queue : queues) queue->Close();
+  };
+  auto has_failed = [&] {
+    std::lock_guard<std::mutex> lock(window_mutex);
+    return failed;
+  };
+
+  std::vector<std::thread> threads;
+  std::vector<std::unique_ptr<std::atomic<int>>> running_workers;
+  for (size_t s = 0; s < num_stages; ++s) {
+    running_workers.push_back(
+        std::make_unique<std::atomic<int>>(stages_[s].num_workers));
+  }
+  for (size_t s = 0; s < num_stages; ++s) {
+    for (int w = 0; w < stages_[s].num_workers; ++w) {
+      threads.emplace_back([&, s, w] {
+        Entry entry;
+        while (queues[s]->Pop(&entry) && !has_failed()) {
+          if (stages_[s].fn(w, &entry.second) != kTfLiteOk) {
+            abort();
+            break;
+          }
+          if (!queues[s + 1]->Push(std::move(entry))) break;
+        }
+        // The last worker out tells the next stage there is nothing more.
+        if (--*running_workers[s] == 0) queues[s + 1]->Close();
+      });
+    }
+  }
+
+  threads.emplace_back([&] {
+    for (size_t i = 0; i < num_items; ++i) {
+      {
+        std::unique_lock<std::mutex> lock(window_mutex);
+        window_cv.wait(lock,
+                       [&] { return failed || i - consumed < max_in_flight_; });
+        if (failed) break;
+      }
+      if (!queues[0]->Push({i, std::move(items[i])})) break;
+    }
+    queues[0]->Close();
+  });
+
+  // Items leave the stages in any order; they are held here until all those
+  // before them have been consumed.
+  std::map<size_t, Item> pending;
+  size_t next = 0;
+  Entry entry;
+  while (next < num_items && queues[num_stages]->Pop(&entry)) {
+    pending.emplace(entry.first, std::move(entry.second));
+    auto it = pending.begin();
+    while (it != pending.end() && it->first == next) {
+      if (sink(next, &it->second) != kTfLiteOk) {
+        abort();
+        break;
+      }
+      it = pending.erase(it);
+      ++next;
+      {
+        std::lock_guard<std::mutex> lock(window_mutex);
+        consumed = next;
+      }
+      window_cv.notify_all();
+    }
+    if (has_failed()) break;
+  }
+  if (next < num_items) abort();
+
+  for (std::thread& thread : threads) thread.join();
+  return next == num_items && !has_failed() ? kTfLiteOk : kTfLiteError;
+}
+
+}  // namespace evaluation
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_EVALUATION_PIPELINED_EXECUTOR_H_
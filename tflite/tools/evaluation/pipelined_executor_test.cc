@@ -0,0 +1,179 @@
+/* Copyright 2026 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/evaluation/pipelined_executor.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstddef>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace evaluation {
+namespace {
+
+// Sleeps for a duration that depends on `i`, so that items overtake each
+// other in the stages.
+void Jitter(int i) {
+  std::this_thread::sleep_for(std::chrono::microseconds((i * 7919) % 500));
+}
+
+TEST(BoundedQueueTest, DrainsAfterClose) {
+  BoundedQueue<int> queue(2);
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  queue.Close();
+  EXPECT_FALSE(queue.Push(3));
+  int value = 0;
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 2);
+  EXPECT_FALSE(queue.Pop(&value));
+}
+
+TEST(BoundedQueueTest, BlocksWhenFull) {
+  BoundedQueue<int> queue(1);
+  ASSERT_TRUE(queue.Push(1));
+  std::atomic<bool> pushed{false};
+  std::thread producer([&] {
+    queue.Push(2);
+    pushed = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(pushed);
+  int value = 0;
+  EXPECT_TRUE(queue.Pop(&value));
+  producer.join();
+  EXPECT_TRUE(pushed);
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(value, 2);
+}
+
+TEST(PipelinedExecutorTest, SinkSeesItemsInOrder) {
+  constexpr int kNumItems = 200;
+  constexpr size_t kMaxInFlight = 8;
+  constexpr int kNumInterpreters = 3;
+
+  PipelinedExecutor<int> executor(kMaxInFlight);
+  std::atomic<int> in_flight{0};
+  std::atomic<int> max_in_flight{0};
+  executor.AddStage(2, [&](int worker, int* item) {
+    const int now = ++in_flight;
+    int seen = max_in_flight;
+    while (now > seen && !max_in_flight.compare_exchange_weak(seen, now)) {
+    }
+    Jitter(*item);
+    *item *= 2;
+    return kTfLiteOk;
+  });
+  // Each worker owns a slot that only it may touch at a time.
+  std::vector<std::unique_ptr<std::atomic<bool>>> busy;
+  for (int i = 0; i < kNumInterpreters; ++i) {
+    busy.push_back(std::make_unique<std::atomic<bool>>(false));
+  }
+  executor.AddStage(kNumInterpreters, [&](int worker, int* item) {
+    if (worker < 0 || worker >= kNumInterpreters || busy[worker]->exchange(true)) {
+      return kTfLiteError;
+    }
+    Jitter(*item + 1);
+    *item += 1;
+    busy[worker]->store(false);
+    return kTfLiteOk;
+  });
+
+  std::vector<int> items;
+  for (int i = 0; i < kNumItems; ++i) items.push_back(i);
+  std::vector<int> results;
+  ASSERT_EQ(executor.Run(items,
+                         [&](size_t index, int* item) {
+                           --in_flight;
+                           EXPECT_EQ(index, results.size());
+                           results.push_back(*item);
+                           return kTfLiteOk;
+                         }),
+            kTfLiteOk);
+
+  ASSERT_EQ(results.size(), kNumItems);
+  for (int i = 0; i < kNumItems; ++i) {
+    EXPECT_EQ(results[i], 2 * i + 1);
+  }
+  EXPECT_LE(max_in_flight, kMaxInFlight);
+}
+
+TEST(PipelinedExecutorTest, StageFailureStopsTheRun) {
+  PipelinedExecutor<int> executor(4);
+  executor.AddStage(3, [](int worker, int* item) {
+    Jitter(*item);
+    return *item == 50 ? kTfLiteError : kTfLiteOk;
+  });
+  std::vector<int> items;
+  for (int i = 0; i < 1000; ++i) items.push_back(i);
+  int consumed = 0;
+  EXPECT_EQ(executor.Run(items,
+                         [&](size_t index, int* item) {
+                           ++consumed;
+                           return kTfLiteOk;
+                         }),
+            kTfLiteError);
+  EXPECT_LE(consumed, 50);
+}
+
+TEST(PipelinedExecutorTest, SinkFailureStopsTheRun) {
+  PipelinedExecutor<int> executor(4);
+  executor.AddStage(2, [](int worker, int* item) { return kTfLiteOk; });
+  std::vector<int> items(100, 0);
+  int consumed = 0;
+  EXPECT_EQ(executor.Run(items,
+                         [&](size_t index, int* item) {
+                           return ++consumed == 10 ? kTfLiteError : kTfLiteOk;
+                         }),
+            kTfLiteError);
+  EXPECT_EQ(consumed, 10);
+}
+
+TEST(PipelinedExecutorTest, NoItemsOrStages) {
+  PipelinedExecutor<int> executor(4);
+  int consumed = 0;
+  auto sink = [&](size_t index, int* item) {
+    ++consumed;
+    return kTfLiteOk;
+  };
+  EXPECT_EQ(executor.Run({1, 2, 3}, sink), kTfLiteOk);
+  EXPECT_EQ(consumed, 3);
+  executor.AddStage(2, [](int worker, int* item) { return kTfLiteOk; });
+  EXPECT_EQ(executor.Run({}, sink), kTfLiteOk);
+  EXPECT_EQ(consumed, 3);
+}
+
+TEST(PipelineOptionsTest, IsPipelined) {
+  PipelineOptions options;
+  EXPECT_FALSE(options.IsPipelined());
+  options.max_in_flight = 1;
+  EXPECT_FALSE(options.IsPipelined());
+  options.num_preprocessing_threads = 2;
+  EXPECT_TRUE(options.IsPipelined());
+  options.num_preprocessing_threads = 1;
+  options.num_interpreters = 2;
+  EXPECT_TRUE(options.IsPipelined());
+}
+
+}  // namespace
+}  // namespace evaluation
+}  // namespace tflite
@@ -16,15 +16,19 @@ limitations under the License.
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/log/log.h"
+#include "xla/tsl/util/stats_calculator.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
@@ -37,6 +41,30 @@ namespace evaluation {
 namespace {
 // Default cropping fraction value.
 const float kCroppingFraction = 0.875;
+
+// An image on its way through RunPipelined().
+struct PipelinedExample {
+  std::string image_path;
+  std::string label;
+  // Encoded file contents, dropped once decoded.
+  std::string contents;
+  // Model input and output, copied out of the stages so that the worker can
+  // move on to the next image.
+  std::vector<uint8_t> input;
+  std::vector<uint8_t> output;
+  int64_t preprocessing_latency_us = 0;
+  int64_t inference_latency_us = 0;
+};
+
+void SetLatencyMetrics(const tsl::Stat<int64_t>& stats,
+                       LatencyMetrics* latency_metrics) {
+  latency_metrics->set_last_us(stats.newest());
+  latency_metrics->set_max_us(stats.max());
+  latency_metrics->set_min_us(stats.min());
+  latency_metrics->set_sum_us(stats.sum());
+  latency_metrics->set_avg_us(stats.avg());
+  latency_metrics->set_std_deviation_us(stats.std_deviation());
+}
 }  // namespace
 
 TfLiteStatus ImageClassificationStage::Init(
@@ -78,19 +106,35 @@ TfLiteStatus ImageClassificationStage::Init(
   }
 
   // ImagePreprocessingStage
+  EvaluationStageConfig preprocessing_config = config_;
   if (!config_.specification().has_image_preprocessing_params()) {
     tflite::evaluation::ImagePreprocessingConfigBuilder builder(
         "image_preprocessing", input_type);
     builder.AddCroppingStep(kCroppingFraction, true /*square*/);
     builder.AddResizingStep(input_shape->data[2], input_shape->data[1], false);
     builder.AddDefaultNormalizationStep();
-    preprocessing_stage_ =
-        std::make_unique<ImagePreprocessingStage>(builder.build());
-  } else {
-    preprocessing_stage_ = std::make_unique<ImagePreprocessingStage>(config_);
+    preprocessing_config = builder.build();
   }
+  preprocessing_stage_ =
+      std::make_unique<ImagePreprocessingStage>(preprocessing_config);
   if (preprocessing_stage_->Init() != kTfLiteOk) return kTfLiteError;
 
+  // Additional pipeline workers.
+  pipeline_preprocessing_stages_.clear();
+  for (int i = 1; i < pipeline_options_.num_preprocessing_threads; ++i) {
+    auto stage =
+        std::make_unique<ImagePreprocessingStage>(preprocessing_config);
+    if (stage->Init() != kTfLiteOk) return kTfLiteError;
+    pipeline_preprocessing_stages_.push_back(std::move(stage));
+  }
+  pipeline_inference_stages_.clear();
+  for (int i = 1; i < pipeline_options_.num_interpreters; ++i) {
+    auto stage =
+        std::make_unique<TfliteInferenceStage>(tflite_inference_config);
+    if (stage->Init(delegate_providers) != kTfLiteOk) return kTfLiteError;
+    pipeline_inference_stages_.push_back(std::move(stage));
+  }
+
   // TopkAccuracyEvalStage.
   if (params.has_topk_accuracy_eval_params()) {
     EvaluationStageConfig topk_accuracy_eval_config;
@@ -140,10 +184,119 @@ TfLiteStatus ImageClassificationStage::Run() {
   return kTfLiteOk;
 }
 
+TfLiteStatus ImageClassificationStage::RunPipelined(
+    const std::vector<ImageLabel>& image_labels) {
+  if (!preprocessing_stage_ || !inference_stage_) {
+    LOG(ERROR) << "Stage not initialized";
+    return kTfLiteError;
+  }
+  if (accuracy_eval_stage_) {
+    for (const ImageLabel& image_label : image_labels) {
+      if (image_label.label.empty()) {
+        LOG(ERROR) << "Ground truth label not provided";
+        return kTfLiteError;
+      }
+    }
+  }
+  const TfLiteModelInfo* model_info = inference_stage_->GetModelInfo();
+  const size_t input_bytes = model_info->inputs[0]->bytes;
+  const size_t output_bytes = model_info->outputs[0]->bytes;
+
+  std::vector<PipelinedExample> examples(image_labels.size());
+  for (size_t i = 0; i < image_labels.size(); ++i) {
+    examples[i].image_path = image_labels[i].image;
+    examples[i].label = image_labels[i].label;
+  }
+
+  PipelinedExecutor<PipelinedExample> executor(
+      pipeline_options_.max_in_flight);
+  executor.AddStage(pipeline_options_.num_reader_threads,
+                    [](int worker, PipelinedExample* example) {
+                      if (!ReadImageFile(example->image_path,
+                                         &example->contents)) {
+                        LOG(ERROR) << "Could not read " << example->image_path;
+                        return kTfLiteError;
+                      }
+                      return kTfLiteOk;
+                    });
+  executor.AddStage(
+      static_cast<int>(1 + pipeline_preprocessing_stages_.size()),
+      [&](int worker, PipelinedExample* example) {
+        ImagePreprocessingStage* stage =
+            worker == 0 ? preprocessing_stage_.get()
+                        : pipeline_preprocessing_stages_[worker - 1].get();
+        stage->SetImage(&example->image_path, &example->contents);
+        if (stage->Run() != kTfLiteOk) return kTfLiteError;
+        const auto* data =
+            static_cast<const uint8_t*>(stage->GetPreprocessedImageData());
+        example->input.assign(data, data + input_bytes);
+        std::string().swap(example->contents);
+        example->preprocessing_latency_us =
+            stage->LatestMetrics().process_metrics().total_latency().last_us();
+        return kTfLiteOk;
+      });
+  executor.AddStage(
+      static_cast<int>(1 + pipeline_inference_stages_.size()),
+      [&](int worker, PipelinedExample* example) {
+        TfliteInferenceStage* stage =
+            worker == 0 ? inference_stage_.get()
+                        : pipeline_inference_stages_[worker - 1].get();
+        const std::vector<void*> data_ptrs = {example->input.data()};
+        stage->SetInputs(data_ptrs);
+        if (stage->Run() != kTfLiteOk) return kTfLiteError;
+        const auto* data =
+            static_cast<const uint8_t*>(stage->GetOutputs()->at(0));
+        example->output.assign(data, data + output_bytes);
+        example->inference_latency_us =
+            stage->LatestMetrics().process_metrics().total_latency().last_us();
+        return kTfLiteOk;
+      });
+
+  ran_pipelined_ = true;
+  return executor.Run(
+      std::move(examples), [&](size_t index, PipelinedExample* example) {
+        pipeline_preprocessing_latency_.UpdateStat(
+            example->preprocessing_latency_us);
+        pipeline_inference_latency_.UpdateStat(example->inference_latency_us);
+        if (!accuracy_eval_stage_) return kTfLiteOk;
+        accuracy_eval_stage_->SetEvalInputs(example->output.data(),
+                                            &example->label);
+        return accuracy_eval_stage_->Run();
+      });
+}
+
 EvaluationStageMetrics ImageClassificationStage::LatestMetrics() {
   EvaluationStageMetrics metrics;
   auto* classification_metrics =
       metrics.mutable_process_metrics()->mutable_image_classification_metrics();
+  if (ran_pipelined_) {
+    SetLatencyMetrics(pipeline_preprocessing_latency_,
+                      classification_metrics->mutable_pre_processing_latency());
+    SetLatencyMetrics(pipeline_inference_latency_,
+                      classification_metrics->mutable_inference_latency());
+    // Every interpreter counts its own inferences.
+    int num_inferences = inference_stage_->LatestMetrics()
+                             .process_metrics()
+                             .tflite_inference_metrics()
+                             .num_inferences();
+    for (const auto& stage : pipeline_inference_stages_) {
+      num_inferences += stage->LatestMetrics()
+                            .process_metrics()
+                            .tflite_inference_metrics()
+                            .num_inferences();
+    }
+    classification_metrics->mutable_inference_metrics()->set_num_inferences(
+        num_inferences);
+    if (accuracy_eval_stage_) {
+      *classification_metrics->mutable_topk_accuracy_metrics() =
+          accuracy_eval_stage_->LatestMetrics()
+              .process_metrics()
+              .topk_accuracy_metrics();
+    }
+    metrics.set_num_runs(
+        static_cast<int>(pipeline_inference_latency_.count()));
+    return metrics;
+  }
 
   *classification_metrics->mutable_pre_processing_latency() =
       preprocessing_stage_->LatestMetrics().process_metrics().total_latency();
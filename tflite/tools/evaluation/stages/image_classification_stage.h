@@ -15,13 +15,16 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_IMAGE_CLASSIFICATION_STAGE_H_
 #define TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_IMAGE_CLASSIFICATION_STAGE_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "xla/tsl/util/stats_calculator.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
 #include "tflite/tools/evaluation/evaluation_stage.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
 #include "tflite/tools/evaluation/stages/tflite_inference_stage.h"
@@ -30,6 +33,11 @@ limitations under the License.
 namespace tflite {
 namespace evaluation {
 
+struct ImageLabel {
+  std::string image;
+  std::string label;
+};
+
 // An EvaluationStage to encapsulate the complete Image Classification task.
 // Utilizes ImagePreprocessingStage, TfLiteInferenceStage &
 // TopkAccuracyEvalStage for individual sub-tasks.
@@ -61,6 +69,18 @@ class ImageClassificationStage : public EvaluationStage {
     ground_truth_label_ = ground_truth_label;
   }
 
+  // Call before Init() to evaluate with RunPipelined().
+  void SetPipelineOptions(const PipelineOptions& options) {
+    pipeline_options_ = options;
+  }
+
+  // Evaluates all of `image_labels`, instead of calling SetInputs() and Run()
+  // for each of them. Reading, preprocessing and inference run on separate
+  // thread pools so that consecutive images overlap. Accuracy and latencies
+  // are accumulated in the order of `image_labels`, so the metrics don't
+  // depend on how the images were scheduled.
+  TfLiteStatus RunPipelined(const std::vector<ImageLabel>& image_labels);
+
   // Provides a pointer to the underlying TfLiteInferenceStage.
   // Returns non-null value only if this stage has been initialized.
   TfliteInferenceStage* const GetInferenceStage() {
@@ -74,11 +94,16 @@ class ImageClassificationStage : public EvaluationStage {
   std::unique_ptr<TopkAccuracyEvalStage> accuracy_eval_stage_;
   std::string image_path_;
   std::string ground_truth_label_;
-};
 
-struct ImageLabel {
-  std::string image;
-  std::string label;
+  PipelineOptions pipeline_options_;
+  // Workers 1 and up of the pipeline. Worker 0 uses preprocessing_stage_ and
+  // inference_stage_.
+  std::vector<std::unique_ptr<ImagePreprocessingStage>>
+      pipeline_preprocessing_stages_;
+  std::vector<std::unique_ptr<TfliteInferenceStage>> pipeline_inference_stages_;
+  bool ran_pipelined_ = false;
+  tsl::Stat<int64_t> pipeline_preprocessing_latency_;
+  tsl::Stat<int64_t> pipeline_inference_latency_;
 };
 
 // Reads a file containing newline-separated denylisted image indices and
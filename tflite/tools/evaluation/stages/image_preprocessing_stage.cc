@@ -67,24 +67,19 @@ struct ImageData {
 };
 
 // Loads the raw image.
-inline void LoadImageRaw(std::string* filename, ImageData* image_data) {
-  std::ifstream stream(filename->c_str(), std::ios::in | std::ios::binary);
-  std::vector<uint8_t> raw_data((std::istreambuf_iterator<char>(stream)),
-                                std::istreambuf_iterator<char>());
+inline void LoadImageRaw(const std::string& image_str, ImageData* image_data) {
   std::vector<float>* orig_image = new std::vector<float>();
-  orig_image->reserve(raw_data.size());
-  for (int i = 0; i < raw_data.size(); ++i) {
-    orig_image->push_back(static_cast<float>(raw_data[i]));
+  orig_image->reserve(image_str.size());
+  for (int i = 0; i < image_str.size(); ++i) {
+    orig_image->push_back(
+        static_cast<float>(static_cast<uint8_t>(image_str[i])));
   }
   image_data->data.reset(orig_image);
 }
 
 // Loads the jpeg image.
-inline void LoadImageJpeg(std::string* filename, ImageData* image_data) {
-  // Reads image.
-  std::ifstream t(*filename);
-  std::string image_str((std::istreambuf_iterator<char>(t)),
-                        std::istreambuf_iterator<char>());
+inline void LoadImageJpeg(const std::string& image_str,
+                          ImageData* image_data) {
   const int fsize = image_str.size();
   auto temp = absl::bit_cast<const uint8_t*>(image_str.data());
   std::unique_ptr<uint8_t[]> original_image;
@@ -246,6 +241,14 @@ inline void Normalize(ImageData* image_data,
 }
 }  // namespace
 
+bool ReadImageFile(const std::string& image_path, std::string* contents) {
+  std::ifstream stream(image_path, std::ios::in | std::ios::binary);
+  if (!stream) return false;
+  contents->assign(std::istreambuf_iterator<char>(stream),
+                   std::istreambuf_iterator<char>());
+  return true;
+}
+
 TfLiteStatus ImagePreprocessingStage::Init() {
   if (!config_.has_specification() ||
       !config_.specification().has_image_preprocessing_params()) {
@@ -284,14 +287,21 @@ TfLiteStatus ImagePreprocessingStage::Run() {
   string image_ext = image_path_->substr(image_path_->find_last_of("."));
   absl::AsciiStrToLower(&image_ext);
   bool is_raw_image = (image_ext == ".rgb8");
-  if (image_ext == ".rgb8") {
-    LoadImageRaw(image_path_, &image_data);
-  } else if (image_ext == ".jpg" || image_ext == ".jpeg") {
-    LoadImageJpeg(image_path_, &image_data);
-  } else {
+  if (!is_raw_image && image_ext != ".jpg" && image_ext != ".jpeg") {
     LOG(ERROR) << "Extension " << image_ext << " is not supported";
     return kTfLiteError;
   }
+  std::string file_contents;
+  if (image_contents_ == nullptr) {
+    ReadImageFile(*image_path_, &file_contents);
+  }
+  const std::string& contents =
+      image_contents_ != nullptr ? *image_contents_ : file_contents;
+  if (is_raw_image) {
+    LoadImageRaw(contents, &image_data);
+  } else {
+    LoadImageJpeg(contents, &image_data);
+  }
 
   // Cropping, padding and resizing are not supported with raw images since raw
   // images do not contain image size information. Those steps are assumed to
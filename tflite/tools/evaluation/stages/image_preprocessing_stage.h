@@ -49,13 +49,25 @@ class ImagePreprocessingStage : public EvaluationStage {
   ~ImagePreprocessingStage() override {}
 
   // Call before Run().
-  void SetImagePath(std::string* image_path) { image_path_ = image_path; }
+  void SetImagePath(std::string* image_path) {
+    image_path_ = image_path;
+    image_contents_ = nullptr;
+  }
+
+  // Call before Run() instead of SetImagePath() if the image file has already
+  // been read into `image_contents`. The format is still told from the
+  // extension of `image_path`.
+  void SetImage(std::string* image_path, const std::string* image_contents) {
+    image_path_ = image_path;
+    image_contents_ = image_contents;
+  }
 
   // Provides preprocessing output.
   void* GetPreprocessedImageData();
 
  private:
   std::string* image_path_ = nullptr;
+  const std::string* image_contents_ = nullptr;
   TfLiteType output_type_;
   tsl::Stat<int64_t> latency_stats_;
 
@@ -65,6 +77,10 @@ class ImagePreprocessingStage : public EvaluationStage {
   std::vector<uint8_t> uint8_preprocessed_image_;
 };
 
+// Reads the whole of the image file at `image_path` into `contents`, for
+// ImagePreprocessingStage::SetImage(). Returns false if it can't be opened.
+bool ReadImageFile(const std::string& image_path, std::string* contents);
+
 // Helper class to build a new ImagePreprocessingParams.
 class ImagePreprocessingConfigBuilder {
  public:
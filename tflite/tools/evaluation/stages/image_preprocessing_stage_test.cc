@@ -100,6 +100,34 @@ TEST(ImagePreprocessingStage, TestImagePreprocessingFloat) {
   EXPECT_EQ(metrics.process_metrics().total_latency().avg_us(), last_latency);
 }
 
+TEST(ImagePreprocessingStage, TestImagePreprocessingFromMemory) {
+  std::string image_path = kTestImage;
+  std::string image_contents;
+  ASSERT_TRUE(ReadImageFile(image_path, &image_contents));
+
+  ImagePreprocessingConfigBuilder builder(kImagePreprocessingStageName,
+                                          kTfLiteFloat32);
+  builder.AddCroppingStep(0.875);
+  builder.AddResizingStep(224, 224, false);
+  builder.AddNormalizationStep(127.5, 1.0 / 127.5);
+  ImagePreprocessingStage stage = ImagePreprocessingStage(builder.build());
+  EXPECT_EQ(stage.Init(), kTfLiteOk);
+
+  // The path only gives the format; the contents are not read from it again.
+  std::string missing_path = "does/not/exist.jpg";
+  stage.SetImage(&missing_path, &image_contents);
+  EXPECT_EQ(stage.Run(), kTfLiteOk);
+
+  float* preprocessed_image_ptr =
+      static_cast<float*>(stage.GetPreprocessedImageData());
+  ASSERT_NE(preprocessed_image_ptr, nullptr);
+  // Same values as when reading from the file in
+  // TestImagePreprocessingFloat.
+  EXPECT_FLOAT_EQ(preprocessed_image_ptr[0], -0.74901962);
+  EXPECT_FLOAT_EQ(preprocessed_image_ptr[1], -0.74901962);
+  EXPECT_FLOAT_EQ(preprocessed_image_ptr[2], -0.68627453);
+}
+
 TEST(ImagePreprocessingStage, TestImagePreprocessingFloat_NoCrop) {
   std::string image_path = kTestImage;
 
@@ -14,17 +14,23 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/tools/evaluation/stages/object_detection_stage.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
+#include "xla/tsl/util/stats_calculator.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tflite/core/c/common.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
@@ -33,6 +39,57 @@ limitations under the License.
 
 namespace tflite {
 namespace evaluation {
+namespace {
+
+// An image on its way through RunPipelined().
+struct PipelinedDetectionExample {
+  std::string image_path;
+  // Encoded file contents, dropped once decoded.
+  std::string contents;
+  // Model input, copied out of the preprocessing stage so that the worker can
+  // move on to the next image.
+  std::vector<uint8_t> input;
+  ObjectDetectionResult predicted_objects;
+  int64_t preprocessing_latency_us = 0;
+  int64_t inference_latency_us = 0;
+};
+
+// Converts the outputs of a detection model with the MobileNet SSD signature
+// to `predicted_objects`.
+void ConvertModelOutputs(const std::vector<void*>& outputs, int class_offset,
+                         ObjectDetectionResult* predicted_objects) {
+  predicted_objects->Clear();
+  int num_detections = static_cast<int>(*static_cast<float*>(outputs.at(3)));
+  float* detected_label_boxes = static_cast<float*>(outputs.at(0));
+  float* detected_label_indices = static_cast<float*>(outputs.at(1));
+  float* detected_label_probabilities = static_cast<float*>(outputs.at(2));
+  for (int i = 0; i < num_detections; ++i) {
+    const int bounding_box_offset = i * 4;
+    auto* object = predicted_objects->add_objects();
+    // Bounding box
+    auto* bbox = object->mutable_bounding_box();
+    bbox->set_normalized_top(detected_label_boxes[bounding_box_offset + 0]);
+    bbox->set_normalized_left(detected_label_boxes[bounding_box_offset + 1]);
+    bbox->set_normalized_bottom(detected_label_boxes[bounding_box_offset + 2]);
+    bbox->set_normalized_right(detected_label_boxes[bounding_box_offset + 3]);
+    // Class.
+    object->set_class_id(static_cast<int>(detected_label_indices[i]) +
+                         class_offset);
+    // Score
+    object->set_score(detected_label_probabilities[i]);
+  }
+}
+
+void SetLatencyMetrics(const tsl::Stat<int64_t>& stats,
+                       LatencyMetrics* latency_metrics) {
+  latency_metrics->set_last_us(stats.newest());
+  latency_metrics->set_max_us(stats.max());
+  latency_metrics->set_min_us(stats.min());
+  latency_metrics->set_sum_us(stats.sum());
+  latency_metrics->set_avg_us(stats.avg());
+  latency_metrics->set_std_deviation_us(stats.std_deviation());
+}
+}  // namespace
 
 TfLiteStatus ObjectDetectionStage::Init(
     const DelegateProviders* delegate_providers) {
@@ -80,10 +137,27 @@ TfLiteStatus ObjectDetectionStage::Init(
       "image_preprocessing", input_type);
   builder.AddResizingStep(input_shape->data[2], input_shape->data[1], false);
   builder.AddDefaultNormalizationStep();
+  const EvaluationStageConfig preprocessing_config = builder.build();
   preprocessing_stage_ =
-      std::make_unique<ImagePreprocessingStage>(builder.build());
+      std::make_unique<ImagePreprocessingStage>(preprocessing_config);
   TF_LITE_ENSURE_STATUS(preprocessing_stage_->Init());
 
+  // Additional pipeline workers.
+  pipeline_preprocessing_stages_.clear();
+  for (int i = 1; i < pipeline_options_.num_preprocessing_threads; ++i) {
+    auto stage =
+        std::make_unique<ImagePreprocessingStage>(preprocessing_config);
+    TF_LITE_ENSURE_STATUS(stage->Init());
+    pipeline_preprocessing_stages_.push_back(std::move(stage));
+  }
+  pipeline_inference_stages_.clear();
+  for (int i = 1; i < pipeline_options_.num_interpreters; ++i) {
+    auto stage =
+        std::make_unique<TfliteInferenceStage>(tflite_inference_config);
+    TF_LITE_ENSURE_STATUS(stage->Init(delegate_providers));
+    pipeline_inference_stages_.push_back(std::move(stage));
+  }
+
   // ObjectDetectionAveragePrecisionStage
   EvaluationStageConfig eval_config;
   eval_config.set_name("average_precision");
@@ -117,29 +191,10 @@ TfLiteStatus ObjectDetectionStage::Run() {
   TF_LITE_ENSURE_STATUS(inference_stage_->Run());
 
   // Convert model output to ObjectsSet.
-  predicted_objects_.Clear();
-  const int class_offset =
-      config_.specification().object_detection_params().class_offset();
-  const std::vector<void*>* outputs = inference_stage_->GetOutputs();
-  int num_detections = static_cast<int>(*static_cast<float*>(outputs->at(3)));
-  float* detected_label_boxes = static_cast<float*>(outputs->at(0));
-  float* detected_label_indices = static_cast<float*>(outputs->at(1));
-  float* detected_label_probabilities = static_cast<float*>(outputs->at(2));
-  for (int i = 0; i < num_detections; ++i) {
-    const int bounding_box_offset = i * 4;
-    auto* object = predicted_objects_.add_objects();
-    // Bounding box
-    auto* bbox = object->mutable_bounding_box();
-    bbox->set_normalized_top(detected_label_boxes[bounding_box_offset + 0]);
-    bbox->set_normalized_left(detected_label_boxes[bounding_box_offset + 1]);
-    bbox->set_normalized_bottom(detected_label_boxes[bounding_box_offset + 2]);
-    bbox->set_normalized_right(detected_label_boxes[bounding_box_offset + 3]);
-    // Class.
-    object->set_class_id(static_cast<int>(detected_label_indices[i]) +
-                         class_offset);
-    // Score
-    object->set_score(detected_label_probabilities[i]);
-  }
+  ConvertModelOutputs(
+      *inference_stage_->GetOutputs(),
+      config_.specification().object_detection_params().class_offset(),
+      &predicted_objects_);
 
   // AP Evaluation.
   eval_stage_->SetEvalInputs(predicted_objects_, *ground_truth_objects_);
@@ -148,10 +203,125 @@ TfLiteStatus ObjectDetectionStage::Run() {
   return kTfLiteOk;
 }
 
+TfLiteStatus ObjectDetectionStage::RunPipelined(
+    const std::vector<std::string>& image_paths,
+    const std::vector<const ObjectDetectionResult*>& ground_truth_objects,
+    const std::function<void(size_t, const ObjectDetectionResult&)>&
+        on_prediction) {
+  if (!preprocessing_stage_ || !inference_stage_ || !eval_stage_) {
+    LOG(ERROR) << "Stage not initialized";
+    return kTfLiteError;
+  }
+  if (image_paths.size() != ground_truth_objects.size()) {
+    LOG(ERROR) << "Got " << image_paths.size() << " images but "
+               << ground_truth_objects.size() << " ground truths";
+    return kTfLiteError;
+  }
+  for (size_t i = 0; i < image_paths.size(); ++i) {
+    if (image_paths[i].empty() || ground_truth_objects[i] == nullptr) {
+      LOG(ERROR) << "Input image or ground truth not set";
+      return kTfLiteError;
+    }
+  }
+  const size_t input_bytes =
+      inference_stage_->GetModelInfo()->inputs[0]->bytes;
+  const int class_offset =
+      config_.specification().object_detection_params().class_offset();
+
+  std::vector<PipelinedDetectionExample> examples(image_paths.size());
+  for (size_t i = 0; i < image_paths.size(); ++i) {
+    examples[i].image_path = image_paths[i];
+  }
+
+  PipelinedExecutor<PipelinedDetectionExample> executor(
+      pipeline_options_.max_in_flight);
+  executor.AddStage(pipeline_options_.num_reader_threads,
+                    [](int worker, PipelinedDetectionExample* example) {
+                      if (!ReadImageFile(example->image_path,
+                                         &example->contents)) {
+                        LOG(ERROR) << "Could not read " << example->image_path;
+                        return kTfLiteError;
+                      }
+                      return kTfLiteOk;
+                    });
+  executor.AddStage(
+      static_cast<int>(1 + pipeline_preprocessing_stages_.size()),
+      [&](int worker, PipelinedDetectionExample* example) {
+        ImagePreprocessingStage* stage =
+            worker == 0 ? preprocessing_stage_.get()
+                        : pipeline_preprocessing_stages_[worker - 1].get();
+        stage->SetImage(&example->image_path, &example->contents);
+        TF_LITE_ENSURE_STATUS(stage->Run());
+        const auto* data =
+            static_cast<const uint8_t*>(stage->GetPreprocessedImageData());
+        example->input.assign(data, data + input_bytes);
+        std::string().swap(example->contents);
+        example->preprocessing_latency_us =
+            stage->LatestMetrics().process_metrics().total_latency().last_us();
+        return kTfLiteOk;
+      });
+  executor.AddStage(
+      static_cast<int>(1 + pipeline_inference_stages_.size()),
+      [&](int worker, PipelinedDetectionExample* example) {
+        TfliteInferenceStage* stage =
+            worker == 0 ? inference_stage_.get()
+                        : pipeline_inference_stages_[worker - 1].get();
+        const std::vector<void*> data_ptrs = {example->input.data()};
+        stage->SetInputs(data_ptrs);
+        TF_LITE_ENSURE_STATUS(stage->Run());
+        ConvertModelOutputs(*stage->GetOutputs(), class_offset,
+                            &example->predicted_objects);
+        std::vector<uint8_t>().swap(example->input);
+        example->inference_latency_us =
+            stage->LatestMetrics().process_metrics().total_latency().last_us();
+        return kTfLiteOk;
+      });
+
+  ran_pipelined_ = true;
+  return executor.Run(
+      std::move(examples),
+      [&](size_t index, PipelinedDetectionExample* example) {
+        pipeline_preprocessing_latency_.UpdateStat(
+            example->preprocessing_latency_us);
+        pipeline_inference_latency_.UpdateStat(example->inference_latency_us);
+        predicted_objects_ = std::move(example->predicted_objects);
+        if (on_prediction) on_prediction(index, predicted_objects_);
+        eval_stage_->SetEvalInputs(predicted_objects_,
+                                   *ground_truth_objects[index]);
+        return eval_stage_->Run();
+      });
+}
+
 EvaluationStageMetrics ObjectDetectionStage::LatestMetrics() {
   EvaluationStageMetrics metrics;
   auto* detection_metrics =
       metrics.mutable_process_metrics()->mutable_object_detection_metrics();
+  if (ran_pipelined_) {
+    SetLatencyMetrics(pipeline_preprocessing_latency_,
+                      detection_metrics->mutable_pre_processing_latency());
+    SetLatencyMetrics(pipeline_inference_latency_,
+                      detection_metrics->mutable_inference_latency());
+    // Every interpreter counts its own inferences.
+    int num_inferences = inference_stage_->LatestMetrics()
+                             .process_metrics()
+                             .tflite_inference_metrics()
+                             .num_inferences();
+    for (const auto& stage : pipeline_inference_stages_) {
+      num_inferences += stage->LatestMetrics()
+                            .process_metrics()
+                            .tflite_inference_metrics()
+                            .num_inferences();
+    }
+    detection_metrics->mutable_inference_metrics()->set_num_inferences(
+        num_inferences);
+    *detection_metrics->mutable_average_precision_metrics() =
+        eval_stage_->LatestMetrics()
+            .process_metrics()
+            .object_detection_average_precision_metrics();
+    metrics.set_num_runs(
+        static_cast<int>(pipeline_inference_latency_.count()));
+    return metrics;
+  }
 
   *detection_metrics->mutable_pre_processing_latency() =
       preprocessing_stage_->LatestMetrics().process_metrics().total_latency();
@@ -15,14 +15,19 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_OBJECT_DETECTION_STAGE_H_
 #define TENSORFLOW_LITE_TOOLS_EVALUATION_STAGES_OBJECT_DETECTION_STAGE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "xla/tsl/util/stats_calculator.h"
 #include "tflite/c/c_api_types.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
 #include "tflite/tools/evaluation/evaluation_stage.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/image_preprocessing_stage.h"
@@ -68,6 +73,24 @@ class ObjectDetectionStage : public EvaluationStage {
     ground_truth_objects_ = &ground_truth_objects;
   }
 
+  // Call before Init() to evaluate with RunPipelined().
+  void SetPipelineOptions(const PipelineOptions& options) {
+    pipeline_options_ = options;
+  }
+
+  // Evaluates all of `image_paths` against the ground truth at the same index
+  // of `ground_truth_objects`, instead of calling SetInputs() and Run() for
+  // each image. Reading, preprocessing and inference run on separate thread
+  // pools so that consecutive images overlap. Average precision and latencies
+  // are accumulated in the order of `image_paths`, so the metrics don't
+  // depend on how the images were scheduled. If set, `on_prediction` is called
+  // in that order as well, with the index and predictions of each image.
+  TfLiteStatus RunPipelined(
+      const std::vector<std::string>& image_paths,
+      const std::vector<const ObjectDetectionResult*>& ground_truth_objects,
+      const std::function<void(size_t, const ObjectDetectionResult&)>&
+          on_prediction = nullptr);
+
   // Provides a pointer to the underlying TfLiteInferenceStage.
   // Returns non-null value only if this stage has been initialized.
   TfliteInferenceStage* const GetInferenceStage() {
@@ -90,6 +113,16 @@ class ObjectDetectionStage : public EvaluationStage {
   const ObjectDetectionResult* ground_truth_objects_;
   // Reflects the outputs generated from the latest call to Run().
   ObjectDetectionResult predicted_objects_;
+
+  PipelineOptions pipeline_options_;
+  // Workers 1 and up of the pipeline. Worker 0 uses preprocessing_stage_ and
+  // inference_stage_.
+  std::vector<std::unique_ptr<ImagePreprocessingStage>>
+      pipeline_preprocessing_stages_;
+  std::vector<std::unique_ptr<TfliteInferenceStage>> pipeline_inference_stages_;
+  bool ran_pipelined_ = false;
+  tsl::Stat<int64_t> pipeline_preprocessing_latency_;
+  tsl::Stat<int64_t> pipeline_inference_latency_;
 };
 
 // Reads a tflite::evaluation::ObjectDetectionGroundTruth instance from a
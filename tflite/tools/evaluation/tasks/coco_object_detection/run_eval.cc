@@ -12,7 +12,9 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <cstddef>
 #include <fstream>
+#include <functional>
 #include <ios>
 #include <memory>
 #include <optional>
@@ -23,6 +25,7 @@ limitations under the License.
 #include "tflite/core/c/common.h"
 #include "tflite/tools/command_line_flags.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/object_detection_stage.h"
@@ -41,6 +44,9 @@ constexpr char kGroundTruthProtoFileFlag[] = "ground_truth_proto";
 constexpr char kInterpreterThreadsFlag[] = "num_interpreter_threads";
 constexpr char kDebugModeFlag[] = "debug_mode";
 constexpr char kDelegateFlag[] = "delegate";
+constexpr char kNumReaderThreadsFlag[] = "num_reader_threads";
+constexpr char kNumPreprocessingThreadsFlag[] = "num_preprocessing_threads";
+constexpr char kNumInterpretersFlag[] = "num_interpreters";
 
 std::string GetNameFromPath(const std::string& str) {
   int pos = str.find_last_of("/\\");
@@ -48,6 +54,28 @@ std::string GetNameFromPath(const std::string& str) {
   return str.substr(pos + 1);
 }
 
+void LogPrediction(const std::string& image_name,
+                   const ObjectDetectionResult& prediction) {
+  TFLITE_LOG(INFO) << "Image: " << image_name << "\n";
+  for (int i = 0; i < prediction.objects_size(); ++i) {
+    const auto& object = prediction.objects(i);
+    TFLITE_LOG(INFO) << "Object [" << i << "]";
+    TFLITE_LOG(INFO) << "  Score: " << object.score();
+    TFLITE_LOG(INFO) << "  Class-ID: " << object.class_id();
+    TFLITE_LOG(INFO) << "  Bounding Box:";
+    const auto& bounding_box = object.bounding_box();
+    TFLITE_LOG(INFO) << "    Normalized Top: " << bounding_box.normalized_top();
+    TFLITE_LOG(INFO) << "    Normalized Bottom: "
+                     << bounding_box.normalized_bottom();
+    TFLITE_LOG(INFO) << "    Normalized Left: "
+                     << bounding_box.normalized_left();
+    TFLITE_LOG(INFO) << "    Normalized Right: "
+                     << bounding_box.normalized_right();
+  }
+  TFLITE_LOG(INFO)
+      << "======================================================\n";
+}
+
 class CocoObjectDetection : public TaskExecutor {
  public:
   CocoObjectDetection() : debug_mode_(false), num_interpreter_threads_(1) {}
@@ -69,6 +97,7 @@ class CocoObjectDetection : public TaskExecutor {
   bool debug_mode_;
   std::string delegate_;
   int num_interpreter_threads_;
+  PipelineOptions pipeline_options_;
 };
 
 std::vector<Flag> CocoObjectDetection::GetFlags() {
@@ -106,6 +135,18 @@ std::vector<Flag> CocoObjectDetection::GetFlags() {
           kDelegateFlag, &delegate_,
           "Delegate to use for inference, if available. "
           "Must be one of {'nnapi', 'gpu', 'xnnpack', 'hexagon'}"),
+      tflite::Flag::CreateFlag(
+          kNumReaderThreadsFlag, &pipeline_options_.num_reader_threads,
+          "Number of threads reading images from disk."),
+      tflite::Flag::CreateFlag(
+          kNumPreprocessingThreadsFlag,
+          &pipeline_options_.num_preprocessing_threads,
+          "Number of threads decoding and preprocessing images."),
+      tflite::Flag::CreateFlag(
+          kNumInterpretersFlag, &pipeline_options_.num_interpreters,
+          "Number of interpreters running inference concurrently. If any of "
+          "the pipeline flags is greater than 1, reading, preprocessing and "
+          "inference overlap across images."),
   };
   return flag_list;
 }
@@ -142,39 +183,47 @@ std::optional<EvaluationStageMetrics> CocoObjectDetection::RunImpl() {
   ObjectDetectionStage eval(eval_config);
 
   eval.SetAllLabels(model_labels);
+  const bool pipelined = pipeline_options_.IsPipelined();
+  if (pipelined) eval.SetPipelineOptions(pipeline_options_);
   if (eval.Init(&delegate_providers_) != kTfLiteOk) return std::nullopt;
 
-  const int step = image_paths.size() / 100;
-  for (int i = 0; i < image_paths.size(); ++i) {
-    if (step > 1 && i % step == 0) {
-      TFLITE_LOG(INFO) << "Finished: " << i / step << "%";
+  if (pipelined) {
+    std::vector<std::string> image_names;
+    image_names.reserve(image_paths.size());
+    for (const std::string& image_path : image_paths) {
+      image_names.push_back(GetNameFromPath(image_path));
+      // Insert all entries before taking pointers, as inserting may move
+      // existing ones.
+      ground_truth_map[image_names.back()];
     }
-
-    const std::string image_name = GetNameFromPath(image_paths[i]);
-    eval.SetInputs(image_paths[i], ground_truth_map[image_name]);
-    if (eval.Run() != kTfLiteOk) return std::nullopt;
-
+    std::vector<const ObjectDetectionResult*> ground_truth_objects;
+    ground_truth_objects.reserve(image_names.size());
+    for (const std::string& image_name : image_names) {
+      ground_truth_objects.push_back(&ground_truth_map[image_name]);
+    }
+    std::function<void(size_t, const ObjectDetectionResult&)> on_prediction;
     if (debug_mode_) {
-      ObjectDetectionResult prediction = *eval.GetLatestPrediction();
-      TFLITE_LOG(INFO) << "Image: " << image_name << "\n";
-      for (int i = 0; i < prediction.objects_size(); ++i) {
-        const auto& object = prediction.objects(i);
-        TFLITE_LOG(INFO) << "Object [" << i << "]";
-        TFLITE_LOG(INFO) << "  Score: " << object.score();
-        TFLITE_LOG(INFO) << "  Class-ID: " << object.class_id();
-        TFLITE_LOG(INFO) << "  Bounding Box:";
-        const auto& bounding_box = object.bounding_box();
-        TFLITE_LOG(INFO) << "    Normalized Top: "
-                         << bounding_box.normalized_top();
-        TFLITE_LOG(INFO) << "    Normalized Bottom: "
-                         << bounding_box.normalized_bottom();
-        TFLITE_LOG(INFO) << "    Normalized Left: "
-                         << bounding_box.normalized_left();
-        TFLITE_LOG(INFO) << "    Normalized Right: "
-                         << bounding_box.normalized_right();
+      on_prediction = [&](size_t index,
+                          const ObjectDetectionResult& prediction) {
+        LogPrediction(image_names[index], prediction);
+      };
+    }
+    if (eval.RunPipelined(image_paths, ground_truth_objects, on_prediction) !=
+        kTfLiteOk) {
+      return std::nullopt;
+    }
+  } else {
+    const int step = image_paths.size() / 100;
+    for (int i = 0; i < image_paths.size(); ++i) {
+      if (step > 1 && i % step == 0) {
+        TFLITE_LOG(INFO) << "Finished: " << i / step << "%";
       }
-      TFLITE_LOG(INFO)
-          << "======================================================\n";
+
+      const std::string image_name = GetNameFromPath(image_paths[i]);
+      eval.SetInputs(image_paths[i], ground_truth_map[image_name]);
+      if (eval.Run() != kTfLiteOk) return std::nullopt;
+
+      if (debug_mode_) LogPrediction(image_name, *eval.GetLatestPrediction());
     }
   }
 
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tflite/core/c/common.h"
 #include "tflite/tools/command_line_flags.h"
 #include "tflite/tools/evaluation/evaluation_delegate_provider.h"
+#include "tflite/tools/evaluation/pipelined_executor.h"
 #include "tflite/tools/evaluation/proto/evaluation_config.pb.h"
 #include "tflite/tools/evaluation/proto/evaluation_stages.pb.h"
 #include "tflite/tools/evaluation/stages/image_classification_stage.h"
@@ -41,6 +42,9 @@ constexpr char kDenylistFilePathFlag[] = "denylist_file_path";
 constexpr char kNumImagesFlag[] = "num_images";
 constexpr char kInterpreterThreadsFlag[] = "num_interpreter_threads";
 constexpr char kDelegateFlag[] = "delegate";
+constexpr char kNumReaderThreadsFlag[] = "num_reader_threads";
+constexpr char kNumPreprocessingThreadsFlag[] = "num_preprocessing_threads";
+constexpr char kNumInterpretersFlag[] = "num_interpreters";
 
 template <typename T>
 std::vector<T> GetFirstN(const std::vector<T>& v, int n) {
@@ -71,6 +75,7 @@ class ImagenetClassification : public TaskExecutor {
   std::string delegate_;
   int num_images_;
   int num_interpreter_threads_;
+  PipelineOptions pipeline_options_;
 };
 
 std::vector<Flag> ImagenetClassification::GetFlags() {
@@ -108,6 +113,18 @@ std::vector<Flag> ImagenetClassification::GetFlags() {
           kDelegateFlag, &delegate_,
           "Delegate to use for inference, if available. "
           "Must be one of {'nnapi', 'gpu', 'hexagon', 'xnnpack'}"),
+      tflite::Flag::CreateFlag(
+          kNumReaderThreadsFlag, &pipeline_options_.num_reader_threads,
+          "Number of threads reading images from disk."),
+      tflite::Flag::CreateFlag(
+          kNumPreprocessingThreadsFlag,
+          &pipeline_options_.num_preprocessing_threads,
+          "Number of threads decoding and preprocessing images."),
+      tflite::Flag::CreateFlag(
+          kNumInterpretersFlag, &pipeline_options_.num_interpreters,
+          "Number of interpreters running inference concurrently. If any of "
+          "the pipeline flags is greater than 1, reading, preprocessing and "
+          "inference overlap across images."),
   };
   return flag_list;
 }
@@ -160,8 +177,17 @@ std::optional<EvaluationStageMetrics> ImagenetClassification::RunImpl() {
   ImageClassificationStage eval(eval_config);
 
   eval.SetAllLabels(model_labels);
+  const bool pipelined = pipeline_options_.IsPipelined();
+  if (pipelined) eval.SetPipelineOptions(pipeline_options_);
   if (eval.Init(&delegate_providers_) != kTfLiteOk) return std::nullopt;
 
+  if (pipelined) {
+    if (eval.RunPipelined(image_labels) != kTfLiteOk) return std::nullopt;
+    const auto latest_metrics = eval.LatestMetrics();
+    OutputResult(latest_metrics);
+    return std::make_optional(latest_metrics);
+  }
+
   const int step = image_labels.size() / 100;
   for (int i = 0; i < image_labels.size(); ++i) {
     if (step > 1 && i % step == 0) {
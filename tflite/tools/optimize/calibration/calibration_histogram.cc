@@ -0,0 +1,312 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/calibration/calibration_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+
+namespace {
+
+// Re-bins |counts| from a range [-R, R] to [-2R, 2R]. Pairs of adjacent bins
+// are merged into the middle half of the histogram.
+void DoubleRange(std::vector<int64_t>* counts) {
+  const int num_bins = counts->size();
+  std::vector<int64_t> doubled(num_bins, 0);
+  for (int i = 0; i < num_bins; ++i) {
+    doubled[num_bins / 4 + i / 2] += (*counts)[i];
+  }
+  counts->swap(doubled);
+}
+
+// Largest finite power of two, the histogram range never grows past it so
+// that bin computations stay finite.
+const float kMaxRange =
+    std::ldexp(1.0f, std::numeric_limits<float>::max_exponent - 1);
+
+// Smallest power of two that is >= |value|, |value| must be positive. Values
+// above |kMaxRange| give |kMaxRange|.
+float NextPowerOfTwo(float value) {
+  int exponent;
+  const float mantissa = std::frexp(value, &exponent);
+  // frexp returns mantissa in [0.5, 1), exact powers of two give 0.5.
+  if (mantissa == 0.5f) return value;
+  return std::min(std::ldexp(1.0f, exponent), kMaxRange);
+}
+
+}  // namespace
+
+Histogram::Histogram(int num_bins)
+    : counts_(std::max(4, num_bins - num_bins % 4), 0) {}
+
+int Histogram::BinIndex(float value) const {
+  // In double, |value + range_| overflows float for values near FLT_MAX.
+  const double bin = std::floor((static_cast<double>(value) + range_) /
+                                static_cast<double>(BinWidth()));
+  return static_cast<int>(
+      std::min(std::max(bin, 0.0), static_cast<double>(num_bins() - 1)));
+}
+
+void Histogram::GrowRange(float abs_max) {
+  if (range_ == 0) {
+    range_ = NextPowerOfTwo(abs_max);
+    counts_[num_bins() / 2] += pending_zeros_;
+    pending_zeros_ = 0;
+    return;
+  }
+  while (range_ < abs_max && range_ < kMaxRange) {
+    DoubleRange(&counts_);
+    range_ *= 2;
+  }
+}
+
+TfLiteStatus Histogram::Update(const float* values, size_t tensor_size) {
+  float abs_max = 0;
+  for (size_t i = 0; i < tensor_size; ++i) {
+    const float value = values[i];
+    // NaN and infinities are reported by |MinMax| and can't be binned.
+    if (!std::isfinite(value)) continue;
+    abs_max = std::max(abs_max, std::abs(value));
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+  if (abs_max > 0) GrowRange(abs_max);
+
+  for (size_t i = 0; i < tensor_size; ++i) {
+    const float value = values[i];
+    if (!std::isfinite(value)) continue;
+    ++total_count_;
+    if (range_ == 0) {
+      ++pending_zeros_;
+    } else {
+      ++counts_[BinIndex(value)];
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Histogram::Merge(const Histogram& other) {
+  if (other.num_bins() != num_bins()) return kTfLiteError;
+  if (!other.HasValues()) return kTfLiteOk;
+
+  std::vector<int64_t> other_counts = other.counts_;
+  int64_t other_pending_zeros = other.pending_zeros_;
+  if (other.range_ > 0) {
+    GrowRange(other.range_);
+    float other_range = other.range_;
+    while (other_range < range_) {
+      DoubleRange(&other_counts);
+      other_range *= 2;
+    }
+    for (int i = 0; i < num_bins(); ++i) counts_[i] += other_counts[i];
+  }
+  if (range_ > 0) {
+    counts_[num_bins() / 2] += other_pending_zeros;
+  } else {
+    pending_zeros_ += other_pending_zeros;
+  }
+  total_count_ += other.total_count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  return kTfLiteOk;
+}
+
+void Histogram::GetPercentileRange(float percentile, float* min_val,
+                                   float* max_val) const {
+  const double tail =
+      total_count_ * (100.0 - std::min(std::max(percentile, 50.0f), 100.0f)) /
+      100.0;
+  int64_t cumulative = 0;
+  int lower_bin = 0;
+  for (; lower_bin < num_bins() - 1; ++lower_bin) {
+    cumulative += counts_[lower_bin];
+    if (cumulative > tail) break;
+  }
+  cumulative = 0;
+  int upper_bin = num_bins() - 1;
+  for (; upper_bin > 0; --upper_bin) {
+    cumulative += counts_[upper_bin];
+    if (cumulative > tail) break;
+  }
+  *min_val = std::max(min_, -range_ + lower_bin * BinWidth());
+  *max_val = std::min(max_, -range_ + (upper_bin + 1) * BinWidth());
+  if (*min_val > *max_val) {
+    *min_val = min_;
+    *max_val = max_;
+  }
+}
+
+float Histogram::FindMseThreshold(int num_bits) const {
+  const double num_steps = std::ldexp(1.0, num_bits) - 1;
+  const int half = num_bins() / 2;
+  const float abs_max = std::max(std::abs(min_), std::abs(max_));
+
+  // Only the populated bins contribute to the error.
+  std::vector<int> populated;
+  for (int i = 0; i < num_bins(); ++i) {
+    if (counts_[i] > 0) populated.push_back(i);
+  }
+
+  // Evaluating every bin edge is wasteful for wide histograms, 512 candidate
+  // thresholds are plenty.
+  const int stride = std::max(1, half / 512);
+  float best_threshold = abs_max;
+  double best_error = std::numeric_limits<double>::max();
+  for (int k = stride;; k += stride) {
+    const float threshold = std::min(k * BinWidth(), abs_max);
+    const float lo = std::max(min_, -threshold);
+    const float hi = std::min(max_, threshold);
+    if (hi > lo) {
+      const double step = (hi - lo) / num_steps;
+      const double rounding_error = step * step / 12;
+      double error = 0;
+      for (int bin : populated) {
+        const double center = BinCenter(bin);
+        const double count = counts_[bin];
+        if (center < lo) {
+          error += count * (lo - center) * (lo - center);
+        } else if (center > hi) {
+          error += count * (center - hi) * (center - hi);
+        } else {
+          error += count * rounding_error;
+        }
+      }
+      if (error < best_error) {
+        best_error = error;
+        best_threshold = threshold;
+      }
+    }
+    if (threshold >= abs_max || k >= half) break;
+  }
+  return best_threshold;
+}
+
+float Histogram::FindKlThreshold(int num_bits) const {
+  const int half = num_bins() / 2;
+  // Magnitudes are quantized to 2^(num_bits - 1) levels.
+  const int num_quantized_bins = 1 << (num_bits - 1);
+  const float abs_max = std::max(std::abs(min_), std::abs(max_));
+
+  // Fold the histogram onto |x|.
+  std::vector<double> abs_counts(half);
+  int last_populated = 0;
+  for (int j = 0; j < half; ++j) {
+    abs_counts[j] = counts_[half + j] + counts_[half - 1 - j];
+    if (abs_counts[j] > 0) last_populated = j;
+  }
+  if (last_populated + 1 <= num_quantized_bins) return abs_max;
+
+  std::vector<double> suffix_sum(half + 1, 0);
+  for (int j = half - 1; j >= 0; --j) {
+    suffix_sum[j] = suffix_sum[j + 1] + abs_counts[j];
+  }
+
+  constexpr double kEpsilon = 1e-4;
+  float best_threshold = abs_max;
+  double best_divergence = std::numeric_limits<double>::max();
+  std::vector<double> p, q;
+  for (int i = num_quantized_bins; i <= last_populated + 1; ++i) {
+    // Reference distribution: the first |i| bins with the clipped outliers
+    // accumulated into the last bin.
+    p.assign(abs_counts.begin(), abs_counts.begin() + i);
+    p[i - 1] += suffix_sum[i];
+
+    // Candidate distribution: the first |i| bins quantized into
+    // |num_quantized_bins| buckets and expanded back over the populated bins.
+    q.assign(i, 0);
+    for (int b = 0; b < num_quantized_bins; ++b) {
+      const int start = static_cast<int64_t>(b) * i / num_quantized_bins;
+      const int end = static_cast<int64_t>(b + 1) * i / num_quantized_bins;
+      double total = 0;
+      int populated = 0;
+      for (int j = start; j < end; ++j) {
+        total += abs_counts[j];
+        populated += abs_counts[j] > 0;
+      }
+      if (populated == 0) continue;
+      for (int j = start; j < end; ++j) {
+        if (abs_counts[j] > 0) q[j] = total / populated;
+      }
+    }
+
+    double p_sum = 0, q_sum = 0;
+    for (int j = 0; j < i; ++j) {
+      p_sum += p[j];
+      q_sum += q[j];
+    }
+    if (p_sum == 0 || q_sum == 0) continue;
+    double divergence = 0;
+    for (int j = 0; j < i; ++j) {
+      if (p[j] == 0) continue;
+      const double pj = p[j] / p_sum;
+      const double qj = std::max(q[j] / q_sum, kEpsilon / i);
+      divergence += pj * std::log(pj / qj);
+    }
+    if (divergence < best_divergence) {
+      best_divergence = divergence;
+      best_threshold = std::min(i * BinWidth(), abs_max);
+    }
+  }
+  return best_threshold;
+}
+
+TfLiteStatus Histogram::GetRange(const RangeEstimationOptions& options,
+                                 float* min_val, float* max_val) const {
+  if (!HasValues()) return kTfLiteError;
+  *min_val = min_;
+  *max_val = max_;
+  // All observed values are zero, there is nothing to clip.
+  if (range_ == 0) return kTfLiteOk;
+
+  float threshold = 0.0f;
+  switch (options.method) {
+    case RangeEstimationMethod::kMinMax:
+      return kTfLiteOk;
+    case RangeEstimationMethod::kPercentile:
+      GetPercentileRange(options.percentile, min_val, max_val);
+      return kTfLiteOk;
+    case RangeEstimationMethod::kMse:
+      if (options.num_bits < 2 || options.num_bits > 16) return kTfLiteError;
+      threshold = FindMseThreshold(options.num_bits);
+      break;
+    case RangeEstimationMethod::kKlDivergence:
+      if (options.num_bits < 2 || options.num_bits > 16) return kTfLiteError;
+      threshold = FindKlThreshold(options.num_bits);
+      break;
+    default:
+      return kTfLiteError;
+  }
+  *min_val = std::max(min_, -threshold);
+  *max_val = std::min(max_, threshold);
+  if (*min_val > *max_val) {
+    // The whole distribution lies outside of [-threshold, threshold].
+    *min_val = min_;
+    *max_val = max_;
+  }
+  return kTfLiteOk;
+}
+
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
@@ -0,0 +1,116 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_HISTOGRAM_H_
+#define TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_HISTOGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "tflite/core/c/common.h"
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+
+// How the quantization range of a tensor is derived from its statistics.
+enum class RangeEstimationMethod {
+  // Use the observed min and max values.
+  kMinMax,
+  // Clip the range at the |percentile| and 100 - |percentile| quantiles.
+  kPercentile,
+  // Pick the clipping threshold that minimizes the expected quantization mean
+  // squared error.
+  kMse,
+  // Pick the clipping threshold that minimizes the KL divergence between the
+  // observed and the quantized distribution.
+  kKlDivergence,
+};
+
+struct RangeEstimationOptions {
+  RangeEstimationMethod method = RangeEstimationMethod::kMinMax;
+  // Used by kPercentile, in (50, 100].
+  float percentile = 99.99f;
+  // Bit width of the target quantized type, used by kMse and kKlDivergence.
+  int num_bits = 8;
+};
+
+// A histogram of tensor values over a symmetric range [-R, R].
+//
+// R is always a power of two and only ever grows by doubling, so that
+// histograms built from different shards of a dataset share a common bin
+// lattice and can be merged exactly by adding counts, independently of the
+// order in which values were observed.
+class Histogram {
+ public:
+  static constexpr int kDefaultNumBins = 2048;
+
+  // |num_bins| must be a positive multiple of 4.
+  explicit Histogram(int num_bins = kDefaultNumBins);
+
+  TfLiteStatus Update(const float* values, size_t tensor_size);
+
+  // Adds the counts of |other| to this histogram. Both histograms must have
+  // the same number of bins.
+  TfLiteStatus Merge(const Histogram& other);
+
+  bool HasValues() const { return total_count_ > 0; }
+
+  // Derives a quantization range from the histogram. kMinMax returns the
+  // exact observed min and max.
+  TfLiteStatus GetRange(const RangeEstimationOptions& options, float* min_val,
+                        float* max_val) const;
+
+  int num_bins() const { return static_cast<int>(counts_.size()); }
+  // Half-width of the histogram range, 0 until a non-zero value was seen.
+  float range() const { return range_; }
+  const std::vector<int64_t>& counts() const { return counts_; }
+  int64_t total_count() const { return total_count_; }
+  float min() const { return min_; }
+  float max() const { return max_; }
+
+ private:
+  // Halving the bin count instead of doubling the range keeps the width
+  // finite for the largest range.
+  float BinWidth() const { return range_ / (counts_.size() / 2); }
+  float BinCenter(int bin) const {
+    return -range_ + (bin + 0.5f) * BinWidth();
+  }
+  int BinIndex(float value) const;
+  // Doubles |range_| until it covers |abs_max|, or reaches the largest finite
+  // power of two.
+  void GrowRange(float abs_max);
+
+  void GetPercentileRange(float percentile, float* min_val,
+                          float* max_val) const;
+  float FindMseThreshold(int num_bits) const;
+  float FindKlThreshold(int num_bits) const;
+
+  std::vector<int64_t> counts_;
+  float range_ = 0;
+  // Zeros observed before the range is known. They are folded into the
+  // center bin once the first non-zero value arrives.
+  int64_t pending_zeros_ = 0;
+  int64_t total_count_ = 0;
+  float min_ = std::numeric_limits<float>::max();
+  float max_ = std::numeric_limits<float>::lowest();
+};
+
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_HISTOGRAM_H_
@@ -0,0 +1,258 @@
+/* Copyright 2025 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tflite/tools/optimize/calibration/calibration_histogram.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "tflite/core/c/common.h"
+#include "tflite/tools/optimize/calibration/calibration_logger.h"
+
+namespace tflite {
+namespace optimize {
+namespace calibration {
+namespace {
+
+// A gaussian bulk with a handful of large outliers.
+std::vector<float> GaussianWithOutliers(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::normal_distribution<float> dist(0.0f, 1.0f);
+  std::vector<float> values(size);
+  for (auto& v : values) v = dist(rng);
+  values[0] = 100.0f;
+  values[1] = -80.0f;
+  return values;
+}
+
+TEST(HistogramTest, EmptyHistogramHasNoRange) {
+  Histogram histogram;
+  float min, max;
+  EXPECT_FALSE(histogram.HasValues());
+  EXPECT_EQ(histogram.GetRange({}, &min, &max), kTfLiteError);
+}
+
+TEST(HistogramTest, RangeIsPowerOfTwoAndCoversValues) {
+  Histogram histogram(/*num_bins=*/64);
+  const std::vector<float> values = {0.0f, 0.3f, -2.5f, 1.0f};
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+  EXPECT_EQ(histogram.range(), 4.0f);
+  EXPECT_EQ(histogram.total_count(), 4);
+  EXPECT_EQ(histogram.min(), -2.5f);
+  EXPECT_EQ(histogram.max(), 1.0f);
+
+  const std::vector<float> larger = {7.0f};
+  ASSERT_EQ(histogram.Update(larger.data(), larger.size()), kTfLiteOk);
+  EXPECT_EQ(histogram.range(), 8.0f);
+  int64_t total = 0;
+  for (int64_t count : histogram.counts()) total += count;
+  EXPECT_EQ(total, 5);
+}
+
+TEST(HistogramTest, ZerosBeforeFirstNonZeroValueAreKept) {
+  Histogram histogram(/*num_bins=*/16);
+  const std::vector<float> zeros(10, 0.0f);
+  ASSERT_EQ(histogram.Update(zeros.data(), zeros.size()), kTfLiteOk);
+  EXPECT_EQ(histogram.range(), 0.0f);
+  float min, max;
+  ASSERT_EQ(histogram.GetRange({}, &min, &max), kTfLiteOk);
+  EXPECT_EQ(min, 0.0f);
+  EXPECT_EQ(max, 0.0f);
+
+  const std::vector<float> one = {1.0f};
+  ASSERT_EQ(histogram.Update(one.data(), one.size()), kTfLiteOk);
+  EXPECT_EQ(histogram.counts()[8], 10);
+}
+
+TEST(HistogramTest, NonFiniteValuesAreSkipped) {
+  Histogram histogram;
+  const std::vector<float> values = {1.0f, std::nanf(""),
+                                     std::numeric_limits<float>::infinity()};
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+  EXPECT_EQ(histogram.total_count(), 1);
+  EXPECT_EQ(histogram.max(), 1.0f);
+}
+
+TEST(HistogramTest, RangeStaysFiniteNearFloatMax) {
+  constexpr float kFloatMax = std::numeric_limits<float>::max();
+  Histogram histogram(/*num_bins=*/16);
+  const std::vector<float> small = {1.0f, -3.0f};
+  ASSERT_EQ(histogram.Update(small.data(), small.size()), kTfLiteOk);
+  const std::vector<float> values = {kFloatMax, -kFloatMax, 0.0f,
+                                     std::numeric_limits<float>::infinity()};
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+  EXPECT_TRUE(std::isfinite(histogram.range()));
+  EXPECT_EQ(histogram.total_count(), 5);
+  EXPECT_EQ(histogram.counts().front(), 1);
+  EXPECT_EQ(histogram.counts().back(), 1);
+
+  // A histogram starting at FLT_MAX gets the same clamped range.
+  Histogram fresh(/*num_bins=*/16);
+  ASSERT_EQ(fresh.Update(values.data(), values.size()), kTfLiteOk);
+  EXPECT_EQ(fresh.range(), histogram.range());
+  float min, max;
+  ASSERT_EQ(fresh.GetRange({}, &min, &max), kTfLiteOk);
+  EXPECT_EQ(min, -kFloatMax);
+  EXPECT_EQ(max, kFloatMax);
+
+  ASSERT_EQ(histogram.Merge(fresh), kTfLiteOk);
+  EXPECT_EQ(histogram.range(), fresh.range());
+  int64_t total = 0;
+  for (int64_t count : histogram.counts()) total += count;
+  EXPECT_EQ(total, 8);
+}
+
+TEST(HistogramTest, MergeMatchesSingleHistogram) {
+  const std::vector<float> small = {0.1f, -0.2f, 0.0f, 0.05f};
+  const std::vector<float> large = GaussianWithOutliers(1000, 1);
+
+  Histogram all;
+  ASSERT_EQ(all.Update(small.data(), small.size()), kTfLiteOk);
+  ASSERT_EQ(all.Update(large.data(), large.size()), kTfLiteOk);
+
+  // Shards observe different ranges, merging in either order must give the
+  // same counts as a single histogram.
+  Histogram shard_a, shard_b;
+  ASSERT_EQ(shard_a.Update(small.data(), small.size()), kTfLiteOk);
+  ASSERT_EQ(shard_b.Update(large.data(), large.size()), kTfLiteOk);
+  Histogram merged_ab = shard_a;
+  ASSERT_EQ(merged_ab.Merge(shard_b), kTfLiteOk);
+  Histogram merged_ba = shard_b;
+  ASSERT_EQ(merged_ba.Merge(shard_a), kTfLiteOk);
+
+  EXPECT_EQ(merged_ab.range(), all.range());
+  EXPECT_EQ(merged_ab.counts(), all.counts());
+  EXPECT_EQ(merged_ba.counts(), all.counts());
+  EXPECT_EQ(merged_ab.total_count(), all.total_count());
+  EXPECT_EQ(merged_ab.min(), all.min());
+  EXPECT_EQ(merged_ab.max(), all.max());
+}
+
+TEST(HistogramTest, MergeRejectsDifferentBinCounts) {
+  Histogram a(/*num_bins=*/16), b(/*num_bins=*/32);
+  const std::vector<float> values = {1.0f};
+  ASSERT_EQ(b.Update(values.data(), values.size()), kTfLiteOk);
+  EXPECT_EQ(a.Merge(b), kTfLiteError);
+}
+
+TEST(HistogramTest, MinMaxMethodReturnsObservedRange) {
+  Histogram histogram;
+  const std::vector<float> values = GaussianWithOutliers(1000, 2);
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+  float min, max;
+  ASSERT_EQ(histogram.GetRange({}, &min, &max), kTfLiteOk);
+  EXPECT_EQ(min, -80.0f);
+  EXPECT_EQ(max, 100.0f);
+}
+
+TEST(HistogramTest, PercentileAndKlDivergenceIgnoreOutliers) {
+  Histogram histogram;
+  const std::vector<float> values = GaussianWithOutliers(100000, 3);
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+
+  for (auto method : {RangeEstimationMethod::kPercentile,
+                      RangeEstimationMethod::kKlDivergence}) {
+    RangeEstimationOptions options;
+    options.method = method;
+    options.percentile = 99.9f;
+    float min, max;
+    ASSERT_EQ(histogram.GetRange(options, &min, &max), kTfLiteOk);
+    EXPECT_LT(min, -1.0f);
+    EXPECT_GT(max, 1.0f);
+    EXPECT_GT(min, -20.0f);
+    EXPECT_LT(max, 20.0f);
+  }
+}
+
+TEST(HistogramTest, MseTradesClippingForResolution) {
+  Histogram histogram;
+  const std::vector<float> values = GaussianWithOutliers(100000, 4);
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+
+  RangeEstimationOptions options;
+  options.method = RangeEstimationMethod::kMse;
+  float min, max;
+  ASSERT_EQ(histogram.GetRange(options, &min, &max), kTfLiteOk);
+  // Clipping the two outliers entirely costs more than the coarser rounding
+  // step, but the full range is not optimal either.
+  EXPECT_LT(min, -20.0f);
+  EXPECT_GT(max, 20.0f);
+  EXPECT_LT(max, 100.0f);
+
+  // With 8x fewer levels the rounding error dominates and the range shrinks.
+  options.num_bits = 5;
+  float narrow_min, narrow_max;
+  ASSERT_EQ(histogram.GetRange(options, &narrow_min, &narrow_max), kTfLiteOk);
+  EXPECT_LT(narrow_max, max);
+  EXPECT_GT(narrow_min, min);
+}
+
+TEST(HistogramTest, ClippingStaysWithinObservedRange) {
+  Histogram histogram;
+  // Non-negative values, e.g. the output of a RELU.
+  std::vector<float> values(1000);
+  for (int i = 0; i < values.size(); ++i) values[i] = i / 100.0f;
+  ASSERT_EQ(histogram.Update(values.data(), values.size()), kTfLiteOk);
+
+  for (auto method :
+       {RangeEstimationMethod::kPercentile, RangeEstimationMethod::kMse,
+        RangeEstimationMethod::kKlDivergence}) {
+    RangeEstimationOptions options;
+    options.method = method;
+    float min, max;
+    ASSERT_EQ(histogram.GetRange(options, &min, &max), kTfLiteOk);
+    EXPECT_GE(min, 0.0f);
+    EXPECT_LE(max, 9.99f);
+    EXPECT_GT(max, 5.0f);
+  }
+}
+
+TEST(LoggerTest, MergeCombinesMinMaxAndHistograms) {
+  LoggerOptions options;
+  options.collect_histograms = true;
+  Logger a(options), b(options);
+  const std::vector<float> low = {-1.0f, 0.5f};
+  const std::vector<float> high = {2.0f, 3.0f};
+  ASSERT_EQ(a.LogTensorValue(0, 1, low.data(), low.size(), nullptr),
+            kTfLiteOk);
+  ASSERT_EQ(b.LogTensorValue(0, 1, high.data(), high.size(), nullptr),
+            kTfLiteOk);
+  ASSERT_EQ(b.LogTensorValue(0, 2, high.data(), high.size(), nullptr),
+            kTfLiteOk);
+
+  ASSERT_EQ(a.Merge(b), kTfLiteOk);
+  float min, max;
+  ASSERT_EQ(a.GetCalibrationValues().at({0, 1}).Get(&min, &max), kTfLiteOk);
+  EXPECT_EQ(min, -1.0f);
+  EXPECT_EQ(max, 3.0f);
+  EXPECT_EQ(a.GetHistograms().at({0, 1}).total_count(), 4);
+  EXPECT_EQ(a.GetHistograms().at({0, 2}).total_count(), 2);
+}
+
+TEST(LoggerTest, HistogramsAreOffByDefault) {
+  Logger logger;
+  const std::vector<float> values = {1.0f};
+  ASSERT_EQ(logger.LogTensorValue(0, 0, values.data(), values.size(), nullptr),
+            kTfLiteOk);
+  EXPECT_TRUE(logger.GetHistograms().empty());
+}
+
+}  // namespace
+}  // namespace calibration
+}  // namespace optimize
+}  // namespace tflite
@@ -52,6 +52,28 @@ TfLiteStatus MinMax::Update(const float* values, size_t tensor_size,
   return kTfLiteOk;
 }
 
+void MinMax::Merge(const MinMax& other) {
+  if (!other.has_values_) return;
+  has_values_ = true;
+  min_ = std::min<float>(min_, other.min_);
+  max_ = std::max<float>(max_, other.max_);
+}
+
+TfLiteStatus Logger::Merge(const Logger& other) {
+  for (const auto& entry : other.tensor_id_to_stats_map_) {
+    tensor_id_to_stats_map_[entry.first].Merge(entry.second);
+  }
+  for (const auto& entry : other.tensor_id_to_histogram_map_) {
+    auto it = tensor_id_to_histogram_map_.find(entry.first);
+    if (it == tensor_id_to_histogram_map_.end()) {
+      tensor_id_to_histogram_map_.emplace(entry.first, entry.second);
+      continue;
+    }
+    TF_LITE_ENSURE_STATUS(it->second.Merge(entry.second));
+  }
+  return kTfLiteOk;
+}
+
 }  // namespace calibration
 }  // namespace optimize
 }  // namespace tflite
@@ -15,11 +15,14 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_LOGGER_H_
 #define TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATION_LOGGER_H_
 
+#include <cstddef>
 #include <limits>
+#include <tuple>
 
 #include "absl/container/flat_hash_map.h"
 #include "tflite/core/api/error_reporter.h"
 #include "tflite/core/c/common.h"
+#include "tflite/tools/optimize/calibration/calibration_histogram.h"
 
 namespace tflite {
 namespace optimize {
@@ -30,6 +33,9 @@ class MinMax {
   TfLiteStatus Update(const float* values, size_t tensor_size,
                       ErrorReporter* error_reporter);
 
+  // Folds the values observed by |other| into this instance.
+  void Merge(const MinMax& other);
+
   bool HasValues() const { return has_values_; }
 
   TfLiteStatus Get(float* min_val, float* max_val) const {
@@ -45,26 +51,66 @@ class MinMax {
   float max_ = std::numeric_limits<float>::min();
 };
 
-// Captures min max values for tensors.
+struct LoggerOptions {
+  // Also record a histogram per tensor, required for range estimation methods
+  // other than min/max.
+  bool collect_histograms = false;
+  int num_histogram_bins = Histogram::kDefaultNumBins;
+};
+
+// Captures min max values, and optionally histograms, for tensors.
+//
+// A Logger is not thread safe. Calibration running several interpreters in
+// parallel gives each of them its own Logger and combines them with |Merge|
+// once all of them are done.
 class Logger {
  public:
+  Logger() = default;
+  explicit Logger(const LoggerOptions& options) : options_(options) {}
+
   // Log the value for tensor at |tensor_index| which has |tensor_values|
   TfLiteStatus LogTensorValue(int subgraph_index, int tensor_index,
                               const float* tensor_values, size_t tensor_size,
                               ErrorReporter* error_reporter) {
     std::tuple<int, int> key{subgraph_index, tensor_index};
-    return tensor_id_to_stats_map_[key].Update(tensor_values, tensor_size,
-                                               error_reporter);
+    TF_LITE_ENSURE_STATUS(tensor_id_to_stats_map_[key].Update(
+        tensor_values, tensor_size, error_reporter));
+    if (options_.collect_histograms) {
+      auto it = tensor_id_to_histogram_map_.find(key);
+      if (it == tensor_id_to_histogram_map_.end()) {
+        it = tensor_id_to_histogram_map_
+                 .emplace(key, Histogram(options_.num_histogram_bins))
+                 .first;
+      }
+      TF_LITE_ENSURE_STATUS(it->second.Update(tensor_values, tensor_size));
+    }
+    return kTfLiteOk;
   }
 
+  // Folds the statistics recorded by |other| into this logger. Both loggers
+  // must use the same number of histogram bins.
+  TfLiteStatus Merge(const Logger& other);
+
   // Returns a map from tensor_index -> observed min max values.
   const absl::flat_hash_map<std::tuple<int, int>, MinMax>&
   GetCalibrationValues() const {
     return tensor_id_to_stats_map_;
   }
 
+  // Returns a map from tensor_index -> observed histogram. Empty unless
+  // histograms are collected.
+  const absl::flat_hash_map<std::tuple<int, int>, Histogram>& GetHistograms()
+      const {
+    return tensor_id_to_histogram_map_;
+  }
+
+  const LoggerOptions& options() const { return options_; }
+
  private:
+  LoggerOptions options_;
   absl::flat_hash_map<std::tuple<int, int>, MinMax> tensor_id_to_stats_map_;
+  absl::flat_hash_map<std::tuple<int, int>, Histogram>
+      tensor_id_to_histogram_map_;
 };
 
 }  // namespace calibration
@@ -27,14 +27,30 @@ namespace tflite {
 namespace optimize {
 namespace calibration {
 
+TfLiteStatus CalibrationReader::GetRange(const std::tuple<int, int>& key,
+                                         const MinMax& minmax, float* min,
+                                         float* max) const {
+  TF_LITE_ENSURE_STATUS(minmax.Get(min, max));
+  if (range_options_.method == RangeEstimationMethod::kMinMax) {
+    return kTfLiteOk;
+  }
+  const auto& histograms = logger_->GetHistograms();
+  auto it = histograms.find(key);
+  if (it == histograms.end()) return kTfLiteError;
+  // The histogram skips non-finite values, keep the min/max range if it has
+  // seen nothing else.
+  if (!it->second.HasValues()) return kTfLiteOk;
+  return it->second.GetRange(range_options_, min, max);
+}
+
 TfLiteStatus CalibrationReader::GetTensorStatsAsMap(
     absl::flat_hash_map<std::tuple<int, int>, CalibrationStats>*
         tensor_id_to_stats_map) const {
   tensor_id_to_stats_map->clear();
   for (const auto& tensorid_stat : logger_->GetCalibrationValues()) {
-    auto minmax = tensorid_stat.second;
     CalibrationReader::CalibrationStats stats;
-    TF_LITE_ENSURE_STATUS(minmax.Get(&stats.min, &stats.max));
+    TF_LITE_ENSURE_STATUS(GetRange(tensorid_stat.first, tensorid_stat.second,
+                                   &stats.min, &stats.max));
     tensor_id_to_stats_map->insert({tensorid_stat.first, stats});
   }
 
@@ -50,9 +66,9 @@ TfLiteStatus CalibrationReader::AddCalibrationToModel(ModelT* model,
     int subgraph_index, tensor_index;
     std::tie(subgraph_index, tensor_index) = tensorid_stat.first;
     const auto& subgraph = model->subgraphs[subgraph_index];
-    auto minmax = tensorid_stat.second;
     float min, max;
-    TfLiteStatus status = minmax.Get(&min, &max);
+    TfLiteStatus status =
+        GetRange(tensorid_stat.first, tensorid_stat.second, &min, &max);
     if (status != kTfLiteOk) continue;
     if (update) {
       auto tensor = subgraph->tensors[tensor_index].get();
@@ -21,6 +21,7 @@ limitations under the License.
 #include "tflite/core/c/c_api_types.h"
 #include "tflite/core/model.h"
 #include "tflite/schema/schema_generated.h"
+#include "tflite/tools/optimize/calibration/calibration_histogram.h"
 #include "tflite/tools/optimize/calibration/calibration_logger.h"
 
 namespace tflite {
@@ -39,6 +40,12 @@ class CalibrationReader {
   };
   explicit CalibrationReader(const Logger* logger) : logger_(logger) {}
 
+  // Reports ranges derived with |range_options|. Methods other than kMinMax
+  // require |logger| to collect histograms.
+  CalibrationReader(const Logger* logger,
+                    const RangeEstimationOptions& range_options)
+      : logger_(logger), range_options_(range_options) {}
+
   // Gets a map from tensor index to recorded calibration values.
   virtual TfLiteStatus GetTensorStatsAsMap(
       absl::flat_hash_map<std::tuple<int, int>, CalibrationStats>*
@@ -52,8 +59,20 @@ class CalibrationReader {
 
   virtual ~CalibrationReader() {}
 
+  const Logger* GetLogger() const { return logger_; }
+
+  const RangeEstimationOptions& GetRangeEstimationOptions() const {
+    return range_options_;
+  }
+
  private:
+  // Computes the range of the tensor identified by |key|, which was observed
+  // to span |minmax|.
+  TfLiteStatus GetRange(const std::tuple<int, int>& key, const MinMax& minmax,
+                        float* min, float* max) const;
+
   const Logger* logger_;
+  RangeEstimationOptions range_options_;
 };
 
 }  // namespace calibration
@@ -14,9 +14,12 @@ limitations under the License.
 ==============================================================================*/
 #include "tflite/tools/optimize/calibration/calibrator.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
@@ -24,6 +27,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
 #include "flatbuffers/buffer.h"  // from @flatbuffers
 #include "flatbuffers/vector.h"  // from @flatbuffers
 #include "tflite/converter/allocation.h"
@@ -66,11 +70,11 @@ class Calibrator {
   Calibrator(const std::unordered_map<const TfLiteNode*, OperatorInfo>&
                  node_ptr_opinfo_map,
              std::unique_ptr<LoggingOpResolver> logging_op_resolver,
-             ErrorReporter* error_reporter)
+             const LoggerOptions& logger_options, ErrorReporter* error_reporter)
       : node_ptr_opinfo_map_(node_ptr_opinfo_map),
         logging_op_resolver_(std::move(logging_op_resolver)),
         error_reporter_(error_reporter) {
-    logger_ = std::make_unique<Logger>();
+    logger_ = std::make_unique<Logger>(logger_options);
   }
 
   // Returns the wrapped kernel invoke function |TfLiteRegistration.invoke|.
@@ -139,20 +143,27 @@ KernelEvalFuncPtr Calibrator::GetKernelInvoke(const TfLiteNode* node) const {
 //
 // This way the kernel invoke functions can get the access to the Calibrator
 // object associated with the |TfLiteContext|.
+//
+// Several logging interpreters may be invoked concurrently (see
+// |CalibrateInParallel|), so the registry is guarded by a reader/writer lock.
+// Kernel invocations only take the shared lock.
 class GlobalCalibratorRegistry {
  public:
   // Get the |Calibrator| associated with given context, returns null if no
   // calibrator is associated with the given context.
   Calibrator* GetCalibrator(const TfLiteNode* node) const {
-    if (node_to_calibrator_.find(node) == node_to_calibrator_.cend()) {
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = node_to_calibrator_.find(node);
+    if (it == node_to_calibrator_.cend()) {
       return nullptr;
     }
-    return node_to_calibrator_.at(node);
+    return it->second;
   }
 
   // Removes the association between calibrator and context.
   // Note: This deletes the calibrator as well.
   void RemoveCalibrator(const TfLiteContext* context) {
+    absl::MutexLock lock(&mutex_);
     Calibrator* calibrator = calibrator_registry_.at(context).get();
     auto nodes = calibrator->GetNodesUnderCalibration();
     for (auto node : nodes) {
@@ -168,14 +179,17 @@ class GlobalCalibratorRegistry {
       const TfLiteContext* context,
       const std::unordered_map<const TfLiteNode*, OperatorInfo>& node_to_opinfo,
       std::unique_ptr<LoggingOpResolver> logging_op_resolver,
-      Calibrator** calibrator_ptr, ErrorReporter* reporter) {
+      const LoggerOptions& logger_options, Calibrator** calibrator_ptr,
+      ErrorReporter* reporter) {
+    absl::MutexLock lock(&mutex_);
     if (calibrator_registry_.find(context) != calibrator_registry_.cend()) {
       reporter->Report(
           "Failed to create calibrator, context already registered.");
       return kTfLiteError;
     }
     auto calibrator = std::make_unique<Calibrator>(
-        node_to_opinfo, std::move(logging_op_resolver), reporter);
+        node_to_opinfo, std::move(logging_op_resolver), logger_options,
+        reporter);
     calibrator_registry_[context] = std::move(calibrator);
     *calibrator_ptr = calibrator_registry_.at(context).get();
     for (const auto& entry : node_to_opinfo) {
@@ -185,9 +199,11 @@ class GlobalCalibratorRegistry {
   }
 
  private:
+  mutable absl::Mutex mutex_;
   absl::flat_hash_map<const TfLiteContext*, std::unique_ptr<Calibrator>>
-      calibrator_registry_;
-  absl::flat_hash_map<const TfLiteNode*, Calibrator*> node_to_calibrator_;
+      calibrator_registry_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<const TfLiteNode*, Calibrator*> node_to_calibrator_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 GlobalCalibratorRegistry* GetCalibratorRegistry() {
@@ -347,6 +363,19 @@ class Reader : public CalibrationReader {
   const TfLiteContext* context_;
 };
 
+// A |CalibrationReader| that owns a logger holding statistics merged from
+// several logging interpreters.
+class MergedReader : public CalibrationReader {
+ public:
+  MergedReader(std::unique_ptr<Logger> logger,
+               const RangeEstimationOptions& range_options)
+      : CalibrationReader(logger.get(), range_options),
+        logger_(std::move(logger)) {}
+
+ private:
+  std::unique_ptr<Logger> logger_;
+};
+
 bool HasInputs(BuiltinOperator code) {
   switch (code) {
     case BuiltinOperator_CALL_ONCE:
@@ -387,6 +416,17 @@ TfLiteStatus BuildLoggingInterpreter(
     const OpResolver& op_resolver, std::unique_ptr<Interpreter>* interpreter,
     std::unique_ptr<CalibrationReader>* calibration_reader,
     const Allocation* allocation) {
+  return BuildLoggingInterpreter(tflite_model, error_reporter, op_resolver,
+                                 LoggerOptions(), interpreter,
+                                 calibration_reader, allocation);
+}
+
+TfLiteStatus BuildLoggingInterpreter(
+    const tflite::Model* tflite_model, ErrorReporter* error_reporter,
+    const OpResolver& op_resolver, const LoggerOptions& logger_options,
+    std::unique_ptr<Interpreter>* interpreter,
+    std::unique_ptr<CalibrationReader>* calibration_reader,
+    const Allocation* allocation) {
   if (error_reporter == nullptr) {
     // Make sure error_reporter is valid.
     error_reporter = DefaultErrorReporter();
@@ -484,14 +524,90 @@ TfLiteStatus BuildLoggingInterpreter(
   // Register a calibrator object for the context. This can be accessed
   // during invocations by the logging kernels.
   TF_LITE_ENSURE_STATUS(GetCalibratorRegistry()->CreateCalibrator(
-      context, node_ptr_opinfo_map, std::move(logging_op_resolver), &calibrator,
-      error_reporter));
+      context, node_ptr_opinfo_map, std::move(logging_op_resolver),
+      logger_options, &calibrator, error_reporter));
   *calibration_reader = std::unique_ptr<CalibrationReader>(
       new Reader(context, calibrator->GetLogger()));
 
   return kTfLiteOk;
 }
 
+TfLiteStatus CalibrateInParallel(
+    const FlatBufferModel& model, const OpResolver& op_resolver,
+    int num_samples, const CalibrationSampleFn& fill_inputs,
+    const ParallelCalibrationOptions& options,
+    std::unique_ptr<CalibrationReader>* calibration_reader) {
+  ErrorReporter* error_reporter = model.error_reporter();
+  if (error_reporter == nullptr) error_reporter = DefaultErrorReporter();
+  if (options.num_workers < 1 || num_samples < 0) {
+    error_reporter->Report("Invalid number of calibration workers or samples.");
+    return kTfLiteError;
+  }
+  if (options.range_options.method != RangeEstimationMethod::kMinMax &&
+      !options.logger_options.collect_histograms) {
+    error_reporter->Report(
+        "Range estimation from histograms requires collect_histograms.");
+    return kTfLiteError;
+  }
+  const int num_workers = std::max(1, std::min(options.num_workers,
+                                               num_samples));
+
+  // Interpreters are built and allocated up front on the calling thread,
+  // the workers only fill inputs and invoke.
+  std::vector<std::unique_ptr<Interpreter>> interpreters(num_workers);
+  std::vector<std::unique_ptr<CalibrationReader>> readers(num_workers);
+  for (int i = 0; i < num_workers; ++i) {
+    TF_LITE_ENSURE_STATUS(BuildLoggingInterpreter(
+        model.GetModel(), error_reporter, op_resolver, options.logger_options,
+        &interpreters[i], &readers[i], model.allocation()));
+    if (interpreters[i]->SetNumThreads(options.num_threads_per_interpreter) !=
+            kTfLiteOk ||
+        interpreters[i]->AllocateTensors() != kTfLiteOk) {
+      error_reporter->Report("Failed to prepare calibration interpreter %d.",
+                             i);
+      return kTfLiteError;
+    }
+  }
+
+  std::vector<TfLiteStatus> statuses(num_workers, kTfLiteOk);
+  auto run_shard = [&](int worker) {
+    const int begin =
+        static_cast<int64_t>(num_samples) * worker / num_workers;
+    const int end =
+        static_cast<int64_t>(num_samples) * (worker + 1) / num_workers;
+    Interpreter* interpreter = interpreters[worker].get();
+    for (int sample = begin; sample < end; ++sample) {
+      if (fill_inputs(sample, interpreter) != kTfLiteOk ||
+          interpreter->Invoke() != kTfLiteOk) {
+        statuses[worker] = kTfLiteError;
+        return;
+      }
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers - 1);
+  for (int i = 1; i < num_workers; ++i) {
+    workers.emplace_back(run_shard, i);
+  }
+  run_shard(0);
+  for (auto& worker : workers) worker.join();
+
+  for (int i = 0; i < num_workers; ++i) {
+    if (statuses[i] != kTfLiteOk) {
+      error_reporter->Report("Calibration worker %d failed.", i);
+      return kTfLiteError;
+    }
+  }
+
+  auto merged_logger = std::make_unique<Logger>(options.logger_options);
+  for (const auto& reader : readers) {
+    TF_LITE_ENSURE_STATUS(merged_logger->Merge(*reader->GetLogger()));
+  }
+  *calibration_reader = std::make_unique<MergedReader>(
+      std::move(merged_logger), options.range_options);
+  return kTfLiteOk;
+}
+
 }  // namespace calibration
 }  // namespace optimize
 }  // namespace tflite
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATOR_H_
 #define TENSORFLOW_LITE_TOOLS_OPTIMIZE_CALIBRATION_CALIBRATOR_H_
 
+#include <functional>
 #include <memory>
 
 #include "tflite/converter/allocation.h"
@@ -25,6 +26,8 @@ limitations under the License.
 #include "tflite/core/model.h"
 #include "tflite/model_builder.h"
 #include "tflite/schema/schema_generated.h"
+#include "tflite/tools/optimize/calibration/calibration_histogram.h"
+#include "tflite/tools/optimize/calibration/calibration_logger.h"
 #include "tflite/tools/optimize/calibration/calibration_reader.h"
 
 namespace tflite {
@@ -70,6 +73,56 @@ TfLiteStatus BuildLoggingInterpreter(
     std::unique_ptr<CalibrationReader>* calibration_reader,
     const Allocation* allocation = nullptr);
 
+// Same as above, with the statistics collected by the logger configured by
+// |logger_options|.
+TfLiteStatus BuildLoggingInterpreter(
+    const tflite::Model* model, ErrorReporter* error_reporter,
+    const OpResolver& op_resolver, const LoggerOptions& logger_options,
+    std::unique_ptr<Interpreter>* interpreter,
+    std::unique_ptr<CalibrationReader>* calibration_reader,
+    const Allocation* allocation = nullptr);
+
+// Fills the inputs of |interpreter| with calibration sample |sample_index|.
+// Called concurrently from several threads, each with its own interpreter.
+using CalibrationSampleFn =
+    std::function<TfLiteStatus(int sample_index, Interpreter* interpreter)>;
+
+struct ParallelCalibrationOptions {
+  // Number of logging interpreters, each invoked on its own thread.
+  int num_workers = 1;
+  // Number of threads each interpreter may use for its kernels.
+  int num_threads_per_interpreter = 1;
+  // Statistics collected per tensor.
+  LoggerOptions logger_options;
+  // How ranges are derived from the statistics by the returned reader.
+  RangeEstimationOptions range_options;
+};
+
+// Calibrates |model| on |num_samples| samples using
+// |options.num_workers| logging interpreters that share the model. Each
+// interpreter consumes a contiguous shard of the samples and logs into its own
+// |Logger|, so workers never synchronize while invoking. The per-worker
+// statistics are merged once all shards are done.
+//
+// The returned |calibration_reader| owns the merged statistics and can be
+// used like the one returned by |BuildLoggingInterpreter|, e.g. to annotate a
+// model with |AddCalibrationToModel| before quantizing it.
+//
+// Sample usage:
+// ParallelCalibrationOptions options;
+// options.num_workers = 8;
+// options.logger_options.collect_histograms = true;
+// options.range_options.method = RangeEstimationMethod::kKlDivergence;
+// CalibrateInParallel(model, resolver, dataset.size(),
+//     [&](int i, Interpreter* interpreter) {
+//       return dataset.CopyTo(i, interpreter->typed_input_tensor<float>(0));
+//     }, options, &calibration_reader);
+TfLiteStatus CalibrateInParallel(
+    const FlatBufferModel& model, const OpResolver& op_resolver,
+    int num_samples, const CalibrationSampleFn& fill_inputs,
+    const ParallelCalibrationOptions& options,
+    std::unique_ptr<CalibrationReader>* calibration_reader);
+
 }  // namespace calibration
 }  // namespace optimize
 }  // namespace tflite
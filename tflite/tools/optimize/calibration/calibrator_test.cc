@@ -710,6 +710,105 @@ TEST(CalibratorTest, CalibrationWithCallOnce) {
     EXPECT_NEAR(e.second.max, expected_result.max, eps);
   }
 }
+
+TfLiteStatus FillMultiAddInputs(int sample_index, Interpreter* interpreter) {
+  // Input i of sample s is filled with (s + 1) * (i + 1).
+  for (size_t i = 0; i < interpreter->inputs().size(); i++) {
+    TfLiteTensor* tensor = interpreter->tensor(interpreter->inputs()[i]);
+    for (size_t j = 0; j < tensor->bytes / sizeof(float); j++) {
+      tensor->data.f[j] = (sample_index + 1) * (i + 1);
+    }
+  }
+  return kTfLiteOk;
+}
+
+TEST(CalibratorTest, ParallelCalibrationMatchesSerial) {
+  auto model = ReadModel("multi_add.bin");
+  ASSERT_TRUE(model);
+  constexpr int kNumSamples = 8;
+
+  std::unique_ptr<Interpreter> interpreter;
+  std::unique_ptr<CalibrationReader> serial_reader;
+  ASSERT_EQ(kTfLiteOk,
+            BuildLoggingInterpreter(*model, ops::builtin::BuiltinOpResolver{},
+                                    &interpreter, &serial_reader));
+  ASSERT_EQ(kTfLiteOk, interpreter->AllocateTensors());
+  for (int i = 0; i < kNumSamples; i++) {
+    ASSERT_EQ(kTfLiteOk, FillMultiAddInputs(i, interpreter.get()));
+    ASSERT_EQ(kTfLiteOk, interpreter->Invoke());
+  }
+  absl::flat_hash_map<std::tuple<int, int>, CalibrationReader::CalibrationStats>
+      serial_stats;
+  ASSERT_EQ(kTfLiteOk, serial_reader->GetTensorStatsAsMap(&serial_stats));
+
+  ParallelCalibrationOptions options;
+  options.num_workers = 3;
+  std::unique_ptr<CalibrationReader> parallel_reader;
+  ASSERT_EQ(kTfLiteOk,
+            CalibrateInParallel(*model, ops::builtin::BuiltinOpResolver{},
+                                kNumSamples, FillMultiAddInputs, options,
+                                &parallel_reader));
+  absl::flat_hash_map<std::tuple<int, int>, CalibrationReader::CalibrationStats>
+      parallel_stats;
+  ASSERT_EQ(kTfLiteOk, parallel_reader->GetTensorStatsAsMap(&parallel_stats));
+
+  const float eps = 1e-6f;
+  EXPECT_EQ(7, parallel_stats.size());
+  EXPECT_EQ(serial_stats.size(), parallel_stats.size());
+  for (const auto& e : serial_stats) {
+    ASSERT_TRUE(parallel_stats.contains(e.first));
+    EXPECT_NEAR(parallel_stats[e.first].min, e.second.min, eps);
+    EXPECT_NEAR(parallel_stats[e.first].max, e.second.max, eps);
+  }
+  // Output tensor 6 is 9 times the sample value.
+  EXPECT_NEAR(parallel_stats[{0, 6}].min, 9, eps);
+  EXPECT_NEAR(parallel_stats[{0, 6}].max, 9 * kNumSamples, eps);
+}
+
+TEST(CalibratorTest, ParallelCalibrationWithHistograms) {
+  auto model = ReadModel("multi_add.bin");
+  ASSERT_TRUE(model);
+  constexpr int kNumSamples = 100;
+
+  ParallelCalibrationOptions options;
+  options.num_workers = 4;
+  options.logger_options.collect_histograms = true;
+  options.range_options.method = RangeEstimationMethod::kPercentile;
+  options.range_options.percentile = 95.0f;
+  std::unique_ptr<CalibrationReader> reader;
+  ASSERT_EQ(kTfLiteOk, CalibrateInParallel(
+                           *model, ops::builtin::BuiltinOpResolver{},
+                           kNumSamples, FillMultiAddInputs, options, &reader));
+  absl::flat_hash_map<std::tuple<int, int>, CalibrationReader::CalibrationStats>
+      stats;
+  ASSERT_EQ(kTfLiteOk, reader->GetTensorStatsAsMap(&stats));
+  EXPECT_EQ(7, stats.size());
+  // The top 5% of the samples of input 0 are clipped.
+  EXPECT_GE(stats[{0, 0}].min, 1);
+  EXPECT_LT(stats[{0, 0}].max, kNumSamples);
+  EXPECT_GT(stats[{0, 0}].max, 0.9f * kNumSamples);
+
+  // The histogram derived ranges are written to the model.
+  ModelT model_t;
+  model->GetModel()->UnPackTo(&model_t);
+  ASSERT_EQ(kTfLiteOk, reader->AddCalibrationToModel(&model_t, false));
+  const auto& quantization = model_t.subgraphs[0]->tensors[0]->quantization;
+  ASSERT_TRUE(quantization);
+  EXPECT_NEAR(quantization->max[0], stats[{0, 0}].max, 1e-6f);
+}
+
+TEST(CalibratorTest, ParallelCalibrationRequiresHistogramsForClipping) {
+  auto model = ReadModel("multi_add.bin");
+  ASSERT_TRUE(model);
+  ParallelCalibrationOptions options;
+  options.range_options.method = RangeEstimationMethod::kMse;
+  std::unique_ptr<CalibrationReader> reader;
+  EXPECT_EQ(kTfLiteError,
+            CalibrateInParallel(*model, ops::builtin::BuiltinOpResolver{},
+                                /*num_samples=*/1, FillMultiAddInputs, options,
+                                &reader));
+}
+
 }  // namespace
 }  // namespace calibration
 }  // namespace optimize
@@ -0,0 +1,239 @@
+// Copyright 2026 Google LLC.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the time to first inference of a synthetic model with many external
+// weights in one group file, with each prefetch mode of the weight loader. The
+// group file is evicted from the page cache before every measurement, and the
+// "inference" reads the weights of the ops in order, spinning for a while per
+// op to stand in for the kernels.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"  // from @com_google_absl
+#include "absl/flags/parse.h"  // from @com_google_absl
+#include "absl/log/absl_log.h"  // from @com_google_absl
+#include "absl/status/status.h"  // from @com_google_absl
+#include "absl/strings/str_cat.h"  // from @com_google_absl
+#include "absl/strings/string_view.h"  // from @com_google_absl
+#include "absl/time/clock.h"  // from @com_google_absl
+#include "absl/time/time.h"  // from @com_google_absl
+#include "flatbuffers/flatbuffer_builder.h"  // from @flatbuffers
+#include "litert/c/litert_tensor_buffer.h"
+#include "litert/c/litert_tensor_buffer_types.h"
+#include "tflite/schema/schema_generated.h"
+#include "weight_loader/external_weight_loader_litert.h"
+
+ABSL_FLAG(std::string, dir, "/tmp", "Directory of the group file.");
+ABSL_FLAG(int, num_weights, 512, "Number of external weights.");
+ABSL_FLAG(int, weight_kb, 512, "Size of every external weight, in KiB.");
+ABSL_FLAG(int, op_us, 200, "Time spent by every op besides reading weights.");
+ABSL_FLAG(int, num_prefetch_threads, 2,
+          "Number of threads of the background read prefetch.");
+
+namespace weight_loader {
+namespace {
+
+constexpr absl::string_view kGroupName = "weights.bin";
+
+// A model whose i-th op reads the i-th weight, with the weights of odd ops
+// stored before the ones of even ops in the group file.
+std::vector<uint8_t> BuildModel(int num_weights, uint64_t weight_size) {
+  flatbuffers::FlatBufferBuilder builder;
+  const std::vector<int32_t> shape = {static_cast<int32_t>(weight_size)};
+  std::vector<flatbuffers::Offset<tflite::Tensor>> tensors;
+  std::vector<flatbuffers::Offset<tflite::Operator>> ops;
+  std::vector<flatbuffers::Offset<tflite::ExternalBuffer>> external_buffers;
+  for (int i = 0; i < num_weights; ++i) {
+    const uint32_t external_buffer_id = i + 1;
+    tensors.push_back(tflite::CreateTensor(
+        builder, builder.CreateVector(shape), tflite::TensorType_UINT8,
+        /*buffer=*/0, builder.CreateString(absl::StrCat("w", i)),
+        /*quantization=*/0, /*is_variable=*/false, /*sparsity=*/0,
+        /*shape_signature=*/0, /*has_rank=*/false, /*variant_tensors=*/0,
+        external_buffer_id));
+    const std::vector<int32_t> inputs = {i};
+    ops.push_back(tflite::CreateOperator(builder, /*opcode_index=*/0,
+                                         builder.CreateVector(inputs)));
+    const uint64_t slot = i % 2 == 1 ? i / 2 : (num_weights + i) / 2;
+    external_buffers.push_back(tflite::CreateExternalBuffer(
+        builder, external_buffer_id, /*group=*/1, slot * weight_size,
+        weight_size, builder.CreateString("")));
+  }
+  const std::vector<int32_t> no_tensors;
+  auto subgraph = tflite::CreateSubGraph(
+      builder, builder.CreateVector(tensors), builder.CreateVector(no_tensors),
+      builder.CreateVector(no_tensors), builder.CreateVector(ops),
+      builder.CreateString("main"));
+  // Group 0 is reserved.
+  const std::vector<flatbuffers::Offset<tflite::ExternalBufferGroup>> groups =
+      {tflite::CreateExternalBufferGroupDirect(builder, ""),
+       tflite::CreateExternalBufferGroupDirect(
+           builder, std::string(kGroupName).c_str())};
+  const std::vector<flatbuffers::Offset<tflite::OperatorCode>> op_codes = {
+      tflite::CreateOperatorCode(builder, /*deprecated_builtin_code=*/0,
+                                 /*custom_code=*/0, /*version=*/1,
+                                 tflite::BuiltinOperator_CUSTOM)};
+  const std::vector<flatbuffers::Offset<tflite::Buffer>> buffers = {
+      tflite::CreateBuffer(builder)};
+  auto model = tflite::CreateModel(
+      builder, /*version=*/3, builder.CreateVector(op_codes),
+      builder.CreateVector(
+          std::vector<flatbuffers::Offset<tflite::SubGraph>>{subgraph}),
+      builder.CreateString("external_weights"), builder.CreateVector(buffers),
+      /*metadata_buffer=*/0, /*metadata=*/0, /*signature_defs=*/0,
+      builder.CreateVector(groups), builder.CreateVector(external_buffers));
+  tflite::FinishModelBuffer(builder, model);
+  return std::vector<uint8_t>(builder.GetBufferPointer(),
+                              builder.GetBufferPointer() + builder.GetSize());
+}
+
+absl::Status WriteGroupFile(const std::string& path, uint64_t size) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  const std::vector<char> chunk(1 << 20, 1);
+  for (uint64_t written = 0; written < size; written += chunk.size()) {
+    file.write(chunk.data(), std::min<uint64_t>(chunk.size(), size - written));
+  }
+  file.close();
+  if (!file) {
+    return absl::InternalError(absl::StrCat("Failed to write ", path));
+  }
+  return absl::OkStatus();
+}
+
+// Drops the clean pages of `path` from the page cache.
+absl::Status EvictFromPageCache(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, absl::StrCat("Failed to open ", path));
+  }
+  fdatasync(fd);
+  const int error = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  close(fd);
+  if (error != 0) {
+    return absl::ErrnoToStatus(error, "posix_fadvise failed");
+  }
+  return absl::OkStatus();
+}
+
+// Reads the weights of the ops in order and spins for `op_time` per op.
+absl::Status RunOps(const WeightLoader& loader, int num_weights,
+                    absl::Duration op_time) {
+  uint64_t sum = 0;
+  for (int i = 0; i < num_weights; ++i) {
+    const WeightAccess* access = loader.GetExternalWeightByBuffer(i + 1);
+    void* data;
+    size_t size;
+    if (access == nullptr ||
+        LiteRtGetTensorBufferPackedSize(access->GetHostBuffer(), &size) !=
+            kLiteRtStatusOk ||
+        LiteRtLockTensorBuffer(access->GetHostBuffer(), &data,
+                               kLiteRtTensorBufferLockModeRead) !=
+            kLiteRtStatusOk) {
+      return absl::InternalError(absl::StrCat("Failed to access weight ", i));
+    }
+    for (size_t j = 0; j < size; ++j) {
+      sum += static_cast<const uint8_t*>(data)[j];
+    }
+    LiteRtUnlockTensorBuffer(access->GetHostBuffer());
+    const absl::Time deadline = absl::Now() + op_time;
+    while (absl::Now() < deadline) {
+    }
+  }
+  if (sum == 0) {
+    return absl::InternalError("Unexpected weight contents");
+  }
+  return absl::OkStatus();
+}
+
+absl::Status Measure(absl::string_view name, WeightPrefetch prefetch,
+                     const std::vector<uint8_t>& model,
+                     const std::string& group_path, int num_weights) {
+  if (auto status = EvictFromPageCache(group_path); !status.ok()) {
+    return status;
+  }
+  const absl::Time start = absl::Now();
+  auto loader = CreateLiteRtWeightLoader(tflite::GetModel(model.data()),
+                                         absl::GetFlag(FLAGS_dir),
+                                         /*scoped_weight_source=*/nullptr);
+  WeightAccessRequest request;
+  request.prefetch = prefetch;
+  request.num_prefetch_threads = absl::GetFlag(FLAGS_num_prefetch_threads);
+  if (auto status = loader->PrepareAccess(request, /*env=*/nullptr);
+      !status.ok()) {
+    return status;
+  }
+  const absl::Duration prepare = absl::Now() - start;
+  if (auto status = RunOps(*loader, num_weights,
+                           absl::Microseconds(absl::GetFlag(FLAGS_op_us)));
+      !status.ok()) {
+    return status;
+  }
+  ABSL_LOG(INFO) << name << ": prepare " << prepare
+                 << ", time to first inference " << absl::Now() - start;
+  return absl::OkStatus();
+}
+
+absl::Status Run() {
+  const int num_weights = absl::GetFlag(FLAGS_num_weights);
+  const uint64_t weight_size =
+      static_cast<uint64_t>(absl::GetFlag(FLAGS_weight_kb)) * 1024;
+  const std::string group_path =
+      absl::StrCat(absl::GetFlag(FLAGS_dir), "/", kGroupName);
+  if (auto status = WriteGroupFile(group_path, num_weights * weight_size);
+      !status.ok()) {
+    return status;
+  }
+  const std::vector<uint8_t> model = BuildModel(num_weights, weight_size);
+  ABSL_LOG(INFO) << num_weights << " weights, "
+                 << num_weights * weight_size / (1 << 20) << " MiB";
+
+  const std::pair<absl::string_view, WeightPrefetch> modes[] = {
+      {"none", WeightPrefetch::kNone},
+      {"willneed", WeightPrefetch::kWillNeed},
+      {"populate", WeightPrefetch::kPopulate},
+      {"background_read", WeightPrefetch::kBackgroundRead},
+  };
+  for (const auto& [name, prefetch] : modes) {
+    if (auto status =
+            Measure(name, prefetch, model, group_path, num_weights);
+        !status.ok()) {
+      return status;
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace weight_loader
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  if (auto status = weight_loader::Run(); !status.ok()) {
+    ABSL_LOG(ERROR) << status;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -25,15 +25,20 @@
 #include <unistd.h>
 #endif  // !defined(_WIN32)
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <ios>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -91,6 +96,9 @@ struct LiteRtWeightInfo : public WeightInfo {
   uint64_t offset;
   // The length of the tensor data in the external file, in bytes.
   uint64_t length;
+  // The index of the first op of the subgraph that reads the tensor, or the
+  // number of ops if no op does.
+  uint32_t first_use;
   // TODO(b/453768409): Refactor external weight loader to only use cc API.
   // The type of the tensor.
   LiteRtRankedTensorType tensor_type;
@@ -166,8 +174,42 @@ std::string JoinPath(absl::string_view base, absl::string_view relative) {
   return result;
 }
 
+#if !defined(_WIN32)
+// A read-only mapping of a range of a file. The mapping of a whole group file
+// or scoped section is shared by the CPU mappings of the slices it contains.
+struct FileMapping {
+  FileMapping(void* base, size_t length, size_t page_offset, uint64_t offset,
+              uint64_t size)
+      : base(base),
+        length(length),
+        page_offset(page_offset),
+        offset(offset),
+        size(size) {}
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+  ~FileMapping() { munmap(base, length); }
+
+  // Returns the address of the byte at `file_offset`, which must be in the
+  // mapped range.
+  uint8_t* Data(uint64_t file_offset) const {
+    return static_cast<uint8_t*>(base) + page_offset + (file_offset - offset);
+  }
+
+  void* base;
+  size_t length;
+  // The offset of the mapped range from `base`.
+  size_t page_offset;
+  // The mapped range of the file.
+  uint64_t offset;
+  uint64_t size;
+};
+#endif  // !defined(_WIN32)
+
 struct CpuMapping {
 #if !defined(_WIN32)
+  // The shared mapping that contains the slice, if any. Otherwise the slice is
+  // mapped on its own, from `base`.
+  std::shared_ptr<const FileMapping> file;
   void* base = nullptr;
   size_t length = 0;
   size_t page_offset = 0;
@@ -223,7 +265,7 @@ absl::Status ReadScopedRangeWin32(HANDLE handle, uint64_t absolute_offset,
 void ReleaseEntry(Entry& entry) {
   entry.access.reset();
 #if !defined(_WIN32)
-  if (entry.cpu_mapping) {
+  if (entry.cpu_mapping && entry.cpu_mapping->base != nullptr) {
     munmap(entry.cpu_mapping->base, entry.cpu_mapping->length);
   }
 #else
@@ -479,8 +521,190 @@ absl::StatusOr<std::vector<uint8_t>> ReadWeightSlice(
   return ReadFileSliceFromPath(info, source.path);
 }
 
+#if !defined(_WIN32)
+// Maps `size` bytes of `fd` from `offset`. With `populate`, the pages are read
+// before returning.
+absl::StatusOr<std::shared_ptr<const FileMapping>> MapFileRange(
+    int fd, uint64_t offset, uint64_t size, bool populate) {
+  if (size == 0) {
+    return absl::InvalidArgumentError("Cannot map an empty file range");
+  }
+  const int64_t page_size = sysconf(_SC_PAGESIZE);
+  const size_t page_offset =
+      static_cast<size_t>(offset % static_cast<uint64_t>(page_size));
+  if (size > std::numeric_limits<size_t>::max() - page_offset) {
+    return absl::ResourceExhaustedError("File range too large to map");
+  }
+  const size_t map_length = page_offset + static_cast<size_t>(size);
+  int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif  // defined(MAP_POPULATE)
+  void* base = mmap(nullptr, map_length, PROT_READ, flags, fd,
+                    static_cast<off_t>(offset - page_offset));
+  if (base == MAP_FAILED) {
+    return absl::ErrnoToStatus(errno, "mmap failed");
+  }
+#if !defined(MAP_POPULATE)
+  if (populate) {
+    madvise(base, map_length, MADV_WILLNEED);
+  }
+#endif  // !defined(MAP_POPULATE)
+  return std::make_shared<const FileMapping>(base, map_length, page_offset,
+                                             offset, size);
+}
+#endif  // !defined(_WIN32)
+
+// Maps each group file or scoped section once, when the first of its slices is
+// mapped, and serves the slices as views into that mapping. A mapping is
+// unmapped once no slice uses it anymore.
+class MappingCache {
+ public:
+  absl::StatusOr<CpuMapping> MapSlice(const LiteRtWeightInfo& info,
+                                      const WeightSource& source,
+                                      bool populate) {
+#if !defined(_WIN32)
+    const bool scoped = source.kind == WeightSource::Kind::kScopedFile;
+    absl::StatusOr<std::shared_ptr<const FileMapping>> file =
+        scoped ? MapSection(*source.section, source.scoped_source, populate)
+               : MapFile(source.path, populate);
+    if (file.ok()) {
+      uint64_t offset = info.offset;
+      if (scoped) {
+        LITERT_RETURN_IF_ERROR(
+            ValidateScopedSlice(info, *source.section, &offset));
+      } else if (info.offset > (*file)->size ||
+                 info.length > (*file)->size - info.offset) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "External weight slice out of range for %s", source.path));
+      }
+      CpuMapping mapping;
+      mapping.data = (*file)->Data(offset);
+      mapping.data_length = static_cast<size_t>(info.length);
+      mapping.file = *std::move(file);
+      return mapping;
+    }
+    // The whole file may not fit in the address space, e.g. on 32-bit
+    // platforms. Map the slice on its own, which also reports the errors.
+#endif  // !defined(_WIN32)
+    return MapWeightSlice(info, source);
+  }
+
+ private:
+#if !defined(_WIN32)
+  absl::StatusOr<std::shared_ptr<const FileMapping>> MapFile(
+      const std::string& path, bool populate) {
+    std::weak_ptr<const FileMapping>& cached = files_[path];
+    if (auto file = cached.lock()) {
+      return file;
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return absl::ErrnoToStatus(errno,
+                                 absl::StrFormat("Failed to open %s", path));
+    }
+    struct stat st;
+    absl::StatusOr<std::shared_ptr<const FileMapping>> file =
+        fstat(fd, &st) == 0
+            ? MapFileRange(fd, 0, static_cast<uint64_t>(st.st_size), populate)
+            : absl::ErrnoToStatus(errno,
+                                  absl::StrFormat("Failed to stat %s", path));
+    close(fd);
+    if (file.ok()) {
+      cached = *file;
+    }
+    return file;
+  }
+
+  absl::StatusOr<std::shared_ptr<const FileMapping>> MapSection(
+      const litert::ScopedWeightSection& section,
+      litert::ScopedWeightSource* source, bool populate) {
+    if (!source || !source->file.IsValid()) {
+      return absl::FailedPreconditionError(
+          "Scoped weight source is not available");
+    }
+    std::weak_ptr<const FileMapping>& cached = sections_[&section];
+    if (auto file = cached.lock()) {
+      return file;
+    }
+    absl::StatusOr<std::shared_ptr<const FileMapping>> file = MapFileRange(
+        source->file.file(), section.offset, section.length, populate);
+    if (file.ok()) {
+      cached = *file;
+    }
+    return file;
+  }
+
+  absl::flat_hash_map<std::string, std::weak_ptr<const FileMapping>> files_;
+  absl::flat_hash_map<const litert::ScopedWeightSection*,
+                      std::weak_ptr<const FileMapping>>
+      sections_;
+#endif  // !defined(_WIN32)
+};
+
+// A range of weights mapped for CPU access, to prefetch.
+struct PrefetchRange {
+  const uint8_t* data;
+  size_t length;
+  // Keeps the mapping that contains the range, if shared, alive.
+  std::shared_ptr<const void> mapping;
+};
+
+// Reads the pages of weight ranges on background threads, so that they are
+// resident by the time the ops first use them. The threads claim the ranges
+// in order.
+class BackgroundPrefetch {
+ public:
+  BackgroundPrefetch(std::vector<PrefetchRange> ranges, int num_threads)
+      : ranges_(std::move(ranges)) {
+    num_threads =
+        std::max(1, std::min(num_threads, static_cast<int>(ranges_.size())));
+    threads_.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+      threads_.emplace_back([this] { Run(); });
+    }
+  }
+
+  // Stops reading and waits for the threads.
+  ~BackgroundPrefetch() {
+    stop_.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+ private:
+  // Reading a byte every 4 KiB, the smallest page size of the supported
+  // platforms, faults in every page.
+  static constexpr size_t kStride = 4096;
+
+  void Run() {
+    uint8_t sum = 0;
+    for (size_t i = next_range_.fetch_add(1); i < ranges_.size();
+         i = next_range_.fetch_add(1)) {
+      const volatile uint8_t* data = ranges_[i].data;
+      for (size_t offset = 0; offset < ranges_[i].length; offset += kStride) {
+        if (stop_.load(std::memory_order_relaxed)) {
+          return;
+        }
+        sum += data[offset];
+      }
+    }
+    (void)sum;
+  }
+
+  std::vector<PrefetchRange> ranges_;
+  std::atomic<size_t> next_range_ = 0;
+  std::atomic<bool> stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
 absl::Status EnsureCpuTensorBuffer(Entry& entry, const LiteRtWeightInfo& info,
-                                   const WeightSource& source) {
+                                   const WeightSource& source,
+                                   MappingCache& mapping_cache,
+                                   bool populate) {
   if (!entry.access.has_value()) {
     entry.access.emplace();
   }
@@ -494,7 +718,8 @@ absl::Status EnsureCpuTensorBuffer(Entry& entry, const LiteRtWeightInfo& info,
   }
 
   if (!entry.cpu_mapping) {
-    absl::StatusOr<CpuMapping> mapping = MapWeightSlice(info, source);
+    absl::StatusOr<CpuMapping> mapping =
+        mapping_cache.MapSlice(info, source, populate);
     if (!mapping.ok()) {
       return mapping.status();
     }
@@ -581,6 +806,19 @@ void ParseFlatBuffer(const tflite::Model& model,
     const auto* subgraph = subgraphs->Get(sg);
     if (!subgraph || !subgraph->tensors()) continue;
 
+    const auto* operators = subgraph->operators();
+    const uint32_t num_ops = operators ? operators->size() : 0;
+    std::vector<uint32_t> first_use(subgraph->tensors()->size(), num_ops);
+    for (uint32_t op = 0; op < num_ops; ++op) {
+      const auto* op_fb = operators->Get(op);
+      if (!op_fb || !op_fb->inputs()) continue;
+      for (int32_t input : *op_fb->inputs()) {
+        if (input >= 0 && static_cast<size_t>(input) < first_use.size()) {
+          first_use[input] = std::min(first_use[input], op);
+        }
+      }
+    }
+
     for (int t = 0; t < subgraph->tensors()->size(); ++t) {
       const auto* tensor_fb = subgraph->tensors()->Get(t);
       if (!tensor_fb || tensor_fb->external_buffer() == 0) continue;
@@ -596,6 +834,7 @@ void ParseFlatBuffer(const tflite::Model& model,
       info.group_id = buffer->group();
       info.offset = buffer->offset();
       info.length = buffer->length();
+      info.first_use = first_use[t];
       info.packing = buffer->packing()
                          ? absl::string_view(buffer->packing()->string_view())
                          : absl::string_view();
@@ -639,6 +878,7 @@ class LiteRtWeightLoader : public WeightLoader {
   }
 
   ~LiteRtWeightLoader() override {
+    background_prefetch_.reset();
     for (auto& [_, entry] : entries_) {
       ReleaseEntry(entry);
     }
@@ -666,6 +906,8 @@ class LiteRtWeightLoader : public WeightLoader {
 
   absl::Status PrepareAccess(const WeightAccessRequest& request,
                              LiteRtEnvironmentT* env) override {
+    background_prefetch_.reset();
+    const bool populate = request.prefetch == WeightPrefetch::kPopulate;
     for (auto& [tensor_id, entry] : entries_) {
       const LiteRtWeightInfo& info = infos_[entry.info_index];
       WeightSource source;
@@ -687,7 +929,8 @@ class LiteRtWeightLoader : public WeightLoader {
       }
 
       if (request.cpu) {
-        absl::Status status = EnsureCpuTensorBuffer(entry, info, source);
+        absl::Status status = EnsureCpuTensorBuffer(entry, info, source,
+                                                    mapping_cache_, populate);
         if (!status.ok()) {
           return status;
         }
@@ -705,6 +948,9 @@ class LiteRtWeightLoader : public WeightLoader {
 #endif
       }
     }
+    if (request.cpu) {
+      Prefetch(request);
+    }
     return absl::OkStatus();
   }
 
@@ -715,6 +961,8 @@ class LiteRtWeightLoader : public WeightLoader {
       return absl::InvalidArgumentError(
           absl::StrFormat("Unknown external buffer id %u", external_buffer_id));
     }
+    // The slice may be mapped on its own, and unmapped under the prefetch.
+    background_prefetch_.reset();
     ReleaseEntry(it->second);
     it->second.access = std::move(access);
     return absl::OkStatus();
@@ -730,6 +978,68 @@ class LiteRtWeightLoader : public WeightLoader {
   }
 
  private:
+  // Returns the weights mapped for CPU access, in the order of their first
+  // use by the ops.
+  std::vector<PrefetchRange> CpuRangesByFirstUse() const {
+    std::vector<const Entry*> mapped;
+    for (const auto& [_, entry] : entries_) {
+      if (entry.cpu_mapping) {
+        mapped.push_back(&entry);
+      }
+    }
+    auto first_use = [this](const Entry* entry) {
+      const LiteRtWeightInfo& info = infos_[entry->info_index];
+      return std::make_tuple(info.subgraph_index, info.first_use,
+                             info.group_id, info.offset);
+    };
+    std::sort(mapped.begin(), mapped.end(),
+              [&](const Entry* a, const Entry* b) {
+                return first_use(a) < first_use(b);
+              });
+    std::vector<PrefetchRange> ranges;
+    ranges.reserve(mapped.size());
+    for (const Entry* entry : mapped) {
+      PrefetchRange range{entry->cpu_mapping->data,
+                          entry->cpu_mapping->data_length};
+#if !defined(_WIN32)
+      range.mapping = entry->cpu_mapping->file;
+#endif  // !defined(_WIN32)
+      ranges.push_back(std::move(range));
+    }
+    return ranges;
+  }
+
+  void Prefetch(const WeightAccessRequest& request) {
+    switch (request.prefetch) {
+      case WeightPrefetch::kNone:
+      case WeightPrefetch::kPopulate:
+        return;
+      case WeightPrefetch::kWillNeed: {
+#if !defined(_WIN32)
+        const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+        for (const PrefetchRange& range : CpuRangesByFirstUse()) {
+          if (range.length == 0) continue;
+          const uintptr_t begin =
+              reinterpret_cast<uintptr_t>(range.data) & ~(page_size - 1);
+          const uintptr_t end =
+              reinterpret_cast<uintptr_t>(range.data) + range.length;
+          // Only a hint, so failures don't matter.
+          madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+        }
+#endif  // !defined(_WIN32)
+        return;
+      }
+      case WeightPrefetch::kBackgroundRead: {
+        std::vector<PrefetchRange> ranges = CpuRangesByFirstUse();
+        if (!ranges.empty()) {
+          background_prefetch_ = std::make_unique<BackgroundPrefetch>(
+              std::move(ranges), request.num_prefetch_threads);
+        }
+        return;
+      }
+    }
+  }
+
   std::optional<std::string> model_directory_;
   std::vector<LiteRtWeightInfo> infos_;
   absl::flat_hash_map<uint32_t, Entry> entries_;
@@ -737,6 +1047,8 @@ class LiteRtWeightLoader : public WeightLoader {
   std::unique_ptr<litert::ScopedWeightSource> scoped_weight_source_;
   absl::flat_hash_map<uint32_t, litert::ScopedWeightSection> group_sections_;
   mutable std::vector<WeightInfo> weight_info_cache_;
+  MappingCache mapping_cache_;
+  std::unique_ptr<BackgroundPrefetch> background_prefetch_;
 };
 
 }  // namespace
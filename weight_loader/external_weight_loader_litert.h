@@ -78,12 +78,31 @@ struct WeightInfo {
   absl::string_view packing;
 };
 
+// How to warm up the external weights mapped for CPU access, so that the first
+// inference doesn't take the page faults one after another.
+enum class WeightPrefetch {
+  // Pages are read on first access.
+  kNone,
+  // Asks the kernel to read the mapped weights ahead (MADV_WILLNEED), in the
+  // order of their first use by the ops.
+  kWillNeed,
+  // Reads the whole group files when they are mapped (MAP_POPULATE).
+  kPopulate,
+  // Reads the mapped weights on background threads, in the order of their
+  // first use by the ops.
+  kBackgroundRead,
+};
+
 // A request to access the data of an external weight tensor.
 struct WeightAccessRequest {
   // Whether to access the data on the CPU.
   bool cpu = true;
   // Whether to access the data on an OpenCL device.
   bool opencl = false;
+  // How to warm up the data accessed on the CPU.
+  WeightPrefetch prefetch = WeightPrefetch::kNone;
+  // Number of threads for `WeightPrefetch::kBackgroundRead`.
+  int num_prefetch_threads = 2;
 };
 
 struct WeightAccess;
@@ -14,7 +14,9 @@
 
 #include "weight_loader/external_weight_loader_litert.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <ios>
@@ -62,27 +64,37 @@ struct ModelBuffer {
   const tflite::Model* model() const { return tflite::GetModel(data.data()); }
 };
 
+// A range of the group file.
+struct Slice {
+  uint64_t offset;
+  uint64_t length;
+};
+
 // Builds a TfLite model. The model contains a single subgraph with one UINT8
-// tensor. This tensor is linked to an external buffer with `kExternalBufferId`
-// and belongs to an external buffer group identified by `group_name` and
-// `kGroupId`.
-ModelBuffer BuildModel(absl::string_view group_name) {
+// vector tensor per slice. The tensor of `slices[i]` is linked to the external
+// buffer with ID `kExternalBufferId + i`, and all of them belong to the
+// external buffer group identified by `group_name` and `kGroupId`.
+ModelBuffer BuildModel(absl::string_view group_name,
+                       absl::Span<const Slice> slices) {
   flatbuffers::FlatBufferBuilder builder;
 
-  const std::vector<int32_t> tensor_shape = {
-      static_cast<int32_t>(kTensorElementCount)};
-  auto tensor = tflite::CreateTensor(
-      builder, builder.CreateVector(tensor_shape), tflite::TensorType_UINT8,
-      /*buffer=*/0, builder.CreateString("external_tensor"),
-      /*quantization=*/0,
-      /*is_variable=*/false,
-      /*sparsity=*/0,
-      /*shape_signature=*/0,
-      /*has_rank=*/false,
-      /*variant_tensors=*/0, kExternalBufferId);
-
-  auto tensors_vec = builder.CreateVector(
-      std::vector<flatbuffers::Offset<tflite::Tensor>>{tensor});
+  std::vector<flatbuffers::Offset<tflite::Tensor>> tensors;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    const std::vector<int32_t> tensor_shape = {
+        static_cast<int32_t>(slices[i].length)};
+    tensors.push_back(tflite::CreateTensor(
+        builder, builder.CreateVector(tensor_shape), tflite::TensorType_UINT8,
+        /*buffer=*/0,
+        builder.CreateString("external_tensor_" + std::to_string(i)),
+        /*quantization=*/0,
+        /*is_variable=*/false,
+        /*sparsity=*/0,
+        /*shape_signature=*/0,
+        /*has_rank=*/false,
+        /*variant_tensors=*/0, kExternalBufferId + i));
+  }
+
+  auto tensors_vec = builder.CreateVector(tensors);
   auto empty_int_vec = builder.CreateVector<int32_t>(std::vector<int32_t>{});
   auto empty_op_vec = builder.CreateVector(
       std::vector<flatbuffers::Offset<tflite::Operator>>{});
@@ -106,11 +118,13 @@ ModelBuffer BuildModel(absl::string_view group_name) {
       std::vector<flatbuffers::Offset<tflite::ExternalBufferGroup>>{
           placeholder_group, group});
 
-  auto ext_buffer = tflite::CreateExternalBuffer(
-      builder, kExternalBufferId, kGroupId, kSliceOffset, kSliceLengthBytes,
-      builder.CreateString(""));
-  auto ext_buffers_vec = builder.CreateVector(
-      std::vector<flatbuffers::Offset<tflite::ExternalBuffer>>{ext_buffer});
+  std::vector<flatbuffers::Offset<tflite::ExternalBuffer>> ext_buffers;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    ext_buffers.push_back(tflite::CreateExternalBuffer(
+        builder, kExternalBufferId + i, kGroupId, slices[i].offset,
+        slices[i].length, builder.CreateString("")));
+  }
+  auto ext_buffers_vec = builder.CreateVector(ext_buffers);
 
   auto model =
       tflite::CreateModel(builder, /*version=*/3,
@@ -126,6 +140,13 @@ ModelBuffer BuildModel(absl::string_view group_name) {
   return result;
 }
 
+// Builds a model whose single tensor is the slice of `kSliceLengthBytes` at
+// `kSliceOffset`, see above.
+ModelBuffer BuildModel(absl::string_view group_name) {
+  const Slice slice = {kSliceOffset, kSliceLengthBytes};
+  return BuildModel(group_name, absl::MakeConstSpan(&slice, 1));
+}
+
 std::string WriteWeightsFile(absl::string_view filename,
                              std::string_view payload) {
   std::string path =
@@ -156,6 +177,36 @@ void ExpectHostBufferEquals(const weight_loader::WeightAccess* access,
   EXPECT_EQ(actual, expected);
 }
 
+// Returns the host address of the weight data.
+const uint8_t* HostData(const weight_loader::WeightAccess* access) {
+  void* host_mem_addr = nullptr;
+  EXPECT_EQ(LiteRtLockTensorBuffer(access->GetHostBuffer(), &host_mem_addr,
+                                   kLiteRtTensorBufferLockModeRead),
+            kLiteRtStatusOk);
+  EXPECT_EQ(LiteRtUnlockTensorBuffer(access->GetHostBuffer()),
+            kLiteRtStatusOk);
+  return static_cast<const uint8_t*>(host_mem_addr);
+}
+
+// Returns the number of mappings of the file at `path` in this process.
+int CountMappingsOf(const std::string& path) {
+  char* resolved = realpath(path.c_str(), nullptr);
+  EXPECT_NE(resolved, nullptr);
+  if (resolved == nullptr) return -1;
+  const std::string suffix = std::string(" ") + resolved;
+  free(resolved);
+  std::ifstream maps("/proc/self/maps");
+  int count = 0;
+  for (std::string line; std::getline(maps, line);) {
+    if (line.size() >= suffix.size() &&
+        line.compare(line.size() - suffix.size(), suffix.size(), suffix) ==
+            0) {
+      ++count;
+    }
+  }
+  return count;
+}
+
 const WeightInfo& GetSingleWeightInfo(const WeightLoader& loader) {
   auto infos = loader.GetWeightInfo();
   EXPECT_EQ(infos.size(), 1);
@@ -247,5 +298,93 @@ TEST(ExternalWeightLoaderTest, LoadsWeightsFromScopedFile) {
   ExpectHostBufferEquals(access, expected);
 }
 
+TEST(ExternalWeightLoaderTest, LoadsWeightsWithPrefetch) {
+  constexpr absl::string_view kGroupName = "prefetch.bin";
+  const std::string payload = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ4545454545";
+  auto model = BuildModel(kGroupName);
+  WriteWeightsFile(kGroupName, payload);
+  const auto expected = ExpectedSlice(payload);
+
+  for (WeightPrefetch prefetch :
+       {WeightPrefetch::kNone, WeightPrefetch::kWillNeed,
+        WeightPrefetch::kPopulate, WeightPrefetch::kBackgroundRead}) {
+    auto loader = CreateLiteRtWeightLoader(
+        model.model(),
+        /*model_directory=*/std::string(::testing::TempDir()),
+        /*scoped_weight_source=*/nullptr);
+    ASSERT_NE(loader, nullptr);
+    const auto& weight_info = GetSingleWeightInfo(*loader);
+    weight_loader::WeightAccessRequest request;
+    request.cpu = true;
+    request.prefetch = prefetch;
+    absl::Status status = loader->PrepareAccess(request, /*env=*/nullptr);
+    ASSERT_TRUE(status.ok()) << status.message();
+
+    const auto* access =
+        loader->GetExternalWeightByBuffer(weight_info.external_buffer_id);
+    ExpectHostBufferMetadata(access);
+    ExpectHostBufferEquals(access, expected);
+  }
+}
+
+#if defined(__linux__)
+TEST(ExternalWeightLoaderTest, SlicesOfAGroupFileShareOneMapping) {
+  constexpr absl::string_view kGroupName = "shared.bin";
+  const std::string payload = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ4545454545";
+  const std::vector<Slice> slices = {{0, 8}, {8, 8}, {24, 16}};
+  auto model = BuildModel(kGroupName, slices);
+  const std::string path = WriteWeightsFile(kGroupName, payload);
+
+  auto loader = CreateLiteRtWeightLoader(
+      model.model(),
+      /*model_directory=*/std::string(::testing::TempDir()),
+      /*scoped_weight_source=*/nullptr);
+  ASSERT_NE(loader, nullptr);
+  ASSERT_EQ(loader->GetWeightInfo().size(), slices.size());
+  ASSERT_EQ(CountMappingsOf(path), 0);
+  weight_loader::WeightAccessRequest request;
+  request.cpu = true;
+  absl::Status status = loader->PrepareAccess(request, /*env=*/nullptr);
+  ASSERT_TRUE(status.ok()) << status.message();
+
+  // All slices are views into a single mapping of the whole file.
+  EXPECT_EQ(CountMappingsOf(path), 1);
+  std::vector<const uint8_t*> data;
+  for (size_t i = 0; i < slices.size(); ++i) {
+    const auto* access =
+        loader->GetExternalWeightByBuffer(kExternalBufferId + i);
+    ASSERT_NE(access, nullptr);
+    data.push_back(HostData(access));
+    ExpectHostBufferEquals(
+        access, std::vector<uint8_t>(
+                    payload.begin() + slices[i].offset,
+                    payload.begin() + slices[i].offset + slices[i].length));
+  }
+  for (size_t i = 1; i < slices.size(); ++i) {
+    EXPECT_EQ(data[i] - data[0],
+              static_cast<ptrdiff_t>(slices[i].offset - slices[0].offset));
+  }
+
+  // The mapping outlives all but the last slice using it.
+  for (size_t i = 0; i + 1 < slices.size(); ++i) {
+    ASSERT_TRUE(
+        loader->SetExternalWeightByBuffer(kExternalBufferId + i, WeightAccess())
+            .ok());
+    EXPECT_EQ(CountMappingsOf(path), 1);
+  }
+  const size_t last = slices.size() - 1;
+  ExpectHostBufferEquals(
+      loader->GetExternalWeightByBuffer(kExternalBufferId + last),
+      std::vector<uint8_t>(
+          payload.begin() + slices[last].offset,
+          payload.begin() + slices[last].offset + slices[last].length));
+  ASSERT_TRUE(loader
+                  ->SetExternalWeightByBuffer(kExternalBufferId + last,
+                                              WeightAccess())
+                  .ok());
+  EXPECT_EQ(CountMappingsOf(path), 0);
+}
+#endif  // defined(__linux__)
+
 }  // namespace
 }  // namespace weight_loader